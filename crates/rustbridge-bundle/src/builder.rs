@@ -6,10 +6,70 @@ use crate::{BundleError, BundleResult, MANIFEST_FILE, Manifest, Platform};
 use minisign::SecretKey;
 use sha2::{Digest, Sha256};
 use std::fs::{self, File};
-use std::io::Write;
+use std::io::{Cursor, Write};
 use std::path::Path;
-use zip::ZipWriter;
+use std::str::FromStr;
 use zip::write::SimpleFileOptions;
+use zip::{CompressionMethod, DateTime, ZipArchive, ZipWriter};
+
+/// How an entry is compressed in the bundle.
+///
+/// Parsed from `stored`, `deflate`, `deflate:<1-9>`, `zstd` or `zstd:<1-22>`.
+/// Only the Rust loader reads zstd entries; bundles meant for the Java,
+/// Python or C# loaders should use `deflate` or `stored`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Compression {
+    /// No compression, so loaders can copy the entry straight out of the bundle.
+    Stored,
+    /// Deflate at the given level (1-9).
+    Deflate(i64),
+    /// Zstandard at the given level (1-22).
+    Zstd(i64),
+}
+
+impl Compression {
+    /// Zip options for an entry, with a fixed timestamp and mode so output is reproducible.
+    fn options(self) -> SimpleFileOptions {
+        let options = SimpleFileOptions::default()
+            .last_modified_time(DateTime::default())
+            .unix_permissions(0o644);
+        match self {
+            Self::Stored => options.compression_method(CompressionMethod::Stored),
+            Self::Deflate(level) => options
+                .compression_method(CompressionMethod::Deflated)
+                .compression_level(Some(level)),
+            Self::Zstd(level) => options
+                .compression_method(CompressionMethod::Zstd)
+                .compression_level(Some(level)),
+        }
+    }
+}
+
+impl Default for Compression {
+    fn default() -> Self {
+        Self::Deflate(6)
+    }
+}
+
+impl FromStr for Compression {
+    type Err = BundleError;
+
+    fn from_str(s: &str) -> BundleResult<Self> {
+        let invalid = || BundleError::InvalidCompression(s.to_string());
+        let (method, level) = match s.split_once(':') {
+            Some((method, level)) => (method, Some(level.parse::<i64>().map_err(|_| invalid())?)),
+            None => (s, None),
+        };
+        match (method, level) {
+            ("stored", None) => Ok(Self::Stored),
+            ("deflate", None) => Ok(Self::default()),
+            ("deflate", Some(level @ 1..=9)) => Ok(Self::Deflate(level)),
+            ("zstd", None) => Ok(Self::Zstd(3)),
+            ("zstd", Some(level @ 1..=22)) => Ok(Self::Zstd(level)),
+            _ => Err(invalid()),
+        }
+    }
+}
 
 /// Builder for creating plugin bundles.
 ///
@@ -31,6 +91,8 @@ pub struct BundleBuilder {
     manifest: Manifest,
     files: Vec<BundleFile>,
     signing_key: Option<(String, SecretKey)>, // (public_key_base64, secret_key)
+    compression: Compression,
+    library_compression: Compression,
 }
 
 /// A file to include in the bundle.
@@ -50,9 +112,28 @@ impl BundleBuilder {
             manifest,
             files: Vec::new(),
             signing_key: None,
+            compression: Compression::default(),
+            library_compression: Compression::default(),
         }
     }
 
+    /// Set the compression for the manifest, schemas, docs and signatures.
+    #[must_use]
+    pub fn with_compression(mut self, compression: Compression) -> Self {
+        self.compression = compression;
+        self
+    }
+
+    /// Set the compression for plugin and bridge libraries.
+    ///
+    /// [`Compression::Stored`] makes the bundle larger but lets
+    /// [`BundleLoader`](crate::BundleLoader) copy libraries out without inflating them.
+    #[must_use]
+    pub fn with_library_compression(mut self, compression: Compression) -> Self {
+        self.library_compression = compression;
+        self
+    }
+
     /// Set the signing key for bundle signing.
     ///
     /// The secret key will be used to sign all library files and the manifest.
@@ -432,49 +513,51 @@ impl BundleBuilder {
     }
 
     /// Write the bundle to a file.
+    ///
+    /// Entries are compressed, and signed if a key is set, on one thread per
+    /// core. Each is written to its own in-memory archive, and those are
+    /// merged in order, so the output does not depend on scheduling. With
+    /// fixed timestamps, sorted manifest keys and deterministic signatures,
+    /// the same inputs always produce the same bundle bytes.
     pub fn write<P: AsRef<Path>>(self, output_path: P) -> BundleResult<()> {
         let output_path = output_path.as_ref();
 
         // Validate the manifest
         self.manifest.validate()?;
 
+        let manifest_json = self.manifest.to_json()?;
+        let secret_key = self.signing_key.as_ref().map(|(_, secret_key)| secret_key);
+
+        // The manifest is always signed; library files (in lib/ or bridge/) are signed too
+        let mut entries = vec![PendingEntry {
+            archive_path: MANIFEST_FILE,
+            contents: manifest_json.as_bytes(),
+            compression: self.compression,
+            sign: true,
+        }];
+        entries.extend(self.files.iter().map(|bundle_file| {
+            let library = bundle_file.archive_path.starts_with("lib/")
+                || bundle_file.archive_path.starts_with("bridge/");
+            PendingEntry {
+                archive_path: &bundle_file.archive_path,
+                contents: &bundle_file.contents,
+                compression: if library {
+                    self.library_compression
+                } else {
+                    self.compression
+                },
+                sign: library,
+            }
+        }));
+
+        let parts = compress_entries(&entries, secret_key, self.compression)?;
+
         // Create the ZIP file
         let file = File::create(output_path)?;
         let mut zip = ZipWriter::new(file);
-        let options =
-            SimpleFileOptions::default().compression_method(zip::CompressionMethod::Deflated);
-
-        // Write manifest.json
-        let manifest_json = self.manifest.to_json()?;
-        zip.start_file(MANIFEST_FILE, options)?;
-        zip.write_all(manifest_json.as_bytes())?;
-
-        // Sign and write manifest.json.minisig if signing is enabled
-        if let Some((ref _public_key, ref secret_key)) = self.signing_key {
-            let signature = sign_data(secret_key, manifest_json.as_bytes())?;
-            zip.start_file(format!("{MANIFEST_FILE}.minisig"), options)?;
-            zip.write_all(signature.as_bytes())?;
+        for part in parts {
+            zip.merge_archive(ZipArchive::new(Cursor::new(part))?)?;
         }
-
-        // Write all other files
-        for bundle_file in &self.files {
-            zip.start_file(&bundle_file.archive_path, options)?;
-            zip.write_all(&bundle_file.contents)?;
-
-            // Sign library files if signing is enabled
-            if let Some((ref _public_key, ref secret_key)) = self.signing_key {
-                // Sign library files (in lib/ or bridge/ directory)
-                if bundle_file.archive_path.starts_with("lib/")
-                    || bundle_file.archive_path.starts_with("bridge/")
-                {
-                    let signature = sign_data(secret_key, &bundle_file.contents)?;
-                    let sig_path = format!("{}.minisig", bundle_file.archive_path);
-                    zip.start_file(&sig_path, options)?;
-                    zip.write_all(signature.as_bytes())?;
-                }
-            }
-        }
-
         zip.finish()?;
 
         Ok(())
@@ -492,6 +575,87 @@ impl BundleBuilder {
     }
 }
 
+/// An entry waiting to be compressed by [`compress_entries`].
+struct PendingEntry<'a> {
+    archive_path: &'a str,
+    contents: &'a [u8],
+    compression: Compression,
+    /// Add a `.minisig` entry right after this one when a key is set
+    sign: bool,
+}
+
+/// Compress each entry into its own in-memory archive, spread over the cores.
+///
+/// Returns the archives in the order of `entries`.
+fn compress_entries(
+    entries: &[PendingEntry<'_>],
+    secret_key: Option<&SecretKey>,
+    signature_compression: Compression,
+) -> BundleResult<Vec<Vec<u8>>> {
+    let workers = std::thread::available_parallelism()
+        .map_or(1, |n| n.get())
+        .min(entries.len())
+        .max(1);
+
+    let mut parts: Vec<(usize, BundleResult<Vec<u8>>)> = std::thread::scope(|scope| {
+        let handles: Vec<_> = (0..workers)
+            .map(|worker| {
+                scope.spawn(move || {
+                    entries
+                        .iter()
+                        .enumerate()
+                        .skip(worker)
+                        .step_by(workers)
+                        .map(|(index, entry)| {
+                            (
+                                index,
+                                compress_entry(entry, secret_key, signature_compression),
+                            )
+                        })
+                        .collect::<Vec<_>>()
+                })
+            })
+            .collect();
+        handles
+            .into_iter()
+            .flat_map(|handle| {
+                handle
+                    .join()
+                    .unwrap_or_else(|panic| std::panic::resume_unwind(panic))
+            })
+            .collect()
+    });
+
+    parts.sort_unstable_by_key(|(index, _)| *index);
+    parts.into_iter().map(|(_, part)| part).collect()
+}
+
+/// Write one entry, and its signature if needed, to an in-memory archive.
+fn compress_entry(
+    entry: &PendingEntry<'_>,
+    secret_key: Option<&SecretKey>,
+    signature_compression: Compression,
+) -> BundleResult<Vec<u8>> {
+    let mut zip = ZipWriter::new(Cursor::new(Vec::new()));
+    let large_file = entry.contents.len() as u64 >= u64::from(u32::MAX);
+    zip.start_file(
+        entry.archive_path,
+        entry.compression.options().large_file(large_file),
+    )?;
+    zip.write_all(entry.contents)?;
+
+    if let Some(secret_key) = secret_key.filter(|_| entry.sign) {
+        let signature = sign_data(secret_key, entry.archive_path, entry.contents)?;
+        zip.start_file(
+            format!("{}.minisig", entry.archive_path),
+            signature_compression.options(),
+        )?;
+        zip.write_all(signature.as_bytes())?;
+    }
+
+    Ok(zip.finish()?.into_inner())
+}
+
 /// Compute SHA256 hash of data and return as hex string.
 pub fn compute_sha256(data: &[u8]) -> String {
     let mut hasher = Sha256::new();
@@ -502,8 +666,11 @@ pub fn compute_sha256(data: &[u8]) -> String {
 
 /// Verify SHA256 checksum of data.
 pub fn verify_sha256(data: &[u8], expected: &str) -> bool {
-    let actual = compute_sha256(data);
+    sha256_matches(&compute_sha256(data), expected)
+}
 
+/// Compare a hex SHA256 digest against a manifest checksum.
+pub(crate) fn sha256_matches(actual: &str, expected: &str) -> bool {
     // Handle both "sha256:xxx" and raw "xxx" formats
     let expected_hex = expected.strip_prefix("sha256:").unwrap_or(expected);
 
@@ -523,11 +690,17 @@ fn detect_schema_format(filename: &str) -> String {
 
 /// Sign data using a minisign secret key.
 ///
+/// The trusted comment names the entry instead of carrying the signing time,
+/// so signing the same data again yields the same signature.
+///
 /// Returns the signature in minisign format (base64-encoded).
-fn sign_data(secret_key: &SecretKey, data: &[u8]) -> BundleResult<String> {
+fn sign_data(secret_key: &SecretKey, archive_path: &str, data: &[u8]) -> BundleResult<String> {
+    let trusted_comment = format!("file:{archive_path}");
     let signature_box = minisign::sign(
         None, // No public key needed for signing
-        secret_key, data, None, // No trusted comment
+        secret_key,
+        data,
+        Some(trusted_comment.as_str()),
         None, // No untrusted comment
     )
     .map_err(|e| BundleError::Io(std::io::Error::other(format!("Failed to sign data: {e}"))))?;
@@ -772,6 +945,155 @@ mod tests {
         assert!(matches!(err, BundleError::InvalidManifest(_)));
     }
 
+    #[test]
+    fn Compression___from_str___parses_methods_and_levels() {
+        assert_eq!(
+            "stored".parse::<Compression>().unwrap(),
+            Compression::Stored
+        );
+        assert_eq!(
+            "deflate".parse::<Compression>().unwrap(),
+            Compression::Deflate(6)
+        );
+        assert_eq!(
+            "deflate:9".parse::<Compression>().unwrap(),
+            Compression::Deflate(9)
+        );
+        assert_eq!("zstd".parse::<Compression>().unwrap(), Compression::Zstd(3));
+        assert_eq!(
+            "zstd:19".parse::<Compression>().unwrap(),
+            Compression::Zstd(19)
+        );
+    }
+
+    #[test]
+    fn Compression___from_str___invalid___returns_error() {
+        for spec in [
+            "",
+            "gzip",
+            "stored:1",
+            "deflate:0",
+            "deflate:10",
+            "zstd:0",
+            "zstd:fast",
+        ] {
+            let result = spec.parse::<Compression>();
+
+            assert!(
+                matches!(result, Err(BundleError::InvalidCompression(_))),
+                "{spec}"
+            );
+        }
+    }
+
+    fn write_signed_bundle(
+        temp_dir: &TempDir,
+        name: &str,
+        keypair: &minisign::KeyPair,
+        library_compression: Compression,
+    ) -> Vec<u8> {
+        let output_path = temp_dir.path().join(name);
+        let mut manifest = Manifest::new("test", "1.0.0");
+        manifest.add_schema(
+            "b.json".to_string(),
+            "schema/b.json".to_string(),
+            "json-schema".to_string(),
+            compute_sha256(b"{}"),
+            None,
+        );
+        let mut builder = BundleBuilder::new(manifest)
+            .with_signing_key(keypair.pk.to_base64(), keypair.sk.clone())
+            .with_library_compression(library_compression);
+        for platform in [
+            Platform::LinuxX86_64,
+            Platform::LinuxAarch64,
+            Platform::DarwinAarch64,
+            Platform::WindowsX86_64,
+        ] {
+            let lib_path = temp_dir
+                .path()
+                .join(format!("lib-{}.so", platform.as_str()));
+            fs::write(&lib_path, platform.as_str().repeat(1000)).unwrap();
+            builder = builder.add_library(platform, &lib_path).unwrap();
+        }
+        builder
+            .add_bytes("schema/b.json", b"{}".to_vec())
+            .write(&output_path)
+            .unwrap();
+        fs::read(output_path).unwrap()
+    }
+
+    #[test]
+    fn BundleBuilder___write___same_inputs___identical_bytes() {
+        let temp_dir = TempDir::new().unwrap();
+        let keypair = minisign::KeyPair::generate_unencrypted_keypair().unwrap();
+
+        let first = write_signed_bundle(&temp_dir, "a.rbp", &keypair, Compression::default());
+        let second = write_signed_bundle(&temp_dir, "b.rbp", &keypair, Compression::default());
+
+        assert_eq!(first, second);
+    }
+
+    #[test]
+    fn BundleBuilder___write___keeps_entry_order_with_signatures() {
+        let temp_dir = TempDir::new().unwrap();
+        let keypair = minisign::KeyPair::generate_unencrypted_keypair().unwrap();
+        let bytes = write_signed_bundle(&temp_dir, "a.rbp", &keypair, Compression::default());
+
+        let archive = zip::ZipArchive::new(Cursor::new(bytes)).unwrap();
+        let names: Vec<&str> = (0..archive.len())
+            .map(|i| archive.name_for_index(i).unwrap())
+            .collect();
+
+        assert_eq!(names[..2], ["manifest.json", "manifest.json.minisig"]);
+        assert_eq!(names.len(), 2 + 4 * 2 + 1);
+        assert_eq!(names.last(), Some(&"schema/b.json"));
+        for pair in names[2..10].chunks(2) {
+            assert!(pair[0].starts_with("lib/"));
+            assert_eq!(pair[1], format!("{}.minisig", pair[0]));
+        }
+    }
+
+    #[test]
+    fn BundleBuilder___write___library_compression___applies_to_libraries_only() {
+        for compression in [Compression::Stored, Compression::Zstd(3)] {
+            let temp_dir = TempDir::new().unwrap();
+            let keypair = minisign::KeyPair::generate_unencrypted_keypair().unwrap();
+            let bytes = write_signed_bundle(&temp_dir, "a.rbp", &keypair, compression);
+
+            let mut archive = zip::ZipArchive::new(Cursor::new(bytes)).unwrap();
+            let expected = match compression {
+                Compression::Stored => CompressionMethod::Stored,
+                _ => CompressionMethod::Zstd,
+            };
+            let library = archive
+                .by_name("lib/linux-x86_64/release/lib-linux-x86_64.so")
+                .unwrap()
+                .compression();
+            let schema = archive.by_name("schema/b.json").unwrap().compression();
+
+            assert_eq!(library, expected);
+            assert_eq!(schema, CompressionMethod::Deflated);
+        }
+    }
+
+    #[test]
+    fn BundleBuilder___write___stored_libraries___load_and_verify() {
+        let temp_dir = TempDir::new().unwrap();
+        let keypair = minisign::KeyPair::generate_unencrypted_keypair().unwrap();
+        write_signed_bundle(&temp_dir, "a.rbp", &keypair, Compression::Stored);
+
+        let mut loader = crate::BundleLoader::open(temp_dir.path().join("a.rbp")).unwrap();
+        let extracted = loader
+            .extract_library(Platform::WindowsX86_64, temp_dir.path().join("out"))
+            .unwrap();
+
+        assert_eq!(
+            fs::read(extracted).unwrap(),
+            "windows-x86_64".repeat(1000).as_bytes()
+        );
+    }
+
     #[test]
     fn BundleBuilder___write___creates_valid_bundle() {
         let temp_dir = TempDir::new().unwrap();
@@ -52,6 +52,10 @@ pub enum BundleError {
     /// Schema mismatch when combining bundles.
     #[error("Schema mismatch: {0}")]
     SchemaMismatch(String),
+
+    /// Unrecognised compression setting.
+    #[error("Invalid compression '{0}': expected stored, deflate[:1-9] or zstd[:1-22]")]
+    InvalidCompression(String),
 }
 
 #[cfg(test)]
@@ -45,7 +45,7 @@ mod platform;
 pub mod builder;
 pub mod loader;
 
-pub use builder::BundleBuilder;
+pub use builder::{BundleBuilder, Compression};
 pub use error::BundleError;
 pub use loader::BundleLoader;
 pub use manifest::{
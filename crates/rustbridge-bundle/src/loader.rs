@@ -2,12 +2,16 @@
 //!
 //! The [`BundleLoader`] provides functionality to load and extract plugin bundles.
 
-use crate::builder::verify_sha256;
-use crate::{BundleError, BundleResult, MANIFEST_FILE, Manifest, Platform};
+use crate::builder::sha256_matches;
+use crate::{BundleError, BundleResult, MANIFEST_FILE, Manifest, Platform, VariantInfo};
+use sha2::{Digest, Sha256};
 use std::fs::{self, File};
-use std::io::Read;
+use std::io::{self, Read, Seek, SeekFrom, Write};
 use std::path::{Path, PathBuf};
-use zip::ZipArchive;
+use zip::{CompressionMethod, ZipArchive};
+
+/// Bytes hashed and written per step while extracting a library
+const CHUNK_SIZE: usize = 64 * 1024;
 
 /// Loader for plugin bundles.
 ///
@@ -25,6 +29,7 @@ use zip::ZipArchive;
 /// ```
 #[derive(Debug)]
 pub struct BundleLoader {
+    path: PathBuf,
     archive: ZipArchive<File>,
     manifest: Manifest,
 }
@@ -50,7 +55,11 @@ impl BundleLoader {
         // Validate manifest
         manifest.validate()?;
 
-        Ok(Self { archive, manifest })
+        Ok(Self {
+            path: path.to_path_buf(),
+            archive,
+            manifest,
+        })
     }
 
     /// Get the bundle manifest.
@@ -89,6 +98,11 @@ impl BundleLoader {
 
     /// Extract a specific variant of the library for a platform.
     ///
+    /// The library is streamed to disk and hashed as it is written, so it is
+    /// never held in memory. Stored (uncompressed) entries are copied straight
+    /// from the bundle file while a second thread hashes them. The file only
+    /// appears at the returned path once its checksum has been verified.
+    ///
     /// Returns the path to the extracted library file.
     pub fn extract_library_variant<P: AsRef<Path>>(
         &mut self,
@@ -97,7 +111,103 @@ impl BundleLoader {
         output_dir: P,
     ) -> BundleResult<PathBuf> {
         let output_dir = output_dir.as_ref();
+        let variant_info = self.variant_info(platform, variant)?;
+
+        let library_path = variant_info.library.clone();
+        let expected_checksum = variant_info.checksum.clone();
+
+        // Determine output filename
+        let file_name = library_file_name(&library_path)?;
+
+        // Create output directory
+        fs::create_dir_all(output_dir)?;
+
+        let output_path = output_dir.join(file_name);
+
+        // Write to a private file first so a failed check never leaves a library behind
+        let mut partial_name = std::ffi::OsString::from(".");
+        partial_name.push(file_name);
+        partial_name.push(format!(".{}.partial", std::process::id()));
+        let partial_path = output_dir.join(partial_name);
+
+        let result = self.write_verified(&library_path, &expected_checksum, &partial_path);
+        if result.is_err() {
+            let _ = fs::remove_file(&partial_path);
+        }
+        result?;
+        fs::rename(&partial_path, &output_path)?;
+
+        Ok(output_path)
+    }
+
+    /// Extract a specific variant of the library into a shared cache.
+    ///
+    /// Libraries are cached under `cache_dir/<sha256>/`, keyed by the
+    /// checksum the manifest records for the variant. A cached library is
+    /// reused when its size and modification time still match the stamp
+    /// written next to it, so a warm start costs two `stat`s and reads no
+    /// library bytes. Otherwise the library is extracted and verified as by
+    /// [`extract_library_variant`](Self::extract_library_variant), with a
+    /// file lock on the entry so concurrent processes extract it only once.
+    ///
+    /// The cache trusts its own contents, so `cache_dir` must only be
+    /// writable by the processes that load from it.
+    ///
+    /// Returns the path to the cached library file.
+    pub fn extract_library_variant_cached<P: AsRef<Path>>(
+        &mut self,
+        platform: Platform,
+        variant: &str,
+        cache_dir: P,
+    ) -> BundleResult<PathBuf> {
+        let variant_info = self.variant_info(platform, variant)?;
+        let digest = variant_info
+            .checksum
+            .strip_prefix("sha256:")
+            .unwrap_or(&variant_info.checksum)
+            .to_string();
+        if digest.len() != 64 || !digest.bytes().all(|b| b.is_ascii_hexdigit()) {
+            return Err(BundleError::InvalidManifest(format!(
+                "Invalid checksum for {}: {}",
+                variant_info.library, variant_info.checksum
+            )));
+        }
+        let file_name = library_file_name(&variant_info.library)?.to_os_string();
+
+        let entry_dir = cache_dir.as_ref().join(&digest);
+        let library = entry_dir.join(&file_name);
+        let stamp = entry_dir.join(STAMP_FILE);
+        if cache_hit(&library, &stamp, &digest) {
+            return Ok(library);
+        }
+
+        fs::create_dir_all(&entry_dir)?;
+        let lock = File::create(entry_dir.join(LOCK_FILE))?;
+        lock.lock()?;
+
+        // Another process may have filled the entry while we waited
+        if cache_hit(&library, &stamp, &digest) {
+            return Ok(library);
+        }
+        let library = self.extract_library_variant(platform, variant, &entry_dir)?;
+        write_stamp(&library, &stamp, &digest)?;
 
+        Ok(library)
+    }
+
+    /// Extract the release variant of the library into a shared cache.
+    ///
+    /// See [`extract_library_variant_cached`](Self::extract_library_variant_cached).
+    pub fn extract_library_cached<P: AsRef<Path>>(
+        &mut self,
+        platform: Platform,
+        cache_dir: P,
+    ) -> BundleResult<PathBuf> {
+        self.extract_library_variant_cached(platform, "release", cache_dir)
+    }
+
+    /// Look up a variant of a platform in the manifest.
+    fn variant_info(&self, platform: Platform, variant: &str) -> BundleResult<&VariantInfo> {
         // Get platform info from manifest
         let platform_info = self.manifest.get_platform(platform).ok_or_else(|| {
             BundleError::UnsupportedPlatform(format!(
@@ -107,61 +217,55 @@ impl BundleLoader {
         })?;
 
         // Get the specific variant
-        let variant_info =
-            platform_info
-                .variant(variant)
-                .ok_or_else(|| BundleError::VariantNotFound {
-                    platform: platform.as_str().to_string(),
-                    variant: variant.to_string(),
-                })?;
-
-        let library_path = variant_info.library.clone();
-        let expected_checksum = variant_info.checksum.clone();
+        platform_info
+            .variant(variant)
+            .ok_or_else(|| BundleError::VariantNotFound {
+                platform: platform.as_str().to_string(),
+                variant: variant.to_string(),
+            })
+    }
 
-        // Read the library from the archive
-        let contents = {
-            let mut library_file = self.archive.by_name(&library_path).map_err(|_| {
-                BundleError::MissingFile(format!("Library not found in bundle: {library_path}"))
-            })?;
+    /// Copy a library entry to `partial_path`, checking its SHA-256 on the way.
+    fn write_verified(
+        &mut self,
+        library_path: &str,
+        expected_checksum: &str,
+        partial_path: &Path,
+    ) -> BundleResult<()> {
+        let mut library_file = self.archive.by_name(library_path).map_err(|_| {
+            BundleError::MissingFile(format!("Library not found in bundle: {library_path}"))
+        })?;
 
-            let mut contents = Vec::new();
-            library_file.read_to_end(&mut contents)?;
-            contents
+        let mut output = File::create(partial_path)?;
+        let actual = if library_file.compression() == CompressionMethod::Stored {
+            copy_stored(
+                &self.path,
+                library_file.data_start(),
+                library_file.size(),
+                &mut output,
+                partial_path,
+            )?
+        } else {
+            copy_hashing(&mut library_file, &mut output)?
         };
 
         // Verify checksum
-        if !verify_sha256(&contents, &expected_checksum) {
-            let actual = crate::builder::compute_sha256(&contents);
+        if !sha256_matches(&actual, expected_checksum) {
             return Err(BundleError::ChecksumMismatch {
-                path: library_path,
-                expected: expected_checksum,
+                path: library_path.to_string(),
+                expected: expected_checksum.to_string(),
                 actual: format!("sha256:{actual}"),
             });
         }
 
-        // Create output directory
-        fs::create_dir_all(output_dir)?;
-
-        // Determine output filename
-        let file_name = Path::new(&library_path)
-            .file_name()
-            .ok_or_else(|| BundleError::InvalidManifest("Invalid library path".to_string()))?;
-
-        let output_path = output_dir.join(file_name);
-
-        // Write the library file
-        fs::write(&output_path, &contents)?;
-
         // Set executable permissions on Unix
         #[cfg(unix)]
         {
             use std::os::unix::fs::PermissionsExt;
-            let mut perms = fs::metadata(&output_path)?.permissions();
-            perms.set_mode(0o755);
-            fs::set_permissions(&output_path, perms)?;
+            output.set_permissions(fs::Permissions::from_mode(0o755))?;
         }
 
-        Ok(output_path)
+        Ok(())
     }
 
     /// List all available variants for a platform.
@@ -244,6 +348,91 @@ impl BundleLoader {
     }
 }
 
+/// Name of the file next to a cached library that records what was verified
+const STAMP_FILE: &str = ".rbcache";
+
+/// Name of the file locked while a cache entry is being filled
+const LOCK_FILE: &str = ".lock";
+
+/// Get the file name of a library from its path in the bundle.
+fn library_file_name(library_path: &str) -> BundleResult<&std::ffi::OsStr> {
+    Path::new(library_path)
+        .file_name()
+        .ok_or_else(|| BundleError::InvalidManifest("Invalid library path".to_string()))
+}
+
+/// Render the cache stamp for a verified library: digest, size and mtime.
+fn stamp_contents(metadata: &fs::Metadata, digest: &str) -> io::Result<String> {
+    let mtime = metadata
+        .modified()?
+        .duration_since(std::time::UNIX_EPOCH)
+        .map_err(io::Error::other)?
+        .as_nanos();
+    Ok(format!("sha256:{digest}\n{}\n{mtime}\n", metadata.len()))
+}
+
+/// Check that a cached library is still the one that was verified.
+fn cache_hit(library: &Path, stamp: &Path, digest: &str) -> bool {
+    let (Ok(metadata), Ok(recorded)) = (fs::metadata(library), fs::read_to_string(stamp)) else {
+        return false;
+    };
+    stamp_contents(&metadata, digest).is_ok_and(|expected| expected == recorded)
+}
+
+/// Record a freshly verified library, replacing any stale stamp atomically.
+fn write_stamp(library: &Path, stamp: &Path, digest: &str) -> io::Result<()> {
+    let contents = stamp_contents(&fs::metadata(library)?, digest)?;
+    let partial = stamp.with_extension(format!("{}.partial", std::process::id()));
+    fs::write(&partial, contents)?;
+    fs::rename(&partial, stamp)
+}
+
+/// Copy `reader` to `output` in chunks and return the hex SHA-256 of the bytes.
+fn copy_hashing(reader: &mut impl Read, output: &mut impl Write) -> io::Result<String> {
+    let mut hasher = Sha256::new();
+    let mut chunk = vec![0u8; CHUNK_SIZE];
+    loop {
+        let read = match reader.read(&mut chunk) {
+            Ok(0) => break,
+            Ok(read) => read,
+            Err(e) if e.kind() == io::ErrorKind::Interrupted => continue,
+            Err(e) => return Err(e),
+        };
+        hasher.update(&chunk[..read]);
+        output.write_all(&chunk[..read])?;
+    }
+    Ok(hex::encode(hasher.finalize()))
+}
+
+/// Copy a stored entry's bytes from the bundle file to `output`.
+///
+/// `io::copy` between two files lets the kernel move the data
+/// (`copy_file_range` on Linux). The checksum is then computed by reading
+/// back `output_path`, the file behind `output`, so it covers the bytes that
+/// were actually written rather than a second read of the bundle.
+fn copy_stored(
+    bundle_path: &Path,
+    start: u64,
+    size: u64,
+    output: &mut File,
+    output_path: &Path,
+) -> io::Result<String> {
+    let mut source = File::open(bundle_path)?;
+    source.seek(SeekFrom::Start(start))?;
+
+    let copied = io::copy(&mut source.take(size), output)?;
+    if copied != size {
+        return Err(io::Error::new(
+            io::ErrorKind::UnexpectedEof,
+            "bundle ended inside a library entry",
+        ));
+    }
+    output.flush()?;
+
+    let mut written = File::open(output_path)?;
+    copy_hashing(&mut written, &mut io::sink())
+}
+
 #[cfg(test)]
 mod tests {
     #![allow(non_snake_case)]
@@ -272,6 +461,37 @@ mod tests {
         bundle_path
     }
 
+    /// Write a bundle by hand so the library entry uses `method`
+    fn create_bundle_with_method(
+        temp_dir: &TempDir,
+        method: zip::CompressionMethod,
+        contents: &[u8],
+        checksum: &str,
+    ) -> PathBuf {
+        let bundle_path = temp_dir.path().join("method.rbp");
+        let library_path = "lib/linux-x86_64/release/libtest.so";
+        let mut manifest = Manifest::new("method-plugin", "1.0.0");
+        manifest.add_platform(Platform::LinuxX86_64, library_path, checksum);
+
+        let file = File::create(&bundle_path).unwrap();
+        let mut zip = zip::ZipWriter::new(file);
+        let options = zip::write::SimpleFileOptions::default();
+        zip.start_file(MANIFEST_FILE, options).unwrap();
+        zip.write_all(manifest.to_json().unwrap().as_bytes())
+            .unwrap();
+        zip.start_file(library_path, options.compression_method(method))
+            .unwrap();
+        zip.write_all(contents).unwrap();
+        zip.finish().unwrap();
+
+        bundle_path
+    }
+
+    /// Library contents spanning several copy chunks
+    fn large_library() -> Vec<u8> {
+        (0..CHUNK_SIZE * 3 + 17).map(|i| (i % 251) as u8).collect()
+    }
+
     fn create_multi_platform_bundle(temp_dir: &TempDir) -> PathBuf {
         let bundle_path = temp_dir.path().join("multi.rbp");
 
@@ -468,6 +688,195 @@ mod tests {
         assert!(lib_path.exists());
     }
 
+    #[test]
+    fn BundleLoader___extract_library___stored_entry___copies_and_verifies() {
+        let temp_dir = TempDir::new().unwrap();
+        let contents = large_library();
+        let bundle_path = create_bundle_with_method(
+            &temp_dir,
+            zip::CompressionMethod::Stored,
+            &contents,
+            &compute_sha256(&contents),
+        );
+        let extract_dir = temp_dir.path().join("extracted");
+
+        let mut loader = BundleLoader::open(&bundle_path).unwrap();
+        let lib_path = loader
+            .extract_library(Platform::LinuxX86_64, &extract_dir)
+            .unwrap();
+
+        assert_eq!(fs::read(&lib_path).unwrap(), contents);
+    }
+
+    #[test]
+    fn copy_stored___range___returns_checksum_of_written_file() {
+        let temp_dir = TempDir::new().unwrap();
+        let source_path = temp_dir.path().join("source.bin");
+        let contents = large_library();
+        fs::write(&source_path, &contents).unwrap();
+        let output_path = temp_dir.path().join("output.bin");
+        let mut output = File::create(&output_path).unwrap();
+
+        let actual = copy_stored(&source_path, 16, 4096, &mut output, &output_path).unwrap();
+
+        let written = fs::read(&output_path).unwrap();
+        assert_eq!(written, &contents[16..16 + 4096]);
+        assert!(sha256_matches(&actual, &compute_sha256(&written)));
+    }
+
+    #[test]
+    fn copy_stored___truncated_source___returns_unexpected_eof() {
+        let temp_dir = TempDir::new().unwrap();
+        let source_path = temp_dir.path().join("source.bin");
+        fs::write(&source_path, b"short").unwrap();
+        let output_path = temp_dir.path().join("output.bin");
+        let mut output = File::create(&output_path).unwrap();
+
+        let result = copy_stored(&source_path, 0, 64, &mut output, &output_path);
+
+        assert_eq!(result.unwrap_err().kind(), io::ErrorKind::UnexpectedEof);
+    }
+
+    #[test]
+    fn BundleLoader___extract_library___deflated_entry___copies_and_verifies() {
+        let temp_dir = TempDir::new().unwrap();
+        let contents = large_library();
+        let bundle_path = create_bundle_with_method(
+            &temp_dir,
+            zip::CompressionMethod::Deflated,
+            &contents,
+            &compute_sha256(&contents),
+        );
+        let extract_dir = temp_dir.path().join("extracted");
+
+        let mut loader = BundleLoader::open(&bundle_path).unwrap();
+        let lib_path = loader
+            .extract_library(Platform::LinuxX86_64, &extract_dir)
+            .unwrap();
+
+        assert_eq!(fs::read(&lib_path).unwrap(), contents);
+    }
+
+    #[test]
+    fn BundleLoader___extract_library___checksum_mismatch___leaves_no_files() {
+        for method in [
+            zip::CompressionMethod::Stored,
+            zip::CompressionMethod::Deflated,
+        ] {
+            let temp_dir = TempDir::new().unwrap();
+            let bundle_path = create_bundle_with_method(
+                &temp_dir,
+                method,
+                b"tampered library",
+                &compute_sha256(b"original library"),
+            );
+            let extract_dir = temp_dir.path().join("extracted");
+
+            let mut loader = BundleLoader::open(&bundle_path).unwrap();
+            let result = loader.extract_library(Platform::LinuxX86_64, &extract_dir);
+
+            let err = result.unwrap_err();
+            assert!(matches!(err, BundleError::ChecksumMismatch { .. }));
+            assert!(
+                err.to_string()
+                    .contains(&compute_sha256(b"tampered library"))
+            );
+            assert_eq!(fs::read_dir(&extract_dir).unwrap().count(), 0);
+        }
+    }
+
+    #[test]
+    fn BundleLoader___extract_library_cached___cold___extracts_into_digest_directory() {
+        let temp_dir = TempDir::new().unwrap();
+        let bundle_path = create_test_bundle(&temp_dir);
+        let cache_dir = temp_dir.path().join("cache");
+
+        let mut loader = BundleLoader::open(&bundle_path).unwrap();
+        let lib_path = loader
+            .extract_library_cached(Platform::LinuxX86_64, &cache_dir)
+            .unwrap();
+
+        let digest = compute_sha256(b"fake library contents");
+        assert_eq!(lib_path, cache_dir.join(&digest).join("libtest.so"));
+        assert_eq!(fs::read(&lib_path).unwrap(), b"fake library contents");
+        assert!(cache_dir.join(&digest).join(STAMP_FILE).exists());
+    }
+
+    #[test]
+    fn BundleLoader___extract_library_cached___warm___skips_extraction() {
+        let cache_dir = TempDir::new().unwrap();
+        let checksum = compute_sha256(b"original library");
+        let original_dir = TempDir::new().unwrap();
+        let original = create_bundle_with_method(
+            &original_dir,
+            zip::CompressionMethod::Deflated,
+            b"original library",
+            &checksum,
+        );
+        let tampered_dir = TempDir::new().unwrap();
+        let tampered = create_bundle_with_method(
+            &tampered_dir,
+            zip::CompressionMethod::Deflated,
+            b"tampered library",
+            &checksum,
+        );
+        BundleLoader::open(&original)
+            .unwrap()
+            .extract_library_cached(Platform::LinuxX86_64, cache_dir.path())
+            .unwrap();
+
+        // A hit never reads the entry, so the bad copy in this bundle goes unnoticed
+        let lib_path = BundleLoader::open(&tampered)
+            .unwrap()
+            .extract_library_cached(Platform::LinuxX86_64, cache_dir.path())
+            .unwrap();
+
+        assert_eq!(fs::read(&lib_path).unwrap(), b"original library");
+    }
+
+    #[test]
+    fn BundleLoader___extract_library_cached___changed_library___extracts_again() {
+        let temp_dir = TempDir::new().unwrap();
+        let bundle_path = create_test_bundle(&temp_dir);
+        let cache_dir = temp_dir.path().join("cache");
+        let mut loader = BundleLoader::open(&bundle_path).unwrap();
+        let lib_path = loader
+            .extract_library_cached(Platform::LinuxX86_64, &cache_dir)
+            .unwrap();
+
+        fs::write(&lib_path, b"overwritten").unwrap();
+        let again = loader
+            .extract_library_cached(Platform::LinuxX86_64, &cache_dir)
+            .unwrap();
+
+        assert_eq!(again, lib_path);
+        assert_eq!(fs::read(&again).unwrap(), b"fake library contents");
+    }
+
+    #[test]
+    fn BundleLoader___extract_library_cached___concurrent_loaders___agree() {
+        let temp_dir = TempDir::new().unwrap();
+        let bundle_path = create_test_bundle(&temp_dir);
+        let cache_dir = temp_dir.path().join("cache");
+
+        let paths: Vec<PathBuf> = std::thread::scope(|scope| {
+            let workers: Vec<_> = (0..4)
+                .map(|_| {
+                    scope.spawn(|| {
+                        BundleLoader::open(&bundle_path)
+                            .unwrap()
+                            .extract_library_cached(Platform::LinuxX86_64, &cache_dir)
+                            .unwrap()
+                    })
+                })
+                .collect();
+            workers.into_iter().map(|w| w.join().unwrap()).collect()
+        });
+
+        assert!(paths.iter().all(|path| path == &paths[0]));
+        assert_eq!(fs::read(&paths[0]).unwrap(), b"fake library contents");
+    }
+
     #[test]
     fn BundleLoader___multi_platform___extract_each_platform() {
         let temp_dir = TempDir::new().unwrap();
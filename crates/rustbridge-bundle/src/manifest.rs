@@ -5,8 +5,8 @@
 //! with the `release` variant being mandatory and the implicit default.
 
 use crate::{BUNDLE_VERSION, BundleError, BundleResult, Platform};
-use serde::{Deserialize, Serialize};
-use std::collections::HashMap;
+use serde::{Deserialize, Serialize, Serializer};
+use std::collections::{BTreeMap, HashMap};
 
 /// Bundle manifest - the main descriptor for a plugin bundle.
 ///
@@ -21,6 +21,7 @@ pub struct Manifest {
 
     /// Platform-specific library information.
     /// Key is the platform string (e.g., "linux-x86_64").
+    #[serde(serialize_with = "serialize_sorted")]
     pub platforms: HashMap<String, PlatformInfo>,
 
     /// Build information (optional).
@@ -51,7 +52,11 @@ pub struct Manifest {
     pub public_key: Option<String>,
 
     /// Schema files embedded in the bundle.
-    #[serde(default, skip_serializing_if = "HashMap::is_empty")]
+    #[serde(
+        default,
+        skip_serializing_if = "HashMap::is_empty",
+        serialize_with = "serialize_sorted"
+    )]
     pub schemas: HashMap<String, SchemaInfo>,
 
     /// Bridge libraries bundled with the plugin (e.g., JNI bridge).
@@ -93,6 +98,7 @@ pub struct PluginInfo {
 pub struct PlatformInfo {
     /// Available variants for this platform.
     /// Must contain at least `release` (mandatory).
+    #[serde(serialize_with = "serialize_sorted")]
     pub variants: HashMap<String, VariantInfo>,
 }
 
@@ -204,7 +210,11 @@ pub struct BuildInfo {
 
     /// Custom key/value metadata for informational purposes.
     /// Can include arbitrary data like repository URL, CI job ID, etc.
-    #[serde(default, skip_serializing_if = "Option::is_none")]
+    #[serde(
+        default,
+        skip_serializing_if = "Option::is_none",
+        serialize_with = "serialize_sorted_option"
+    )]
     pub custom: Option<HashMap<String, String>>,
 }
 
@@ -293,7 +303,11 @@ pub struct SchemaInfo {
 pub struct BridgeInfo {
     /// JNI bridge libraries by platform.
     /// Key is the platform string (e.g., "linux-x86_64").
-    #[serde(default, skip_serializing_if = "HashMap::is_empty")]
+    #[serde(
+        default,
+        skip_serializing_if = "HashMap::is_empty",
+        serialize_with = "serialize_sorted"
+    )]
     pub jni: HashMap<String, PlatformInfo>,
 }
 
@@ -646,6 +660,24 @@ impl Manifest {
     }
 }
 
+/// Serialize a map with sorted keys, so the same manifest always yields the same JSON.
+fn serialize_sorted<S: Serializer, V: Serialize>(
+    map: &HashMap<String, V>,
+    serializer: S,
+) -> Result<S::Ok, S::Error> {
+    map.iter().collect::<BTreeMap<_, _>>().serialize(serializer)
+}
+
+/// [`serialize_sorted`] for optional maps.
+fn serialize_sorted_option<S: Serializer, V: Serialize>(
+    map: &Option<HashMap<String, V>>,
+    serializer: S,
+) -> Result<S::Ok, S::Error> {
+    map.as_ref()
+        .map(|map| map.iter().collect::<BTreeMap<_, _>>())
+        .serialize(serializer)
+}
+
 #[cfg(test)]
 mod tests {
     #![allow(non_snake_case)]
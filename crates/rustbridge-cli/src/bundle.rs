@@ -4,7 +4,7 @@
 
 use anyhow::{Context, Result};
 use minisign::{SecretKey, SecretKeyBox};
-use rustbridge_bundle::{BundleBuilder, BundleLoader, Manifest, Platform};
+use rustbridge_bundle::{BundleBuilder, BundleLoader, Compression, Manifest, Platform};
 use std::collections::HashMap;
 use std::fs;
 use std::path::Path;
@@ -26,12 +26,16 @@ pub fn create(
     no_metadata: bool,
     sbom_files: &[(String, String)],
     custom_metadata: &[(String, String)],
+    compression: Compression,
+    library_compression: Compression,
 ) -> Result<()> {
     println!("Creating bundle: {name} v{version}");
 
     // Create manifest
     let manifest = Manifest::new(name, version);
-    let mut builder = BundleBuilder::new(manifest);
+    let mut builder = BundleBuilder::new(manifest)
+        .with_compression(compression)
+        .with_library_compression(library_compression);
 
     // Load signing key if provided
     if let Some(key_path) = sign_key_path {
@@ -82,8 +86,13 @@ pub fn create(
         let temp_dir = tempfile::tempdir().context("Failed to create temp directory")?;
         let temp_header = temp_dir.path().join(header_name);
 
-        crate::header_gen::run(source_file, temp_header.to_str().unwrap(), false)
-            .with_context(|| format!("Failed to generate C header from {source_file}"))?;
+        crate::header_gen::run(
+            source_file,
+            temp_header.to_str().unwrap(),
+            &Default::default(),
+            false,
+        )
+        .with_context(|| format!("Failed to generate C header from {source_file}"))?;
 
         // Add the generated header to the bundle
         builder = builder
@@ -883,6 +892,8 @@ mod tests {
             true, // Skip metadata for test
             &[],  // No SBOM files
             &[],  // No custom metadata
+            Compression::default(),
+            Compression::default(),
         )
         .unwrap();
 
@@ -929,6 +940,8 @@ mod tests {
             true,
             &[],
             &[],
+            Compression::default(),
+            Compression::default(),
         )
         .unwrap();
 
@@ -970,6 +983,8 @@ mod tests {
             true,
             &[],
             &[],
+            Compression::default(),
+            Compression::default(),
         )
         .unwrap();
 
@@ -1017,6 +1032,8 @@ mod tests {
             true,
             &[],
             &[],
+            Compression::default(),
+            Compression::default(),
         )
         .unwrap();
 
@@ -2,12 +2,19 @@
 //!
 //! This module parses Rust source files and generates C header files
 //! containing equivalent struct definitions for FFI binary transport.
+//! It can also write `BinaryStruct` impls for the same structs, so plugins
+//! get their request layouts checked at dispatch (see
+//! `rustbridge::register_binary_request`), and Java, C# and Python
+//! accessors for them (see [`accessors`]).
 
 use anyhow::{Context, Result};
+use std::collections::HashMap;
 use std::fs;
 use std::path::Path;
 use syn::{Attribute, Fields, Item, Type};
 
+mod accessors;
+
 /// Type mapping from Rust to C
 struct TypeMapping {
     rust_type: &'static str,
@@ -67,14 +74,32 @@ const TYPE_MAPPINGS: &[TypeMapping] = &[
         rust_type: "bool",
         c_type: "bool",
     },
+    TypeMapping {
+        rust_type: "RbString",
+        c_type: "RbString",
+    },
+    TypeMapping {
+        rust_type: "RbBytes",
+        c_type: "RbBytes",
+    },
 ];
 
+/// C types defined in `rustbridge_types.h` rather than the standard headers
+const RUSTBRIDGE_C_TYPES: &[&str] = &["RbString", "RbBytes"];
+
 /// A parsed `#[repr(C)]` struct
 #[derive(Debug)]
 struct CStruct {
     name: String,
     fields: Vec<CField>,
     doc_comment: Option<String>,
+    /// Value of the struct's `VERSION` associated constant
+    version: Option<String>,
+    /// Every field was mapped, so the struct's layout is fully known
+    complete: bool,
+    /// The struct is complete and any bit pattern is a valid value (no
+    /// `bool`), so a `BinaryStruct` impl can be generated
+    plain: bool,
 }
 
 /// A field within a C struct
@@ -104,6 +129,7 @@ fn parse_rust_file(source_path: &Path) -> Result<(Vec<CStruct>, Vec<CConstant>)>
 
     let mut structs = Vec::new();
     let mut constants = Vec::new();
+    let mut versions = HashMap::new();
 
     for item in ast.items {
         match item {
@@ -119,10 +145,19 @@ fn parse_rust_file(source_path: &Path) -> Result<(Vec<CStruct>, Vec<CConstant>)>
                     constants.push(constant);
                 }
             }
+            Item::Impl(i) => {
+                if let Some((name, version)) = parse_version(&i) {
+                    versions.insert(name, version);
+                }
+            }
             _ => {}
         }
     }
 
+    for c_struct in &mut structs {
+        c_struct.version = versions.remove(&c_struct.name);
+    }
+
     Ok((structs, constants))
 }
 
@@ -168,22 +203,35 @@ fn parse_struct(s: &syn::ItemStruct) -> Option<CStruct> {
     let name = s.ident.to_string();
     let doc_comment = extract_doc_comment(&s.attrs);
 
-    let fields = match &s.fields {
-        Fields::Named(named) => named
-            .named
-            .iter()
-            .filter_map(|field| {
-                let field_name = field.ident.as_ref()?.to_string();
-                let c_type = rust_type_to_c(&field.ty)?;
-                let doc_comment = extract_doc_comment(&field.attrs);
-
-                Some(CField {
-                    name: field_name,
-                    c_type,
-                    doc_comment,
+    let (fields, complete, plain) = match &s.fields {
+        Fields::Named(named) => {
+            let fields: Vec<CField> = named
+                .named
+                .iter()
+                .filter_map(|field| {
+                    let field_name = field.ident.as_ref()?.to_string();
+                    let c_type = rust_type_to_c(&field.ty)?;
+                    let doc_comment = extract_doc_comment(&field.attrs);
+
+                    Some(CField {
+                        name: field_name,
+                        c_type,
+                        doc_comment,
+                    })
                 })
-            })
-            .collect(),
+                .collect();
+            // Borrowed types nested in arrays or pointers would escape the
+            // dispatch check, so they only count as whole fields
+            let complete = fields.len() == named.named.len();
+            let plain = complete
+                && fields.iter().all(|f| {
+                    !f.c_type.starts_with("bool")
+                        && RUSTBRIDGE_C_TYPES
+                            .iter()
+                            .all(|ty| f.c_type == *ty || !f.c_type.contains(ty))
+                });
+            (fields, complete, plain)
+        }
         _ => return None, // Only support named fields
     };
 
@@ -191,9 +239,57 @@ fn parse_struct(s: &syn::ItemStruct) -> Option<CStruct> {
         name,
         fields,
         doc_comment,
+        version: None,
+        complete,
+        plain,
     })
 }
 
+/// Find `const VERSION: u8 = N` in an inherent impl, as the binary message
+/// structs declare their current version
+fn parse_version(i: &syn::ItemImpl) -> Option<(String, String)> {
+    if i.trait_.is_some() {
+        return None;
+    }
+    let Type::Path(self_ty) = i.self_ty.as_ref() else {
+        return None;
+    };
+    let name = self_ty.path.segments.last()?.ident.to_string();
+
+    i.items.iter().find_map(|item| match item {
+        syn::ImplItem::Const(c) if c.ident == "VERSION" => match &c.expr {
+            syn::Expr::Lit(syn::ExprLit {
+                lit: syn::Lit::Int(value),
+                ..
+            }) => Some((name.clone(), value.base10_digits().to_string())),
+            _ => None,
+        },
+        _ => None,
+    })
+}
+
+/// Convert a struct name to the prefix of its C macros (`SmallRequestRaw`
+/// becomes `SMALL_REQUEST_RAW`)
+fn macro_prefix(name: &str) -> String {
+    let mut prefix = String::new();
+    for (i, c) in name.chars().enumerate() {
+        if c.is_uppercase() && i > 0 {
+            prefix.push('_');
+        }
+        prefix.push(c.to_ascii_uppercase());
+    }
+    prefix
+}
+
+/// Whether the struct has a `version: u8` field checked against `VERSION`
+fn versioned_field(c_struct: &CStruct) -> bool {
+    c_struct.version.is_some()
+        && c_struct
+            .fields
+            .iter()
+            .any(|f| f.name == "version" && f.c_type == "uint8_t")
+}
+
 /// Parse a constant definition
 fn parse_constant(c: &syn::ItemConst) -> Option<CConstant> {
     let name = c.ident.to_string();
@@ -271,7 +367,16 @@ fn generate_header(structs: &[CStruct], constants: &[CConstant], source_name: &s
     output.push_str(&format!("#define {guard_name}_H\n\n"));
     output.push_str("#include <stdint.h>\n");
     output.push_str("#include <stdbool.h>\n");
-    output.push_str("#include <stddef.h>\n\n");
+    output.push_str("#include <stddef.h>\n");
+    let uses_rustbridge_types = structs.iter().any(|s| {
+        s.fields
+            .iter()
+            .any(|f| RUSTBRIDGE_C_TYPES.iter().any(|ty| f.c_type.contains(ty)))
+    });
+    if uses_rustbridge_types {
+        output.push_str("#include \"rustbridge_types.h\"\n");
+    }
+    output.push('\n');
     output.push_str("#ifdef __cplusplus\n");
     output.push_str("extern \"C\" {\n");
     output.push_str("#endif\n\n");
@@ -317,6 +422,18 @@ fn generate_header(structs: &[CStruct], constants: &[CConstant], source_name: &s
         }
 
         output.push_str(&format!("}} {};\n\n", c_struct.name));
+
+        if let Some(version) = &c_struct.version {
+            output.push_str(&format!(
+                "/** Version the plugin accepts in {}.version */\n",
+                c_struct.name
+            ));
+            output.push_str(&format!(
+                "#define {}_VERSION ((uint8_t){})\n\n",
+                macro_prefix(&c_struct.name),
+                version
+            ));
+        }
     }
 
     // Footer
@@ -328,8 +445,84 @@ fn generate_header(structs: &[CStruct], constants: &[CConstant], source_name: &s
     output
 }
 
+/// Generate `BinaryStruct` impls for the structs, to be `include!`d next to
+/// their definitions
+///
+/// Sizes, alignments and offsets are left to `size_of`, `align_of` and
+/// `offset_of!`, so the descriptors always match what the compiler laid out.
+/// Structs with unmapped or `bool` fields are skipped.
+fn generate_layouts(structs: &[CStruct], source_name: &str) -> String {
+    let mut output = String::new();
+
+    output.push_str("// Auto-generated by rustbridge generate-header\n");
+    output.push_str(&format!("// Source: {source_name}\n"));
+    output.push_str("// DO NOT EDIT - regenerate with: rustbridge generate-header --layouts\n");
+    output.push_str("//\n");
+    output.push_str("// Include from the source file: include!(\"<this file>\");\n");
+
+    for c_struct in structs.iter().filter(|s| s.plain) {
+        let name = &c_struct.name;
+        let offsets = |ty: &str| {
+            c_struct
+                .fields
+                .iter()
+                .filter(|f| f.c_type == ty)
+                .map(|f| format!("::core::mem::offset_of!({name}, {})", f.name))
+                .collect::<Vec<_>>()
+                .join(", ")
+        };
+
+        output.push('\n');
+        output.push_str(&format!(
+            "// SAFETY: generated from the definition of {name}, whose fields are\n"
+        ));
+        output.push_str("// valid for any bit pattern\n");
+        output.push_str(&format!(
+            "unsafe impl rustbridge::BinaryStruct for {name} {{\n"
+        ));
+        output
+            .push_str("    const LAYOUT: rustbridge::BinaryLayout = rustbridge::BinaryLayout {\n");
+        output.push_str(&format!("        name: \"{name}\",\n"));
+        output.push_str(&format!(
+            "        size: ::core::mem::size_of::<{name}>(),\n"
+        ));
+        output.push_str(&format!(
+            "        align: ::core::mem::align_of::<{name}>(),\n"
+        ));
+        if versioned_field(c_struct) {
+            output.push_str("        version: Some((\n");
+            output.push_str(&format!(
+                "            ::core::mem::offset_of!({name}, version),\n"
+            ));
+            output.push_str(&format!("            {name}::VERSION,\n"));
+            output.push_str("        )),\n");
+        } else {
+            output.push_str("        version: None,\n");
+        }
+        output.push_str(&format!("        strings: &[{}],\n", offsets("RbString")));
+        output.push_str(&format!("        bytes: &[{}],\n", offsets("RbBytes")));
+        output.push_str("    };\n");
+        output.push_str("}\n");
+    }
+
+    output
+}
+
+/// Files written alongside the C header
+#[derive(Debug, Default)]
+pub struct Outputs<'a> {
+    /// `BinaryStruct` impls for the plugin, to `include!` next to the structs
+    pub layouts: Option<&'a str>,
+    /// Directory and package of the Java FFM accessor classes
+    pub java: Option<(&'a str, &'a str)>,
+    /// File and namespace of the C# accessor structs
+    pub csharp: Option<(&'a str, &'a str)>,
+    /// Python module of ctypes accessor structs
+    pub python: Option<&'a str>,
+}
+
 /// Run the header generation command
-pub fn run(source: &str, output: &str, verify: bool) -> Result<()> {
+pub fn run(source: &str, output: &str, outputs: &Outputs<'_>, verify: bool) -> Result<()> {
     let source_path = Path::new(source);
     let output_path = Path::new(output);
 
@@ -358,6 +551,30 @@ pub fn run(source: &str, output: &str, verify: bool) -> Result<()> {
 
     println!("Generated header: {}", output_path.display());
 
+    if let Some(layouts) = outputs.layouts {
+        write_generated(
+            Path::new(layouts),
+            "layouts",
+            generate_layouts(&structs, &source_name),
+        )?;
+    }
+    if let Some((dir, package)) = outputs.java {
+        let dir = Path::new(dir);
+        fs::create_dir_all(dir)
+            .with_context(|| format!("Failed to create directory: {}", dir.display()))?;
+        for (name, class) in accessors::generate_java(&structs, &source_name, package) {
+            write_generated(&dir.join(format!("{name}.java")), "Java accessors", class)?;
+        }
+    }
+    if let Some((path, namespace)) = outputs.csharp {
+        let csharp = accessors::generate_csharp(&structs, &source_name, namespace);
+        write_generated(Path::new(path), "C# accessors", csharp)?;
+    }
+    if let Some(path) = outputs.python {
+        let python = accessors::generate_python(&structs, &source_name);
+        write_generated(Path::new(path), "Python accessors", python)?;
+    }
+
     if verify {
         verify_header(output_path)?;
     }
@@ -365,6 +582,13 @@ pub fn run(source: &str, output: &str, verify: bool) -> Result<()> {
     Ok(())
 }
 
+fn write_generated(path: &Path, what: &str, contents: String) -> Result<()> {
+    fs::write(path, contents)
+        .with_context(|| format!("Failed to write {what} file: {}", path.display()))?;
+    println!("Generated {what}: {}", path.display());
+    Ok(())
+}
+
 /// Verify the generated header compiles with a C compiler.
 ///
 /// Uses the `cc` crate to find an available C compiler (gcc, clang, MSVC)
@@ -558,6 +782,9 @@ mod tests {
                 },
             ],
             doc_comment: Some("A test struct".to_string()),
+            version: None,
+            complete: true,
+            plain: true,
         }];
 
         let constants = vec![CConstant {
@@ -578,4 +805,89 @@ mod tests {
         assert!(header.contains("/** The value */"));
         assert!(header.contains(" * A test struct"));
     }
+
+    pub(super) fn parse_items(source: &str) -> (Vec<CStruct>, Vec<CConstant>) {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let path = temp_dir.path().join("messages.rs");
+        fs::write(&path, source).unwrap();
+        parse_rust_file(&path).unwrap()
+    }
+
+    const VERSIONED_SOURCE: &str = r#"
+        #[repr(C)]
+        pub struct LookupRequest {
+            pub version: u8,
+            pub _reserved: [u8; 7],
+            pub key: RbString,
+            pub payload: RbBytes,
+        }
+
+        impl LookupRequest {
+            pub const VERSION: u8 = 3;
+        }
+
+        #[repr(C)]
+        pub struct FlagResponse {
+            pub enabled: bool,
+        }
+    "#;
+
+    #[test]
+    fn rust_type_to_c___borrowed_types___maps_to_rustbridge_types() {
+        let ty: Type = syn::parse_quote!(RbString);
+        assert_eq!(rust_type_to_c(&ty), Some("RbString".to_string()));
+
+        let ty: Type = syn::parse_quote!(rustbridge::RbBytes);
+        assert_eq!(rust_type_to_c(&ty), Some("RbBytes".to_string()));
+    }
+
+    #[test]
+    fn parse_rust_file___version_constant___attached_to_struct() {
+        let (structs, _) = parse_items(VERSIONED_SOURCE);
+
+        assert_eq!(structs[0].version.as_deref(), Some("3"));
+        assert!(structs[0].plain);
+        assert_eq!(structs[1].version, None);
+        assert!(!structs[1].plain);
+    }
+
+    #[test]
+    fn generate_header___versioned_struct___defines_version_and_includes_types() {
+        let (structs, constants) = parse_items(VERSIONED_SOURCE);
+
+        let header = generate_header(&structs, &constants, "messages.rs");
+
+        assert!(header.contains("#include \"rustbridge_types.h\""));
+        assert!(header.contains("    RbString key;"));
+        assert!(header.contains("#define LOOKUP_REQUEST_VERSION ((uint8_t)3)"));
+    }
+
+    #[test]
+    fn generate_layouts___versioned_struct___describes_fields_by_offset() {
+        let (structs, _) = parse_items(VERSIONED_SOURCE);
+
+        let layouts = generate_layouts(&structs, "messages.rs");
+
+        assert!(layouts.contains("unsafe impl rustbridge::BinaryStruct for LookupRequest {"));
+        assert!(layouts.contains("size: ::core::mem::size_of::<LookupRequest>(),"));
+        assert!(layouts.contains("::core::mem::offset_of!(LookupRequest, version),"));
+        assert!(layouts.contains("LookupRequest::VERSION,"));
+        assert!(layouts.contains("strings: &[::core::mem::offset_of!(LookupRequest, key)],"));
+        assert!(layouts.contains("bytes: &[::core::mem::offset_of!(LookupRequest, payload)],"));
+    }
+
+    #[test]
+    fn generate_layouts___bool_field___skips_struct() {
+        let (structs, _) = parse_items(VERSIONED_SOURCE);
+
+        let layouts = generate_layouts(&structs, "messages.rs");
+
+        assert!(!layouts.contains("FlagResponse"));
+    }
+
+    #[test]
+    fn macro_prefix___camel_case___becomes_upper_snake_case() {
+        assert_eq!(macro_prefix("SmallRequestRaw"), "SMALL_REQUEST_RAW");
+        assert_eq!(macro_prefix("Echo"), "ECHO");
+    }
 }
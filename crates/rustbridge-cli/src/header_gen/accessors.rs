@@ -0,0 +1,868 @@
+//! Host-language accessors for binary structs
+//!
+//! Generates Java (FFM), C# and Python types from the same parsed structs as
+//! the C header, so hosts read and write fields in place instead of keeping
+//! hand-written copies of each layout in sync with the Rust definition.
+//!
+//! Field offsets follow the C layout rules for the 64-bit targets bundles
+//! are built for: every field is aligned to its own size (arrays to their
+//! element's), and the struct is padded to its largest alignment. Structs
+//! with fields the header generator could not map are skipped.
+//!
+//! The generated accessors only address memory; they never copy a struct.
+//! Wrapped around the buffer a response was written into by `callRawInto`
+//! (or its C# and Python equivalents), they read the plugin's bytes where
+//! they landed.
+
+use super::{CField, CStruct, versioned_field};
+
+/// A C scalar and its host-language spellings
+struct Scalar {
+    c_type: &'static str,
+    size: usize,
+    /// Java type and the `BinaryStruct` accessor suffix that reads it
+    java: (&'static str, &'static str),
+    csharp: &'static str,
+    python: &'static str,
+}
+
+const SCALARS: &[Scalar] = &[
+    Scalar {
+        c_type: "uint8_t",
+        size: 1,
+        java: ("byte", "Byte"),
+        csharp: "byte",
+        python: "c_uint8",
+    },
+    Scalar {
+        c_type: "int8_t",
+        size: 1,
+        java: ("byte", "Byte"),
+        csharp: "sbyte",
+        python: "c_int8",
+    },
+    Scalar {
+        c_type: "bool",
+        size: 1,
+        java: ("boolean", "Byte"),
+        csharp: "bool",
+        python: "c_bool",
+    },
+    Scalar {
+        c_type: "uint16_t",
+        size: 2,
+        java: ("short", "Short"),
+        csharp: "ushort",
+        python: "c_uint16",
+    },
+    Scalar {
+        c_type: "int16_t",
+        size: 2,
+        java: ("short", "Short"),
+        csharp: "short",
+        python: "c_int16",
+    },
+    Scalar {
+        c_type: "uint32_t",
+        size: 4,
+        java: ("int", "Int"),
+        csharp: "uint",
+        python: "c_uint32",
+    },
+    Scalar {
+        c_type: "int32_t",
+        size: 4,
+        java: ("int", "Int"),
+        csharp: "int",
+        python: "c_int32",
+    },
+    Scalar {
+        c_type: "float",
+        size: 4,
+        java: ("float", "Float"),
+        csharp: "float",
+        python: "c_float",
+    },
+    Scalar {
+        c_type: "uint64_t",
+        size: 8,
+        java: ("long", "Long"),
+        csharp: "ulong",
+        python: "c_uint64",
+    },
+    Scalar {
+        c_type: "int64_t",
+        size: 8,
+        java: ("long", "Long"),
+        csharp: "long",
+        python: "c_int64",
+    },
+    Scalar {
+        c_type: "size_t",
+        size: 8,
+        java: ("long", "Long"),
+        csharp: "nuint",
+        python: "c_size_t",
+    },
+    Scalar {
+        c_type: "ptrdiff_t",
+        size: 8,
+        java: ("long", "Long"),
+        csharp: "nint",
+        python: "c_ssize_t",
+    },
+    Scalar {
+        c_type: "double",
+        size: 8,
+        java: ("double", "Double"),
+        csharp: "double",
+        python: "c_double",
+    },
+];
+
+/// Size of a pointer, and of the data pointer in `RbString`/`RbBytes`
+const POINTER_SIZE: usize = 8;
+
+/// What a field holds, as far as the accessors care
+enum Kind {
+    Scalar(&'static Scalar),
+    /// Fixed array of scalars
+    Array(&'static Scalar, usize),
+    /// `[u8; N]` with a `<name>_len: u32` sibling, read as a UTF-8 string
+    FixedString(usize),
+    /// Raw pointer, exposed as an address
+    Pointer,
+    /// `RbString` or `RbBytes`: a `u32` length, then a data pointer
+    Borrowed,
+}
+
+/// A field placed at its C offset
+struct Placed<'a> {
+    field: &'a CField,
+    offset: usize,
+    kind: Kind,
+}
+
+/// A struct with every field placed
+struct Layout<'a> {
+    c_struct: &'a CStruct,
+    fields: Vec<Placed<'a>>,
+    size: usize,
+    align: usize,
+}
+
+impl Layout<'_> {
+    /// Whether a field has a `<name>_len: u32` sibling
+    fn has_length(&self, field: &CField) -> bool {
+        let len_name = format!("{}_len", field.name);
+        self.fields
+            .iter()
+            .any(|p| p.field.name == len_name && p.field.c_type == "uint32_t")
+    }
+
+    /// Whether a field is the length of a fixed string, so it is set
+    /// together with the string rather than on its own
+    fn is_length(&self, field: &CField) -> bool {
+        self.fields.iter().any(|p| {
+            matches!(p.kind, Kind::FixedString(_))
+                && field.name.strip_suffix("_len") == Some(p.field.name.as_str())
+        })
+    }
+
+    /// Accessors are generated for fields without a leading underscore;
+    /// the rest are reserved or padding
+    fn public_fields(&self) -> impl Iterator<Item = &Placed<'_>> {
+        self.fields
+            .iter()
+            .filter(|p| !p.field.name.starts_with('_'))
+    }
+}
+
+fn scalar(c_type: &str) -> Option<&'static Scalar> {
+    SCALARS.iter().find(|s| s.c_type == c_type)
+}
+
+/// Place every field of a struct, or `None` if a field type is unknown
+fn layout(c_struct: &CStruct) -> Option<Layout<'_>> {
+    if !c_struct.complete {
+        return None;
+    }
+
+    let mut fields = Vec::with_capacity(c_struct.fields.len());
+    let mut offset = 0usize;
+    let mut align = 1;
+    for field in &c_struct.fields {
+        let (kind, size, field_align) = if let Some((elem, len)) = field.c_type.split_once('[') {
+            let elem = scalar(elem)?;
+            let len: usize = len.strip_suffix(']')?.parse().ok()?;
+            (Kind::Array(elem, len), elem.size * len, elem.size)
+        } else if field.c_type.ends_with('*') {
+            (Kind::Pointer, POINTER_SIZE, POINTER_SIZE)
+        } else if field.c_type == "RbString" || field.c_type == "RbBytes" {
+            (Kind::Borrowed, 2 * POINTER_SIZE, POINTER_SIZE)
+        } else {
+            let scalar = scalar(&field.c_type)?;
+            (Kind::Scalar(scalar), scalar.size, scalar.size)
+        };
+        offset = offset.next_multiple_of(field_align);
+        fields.push(Placed {
+            field,
+            offset,
+            kind,
+        });
+        offset += size;
+        align = align.max(field_align);
+    }
+
+    let mut layout = Layout {
+        c_struct,
+        fields,
+        size: offset.next_multiple_of(align),
+        align,
+    };
+    let strings: Vec<usize> = layout
+        .fields
+        .iter()
+        .enumerate()
+        .filter(|(_, p)| match p.kind {
+            Kind::Array(elem, _) => elem.c_type == "uint8_t" && layout.has_length(p.field),
+            _ => false,
+        })
+        .map(|(i, _)| i)
+        .collect();
+    for i in strings {
+        if let Kind::Array(_, len) = layout.fields[i].kind {
+            layout.fields[i].kind = Kind::FixedString(len);
+        }
+    }
+    Some(layout)
+}
+
+/// Place the structs accessors can be generated for
+fn layouts(structs: &[CStruct]) -> Vec<Layout<'_>> {
+    structs.iter().filter_map(layout).collect()
+}
+
+/// `key_len` becomes `KeyLen`
+fn pascal_case(name: &str) -> String {
+    name.split('_')
+        .filter(|part| !part.is_empty())
+        .map(|part| {
+            let mut chars = part.chars();
+            chars
+                .next()
+                .map(|first| first.to_ascii_uppercase().to_string() + chars.as_str())
+                .unwrap_or_default()
+        })
+        .collect()
+}
+
+fn generated_banner(comment: &str, source_name: &str, option: &str) -> String {
+    format!(
+        "{comment} Auto-generated by rustbridge generate-header\n\
+         {comment} Source: {source_name}\n\
+         {comment} DO NOT EDIT - regenerate with: rustbridge generate-header {option}\n"
+    )
+}
+
+/// Generate one Java class per struct, extending `com.rustbridge.ffm.BinaryStruct`
+///
+/// Returns `(class name, source)` pairs. Offsets are literal constants and
+/// fields are read through the base class's unaligned accessors, so the
+/// classes work over native segments and over heap segments wrapping a
+/// `byte[]` alike.
+pub(super) fn generate_java(
+    structs: &[CStruct],
+    source_name: &str,
+    package: &str,
+) -> Vec<(String, String)> {
+    layouts(structs)
+        .iter()
+        .map(|layout| {
+            let name = &layout.c_struct.name;
+            (name.clone(), java_class(layout, source_name, package))
+        })
+        .collect()
+}
+
+fn java_class(layout: &Layout<'_>, source_name: &str, package: &str) -> String {
+    let c_struct = layout.c_struct;
+    let name = &c_struct.name;
+    let constant = |field: &CField| format!("{}_OFFSET", field.name.to_uppercase());
+    let mut output = generated_banner("//", source_name, "--java");
+
+    output.push_str(&format!("package {package};\n\n"));
+    output.push_str("import com.rustbridge.ffm.BinaryStruct;\n\n");
+    output.push_str("import java.lang.foreign.Arena;\n");
+    output.push_str("import java.lang.foreign.MemorySegment;\n");
+    if layout
+        .public_fields()
+        .any(|p| matches!(p.kind, Kind::Array(..)))
+    {
+        output.push_str("import java.util.Objects;\n");
+    }
+    output.push('\n');
+
+    output.push_str("/**\n");
+    match &c_struct.doc_comment {
+        Some(doc) => {
+            for line in doc.lines() {
+                output.push_str(&format!(" * {line}\n"));
+            }
+        }
+        None => output.push_str(&format!(" * {name} from {source_name}.\n")),
+    }
+    output.push_str(" */\n");
+    output.push_str(&format!(
+        "public final class {name} extends BinaryStruct {{\n"
+    ));
+    output.push_str("    /** Size of the struct in bytes. */\n");
+    output.push_str(&format!(
+        "    public static final long BYTE_SIZE = {};\n",
+        layout.size
+    ));
+    output.push_str("    /** Alignment of the struct in bytes. */\n");
+    output.push_str(&format!(
+        "    public static final long BYTE_ALIGNMENT = {};\n",
+        layout.align
+    ));
+    if let Some(version) = &c_struct.version {
+        output.push_str("    /** Version the plugin accepts. */\n");
+        output.push_str(&format!(
+            "    public static final byte CURRENT_VERSION = {version};\n"
+        ));
+    }
+    output.push('\n');
+    for placed in layout.public_fields() {
+        output.push_str(&format!(
+            "    public static final long {} = {};\n",
+            constant(placed.field),
+            placed.offset
+        ));
+    }
+    output.push('\n');
+
+    output.push_str("    /**\n");
+    output.push_str(&format!(
+        "     * Wrap a segment holding a {name}, such as the output of {{@code callRawInto}}.\n"
+    ));
+    output.push_str("     *\n");
+    output.push_str("     * @param segment at least {@link #BYTE_SIZE} bytes\n");
+    output.push_str("     */\n");
+    output.push_str(&format!("    public {name}(MemorySegment segment) {{\n"));
+    output.push_str("        super(segment);\n");
+    output.push_str("        if (segment.byteSize() < BYTE_SIZE) {\n");
+    output.push_str("            throw new IllegalArgumentException(\n");
+    output.push_str(&format!(
+        "                \"{name} needs \" + BYTE_SIZE + \" bytes, got \" + segment.byteSize());\n"
+    ));
+    output.push_str("        }\n");
+    output.push_str("    }\n\n");
+
+    output.push_str("    /**\n");
+    if versioned_field(c_struct) {
+        output.push_str(&format!(
+            "     * Allocate a zeroed {name} with the current version set.\n"
+        ));
+    } else {
+        output.push_str(&format!("     * Allocate a zeroed {name}.\n"));
+    }
+    output.push_str("     *\n");
+    output.push_str("     * @param arena the arena that owns the memory\n");
+    output.push_str("     * @return the new struct\n");
+    output.push_str("     */\n");
+    output.push_str(&format!(
+        "    public static {name} allocate(Arena arena) {{\n"
+    ));
+    let segment = "arena.allocate(BYTE_SIZE, BYTE_ALIGNMENT)";
+    if versioned_field(c_struct) {
+        output.push_str(&format!("        {name} struct = new {name}({segment});\n"));
+        output.push_str("        struct.setVersion(CURRENT_VERSION);\n");
+        output.push_str("        return struct;\n");
+    } else {
+        output.push_str(&format!("        return new {name}({segment});\n"));
+    }
+    output.push_str("    }\n\n");
+
+    output.push_str("    @Override\n");
+    output.push_str("    public long byteSize() {\n");
+    output.push_str("        return BYTE_SIZE;\n");
+    output.push_str("    }\n");
+
+    for placed in layout.public_fields() {
+        let field = placed.field;
+        let property = pascal_case(&field.name);
+        let offset = constant(field);
+        output.push('\n');
+        if let Some(doc) = &field.doc_comment {
+            output.push_str(&format!("    /** {doc} */\n"));
+        }
+        match placed.kind {
+            Kind::Scalar(scalar) if scalar.c_type == "bool" => {
+                output.push_str(&format!(
+                    "    public boolean get{property}() {{\n        return getByte({offset}) != 0;\n    }}\n\n"
+                ));
+                output.push_str(&format!(
+                    "    public void set{property}(boolean value) {{\n        setByte({offset}, (byte) (value ? 1 : 0));\n    }}\n"
+                ));
+            }
+            Kind::Scalar(scalar) => {
+                let (ty, accessor) = scalar.java;
+                output.push_str(&format!(
+                    "    public {ty} get{property}() {{\n        return get{accessor}({offset});\n    }}\n"
+                ));
+                if !layout.is_length(field) {
+                    output.push_str(&format!(
+                        "\n    public void set{property}({ty} value) {{\n        set{accessor}({offset}, value);\n    }}\n"
+                    ));
+                }
+            }
+            Kind::Array(elem, len) => {
+                let (ty, accessor) = elem.java;
+                let element = format!(
+                    "{offset} + (long) Objects.checkIndex(index, {len}) * {}",
+                    elem.size
+                );
+                if elem.c_type == "bool" {
+                    output.push_str(&format!(
+                        "    public boolean get{property}(int index) {{\n        return getByte({element}) != 0;\n    }}\n\n"
+                    ));
+                    output.push_str(&format!(
+                        "    public void set{property}(int index, boolean value) {{\n        setByte({element}, (byte) (value ? 1 : 0));\n    }}\n"
+                    ));
+                } else {
+                    output.push_str(&format!(
+                        "    public {ty} get{property}(int index) {{\n        return get{accessor}({element});\n    }}\n\n"
+                    ));
+                    output.push_str(&format!(
+                        "    public void set{property}(int index, {ty} value) {{\n        set{accessor}({element}, value);\n    }}\n"
+                    ));
+                }
+            }
+            Kind::FixedString(len) => {
+                let len_offset = format!("{}_LEN_OFFSET", field.name.to_uppercase());
+                output.push_str(&format!(
+                    "    public String get{property}() {{\n        return getFixedString({offset}, {len}, {len_offset});\n    }}\n\n"
+                ));
+                output.push_str(&format!(
+                    "    public void set{property}(String value) {{\n        setFixedString(value, {offset}, {len}, {len_offset});\n    }}\n"
+                ));
+            }
+            Kind::Pointer => {
+                output.push_str(&format!(
+                    "    public long get{property}() {{\n        return getLong({offset});\n    }}\n\n"
+                ));
+                output.push_str(&format!(
+                    "    public void set{property}(long address) {{\n        setLong({offset}, address);\n    }}\n"
+                ));
+            }
+            Kind::Borrowed => {
+                output.push_str(&format!(
+                    "    public int get{property}Len() {{\n        return getInt({offset});\n    }}\n\n"
+                ));
+                output.push_str(&format!(
+                    "    public long get{property}Address() {{\n        return getLong({offset} + {POINTER_SIZE});\n    }}\n\n"
+                ));
+                output.push_str(&format!(
+                    "    /** Point the field at native memory, which must outlive the call. */\n    public void set{property}(MemorySegment data) {{\n        setInt({offset}, Math.toIntExact(data.byteSize()));\n        setLong({offset} + {POINTER_SIZE}, data.address());\n    }}\n"
+                ));
+            }
+        }
+    }
+
+    output.push_str("}\n");
+    output
+}
+
+/// Generate C# structs implementing `RustBridge.IBinaryStruct`, in one file
+///
+/// The structs use explicit field offsets, with `[InlineArray]` buffers for
+/// arrays, so they need no unsafe code. `View` reinterprets a span (the
+/// output of `CallRawInto`) as the struct in place.
+pub(super) fn generate_csharp(structs: &[CStruct], source_name: &str, namespace: &str) -> String {
+    let mut output = generated_banner("//", source_name, "--csharp");
+    output.push('\n');
+    output.push_str("using System;\n");
+    output.push_str("using System.Runtime.CompilerServices;\n");
+    output.push_str("using System.Runtime.InteropServices;\n");
+    output.push_str("using System.Text;\n");
+    output.push_str("using RustBridge;\n\n");
+    output.push_str(&format!("namespace {namespace};\n"));
+
+    for layout in layouts(structs) {
+        output.push('\n');
+        csharp_struct(&layout, source_name, &mut output);
+    }
+    output
+}
+
+fn csharp_struct(layout: &Layout<'_>, source_name: &str, output: &mut String) {
+    let c_struct = layout.c_struct;
+    let name = &c_struct.name;
+
+    output.push_str("/// <summary>\n");
+    match &c_struct.doc_comment {
+        Some(doc) => {
+            for line in doc.lines() {
+                output.push_str(&format!("/// {line}\n"));
+            }
+        }
+        None => output.push_str(&format!("/// {name} from {source_name}.\n")),
+    }
+    output.push_str("/// </summary>\n");
+    output.push_str(&format!(
+        "[StructLayout(LayoutKind.Explicit, Size = {})]\n",
+        layout.size
+    ));
+    output.push_str(&format!("public struct {name} : IBinaryStruct\n{{\n"));
+    output.push_str("    /// <summary>Size of the struct in bytes.</summary>\n");
+    output.push_str(&format!(
+        "    public const int StructSize = {};\n",
+        layout.size
+    ));
+    if let Some(version) = &c_struct.version {
+        output.push_str("    /// <summary>Version the plugin accepts.</summary>\n");
+        output.push_str(&format!(
+            "    public const byte CurrentVersion = {version};\n"
+        ));
+    }
+
+    for placed in layout.public_fields() {
+        let field = placed.field;
+        let property = pascal_case(&field.name);
+        let offset = placed.offset;
+        output.push('\n');
+        if let Some(doc) = &field.doc_comment {
+            output.push_str(&format!("    /// <summary>{doc}</summary>\n"));
+        }
+        match placed.kind {
+            Kind::Scalar(scalar) => {
+                output.push_str(&format!(
+                    "    [FieldOffset({offset})] public {} {property};\n",
+                    scalar.csharp
+                ));
+            }
+            Kind::Array(_, _) | Kind::FixedString(_) => {
+                output.push_str(&format!(
+                    "    [FieldOffset({offset})] public {property}Buffer {property};\n"
+                ));
+            }
+            Kind::Pointer => {
+                output.push_str(&format!(
+                    "    [FieldOffset({offset})] public nint {property};\n"
+                ));
+            }
+            Kind::Borrowed => {
+                output.push_str(&format!(
+                    "    [FieldOffset({offset})] public uint {property}Len;\n"
+                ));
+                output.push_str(&format!(
+                    "    [FieldOffset({})] public nint {property}Data;\n",
+                    offset + POINTER_SIZE
+                ));
+            }
+        }
+    }
+
+    output.push_str("\n    public readonly int ByteSize => StructSize;\n\n");
+    output.push_str("    /// <summary>\n");
+    output.push_str(&format!(
+        "    /// View bytes holding a {name}, such as the output of <c>CallRawInto</c>, without copying.\n"
+    ));
+    output.push_str("    /// </summary>\n");
+    output.push_str(&format!(
+        "    public static ref readonly {name} View(ReadOnlySpan<byte> bytes) =>\n"
+    ));
+    output.push_str(&format!(
+        "        ref MemoryMarshal.AsRef<{name}>(bytes[..StructSize]);\n"
+    ));
+
+    for placed in layout.public_fields() {
+        let Kind::FixedString(len) = placed.kind else {
+            continue;
+        };
+        let property = pascal_case(&placed.field.name);
+        output.push('\n');
+        output.push_str(&format!(
+            "    public readonly string Get{property}() =>\n        Encoding.UTF8.GetString(((ReadOnlySpan<byte>){property})[..(int)Math.Min({property}Len, {len}u)]);\n\n"
+        ));
+        output.push_str(&format!(
+            "    public void Set{property}(string value)\n    {{\n"
+        ));
+        output.push_str(&format!("        Span<byte> buffer = {property};\n"));
+        output.push_str("        buffer.Clear();\n");
+        output.push_str("        var bytes = Encoding.UTF8.GetBytes(value);\n");
+        output.push_str(&format!(
+            "        var len = Math.Min(bytes.Length, {len});\n"
+        ));
+        output.push_str("        bytes.AsSpan(0, len).CopyTo(buffer);\n");
+        output.push_str(&format!("        {property}Len = (uint)len;\n"));
+        output.push_str("    }\n");
+    }
+
+    for placed in layout.public_fields() {
+        let (elem, len) = match placed.kind {
+            Kind::Array(elem, len) => (elem.csharp, len),
+            Kind::FixedString(len) => ("byte", len),
+            _ => continue,
+        };
+        let property = pascal_case(&placed.field.name);
+        output.push('\n');
+        output.push_str(&format!("    [InlineArray({len})]\n"));
+        output.push_str(&format!("    public struct {property}Buffer\n    {{\n"));
+        output.push_str(&format!("        private {elem} _element0;\n"));
+        output.push_str("    }\n");
+    }
+
+    output.push_str("}\n");
+}
+
+/// Generate a Python module of ctypes structures
+///
+/// ctypes reads and writes structure fields in the structure's own buffer,
+/// so a response written by `call_raw_into`, or a `view` over any writable
+/// buffer, is used without copies. Each structure's size is asserted at
+/// import against the size computed here.
+pub(super) fn generate_python(structs: &[CStruct], source_name: &str) -> String {
+    let layouts = layouts(structs);
+    let mut output = generated_banner("#", source_name, "--python");
+    output.push_str(&format!(
+        "\"\"\"Binary message structs from {source_name}.\"\"\"\n\n"
+    ));
+    output.push_str("from __future__ import annotations\n\n");
+
+    let mut imports: Vec<&str> = vec!["Structure", "sizeof"];
+    for placed in layouts.iter().flat_map(|l| &l.fields) {
+        match placed.kind {
+            Kind::Scalar(scalar) | Kind::Array(scalar, _) => imports.push(scalar.python),
+            Kind::FixedString(_) => imports.push("c_uint8"),
+            Kind::Pointer => imports.push("c_void_p"),
+            Kind::Borrowed => imports.extend(["c_uint32", "c_void_p"]),
+        }
+    }
+    imports.sort_unstable_by_key(|import| (import.starts_with("c_"), *import));
+    imports.dedup();
+    output.push_str(&format!("from ctypes import {}\n", imports.join(", ")));
+
+    if layouts
+        .iter()
+        .any(|l| l.fields.iter().any(|p| matches!(p.kind, Kind::Borrowed)))
+    {
+        output.push_str("\n\nclass RbSlice(Structure):\n");
+        output.push_str(
+            "    \"\"\"Layout of RbString and RbBytes: a length, then a data pointer.\"\"\"\n\n",
+        );
+        output.push_str("    _fields_ = [(\"len\", c_uint32), (\"data\", c_void_p)]\n");
+    }
+
+    for layout in &layouts {
+        python_class(layout, source_name, &mut output);
+    }
+    output
+}
+
+fn python_class(layout: &Layout<'_>, source_name: &str, output: &mut String) {
+    let c_struct = layout.c_struct;
+    let name = &c_struct.name;
+
+    output.push_str(&format!("\n\nclass {name}(Structure):\n"));
+    let doc = c_struct
+        .doc_comment
+        .clone()
+        .unwrap_or_else(|| format!("{name} from {source_name}."));
+    output.push_str(&format!(
+        "    \"\"\"{}\"\"\"\n\n",
+        doc.replace('\n', "\n    ")
+    ));
+    output.push_str("    _fields_ = [\n");
+    for placed in &layout.fields {
+        let ty = match placed.kind {
+            Kind::Scalar(scalar) => scalar.python.to_string(),
+            Kind::Array(elem, len) => format!("{} * {len}", elem.python),
+            Kind::FixedString(len) => format!("c_uint8 * {len}"),
+            Kind::Pointer => "c_void_p".to_string(),
+            Kind::Borrowed => "RbSlice".to_string(),
+        };
+        output.push_str(&format!("        (\"{}\", {ty}),\n", placed.field.name));
+    }
+    output.push_str("    ]\n\n");
+    output.push_str(&format!("    SIZE = {}\n", layout.size));
+    if let Some(version) = &c_struct.version {
+        output.push_str(&format!("    CURRENT_VERSION = {version}\n"));
+    }
+
+    output.push_str("\n    @classmethod\n");
+    output.push_str(&format!(
+        "    def view(cls, buffer: bytearray | memoryview) -> {name}:\n"
+    ));
+    output.push_str(
+        "        \"\"\"View a writable buffer holding the struct in place, without copying.\"\"\"\n",
+    );
+    output.push_str("        return cls.from_buffer(buffer)\n");
+
+    for placed in &layout.fields {
+        let Kind::FixedString(len) = placed.kind else {
+            continue;
+        };
+        let field = &placed.field.name;
+        output.push_str(&format!("\n    def get_{field}(self) -> str:\n"));
+        output.push_str(&format!(
+            "        return str(memoryview(self.{field}).cast(\"B\")[: min(self.{field}_len, {len})], \"utf-8\")\n"
+        ));
+        output.push_str(&format!(
+            "\n    def set_{field}(self, value: str) -> None:\n"
+        ));
+        output.push_str(&format!("        data = value.encode(\"utf-8\")[:{len}]\n"));
+        output.push_str(&format!(
+            "        buffer = memoryview(self.{field}).cast(\"B\")\n"
+        ));
+        output.push_str(&format!("        buffer[:] = bytes({len})\n"));
+        output.push_str("        buffer[: len(data)] = data\n");
+        output.push_str(&format!("        self.{field}_len = len(data)\n"));
+    }
+
+    output.push_str(&format!(
+        "\n\nassert sizeof({name}) == {name}.SIZE, \"{name} layout differs from {source_name}\"\n"
+    ));
+}
+
+#[cfg(test)]
+mod tests {
+    #![allow(non_snake_case)]
+
+    use super::super::tests::parse_items;
+    use super::*;
+
+    const SOURCE: &str = r#"
+        /// A lookup
+        #[repr(C)]
+        pub struct LookupRequest {
+            pub version: u8,
+            pub _reserved: [u8; 3],
+            /// Key to look up
+            pub key: [u8; 32],
+            pub key_len: u32,
+            pub payload: RbBytes,
+            pub ttl: u16,
+            pub hit: bool,
+        }
+
+        impl LookupRequest {
+            pub const VERSION: u8 = 2;
+        }
+
+        #[repr(C)]
+        pub struct Unmapped {
+            pub value: u32,
+            pub other: String,
+        }
+    "#;
+
+    #[test]
+    fn layout___mixed_fields___follows_c_alignment() {
+        let (structs, _) = parse_items(SOURCE);
+
+        let layout = layout(&structs[0]).unwrap();
+
+        let offsets: Vec<(&str, usize)> = layout
+            .fields
+            .iter()
+            .map(|p| (p.field.name.as_str(), p.offset))
+            .collect();
+        assert_eq!(
+            offsets,
+            [
+                ("version", 0),
+                ("_reserved", 1),
+                ("key", 4),
+                ("key_len", 36),
+                ("payload", 40),
+                ("ttl", 56),
+                ("hit", 58),
+            ]
+        );
+        assert_eq!(layout.size, 64);
+        assert_eq!(layout.align, 8);
+        assert!(matches!(layout.fields[2].kind, Kind::FixedString(32)));
+    }
+
+    #[test]
+    fn layout___unmapped_field___skips_struct() {
+        let (structs, _) = parse_items(SOURCE);
+
+        assert!(layout(&structs[1]).is_none());
+        assert_eq!(layouts(&structs).len(), 1);
+    }
+
+    #[test]
+    fn pascal_case___snake_case___joins_capitalized_parts() {
+        assert_eq!(pascal_case("key_len"), "KeyLen");
+        assert_eq!(pascal_case("version"), "Version");
+    }
+
+    #[test]
+    fn generate_java___versioned_struct___writes_offsets_and_accessors() {
+        let (structs, _) = parse_items(SOURCE);
+
+        let classes = generate_java(&structs, "messages.rs", "com.example.messages");
+
+        assert_eq!(classes.len(), 1);
+        let (name, java) = &classes[0];
+        assert_eq!(name, "LookupRequest");
+        assert!(java.contains("package com.example.messages;"));
+        assert!(java.contains("public final class LookupRequest extends BinaryStruct {"));
+        assert!(java.contains("public static final long BYTE_SIZE = 64;"));
+        assert!(java.contains("public static final byte CURRENT_VERSION = 2;"));
+        assert!(java.contains("public static final long KEY_LEN_OFFSET = 36;"));
+        assert!(java.contains("return getFixedString(KEY_OFFSET, 32, KEY_LEN_OFFSET);"));
+        assert!(java.contains("public int getKeyLen()"));
+        assert!(!java.contains("setKeyLen"));
+        assert!(java.contains("public long getPayloadAddress()"));
+        assert!(java.contains("public short getTtl()"));
+        assert!(java.contains("return getByte(HIT_OFFSET) != 0;"));
+        assert!(java.contains("struct.setVersion(CURRENT_VERSION);"));
+        assert!(!java.contains("getReserved"));
+    }
+
+    #[test]
+    fn generate_csharp___versioned_struct___uses_explicit_offsets() {
+        let (structs, _) = parse_items(SOURCE);
+
+        let csharp = generate_csharp(&structs, "messages.rs", "Example.Messages");
+
+        assert!(csharp.contains("namespace Example.Messages;"));
+        assert!(csharp.contains("[StructLayout(LayoutKind.Explicit, Size = 64)]"));
+        assert!(csharp.contains("public struct LookupRequest : IBinaryStruct"));
+        assert!(csharp.contains("public const byte CurrentVersion = 2;"));
+        assert!(csharp.contains("[FieldOffset(4)] public KeyBuffer Key;"));
+        assert!(csharp.contains("[FieldOffset(48)] public nint PayloadData;"));
+        assert!(csharp.contains("[FieldOffset(58)] public bool Hit;"));
+        assert!(
+            csharp.contains(
+                "public static ref readonly LookupRequest View(ReadOnlySpan<byte> bytes)"
+            )
+        );
+        assert!(csharp.contains("public readonly string GetKey()"));
+        assert!(csharp.contains("[InlineArray(32)]"));
+        assert!(!csharp.contains("Unmapped"));
+    }
+
+    #[test]
+    fn generate_python___versioned_struct___declares_ctypes_fields() {
+        let (structs, _) = parse_items(SOURCE);
+
+        let python = generate_python(&structs, "messages.rs");
+
+        assert!(python.contains(
+            "from ctypes import Structure, sizeof, c_bool, c_uint16, c_uint32, c_uint8, c_void_p"
+        ));
+        assert!(python.contains("class RbSlice(Structure):"));
+        assert!(python.contains("class LookupRequest(Structure):"));
+        assert!(python.contains("(\"_reserved\", c_uint8 * 3),"));
+        assert!(python.contains("(\"payload\", RbSlice),"));
+        assert!(python.contains("    SIZE = 64\n"));
+        assert!(python.contains("    CURRENT_VERSION = 2\n"));
+        assert!(python.contains("def get_key(self) -> str:"));
+        assert!(python.contains("assert sizeof(LookupRequest) == LookupRequest.SIZE"));
+    }
+}
@@ -7,6 +7,7 @@
 //! - `rustbridge bundle` - Create, inspect, or extract plugin bundles
 
 use clap::{Parser, Subcommand};
+use rustbridge_bundle::Compression;
 
 mod bundle;
 mod codegen;
@@ -69,6 +70,31 @@ enum Commands {
         #[arg(short, long, default_value = "messages.h")]
         output: String,
 
+        /// Also write `BinaryStruct` impls for the structs to this file, for
+        /// `include!` next to them, so their requests are checked at dispatch
+        #[arg(long)]
+        layouts: Option<String>,
+
+        /// Also write Java FFM accessor classes for the structs to this directory
+        #[arg(long)]
+        java: Option<String>,
+
+        /// Package of the generated Java classes
+        #[arg(long, default_value = "com.rustbridge.generated")]
+        java_package: String,
+
+        /// Also write C# accessor structs for the structs to this file
+        #[arg(long)]
+        csharp: Option<String>,
+
+        /// Namespace of the generated C# structs
+        #[arg(long, default_value = "RustBridge.Generated")]
+        csharp_namespace: String,
+
+        /// Also write Python ctypes accessor structs to this module
+        #[arg(long)]
+        python: Option<String>,
+
         /// Verify the generated header compiles with a C compiler
         #[arg(short, long)]
         verify: bool,
@@ -169,6 +195,17 @@ enum BundleAction {
         /// Example: --metadata ci_job_id=12345
         #[arg(long, value_name = "KEY=VALUE")]
         metadata: Vec<String>,
+
+        /// Compression for the manifest, schemas and other files
+        /// Format: stored, deflate[:1-9] or zstd[:1-22]
+        #[arg(long, value_name = "METHOD[:LEVEL]", default_value = "deflate")]
+        compression: Compression,
+
+        /// Compression for plugin and JNI bridge libraries
+        /// Use "stored" so loaders can copy libraries out without inflating them.
+        /// zstd bundles can only be read by the Rust loader.
+        #[arg(long, value_name = "METHOD[:LEVEL]", default_value = "deflate")]
+        library_compression: Compression,
     },
 
     /// Combine multiple bundles into one
@@ -278,9 +315,23 @@ fn main() -> anyhow::Result<()> {
         Commands::GenerateHeader {
             source,
             output,
+            layouts,
+            java,
+            java_package,
+            csharp,
+            csharp_namespace,
+            python,
             verify,
         } => {
-            header_gen::run(&source, &output, verify)?;
+            let outputs = header_gen::Outputs {
+                layouts: layouts.as_deref(),
+                java: java.as_deref().map(|dir| (dir, java_package.as_str())),
+                csharp: csharp
+                    .as_deref()
+                    .map(|path| (path, csharp_namespace.as_str())),
+                python: python.as_deref(),
+            };
+            header_gen::run(&source, &output, &outputs, verify)?;
         }
         Commands::Keygen { output, force } => {
             keygen::run(output, force)?;
@@ -301,6 +352,8 @@ fn main() -> anyhow::Result<()> {
                 no_metadata,
                 sbom,
                 metadata,
+                compression,
+                library_compression,
             } => {
                 // Parse library arguments (PLATFORM:PATH or PLATFORM:VARIANT:PATH)
                 let libs: Vec<(String, String, String)> = libraries
@@ -413,6 +466,8 @@ fn main() -> anyhow::Result<()> {
                     no_metadata,
                     &sbom_files,
                     &custom_metadata,
+                    compression,
+                    library_compression,
                 )?;
             }
             BundleAction::Combine {
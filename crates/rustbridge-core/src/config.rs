@@ -24,17 +24,241 @@ pub struct PluginConfig {
     #[serde(default)]
     pub worker_threads: Option<usize>,
 
+    /// How the plugin's Tokio runtime is built and where its threads run
+    #[serde(default)]
+    pub runtime: RuntimeSettings,
+
     /// Initial log level
     #[serde(default = "default_log_level")]
     pub log_level: String,
 
+    /// How log events reach the host's log callback
+    #[serde(default)]
+    pub logging: LoggingConfig,
+
     /// Maximum concurrent async operations
     #[serde(default = "default_max_concurrent")]
     pub max_concurrent_ops: usize,
 
+    /// What happens to requests that arrive while `max_concurrent_ops` are in flight
+    #[serde(default)]
+    pub admission: AdmissionConfig,
+
     /// Shutdown timeout in milliseconds
     #[serde(default = "default_shutdown_timeout")]
     pub shutdown_timeout_ms: u64,
+
+    /// How handler JSON is wrapped in the response envelope
+    #[serde(default)]
+    pub response_encoding: ResponseEncoding,
+
+    /// Per-handler call counts and latency histograms
+    #[serde(default)]
+    pub metrics: MetricsConfig,
+
+    /// Per-call timelines of slow calls, kept for forensics
+    #[serde(default)]
+    pub flight_recorder: FlightRecorderConfig,
+}
+
+/// Per-handler metrics options
+///
+/// Off by default. When enabled, each call reads the clock once per phase
+/// and adds to a few per-thread counters; `plugin_get_metrics` returns them.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(default)]
+pub struct MetricsConfig {
+    /// Record call counts and latency histograms for every handler
+    pub enabled: bool,
+}
+
+/// Flight recorder options
+///
+/// Off by default. When enabled, each call reads the clock once per phase
+/// and calls that take at least `slow_call_threshold_us` are copied into a
+/// small ring per thread; `plugin_get_slow_calls` returns the latest ones.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(default)]
+pub struct FlightRecorderConfig {
+    /// Record slow calls
+    pub enabled: bool,
+
+    /// Calls at least this long, in microseconds, are recorded
+    pub slow_call_threshold_us: u64,
+
+    /// Slow calls kept per thread; the oldest is overwritten when full
+    pub capacity: usize,
+}
+
+impl Default for FlightRecorderConfig {
+    fn default() -> Self {
+        Self {
+            enabled: false,
+            slow_call_threshold_us: 1000,
+            capacity: 64,
+        }
+    }
+}
+
+/// Strategy for wrapping a handler's JSON bytes in the response envelope
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum ResponseEncoding {
+    /// Write the envelope prefix and suffix directly around the payload bytes
+    ///
+    /// The payload is validated but not re-encoded, so it reaches the host
+    /// exactly as the handler produced it.
+    #[default]
+    Splice,
+
+    /// Parse the payload into a JSON value and serialize the whole envelope
+    ///
+    /// Normalizes the payload (compact, object keys sorted) at the cost of an
+    /// extra parse and encode per response.
+    Reencode,
+}
+
+/// Log delivery options
+///
+/// Like the log level, these apply only to the plugin they configure.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(default)]
+pub struct LoggingConfig {
+    /// Whether events are delivered on the emitting thread or by a drainer thread
+    pub delivery: LogDelivery,
+
+    /// Events held in the asynchronous queue before new ones are dropped
+    pub queue_capacity: usize,
+
+    /// Most events handed to the host in one batch
+    pub batch_size: usize,
+
+    /// How often the drainer wakes when fewer than `batch_size` events are queued
+    pub flush_interval_ms: u64,
+}
+
+impl Default for LoggingConfig {
+    fn default() -> Self {
+        Self {
+            delivery: LogDelivery::default(),
+            queue_capacity: 8192,
+            batch_size: 256,
+            flush_interval_ms: 10,
+        }
+    }
+}
+
+/// How log events are handed to the host
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum LogDelivery {
+    /// Call the host's callback on the thread that emitted the event
+    ///
+    /// Every event is seen immediately and in order, which helps debugging,
+    /// but each one costs an upcall on the request path.
+    #[default]
+    Sync,
+
+    /// Queue events and deliver them in batches from a dedicated thread
+    ///
+    /// The emitting thread only formats the message and pushes it onto a
+    /// bounded lock-free queue. When the queue is full the event is dropped
+    /// and counted instead of blocking the caller.
+    Async,
+}
+
+/// Tokio runtime options for a plugin
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(default)]
+pub struct RuntimeSettings {
+    /// Scheduler used by the runtime
+    pub flavor: RuntimeFlavor,
+
+    /// Use the process-wide runtime of this flavor instead of building one
+    ///
+    /// The shared runtime is built by the first plugin that asks for it, so
+    /// its thread and affinity settings win; later plugins reuse it as is and
+    /// log a warning if they asked for different ones. It shuts down with
+    /// the last plugin using it.
+    pub shared: bool,
+
+    /// Maximum threads in the blocking pool (default: 512)
+    pub max_blocking_threads: Option<usize>,
+
+    /// CPUs the runtime's threads may run on (empty = no restriction)
+    pub cpu_affinity: Vec<usize>,
+
+    /// Restrict the runtime's threads to the CPUs of this NUMA node
+    ///
+    /// Combined with `cpu_affinity`, only CPUs in both sets are used.
+    pub numa_node: Option<usize>,
+}
+
+/// Scheduler flavor for a plugin's Tokio runtime
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum RuntimeFlavor {
+    /// Work-stealing scheduler with `worker_threads` workers
+    #[default]
+    MultiThread,
+
+    /// Single scheduler thread, for plugins with little async work
+    ///
+    /// Spawned tasks run on one dedicated thread; synchronous calls still
+    /// run their handler on the calling thread.
+    CurrentThread,
+}
+
+/// Admission control for requests beyond `max_concurrent_ops`
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(default)]
+pub struct AdmissionConfig {
+    /// Queueing mode once the concurrency limit is reached
+    pub mode: AdmissionMode,
+
+    /// Longest a queued request waits for a slot before it is rejected
+    pub max_wait_ms: u64,
+
+    /// Maximum number of queued requests; arrivals beyond it are rejected
+    pub max_queue_depth: usize,
+
+    /// Queue deadline used by `AdaptiveLifo` while the queue is overloaded
+    pub codel_target_ms: u64,
+
+    /// How long the queue must stay non-empty before it counts as overloaded
+    pub codel_interval_ms: u64,
+}
+
+impl Default for AdmissionConfig {
+    fn default() -> Self {
+        Self {
+            mode: AdmissionMode::default(),
+            max_wait_ms: 10,
+            max_queue_depth: 1024,
+            codel_target_ms: 5,
+            codel_interval_ms: 100,
+        }
+    }
+}
+
+/// How requests wait for a free slot once the concurrency limit is reached
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum AdmissionMode {
+    /// Reject immediately with `TooManyRequests`
+    #[default]
+    Reject,
+
+    /// Queue in arrival order for up to `max_wait_ms`
+    Fifo,
+
+    /// Queue in arrival order until the queue stays non-empty for
+    /// `codel_interval_ms`, then serve the newest request first and shorten
+    /// the deadline of new arrivals to `codel_target_ms`
+    ///
+    /// Under sustained overload this sheds the requests that have already
+    /// waited longest, which are the most likely to have timed out at the host.
+    AdaptiveLifo,
 }
 
 fn default_log_level() -> String {
@@ -55,9 +279,15 @@ impl Default for PluginConfig {
             data: serde_json::Value::Null,
             init_params: None,
             worker_threads: None,
+            runtime: RuntimeSettings::default(),
             log_level: default_log_level(),
+            logging: LoggingConfig::default(),
             max_concurrent_ops: default_max_concurrent(),
+            admission: AdmissionConfig::default(),
             shutdown_timeout_ms: default_shutdown_timeout(),
+            response_encoding: ResponseEncoding::default(),
+            metrics: MetricsConfig::default(),
+            flight_recorder: FlightRecorderConfig::default(),
         }
     }
 }
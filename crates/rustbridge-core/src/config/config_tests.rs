@@ -39,6 +39,22 @@ fn PluginConfig___from_json___parses_worker_threads() {
     assert_eq!(config.worker_threads, Some(4));
 }
 
+#[test]
+fn PluginConfig___default___uses_splice_response_encoding() {
+    let config = PluginConfig::default();
+
+    assert_eq!(config.response_encoding, ResponseEncoding::Splice);
+}
+
+#[test]
+fn PluginConfig___from_json___parses_response_encoding() {
+    let json = r#"{"response_encoding": "reencode"}"#;
+
+    let config = PluginConfig::from_json(json.as_bytes()).unwrap();
+
+    assert_eq!(config.response_encoding, ResponseEncoding::Reencode);
+}
+
 #[test]
 fn PluginConfig___from_empty_bytes___returns_defaults() {
     let config = PluginConfig::from_json(&[]).unwrap();
@@ -210,3 +226,93 @@ fn from_json___deserializes_init_params() {
     let seed_data: Option<bool> = config.get_init_param("seed_data");
     assert_eq!(seed_data, Some(false));
 }
+
+#[test]
+fn PluginConfig___from_json___missing_admission_defaults_to_reject() {
+    let config = PluginConfig::from_json(br#"{"max_concurrent_ops": 4}"#).unwrap();
+
+    assert_eq!(config.admission, AdmissionConfig::default());
+    assert_eq!(config.admission.mode, AdmissionMode::Reject);
+}
+
+#[test]
+fn PluginConfig___from_json___partial_admission_fills_defaults() {
+    let json = r#"{"admission": {"mode": "adaptive_lifo", "max_wait_ms": 50}}"#;
+
+    let config = PluginConfig::from_json(json.as_bytes()).unwrap();
+
+    assert_eq!(config.admission.mode, AdmissionMode::AdaptiveLifo);
+    assert_eq!(config.admission.max_wait_ms, 50);
+    assert_eq!(
+        config.admission.max_queue_depth,
+        AdmissionConfig::default().max_queue_depth
+    );
+}
+
+#[test]
+fn PluginConfig___from_json___missing_runtime_uses_dedicated_multi_thread() {
+    let config = PluginConfig::from_json(br#"{"worker_threads": 2}"#).unwrap();
+
+    assert_eq!(config.runtime, RuntimeSettings::default());
+    assert_eq!(config.runtime.flavor, RuntimeFlavor::MultiThread);
+    assert!(!config.runtime.shared);
+}
+
+#[test]
+fn PluginConfig___from_json___runtime_settings_parsed() {
+    let json = r#"{"runtime": {"flavor": "current_thread", "shared": true, "cpu_affinity": [0, 2], "numa_node": 1}}"#;
+
+    let config = PluginConfig::from_json(json.as_bytes()).unwrap();
+
+    assert_eq!(config.runtime.flavor, RuntimeFlavor::CurrentThread);
+    assert!(config.runtime.shared);
+    assert_eq!(config.runtime.cpu_affinity, vec![0, 2]);
+    assert_eq!(config.runtime.numa_node, Some(1));
+    assert_eq!(config.runtime.max_blocking_threads, None);
+}
+
+#[test]
+fn PluginConfig___from_json___missing_logging_delivers_synchronously() {
+    let config = PluginConfig::from_json(br#"{"log_level": "debug"}"#).unwrap();
+
+    assert_eq!(config.logging, LoggingConfig::default());
+    assert_eq!(config.logging.delivery, LogDelivery::Sync);
+}
+
+#[test]
+fn PluginConfig___from_json___metrics_off_unless_enabled() {
+    let default = PluginConfig::from_json(b"{}").unwrap();
+    let enabled = PluginConfig::from_json(br#"{"metrics": {"enabled": true}}"#).unwrap();
+
+    assert!(!default.metrics.enabled);
+    assert!(enabled.metrics.enabled);
+}
+
+#[test]
+fn PluginConfig___from_json___partial_flight_recorder_fills_defaults() {
+    let json = r#"{"flight_recorder": {"enabled": true, "slow_call_threshold_us": 250}}"#;
+
+    let config = PluginConfig::from_json(json.as_bytes()).unwrap();
+
+    assert!(config.flight_recorder.enabled);
+    assert_eq!(config.flight_recorder.slow_call_threshold_us, 250);
+    assert_eq!(
+        config.flight_recorder.capacity,
+        FlightRecorderConfig::default().capacity
+    );
+    assert!(!PluginConfig::default().flight_recorder.enabled);
+}
+
+#[test]
+fn PluginConfig___from_json___partial_logging_fills_defaults() {
+    let json = r#"{"logging": {"delivery": "async", "queue_capacity": 64}}"#;
+
+    let config = PluginConfig::from_json(json.as_bytes()).unwrap();
+
+    assert_eq!(config.logging.delivery, LogDelivery::Async);
+    assert_eq!(config.logging.queue_capacity, 64);
+    assert_eq!(
+        config.logging.batch_size,
+        LoggingConfig::default().batch_size
+    );
+}
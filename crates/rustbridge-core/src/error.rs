@@ -59,6 +59,14 @@ pub enum PluginError {
     /// Too many concurrent requests
     #[error("too many concurrent requests (limit exceeded)")]
     TooManyRequests,
+
+    /// Caller-provided output buffer is too small for the response
+    #[error("insufficient output capacity: {required} bytes required")]
+    InsufficientCapacity { required: usize },
+
+    /// The plugin cannot handle the requested payload content type
+    #[error("unsupported content type: {0}")]
+    UnsupportedContentType(String),
 }
 
 impl PluginError {
@@ -78,6 +86,8 @@ impl PluginError {
             PluginError::Internal(_) => 11,
             PluginError::FfiError(_) => 12,
             PluginError::TooManyRequests => 13,
+            PluginError::InsufficientCapacity { .. } => 14,
+            PluginError::UnsupportedContentType(_) => 15,
         }
     }
 
@@ -100,11 +110,28 @@ impl PluginError {
             11 => PluginError::Internal(message),
             12 => PluginError::FfiError(message),
             13 => PluginError::TooManyRequests,
+            14 => PluginError::InsufficientCapacity {
+                required: parse_required_capacity(&message),
+            },
+            15 => PluginError::UnsupportedContentType(message),
             _ => PluginError::Internal(message),
         }
     }
 }
 
+/// Extract the byte count from an insufficient-capacity message
+///
+/// Accepts both the bare number and the `Display` text
+/// ("insufficient output capacity: N bytes required") that the envelope and
+/// JNI paths carry. Returns 0 if the message holds no number.
+fn parse_required_capacity(message: &str) -> usize {
+    message
+        .split(|c: char| !c.is_ascii_digit())
+        .find(|digits| !digits.is_empty())
+        .and_then(|digits| digits.parse().ok())
+        .unwrap_or(0)
+}
+
 impl From<serde_json::Error> for PluginError {
     fn from(err: serde_json::Error) -> Self {
         PluginError::SerializationError(err.to_string())
@@ -28,6 +28,12 @@ use test_case::test_case;
 #[test_case(PluginError::Internal("test".into()), 11, "Internal")]
 #[test_case(PluginError::FfiError("test".into()), 12, "FfiError")]
 #[test_case(PluginError::TooManyRequests, 13, "TooManyRequests")]
+#[test_case(PluginError::InsufficientCapacity { required: 64 }, 14, "InsufficientCapacity")]
+#[test_case(
+    PluginError::UnsupportedContentType("test".into()),
+    15,
+    "UnsupportedContentType"
+)]
 fn PluginError___variant___maps_to_correct_code(
     error: PluginError,
     expected_code: u32,
@@ -59,6 +65,8 @@ fn PluginError___variant___maps_to_correct_code(
 #[test_case(11, "Internal")]
 #[test_case(12, "FfiError")]
 #[test_case(13, "TooManyRequests")]
+#[test_case(14, "InsufficientCapacity")]
+#[test_case(15, "UnsupportedContentType")]
 fn PluginError___from_code___creates_correct_variant(code: u32, _expected_variant: &str) {
     let error = PluginError::from_code(code, "test message".into());
 
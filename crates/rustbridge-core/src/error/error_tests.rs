@@ -34,6 +34,38 @@ fn PluginError___from_code_unknown___returns_internal() {
     assert!(matches!(err, PluginError::Internal(_)));
 }
 
+#[test]
+fn PluginError___from_code_14___parses_required_capacity() {
+    let err = PluginError::from_code(14, "128".into());
+
+    assert!(matches!(
+        err,
+        PluginError::InsufficientCapacity { required: 128 }
+    ));
+}
+
+#[test]
+fn PluginError___from_code_14___round_trips_display_text() {
+    let original = PluginError::InsufficientCapacity { required: 4096 };
+
+    let err = PluginError::from_code(original.error_code(), original.to_string());
+
+    assert!(matches!(
+        err,
+        PluginError::InsufficientCapacity { required: 4096 }
+    ));
+}
+
+#[test]
+fn PluginError___from_code_14_without_number___required_is_zero() {
+    let err = PluginError::from_code(14, "buffer too small".into());
+
+    assert!(matches!(
+        err,
+        PluginError::InsufficientCapacity { required: 0 }
+    ));
+}
+
 #[test]
 fn PluginError___all_variants___have_unique_codes() {
     let errors = vec![
@@ -52,6 +84,8 @@ fn PluginError___all_variants___have_unique_codes() {
         PluginError::Timeout,
         PluginError::Internal("".into()),
         PluginError::FfiError("".into()),
+        PluginError::TooManyRequests,
+        PluginError::InsufficientCapacity { required: 0 },
     ];
 
     let codes: Vec<u32> = errors.iter().map(|e| e.error_code()).collect();
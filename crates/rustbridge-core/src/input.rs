@@ -0,0 +1,104 @@
+//! Streamed request input
+
+use std::io;
+use std::pin::Pin;
+use std::task::{Context, Poll};
+use tokio::io::{AsyncRead, ReadBuf};
+use tokio::sync::mpsc;
+
+/// Sending half of a [`RequestReader`], fed by the host
+pub type RequestSender = mpsc::Sender<Vec<u8>>;
+
+/// A request payload delivered by the host in chunks
+///
+/// Passed to [`Plugin::handle_request_reader`](crate::Plugin::handle_request_reader)
+/// for requests too large to hand over in one buffer. Reading returns the
+/// chunks in order and reaches end-of-file once the host has finished; only a
+/// few chunks are buffered, so a handler that reads as it goes uses constant
+/// memory regardless of the payload size.
+///
+/// # Example
+///
+/// ```ignore
+/// use tokio::io::AsyncReadExt;
+///
+/// let mut buf = vec![0u8; 64 * 1024];
+/// let mut total = 0u64;
+/// loop {
+///     let n = request.read(&mut buf).await?;
+///     if n == 0 {
+///         break;
+///     }
+///     total += n as u64;
+/// }
+/// ```
+pub struct RequestReader {
+    chunks: Option<mpsc::Receiver<Vec<u8>>>,
+    current: Vec<u8>,
+    position: usize,
+}
+
+impl RequestReader {
+    /// Create a connected sender and reader buffering up to `buffer` chunks
+    ///
+    /// Dropping the sender marks the end of the request.
+    pub fn channel(buffer: usize) -> (RequestSender, Self) {
+        let (sender, receiver) = mpsc::channel(buffer.max(1));
+        (
+            sender,
+            Self {
+                chunks: Some(receiver),
+                current: Vec::new(),
+                position: 0,
+            },
+        )
+    }
+
+    /// Create a reader over a payload that is already in memory
+    pub fn from_bytes(payload: Vec<u8>) -> Self {
+        Self {
+            chunks: None,
+            current: payload,
+            position: 0,
+        }
+    }
+}
+
+impl AsyncRead for RequestReader {
+    fn poll_read(
+        self: Pin<&mut Self>,
+        cx: &mut Context<'_>,
+        buf: &mut ReadBuf<'_>,
+    ) -> Poll<io::Result<()>> {
+        let this = self.get_mut();
+        loop {
+            if this.position < this.current.len() {
+                let n = buf.remaining().min(this.current.len() - this.position);
+                buf.put_slice(&this.current[this.position..this.position + n]);
+                this.position += n;
+                return Poll::Ready(Ok(()));
+            }
+
+            let Some(chunks) = this.chunks.as_mut() else {
+                return Poll::Ready(Ok(()));
+            };
+            match chunks.poll_recv(cx) {
+                Poll::Ready(Some(chunk)) => {
+                    this.current = chunk;
+                    this.position = 0;
+                }
+                Poll::Ready(None) => {
+                    this.chunks = None;
+                    this.current = Vec::new();
+                    this.position = 0;
+                    return Poll::Ready(Ok(()));
+                }
+                Poll::Pending => return Poll::Pending,
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+#[path = "input/input_tests.rs"]
+mod input_tests;
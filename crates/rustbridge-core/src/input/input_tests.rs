@@ -0,0 +1,58 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use tokio::io::AsyncReadExt;
+
+// from_bytes tests
+
+#[tokio::test]
+async fn RequestReader___from_bytes___reads_payload_then_eof() {
+    let mut reader = RequestReader::from_bytes(b"payload".to_vec());
+
+    let mut out = Vec::new();
+    reader.read_to_end(&mut out).await.unwrap();
+
+    assert_eq!(out, b"payload");
+}
+
+// channel tests
+
+#[tokio::test]
+async fn RequestReader___channel___concatenates_chunks_in_order() {
+    let (sender, mut reader) = RequestReader::channel(4);
+    sender.send(b"ab".to_vec()).await.unwrap();
+    sender.send(Vec::new()).await.unwrap();
+    sender.send(b"cd".to_vec()).await.unwrap();
+    drop(sender);
+
+    let mut out = Vec::new();
+    reader.read_to_end(&mut out).await.unwrap();
+
+    assert_eq!(out, b"abcd");
+}
+
+#[tokio::test]
+async fn RequestReader___small_read_buffer___splits_chunk_across_reads() {
+    let (sender, mut reader) = RequestReader::channel(1);
+    sender.send(b"abcde".to_vec()).await.unwrap();
+    drop(sender);
+
+    let mut buf = [0u8; 2];
+    let first = reader.read(&mut buf).await.unwrap();
+    assert_eq!(&buf[..first], b"ab");
+    let mut rest = Vec::new();
+    reader.read_to_end(&mut rest).await.unwrap();
+
+    assert_eq!(rest, b"cde");
+}
+
+#[tokio::test]
+async fn RequestReader___full_channel___applies_backpressure() {
+    let (sender, _reader) = RequestReader::channel(2);
+
+    sender.try_send(vec![1]).unwrap();
+    sender.try_send(vec![2]).unwrap();
+    let third = sender.try_send(vec![3]);
+
+    assert!(third.is_err());
+}
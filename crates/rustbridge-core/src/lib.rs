@@ -5,18 +5,27 @@
 //! - [`LifecycleState`] for managing plugin lifecycle
 //! - [`PluginError`] for error handling
 //! - [`PluginConfig`] for plugin configuration
+//! - [`ResponseStream`] for responses produced in chunks
+//! - [`RequestReader`] for requests delivered in chunks
 
 mod config;
 mod error;
+mod input;
 mod lifecycle;
 mod plugin;
 mod request;
+mod stream;
 
-pub use config::{PluginConfig, PluginMetadata};
+pub use config::{
+    AdmissionConfig, AdmissionMode, FlightRecorderConfig, LogDelivery, LoggingConfig,
+    MetricsConfig, PluginConfig, PluginMetadata, ResponseEncoding, RuntimeFlavor, RuntimeSettings,
+};
 pub use error::{PluginError, PluginResult};
+pub use input::{RequestReader, RequestSender};
 pub use lifecycle::LifecycleState;
 pub use plugin::{Plugin, PluginContext, PluginFactory};
-pub use request::{RequestContext, ResponseBuilder};
+pub use request::{ContentType, RequestContext, ResponseBuilder};
+pub use stream::{BoxResponseStream, IterStream, OnceStream, ResponseStream};
 
 /// Log levels for FFI callbacks
 #[repr(u8)]
@@ -59,8 +68,9 @@ impl std::fmt::Display for LogLevel {
 /// Prelude module for convenient imports
 pub mod prelude {
     pub use crate::{
-        LifecycleState, LogLevel, Plugin, PluginConfig, PluginContext, PluginError, PluginFactory,
-        PluginResult, RequestContext, ResponseBuilder,
+        ContentType, LifecycleState, LogLevel, Plugin, PluginConfig, PluginContext, PluginError,
+        PluginFactory, PluginResult, RequestContext, RequestReader, ResponseBuilder,
+        ResponseStream,
     };
 }
 
@@ -1,7 +1,11 @@
 //! Plugin trait and context types
 
-use crate::{LifecycleState, PluginConfig, PluginError, PluginResult};
+use crate::{
+    BoxResponseStream, ContentType, LifecycleState, OnceStream, PluginConfig, PluginError,
+    PluginResult, RequestReader,
+};
 use async_trait::async_trait;
+use tokio::io::AsyncReadExt;
 
 /// Context provided to plugin operations
 pub struct PluginContext {
@@ -121,6 +125,98 @@ pub trait Plugin: Send + Sync + 'static {
         payload: &[u8],
     ) -> PluginResult<Vec<u8>>;
 
+    /// Handle a request without going through the async runtime
+    ///
+    /// Override this for handlers that never await. Return `Some` to answer
+    /// the request inline on the calling thread, or `None` to fall back to
+    /// [`handle_request`](Plugin::handle_request) for this `type_tag`.
+    ///
+    /// Synchronous calls try this first, which skips the boxed future and the
+    /// runtime entirely. The default handles nothing.
+    fn handle_request_sync(
+        &self,
+        _ctx: &PluginContext,
+        _type_tag: &str,
+        _payload: &[u8],
+    ) -> Option<PluginResult<Vec<u8>>> {
+        None
+    }
+
+    /// Handle a request whose payload uses a negotiated content type
+    ///
+    /// The response must be encoded in the same `content_type` as the
+    /// request. The default forwards JSON to
+    /// [`handle_request`](Plugin::handle_request) and rejects every other
+    /// format with [`PluginError::UnsupportedContentType`], so plugins only
+    /// override this once they can speak a binary codec.
+    async fn handle_request_as(
+        &self,
+        ctx: &PluginContext,
+        type_tag: &str,
+        content_type: ContentType,
+        payload: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        match content_type {
+            ContentType::Json => self.handle_request(ctx, type_tag, payload).await,
+            other => Err(PluginError::UnsupportedContentType(
+                other.mime().to_string(),
+            )),
+        }
+    }
+
+    /// Handle a request whose response is delivered in chunks
+    ///
+    /// Override this for type tags whose responses are too large to build in
+    /// one `Vec`. The returned stream runs on the plugin's runtime and is
+    /// pulled by the host chunk by chunk, with only a few chunks buffered
+    /// ahead of it. Setup work and request validation belong here, before
+    /// the stream is returned, so their errors reach the host when the
+    /// stream is opened.
+    ///
+    /// The default answers with one chunk from
+    /// [`handle_request_sync`](Plugin::handle_request_sync) or
+    /// [`handle_request`](Plugin::handle_request).
+    async fn handle_request_stream(
+        &self,
+        ctx: &PluginContext,
+        type_tag: &str,
+        payload: &[u8],
+    ) -> PluginResult<BoxResponseStream> {
+        let response = match self.handle_request_sync(ctx, type_tag, payload) {
+            Some(result) => result?,
+            None => self.handle_request(ctx, type_tag, payload).await?,
+        };
+        let stream: BoxResponseStream = Box::new(OnceStream::new(response));
+        Ok(stream)
+    }
+
+    /// Handle a request whose payload is delivered in chunks
+    ///
+    /// Override this for type tags that accept payloads too large to hold in
+    /// memory at once, and consume `request` incrementally. The host writes
+    /// chunks while this runs, and its writes block once a few chunks are
+    /// waiting, so reading slowly throttles the host.
+    ///
+    /// The default reads the whole payload and hands it to
+    /// [`handle_request_sync`](Plugin::handle_request_sync) or
+    /// [`handle_request`](Plugin::handle_request).
+    async fn handle_request_reader(
+        &self,
+        ctx: &PluginContext,
+        type_tag: &str,
+        request: &mut RequestReader,
+    ) -> PluginResult<Vec<u8>> {
+        let mut payload = Vec::new();
+        request
+            .read_to_end(&mut payload)
+            .await
+            .map_err(|e| PluginError::Internal(format!("Failed to read request: {}", e)))?;
+        match self.handle_request_sync(ctx, type_tag, &payload) {
+            Some(result) => result,
+            None => self.handle_request(ctx, type_tag, &payload).await,
+        }
+    }
+
     /// Called when the plugin is shutting down
     ///
     /// Use this to cleanup resources, close connections, etc.
@@ -134,3 +134,82 @@ fn Plugin___supported_types___returns_empty_by_default() {
 
     assert!(types.is_empty());
 }
+
+#[test]
+fn Plugin___handle_request_sync___returns_none_by_default() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let result = plugin.handle_request_sync(&ctx, "echo", b"hello");
+
+    assert!(result.is_none());
+}
+
+#[tokio::test]
+async fn Plugin___handle_request_as___json_delegates_to_handle_request() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let response = plugin
+        .handle_request_as(&ctx, "echo", ContentType::Json, b"hello")
+        .await
+        .unwrap();
+
+    assert_eq!(response, b"hello");
+}
+
+#[tokio::test]
+async fn Plugin___handle_request_as___binary_rejected_by_default() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let result = plugin
+        .handle_request_as(&ctx, "echo", ContentType::MsgPack, b"hello")
+        .await;
+
+    assert!(matches!(
+        result,
+        Err(PluginError::UnsupportedContentType(_))
+    ));
+}
+
+#[tokio::test]
+async fn Plugin___handle_request_stream___default_yields_whole_response() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let mut stream = plugin
+        .handle_request_stream(&ctx, "echo", b"hello")
+        .await
+        .unwrap();
+
+    assert_eq!(stream.next_chunk().await.unwrap().unwrap(), b"hello");
+    assert!(stream.next_chunk().await.is_none());
+}
+
+#[tokio::test]
+async fn Plugin___handle_request_stream___default_returns_handler_error_on_open() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let result = plugin.handle_request_stream(&ctx, "unknown", b"").await;
+
+    assert!(matches!(result, Err(PluginError::UnknownMessageType(_))));
+}
+
+#[tokio::test]
+async fn Plugin___handle_request_reader___default_reads_whole_payload() {
+    let plugin = TestPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+    let (sender, mut reader) = RequestReader::channel(2);
+    sender.send(b"hel".to_vec()).await.unwrap();
+    sender.send(b"lo".to_vec()).await.unwrap();
+    drop(sender);
+
+    let response = plugin
+        .handle_request_reader(&ctx, "echo", &mut reader)
+        .await
+        .unwrap();
+
+    assert_eq!(response, b"hello");
+}
@@ -30,6 +30,50 @@ impl RequestContext {
     }
 }
 
+/// Wire format of a request or response payload
+///
+/// Hosts pick the format per call through `plugin_call_as`; plain
+/// `plugin_call` always uses [`ContentType::Json`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash)]
+pub enum ContentType {
+    /// UTF-8 JSON (`application/json`)
+    #[default]
+    Json,
+    /// MessagePack (`application/msgpack`)
+    MsgPack,
+    /// rustbridge flat binary format, readable in place without decoding
+    /// (`application/x-rustbridge-flat`)
+    Flat,
+}
+
+impl ContentType {
+    /// MIME type sent on the wire for this format
+    pub const fn mime(self) -> &'static str {
+        match self {
+            ContentType::Json => "application/json",
+            ContentType::MsgPack => "application/msgpack",
+            ContentType::Flat => "application/x-rustbridge-flat",
+        }
+    }
+
+    /// Parse a MIME type, ignoring case and any `;` parameters
+    ///
+    /// Returns `None` for formats rustbridge has no codec for.
+    pub fn from_mime(mime: &str) -> Option<Self> {
+        let essence = mime.split(';').next().unwrap_or_default().trim();
+        [
+            ("application/json", ContentType::Json),
+            ("application/msgpack", ContentType::MsgPack),
+            ("application/x-msgpack", ContentType::MsgPack),
+            ("application/vnd.msgpack", ContentType::MsgPack),
+            ("application/x-rustbridge-flat", ContentType::Flat),
+        ]
+        .into_iter()
+        .find(|(name, _)| essence.eq_ignore_ascii_case(name))
+        .map(|(_, content_type)| content_type)
+    }
+}
+
 /// Builder for constructing responses
 #[derive(Debug)]
 pub struct ResponseBuilder {
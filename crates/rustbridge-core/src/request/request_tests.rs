@@ -146,3 +146,44 @@ fn ResponseResult___error___returns_some_for_error() {
     let err = result.error().unwrap();
     assert_eq!(err.code, 404);
 }
+
+// ContentType tests
+
+#[test]
+fn ContentType___from_mime___parses_known_types() {
+    assert_eq!(
+        ContentType::from_mime("application/json"),
+        Some(ContentType::Json)
+    );
+    assert_eq!(
+        ContentType::from_mime("application/x-msgpack"),
+        Some(ContentType::MsgPack)
+    );
+    assert_eq!(
+        ContentType::from_mime("application/x-rustbridge-flat"),
+        Some(ContentType::Flat)
+    );
+}
+
+#[test]
+fn ContentType___from_mime___ignores_case_and_parameters() {
+    let content_type = ContentType::from_mime(" Application/JSON; charset=utf-8");
+
+    assert_eq!(content_type, Some(ContentType::Json));
+}
+
+#[test]
+fn ContentType___from_mime___unknown_returns_none() {
+    assert_eq!(ContentType::from_mime("application/cbor"), None);
+    assert_eq!(ContentType::from_mime(""), None);
+}
+
+#[test]
+fn ContentType___mime___roundtrips_through_from_mime() {
+    for content_type in [ContentType::Json, ContentType::MsgPack, ContentType::Flat] {
+        assert_eq!(
+            ContentType::from_mime(content_type.mime()),
+            Some(content_type)
+        );
+    }
+}
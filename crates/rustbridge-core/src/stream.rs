@@ -0,0 +1,100 @@
+//! Streaming response types
+
+use crate::PluginResult;
+use async_trait::async_trait;
+
+/// A response produced as a sequence of chunks
+///
+/// Returned by [`Plugin::handle_request_stream`](crate::Plugin::handle_request_stream)
+/// for responses too large to build in one allocation. The host pulls
+/// chunks one at a time and only a few are buffered ahead of it, so
+/// `next_chunk` is not polled again until the host has caught up.
+///
+/// Concatenated, the chunks form the same bytes `handle_request` would have
+/// returned. Empty chunks are skipped.
+///
+/// # Example
+///
+/// ```ignore
+/// use rustbridge_core::{PluginResult, ResponseStream};
+///
+/// struct Lines {
+///     remaining: usize,
+/// }
+///
+/// #[async_trait::async_trait]
+/// impl ResponseStream for Lines {
+///     async fn next_chunk(&mut self) -> Option<PluginResult<Vec<u8>>> {
+///         if self.remaining == 0 {
+///             return None;
+///         }
+///         self.remaining -= 1;
+///         Some(Ok(format!("line {}\n", self.remaining).into_bytes()))
+///     }
+/// }
+/// ```
+#[async_trait]
+pub trait ResponseStream: Send {
+    /// Produce the next chunk, or `None` once the response is complete
+    ///
+    /// Returning an error ends the stream; the host receives the error in
+    /// place of the next chunk.
+    async fn next_chunk(&mut self) -> Option<PluginResult<Vec<u8>>>;
+}
+
+/// Boxed response stream returned by plugins
+pub type BoxResponseStream = Box<dyn ResponseStream>;
+
+/// Stream that yields one complete response
+///
+/// Used by the default `handle_request_stream`, so every type tag can be
+/// called through the streaming entry points.
+pub struct OnceStream {
+    chunk: Option<Vec<u8>>,
+}
+
+impl OnceStream {
+    /// Create a stream that yields `chunk` and then ends
+    pub fn new(chunk: Vec<u8>) -> Self {
+        Self { chunk: Some(chunk) }
+    }
+}
+
+#[async_trait]
+impl ResponseStream for OnceStream {
+    async fn next_chunk(&mut self) -> Option<PluginResult<Vec<u8>>> {
+        self.chunk.take().map(Ok)
+    }
+}
+
+/// Stream over a synchronous iterator of chunks
+///
+/// Each chunk is produced on a runtime worker when the host asks for more,
+/// so the iterator should not block for long.
+pub struct IterStream<I> {
+    chunks: I,
+}
+
+impl<I> IterStream<I>
+where
+    I: Iterator<Item = PluginResult<Vec<u8>>> + Send,
+{
+    /// Create a stream that yields each item of `chunks`
+    pub fn new(chunks: I) -> Self {
+        Self { chunks }
+    }
+}
+
+#[async_trait]
+impl<I> ResponseStream for IterStream<I>
+where
+    I: Iterator<Item = PluginResult<Vec<u8>>> + Send,
+{
+    async fn next_chunk(&mut self) -> Option<PluginResult<Vec<u8>>> {
+        self.chunks.next()
+    }
+}
+
+#[cfg(test)]
+#[path = "stream/stream_tests.rs"]
+mod stream_tests;
@@ -0,0 +1,50 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use crate::PluginError;
+
+async fn collect(mut stream: impl ResponseStream) -> Vec<PluginResult<Vec<u8>>> {
+    let mut chunks = Vec::new();
+    while let Some(chunk) = stream.next_chunk().await {
+        chunks.push(chunk);
+    }
+    chunks
+}
+
+// OnceStream tests
+
+#[tokio::test]
+async fn OnceStream___next_chunk___yields_once_then_ends() {
+    let stream = OnceStream::new(b"whole".to_vec());
+
+    let chunks = collect(stream).await;
+
+    assert_eq!(chunks.len(), 1);
+    assert_eq!(chunks[0].as_ref().unwrap(), b"whole");
+}
+
+// IterStream tests
+
+#[tokio::test]
+async fn IterStream___next_chunk___yields_items_in_order() {
+    let stream = IterStream::new((0..3u8).map(|i| Ok(vec![i; 2])));
+
+    let chunks = collect(stream).await;
+
+    let chunks: Vec<Vec<u8>> = chunks.into_iter().map(|c| c.unwrap()).collect();
+    assert_eq!(chunks, vec![vec![0, 0], vec![1, 1], vec![2, 2]]);
+}
+
+#[tokio::test]
+async fn IterStream___error_item___is_passed_through() {
+    let items = vec![
+        Ok(b"a".to_vec()),
+        Err(PluginError::HandlerError("boom".to_string())),
+    ];
+    let stream = IterStream::new(items.into_iter());
+
+    let chunks = collect(stream).await;
+
+    assert!(chunks[0].is_ok());
+    assert!(matches!(chunks[1], Err(PluginError::HandlerError(_))));
+}
@@ -0,0 +1,178 @@
+//! Response Buffer Pool Benchmarks
+//!
+//! Measures what the per-thread buffer pool saves on each response:
+//!
+//! 1. **plugin_call**: a JSON call through the C ABI and the matching
+//!    `plugin_free_buffer`, where the response envelope is built in a pooled
+//!    buffer
+//! 2. **RbResponse::success**: a binary struct response and `rb_response_free`
+//! 3. **FfiBuffer::error**: an error buffer and its free
+//! 4. **RbBytesOwned::from_slice**: a copied byte buffer and its free
+//!
+//! Each case runs with pooling disabled (`max_cached_per_class: 0`, the
+//! previous behaviour) and with the default pool. Before the timed runs the
+//! heap allocations per call are counted with a wrapping global allocator and
+//! printed, so the before/after difference is visible without a profiler.
+
+use async_trait::async_trait;
+use criterion::{Criterion, black_box, criterion_group, criterion_main};
+use rustbridge_core::{Plugin, PluginContext, PluginResult};
+use rustbridge_ffi::{
+    FfiBuffer, PoolConfig, RbBytesOwned, RbResponse, configure_buffer_pool, plugin_call,
+    plugin_free_buffer, plugin_init, plugin_shutdown, rb_response_free,
+};
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicU64, Ordering};
+
+const ALLOC_SAMPLE_CALLS: u64 = 10_000;
+
+/// Counts allocations made through the global allocator
+struct CountingAllocator;
+
+static ALLOCATIONS: AtomicU64 = AtomicU64::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        unsafe { System.dealloc(ptr, layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAllocator = CountingAllocator;
+
+/// Plugin answering every request with the same small payload
+struct FixedPlugin;
+
+#[async_trait]
+impl Plugin for FixedPlugin {
+    async fn on_start(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn on_stop(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn handle_request(
+        &self,
+        _context: &PluginContext,
+        _type_tag: &str,
+        _request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        Ok(br#"{"value":"cached","ttl_seconds":60}"#.to_vec())
+    }
+}
+
+#[repr(C)]
+struct SmallResponse {
+    value: [u8; 64],
+    ttl_seconds: u32,
+    cache_hit: u8,
+}
+
+fn pool_configs() -> [(&'static str, PoolConfig); 2] {
+    [
+        (
+            "unpooled",
+            PoolConfig {
+                max_cached_per_class: 0,
+                ..PoolConfig::default()
+            },
+        ),
+        ("pooled", PoolConfig::default()),
+    ]
+}
+
+fn call_and_free(handle: *mut c_void) {
+    let request = br#"{"key":"user:1"}"#;
+    unsafe {
+        let mut buffer = plugin_call(handle, c"get".as_ptr(), request.as_ptr(), request.len());
+        black_box(buffer.len);
+        plugin_free_buffer(&mut buffer);
+    }
+}
+
+fn success_and_free(_handle: *mut c_void) {
+    let mut response = RbResponse::success(SmallResponse {
+        value: [7; 64],
+        ttl_seconds: 60,
+        cache_hit: 1,
+    });
+    black_box(response.len);
+    unsafe { rb_response_free(&mut response) };
+}
+
+fn error_and_free(_handle: *mut c_void) {
+    let mut buffer = FfiBuffer::error(7, black_box("Handler error: key not found"));
+    unsafe { buffer.free() };
+}
+
+fn bytes_and_free(_handle: *mut c_void) {
+    let mut bytes = RbBytesOwned::from_slice(black_box(&[0u8; 256]));
+    unsafe { bytes.free() };
+}
+
+/// A benchmarked call, given the plugin handle
+type Case = fn(*mut c_void);
+
+const CASES: [(&str, Case); 4] = [
+    ("plugin_call", call_and_free),
+    ("rb_response_success", success_and_free),
+    ("ffi_buffer_error", error_and_free),
+    ("rb_bytes_from_slice", bytes_and_free),
+];
+
+/// Heap allocations per call of `f`, after one warm-up call
+fn allocations_per_call(f: Case, handle: *mut c_void) -> f64 {
+    f(handle);
+    let before = ALLOCATIONS.load(Ordering::Relaxed);
+    for _ in 0..ALLOC_SAMPLE_CALLS {
+        f(handle);
+    }
+    let after = ALLOCATIONS.load(Ordering::Relaxed);
+    (after - before) as f64 / ALLOC_SAMPLE_CALLS as f64
+}
+
+fn bench_buffer_pool(c: &mut Criterion) {
+    let plugin: Box<dyn Plugin> = Box::new(FixedPlugin);
+    let plugin = Box::into_raw(Box::new(plugin)) as *mut c_void;
+    let handle = unsafe { plugin_init(plugin, std::ptr::null(), 0, None) };
+    assert!(!handle.is_null(), "plugin_init failed");
+
+    for (label, config) in pool_configs() {
+        configure_buffer_pool(config);
+        for (name, f) in CASES {
+            println!(
+                "{name}/{label}: {:.2} allocations per call",
+                allocations_per_call(f, handle)
+            );
+        }
+    }
+
+    for (label, config) in pool_configs() {
+        configure_buffer_pool(config);
+        let mut group = c.benchmark_group(label);
+        for (name, f) in CASES {
+            group.bench_function(name, |b| b.iter(|| f(handle)));
+        }
+        group.finish();
+    }
+
+    configure_buffer_pool(PoolConfig::default());
+    unsafe { plugin_shutdown(handle) };
+}
+
+criterion_group!(benches, bench_buffer_pool);
+
+criterion_main!(benches);
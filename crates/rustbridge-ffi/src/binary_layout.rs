@@ -0,0 +1,146 @@
+//! Request layouts checked once at binary dispatch
+//!
+//! A [`BinaryLayout`] describes a `#[repr(C)]` request struct: its size and
+//! alignment, where its `version` byte sits and which fields are
+//! [`RbString`]s or [`RbBytes`]. Registering one for a message ID with
+//! [`register_binary_request`](crate::register_binary_request) makes every
+//! binary dispatch path check the request against it before the handler
+//! runs, so the handler can reinterpret the bytes with
+//! [`BinaryStruct::from_request`] instead of re-validating them.
+//!
+//! `rustbridge generate-header --layouts <file>` writes the
+//! [`BinaryStruct`] impls for every struct in a source file, using
+//! `size_of`, `align_of` and `offset_of!` so the descriptors are computed
+//! by the compiler rather than by hand.
+
+use crate::binary_types::{RbBytes, RbString};
+use rustbridge_core::PluginError;
+
+/// Layout of a `#[repr(C)]` request struct
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct BinaryLayout {
+    /// Struct name, used in error messages
+    pub name: &'static str,
+    /// `size_of` the struct; shorter requests are rejected
+    pub size: usize,
+    /// `align_of` the struct; the request must start on this boundary
+    pub align: usize,
+    /// Offset of the `version: u8` field and the only version accepted
+    pub version: Option<(usize, u8)>,
+    /// Offsets of `RbString` fields, which must be absent or valid UTF-8
+    pub strings: &'static [usize],
+    /// Offsets of `RbBytes` fields, which must not be null with a length
+    pub bytes: &'static [usize],
+}
+
+impl BinaryLayout {
+    /// Check a request against this layout, as dispatch does before the
+    /// handler runs
+    ///
+    /// # Safety
+    ///
+    /// The layout must describe a struct whose `strings` and `bytes` offsets
+    /// hold `RbString` and `RbBytes` fields, and the non-null pointers in
+    /// those fields must be valid for reads of their length, as
+    /// `plugin_call_raw` already requires of its caller.
+    pub unsafe fn check(&self, request: &[u8]) -> Result<(), PluginError> {
+        if request.len() < self.size {
+            return Err(self.invalid(format_args!(
+                "{} bytes, expected {}",
+                request.len(),
+                self.size
+            )));
+        }
+        if !(request.as_ptr() as usize).is_multiple_of(self.align) {
+            return Err(self.invalid(format_args!(
+                "request is not aligned to {} bytes",
+                self.align
+            )));
+        }
+        if let Some((offset, expected)) = self.version
+            && request[offset] != expected
+        {
+            return Err(self.invalid(format_args!(
+                "unsupported version {} (expected {})",
+                request[offset], expected
+            )));
+        }
+
+        for &offset in self.strings {
+            // SAFETY: the caller guarantees an RbString at this offset, and the
+            // request is long enough and aligned
+            let string = unsafe { &*(request.as_ptr().add(offset) as *const RbString) };
+            // SAFETY: the caller guarantees non-null data is valid for len bytes
+            if !unsafe { borrowed(string.data, string.len) }
+                .is_some_and(|data| std::str::from_utf8(data).is_ok())
+            {
+                return Err(
+                    self.invalid(format_args!("string at offset {offset} is not valid UTF-8"))
+                );
+            }
+        }
+        for &offset in self.bytes {
+            // SAFETY: as for strings, with an RbBytes at this offset
+            let bytes = unsafe { &*(request.as_ptr().add(offset) as *const RbBytes) };
+            // SAFETY: as above
+            if unsafe { borrowed(bytes.data, bytes.len) }.is_none() {
+                return Err(self.invalid(format_args!(
+                    "bytes at offset {offset} are null with a length"
+                )));
+            }
+        }
+        Ok(())
+    }
+
+    fn invalid(&self, detail: std::fmt::Arguments<'_>) -> PluginError {
+        PluginError::SerializationError(format!("Invalid {}: {detail}", self.name))
+    }
+}
+
+/// View a borrowed field's data; `None` if it is null with a non-zero length
+///
+/// # Safety
+///
+/// A non-null `data` must be valid for reads of `len` bytes.
+unsafe fn borrowed<'a>(data: *const u8, len: u32) -> Option<&'a [u8]> {
+    match (data.is_null(), len) {
+        (true, 0) => Some(&[]),
+        (true, _) => None,
+        // SAFETY: guaranteed by the caller
+        (false, len) => Some(unsafe { std::slice::from_raw_parts(data, len as usize) }),
+    }
+}
+
+/// A `#[repr(C)]` request struct with a known [`BinaryLayout`]
+///
+/// # Safety
+///
+/// `LAYOUT` must match the struct: its `size_of`, its `align_of`, the offset
+/// of a `u8` version field, and the offsets of its `RbString` and `RbBytes`
+/// fields. Every other bit pattern of the struct's bytes must be a valid
+/// value, as it is for the integer and array fields used in binary messages.
+/// Prefer the impls written by `rustbridge generate-header --layouts`.
+pub unsafe trait BinaryStruct: Copy + 'static {
+    /// Layout checked at dispatch for message IDs registered with this type
+    const LAYOUT: BinaryLayout;
+
+    /// Reinterpret a request that dispatch has checked against `LAYOUT`
+    ///
+    /// # Safety
+    ///
+    /// The message ID must have been registered for this type with
+    /// `register_binary_request`, and `request` must be the slice the
+    /// handler received.
+    #[inline]
+    unsafe fn from_request(request: &[u8]) -> &Self {
+        debug_assert!(request.len() >= Self::LAYOUT.size);
+        debug_assert!((request.as_ptr() as usize).is_multiple_of(Self::LAYOUT.align));
+        // SAFETY: dispatch checked the length and alignment, and the trait
+        // guarantees any checked bytes are a valid Self
+        unsafe { &*(request.as_ptr() as *const Self) }
+    }
+}
+
+#[cfg(test)]
+#[path = "binary_layout/binary_layout_tests.rs"]
+mod binary_layout_tests;
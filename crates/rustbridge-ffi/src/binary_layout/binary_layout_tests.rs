@@ -0,0 +1,153 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::mem::offset_of;
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct NamedRequest {
+    version: u8,
+    name: RbString,
+    payload: RbBytes,
+}
+
+// SAFETY: the layout matches the struct; a zeroed pointer field is null
+unsafe impl BinaryStruct for NamedRequest {
+    const LAYOUT: BinaryLayout = BinaryLayout {
+        name: "NamedRequest",
+        size: size_of::<NamedRequest>(),
+        align: align_of::<NamedRequest>(),
+        version: Some((offset_of!(NamedRequest, version), 2)),
+        strings: &[offset_of!(NamedRequest, name)],
+        bytes: &[offset_of!(NamedRequest, payload)],
+    };
+}
+
+/// Words in a request buffer, one more than needed so it can be misaligned
+const WORDS: usize = size_of::<NamedRequest>().div_ceil(8) + 1;
+
+/// Write a request into a zeroed, 8-byte aligned buffer field by field, so
+/// the padding bytes stay initialized
+fn request(version: u8, name: RbString, payload: RbBytes) -> [u64; WORDS] {
+    let mut buffer = [0u64; WORDS];
+    let base = buffer.as_mut_ptr() as *mut NamedRequest;
+    // SAFETY: the buffer is large enough and aligned for NamedRequest
+    unsafe {
+        (&raw mut (*base).version).write(version);
+        (&raw mut (*base).name.len).write(name.len);
+        (&raw mut (*base).name.data).write(name.data);
+        (&raw mut (*base).payload.len).write(payload.len);
+        (&raw mut (*base).payload.data).write(payload.data);
+    }
+    buffer
+}
+
+fn as_bytes(buffer: &[u64; WORDS]) -> &[u8] {
+    // SAFETY: every byte of the buffer is initialized
+    unsafe { std::slice::from_raw_parts(buffer.as_ptr() as *const u8, size_of::<NamedRequest>()) }
+}
+
+fn check(request: &[u8]) -> Result<(), PluginError> {
+    // SAFETY: the layout is NamedRequest's and its pointers come from live data
+    unsafe { NamedRequest::LAYOUT.check(request) }
+}
+
+fn message(result: Result<(), PluginError>) -> String {
+    result.unwrap_err().to_string()
+}
+
+#[test]
+fn BinaryLayout___check___accepts_valid_request() {
+    let buffer = request(
+        2,
+        RbString::from_static("key"),
+        RbBytes::from_static(b"\xff\x00"),
+    );
+
+    assert!(check(as_bytes(&buffer)).is_ok());
+}
+
+#[test]
+fn BinaryLayout___check___accepts_absent_fields() {
+    let buffer = request(2, RbString::none(), RbBytes::none());
+
+    assert!(check(as_bytes(&buffer)).is_ok());
+}
+
+#[test]
+fn BinaryLayout___check___rejects_short_request() {
+    let buffer = request(2, RbString::none(), RbBytes::none());
+    let bytes = as_bytes(&buffer);
+
+    let error = check(&bytes[..bytes.len() - 1]).unwrap_err();
+
+    assert_eq!(error.error_code(), 5);
+    assert!(error.to_string().contains("Invalid NamedRequest"));
+}
+
+#[test]
+fn BinaryLayout___check___rejects_misaligned_request() {
+    let buffer = request(2, RbString::none(), RbBytes::none());
+    // SAFETY: the buffer has a spare word after the request
+    let shifted = unsafe {
+        std::slice::from_raw_parts(
+            (buffer.as_ptr() as *const u8).add(1),
+            size_of::<NamedRequest>(),
+        )
+    };
+
+    assert!(message(check(shifted)).contains("not aligned"));
+}
+
+#[test]
+fn BinaryLayout___check___rejects_other_version() {
+    let buffer = request(3, RbString::none(), RbBytes::none());
+
+    assert!(message(check(as_bytes(&buffer))).contains("unsupported version 3 (expected 2)"));
+}
+
+#[test]
+fn BinaryLayout___check___rejects_invalid_utf8() {
+    let name = RbString {
+        len: 2,
+        data: b"\xc3\x28\0".as_ptr(),
+    };
+    let buffer = request(2, name, RbBytes::none());
+
+    assert!(message(check(as_bytes(&buffer))).contains("not valid UTF-8"));
+}
+
+#[test]
+fn BinaryLayout___check___rejects_null_string_with_length() {
+    let name = RbString {
+        len: 4,
+        data: std::ptr::null(),
+    };
+    let buffer = request(2, name, RbBytes::none());
+
+    assert!(check(as_bytes(&buffer)).is_err());
+}
+
+#[test]
+fn BinaryLayout___check___rejects_null_bytes_with_length() {
+    let payload = RbBytes {
+        len: 4,
+        data: std::ptr::null(),
+    };
+    let buffer = request(2, RbString::none(), payload);
+
+    assert!(message(check(as_bytes(&buffer))).contains("null with a length"));
+}
+
+#[test]
+fn BinaryStruct___from_request___reads_checked_request() {
+    let buffer = request(2, RbString::from_static("key"), RbBytes::none());
+    let bytes = as_bytes(&buffer);
+    check(bytes).unwrap();
+
+    // SAFETY: the request passed the layout check
+    let request = unsafe { NamedRequest::from_request(bytes) };
+
+    assert_eq!(request.version, 2);
+    assert_eq!(unsafe { request.name.as_str() }, Some("key"));
+}
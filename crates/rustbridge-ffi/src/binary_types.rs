@@ -16,7 +16,9 @@
 //! All types use explicit `#[repr(C)]` layout for predictable memory representation.
 //! Pointer validity must be ensured by the caller for borrowed types.
 
-use std::ffi::c_void;
+use crate::pool;
+use rustbridge_runtime::{AdmissionStats, WAIT_HISTOGRAM_BUCKETS};
+use std::ffi::{CStr, c_void};
 use std::slice;
 
 // ============================================================================
@@ -364,9 +366,9 @@ impl RbBytesOwned {
         }
     }
 
-    /// Create from a byte slice (copies data)
+    /// Create from a byte slice (copies data into a pooled buffer)
     pub fn from_slice(bytes: &[u8]) -> Self {
-        Self::from_vec(bytes.to_vec())
+        Self::from_vec(pool::take_copy(bytes))
     }
 
     /// Convert to borrowed RbBytes
@@ -386,10 +388,9 @@ impl RbBytesOwned {
     /// - Must only be called on buffers created by Rust
     pub unsafe fn free(&mut self) {
         if !self.data.is_null() && self.capacity > 0 {
-            // Reconstruct the Vec and let it drop
-            let _ = unsafe {
-                Vec::from_raw_parts(self.data, self.len as usize, self.capacity as usize)
-            };
+            unsafe {
+                pool::recycle_raw(self.data, self.len as usize, self.capacity as usize);
+            }
             self.data = std::ptr::null_mut();
             self.len = 0;
             self.capacity = 0;
@@ -435,7 +436,7 @@ pub struct RbResponse {
     pub error_code: u32,
     /// Size of response data in bytes
     pub len: u32,
-    /// Allocation capacity
+    /// Allocation capacity (0 for static data, which is never freed)
     pub capacity: u32,
     /// Pointer to response data (or error message)
     pub data: *mut c_void,
@@ -444,57 +445,80 @@ pub struct RbResponse {
 impl RbResponse {
     /// Create a successful response with struct data
     ///
+    /// The value is copied into a pooled byte buffer. Byte buffers come from
+    /// the system allocator, which aligns them for any primitive type.
+    ///
     /// # Safety
     ///
     /// The type T must be `#[repr(C)]` and safe to transmit across FFI.
     pub fn success<T: Sized>(value: T) -> Self {
         let size = std::mem::size_of::<T>();
-        let align = std::mem::align_of::<T>();
-
-        // Allocate aligned memory
-        #[allow(clippy::expect_used)] // Safe: Layout is valid for any Sized type from std::mem
-        let layout = std::alloc::Layout::from_size_align(size, align)
-            .expect("Invalid layout for response type");
-
-        // SAFETY: We just created a valid layout
-        let data = unsafe { std::alloc::alloc(layout) as *mut c_void };
-
-        if data.is_null() {
-            return Self::error(11, "Failed to allocate response buffer");
-        }
+        let mut data = pool::take(size);
 
-        // Copy the value into the allocated memory
-        // SAFETY: data is valid, aligned, and sized for T
+        // SAFETY: data has capacity for size bytes, and the unaligned write
+        // makes no assumption about where the allocator placed them
         unsafe {
-            std::ptr::write(data as *mut T, value);
+            std::ptr::write_unaligned(data.as_mut_ptr() as *mut T, value);
+            data.set_len(size);
         }
 
+        Self::from_vec(data)
+    }
+
+    /// Create a successful response from raw struct bytes (takes ownership)
+    pub fn from_vec(mut data: Vec<u8>) -> Self {
+        let len = data.len();
+        let capacity = data.capacity();
+        let ptr = data.as_mut_ptr();
+        std::mem::forget(data);
+
         Self {
             error_code: 0,
-            len: size as u32,
-            capacity: size as u32,
-            data,
+            len: len as u32,
+            capacity: capacity as u32,
+            data: ptr as *mut c_void,
         }
     }
 
     /// Create an error response
+    ///
+    /// The message is NUL-terminated in a pooled buffer.
     pub fn error(code: u32, message: &str) -> Self {
-        let mut msg = message.as_bytes().to_vec();
+        let mut msg = pool::take(message.len() + 1);
+        msg.extend_from_slice(message.as_bytes());
         msg.push(0); // Null terminate
 
-        let len = msg.len();
-        let capacity = msg.capacity();
-        let data = msg.as_mut_ptr();
-        std::mem::forget(msg);
+        let mut response = Self::from_vec(msg);
+        response.error_code = code;
+        response
+    }
 
+    /// Create an error response over a static message
+    ///
+    /// Nothing is allocated. The response borrows `message` and reports a
+    /// capacity of 0, which `free` treats as nothing to release.
+    pub const fn error_static(code: u32, message: &'static CStr) -> Self {
         Self {
             error_code: code,
-            len: len as u32,
-            capacity: capacity as u32,
-            data: data as *mut c_void,
+            len: message.to_bytes_with_nul().len() as u32,
+            capacity: 0,
+            data: message.as_ptr() as *mut c_void,
         }
     }
 
+    /// Create an error response with a formatted message
+    ///
+    /// The message is written straight into a pooled buffer and
+    /// NUL-terminated, without formatting it into a `String` first.
+    pub fn error_fmt(code: u32, message: std::fmt::Arguments<'_>) -> Self {
+        let mut msg = pool::write_fmt(message);
+        msg.push(0); // Null terminate
+
+        let mut response = Self::from_vec(msg);
+        response.error_code = code;
+        response
+    }
+
     /// Create an empty response (for invalid calls)
     pub fn empty() -> Self {
         Self {
@@ -517,30 +541,17 @@ impl RbResponse {
     ///
     /// - Must only be called once
     /// - Must only be called on responses created by Rust
-    /// - For success responses, the original type's size must match `len`
+    ///
+    /// Responses with a capacity of 0 own no memory and are left as they are.
     pub unsafe fn free(&mut self) {
         if !self.data.is_null() && self.capacity > 0 {
-            if self.error_code != 0 {
-                // Error message is a Vec<u8>
-                let _ = unsafe {
-                    Vec::from_raw_parts(
-                        self.data as *mut u8,
-                        self.len as usize,
-                        self.capacity as usize,
-                    )
-                };
-            } else {
-                // Success data was allocated with alloc
-                // SAFETY: capacity was set from a valid layout during allocation
-                let layout = unsafe {
-                    std::alloc::Layout::from_size_align_unchecked(
-                        self.capacity as usize,
-                        std::mem::align_of::<usize>(), // Conservative alignment
-                    )
-                };
-                unsafe {
-                    std::alloc::dealloc(self.data as *mut u8, layout);
-                }
+            // Success data and error messages are both byte buffers
+            unsafe {
+                pool::recycle_raw(
+                    self.data as *mut u8,
+                    self.len as usize,
+                    self.capacity as usize,
+                );
             }
             self.data = std::ptr::null_mut();
             self.len = 0;
@@ -573,6 +584,126 @@ impl Default for RbResponse {
     }
 }
 
+// ============================================================================
+// Batch Request Descriptor
+// ============================================================================
+
+/// Descriptor for one message in a `plugin_call_raw_batch` call
+///
+/// The request bytes are borrowed from the caller for the duration of the call.
+///
+/// # Memory Layout
+///
+/// ```text
+/// +------------+-----------+------------+--------------+
+/// | message_id | _reserved |  request   | request_size |
+/// |   (u32)    |   (u32)   | (*const u8)|   (usize)    |
+/// +------------+-----------+------------+--------------+
+/// ```
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct RbBatchRequest {
+    /// Numeric message identifier
+    pub message_id: u32,
+    /// Reserved for alignment (must be zero)
+    pub _reserved: u32,
+    /// Pointer to the request struct
+    pub request: *const c_void,
+    /// Size of the request struct in bytes
+    pub request_size: usize,
+}
+
+impl RbBatchRequest {
+    /// Create a descriptor borrowing `request`
+    pub fn new(message_id: u32, request: &[u8]) -> Self {
+        Self {
+            message_id,
+            _reserved: 0,
+            request: request.as_ptr() as *const c_void,
+            request_size: request.len(),
+        }
+    }
+}
+
+// ============================================================================
+// Admission Stats
+// ============================================================================
+
+/// Admission control counters returned by `plugin_get_admission_stats`
+///
+/// Every field is a `u64` so the layout is the same on all platforms
+/// (248 bytes, no padding). `wait_histogram_us[i]` counts queued requests
+/// that waited `[2^(i-1), 2^i)` microseconds; bucket 0 counts waits under
+/// 1 µs and the last bucket also counts every longer wait.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct RbAdmissionStats {
+    /// Maximum number of requests in flight (0 = unlimited)
+    pub limit: u64,
+    /// Requests currently holding a slot
+    pub in_flight: u64,
+    /// Requests currently queued for a slot
+    pub queue_depth: u64,
+    /// Requests admitted, directly or after queueing
+    pub admitted: u64,
+    /// Requests that had to queue
+    pub queued: u64,
+    /// Requests rejected with `TooManyRequests`, including timeouts
+    pub rejected: u64,
+    /// Queued requests rejected because their deadline passed
+    pub timed_out: u64,
+    /// Queue wait times of admitted requests, in log2 microsecond buckets
+    pub wait_histogram_us: [u64; WAIT_HISTOGRAM_BUCKETS],
+}
+
+impl From<&AdmissionStats> for RbAdmissionStats {
+    fn from(stats: &AdmissionStats) -> Self {
+        Self {
+            limit: stats.limit as u64,
+            in_flight: stats.in_flight as u64,
+            queue_depth: stats.queue_depth as u64,
+            admitted: stats.admitted,
+            queued: stats.queued,
+            rejected: stats.rejected,
+            timed_out: stats.timed_out,
+            wait_histogram_us: stats.wait_histogram_us,
+        }
+    }
+}
+
+// ============================================================================
+// Slow Calls
+// ============================================================================
+
+/// A slow call captured by the flight recorder, returned by `plugin_get_slow_calls`
+///
+/// 64 bytes with no padding on every platform. A phase the call never
+/// reached (for example, serializing after a rejected admission) is 0.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct RbSlowCall {
+    /// When the call started, in nanoseconds since the plugin started
+    pub started_ns: u64,
+    /// Duration of the whole call
+    pub total_ns: u64,
+    /// Time waiting for admission
+    pub queue_ns: u64,
+    /// Time validating the request and finding the handler
+    pub dispatch_ns: u64,
+    /// Time in the handler
+    pub handler_ns: u64,
+    /// Time encoding the response
+    pub serialize_ns: u64,
+    /// `RB_CALL_KIND_JSON` or `RB_CALL_KIND_BINARY`
+    pub kind: u32,
+    /// Type ID for JSON calls (0 for tags without one), message ID for binary calls
+    pub id: u32,
+    /// Bitwise OR of `RB_SLOW_CALL_*` flags
+    pub flags: u32,
+    /// Number identifying the calling thread, unique within the process
+    pub thread: u32,
+}
+
 // ============================================================================
 // Tests
 // ============================================================================
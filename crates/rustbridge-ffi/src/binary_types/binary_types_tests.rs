@@ -309,6 +309,53 @@ fn RbResponse___as_ref___returns_none_for_error() {
     unsafe { resp.free() };
 }
 
+#[test]
+fn RbResponse___free___returns_buffer_to_pool_for_next_response() {
+    let mut first = RbResponse::success(TestStruct { x: 1, y: 2 });
+    let data = first.data;
+    unsafe { first.free() };
+
+    let mut second = RbResponse::error(7, "reused");
+
+    assert_eq!(second.data, data);
+    unsafe { second.free() };
+}
+
+#[test]
+fn RbResponse___from_vec___adopts_bytes() {
+    let mut resp = RbResponse::from_vec(vec![1, 2, 3]);
+
+    assert!(!resp.is_error());
+    assert_eq!(resp.len, 3);
+    assert!(resp.capacity >= 3);
+
+    unsafe { resp.free() };
+}
+
+#[test]
+fn RbResponse___error_static___borrows_nul_terminated_message() {
+    let mut resp = RbResponse::error_static(1, c"Invalid handle");
+
+    assert!(resp.is_error());
+    assert_eq!(resp.capacity, 0);
+    assert_eq!(resp.len as usize, "Invalid handle".len() + 1);
+    let message = unsafe { std::ffi::CStr::from_ptr(resp.data as *const std::ffi::c_char) };
+    assert_eq!(message, c"Invalid handle");
+
+    unsafe { resp.free() }; // Static data is not released
+}
+
+#[test]
+fn RbResponse___error_fmt___nul_terminates_message() {
+    let mut resp = RbResponse::error_fmt(6, format_args!("Unknown message ID: {}", 7));
+
+    let message = unsafe { std::ffi::CStr::from_ptr(resp.data as *const std::ffi::c_char) };
+    assert_eq!(message, c"Unknown message ID: 7");
+    assert_eq!(resp.len as usize, message.to_bytes_with_nul().len());
+
+    unsafe { resp.free() };
+}
+
 #[test]
 fn RbResponse___free___safe_to_call_on_empty() {
     let mut resp = RbResponse::empty();
@@ -353,3 +400,63 @@ fn memory_layout___RbResponse___has_expected_size() {
     let size = std::mem::size_of::<RbResponse>();
     assert!(size >= 16, "RbResponse too small: {}", size);
 }
+
+#[test]
+fn memory_layout___RbBatchRequest___has_expected_size() {
+    // u32 (4) + u32 (4) + ptr + usize = 24 bytes on 64-bit, 16 on 32-bit
+    let size = std::mem::size_of::<RbBatchRequest>();
+    assert!(
+        size == 16 || size == 24,
+        "Unexpected RbBatchRequest size: {}",
+        size
+    );
+}
+
+#[test]
+fn RbBatchRequest___new___borrows_request_bytes() {
+    let data = [1u8, 2, 3];
+
+    let request = RbBatchRequest::new(7, &data);
+
+    assert_eq!(request.message_id, 7);
+    assert_eq!(request._reserved, 0);
+    assert_eq!(request.request, data.as_ptr() as *const c_void);
+    assert_eq!(request.request_size, 3);
+}
+
+#[test]
+fn memory_layout___RbAdmissionStats___has_expected_size() {
+    // 7 u64 counters + 24 u64 histogram buckets, no padding
+    assert_eq!(std::mem::size_of::<RbAdmissionStats>(), 248);
+}
+
+#[test]
+fn memory_layout___RbSlowCall___has_expected_size() {
+    // 6 u64 timestamps and durations + 4 u32 fields, no padding
+    assert_eq!(std::mem::size_of::<RbSlowCall>(), 64);
+    assert_eq!(std::mem::align_of::<RbSlowCall>(), 8);
+}
+
+#[test]
+fn RbAdmissionStats___from___copies_every_counter() {
+    let mut stats = AdmissionStats {
+        limit: 4,
+        in_flight: 3,
+        queue_depth: 2,
+        admitted: 10,
+        queued: 5,
+        rejected: 1,
+        timed_out: 1,
+        ..Default::default()
+    };
+    stats.wait_histogram_us[3] = 5;
+
+    let ffi = RbAdmissionStats::from(&stats);
+
+    assert_eq!((ffi.limit, ffi.in_flight, ffi.queue_depth), (4, 3, 2));
+    assert_eq!(
+        (ffi.admitted, ffi.queued, ffi.rejected, ffi.timed_out),
+        (10, 5, 1, 1)
+    );
+    assert_eq!(ffi.wait_histogram_us[3], 5);
+}
@@ -1,5 +1,6 @@
 //! FFI buffer for passing data across the boundary
 
+use crate::pool;
 use std::ptr;
 
 /// Buffer for passing data across FFI boundary
@@ -12,14 +13,14 @@ use std::ptr;
 /// # Memory Safety
 ///
 /// The buffer owns its memory. When `plugin_free_buffer` is called, the
-/// memory is deallocated. The host must not use the buffer after freeing it.
+/// memory is returned to the freeing thread's buffer pool or deallocated. The host must not use the buffer after freeing it.
 #[repr(C)]
 pub struct FfiBuffer {
     /// Pointer to the data
     pub data: *mut u8,
     /// Length of valid data in bytes
     pub len: usize,
-    /// Total capacity of the allocation
+    /// Total capacity of the allocation (0 for static data, which is never freed)
     pub capacity: usize,
     /// Error code (0 = success)
     pub error_code: u32,
@@ -59,7 +60,31 @@ impl FfiBuffer {
     ///
     /// The error message is stored in the buffer data.
     pub fn error(code: u32, message: &str) -> Self {
-        let mut buffer = Self::from_vec(message.as_bytes().to_vec());
+        let mut buffer = Self::from_vec(pool::take_copy(message.as_bytes()));
+        buffer.error_code = code;
+        buffer
+    }
+
+    /// Create an error buffer over static data
+    ///
+    /// Nothing is allocated. The buffer borrows `data` and reports a
+    /// capacity of 0, which `free` treats as nothing to release, so fixed
+    /// errors on rejection paths cost no more than returning the struct.
+    pub const fn error_static(code: u32, data: &'static [u8]) -> Self {
+        Self {
+            data: data.as_ptr() as *mut u8,
+            len: data.len(),
+            capacity: 0,
+            error_code: code,
+        }
+    }
+
+    /// Create an error buffer with a formatted message
+    ///
+    /// The message is written straight into a pooled buffer, without
+    /// formatting it into a `String` first.
+    pub fn error_fmt(code: u32, message: std::fmt::Arguments<'_>) -> Self {
+        let mut buffer = Self::from_vec(pool::write_fmt(message));
         buffer.error_code = code;
         buffer
     }
@@ -102,12 +127,12 @@ impl FfiBuffer {
     /// # Safety
     ///
     /// This must only be called once per buffer. After calling, the buffer
-    /// is invalid and must not be used.
+    /// is invalid and must not be used. Buffers with a capacity of 0 own no
+    /// memory and are only reset.
     pub unsafe fn free(&mut self) {
         unsafe {
             if !self.data.is_null() && self.capacity > 0 {
-                // Reconstruct the Vec and let it drop
-                let _ = Vec::from_raw_parts(self.data, self.len, self.capacity);
+                pool::recycle_raw(self.data, self.len, self.capacity);
             }
             self.data = ptr::null_mut();
             self.len = 0;
@@ -152,3 +152,47 @@ fn FfiBuffer___as_slice___empty_buffer_returns_empty_slice() {
         assert!(slice.is_empty());
     }
 }
+
+#[test]
+fn FfiBuffer___free___returns_memory_to_pool_for_next_error() {
+    let mut first = FfiBuffer::error(7, "first error");
+    let data = first.data;
+    unsafe { first.free() };
+
+    let mut second = FfiBuffer::error(7, "second error");
+
+    assert_eq!(second.data, data);
+    unsafe { second.free() };
+}
+
+#[test]
+fn FfiBuffer___error_static___borrows_message() {
+    static MESSAGE: &[u8] = b"Invalid handle";
+
+    let buf = FfiBuffer::error_static(1, MESSAGE);
+
+    assert_eq!(buf.data as *const u8, MESSAGE.as_ptr());
+    assert_eq!(buf.len, MESSAGE.len());
+    assert_eq!(buf.capacity, 0);
+    assert_eq!(buf.error_code, 1);
+}
+
+#[test]
+fn FfiBuffer___error_static___free_leaves_message_intact() {
+    let mut buf = FfiBuffer::error_static(1, b"Invalid handle");
+
+    unsafe { buf.free() };
+
+    assert!(buf.data.is_null());
+    assert_eq!(FfiBuffer::error_static(1, b"Invalid handle").len, 14);
+}
+
+#[test]
+fn FfiBuffer___error_fmt___formats_message() {
+    let mut buf = FfiBuffer::error_fmt(6, format_args!("Unknown message ID: {}", 42));
+
+    unsafe {
+        assert_eq!(buf.as_slice(), b"Unknown message ID: 42");
+        buf.free();
+    }
+}
@@ -2,18 +2,22 @@
 //!
 //! These functions are the FFI entry points called by host languages.
 
-use crate::binary_types::RbResponse;
+use crate::binary_types::{RbAdmissionStats, RbBatchRequest, RbResponse, RbSlowCall};
 use crate::buffer::FfiBuffer;
 use crate::handle::{PluginHandle, PluginHandleManager};
+use crate::metrics::{CallTimer, MetricKey, Phase};
 use crate::panic_guard::catch_panic;
-use dashmap::DashMap;
-use once_cell::sync::OnceCell;
-use rustbridge_core::{LogLevel, PluginConfig};
-use rustbridge_logging::{LogCallback, LogCallbackManager};
+use crate::registry::BinaryHandlers;
+use crate::ring::{RbRingChannel, RingChannel};
+use crate::static_errors;
+use rustbridge_core::{ContentType, LogLevel, PluginConfig, PluginError};
+use rustbridge_logging::{LogBatchCallback, LogCallback, LogCallbackManager};
 use rustbridge_transport::ResponseEnvelope;
+use std::borrow::Cow;
 use std::ffi::c_void;
 use std::panic::AssertUnwindSafe;
 use std::ptr;
+use std::sync::Arc;
 
 /// Opaque handle type for FFI
 pub type FfiPluginHandle = *mut c_void;
@@ -84,37 +88,29 @@ unsafe fn plugin_init_impl(
         }
     };
 
-    // Register plugin with callback manager (increments ref count)
-    LogCallbackManager::global().register_plugin(log_callback);
+    // Give this plugin its own callback, level and delivery mode BEFORE
+    // initializing logging, so nothing it logs reaches another plugin's host
+    let logger = LogCallbackManager::from_config(&config, log_callback);
 
-    // Set the log level from config BEFORE initializing logging
-    let log_level = match config.log_level.to_lowercase().as_str() {
-        "trace" => LogLevel::Trace,
-        "debug" => LogLevel::Debug,
-        "info" => LogLevel::Info,
-        "warn" => LogLevel::Warn,
-        "error" => LogLevel::Error,
-        "off" => LogLevel::Off,
-        _ => LogLevel::Info, // Default to Info for unknown values
-    };
-    LogCallbackManager::global().set_level(log_level);
-
-    // Initialize logging with the configured level
+    // Install the process-wide subscriber (first plugin only)
     rustbridge_logging::init_logging();
 
     // Install panic hook to log panics via FFI callback
     crate::panic_guard::install_panic_hook();
 
+    let _log = logger.enter();
+
     // Take ownership of the plugin
     // SAFETY: caller guarantees plugin_ptr is from plugin_create
     let plugin: Box<Box<dyn rustbridge_core::Plugin>> =
         unsafe { Box::from_raw(plugin_ptr as *mut Box<dyn rustbridge_core::Plugin>) };
 
     // Create the handle
-    let handle = match PluginHandle::new(*plugin, config) {
+    let handle = match PluginHandle::with_logger(*plugin, config, Arc::clone(&logger)) {
         Ok(h) => h,
         Err(e) => {
             tracing::error!("Failed to create handle: {}", e);
+            logger.close();
             return ptr::null_mut();
         }
     };
@@ -122,15 +118,16 @@ unsafe fn plugin_init_impl(
     // Start the plugin
     if let Err(e) = handle.start() {
         tracing::error!("Failed to start plugin: {}", e);
+        logger.close();
         return ptr::null_mut();
     }
 
-    // Register and return handle
+    // Register and return handle (registration also stores the ID in the handle)
     let id = PluginHandleManager::global().register(handle);
-
-    // Store ID in the handle
-    if let Some(h) = PluginHandleManager::global().get(id) {
-        h.set_id(id);
+    if id == 0 {
+        tracing::error!("Failed to register plugin handle: handle table is full");
+        logger.close();
+        return ptr::null_mut();
     }
 
     id as FfiPluginHandle
@@ -178,22 +175,61 @@ unsafe fn plugin_call_impl(
 ) -> FfiBuffer {
     // Validate handle
     let id = handle as u64;
-    let plugin_handle = match PluginHandleManager::global().get(id) {
+    let plugin_handle = match PluginHandleManager::global().lookup(id) {
         Some(h) => h,
-        None => return FfiBuffer::error(1, "Invalid handle"),
+        None => return FfiBuffer::error_static(1, b"Invalid handle"),
     };
+    let timer = plugin_handle.call_timer();
 
     // Parse type tag
     let type_tag_str = if type_tag.is_null() {
-        return FfiBuffer::error(4, "Type tag is null");
+        return FfiBuffer::error_static(4, b"Type tag is null");
     } else {
         // SAFETY: caller guarantees type_tag is a valid null-terminated C string
         match unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() {
             Ok(s) => s,
-            Err(_) => return FfiBuffer::error(4, "Invalid type tag encoding"),
+            Err(_) => return FfiBuffer::error_static(4, b"Invalid type tag encoding"),
         }
     };
 
+    // SAFETY: caller guarantees request is valid for request_len bytes
+    unsafe {
+        call_json(
+            &plugin_handle,
+            type_tag_str,
+            None,
+            request,
+            request_len,
+            timer,
+        )
+    }
+}
+
+/// Call a plugin with a JSON request and wrap the result in an envelope
+///
+/// Shared by `plugin_call` and `plugin_call_id` once the type tag is known.
+/// `type_id` is only looked up from the tag when metrics need it.
+///
+/// # Safety
+/// - `request` must be null or valid for `request_len` bytes
+unsafe fn call_json(
+    plugin_handle: &PluginHandle,
+    type_tag: &str,
+    type_id: Option<u32>,
+    request: *const u8,
+    request_len: usize,
+    mut timer: CallTimer<'_>,
+) -> FfiBuffer {
+    timer.key(|| {
+        MetricKey::Json(type_id.unwrap_or_else(|| plugin_handle.resolve_type_tag(type_tag)))
+    });
+
+    // Reject calls to an inactive plugin without building the error
+    let state = plugin_handle.state();
+    if !state.can_handle_requests() {
+        return static_errors::inactive_envelope(state);
+    }
+
     // Get request data
     let request_data = if request.is_null() || request_len == 0 {
         &[]
@@ -202,29 +238,212 @@ unsafe fn plugin_call_impl(
         unsafe { std::slice::from_raw_parts(request, request_len) }
     };
 
+    timer.lap(Phase::Dispatch);
+
     // Make the call
-    match plugin_handle.call(type_tag_str, request_data) {
+    let (buffer, ok) = match plugin_handle.call_timed(type_tag, request_data, &mut timer) {
         Ok(response_data) => {
             // Wrap in response envelope
-            match ResponseEnvelope::success_raw(&response_data) {
-                Ok(envelope) => match envelope.to_bytes() {
-                    Ok(bytes) => FfiBuffer::from_vec(bytes),
-                    Err(e) => FfiBuffer::error(5, &format!("Serialization error: {}", e)),
-                },
-                Err(e) => FfiBuffer::error(5, &format!("Serialization error: {}", e)),
+            match plugin_handle.encode_success(&response_data) {
+                Ok(bytes) => (FfiBuffer::from_vec(bytes), true),
+                Err(e) => (
+                    FfiBuffer::error(5, &format!("Serialization error: {}", e)),
+                    false,
+                ),
             }
         }
-        Err(e) => {
-            let envelope = ResponseEnvelope::from_error(&e);
-            match envelope.to_bytes() {
-                Ok(bytes) => {
-                    let mut buf = FfiBuffer::from_vec(bytes);
-                    buf.error_code = e.error_code();
-                    buf
-                }
-                Err(se) => FfiBuffer::error(e.error_code(), &format!("{}: {}", e, se)),
+        Err(e) => (error_envelope_buffer(&e), false),
+    };
+    timer.lap(Phase::Serialize);
+    timer.finish(ok);
+    buffer
+}
+
+/// Resolve a type tag to a numeric ID for `plugin_call_id`
+///
+/// Hosts call this once per type tag, typically at startup, and then make
+/// requests with [`plugin_call_id`], which skips measuring, validating and
+/// matching the tag string on every call. IDs are assigned to the tags the
+/// plugin lists in `supported_types` when it starts and stay valid for the
+/// lifetime of the handle.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_tag`: Message type identifier (null-terminated C string)
+///
+/// # Returns
+/// The type ID (never 0), or 0 if the handle is invalid, `type_tag` is null
+/// or not UTF-8, or the plugin does not list the tag. Hosts fall back to
+/// `plugin_call` for tags that resolve to 0.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `type_tag` must be null or a valid null-terminated C string
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_resolve_type_tag(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+) -> u32 {
+    let id = handle as u64;
+    let Some(plugin_handle) = PluginHandleManager::global().lookup(id) else {
+        return 0;
+    };
+    if type_tag.is_null() {
+        return 0;
+    }
+    // SAFETY: caller guarantees type_tag is a valid null-terminated C string
+    match unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() {
+        Ok(type_tag_str) => plugin_handle.resolve_type_tag(type_tag_str),
+        Err(_) => 0,
+    }
+}
+
+/// Make a synchronous call to the plugin by type ID
+///
+/// Behaves exactly like [`plugin_call`] for the type tag that `type_id` was
+/// resolved from, including the JSON response envelope.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_id`: Type ID from plugin_resolve_type_tag
+/// - `request`: Request payload bytes
+/// - `request_len`: Length of request payload
+///
+/// # Returns
+/// FfiBuffer containing the response (must be freed with plugin_free_buffer).
+/// IDs that were not returned by `plugin_resolve_type_tag` for this handle
+/// fail with error code 6 (unknown message type).
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `request` must be valid for `request_len` bytes
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_call_id(
+    handle: FfiPluginHandle,
+    type_id: u32,
+    request: *const u8,
+    request_len: usize,
+) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            let Some(plugin_handle) = PluginHandleManager::global().lookup(handle_id) else {
+                return FfiBuffer::error_static(1, b"Invalid handle");
+            };
+            let timer = plugin_handle.call_timer();
+            let Some(type_tag) = plugin_handle.type_tag(type_id) else {
+                return FfiBuffer::error_static(6, b"Unknown type ID");
+            };
+            // SAFETY: caller guarantees request is valid for request_len bytes
+            unsafe {
+                call_json(
+                    &plugin_handle,
+                    type_tag,
+                    Some(type_id),
+                    request,
+                    request_len,
+                    timer,
+                )
+            }
+        }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Make a synchronous call with a negotiated payload content type
+///
+/// Unlike [`plugin_call`], the response is not wrapped in a JSON envelope: on
+/// success the buffer holds the handler's response encoded as `content_type`,
+/// and on failure `error_code` is set and the buffer holds the UTF-8 error
+/// message. Binary payloads therefore never pass through JSON.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_tag`: Message type identifier (null-terminated C string)
+/// - `content_type`: MIME type of the request and response (null-terminated C
+///   string, e.g. `application/msgpack`); null means `application/json`
+/// - `request`: Request payload bytes
+/// - `request_len`: Length of request payload
+///
+/// # Returns
+/// FfiBuffer containing the response (must be freed with plugin_free_buffer).
+/// Unknown MIME types, and types the plugin does not implement, fail with
+/// error code 15 (unsupported content type).
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `type_tag` must be a valid null-terminated C string
+/// - `content_type` must be null or a valid null-terminated C string
+/// - `request` must be valid for `request_len` bytes
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_call_as(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    content_type: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe {
+            plugin_call_as_impl(handle, type_tag, content_type, request, request_len)
+        }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Internal implementation of plugin_call_as (wrapped by panic handler)
+unsafe fn plugin_call_as_impl(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    content_type: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+) -> FfiBuffer {
+    let id = handle as u64;
+    let plugin_handle = match PluginHandleManager::global().lookup(id) {
+        Some(h) => h,
+        None => return FfiBuffer::error_static(1, b"Invalid handle"),
+    };
+
+    if type_tag.is_null() {
+        return FfiBuffer::error_static(4, b"Type tag is null");
+    }
+    // SAFETY: caller guarantees type_tag is a valid null-terminated C string
+    let Ok(type_tag_str) = unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() else {
+        return FfiBuffer::error_static(4, b"Invalid type tag encoding");
+    };
+
+    let content_type = if content_type.is_null() {
+        ContentType::Json
+    } else {
+        // SAFETY: caller guarantees content_type is a valid null-terminated C string
+        let mime = unsafe { std::ffi::CStr::from_ptr(content_type) }.to_string_lossy();
+        match ContentType::from_mime(&mime) {
+            Some(content_type) => content_type,
+            None => {
+                let err = PluginError::UnsupportedContentType(mime.into_owned());
+                return FfiBuffer::error(err.error_code(), &err.to_string());
             }
         }
+    };
+
+    let request_data = if request.is_null() || request_len == 0 {
+        &[]
+    } else {
+        // SAFETY: caller guarantees request is valid for request_len bytes
+        unsafe { std::slice::from_raw_parts(request, request_len) }
+    };
+
+    match plugin_handle.call_as(type_tag_str, content_type, request_data) {
+        Ok(response_data) => FfiBuffer::from_vec(response_data),
+        Err(e) => FfiBuffer::error_fmt(e.error_code(), format_args!("{e}")),
     }
 }
 
@@ -279,13 +498,9 @@ fn plugin_shutdown_impl(handle: FfiPluginHandle) -> bool {
         }
     };
 
-    // Clear binary handlers for this thread to avoid stale handlers on reload
-    clear_binary_handlers();
-
-    // Unregister plugin from callback manager (decrements ref count)
-    // The callback will only be cleared when the last plugin shuts down.
-    // This allows multiple plugins to coexist and share the same callback.
-    LogCallbackManager::global().unregister_plugin();
+    // Deliver anything still queued, then drop this plugin's callbacks.
+    // Other plugins keep their own.
+    plugin_handle.logger().close();
 
     result
 }
@@ -302,7 +517,7 @@ fn plugin_shutdown_impl(handle: FfiPluginHandle) -> bool {
 pub unsafe extern "C" fn plugin_set_log_level(handle: FfiPluginHandle, level: u8) {
     let id = handle as u64;
 
-    if let Some(plugin_handle) = PluginHandleManager::global().get(id) {
+    if let Some(plugin_handle) = PluginHandleManager::global().lookup(id) {
         plugin_handle.set_log_level(LogLevel::from_u8(level));
     }
 }
@@ -322,7 +537,7 @@ pub unsafe extern "C" fn plugin_set_log_level(handle: FfiPluginHandle, level: u8
 pub unsafe extern "C" fn plugin_get_state(handle: FfiPluginHandle) -> u8 {
     let id = handle as u64;
 
-    match PluginHandleManager::global().get(id) {
+    match PluginHandleManager::global().lookup(id) {
         Some(h) => match h.state() {
             rustbridge_core::LifecycleState::Installed => 0,
             rustbridge_core::LifecycleState::Starting => 1,
@@ -348,52 +563,169 @@ pub unsafe extern "C" fn plugin_get_state(handle: FfiPluginHandle) -> u8 {
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn plugin_get_rejected_count(handle: FfiPluginHandle) -> u64 {
     let id = handle as u64;
-    match PluginHandleManager::global().get(id) {
+    match PluginHandleManager::global().lookup(id) {
         Some(h) => h.rejected_request_count(),
         None => 0,
     }
 }
 
-// ============================================================================
-// Binary Transport Functions
-// ============================================================================
-
-/// Handler function type for binary message processing
+/// Set a callback that receives log events in batches
+///
+/// With `logging.delivery` set to `"async"`, queued events are handed to
+/// this callback from a background thread, many per call. Without it, the
+/// `log_callback` passed to `plugin_init` is called once per event instead.
+/// Like that callback, it only receives this plugin's events and is cleared
+/// when the plugin shuts down.
 ///
-/// Plugins that want to support binary transport must register handlers
-/// using this signature. The handler receives the request struct as raw bytes
-/// and must return response bytes (which will be wrapped in RbResponse).
-pub type BinaryMessageHandler =
-    fn(handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, rustbridge_core::PluginError>;
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `callback`: Batched log callback, or null to remove it
+///
+/// # Returns
+/// `true` if the callback was set, `false` if the handle is invalid
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - The callback must remain valid until it is replaced or the plugin shuts down
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_set_log_batch_callback(
+    handle: FfiPluginHandle,
+    callback: Option<LogBatchCallback>,
+) -> bool {
+    let id = handle as u64;
+    match PluginHandleManager::global().lookup(id) {
+        Some(h) => {
+            h.logger().set_batch_callback(callback);
+            true
+        }
+        None => false,
+    }
+}
 
-/// Global registry for binary message handlers
+/// Get the number of log events dropped because the async log queue was full
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+///
+/// # Returns
+/// Number of this plugin's events dropped. Returns 0 if handle is invalid.
 ///
-/// This uses a thread-safe DashMap so handlers registered from the Tokio
-/// worker thread are visible when plugin_call_raw is called from the host
-/// language thread.
-static BINARY_HANDLERS: OnceCell<DashMap<u32, BinaryMessageHandler>> = OnceCell::new();
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_get_dropped_log_count(handle: FfiPluginHandle) -> u64 {
+    let id = handle as u64;
+    match PluginHandleManager::global().lookup(id) {
+        Some(h) => h.logger().dropped_count(),
+        None => 0,
+    }
+}
 
-/// Get the binary handlers registry, initializing if needed
-fn binary_handlers() -> &'static DashMap<u32, BinaryMessageHandler> {
-    BINARY_HANDLERS.get_or_init(DashMap::new)
+/// Copy the plugin's admission control counters into `out`
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `out`: Receives the counters; left untouched on failure
+///
+/// # Returns
+/// `true` on success, `false` if the handle is invalid or `out` is null.
+/// Plugins without a concurrency limit report all-zero counters.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `out` must be null or valid for writing one `RbAdmissionStats`
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_get_admission_stats(
+    handle: FfiPluginHandle,
+    out: *mut RbAdmissionStats,
+) -> bool {
+    if out.is_null() {
+        return false;
+    }
+    let id = handle as u64;
+    match PluginHandleManager::global().lookup(id) {
+        Some(h) => {
+            // SAFETY: out is non-null and the caller guarantees it is writable
+            unsafe { out.write(RbAdmissionStats::from(&h.admission_stats())) };
+            true
+        }
+        None => false,
+    }
 }
 
-/// Register a binary message handler
+/// Get per-handler call counts and latency histograms as JSON
+///
+/// Only recorded when the plugin was started with `metrics.enabled`;
+/// otherwise the snapshot is `{"enabled":false,"handlers":[]}`. Each entry
+/// in `handlers` has `kind` (`json` or `binary`), the `type_tag` or
+/// `message_id` it counts, `calls`, `errors`, and one latency summary per
+/// phase (`queue`, `dispatch`, `handler`, `serialize`) with `count`,
+/// `sum_ns`, `p50_ns`, `p90_ns`, `p99_ns` and the non-empty `buckets` as
+/// `[lower_bound_ns, count]` pairs.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+///
+/// # Returns
+/// FfiBuffer containing the JSON snapshot (must be freed with
+/// plugin_free_buffer), or error code 1 if the handle is invalid
 ///
-/// Call this during plugin initialization to register handlers for
-/// binary transport message types.
-pub fn register_binary_handler(message_id: u32, handler: BinaryMessageHandler) {
-    binary_handlers().insert(message_id, handler);
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_get_metrics(handle: FfiPluginHandle) -> FfiBuffer {
+    let id = handle as u64;
+    let Some(plugin_handle) = PluginHandleManager::global().lookup(id) else {
+        return FfiBuffer::error_static(1, b"Invalid handle");
+    };
+    match serde_json::to_vec(&plugin_handle.metrics_snapshot()) {
+        Ok(bytes) => FfiBuffer::from_vec(bytes),
+        Err(e) => FfiBuffer::error(5, &format!("Serialization error: {}", e)),
+    }
 }
 
-/// Clear all binary message handlers
+/// Copy the plugin's latest slow calls into `out`, newest first
+///
+/// Only recorded when the plugin was started with `flight_recorder.enabled`.
+/// A call is kept when it takes at least `slow_call_threshold_us` or
+/// panics; each thread keeps the last `capacity` of them.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `out`: Receives up to `capacity` records
+/// - `capacity`: Number of records `out` can hold
+///
+/// # Returns
+/// Number of records written. Returns 0 if the handle is invalid, `out` is
+/// null, or the recorder is disabled.
 ///
-/// This should be called during plugin shutdown to ensure handlers
-/// don't persist across plugin reload cycles.
-pub(crate) fn clear_binary_handlers() {
-    binary_handlers().clear();
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `out` must be null or valid for writing `capacity` `RbSlowCall`s
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_get_slow_calls(
+    handle: FfiPluginHandle,
+    out: *mut RbSlowCall,
+    capacity: usize,
+) -> usize {
+    if out.is_null() || capacity == 0 {
+        return 0;
+    }
+    let id = handle as u64;
+    let Some(plugin_handle) = PluginHandleManager::global().lookup(id) else {
+        return 0;
+    };
+    let calls = plugin_handle.slow_calls(capacity);
+    // SAFETY: out is non-null, the caller guarantees room for capacity
+    // records, and calls holds at most capacity
+    unsafe { ptr::copy_nonoverlapping(calls.as_ptr(), out, calls.len()) };
+    calls.len()
 }
 
+// ============================================================================
+// Binary Transport Functions
+// ============================================================================
+
 /// Make a synchronous binary call to the plugin
 ///
 /// # Parameters
@@ -425,25 +757,26 @@ pub unsafe extern "C" fn plugin_call_raw(
         }),
     ) {
         Ok(result) => result,
-        Err(error_buffer) => {
-            // Convert FfiBuffer error to RbResponse error
-            let msg = if error_buffer.is_error() && !error_buffer.data.is_null() {
-                // SAFETY: error buffer contains a valid string
-                let slice =
-                    unsafe { std::slice::from_raw_parts(error_buffer.data, error_buffer.len) };
-                String::from_utf8_lossy(slice).into_owned()
-            } else {
-                "Internal error (panic)".to_string()
-            };
-            // Free the original error buffer
-            let mut buf = error_buffer;
-            // SAFETY: buf is a valid FfiBuffer from catch_panic
-            unsafe { buf.free() };
-            RbResponse::error(11, &msg)
-        }
+        Err(error_buffer) => panic_response(error_buffer),
     }
 }
 
+/// Convert the error buffer produced by `catch_panic` into an RbResponse
+fn panic_response(error_buffer: FfiBuffer) -> RbResponse {
+    let msg = if error_buffer.is_error() && !error_buffer.data.is_null() {
+        // SAFETY: error buffer contains a valid string
+        let slice = unsafe { std::slice::from_raw_parts(error_buffer.data, error_buffer.len) };
+        String::from_utf8_lossy(slice).into_owned()
+    } else {
+        "Internal error (panic)".to_string()
+    };
+    // Free the original error buffer
+    let mut buf = error_buffer;
+    // SAFETY: buf is a valid FfiBuffer from catch_panic
+    unsafe { buf.free() };
+    RbResponse::error(11, &msg)
+}
+
 /// Internal implementation of plugin_call_raw (wrapped by panic handler)
 unsafe fn plugin_call_raw_impl(
     handle: FfiPluginHandle,
@@ -453,14 +786,15 @@ unsafe fn plugin_call_raw_impl(
 ) -> RbResponse {
     // Validate handle
     let id = handle as u64;
-    let plugin_handle = match PluginHandleManager::global().get(id) {
+    let plugin_handle = match PluginHandleManager::global().lookup(id) {
         Some(h) => h,
-        None => return RbResponse::error(1, "Invalid handle"),
+        None => return RbResponse::error_static(1, c"Invalid handle"),
     };
+    let timer = plugin_handle.call_timer();
 
     // Check plugin state
     if !plugin_handle.state().can_handle_requests() {
-        return RbResponse::error(1, "Plugin not in Active state");
+        return RbResponse::error_static(1, c"Plugin not in Active state");
     }
 
     // Get request data
@@ -471,147 +805,1076 @@ unsafe fn plugin_call_raw_impl(
         unsafe { std::slice::from_raw_parts(request as *const u8, request_size) }
     };
 
-    // Look up handler
-    let handler = binary_handlers().get(&message_id).map(|r| *r);
+    // Look up handlers
+    let handlers = plugin_handle.binary_handlers(message_id);
 
-    match handler {
-        Some(h) => {
-            // Call the handler
-            match h(&plugin_handle, request_data) {
-                Ok(response_bytes) => {
-                    // Return raw bytes as response
-                    // The caller is responsible for interpreting the bytes as the correct struct
-                    let mut response = RbResponse::empty();
-                    let len = response_bytes.len();
-                    let capacity = response_bytes.capacity();
-                    let data = response_bytes.leak().as_mut_ptr();
-
-                    response.error_code = 0;
-                    response.len = len as u32;
-                    response.capacity = capacity as u32;
-                    response.data = data as *mut c_void;
-
-                    response
-                }
-                Err(e) => RbResponse::error(e.error_code(), &e.to_string()),
-            }
-        }
-        None => RbResponse::error(6, &format!("Unknown message ID: {}", message_id)),
-    }
+    // SAFETY: the caller guarantees the request's pointers are valid
+    unsafe { dispatch_binary(&plugin_handle, message_id, handlers, request_data, timer) }
 }
 
-/// Free an RbResponse returned by plugin_call_raw
+/// Check a request against its layout, invoke the binary handler and wrap
+/// the result in an RbResponse
 ///
 /// # Safety
-/// - `response` must be a valid pointer to an RbResponse from plugin_call_raw
-/// - Must only be called once per response
-#[unsafe(no_mangle)]
-pub unsafe extern "C" fn rb_response_free(response: *mut RbResponse) {
-    unsafe {
-        if !response.is_null() {
-            (*response).free();
-        }
-    }
-}
-
-// ============================================================================
-// Async API (future implementation)
-// ============================================================================
+/// Pointers in the request's `RbString` and `RbBytes` fields must be valid.
+unsafe fn dispatch_binary(
+    plugin_handle: &PluginHandle,
+    message_id: u32,
+    handlers: BinaryHandlers,
+    request_data: &[u8],
+    mut timer: CallTimer<'_>,
+) -> RbResponse {
+    let _log = plugin_handle.logger().enter();
+    timer.key(|| MetricKey::Binary(message_id));
+    timer.lap(Phase::Dispatch);
+    let Some(h) = handlers.raw else {
+        timer.finish(false);
+        return RbResponse::error_fmt(6, format_args!("Unknown message ID: {}", message_id));
+    };
 
-// =============================================================================
-// Async API (Reserved for Future Implementation)
-// =============================================================================
-//
-// These functions are reserved for a future async API that will allow
-// non-blocking plugin calls with completion callbacks. They are exported
-// to maintain ABI stability but currently return stub values.
-//
-// Planned features:
-// - Non-blocking request submission with callback-based completion
-// - Request cancellation support
-// - Integration with host language async runtimes (tokio, async-std, etc.)
+    // Call the handler once the request matches its registered layout
+    // SAFETY: guaranteed by the caller
+    let result =
+        unsafe { handlers.check(request_data) }.and_then(|()| h(plugin_handle, request_data));
+    timer.lap(Phase::Handler);
+    let ok = result.is_ok();
+    let response = match result {
+        // Return raw bytes as response
+        // The caller is responsible for interpreting the bytes as the correct struct
+        Ok(response_bytes) => RbResponse::from_vec(response_bytes),
+        Err(e) => RbResponse::error_fmt(e.error_code(), format_args!("{e}")),
+    };
+    timer.lap(Phase::Serialize);
+    timer.finish(ok);
+    response
+}
 
-/// Completion callback for async requests.
+/// Batch flag: dispatch the messages in parallel on the plugin's runtime
 ///
-/// When implemented, this callback will be invoked when an async request completes.
-/// The callback receives the original context pointer, request ID, response data,
-/// and an error code (0 for success).
-pub type CompletionCallbackFn = extern "C" fn(
-    context: *mut c_void,
-    request_id: u64,
-    data: *const u8,
-    len: usize,
-    error_code: u32,
-);
+/// Without this flag the batch runs sequentially on the calling thread.
+pub const RB_BATCH_PARALLEL: u32 = 1;
 
-/// Initiate an asynchronous plugin call.
-///
-/// # Status
-///
-/// **Not yet implemented.** This function is reserved for future async API support.
-/// Currently returns 0 to indicate the operation is not available.
+/// Make several binary calls to the plugin in one FFI crossing
 ///
-/// # Planned Behavior
+/// The handle and plugin state are validated once for the whole batch, and
+/// each message is dispatched to its registered handler. Each message gets
+/// its own panic guard. A panicking handler produces an error response for
+/// that message and marks the plugin as failed, as `plugin_call_raw` does.
 ///
-/// When implemented, this function will:
-/// 1. Accept a request and completion callback
-/// 2. Submit the request for async processing
-/// 3. Return a non-zero request ID for tracking/cancellation
-/// 4. Invoke the callback with the response when complete
-///
-/// # Safety
-///
-/// When implemented, the following invariants must hold:
-/// - `handle` must be a valid handle from `plugin_init`, or null
-/// - `type_tag` must be a valid null-terminated C string, or null
-/// - `request` must be valid for `request_len` bytes, or null if `request_len` is 0
-/// - `callback` must remain valid until invoked or the request is cancelled
-/// - `context` is passed through to the callback unchanged
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `requests`: Array of `count` request descriptors
+/// - `count`: Number of messages in the batch
+/// - `responses`: Caller-allocated array of `count` RbResponse slots
+/// - `flags`: Bitwise OR of batch flags (`RB_BATCH_PARALLEL`)
 ///
 /// # Returns
+/// 0 if the batch was dispatched. Every slot in `responses` is then filled
+/// and must be freed with `rb_response_free`, whether it is a success or an
+/// error. A non-zero error code means nothing was dispatched and `responses`
+/// was left untouched: 1 for an invalid handle or inactive plugin, 4 for null
+/// arrays.
 ///
-/// Request ID that can be used with `plugin_cancel_async`, or 0 if not implemented.
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `requests` must be valid for `count` descriptors, and each descriptor's
+///   `request` must be valid for `request_size` bytes
+/// - `responses` must be valid for writes of `count` RbResponse values
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_call_raw_batch(
+    handle: FfiPluginHandle,
+    requests: *const RbBatchRequest,
+    count: usize,
+    responses: *mut RbResponse,
+    flags: u32,
+) -> u32 {
+    // Wrap in panic handler
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe {
+            plugin_call_raw_batch_impl(handle, requests, count, responses, flags)
+        }),
+    ) {
+        Ok(code) => code,
+        Err(mut error_buffer) => {
+            // SAFETY: error_buffer is a valid FfiBuffer from catch_panic
+            unsafe { error_buffer.free() };
+            11
+        }
+    }
+}
+
+/// Internal implementation of plugin_call_raw_batch (wrapped by panic handler)
+unsafe fn plugin_call_raw_batch_impl(
+    handle: FfiPluginHandle,
+    requests: *const RbBatchRequest,
+    count: usize,
+    responses: *mut RbResponse,
+    flags: u32,
+) -> u32 {
+    if count == 0 {
+        return 0;
+    }
+    if requests.is_null() || responses.is_null() {
+        return 4;
+    }
+
+    // Validate handle and state once for the whole batch
+    let id = handle as u64;
+    let plugin_handle = match PluginHandleManager::global().lookup(id) {
+        Some(h) => h,
+        None => return 1,
+    };
+    if !plugin_handle.state().can_handle_requests() {
+        return 1;
+    }
+
+    let batch = BatchRequests {
+        ptr: requests,
+        len: count,
+    };
+    let workers = plugin_handle.parallelism().min(count);
+
+    // Callers already on a runtime thread (e.g. a completion callback) cannot
+    // block on the pool, so their batches run sequentially
+    let parallel = flags & RB_BATCH_PARALLEL != 0
+        && !plugin_handle.bridge().is_shutting_down()
+        && plugin_handle.bridge().can_block();
+
+    if parallel && workers > 1 {
+        let chunk_size = count.div_ceil(workers);
+        let tasks: Vec<_> = (0..count)
+            .step_by(chunk_size)
+            .map(|start| {
+                let handle = plugin_handle.to_arc();
+                let range = start..(start + chunk_size).min(count);
+                move || {
+                    // SAFETY: the calling thread blocks until every chunk has
+                    // finished, so the request descriptors outlive this task
+                    let requests = unsafe { batch.as_slice() };
+                    dispatch_batch(&handle, &requests[range])
+                }
+            })
+            .collect();
+
+        match plugin_handle.bridge().call_blocking_all(tasks) {
+            Ok(chunks) => {
+                for (i, response) in chunks.into_iter().flatten().enumerate() {
+                    // SAFETY: caller guarantees responses is valid for count writes,
+                    // and the chunks cover indices 0..count in order
+                    unsafe { responses.add(i).write(response) };
+                }
+            }
+            Err(e) => {
+                // Each message runs under its own panic guard, so this only
+                // happens if the runtime itself fails to run a chunk
+                let message = e.to_string();
+                for i in 0..count {
+                    // SAFETY: caller guarantees responses is valid for count writes
+                    unsafe {
+                        responses
+                            .add(i)
+                            .write(RbResponse::error(e.error_code(), &message))
+                    };
+                }
+            }
+        }
+        return 0;
+    }
+
+    // SAFETY: caller guarantees requests is valid for count descriptors
+    let requests = unsafe { batch.as_slice() };
+    for (i, response) in dispatch_batch(&plugin_handle, requests)
+        .into_iter()
+        .enumerate()
+    {
+        // SAFETY: caller guarantees responses is valid for count writes
+        unsafe { responses.add(i).write(response) };
+    }
+    0
+}
+
+/// Request descriptor array shared with the runtime's blocking pool
+#[derive(Clone, Copy)]
+struct BatchRequests {
+    ptr: *const RbBatchRequest,
+    len: usize,
+}
+
+// SAFETY: the descriptors are only read, and plugin_call_raw_batch keeps them
+// alive until every task that holds this pointer has completed
+unsafe impl Send for BatchRequests {}
+
+impl BatchRequests {
+    /// # Safety
+    /// `ptr` must still be valid for `len` descriptors.
+    unsafe fn as_slice(&self) -> &[RbBatchRequest] {
+        unsafe { std::slice::from_raw_parts(self.ptr, self.len) }
+    }
+}
+
+/// Dispatch a run of batch requests, each under its own panic guard
+///
+/// A message that panics marks the plugin failed, so the state is checked
+/// again before each message and the rest of the batch is rejected.
+fn dispatch_batch(plugin_handle: &PluginHandle, requests: &[RbBatchRequest]) -> Vec<RbResponse> {
+    let handle_id = plugin_handle.id().unwrap_or(0);
+
+    requests
+        .iter()
+        .map(|request| {
+            if !plugin_handle.state().can_handle_requests() {
+                return RbResponse::error_static(1, c"Plugin not in Active state");
+            }
+            let timer = plugin_handle.call_timer();
+            let handlers = plugin_handle.binary_handlers(request.message_id);
+
+            let request_data = if request.request.is_null() || request.request_size == 0 {
+                &[]
+            } else {
+                // SAFETY: caller guarantees each request is valid for request_size bytes
+                unsafe {
+                    std::slice::from_raw_parts(request.request as *const u8, request.request_size)
+                }
+            };
+
+            match catch_panic(
+                handle_id,
+                // SAFETY: the caller guarantees each request's pointers are valid
+                AssertUnwindSafe(|| unsafe {
+                    dispatch_binary(
+                        plugin_handle,
+                        request.message_id,
+                        handlers,
+                        request_data,
+                        timer,
+                    )
+                }),
+            ) {
+                Ok(response) => response,
+                Err(error_buffer) => panic_response(error_buffer),
+            }
+        })
+        .collect()
+}
+
+/// Make a synchronous binary call that writes the response into a caller buffer
+///
+/// Avoids the response allocation and the `rb_response_free` crossing of
+/// `plugin_call_raw`. A handler registered with `register_binary_into_handler`
+/// writes straight into `out`; otherwise the `register_binary_handler` handler
+/// runs and its response is copied.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `message_id`: Numeric message identifier
+/// - `request`: Pointer to request struct
+/// - `request_size`: Size of request struct
+/// - `out`: Caller-allocated output buffer
+/// - `out_capacity`: Size of `out` in bytes
+/// - `out_len`: Receives the number of bytes written to `out`
+///
+/// # Returns
+/// - 0: the response was written to `out` and `*out_len` is its size
+/// - 14 (insufficient capacity): nothing was written, and `*out_len` is the
+///   required size, or 0 if the handler could not tell
+/// - any other code: the error message (UTF-8, truncated to `out_capacity`)
+///   was written to `out` and `*out_len` is its length
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `request` must be valid for `request_size` bytes
+/// - `out` must be valid for writes of `out_capacity` bytes
+/// - `out_len` must be a valid pointer
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_call_raw_into(
+    handle: FfiPluginHandle,
+    message_id: u32,
+    request: *const c_void,
+    request_size: usize,
+    out: *mut c_void,
+    out_capacity: usize,
+    out_len: *mut usize,
+) -> u32 {
+    if out_len.is_null() || (out.is_null() && out_capacity > 0) {
+        return 4;
+    }
+    let out = if out.is_null() {
+        &mut [][..]
+    } else {
+        // SAFETY: caller guarantees out is valid for out_capacity bytes
+        unsafe { std::slice::from_raw_parts_mut(out as *mut u8, out_capacity) }
+    };
+
+    // Wrap in panic handler
+    let handle_id = handle as u64;
+    let result = match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe {
+            plugin_call_raw_into_impl(handle, message_id, request, request_size, &mut *out)
+        }),
+    ) {
+        Ok(result) => result,
+        Err(mut error_buffer) => {
+            // SAFETY: error buffer contains a valid string
+            let message = unsafe { error_buffer.as_slice() }.to_vec();
+            // SAFETY: error_buffer is a valid FfiBuffer from catch_panic
+            unsafe { error_buffer.free() };
+            Err(IntoError::Failed(
+                11,
+                Cow::Owned(String::from_utf8_lossy(&message).into_owned()),
+            ))
+        }
+    };
+
+    let (code, len) = match result {
+        Ok(len) => (0, len),
+        Err(IntoError::Capacity(required)) => (14, required),
+        Err(IntoError::UnknownMessage(message_id)) => (
+            6,
+            write_truncated(out, format_args!("Unknown message ID: {message_id}")),
+        ),
+        Err(IntoError::Failed(code, message)) => {
+            let len = message.len().min(out.len());
+            out[..len].copy_from_slice(&message.as_bytes()[..len]);
+            (code, len)
+        }
+    };
+    // SAFETY: out_len was checked for null above
+    unsafe { out_len.write(len) };
+    code
+}
+
+/// Failure of a plugin_call_raw_into call
+enum IntoError {
+    /// The output buffer is too small; carries the required size (0 if unknown)
+    Capacity(usize),
+    /// No binary handler is registered for this message ID
+    UnknownMessage(u32),
+    /// Any other failure, with its error code and message
+    ///
+    /// Fixed messages are borrowed so rejecting a call does not allocate.
+    Failed(u32, Cow<'static, str>),
+}
+
+/// Format `args` into `out`, truncating at its end, and return the length written
+fn write_truncated(out: &mut [u8], args: std::fmt::Arguments<'_>) -> usize {
+    let capacity = out.len();
+    let mut cursor = out;
+    // Running out of room is the expected way to truncate
+    let _ = std::io::Write::write_fmt(&mut cursor, args);
+    capacity - cursor.len()
+}
+
+impl From<rustbridge_core::PluginError> for IntoError {
+    fn from(e: rustbridge_core::PluginError) -> Self {
+        match e {
+            rustbridge_core::PluginError::InsufficientCapacity { required } => {
+                IntoError::Capacity(required)
+            }
+            e => IntoError::Failed(e.error_code(), Cow::Owned(e.to_string())),
+        }
+    }
+}
+
+/// Internal implementation of plugin_call_raw_into (wrapped by panic handler)
+unsafe fn plugin_call_raw_into_impl(
+    handle: FfiPluginHandle,
+    message_id: u32,
+    request: *const c_void,
+    request_size: usize,
+    out: &mut [u8],
+) -> Result<usize, IntoError> {
+    // Validate handle
+    let id = handle as u64;
+    let plugin_handle = PluginHandleManager::global()
+        .lookup(id)
+        .ok_or(IntoError::Failed(1, Cow::Borrowed("Invalid handle")))?;
+
+    // Check plugin state
+    if !plugin_handle.state().can_handle_requests() {
+        return Err(IntoError::Failed(
+            1,
+            Cow::Borrowed("Plugin not in Active state"),
+        ));
+    }
+
+    // Get request data
+    let request_data = if request.is_null() || request_size == 0 {
+        &[]
+    } else {
+        // SAFETY: caller guarantees request is valid for request_size bytes
+        unsafe { std::slice::from_raw_parts(request as *const u8, request_size) }
+    };
+
+    let _log = plugin_handle.logger().enter();
+    let capacity = out.len();
+    let handlers = plugin_handle.binary_handlers(message_id);
+    // SAFETY: the caller guarantees the request's pointers are valid
+    unsafe { handlers.check(request_data) }?;
+    if let Some(handler) = handlers.into {
+        let len = handler(&plugin_handle, request_data, out)?;
+        if len > capacity {
+            return Err(IntoError::Failed(
+                11,
+                Cow::Owned(format!(
+                    "Handler reported {} bytes for a {} byte buffer",
+                    len, capacity
+                )),
+            ));
+        }
+        Ok(len)
+    } else if let Some(handler) = handlers.raw {
+        // No direct writer registered; copy the allocated response
+        let response = handler(&plugin_handle, request_data)?;
+        let dest = out
+            .get_mut(..response.len())
+            .ok_or(IntoError::Capacity(response.len()))?;
+        dest.copy_from_slice(&response);
+        Ok(response.len())
+    } else {
+        Err(IntoError::UnknownMessage(message_id))
+    }
+}
+
+/// Free an RbResponse returned by plugin_call_raw or plugin_call_raw_batch
+///
+/// # Safety
+/// - `response` must be a valid pointer to an RbResponse from plugin_call_raw
+/// - Must only be called once per response
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rb_response_free(response: *mut RbResponse) {
+    unsafe {
+        if !response.is_null() {
+            (*response).free();
+        }
+    }
+}
+
+// ============================================================================
+// Async API
+// ============================================================================
+
+/// Completion callback for async requests.
+///
+/// Invoked once from a runtime worker thread when an async request completes.
+/// The callback receives the original context pointer, request ID, the
+/// response envelope (same format as `plugin_call`), and an error code
+/// (0 for success). The data is only valid for the duration of the callback.
+pub type CompletionCallbackFn = extern "C" fn(
+    context: *mut c_void,
+    request_id: u64,
+    data: *const u8,
+    len: usize,
+    error_code: u32,
+);
+
+/// Initiate an asynchronous plugin call.
+///
+/// The request is copied and spawned onto the plugin's async runtime, so the
+/// calling thread returns immediately. When the handler finishes, `callback`
+/// is invoked exactly once with the response envelope, unless the request is
+/// cancelled with `plugin_cancel_async` first. Requests still pending at
+/// shutdown are completed with a Cancelled error (code 9).
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_tag`: Message type identifier (null-terminated C string)
+/// - `request`: Request payload bytes
+/// - `request_len`: Length of request payload
+/// - `callback`: Completion callback
+/// - `context`: Opaque pointer passed through to the callback unchanged
+///
+/// # Returns
+/// Non-zero request ID that can be used with `plugin_cancel_async`, or 0 if
+/// the request could not be submitted (invalid handle, invalid type tag,
+/// plugin not active, or concurrency limit exceeded). The callback is not
+/// invoked when 0 is returned.
+///
+/// # Safety
+/// - `handle` must be a valid handle from `plugin_init`, or null
+/// - `type_tag` must be a valid null-terminated C string, or null
+/// - `request` must be valid for `request_len` bytes, or null if `request_len` is 0
+/// - `callback` and `context` must remain valid until the callback is invoked
+///   or the request is cancelled
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn plugin_call_async(
-    _handle: FfiPluginHandle,
-    _type_tag: *const std::ffi::c_char,
-    _request: *const u8,
-    _request_len: usize,
-    _callback: CompletionCallbackFn,
-    _context: *mut c_void,
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+    callback: CompletionCallbackFn,
+    context: *mut c_void,
 ) -> u64 {
-    // Reserved for future implementation
-    0
+    // Wrap in panic handler
+    let handle_id = handle as u64;
+    catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe {
+            plugin_call_async_impl(handle, type_tag, request, request_len, callback, context)
+        }),
+    )
+    .unwrap_or(0)
+}
+
+/// Internal implementation of plugin_call_async (wrapped by panic handler)
+unsafe fn plugin_call_async_impl(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+    callback: CompletionCallbackFn,
+    context: *mut c_void,
+) -> u64 {
+    // Validate handle
+    let id = handle as u64;
+    let plugin_handle = match PluginHandleManager::global().get(id) {
+        Some(h) => h,
+        None => return 0,
+    };
+
+    // Parse type tag
+    if type_tag.is_null() {
+        return 0;
+    }
+    // SAFETY: caller guarantees type_tag is a valid null-terminated C string
+    let type_tag_str = match unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() {
+        Ok(s) => s,
+        Err(_) => return 0,
+    };
+
+    // Get request data
+    let request_data = if request.is_null() || request_len == 0 {
+        &[]
+    } else {
+        // SAFETY: caller guarantees request is valid for request_len bytes
+        unsafe { std::slice::from_raw_parts(request, request_len) }
+    };
+
+    match plugin_handle.call_async(type_tag_str, request_data, callback, context) {
+        Ok(request_id) => request_id,
+        Err(e) => {
+            tracing::debug!("Async request rejected: {}", e);
+            0
+        }
+    }
 }
 
 /// Cancel a pending async request.
 ///
-/// # Status
+/// Aborts the spawned handler task. The completion callback will NOT be
+/// invoked for a successfully cancelled request, so the host may release
+/// the request's context as soon as this returns `true`.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `request_id`: Request ID returned by `plugin_call_async`
+///
+/// # Returns
+/// `true` if the request was pending and has been cancelled, `false` if it
+/// already completed, was not found, or the handle is invalid.
+///
+/// # Safety
+/// - `handle` must be a valid handle from `plugin_init`, or null
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_cancel_async(handle: FfiPluginHandle, request_id: u64) -> bool {
+    let handle_id = handle as u64;
+    catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| match PluginHandleManager::global().lookup(handle_id) {
+            Some(h) => h.cancel_async(request_id),
+            None => false,
+        }),
+    )
+    .unwrap_or_default()
+}
+
+// ============================================================================
+// Streaming Responses
+// ============================================================================
+
+/// Open a streamed response for a request
+///
+/// Calls the plugin's `handle_request_stream` for `type_tag` on the calling
+/// thread. On success the stream's chunks are then produced on the plugin's
+/// runtime, a few at a time, as the host pulls them with
+/// [`plugin_stream_next`].
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_tag`: Message type identifier (null-terminated C string)
+/// - `request`: Request payload bytes
+/// - `request_len`: Length of request payload
+/// - `stream_id`: Receives the stream ID (never 0) on success
+///
+/// # Returns
+/// An empty FfiBuffer on success. On failure `error_code` is set and the
+/// buffer holds an error envelope, as for `plugin_call`. Free it with
+/// plugin_free_buffer either way.
 ///
-/// **Not yet implemented.** This function is reserved for future async API support.
-/// Currently returns `false` to indicate the operation is not available.
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `type_tag` must be a valid null-terminated C string
+/// - `request` must be valid for `request_len` bytes
+/// - `stream_id` must be valid for writes
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_stream_open(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+    stream_id: *mut u64,
+) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe {
+            plugin_stream_open_impl(handle, type_tag, request, request_len, stream_id)
+        }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Internal implementation of plugin_stream_open (wrapped by panic handler)
+unsafe fn plugin_stream_open_impl(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    request: *const u8,
+    request_len: usize,
+    stream_id: *mut u64,
+) -> FfiBuffer {
+    let id = handle as u64;
+    let plugin_handle = match PluginHandleManager::global().lookup(id) {
+        Some(h) => h,
+        None => return FfiBuffer::error_static(1, b"Invalid handle"),
+    };
+
+    if stream_id.is_null() {
+        return FfiBuffer::error_static(4, b"Stream ID pointer is null");
+    }
+    if type_tag.is_null() {
+        return FfiBuffer::error_static(4, b"Type tag is null");
+    }
+    // SAFETY: caller guarantees type_tag is a valid null-terminated C string
+    let Ok(type_tag_str) = unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() else {
+        return FfiBuffer::error_static(4, b"Invalid type tag encoding");
+    };
+
+    let request_data = if request.is_null() || request_len == 0 {
+        &[]
+    } else {
+        // SAFETY: caller guarantees request is valid for request_len bytes
+        unsafe { std::slice::from_raw_parts(request, request_len) }
+    };
+
+    match plugin_handle.open_stream(type_tag_str, request_data) {
+        Ok(opened) => {
+            // SAFETY: caller guarantees stream_id is valid for writes
+            unsafe { stream_id.write(opened) };
+            FfiBuffer::empty()
+        }
+        Err(e) => error_envelope_buffer(&e),
+    }
+}
+
+/// Pull the next chunk of a streamed response
+///
+/// Blocks until the plugin has produced the chunk. Each call returns one
+/// frame:
+///
+/// | `error_code` | `len` | Meaning |
+/// |--------------|-------|---------|
+/// | 0 | > 0 | Next chunk of the response payload |
+/// | 0 | 0 | End of stream |
+/// | non-zero | > 0 | The stream failed; the buffer holds an error envelope |
 ///
-/// # Planned Behavior
+/// Chunks concatenate to the payload `plugin_call` would have wrapped in its
+/// success envelope. After the end frame or an error the stream ID is no
+/// longer valid. Streams still open at `plugin_shutdown` fail with
+/// `Cancelled` (code 9).
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `stream_id`: Stream ID from plugin_stream_open
 ///
-/// When implemented, this function will:
-/// 1. Attempt to cancel the pending request identified by `request_id`
-/// 2. Return `true` if cancellation succeeded, `false` if the request
-///    already completed or was not found
-/// 3. The completion callback will NOT be invoked for cancelled requests
+/// # Returns
+/// FfiBuffer holding the frame (must be freed with plugin_free_buffer)
 ///
 /// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - Must not be called from a callback running on the plugin's runtime
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_stream_next(handle: FfiPluginHandle, stream_id: u64) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            let Some(plugin_handle) = PluginHandleManager::global().get(handle_id) else {
+                return FfiBuffer::error_static(1, b"Invalid handle");
+            };
+            match plugin_handle.next_stream_chunk(stream_id) {
+                Ok(Some(chunk)) => FfiBuffer::from_vec(chunk),
+                Ok(None) => FfiBuffer::empty(),
+                Err(e) => error_envelope_buffer(&e),
+            }
+        }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Stop a streamed response before it is complete
 ///
-/// When implemented, the following invariants must hold:
-/// - `handle` must be a valid handle from `plugin_init`, or null
-/// - `request_id` must be a valid request ID from `plugin_call_async`
+/// The plugin stops producing chunks and releases the stream. A
+/// `plugin_stream_next` call blocked on the stream fails with `Cancelled`.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `stream_id`: Stream ID from plugin_stream_open
+///
+/// # Returns
+/// `true` if the stream was open, `false` if it had already ended, was not
+/// found, or the handle is invalid.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_stream_close(handle: FfiPluginHandle, stream_id: u64) -> bool {
+    let handle_id = handle as u64;
+    catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| match PluginHandleManager::global().lookup(handle_id) {
+            Some(h) => h.close_stream(stream_id),
+            None => false,
+        }),
+    )
+    .unwrap_or_default()
+}
+
+// ============================================================================
+// Streamed Requests
+// ============================================================================
+
+/// Open a request whose payload will be written in chunks
+///
+/// Starts the plugin's `handle_request_reader` for `type_tag` on the
+/// plugin's runtime. The host then passes the payload with
+/// [`plugin_input_write`] and collects the response with
+/// [`plugin_input_finish`], so a large payload never has to be in memory at
+/// once on either side.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `type_tag`: Message type identifier (null-terminated C string)
+/// - `input_id`: Receives the input ID (never 0) on success
 ///
 /// # Returns
+/// An empty FfiBuffer on success. On failure `error_code` is set and the
+/// buffer holds an error envelope, as for `plugin_call`. Free it with
+/// plugin_free_buffer either way.
 ///
-/// `true` if cancellation was successful, `false` otherwise.
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `type_tag` must be a valid null-terminated C string
+/// - `input_id` must be valid for writes
 #[unsafe(no_mangle)]
-pub unsafe extern "C" fn plugin_cancel_async(_handle: FfiPluginHandle, _request_id: u64) -> bool {
-    // Reserved for future implementation
-    false
+pub unsafe extern "C" fn plugin_input_open(
+    handle: FfiPluginHandle,
+    type_tag: *const std::ffi::c_char,
+    input_id: *mut u64,
+) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| unsafe { plugin_input_open_impl(handle_id, type_tag, input_id) }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Internal implementation of plugin_input_open (wrapped by panic handler)
+unsafe fn plugin_input_open_impl(
+    handle_id: u64,
+    type_tag: *const std::ffi::c_char,
+    input_id: *mut u64,
+) -> FfiBuffer {
+    let Some(plugin_handle) = PluginHandleManager::global().get(handle_id) else {
+        return FfiBuffer::error_static(1, b"Invalid handle");
+    };
+
+    if input_id.is_null() {
+        return FfiBuffer::error_static(4, b"Input ID pointer is null");
+    }
+    if type_tag.is_null() {
+        return FfiBuffer::error_static(4, b"Type tag is null");
+    }
+    // SAFETY: caller guarantees type_tag is a valid null-terminated C string
+    let Ok(type_tag_str) = unsafe { std::ffi::CStr::from_ptr(type_tag) }.to_str() else {
+        return FfiBuffer::error_static(4, b"Invalid type tag encoding");
+    };
+
+    match plugin_handle.open_input(type_tag_str) {
+        Ok(opened) => {
+            // SAFETY: caller guarantees input_id is valid for writes
+            unsafe { input_id.write(opened) };
+            FfiBuffer::empty()
+        }
+        Err(e) => error_envelope_buffer(&e),
+    }
+}
+
+/// Pass the next chunk of a streamed request to its handler
+///
+/// The chunk is copied, so `data` may be reused as soon as this returns.
+/// Blocks while the handler is `INPUT_BUFFER_CHUNKS` chunks behind, which
+/// keeps memory use constant for a payload of any size. Chunks written
+/// after the handler has returned are discarded; its result is reported
+/// by [`plugin_input_finish`].
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `input_id`: Input ID from plugin_input_open
+/// - `data`: Chunk bytes
+/// - `len`: Length of the chunk
+///
+/// # Returns
+/// 0 on success, 1 if the handle or input ID is invalid, 4 if `data` is
+/// null with a non-zero `len`.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - `data` must be valid for `len` bytes
+/// - Must not be called from a callback running on the plugin's runtime
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_input_write(
+    handle: FfiPluginHandle,
+    input_id: u64,
+    data: *const u8,
+    len: usize,
+) -> u32 {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            let Some(plugin_handle) = PluginHandleManager::global().get(handle_id) else {
+                return 1;
+            };
+            let chunk = if len == 0 {
+                &[]
+            } else if data.is_null() {
+                return 4;
+            } else {
+                // SAFETY: caller guarantees data is valid for len bytes
+                unsafe { std::slice::from_raw_parts(data, len) }
+            };
+            match plugin_handle.write_input(input_id, chunk) {
+                Ok(()) => 0,
+                Err(e) => e.error_code(),
+            }
+        }),
+    ) {
+        Ok(code) => code,
+        Err(mut error_buffer) => {
+            // SAFETY: error_buffer is a valid FfiBuffer from catch_panic
+            unsafe { error_buffer.free() };
+            11
+        }
+    }
+}
+
+/// End a streamed request and wait for the handler's response
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `input_id`: Input ID from plugin_input_open
+///
+/// # Returns
+/// FfiBuffer holding the response envelope, exactly as returned by
+/// `plugin_call` (must be freed with plugin_free_buffer). The input ID is
+/// no longer valid afterwards.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+/// - Must not be called from a callback running on the plugin's runtime
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_input_finish(handle: FfiPluginHandle, input_id: u64) -> FfiBuffer {
+    let handle_id = handle as u64;
+    match catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            let Some(plugin_handle) = PluginHandleManager::global().get(handle_id) else {
+                return FfiBuffer::error_static(1, b"Invalid handle");
+            };
+            match plugin_handle.finish_input(input_id) {
+                Ok(response_data) => match plugin_handle.encode_success(&response_data) {
+                    Ok(bytes) => FfiBuffer::from_vec(bytes),
+                    Err(e) => FfiBuffer::error(5, &format!("Serialization error: {}", e)),
+                },
+                Err(e) => error_envelope_buffer(&e),
+            }
+        }),
+    ) {
+        Ok(result) => result,
+        Err(error_buffer) => error_buffer,
+    }
+}
+
+/// Abandon a streamed request
+///
+/// The handler is stopped, its admission slot released, and the chunks
+/// already written are dropped. A `plugin_input_write` blocked on the input
+/// returns.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `input_id`: Input ID from plugin_input_open
+///
+/// # Returns
+/// `true` if the input was open, `false` if it was already finished,
+/// aborted, or not found, or the handle is invalid.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_input_abort(handle: FfiPluginHandle, input_id: u64) -> bool {
+    let handle_id = handle as u64;
+    catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| match PluginHandleManager::global().lookup(handle_id) {
+            Some(h) => h.abort_input(input_id),
+            None => false,
+        }),
+    )
+    .unwrap_or_default()
+}
+
+/// Encode an error as a `plugin_call` error envelope buffer
+///
+/// Errors whose envelope never varies get a static buffer.
+fn error_envelope_buffer(error: &PluginError) -> FfiBuffer {
+    if let Some(buf) = static_errors::envelope(error) {
+        return buf;
+    }
+    match ResponseEnvelope::from_error(error).to_bytes() {
+        Ok(bytes) => {
+            let mut buf = FfiBuffer::from_vec(bytes);
+            buf.error_code = error.error_code();
+            buf
+        }
+        Err(se) => FfiBuffer::error_fmt(error.error_code(), format_args!("{}: {}", error, se)),
+    }
+}
+
+// ============================================================================
+// Shared-Memory Ring Transport
+// ============================================================================
+
+/// Open a shared-memory ring channel to the plugin
+///
+/// Allocates a request ring and a response ring of `capacity` data bytes each
+/// and starts a consumer on the plugin's runtime that answers request frames
+/// with its binary handlers. The host then writes requests and reads
+/// responses directly through the returned descriptor; see `RbRing` for the
+/// protocol.
+///
+/// # Parameters
+/// - `handle`: Plugin handle from plugin_init
+/// - `capacity`: Data bytes per ring, rounded up to a power of two
+///   (0 = `RB_RING_DEFAULT_CAPACITY`)
+///
+/// # Returns
+/// The channel descriptor, or null if the handle is invalid, the plugin is
+/// not active, or `capacity` exceeds `RB_RING_MAX_CAPACITY`. The channel must
+/// be released with `plugin_ring_close`, also after `plugin_shutdown`.
+///
+/// # Safety
+/// - `handle` must be a valid handle from plugin_init
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_ring_open(
+    handle: FfiPluginHandle,
+    capacity: usize,
+) -> *mut RbRingChannel {
+    let handle_id = handle as u64;
+    catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            let Some(plugin_handle) = PluginHandleManager::global().get(handle_id) else {
+                return ptr::null_mut();
+            };
+            match RingChannel::open(plugin_handle, capacity) {
+                Ok(channel) => Arc::into_raw(channel) as *mut RbRingChannel,
+                Err(e) => {
+                    tracing::warn!("plugin_ring_open failed: {}", e);
+                    ptr::null_mut()
+                }
+            }
+        }),
+    )
+    .unwrap_or(ptr::null_mut())
+}
+
+/// Wake the ring consumer after publishing requests
+///
+/// Only needed when the request ring's `waiters` field is non-zero after
+/// the host has published; otherwise the consumer is polling and will see
+/// the new frames on its own.
+///
+/// # Safety
+/// - `channel` must be null or a live descriptor from plugin_ring_open
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_ring_notify(channel: *const RbRingChannel) {
+    // SAFETY: the caller guarantees channel came from plugin_ring_open
+    if let Some(channel) = unsafe { (channel as *const RingChannel).as_ref() } {
+        channel.request().notify();
+    }
+}
+
+/// Block until the response ring has frames, the channel closes, or the timeout passes
+///
+/// # Parameters
+/// - `channel`: Descriptor from plugin_ring_open
+/// - `timeout_ms`: Longest time to wait
+///
+/// # Returns
+/// `true` if response frames are waiting. Wakeups may be spurious, so
+/// callers should poll the ring and wait again on `false`.
+///
+/// # Safety
+/// - `channel` must be null or a live descriptor from plugin_ring_open
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_ring_wait(channel: *const RbRingChannel, timeout_ms: u32) -> bool {
+    // SAFETY: the caller guarantees channel came from plugin_ring_open
+    match unsafe { (channel as *const RingChannel).as_ref() } {
+        Some(channel) => channel
+            .response()
+            .wait(std::time::Duration::from_millis(u64::from(timeout_ms))),
+        None => false,
+    }
+}
+
+/// Stop a ring channel's consumer and release the channel
+///
+/// Requests still in the ring are not answered. Both rings are marked
+/// closed before the consumer is stopped, so a host thread blocked in
+/// `plugin_ring_wait` returns.
+///
+/// # Safety
+/// - `channel` must be null or a descriptor from plugin_ring_open that has
+///   not been closed; it is invalid after this call
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn plugin_ring_close(channel: *mut RbRingChannel) {
+    if channel.is_null() {
+        return;
+    }
+    // SAFETY: the caller guarantees channel came from Arc::into_raw in
+    // plugin_ring_open and is released only once
+    let channel = unsafe { Arc::from_raw(channel as *const RingChannel) };
+    let _ = catch_panic(0, AssertUnwindSafe(|| channel.stop()));
 }
 
 #[cfg(test)]
@@ -41,6 +41,60 @@ fn plugin_call___null_type_tag___returns_error() {
     }
 }
 
+#[test]
+fn plugin_resolve_type_tag___invalid_handle___returns_zero() {
+    unsafe {
+        let type_id = plugin_resolve_type_tag(999 as FfiPluginHandle, c"test".as_ptr());
+
+        assert_eq!(type_id, 0);
+    }
+}
+
+#[test]
+fn plugin_call_id___invalid_handle___returns_error() {
+    unsafe {
+        let mut result = plugin_call_id(999 as FfiPluginHandle, 1, ptr::null(), 0);
+
+        assert_eq!(result.error_code, 1);
+
+        result.free();
+    }
+}
+
+#[test]
+fn plugin_call_as___invalid_handle___returns_error() {
+    unsafe {
+        let mut result = plugin_call_as(
+            999 as FfiPluginHandle,
+            c"test".as_ptr(),
+            c"application/msgpack".as_ptr(),
+            ptr::null(),
+            0,
+        );
+
+        assert_eq!(result.error_code, 1);
+
+        result.free();
+    }
+}
+
+#[test]
+fn plugin_call_as___null_type_tag___returns_error() {
+    unsafe {
+        let mut result = plugin_call_as(
+            1 as FfiPluginHandle,
+            ptr::null(),
+            ptr::null(),
+            ptr::null(),
+            0,
+        );
+
+        assert!(result.is_error());
+
+        result.free();
+    }
+}
+
 #[test]
 fn plugin_free_buffer___null_pointer___does_not_crash() {
     unsafe {
@@ -57,6 +111,46 @@ fn plugin_get_state___invalid_handle___returns_255() {
     }
 }
 
+#[test]
+fn plugin_set_log_batch_callback___invalid_handle___returns_false() {
+    unsafe {
+        let result = plugin_set_log_batch_callback(999 as FfiPluginHandle, None);
+
+        assert!(!result);
+    }
+}
+
+#[test]
+fn plugin_get_dropped_log_count___invalid_handle___returns_zero() {
+    unsafe {
+        let count = plugin_get_dropped_log_count(999 as FfiPluginHandle);
+
+        assert_eq!(count, 0);
+    }
+}
+
+#[test]
+fn plugin_get_metrics___invalid_handle___returns_error() {
+    unsafe {
+        let mut buffer = plugin_get_metrics(999 as FfiPluginHandle);
+
+        assert!(buffer.is_error());
+        assert_eq!(buffer.error_code, 1);
+        buffer.free();
+    }
+}
+
+#[test]
+fn plugin_get_slow_calls___invalid_handle___returns_zero() {
+    unsafe {
+        let mut calls = [RbSlowCall::default(); 2];
+
+        let count = plugin_get_slow_calls(999 as FfiPluginHandle, calls.as_mut_ptr(), calls.len());
+
+        assert_eq!(count, 0);
+    }
+}
+
 #[test]
 fn plugin_shutdown___invalid_handle___returns_false() {
     unsafe {
@@ -65,3 +159,155 @@ fn plugin_shutdown___invalid_handle___returns_false() {
         assert!(!result);
     }
 }
+
+extern "C" fn noop_completion(
+    _context: *mut c_void,
+    _request_id: u64,
+    _data: *const u8,
+    _len: usize,
+    _error_code: u32,
+) {
+}
+
+#[test]
+fn plugin_call_async___invalid_handle___returns_zero() {
+    unsafe {
+        let request_id = plugin_call_async(
+            999 as FfiPluginHandle,
+            c"test".as_ptr(),
+            ptr::null(),
+            0,
+            noop_completion,
+            ptr::null_mut(),
+        );
+
+        assert_eq!(request_id, 0);
+    }
+}
+
+#[test]
+fn plugin_call_async___null_type_tag___returns_zero() {
+    unsafe {
+        let request_id = plugin_call_async(
+            1 as FfiPluginHandle,
+            ptr::null(),
+            ptr::null(),
+            0,
+            noop_completion,
+            ptr::null_mut(),
+        );
+
+        assert_eq!(request_id, 0);
+    }
+}
+
+#[test]
+fn plugin_cancel_async___invalid_handle___returns_false() {
+    unsafe {
+        let cancelled = plugin_cancel_async(999 as FfiPluginHandle, 1);
+
+        assert!(!cancelled);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___zero_count___returns_success() {
+    unsafe {
+        let code =
+            plugin_call_raw_batch(999 as FfiPluginHandle, ptr::null(), 0, ptr::null_mut(), 0);
+
+        assert_eq!(code, 0);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___null_arrays___returns_config_error() {
+    unsafe {
+        let code =
+            plugin_call_raw_batch(999 as FfiPluginHandle, ptr::null(), 2, ptr::null_mut(), 0);
+
+        assert_eq!(code, 4);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___invalid_handle___leaves_responses_untouched() {
+    let data = [0u8; 4];
+    let requests = [RbBatchRequest::new(1, &data)];
+    let mut responses = [RbResponse::empty()];
+    responses[0].error_code = 42;
+
+    let code = unsafe {
+        plugin_call_raw_batch(
+            999 as FfiPluginHandle,
+            requests.as_ptr(),
+            1,
+            responses.as_mut_ptr(),
+            RB_BATCH_PARALLEL,
+        )
+    };
+
+    assert_eq!(code, 1);
+    assert_eq!(responses[0].error_code, 42);
+}
+
+#[test]
+fn plugin_call_raw_into___null_out_len___returns_config_error() {
+    let mut out = [0u8; 16];
+
+    let code = unsafe {
+        plugin_call_raw_into(
+            1 as FfiPluginHandle,
+            1,
+            ptr::null(),
+            0,
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            ptr::null_mut(),
+        )
+    };
+
+    assert_eq!(code, 4);
+}
+
+#[test]
+fn plugin_call_raw_into___invalid_handle___writes_error_message() {
+    let mut out = [0u8; 64];
+    let mut out_len = 0usize;
+
+    let code = unsafe {
+        plugin_call_raw_into(
+            999 as FfiPluginHandle,
+            1,
+            ptr::null(),
+            0,
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            &mut out_len,
+        )
+    };
+
+    assert_eq!(code, 1);
+    assert_eq!(&out[..out_len], b"Invalid handle");
+}
+
+#[test]
+fn plugin_call_raw_into___small_buffer___truncates_error_message() {
+    let mut out = [0u8; 4];
+    let mut out_len = 0usize;
+
+    let code = unsafe {
+        plugin_call_raw_into(
+            999 as FfiPluginHandle,
+            1,
+            ptr::null(),
+            0,
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            &mut out_len,
+        )
+    };
+
+    assert_eq!(code, 1);
+    assert_eq!(&out[..out_len], b"Inva");
+}
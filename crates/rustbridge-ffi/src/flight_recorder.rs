@@ -0,0 +1,112 @@
+//! Flight recorder for slow calls
+//!
+//! With `flight_recorder.enabled` set in the plugin config, the same calls
+//! that [metrics](crate::metrics) count are timed phase by phase on the
+//! caller's stack. A call that takes at least `slow_call_threshold_us`, or
+//! panics, is copied as an [`RbSlowCall`] into the ring of the calling
+//! thread's shard, overwriting the oldest entry when the ring is full.
+//! `plugin_get_slow_calls` returns the latest ones, newest first.
+//!
+//! Fast calls never touch the rings, so the shard locks are only taken by
+//! slow calls and by readers.
+
+use crate::binary_types::RbSlowCall;
+use crate::metrics::{MetricKey, PHASES, duration_ns, shard_count, thread_shard};
+use parking_lot::Mutex;
+use rustbridge_core::FlightRecorderConfig;
+use std::collections::VecDeque;
+use std::time::Instant;
+
+/// `RbSlowCall::kind` of a JSON call; `id` is its type ID
+pub const RB_CALL_KIND_JSON: u32 = 0;
+
+/// `RbSlowCall::kind` of a binary call; `id` is its message ID
+pub const RB_CALL_KIND_BINARY: u32 = 1;
+
+/// The call returned an error
+pub const RB_SLOW_CALL_ERROR: u32 = 1 << 0;
+
+/// The call panicked (always set together with `RB_SLOW_CALL_ERROR`)
+pub const RB_SLOW_CALL_PANICKED: u32 = 1 << 1;
+
+/// The handler had no synchronous path, so the caller blocked on the runtime
+pub const RB_SLOW_CALL_ASYNC_HANDLER: u32 = 1 << 2;
+
+/// Rings of recent slow calls for one plugin
+pub(crate) struct FlightRecorder {
+    threshold_ns: u64,
+    capacity: usize,
+    epoch: Instant,
+    shards: Box<[Mutex<VecDeque<RbSlowCall>>]>,
+}
+
+impl FlightRecorder {
+    /// Create empty rings, measuring `started_ns` from now
+    pub(crate) fn new(config: &FlightRecorderConfig) -> Self {
+        let capacity = config.capacity.max(1);
+        Self {
+            threshold_ns: config.slow_call_threshold_us.saturating_mul(1000),
+            capacity,
+            epoch: Instant::now(),
+            shards: (0..shard_count())
+                .map(|_| Mutex::new(VecDeque::with_capacity(capacity)))
+                .collect(),
+        }
+    }
+
+    /// Keep a finished call if it was slow or panicked
+    pub(crate) fn record(
+        &self,
+        key: MetricKey,
+        start: Instant,
+        phases: &[Option<u64>; PHASES],
+        flags: u32,
+    ) {
+        let total_ns = duration_ns(start.elapsed());
+        if total_ns < self.threshold_ns && flags & RB_SLOW_CALL_PANICKED == 0 {
+            return;
+        }
+
+        let (kind, id) = match key {
+            MetricKey::Json(type_id) => (RB_CALL_KIND_JSON, type_id),
+            MetricKey::Binary(message_id) => (RB_CALL_KIND_BINARY, message_id),
+        };
+        let [queue_ns, dispatch_ns, handler_ns, serialize_ns] =
+            phases.map(Option::unwrap_or_default);
+        let thread = thread_shard();
+        let call = RbSlowCall {
+            started_ns: duration_ns(start.saturating_duration_since(self.epoch)),
+            total_ns,
+            queue_ns,
+            dispatch_ns,
+            handler_ns,
+            serialize_ns,
+            kind,
+            id,
+            flags,
+            thread: u32::try_from(thread).unwrap_or(u32::MAX),
+        };
+
+        let mut ring = self.shards[thread % self.shards.len()].lock();
+        if ring.len() == self.capacity {
+            ring.pop_front();
+        }
+        ring.push_back(call);
+    }
+
+    /// Get up to `max` of the latest slow calls, newest first
+    pub(crate) fn recent(&self, max: usize) -> Vec<RbSlowCall> {
+        let mut calls: Vec<RbSlowCall> = self
+            .shards
+            .iter()
+            .flat_map(|shard| shard.lock().iter().copied().collect::<Vec<_>>())
+            .collect();
+        calls.sort_unstable_by(|a, b| b.started_ns.cmp(&a.started_ns));
+        calls.truncate(max);
+        calls
+    }
+}
+
+#[cfg(test)]
+#[path = "flight_recorder/flight_recorder_tests.rs"]
+mod flight_recorder_tests;
@@ -0,0 +1,110 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::time::Duration;
+
+fn recorder(slow_call_threshold_us: u64, capacity: usize) -> FlightRecorder {
+    FlightRecorder::new(&FlightRecorderConfig {
+        enabled: true,
+        slow_call_threshold_us,
+        capacity,
+    })
+}
+
+fn started_ago(micros: u64) -> Instant {
+    Instant::now() - Duration::from_micros(micros)
+}
+
+#[test]
+fn FlightRecorder___record___skips_calls_under_threshold() {
+    let recorder = recorder(1_000_000, 8);
+
+    recorder.record(MetricKey::Json(1), Instant::now(), &[None; PHASES], 0);
+
+    assert!(recorder.recent(8).is_empty());
+}
+
+#[test]
+fn FlightRecorder___record___keeps_slow_calls_with_their_phases() {
+    let recorder = recorder(0, 8);
+
+    recorder.record(
+        MetricKey::Binary(7),
+        started_ago(50),
+        &[Some(1), Some(2), Some(3), None],
+        RB_SLOW_CALL_ERROR,
+    );
+
+    let calls = recorder.recent(8);
+    assert_eq!(calls.len(), 1);
+    assert_eq!((calls[0].kind, calls[0].id), (RB_CALL_KIND_BINARY, 7));
+    assert!(calls[0].total_ns >= 50_000);
+    assert_eq!(
+        (
+            calls[0].queue_ns,
+            calls[0].dispatch_ns,
+            calls[0].handler_ns,
+            calls[0].serialize_ns
+        ),
+        (1, 2, 3, 0)
+    );
+    assert_eq!(calls[0].flags, RB_SLOW_CALL_ERROR);
+    assert_eq!(calls[0].thread as usize, thread_shard());
+}
+
+#[test]
+fn FlightRecorder___record___keeps_panics_under_threshold() {
+    let recorder = recorder(1_000_000, 8);
+
+    recorder.record(
+        MetricKey::Json(1),
+        Instant::now(),
+        &[None; PHASES],
+        RB_SLOW_CALL_ERROR | RB_SLOW_CALL_PANICKED,
+    );
+
+    assert_eq!(recorder.recent(8).len(), 1);
+}
+
+#[test]
+fn FlightRecorder___record___full_ring_overwrites_oldest() {
+    let recorder = recorder(0, 2);
+
+    for id in 1..=3 {
+        recorder.record(MetricKey::Json(id), Instant::now(), &[None; PHASES], 0);
+    }
+
+    let ids: Vec<u32> = recorder.recent(8).iter().map(|call| call.id).collect();
+    assert_eq!(ids, vec![3, 2]);
+}
+
+#[test]
+fn FlightRecorder___recent___returns_newest_first_up_to_max() {
+    let recorder = recorder(0, 8);
+
+    recorder.record(MetricKey::Json(1), started_ago(300), &[None; PHASES], 0);
+    recorder.record(MetricKey::Json(2), started_ago(100), &[None; PHASES], 0);
+    recorder.record(MetricKey::Json(3), started_ago(200), &[None; PHASES], 0);
+
+    let ids: Vec<u32> = recorder.recent(2).iter().map(|call| call.id).collect();
+    assert_eq!(ids, vec![2, 3]);
+}
+
+#[test]
+fn FlightRecorder___recent___merges_calls_from_many_threads() {
+    let recorder = std::sync::Arc::new(recorder(0, 64));
+
+    let threads: Vec<_> = (0..4)
+        .map(|id| {
+            let recorder = recorder.clone();
+            std::thread::spawn(move || {
+                recorder.record(MetricKey::Json(id), Instant::now(), &[None; PHASES], 0);
+            })
+        })
+        .collect();
+    for thread in threads {
+        thread.join().unwrap();
+    }
+
+    assert_eq!(recorder.recent(64).len(), 4);
+}
@@ -1,31 +1,50 @@
 //! Plugin handle management
 
+use crate::binary_types::RbSlowCall;
+use crate::flight_recorder::{FlightRecorder, RB_SLOW_CALL_ASYNC_HANDLER};
+use crate::handle_table::{HandleGuard, HandleTable};
+use crate::input::{INPUT_BUFFER_CHUNKS, InputTable};
+use crate::metrics::{CallTimer, HandlerMetrics, MetricKey, MetricsSnapshot, Phase};
+use crate::pool;
+use crate::registry::{BinaryDispatchTable, BinaryHandlers, capture_registrations};
+use crate::ring::RingChannel;
+use crate::stream::StreamTable;
+use crate::type_ids::TypeTagIds;
 use dashmap::DashMap;
 use once_cell::sync::OnceCell;
-use parking_lot::RwLock;
+use parking_lot::{Mutex, RwLock};
 use rustbridge_core::{
-    LifecycleState, Plugin, PluginConfig, PluginContext, PluginError, PluginResult,
+    ContentType, LifecycleState, Plugin, PluginConfig, PluginContext, PluginError, PluginResult,
+    RequestReader, ResponseEncoding,
 };
 use rustbridge_logging::LogCallbackManager;
-use rustbridge_runtime::{AsyncBridge, AsyncRuntime, RuntimeConfig};
-use std::sync::Arc;
-use std::sync::atomic::{AtomicU64, Ordering};
+use rustbridge_runtime::{
+    AdmissionController, AdmissionPermit, AdmissionStats, AsyncBridge, AsyncRuntime,
+    CompletionCallback, PendingRequest, RuntimeConfig,
+};
+use rustbridge_transport::ResponseEnvelope;
+use std::ffi::c_void;
+use std::mem::ManuallyDrop;
+use std::ops::Deref;
+use std::sync::{Arc, Weak};
 
 /// Global handle manager
 static HANDLE_MANAGER: OnceCell<PluginHandleManager> = OnceCell::new();
 
 /// Manages plugin handles
+///
+/// Handles live in a generational slot table. Lookups are wait-free and do
+/// not touch the handle's reference count, and IDs of removed handles stay
+/// invalid even after their slot is reused.
 pub struct PluginHandleManager {
-    handles: DashMap<u64, Arc<PluginHandle>>,
-    next_id: AtomicU64,
+    handles: HandleTable<PluginHandle>,
 }
 
 impl PluginHandleManager {
     /// Create a new handle manager
     pub fn new() -> Self {
         Self {
-            handles: DashMap::new(),
-            next_id: AtomicU64::new(1),
+            handles: HandleTable::new(),
         }
     }
 
@@ -35,20 +54,41 @@ impl PluginHandleManager {
     }
 
     /// Register a new handle
+    ///
+    /// Sets the handle's ID and returns it, or returns 0 if the table is full.
     pub fn register(&self, handle: PluginHandle) -> u64 {
-        let id = self.next_id.fetch_add(1, Ordering::SeqCst);
-        self.handles.insert(id, Arc::new(handle));
-        id
+        self.handles.insert_with(|id| {
+            handle.set_id(id);
+            Arc::new(handle)
+        })
+    }
+
+    /// Look up a handle for the duration of a call
+    ///
+    /// This is the FFI hot path: the guard borrows the handle without cloning
+    /// the `Arc`, and keeps it alive if it is removed meanwhile.
+    pub fn lookup(&self, id: u64) -> Option<HandleGuard<'_, PluginHandle>> {
+        self.handles.get(id)
     }
 
     /// Get a handle by ID
     pub fn get(&self, id: u64) -> Option<Arc<PluginHandle>> {
-        self.handles.get(&id).map(|r| r.clone())
+        self.handles.get_arc(id)
     }
 
     /// Remove a handle
     pub fn remove(&self, id: u64) -> Option<Arc<PluginHandle>> {
-        self.handles.remove(&id).map(|(_, v)| v)
+        self.handles.remove(id)
+    }
+
+    /// Number of registered handles
+    pub fn len(&self) -> usize {
+        self.handles.len()
+    }
+
+    /// Check if no handles are registered
+    pub fn is_empty(&self) -> bool {
+        self.handles.is_empty()
     }
 }
 
@@ -70,19 +110,57 @@ pub struct PluginHandle {
     bridge: AsyncBridge,
     /// Handle ID (set after registration)
     id: RwLock<Option<u64>>,
-    /// Optional request limiter (None = unlimited)
-    request_limiter: Option<Arc<tokio::sync::Semaphore>>,
-    /// Counter for requests rejected due to concurrency limit
-    rejected_requests: AtomicU64,
+    /// Admission control for `max_concurrent_ops` (None = unlimited)
+    admission: Option<Arc<AdmissionController>>,
+    /// Async requests submitted but not yet completed or cancelled
+    pending_requests: DashMap<u64, PendingRequest>,
+    /// Binary handlers, frozen when the plugin becomes Active
+    binary_dispatch: OnceCell<BinaryDispatchTable>,
+    /// Numeric IDs for JSON type tags, frozen when the plugin becomes Active
+    type_ids: OnceCell<TypeTagIds>,
+    /// Per-handler metrics, created at start when `metrics.enabled` is set
+    metrics: OnceCell<HandlerMetrics>,
+    /// Slow-call rings, created at start when `flight_recorder.enabled` is set
+    recorder: OnceCell<FlightRecorder>,
+    /// Ring channels opened with plugin_ring_open, stopped on shutdown
+    rings: Mutex<Vec<Weak<RingChannel>>>,
+    /// Streamed responses opened with plugin_stream_open
+    streams: StreamTable,
+    /// Streamed requests opened with plugin_input_open
+    inputs: InputTable,
+    /// This plugin's log callback and level, entered while its code runs
+    logger: Arc<LogCallbackManager>,
 }
 
 impl PluginHandle {
     /// Create a new plugin handle
+    ///
+    /// The plugin gets its own log manager, configured from `config` but
+    /// without a host callback.
     pub fn new(plugin: Box<dyn Plugin>, config: PluginConfig) -> PluginResult<Self> {
+        let logger = LogCallbackManager::from_config(&config, None);
+        Self::with_logger(plugin, config, logger)
+    }
+
+    /// Create a new plugin handle whose log events go to `logger`
+    pub fn with_logger(
+        plugin: Box<dyn Plugin>,
+        config: PluginConfig,
+        logger: Arc<LogCallbackManager>,
+    ) -> PluginResult<Self> {
         // Create runtime configuration from plugin config
+        let defaults = RuntimeConfig::default();
         let runtime_config = RuntimeConfig {
             worker_threads: config.worker_threads,
-            ..Default::default()
+            max_blocking_threads: config
+                .runtime
+                .max_blocking_threads
+                .unwrap_or(defaults.max_blocking_threads),
+            flavor: config.runtime.flavor,
+            shared: config.runtime.shared,
+            cpu_affinity: config.runtime.cpu_affinity.clone(),
+            numa_node: config.runtime.numa_node,
+            ..defaults
         };
 
         // Create the async runtime
@@ -91,10 +169,11 @@ impl PluginHandle {
         // Create the async bridge
         let bridge = AsyncBridge::new(runtime.clone());
 
-        // Create request limiter based on max_concurrent_ops
-        let request_limiter = if config.max_concurrent_ops > 0 {
-            Some(Arc::new(tokio::sync::Semaphore::new(
+        // Create admission controller based on max_concurrent_ops
+        let admission = if config.max_concurrent_ops > 0 {
+            Some(Arc::new(AdmissionController::new(
                 config.max_concurrent_ops,
+                config.admission.clone(),
             )))
         } else {
             None // 0 means unlimited
@@ -109,8 +188,16 @@ impl PluginHandle {
             runtime,
             bridge,
             id: RwLock::new(None),
-            request_limiter,
-            rejected_requests: AtomicU64::new(0),
+            admission,
+            pending_requests: DashMap::new(),
+            binary_dispatch: OnceCell::new(),
+            type_ids: OnceCell::new(),
+            metrics: OnceCell::new(),
+            recorder: OnceCell::new(),
+            rings: Mutex::new(Vec::new()),
+            streams: StreamTable::new(),
+            inputs: InputTable::new(),
+            logger,
         })
     }
 
@@ -124,6 +211,102 @@ impl PluginHandle {
         *self.id.write() = Some(id);
     }
 
+    /// Get the async bridge for this plugin
+    pub(crate) fn bridge(&self) -> &AsyncBridge {
+        &self.bridge
+    }
+
+    /// Get the async runtime for this plugin
+    pub(crate) fn runtime(&self) -> &AsyncRuntime {
+        &self.runtime
+    }
+
+    /// Get this plugin's log manager
+    pub fn logger(&self) -> &Arc<LogCallbackManager> {
+        &self.logger
+    }
+
+    /// Remember a ring channel so shutdown can stop its consumer
+    pub(crate) fn track_ring(&self, channel: &Arc<RingChannel>) {
+        let mut rings = self.rings.lock();
+        rings.retain(|ring| ring.strong_count() > 0);
+        rings.push(Arc::downgrade(channel));
+    }
+
+    /// Stop the consumers of every open ring channel
+    ///
+    /// The channels' memory stays valid until the host closes them.
+    fn stop_rings(&self) {
+        let rings = std::mem::take(&mut *self.rings.lock());
+        for ring in rings.iter().filter_map(Weak::upgrade) {
+            ring.stop();
+        }
+    }
+
+    /// Number of runtime workers available for parallel dispatch
+    pub(crate) fn parallelism(&self) -> usize {
+        self.context.config.worker_threads.unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+    }
+
+    /// Look up the binary handlers registered for a message ID
+    ///
+    /// Returns no handlers until the plugin has started.
+    pub(crate) fn binary_handlers(&self, message_id: u32) -> BinaryHandlers {
+        self.binary_dispatch
+            .get()
+            .and_then(|table| table.get(message_id))
+            .unwrap_or_default()
+    }
+
+    /// Resolve a JSON type tag to its numeric ID
+    ///
+    /// IDs are assigned to the plugin's `supported_types` when it starts.
+    /// Returns 0 for tags without an ID and before the plugin has started.
+    pub fn resolve_type_tag(&self, type_tag: &str) -> u32 {
+        self.type_ids
+            .get()
+            .map_or(0, |type_ids| type_ids.resolve(type_tag))
+    }
+
+    /// Get the type tag for an ID from [`resolve_type_tag`](Self::resolve_type_tag)
+    #[inline]
+    pub fn type_tag(&self, type_id: u32) -> Option<&'static str> {
+        self.type_ids.get()?.tag(type_id)
+    }
+
+    /// Start timing a call for the metrics and the flight recorder
+    ///
+    /// The timer is inert unless at least one of them is enabled.
+    #[inline]
+    pub(crate) fn call_timer(&self) -> CallTimer<'_> {
+        CallTimer::start(self.metrics.get(), self.recorder.get())
+    }
+
+    /// Snapshot the per-handler call counts and latency histograms
+    ///
+    /// Returns an empty snapshot with `enabled: false` unless the plugin was
+    /// started with `metrics.enabled`.
+    pub fn metrics_snapshot(&self) -> MetricsSnapshot {
+        self.metrics
+            .get()
+            .map(HandlerMetrics::snapshot)
+            .unwrap_or_default()
+    }
+
+    /// Get up to `max` of the latest slow calls, newest first
+    ///
+    /// Empty unless the plugin was started with `flight_recorder.enabled`.
+    pub fn slow_calls(&self, max: usize) -> Vec<RbSlowCall> {
+        self.recorder
+            .get()
+            .map(|recorder| recorder.recent(max))
+            .unwrap_or_default()
+    }
+
     /// Get the current lifecycle state
     pub fn state(&self) -> LifecycleState {
         self.context.state()
@@ -131,14 +314,34 @@ impl PluginHandle {
 
     /// Start the plugin
     pub fn start(&self) -> PluginResult<()> {
+        let _log = self.logger.enter();
+
         // Transition to Starting state
         self.context.transition_to(LifecycleState::Starting)?;
 
-        // Call plugin's on_start
-        let result = self.bridge.call_sync(self.plugin.on_start(&self.context));
+        // Call plugin's on_start, collecting the binary handlers it registers
+        let (result, registry) =
+            capture_registrations(|| self.bridge.call_sync(self.plugin.on_start(&self.context)));
 
         match result {
             Ok(()) => {
+                // Freeze handlers before any call can see the Active state
+                let binary_dispatch = registry.freeze();
+                let type_ids = TypeTagIds::new(self.plugin.supported_types());
+                if self.context.config.metrics.enabled {
+                    let _ = self.metrics.set(HandlerMetrics::new(
+                        type_ids.tags(),
+                        &binary_dispatch.message_ids(),
+                    ));
+                }
+                if self.context.config.flight_recorder.enabled {
+                    let _ = self
+                        .recorder
+                        .set(FlightRecorder::new(&self.context.config.flight_recorder));
+                }
+                let _ = self.binary_dispatch.set(binary_dispatch);
+                let _ = self.type_ids.set(type_ids);
+
                 // Transition to Active
                 self.context.transition_to(LifecycleState::Active)?;
                 tracing::info!("Plugin started successfully");
@@ -153,42 +356,339 @@ impl PluginHandle {
         }
     }
 
+    /// Check the plugin is active and acquire an admission slot for a call
+    ///
+    /// Queues on the calling thread if the admission mode allows it.
+    fn admit_sync_call(&self) -> PluginResult<Option<AdmissionPermit<'_>>> {
+        if !self.context.state().can_handle_requests() {
+            return Err(PluginError::InvalidState {
+                expected: "Active".to_string(),
+                actual: self.context.state().to_string(),
+            });
+        }
+        match &self.admission {
+            Some(admission) => admission.admit().map(Some),
+            None => Ok(None),
+        }
+    }
+
     /// Handle a request
     pub fn call(&self, type_tag: &str, request: &[u8]) -> PluginResult<Vec<u8>> {
-        // Check state
+        let mut timer = self.call_timer();
+        timer.key(|| MetricKey::Json(self.resolve_type_tag(type_tag)));
+        let result = self.call_timed(type_tag, request, &mut timer);
+        timer.finish(result.is_ok());
+        result
+    }
+
+    /// Handle a request, timing the admission wait and the handler
+    pub(crate) fn call_timed(
+        &self,
+        type_tag: &str,
+        request: &[u8],
+        timer: &mut CallTimer<'_>,
+    ) -> PluginResult<Vec<u8>> {
+        let _log = self.logger.enter();
+        let _permit = self.admit_sync_call()?;
+        timer.lap(Phase::Queue);
+
+        // Call the plugin handler, inline if it has a synchronous path
+        // Permit is automatically released when dropped
+        let result = match self
+            .plugin
+            .handle_request_sync(&self.context, type_tag, request)
+        {
+            Some(result) => result,
+            None => {
+                timer.flag(RB_SLOW_CALL_ASYNC_HANDLER);
+                self.bridge
+                    .call_sync(self.plugin.handle_request(&self.context, type_tag, request))
+            }
+        };
+        timer.lap(Phase::Handler);
+        result
+    }
+
+    /// Handle a request whose payload is encoded as `content_type`
+    ///
+    /// JSON is exactly [`call`](Self::call), including the synchronous fast
+    /// path. Other formats go to
+    /// [`Plugin::handle_request_as`](rustbridge_core::Plugin::handle_request_as),
+    /// and the response comes back in the same format as the request.
+    pub fn call_as(
+        &self,
+        type_tag: &str,
+        content_type: ContentType,
+        request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        if content_type == ContentType::Json {
+            return self.call(type_tag, request);
+        }
+        let _log = self.logger.enter();
+        let _permit = self.admit_sync_call()?;
+        self.bridge.call_sync(self.plugin.handle_request_as(
+            &self.context,
+            type_tag,
+            content_type,
+            request,
+        ))
+    }
+
+    /// Open a streamed response for a request
+    ///
+    /// Runs [`Plugin::handle_request_stream`](rustbridge_core::Plugin::handle_request_stream)
+    /// on the calling thread, so handler errors are returned here, then
+    /// drives the stream on the runtime. The stream holds an admission slot
+    /// until it ends or is closed. Returns the stream ID (never 0).
+    pub fn open_stream(&self, type_tag: &str, request: &[u8]) -> PluginResult<u64> {
+        let _log = self.logger.enter();
+        if !self.context.state().can_handle_requests() {
+            return Err(PluginError::InvalidState {
+                expected: "Active".to_string(),
+                actual: self.context.state().to_string(),
+            });
+        }
+        let permit = match &self.admission {
+            Some(admission) => Some(self.bridge.call_sync(Arc::clone(admission).admit_owned())?),
+            None => None,
+        };
+        let stream = self.bridge.call_sync(self.plugin.handle_request_stream(
+            &self.context,
+            type_tag,
+            request,
+        ))?;
+        Ok(self
+            .streams
+            .open(&self.bridge, Arc::clone(&self.logger), stream, permit))
+    }
+
+    /// Block until the next chunk of an open stream is ready
+    ///
+    /// Returns `Ok(None)` once the stream is complete. A stream is forgotten
+    /// after it completes or fails, and unknown IDs fail with `InvalidState`.
+    pub fn next_stream_chunk(&self, stream_id: u64) -> PluginResult<Option<Vec<u8>>> {
+        self.streams.next(stream_id)
+    }
+
+    /// Stop an open stream before it is complete
+    ///
+    /// Returns `true` if the stream was open.
+    pub fn close_stream(&self, stream_id: u64) -> bool {
+        self.streams.close(stream_id)
+    }
+
+    /// Get the number of streams that have not completed or been closed
+    pub fn open_stream_count(&self) -> usize {
+        self.streams.len()
+    }
+
+    /// Open a streamed request for `type_tag`
+    ///
+    /// Spawns [`Plugin::handle_request_reader`](rustbridge_core::Plugin::handle_request_reader)
+    /// on the runtime, reading the chunks later passed to
+    /// [`write_input`](Self::write_input). The handler holds an admission
+    /// slot until it returns. Returns the input ID (never 0).
+    pub fn open_input(self: &Arc<Self>, type_tag: &str) -> PluginResult<u64> {
         if !self.context.state().can_handle_requests() {
             return Err(PluginError::InvalidState {
                 expected: "Active".to_string(),
                 actual: self.context.state().to_string(),
             });
         }
+        let permit = match &self.admission {
+            Some(admission) => Some(self.bridge.call_sync(Arc::clone(admission).admit_owned())?),
+            None => None,
+        };
+
+        let (sender, mut reader) = RequestReader::channel(INPUT_BUFFER_CHUNKS);
+        let handle = TaskHandle::new(Arc::clone(self));
+        let type_tag = type_tag.to_string();
+        let handler = rustbridge_logging::scoped(Arc::clone(&self.logger), async move {
+            let _permit = permit;
+            handle
+                .plugin
+                .handle_request_reader(&handle.context, &type_tag, &mut reader)
+                .await
+        });
+        Ok(self.inputs.open(&self.bridge, sender, handler))
+    }
+
+    /// Pass the next chunk of a streamed request to its handler
+    ///
+    /// Blocks while the handler has [`INPUT_BUFFER_CHUNKS`] chunks waiting.
+    pub fn write_input(&self, input_id: u64, chunk: &[u8]) -> PluginResult<()> {
+        self.inputs.write(input_id, chunk)
+    }
 
-        // Try to acquire permit (immediate, non-blocking)
-        let _permit = if let Some(sem) = &self.request_limiter {
-            match sem.try_acquire() {
-                Ok(permit) => Some(permit),
-                Err(_) => {
-                    self.rejected_requests.fetch_add(1, Ordering::Relaxed);
-                    return Err(PluginError::TooManyRequests);
+    /// End a streamed request and wait for the handler's response
+    pub fn finish_input(&self, input_id: u64) -> PluginResult<Vec<u8>> {
+        self.inputs.finish(&self.bridge, input_id)
+    }
+
+    /// Stop a streamed request's handler and discard the request
+    ///
+    /// Returns `true` if the input was open.
+    pub fn abort_input(&self, input_id: u64) -> bool {
+        self.inputs.abort(input_id)
+    }
+
+    /// Get the number of streamed requests not yet finished or aborted
+    pub fn open_input_count(&self) -> usize {
+        self.inputs.len()
+    }
+
+    /// Wrap a handler's JSON response in a success envelope
+    ///
+    /// Uses the plugin's configured [`ResponseEncoding`](rustbridge_core::ResponseEncoding).
+    /// Spliced envelopes are written into a buffer from the calling thread's
+    /// buffer pool, so the buffer freed by the previous call is reused.
+    pub fn encode_success(&self, response: &[u8]) -> Result<Vec<u8>, serde_json::Error> {
+        match self.context.config.response_encoding {
+            ResponseEncoding::Splice => {
+                let mut bytes = pool::take(ResponseEnvelope::spliced_success_len(response.len()));
+                match ResponseEnvelope::encode_success_raw_into(response, &mut bytes) {
+                    Ok(()) => Ok(bytes),
+                    Err(e) => {
+                        pool::recycle(bytes);
+                        Err(e)
+                    }
                 }
             }
-        } else {
-            None
+            encoding => ResponseEnvelope::encode_success_with(response, encoding),
+        }
+    }
+
+    /// Submit a request for asynchronous processing
+    ///
+    /// The handler is spawned onto the plugin's runtime and `callback` is
+    /// invoked from a runtime worker thread when it finishes, with the same
+    /// response envelope `call` would produce. Returns the request ID (never 0)
+    /// that can be passed to [`cancel_async`](Self::cancel_async).
+    ///
+    /// Submission failures (wrong state, concurrency limit) are returned
+    /// directly and the callback is never invoked for them.
+    pub fn call_async(
+        self: &Arc<Self>,
+        type_tag: &str,
+        request: &[u8],
+        callback: CompletionCallback,
+        context: *mut c_void,
+    ) -> PluginResult<u64> {
+        // Check state
+        if !self.context.state().can_handle_requests() || self.bridge.is_shutting_down() {
+            return Err(PluginError::InvalidState {
+                expected: "Active".to_string(),
+                actual: self.context.state().to_string(),
+            });
+        }
+
+        // Take a free slot now; if the mode queues, the task waits for one instead.
+        // The permit is held until the task ends
+        let mut permit = None;
+        let mut queue_on = None;
+        if let Some(admission) = &self.admission {
+            match admission.try_admit_owned()? {
+                Some(admitted) => permit = Some(admitted),
+                None => queue_on = Some(Arc::clone(admission)),
+            }
+        }
+
+        // Request IDs start at 1 so that 0 can signal a failed submission
+        let request_id = self.bridge.next_request_id().wrapping_add(1);
+        self.pending_requests.insert(
+            request_id,
+            PendingRequest::new(request_id, callback, context),
+        );
+
+        let completion = AsyncCompletion::new(Arc::clone(self), request_id);
+        let type_tag = type_tag.to_string();
+        let request = request.to_vec();
+        let work = async move {
+            let permit = match queue_on {
+                Some(admission) => match admission.admit_owned().await {
+                    Ok(admitted) => Some(admitted),
+                    Err(e) => return completion.complete(Err(e)),
+                },
+                None => permit,
+            };
+            let handle = completion.handle();
+            let result =
+                match handle
+                    .plugin
+                    .handle_request_sync(&handle.context, &type_tag, &request)
+                {
+                    Some(result) => result,
+                    None => {
+                        handle
+                            .plugin
+                            .handle_request(&handle.context, &type_tag, &request)
+                            .await
+                    }
+                };
+            drop(permit);
+            completion.complete(result);
         };
+        let task = self
+            .bridge
+            .spawn(rustbridge_logging::scoped(Arc::clone(&self.logger), work));
 
-        // Call the plugin handler
-        // Permit is automatically released when dropped
-        self.bridge
-            .call_sync(self.plugin.handle_request(&self.context, type_tag, request))
+        match self.pending_requests.get_mut(&request_id) {
+            Some(mut pending) => pending.cancel_handle = Some(task),
+            // Already completed or cancelled; aborting a finished task is a no-op
+            None => task.abort(),
+        }
+
+        Ok(request_id)
+    }
+
+    /// Cancel a pending async request
+    ///
+    /// Returns `true` if the request was still pending. The completion
+    /// callback is not invoked for a cancelled request.
+    pub fn cancel_async(&self, request_id: u64) -> bool {
+        match self.pending_requests.remove(&request_id) {
+            Some((_, pending)) => {
+                if let Some(task) = &pending.cancel_handle {
+                    task.abort();
+                }
+                true
+            }
+            None => false,
+        }
+    }
+
+    /// Get the number of async requests that have not completed yet
+    pub fn pending_request_count(&self) -> usize {
+        self.pending_requests.len()
+    }
+
+    /// Abort all pending async requests, completing each with a cancellation error
+    ///
+    /// Callbacks are invoked so hosts can release their per-request context.
+    fn cancel_pending_requests(&self) {
+        let ids: Vec<u64> = self.pending_requests.iter().map(|e| *e.key()).collect();
+        for id in ids {
+            if let Some((_, pending)) = self.pending_requests.remove(&id) {
+                if let Some(task) = &pending.cancel_handle {
+                    task.abort();
+                }
+                let (data, error_code) = completion_envelope(self, Err(PluginError::Cancelled));
+                // SAFETY: the host guarantees the callback and context stay valid
+                // until the request is completed or cancelled
+                unsafe { pending.complete(&data, error_code) };
+            }
+        }
     }
 
     /// Shutdown the plugin
     pub fn shutdown(&self, timeout_ms: u64) -> PluginResult<()> {
+        let _log = self.logger.enter();
         let current_state = self.context.state();
 
         // Can only shutdown from Active state
         if current_state != LifecycleState::Active {
             if current_state.is_terminal() {
+                self.stop_rings();
                 return Ok(()); // Already stopped/failed
             }
             return Err(PluginError::InvalidState {
@@ -200,12 +700,21 @@ impl PluginHandle {
         // Transition to Stopping
         self.context.transition_to(LifecycleState::Stopping)?;
 
+        // Ring consumers hold the handle and run handlers; stop them first
+        self.stop_rings();
+        // Hosts blocked in plugin_stream_next get Cancelled
+        self.streams.close_all();
+        self.inputs.abort_all();
+
         // Call plugin's on_stop with timeout
         let timeout = std::time::Duration::from_millis(timeout_ms);
         let result = self
             .bridge
             .call_sync_timeout(self.plugin.on_stop(&self.context), timeout);
 
+        // Async requests still in flight will never be delivered
+        self.cancel_pending_requests();
+
         // Shutdown runtime
         let runtime_timeout = std::time::Duration::from_millis(timeout_ms / 2);
         let _ = self.runtime.shutdown(runtime_timeout);
@@ -230,14 +739,10 @@ impl PluginHandle {
     }
 
     /// Set the log level
+    ///
+    /// Only this plugin's events are affected.
     pub fn set_log_level(&self, level: rustbridge_core::LogLevel) {
-        // Update the log callback manager's level
-        LogCallbackManager::global().set_level(level);
-
-        // Reload the tracing subscriber's filter
-        if let Err(e) = rustbridge_logging::ReloadHandle::global().reload_level(level) {
-            tracing::warn!("Failed to reload tracing filter: {}", e);
-        }
+        self.logger.set_level(level);
     }
 
     /// Mark the plugin as failed
@@ -255,7 +760,19 @@ impl PluginHandle {
 
     /// Get the count of requests rejected due to concurrency limits
     pub fn rejected_request_count(&self) -> u64 {
-        self.rejected_requests.load(Ordering::Relaxed)
+        self.admission
+            .as_ref()
+            .map_or(0, |admission| admission.rejected_count())
+    }
+
+    /// Get a snapshot of admission control counters
+    ///
+    /// Without a concurrency limit every counter is zero, including `limit`.
+    pub fn admission_stats(&self) -> AdmissionStats {
+        self.admission
+            .as_ref()
+            .map(|admission| admission.stats())
+            .unwrap_or_default()
     }
 }
 
@@ -263,6 +780,110 @@ impl PluginHandle {
 unsafe impl Send for PluginHandle {}
 unsafe impl Sync for PluginHandle {}
 
+/// Completion state owned by a spawned async request
+///
+/// Delivers the result to the pending request's callback. If the task is
+/// dropped before completing (handler panic or runtime teardown), the host is
+/// still notified so it can release its context.
+///
+/// The task holds a strong reference to the handle through [`TaskHandle`].
+struct AsyncCompletion {
+    handle: TaskHandle,
+    request_id: u64,
+    completed: bool,
+}
+
+impl AsyncCompletion {
+    fn new(handle: Arc<PluginHandle>, request_id: u64) -> Self {
+        Self {
+            handle: TaskHandle::new(handle),
+            request_id,
+            completed: false,
+        }
+    }
+
+    fn handle(&self) -> &PluginHandle {
+        &self.handle
+    }
+
+    fn complete(mut self, result: PluginResult<Vec<u8>>) {
+        self.completed = true;
+        self.deliver(result);
+    }
+
+    fn deliver(&self, result: PluginResult<Vec<u8>>) {
+        // Removing the entry claims the callback; a cancelled request is gone
+        let Some((_, pending)) = self.handle.pending_requests.remove(&self.request_id) else {
+            return;
+        };
+        let (data, error_code) = completion_envelope(&self.handle, result);
+        // SAFETY: the host guarantees the callback and context stay valid
+        // until the request is completed or cancelled
+        unsafe { pending.complete(&data, error_code) };
+    }
+}
+
+impl Drop for AsyncCompletion {
+    fn drop(&mut self) {
+        if !self.completed {
+            if std::thread::panicking() {
+                self.handle.mark_failed();
+                self.deliver(Err(PluginError::Internal("Handler panicked".to_string())));
+            } else {
+                self.deliver(Err(PluginError::Cancelled));
+            }
+        }
+    }
+}
+
+/// Strong reference to a handle, held by a task on the handle's runtime
+///
+/// Dropping the last reference drops the Tokio runtime, which panics on a
+/// runtime thread, so in that case the handle is released on a separate
+/// thread.
+pub(crate) struct TaskHandle(ManuallyDrop<Arc<PluginHandle>>);
+
+impl TaskHandle {
+    pub(crate) fn new(handle: Arc<PluginHandle>) -> Self {
+        Self(ManuallyDrop::new(handle))
+    }
+}
+
+impl Deref for TaskHandle {
+    type Target = PluginHandle;
+
+    fn deref(&self) -> &PluginHandle {
+        &self.0
+    }
+}
+
+impl Drop for TaskHandle {
+    fn drop(&mut self) {
+        // SAFETY: the handle is not used again after this point
+        let handle = unsafe { ManuallyDrop::take(&mut self.0) };
+        if let Some(last) = Arc::into_inner(handle)
+            && tokio::runtime::Handle::try_current().is_ok()
+        {
+            std::thread::spawn(move || drop(last));
+        }
+    }
+}
+
+/// Encode an async result the same way `plugin_call` does
+fn completion_envelope(handle: &PluginHandle, result: PluginResult<Vec<u8>>) -> (Vec<u8>, u32) {
+    let error = match result {
+        Ok(data) => match handle.encode_success(&data) {
+            Ok(bytes) => return (bytes, 0),
+            Err(e) => PluginError::SerializationError(e.to_string()),
+        },
+        Err(e) => e,
+    };
+    match ResponseEnvelope::from_error(&error).to_bytes() {
+        Ok(bytes) => (bytes, error.error_code()),
+        Err(e) => (format!("Serialization error: {}", e).into_bytes(), 5),
+    }
+}
+
 #[cfg(test)]
 #[path = "handle/handle_tests.rs"]
 mod handle_tests;
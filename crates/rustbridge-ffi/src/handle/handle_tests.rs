@@ -2,6 +2,9 @@
 
 use super::*;
 use async_trait::async_trait;
+use rustbridge_core::{AdmissionConfig, AdmissionMode, LogLevel, RuntimeFlavor, RuntimeSettings};
+use std::sync::mpsc;
+use std::time::Duration;
 
 struct TestPlugin;
 
@@ -23,6 +26,8 @@ impl Plugin for TestPlugin {
             // Sleep to simulate a slow request
             tokio::time::sleep(std::time::Duration::from_millis(100)).await;
             Ok(payload.to_vec())
+        } else if type_tag == "panic" {
+            panic!("handler panic");
         } else {
             Err(PluginError::UnknownMessageType(type_tag.to_string()))
         }
@@ -33,6 +38,39 @@ impl Plugin for TestPlugin {
     }
 }
 
+/// Answers "echo" synchronously and everything else through the async path
+struct SyncPlugin;
+
+#[async_trait]
+impl Plugin for SyncPlugin {
+    async fn on_start(&self, _ctx: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    fn handle_request_sync(
+        &self,
+        _ctx: &PluginContext,
+        type_tag: &str,
+        _payload: &[u8],
+    ) -> Option<PluginResult<Vec<u8>>> {
+        (type_tag == "echo").then(|| Ok(b"\"sync\"".to_vec()))
+    }
+
+    async fn handle_request(
+        &self,
+        _ctx: &PluginContext,
+        _type_tag: &str,
+        _payload: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        tokio::task::yield_now().await;
+        Ok(b"\"async\"".to_vec())
+    }
+
+    async fn on_stop(&self, _ctx: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+}
+
 // PluginHandle tests
 
 #[test]
@@ -94,6 +132,145 @@ fn PluginHandle___call___before_start_returns_error() {
     assert!(matches!(result, Err(PluginError::InvalidState { .. })));
 }
 
+#[test]
+fn PluginHandle___call___sync_handler_answers_inline() {
+    let handle = PluginHandle::new(Box::new(SyncPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+
+    let response = handle.call("echo", b"hi").unwrap();
+
+    assert_eq!(response, b"\"sync\"");
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call___sync_handler_none_falls_back_to_async() {
+    let handle = PluginHandle::new(Box::new(SyncPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+
+    let response = handle.call("other", b"hi").unwrap();
+
+    assert_eq!(response, b"\"async\"");
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_as___json_uses_sync_handler() {
+    let handle = PluginHandle::new(Box::new(SyncPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+
+    let response = handle.call_as("echo", ContentType::Json, b"hi").unwrap();
+
+    assert_eq!(response, b"\"sync\"");
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_as___binary_without_plugin_support_returns_unsupported() {
+    let handle = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+
+    let result = handle.call_as("echo", ContentType::MsgPack, b"\xa2hi");
+
+    assert!(matches!(
+        result,
+        Err(PluginError::UnsupportedContentType(_))
+    ));
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___current_thread_runtime___serves_sync_and_async_calls() {
+    let config = PluginConfig {
+        runtime: RuntimeSettings {
+            flavor: RuntimeFlavor::CurrentThread,
+            ..Default::default()
+        },
+        ..Default::default()
+    };
+    let handle = Arc::new(PluginHandle::new(Box::new(TestPlugin), config).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    let result = handle.call("slow", b"{}").unwrap();
+    handle
+        .call_async("slow", b"{}", send_completion, context_of(tx))
+        .unwrap();
+
+    assert_eq!(result, b"{}");
+    let (_, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+    assert_eq!(error_code, 0);
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___shared_runtime___handles_shut_down_independently() {
+    let shared = || PluginConfig {
+        runtime: RuntimeSettings {
+            shared: true,
+            ..Default::default()
+        },
+        ..Default::default()
+    };
+    let first = PluginHandle::new(Box::new(TestPlugin), shared()).unwrap();
+    let second = PluginHandle::new(Box::new(TestPlugin), shared()).unwrap();
+    first.start().unwrap();
+    second.start().unwrap();
+
+    first.shutdown(1000).unwrap();
+    drop(first);
+    let result = second.call("echo", b"{}").unwrap();
+
+    assert_eq!(result, b"{}");
+    second.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___resolve_type_tag___before_start_returns_zero() {
+    let handle = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
+
+    assert_eq!(handle.resolve_type_tag("echo"), 0);
+    assert_eq!(handle.type_tag(1), None);
+}
+
+#[test]
+fn PluginHandle___resolve_type_tag___plugin_without_supported_types_returns_zero() {
+    let handle = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+
+    assert_eq!(handle.resolve_type_tag("echo"), 0);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___set_log_level___leaves_other_handles_untouched() {
+    let first = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
+    let second = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
+
+    first.set_log_level(LogLevel::Trace);
+    second.set_log_level(LogLevel::Warn);
+
+    assert_eq!(first.logger().level(), LogLevel::Trace);
+    assert_eq!(second.logger().level(), LogLevel::Warn);
+}
+
+#[test]
+fn PluginHandle___new___takes_log_level_from_config() {
+    let config = PluginConfig {
+        log_level: "debug".to_string(),
+        ..Default::default()
+    };
+
+    let handle = PluginHandle::new(Box::new(TestPlugin), config).unwrap();
+
+    assert_eq!(handle.logger().level(), LogLevel::Debug);
+}
+
 #[test]
 fn PluginHandle___id___initially_none() {
     let handle = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap();
@@ -110,6 +287,232 @@ fn PluginHandle___set_id___sets_id() {
     assert_eq!(handle.id(), Some(42));
 }
 
+// Async call tests
+
+type Completion = (u64, u32, Vec<u8>);
+
+extern "C" fn send_completion(
+    context: *mut c_void,
+    request_id: u64,
+    data: *const u8,
+    len: usize,
+    error_code: u32,
+) {
+    let tx = unsafe { &*(context as *const mpsc::Sender<Completion>) };
+    let bytes = unsafe { std::slice::from_raw_parts(data, len) }.to_vec();
+    let _ = tx.send((request_id, error_code, bytes));
+}
+
+/// The sender is leaked because a callback may still be inside `send` on a
+/// worker thread after the test has received its message and returned.
+fn completion_channel() -> (
+    &'static mpsc::Sender<Completion>,
+    mpsc::Receiver<Completion>,
+) {
+    let (tx, rx) = mpsc::channel();
+    (Box::leak(Box::new(tx)), rx)
+}
+
+fn context_of(tx: &mpsc::Sender<Completion>) -> *mut c_void {
+    tx as *const mpsc::Sender<Completion> as *mut c_void
+}
+
+#[test]
+fn PluginHandle___call_async___invokes_callback_with_envelope() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    let request_id = handle
+        .call_async("echo", b"{\"a\":1}", send_completion, context_of(tx))
+        .unwrap();
+    let (id, error_code, data) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    assert_ne!(request_id, 0);
+    assert_eq!(id, request_id);
+    assert_eq!(error_code, 0);
+    let envelope: ResponseEnvelope = serde_json::from_slice(&data).unwrap();
+    assert_eq!(envelope.payload, Some(serde_json::json!({"a": 1})));
+    assert_eq!(handle.pending_request_count(), 0);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_async___uses_sync_handler() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(SyncPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    handle
+        .call_async("echo", b"1", send_completion, context_of(tx))
+        .unwrap();
+    let (_, error_code, data) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    assert_eq!(error_code, 0);
+    let envelope: ResponseEnvelope = serde_json::from_slice(&data).unwrap();
+    assert_eq!(envelope.payload, Some(serde_json::json!("sync")));
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_async___handler_error_reports_error_code() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    handle
+        .call_async("unknown", b"{}", send_completion, context_of(tx))
+        .unwrap();
+    let (_, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    assert_eq!(error_code, 6);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_async___handler_panic_reports_internal_error() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    handle
+        .call_async("panic", b"{}", send_completion, context_of(tx))
+        .unwrap();
+    let (_, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    assert_eq!(error_code, 11);
+    assert_eq!(handle.state(), LifecycleState::Failed);
+}
+
+#[test]
+fn PluginHandle___call_async___before_start_returns_error() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    let (tx, _rx) = completion_channel();
+
+    let result = handle.call_async("echo", b"{}", send_completion, context_of(tx));
+
+    assert!(matches!(result, Err(PluginError::InvalidState { .. })));
+}
+
+#[test]
+fn PluginHandle___call_async___returns_unique_ids() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+
+    let id1 = handle
+        .call_async("echo", b"1", send_completion, context_of(tx))
+        .unwrap();
+    let id2 = handle
+        .call_async("echo", b"2", send_completion, context_of(tx))
+        .unwrap();
+    rx.recv_timeout(Duration::from_secs(5)).unwrap();
+    rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    assert_ne!(id1, id2);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___cancel_async___pending_request_skips_callback() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+    let request_id = handle
+        .call_async("slow", b"{}", send_completion, context_of(tx))
+        .unwrap();
+
+    let cancelled = handle.cancel_async(request_id);
+
+    assert!(cancelled);
+    assert!(rx.recv_timeout(Duration::from_millis(300)).is_err());
+    assert_eq!(handle.pending_request_count(), 0);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___cancel_async___completed_request_returns_false() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+    let request_id = handle
+        .call_async("echo", b"{}", send_completion, context_of(tx))
+        .unwrap();
+    rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    let cancelled = handle.cancel_async(request_id);
+
+    assert!(!cancelled);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___cancel_async___unknown_id_returns_false() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+
+    let cancelled = handle.cancel_async(12345);
+
+    assert!(!cancelled);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___shutdown___completes_pending_async_as_cancelled() {
+    let handle =
+        Arc::new(PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+    let request_id = handle
+        .call_async("slow", b"{}", send_completion, context_of(tx))
+        .unwrap();
+
+    handle.shutdown(1000).unwrap();
+
+    let (id, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+    assert_eq!(id, request_id);
+    assert_eq!(error_code, 9);
+    assert_eq!(handle.pending_request_count(), 0);
+}
+
+#[test]
+fn concurrency_limit___async_exceeded___returns_error() {
+    let config = PluginConfig {
+        max_concurrent_ops: 1,
+        ..Default::default()
+    };
+    let handle = Arc::new(PluginHandle::new(Box::new(TestPlugin), config).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+    handle
+        .call_async("slow", b"{}", send_completion, context_of(tx))
+        .unwrap();
+
+    let result = handle.call_async("echo", b"{}", send_completion, context_of(tx));
+
+    assert!(matches!(result, Err(PluginError::TooManyRequests)));
+    assert_eq!(handle.rejected_request_count(), 1);
+    rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+    handle.shutdown(1000).unwrap();
+}
+
 // PluginHandleManager tests
 
 #[test]
@@ -281,3 +684,97 @@ fn rejected_request_count___incremented___on_limit_exceeded() {
     assert_eq!(handle.rejected_request_count(), 5);
     handle.shutdown(1000).unwrap();
 }
+
+// Admission queue tests
+
+fn fifo_config(max_wait_ms: u64) -> PluginConfig {
+    PluginConfig {
+        max_concurrent_ops: 1,
+        admission: AdmissionConfig {
+            mode: AdmissionMode::Fifo,
+            max_wait_ms,
+            ..Default::default()
+        },
+        ..Default::default()
+    }
+}
+
+fn wait_for_in_flight(handle: &PluginHandle, count: usize) {
+    let deadline = std::time::Instant::now() + Duration::from_secs(5);
+    while handle.admission_stats().in_flight != count {
+        assert!(std::time::Instant::now() < deadline);
+        std::thread::sleep(Duration::from_millis(1));
+    }
+}
+
+#[test]
+fn PluginHandle___call___fifo_admission_waits_for_slot() {
+    let handle = Arc::new(PluginHandle::new(Box::new(TestPlugin), fifo_config(5000)).unwrap());
+    handle.start().unwrap();
+    let h1 = handle.clone();
+    let t1 = std::thread::spawn(move || h1.call("slow", b"1"));
+    wait_for_in_flight(&handle, 1);
+
+    let result = handle.call("echo", b"2");
+
+    assert_eq!(result.unwrap(), b"2");
+    assert!(t1.join().unwrap().is_ok());
+    let stats = handle.admission_stats();
+    assert_eq!(stats.queued, 1);
+    assert_eq!(stats.rejected, 0);
+    assert_eq!(stats.wait_histogram_us.iter().sum::<u64>(), 1);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call___fifo_admission_deadline_rejects() {
+    let handle = Arc::new(PluginHandle::new(Box::new(TestPlugin), fifo_config(5)).unwrap());
+    handle.start().unwrap();
+    let h1 = handle.clone();
+    let t1 = std::thread::spawn(move || h1.call("slow", b"1"));
+    wait_for_in_flight(&handle, 1);
+
+    let result = handle.call("echo", b"2");
+
+    assert!(matches!(result, Err(PluginError::TooManyRequests)));
+    assert!(t1.join().unwrap().is_ok());
+    assert_eq!(handle.rejected_request_count(), 1);
+    assert_eq!(handle.admission_stats().timed_out, 1);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___call_async___fifo_admission_queues_in_task() {
+    let handle = Arc::new(PluginHandle::new(Box::new(TestPlugin), fifo_config(5000)).unwrap());
+    handle.start().unwrap();
+    let (tx, rx) = completion_channel();
+    handle
+        .call_async("slow", b"{}", send_completion, context_of(tx))
+        .unwrap();
+
+    let queued = handle.call_async("echo", b"{}", send_completion, context_of(tx));
+
+    assert!(queued.is_ok());
+    for _ in 0..2 {
+        let (_, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+        assert_eq!(error_code, 0);
+    }
+    assert_eq!(handle.admission_stats().queued, 1);
+
+    handle.shutdown(1000).unwrap();
+}
+
+#[test]
+fn PluginHandle___admission_stats___unlimited_reports_zero_limit() {
+    let config = PluginConfig {
+        max_concurrent_ops: 0,
+        ..Default::default()
+    };
+    let handle = PluginHandle::new(Box::new(TestPlugin), config).unwrap();
+
+    let stats = handle.admission_stats();
+
+    assert_eq!(stats, AdmissionStats::default());
+}
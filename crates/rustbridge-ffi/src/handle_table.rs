@@ -0,0 +1,473 @@
+//! Generational slot table for plugin handles
+//!
+//! A handle ID packs a slot index (low 32 bits, offset by one so an ID is
+//! never 0) and the slot's generation (high 32 bits). Removing a handle bumps
+//! its slot's generation, so stale IDs are rejected even after the slot is
+//! reused.
+//!
+//! Lookups are wait-free and take no locks. A reader publishes the entry it
+//! found in one of its thread's hazard slots, then re-checks the slot. There
+//! is no shared reference count to update. Removal unlinks the entry and
+//! keeps the table's reference until no hazard slot still holds it.
+//! Register and remove are rare and serialize on a mutex.
+
+use parking_lot::Mutex;
+use std::marker::PhantomData;
+use std::ops::Deref;
+use std::ptr::{self, NonNull};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, AtomicPtr, AtomicU32, Ordering};
+
+/// Slots allocated at a time
+const SEGMENT_SIZE: usize = 64;
+
+/// Maximum number of segments, bounding the table to 65536 live handles
+const MAX_SEGMENTS: usize = 1024;
+
+/// Entries a thread can hold protected at once; nested lookups beyond this
+/// fall back to the writer lock
+const HAZARDS_PER_THREAD: usize = 4;
+
+/// One handle slot
+struct Slot<T> {
+    /// Bumped on every removal
+    generation: AtomicU32,
+    /// Entry from `Arc::into_raw`, or null when the slot is free
+    entry: AtomicPtr<T>,
+}
+
+/// Mutable table state, guarded by the writer lock
+struct Writer<T> {
+    /// Slots that have been allocated so far
+    allocated: u32,
+    /// Free slot indices, reused most recently freed first
+    free: Vec<u32>,
+    /// Removed entries that a reader may still be using
+    retired: Vec<Arc<T>>,
+    /// Number of live entries
+    live: usize,
+}
+
+/// Generational slot table with wait-free lookups
+pub struct HandleTable<T> {
+    /// Lazily allocated segments of `SEGMENT_SIZE` slots each
+    segments: Box<[AtomicPtr<Slot<T>>]>,
+    writer: Mutex<Writer<T>>,
+    /// Set while `retired` may be non-empty, so guards know to reclaim
+    retired_pending: AtomicBool,
+}
+
+impl<T> HandleTable<T> {
+    /// Create an empty table
+    pub fn new() -> Self {
+        Self {
+            segments: (0..MAX_SEGMENTS)
+                .map(|_| AtomicPtr::new(ptr::null_mut()))
+                .collect(),
+            writer: Mutex::new(Writer {
+                allocated: 0,
+                free: Vec::new(),
+                retired: Vec::new(),
+                live: 0,
+            }),
+            retired_pending: AtomicBool::new(false),
+        }
+    }
+
+    /// Insert an entry built from its ID
+    ///
+    /// Returns the new ID, or 0 if the table is full (in which case `make`
+    /// is not called).
+    pub fn insert_with(&self, make: impl FnOnce(u64) -> Arc<T>) -> u64 {
+        let mut writer = self.writer.lock();
+        let index = match writer.free.pop() {
+            Some(index) => index,
+            None => {
+                let index = writer.allocated;
+                let segment = index as usize / SEGMENT_SIZE;
+                if segment >= MAX_SEGMENTS {
+                    return 0;
+                }
+                if (index as usize).is_multiple_of(SEGMENT_SIZE) {
+                    self.allocate_segment(segment);
+                }
+                writer.allocated += 1;
+                index
+            }
+        };
+
+        let Some(slot) = self.slot(index) else {
+            return 0;
+        };
+        let id = encode_id(index, slot.generation.load(Ordering::Relaxed));
+        let entry = Arc::into_raw(make(id)) as *mut T;
+        // Release: a reader that sees the entry also sees the bumped generation
+        slot.entry.store(entry, Ordering::Release);
+        writer.live += 1;
+        id
+    }
+
+    /// Look up an entry without touching its reference count
+    ///
+    /// The returned guard keeps the entry alive until dropped, even if it is
+    /// removed from the table meanwhile.
+    pub fn get(&self, id: u64) -> Option<HandleGuard<'_, T>> {
+        let (index, generation) = decode_id(id)?;
+        let slot = self.slot(index)?;
+        match hazards::with_free_slot(|hazard| self.protect(slot, generation, hazard)) {
+            Some(result) => result,
+            // No hazard slot left on this thread (deep nesting or thread teardown)
+            None => self.get_locked(slot, generation),
+        }
+    }
+
+    /// Look up an entry and take a strong reference to it
+    pub fn get_arc(&self, id: u64) -> Option<Arc<T>> {
+        self.get(id).map(|guard| guard.to_arc())
+    }
+
+    /// Remove an entry
+    ///
+    /// Returns the table's reference to it. Lookups with this ID fail from
+    /// now on; readers that already found the entry keep it alive until their
+    /// guards drop.
+    pub fn remove(&self, id: u64) -> Option<Arc<T>> {
+        let (index, generation) = decode_id(id)?;
+        let slot = self.slot(index)?;
+
+        let removed = {
+            let mut writer = self.writer.lock();
+            if slot.generation.load(Ordering::Relaxed) != generation {
+                return None;
+            }
+            let entry = slot.entry.swap(ptr::null_mut(), Ordering::SeqCst);
+            if entry.is_null() {
+                return None;
+            }
+            let next = generation.wrapping_add(1);
+            slot.generation.store(next, Ordering::SeqCst);
+            // Retire a slot whose generation would wrap rather than risk
+            // accepting a very old ID
+            if next != u32::MAX {
+                writer.free.push(index);
+            }
+            writer.live -= 1;
+
+            // SAFETY: the entry came from Arc::into_raw in insert_with and the
+            // table's reference is handed over exactly once, here
+            let removed = unsafe { Arc::from_raw(entry as *const T) };
+            writer.retired.push(Arc::clone(&removed));
+            self.retired_pending.store(true, Ordering::SeqCst);
+            removed
+        };
+
+        self.reclaim();
+        Some(removed)
+    }
+
+    /// Number of live entries
+    pub fn len(&self) -> usize {
+        self.writer.lock().live
+    }
+
+    /// Check if the table is empty
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Release retired entries that no reader has published
+    fn reclaim(&self) {
+        let released = {
+            let mut writer = self.writer.lock();
+            let (busy, released): (Vec<_>, Vec<_>) = writer
+                .retired
+                .drain(..)
+                .partition(|entry| hazards::is_protected(Arc::as_ptr(entry) as *mut ()));
+            writer.retired = busy;
+            if writer.retired.is_empty() {
+                self.retired_pending.store(false, Ordering::SeqCst);
+            }
+            released
+        };
+        // Drop outside the lock; this may be the last reference
+        drop(released);
+    }
+
+    fn protect(
+        &self,
+        slot: &Slot<T>,
+        generation: u32,
+        hazard: &'static AtomicPtr<()>,
+    ) -> Option<HandleGuard<'_, T>> {
+        let entry = slot.entry.load(Ordering::Acquire);
+        if entry.is_null() || slot.generation.load(Ordering::Acquire) != generation {
+            return None;
+        }
+
+        hazard.store(entry as *mut (), Ordering::SeqCst);
+        // Re-check after publishing: a concurrent remove either sees the
+        // hazard when it reclaims, or we see that the entry was unlinked.
+        // The entry is read before the generation so a slot that was
+        // removed and refilled at the same address is still rejected.
+        if slot.entry.load(Ordering::SeqCst) != entry
+            || slot.generation.load(Ordering::SeqCst) != generation
+        {
+            hazard.store(ptr::null_mut(), Ordering::SeqCst);
+            if self.retired_pending.load(Ordering::SeqCst) {
+                self.reclaim();
+            }
+            return None;
+        }
+
+        Some(HandleGuard {
+            table: self,
+            entry: NonNull::new(entry)?,
+            hazard: Some(hazard),
+            _owned: None,
+            _not_send: PhantomData,
+        })
+    }
+
+    fn get_locked(&self, slot: &Slot<T>, generation: u32) -> Option<HandleGuard<'_, T>> {
+        let _writer = self.writer.lock();
+        let entry = NonNull::new(slot.entry.load(Ordering::Acquire))?;
+        if slot.generation.load(Ordering::Acquire) != generation {
+            return None;
+        }
+        // SAFETY: removal needs the writer lock, so the table's reference is alive
+        let owned = unsafe {
+            Arc::increment_strong_count(entry.as_ptr());
+            Arc::from_raw(entry.as_ptr() as *const T)
+        };
+        Some(HandleGuard {
+            table: self,
+            entry,
+            hazard: None,
+            _owned: Some(owned),
+            _not_send: PhantomData,
+        })
+    }
+
+    fn slot(&self, index: u32) -> Option<&Slot<T>> {
+        let segment = self
+            .segments
+            .get(index as usize / SEGMENT_SIZE)?
+            .load(Ordering::Acquire);
+        if segment.is_null() {
+            return None;
+        }
+        // SAFETY: segments hold SEGMENT_SIZE slots and live as long as the table
+        Some(unsafe { &*segment.add(index as usize % SEGMENT_SIZE) })
+    }
+
+    /// Allocate a segment; called with the writer lock held
+    fn allocate_segment(&self, segment: usize) {
+        let slots: Box<[Slot<T>]> = (0..SEGMENT_SIZE)
+            .map(|_| Slot {
+                generation: AtomicU32::new(1),
+                entry: AtomicPtr::new(ptr::null_mut()),
+            })
+            .collect();
+        let slots = Box::into_raw(slots) as *mut Slot<T>;
+        self.segments[segment].store(slots, Ordering::Release);
+    }
+}
+
+impl<T> Default for HandleTable<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<T> Drop for HandleTable<T> {
+    fn drop(&mut self) {
+        for segment in self.segments.iter() {
+            let segment = segment.load(Ordering::Acquire);
+            if segment.is_null() {
+                continue;
+            }
+            // SAFETY: allocated in allocate_segment with SEGMENT_SIZE slots;
+            // guards borrow the table, so none are outstanding
+            let slots =
+                unsafe { Box::from_raw(ptr::slice_from_raw_parts_mut(segment, SEGMENT_SIZE)) };
+            for slot in slots.iter() {
+                let entry = slot.entry.load(Ordering::Acquire);
+                if !entry.is_null() {
+                    // SAFETY: the table still owns this reference
+                    drop(unsafe { Arc::from_raw(entry as *const T) });
+                }
+            }
+        }
+    }
+}
+
+/// A protected reference to a table entry
+///
+/// Dereferences to the entry. Not `Send`: the protection lives in a hazard
+/// slot owned by the thread that did the lookup.
+pub struct HandleGuard<'a, T> {
+    table: &'a HandleTable<T>,
+    entry: NonNull<T>,
+    hazard: Option<&'static AtomicPtr<()>>,
+    /// Keeps the entry alive when no hazard slot was available
+    _owned: Option<Arc<T>>,
+    _not_send: PhantomData<*const ()>,
+}
+
+impl<T> HandleGuard<'_, T> {
+    /// Take a strong reference to the entry
+    pub fn to_arc(&self) -> Arc<T> {
+        // SAFETY: the entry is protected, so the table (or `owned`) still
+        // holds a strong reference
+        unsafe {
+            Arc::increment_strong_count(self.entry.as_ptr());
+            Arc::from_raw(self.entry.as_ptr() as *const T)
+        }
+    }
+}
+
+impl<T> Deref for HandleGuard<'_, T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        // SAFETY: the entry stays alive while this guard exists
+        unsafe { self.entry.as_ref() }
+    }
+}
+
+impl<T> Drop for HandleGuard<'_, T> {
+    fn drop(&mut self) {
+        if let Some(hazard) = self.hazard {
+            hazard.store(ptr::null_mut(), Ordering::SeqCst);
+            // remove() sets the flag before scanning, so if its scan saw this
+            // hazard we see the flag and finish the reclaim
+            if self.table.retired_pending.load(Ordering::SeqCst) {
+                self.table.reclaim();
+            }
+        }
+    }
+}
+
+/// Per-thread hazard slots
+mod hazards {
+    use super::HAZARDS_PER_THREAD;
+    use std::ptr;
+    use std::sync::atomic::{AtomicBool, AtomicPtr, Ordering};
+
+    /// Hazard slots owned by one thread at a time
+    ///
+    /// Records are never freed; a thread that exits releases its record for
+    /// reuse.
+    struct HazardRecord {
+        slots: [AtomicPtr<()>; HAZARDS_PER_THREAD],
+        in_use: AtomicBool,
+        next: *const HazardRecord,
+    }
+
+    // SAFETY: `next` is written once before the record is published
+    unsafe impl Sync for HazardRecord {}
+
+    static RECORDS: AtomicPtr<HazardRecord> = AtomicPtr::new(ptr::null_mut());
+
+    /// This thread's hazard record, released when the thread exits
+    struct ThreadRecord(&'static HazardRecord);
+
+    impl ThreadRecord {
+        fn acquire() -> Self {
+            let mut current = RECORDS.load(Ordering::Acquire);
+            while !current.is_null() {
+                // SAFETY: records are leaked and never freed
+                let record = unsafe { &*current };
+                if !record.in_use.load(Ordering::Relaxed)
+                    && record
+                        .in_use
+                        .compare_exchange(false, true, Ordering::Acquire, Ordering::Relaxed)
+                        .is_ok()
+                {
+                    return Self(record);
+                }
+                current = record.next as *mut HazardRecord;
+            }
+
+            let record = Box::leak(Box::new(HazardRecord {
+                slots: Default::default(),
+                in_use: AtomicBool::new(true),
+                next: ptr::null(),
+            }));
+            let mut head = RECORDS.load(Ordering::Acquire);
+            loop {
+                record.next = head;
+                match RECORDS.compare_exchange_weak(
+                    head,
+                    record,
+                    Ordering::AcqRel,
+                    Ordering::Acquire,
+                ) {
+                    Ok(_) => return Self(record),
+                    Err(actual) => head = actual,
+                }
+            }
+        }
+    }
+
+    impl Drop for ThreadRecord {
+        fn drop(&mut self) {
+            for slot in &self.0.slots {
+                slot.store(ptr::null_mut(), Ordering::Release);
+            }
+            self.0.in_use.store(false, Ordering::Release);
+        }
+    }
+
+    thread_local! {
+        static RECORD: ThreadRecord = ThreadRecord::acquire();
+    }
+
+    /// Run `f` with a free hazard slot of this thread
+    ///
+    /// Returns `None` if every slot is in use or the thread is exiting.
+    pub(super) fn with_free_slot<R>(f: impl FnOnce(&'static AtomicPtr<()>) -> R) -> Option<R> {
+        let slot = RECORD
+            .try_with(|record| {
+                record
+                    .0
+                    .slots
+                    .iter()
+                    .find(|slot| slot.load(Ordering::Relaxed).is_null())
+            })
+            .ok()
+            .flatten()?;
+        Some(f(slot))
+    }
+
+    /// Check if any thread has `entry` published
+    pub(super) fn is_protected(entry: *mut ()) -> bool {
+        let mut current = RECORDS.load(Ordering::Acquire);
+        while !current.is_null() {
+            // SAFETY: records are leaked and never freed
+            let record = unsafe { &*current };
+            if record
+                .slots
+                .iter()
+                .any(|slot| slot.load(Ordering::SeqCst) == entry)
+            {
+                return true;
+            }
+            current = record.next as *mut HazardRecord;
+        }
+        false
+    }
+}
+
+fn encode_id(index: u32, generation: u32) -> u64 {
+    (u64::from(generation) << 32) | (u64::from(index) + 1)
+}
+
+fn decode_id(id: u64) -> Option<(u32, u32)> {
+    let index = (id as u32).checked_sub(1)?;
+    Some((index, (id >> 32) as u32))
+}
+
+#[cfg(test)]
+#[path = "handle_table/handle_table_tests.rs"]
+mod handle_table_tests;
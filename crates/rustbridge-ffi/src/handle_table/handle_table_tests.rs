@@ -0,0 +1,174 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::sync::atomic::AtomicUsize;
+
+/// Counts how many values have been dropped
+struct DropCounter(Arc<AtomicUsize>);
+
+impl Drop for DropCounter {
+    fn drop(&mut self) {
+        self.0.fetch_add(1, Ordering::SeqCst);
+    }
+}
+
+fn counted() -> (Arc<AtomicUsize>, impl FnOnce(u64) -> Arc<DropCounter>) {
+    let drops = Arc::new(AtomicUsize::new(0));
+    let counter = Arc::clone(&drops);
+    (drops, move |_| Arc::new(DropCounter(counter)))
+}
+
+// ID encoding tests
+
+#[test]
+fn encode_id___roundtrip___preserves_index_and_generation() {
+    let id = encode_id(41, 7);
+
+    assert_eq!(decode_id(id), Some((41, 7)));
+}
+
+#[test]
+fn decode_id___zero___returns_none() {
+    assert_eq!(decode_id(0), None);
+    assert_eq!(decode_id(5 << 32), None);
+}
+
+// HandleTable tests
+
+#[test]
+fn HandleTable___insert_with___passes_assigned_id() {
+    let table = HandleTable::new();
+    let mut seen = 0;
+
+    let id = table.insert_with(|id| {
+        seen = id;
+        Arc::new(1u32)
+    });
+
+    assert_ne!(id, 0);
+    assert_eq!(seen, id);
+}
+
+#[test]
+fn HandleTable___get___returns_inserted_value() {
+    let table = HandleTable::new();
+    let id = table.insert_with(|_| Arc::new("value"));
+
+    let guard = table.get(id).unwrap();
+
+    assert_eq!(*guard, "value");
+}
+
+#[test]
+fn HandleTable___get___unknown_ids_return_none() {
+    let table: HandleTable<u32> = HandleTable::new();
+    table.insert_with(|_| Arc::new(1));
+
+    assert!(table.get(0).is_none());
+    assert!(table.get(encode_id(5000, 1)).is_none());
+    assert!(table.get(u64::MAX).is_none());
+}
+
+#[test]
+fn HandleTable___remove___rejects_stale_id_after_slot_reuse() {
+    let table = HandleTable::new();
+    let old_id = table.insert_with(|_| Arc::new(1u32));
+    table.remove(old_id);
+
+    let new_id = table.insert_with(|_| Arc::new(2u32));
+
+    assert_eq!(
+        decode_id(old_id).map(|d| d.0),
+        decode_id(new_id).map(|d| d.0)
+    );
+    assert_ne!(old_id, new_id);
+    assert!(table.get(old_id).is_none());
+    assert!(table.remove(old_id).is_none());
+    assert_eq!(*table.get(new_id).unwrap(), 2);
+}
+
+#[test]
+fn HandleTable___remove___twice_returns_none() {
+    let table = HandleTable::new();
+    let id = table.insert_with(|_| Arc::new(1u32));
+
+    assert!(table.remove(id).is_some());
+    assert!(table.remove(id).is_none());
+    assert!(table.is_empty());
+}
+
+#[test]
+fn HandleTable___remove_without_readers___releases_table_reference() {
+    let table = HandleTable::new();
+    let (drops, make) = counted();
+    let id = table.insert_with(make);
+
+    let removed = table.remove(id).unwrap();
+
+    assert_eq!(Arc::strong_count(&removed), 1);
+    drop(removed);
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
+
+#[test]
+fn HandleTable___remove_while_guarded___drops_after_guard() {
+    let table = HandleTable::new();
+    let (drops, make) = counted();
+    let id = table.insert_with(make);
+    let guard = table.get(id).unwrap();
+
+    drop(table.remove(id));
+
+    assert_eq!(drops.load(Ordering::SeqCst), 0);
+    drop(guard);
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
+
+#[test]
+fn HandleTable___nested_guards___fall_back_past_hazard_slots() {
+    let table = HandleTable::new();
+    let id = table.insert_with(|_| Arc::new(9u32));
+
+    let guards: Vec<_> = (0..HAZARDS_PER_THREAD + 2)
+        .map(|_| table.get(id).unwrap())
+        .collect();
+
+    assert!(guards.iter().all(|g| **g == 9));
+    assert!(guards.iter().any(|g| g._owned.is_some()));
+}
+
+#[test]
+fn HandleTable___to_arc___outlives_removal() {
+    let table = HandleTable::new();
+    let id = table.insert_with(|_| Arc::new(3u32));
+    let arc = table.get_arc(id).unwrap();
+
+    table.remove(id);
+
+    assert_eq!(*arc, 3);
+}
+
+#[test]
+fn HandleTable___many_inserts___span_segments() {
+    let table = HandleTable::new();
+
+    let ids: Vec<u64> = (0..(SEGMENT_SIZE as u32 * 3))
+        .map(|i| table.insert_with(|_| Arc::new(i)))
+        .collect();
+
+    assert_eq!(table.len(), ids.len());
+    for (i, id) in ids.iter().enumerate() {
+        assert_eq!(*table.get(*id).unwrap(), i as u32);
+    }
+}
+
+#[test]
+fn HandleTable___drop___releases_live_entries() {
+    let table = HandleTable::new();
+    let (drops, make) = counted();
+    table.insert_with(make);
+
+    drop(table);
+
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
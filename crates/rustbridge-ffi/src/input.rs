@@ -0,0 +1,145 @@
+//! Streamed requests written by the host chunk by chunk
+//!
+//! `plugin_input_open` spawns [`Plugin::handle_request_reader`] on the
+//! plugin's runtime with a [`RequestReader`] fed by a bounded channel.
+//! `plugin_input_write` blocks the host thread on that channel, so at most
+//! [`INPUT_BUFFER_CHUNKS`] chunks are queued ahead of the handler and a slow
+//! handler throttles the host. `plugin_input_finish` ends the request and
+//! waits for the handler's response.
+//!
+//! [`Plugin::handle_request_reader`]: rustbridge_core::Plugin::handle_request_reader
+//! [`RequestReader`]: rustbridge_core::RequestReader
+
+use dashmap::DashMap;
+use parking_lot::Mutex;
+use rustbridge_core::{PluginError, PluginResult, RequestSender};
+use rustbridge_runtime::AsyncBridge;
+use std::future::Future;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU64, Ordering};
+use tokio::task::{AbortHandle, JoinHandle};
+
+/// Chunks the host may write ahead of the handler
+pub const INPUT_BUFFER_CHUNKS: usize = 4;
+
+/// A request still being written by the host
+struct ActiveInput {
+    /// Dropped by `finish` to signal end-of-file
+    sender: Mutex<Option<RequestSender>>,
+    handler: Mutex<Option<JoinHandle<PluginResult<Vec<u8>>>>>,
+    abort: AbortHandle,
+}
+
+/// Requests opened on one plugin handle, keyed by input ID
+pub(crate) struct InputTable {
+    inputs: DashMap<u64, Arc<ActiveInput>>,
+    next_id: AtomicU64,
+}
+
+impl InputTable {
+    pub(crate) fn new() -> Self {
+        Self {
+            inputs: DashMap::new(),
+            next_id: AtomicU64::new(1),
+        }
+    }
+
+    /// Spawn `handler`, fed through `sender`, and return its ID (never 0)
+    pub(crate) fn open<F>(&self, bridge: &AsyncBridge, sender: RequestSender, handler: F) -> u64
+    where
+        F: Future<Output = PluginResult<Vec<u8>>> + Send + 'static,
+    {
+        let handler = bridge.spawn(handler);
+        let id = self.next_id.fetch_add(1, Ordering::Relaxed);
+        self.inputs.insert(
+            id,
+            Arc::new(ActiveInput {
+                sender: Mutex::new(Some(sender)),
+                abort: handler.abort_handle(),
+                handler: Mutex::new(Some(handler)),
+            }),
+        );
+        id
+    }
+
+    /// Queue the next chunk, blocking while the handler is behind
+    ///
+    /// The chunk is copied once into the queue. Chunks written after the
+    /// handler has stopped reading are discarded; `finish` reports its
+    /// result. Must not be called from a runtime thread.
+    pub(crate) fn write(&self, id: u64, chunk: &[u8]) -> PluginResult<()> {
+        let input = self.get(id)?;
+        if chunk.is_empty() {
+            return Ok(());
+        }
+        let sender = input.sender.lock();
+        if let Some(sender) = sender.as_ref() {
+            let _ = sender.blocking_send(chunk.to_vec());
+        }
+        Ok(())
+    }
+
+    /// End the request and wait for the handler's response
+    ///
+    /// The input is forgotten afterwards, so later calls fail with
+    /// `InvalidState`.
+    pub(crate) fn finish(&self, bridge: &AsyncBridge, id: u64) -> PluginResult<Vec<u8>> {
+        let input = self.get(id)?;
+        input.sender.lock().take();
+        let handler = input.handler.lock().take();
+        self.inputs.remove(&id);
+
+        let Some(handler) = handler else {
+            return Err(PluginError::Cancelled);
+        };
+        bridge.call_sync(async move {
+            match handler.await {
+                Ok(result) => result,
+                Err(e) if e.is_panic() => {
+                    Err(PluginError::Internal("Handler panicked".to_string()))
+                }
+                Err(_) => Err(PluginError::Cancelled),
+            }
+        })
+    }
+
+    /// Stop the handler and discard the request
+    ///
+    /// Returns `true` if the input was open.
+    pub(crate) fn abort(&self, id: u64) -> bool {
+        match self.inputs.remove(&id) {
+            Some((_, input)) => {
+                input.abort.abort();
+                true
+            }
+            None => false,
+        }
+    }
+
+    /// Stop every open input; writes blocked on them return
+    pub(crate) fn abort_all(&self) {
+        let ids: Vec<u64> = self.inputs.iter().map(|e| *e.key()).collect();
+        for id in ids {
+            self.abort(id);
+        }
+    }
+
+    /// Number of open inputs
+    pub(crate) fn len(&self) -> usize {
+        self.inputs.len()
+    }
+
+    fn get(&self, id: u64) -> PluginResult<Arc<ActiveInput>> {
+        self.inputs
+            .get(&id)
+            .map(|entry| Arc::clone(&entry))
+            .ok_or_else(|| PluginError::InvalidState {
+                expected: "open input".to_string(),
+                actual: format!("unknown input ID {}", id),
+            })
+    }
+}
+
+#[cfg(test)]
+#[path = "input/input_tests.rs"]
+mod input_tests;
@@ -0,0 +1,134 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use rustbridge_core::RequestReader;
+use rustbridge_runtime::{AsyncRuntime, RuntimeConfig};
+use std::sync::atomic::AtomicUsize;
+use std::thread;
+use std::time::Duration;
+use tokio::io::AsyncReadExt;
+
+fn bridge() -> AsyncBridge {
+    let runtime = AsyncRuntime::new(RuntimeConfig::new().with_worker_threads(1)).unwrap();
+    AsyncBridge::new(Arc::new(runtime))
+}
+
+/// Open an input whose handler returns the whole payload
+fn open_collect(table: &InputTable, bridge: &AsyncBridge) -> u64 {
+    let (sender, mut reader) = RequestReader::channel(INPUT_BUFFER_CHUNKS);
+    table.open(bridge, sender, async move {
+        let mut payload = Vec::new();
+        reader.read_to_end(&mut payload).await.unwrap();
+        Ok(payload)
+    })
+}
+
+// Write and finish tests
+
+#[test]
+fn InputTable___open___ids_start_at_one() {
+    let bridge = bridge();
+    let table = InputTable::new();
+
+    let first = open_collect(&table, &bridge);
+    let second = open_collect(&table, &bridge);
+
+    assert_eq!(first, 1);
+    assert_eq!(second, 2);
+    assert_eq!(table.len(), 2);
+}
+
+#[test]
+fn InputTable___finish___returns_handler_response_for_written_chunks() {
+    let bridge = bridge();
+    let table = InputTable::new();
+    let id = open_collect(&table, &bridge);
+
+    table.write(id, b"hello ").unwrap();
+    table.write(id, b"").unwrap();
+    table.write(id, b"world").unwrap();
+    let response = table.finish(&bridge, id).unwrap();
+
+    assert_eq!(response, b"hello world");
+    assert_eq!(table.len(), 0);
+}
+
+#[test]
+fn InputTable___write___unknown_id_is_invalid_state() {
+    let table = InputTable::new();
+
+    let result = table.write(42, b"data");
+
+    assert!(matches!(result, Err(PluginError::InvalidState { .. })));
+}
+
+#[test]
+fn InputTable___finish___handler_error_is_returned() {
+    let bridge = bridge();
+    let table = InputTable::new();
+    let (sender, _reader) = RequestReader::channel(1);
+    let id = table.open(&bridge, sender, async {
+        Err(PluginError::HandlerError("bad".to_string()))
+    });
+
+    table.write(id, b"ignored").unwrap();
+    let result = table.finish(&bridge, id);
+
+    assert!(matches!(result, Err(PluginError::HandlerError(_))));
+}
+
+#[test]
+fn InputTable___slow_handler___blocks_writer_at_buffer_limit() {
+    let bridge = bridge();
+    let table = Arc::new(InputTable::new());
+    let (sender, reader) = RequestReader::channel(INPUT_BUFFER_CHUNKS);
+    let id = table.open(&bridge, sender, async move {
+        let _reader = reader;
+        std::future::pending().await
+    });
+    let written = Arc::new(AtomicUsize::new(0));
+    let writer_table = Arc::clone(&table);
+    let writer_count = Arc::clone(&written);
+
+    let writer = thread::spawn(move || {
+        for _ in 0..INPUT_BUFFER_CHUNKS * 4 {
+            if writer_table.write(id, &[0u8; 16]).is_err() {
+                break;
+            }
+            writer_count.fetch_add(1, Ordering::SeqCst);
+        }
+    });
+    thread::sleep(Duration::from_millis(50));
+
+    assert_eq!(written.load(Ordering::SeqCst), INPUT_BUFFER_CHUNKS);
+    assert!(table.abort(id));
+    writer.join().unwrap();
+}
+
+// Abort tests
+
+#[test]
+fn InputTable___abort___forgets_input() {
+    let bridge = bridge();
+    let table = InputTable::new();
+    let id = open_collect(&table, &bridge);
+
+    assert!(table.abort(id));
+    assert!(!table.abort(id));
+    assert!(matches!(
+        table.finish(&bridge, id),
+        Err(PluginError::InvalidState { .. })
+    ));
+}
+
+#[test]
+fn InputTable___abort_all___clears_table() {
+    let bridge = bridge();
+    let table = InputTable::new();
+    open_collect(&table, &bridge);
+    open_collect(&table, &bridge);
+
+    table.abort_all();
+
+    assert_eq!(table.len(), 0);
+}
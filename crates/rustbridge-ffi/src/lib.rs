@@ -3,6 +3,8 @@
 //! This crate provides the FFI boundary layer:
 //! - [`FfiBuffer`] for passing data across FFI
 //! - [`PluginHandle`] for managing plugin instances
+//! - A per-thread buffer pool that response buffers are drawn from and freed into
+//!   (see [`configure_buffer_pool`])
 //! - C ABI exported functions (plugin_init, plugin_call, etc.)
 //!
 //! # FFI Functions
@@ -11,40 +13,95 @@
 //!
 //! - `plugin_init` - Initialize a plugin instance
 //! - `plugin_call` - Make a synchronous request to the plugin
+//! - `plugin_resolve_type_tag` / `plugin_call_id` - Resolve a type tag to a numeric ID once,
+//!   then make requests by ID
 //! - `plugin_free_buffer` - Free a buffer returned by plugin_call
 //! - `plugin_shutdown` - Shutdown a plugin instance
 //! - `plugin_set_log_level` - Set the log level for a plugin
-//! - `plugin_call_async` - Make an async request (future)
-//! - `plugin_cancel_async` - Cancel an async request (future)
+//! - `plugin_call_raw` - Make a synchronous binary request to the plugin
+//! - `plugin_call_raw_batch` - Make several binary requests in one call
+//! - `plugin_call_raw_into` - Make a binary request into a caller-provided buffer
+//! - `plugin_call_async` - Submit a non-blocking request with a completion callback
+//! - `plugin_cancel_async` - Cancel a pending async request
+//! - `plugin_ring_open` / `plugin_ring_close` - Open and close a shared-memory ring channel
+//! - `plugin_ring_notify` / `plugin_ring_wait` - Wake the ring consumer, or wait for responses
+//! - `plugin_stream_open` / `plugin_stream_next` / `plugin_stream_close` - Pull a large
+//!   response in chunks
+//! - `plugin_input_open` / `plugin_input_write` / `plugin_input_finish` / `plugin_input_abort` -
+//!   Write a large request in chunks
+//! - `plugin_get_metrics` - Per-handler call counts and latency histograms as JSON
+//! - `plugin_get_slow_calls` - Phase timelines of the latest slow calls
 
+mod binary_layout;
 mod binary_types;
 mod buffer;
 mod exports;
+mod flight_recorder;
 mod handle;
+mod handle_table;
+mod input;
+mod metrics;
 mod panic_guard;
+mod pool;
+mod registry;
+mod ring;
+mod static_errors;
+mod stream;
+mod type_ids;
 
-pub use binary_types::{RbBytes, RbBytesOwned, RbResponse, RbString, RbStringOwned};
+pub use binary_layout::{BinaryLayout, BinaryStruct};
+pub use binary_types::{
+    RbAdmissionStats, RbBatchRequest, RbBytes, RbBytesOwned, RbResponse, RbSlowCall, RbString,
+    RbStringOwned,
+};
 pub use buffer::FfiBuffer;
 pub use handle::{PluginHandle, PluginHandleManager};
+pub use handle_table::HandleGuard;
 
 // Re-export FFI functions for use by plugins
 pub use exports::{
-    BinaryMessageHandler, plugin_call, plugin_call_async, plugin_call_raw, plugin_cancel_async,
-    plugin_free_buffer, plugin_get_rejected_count, plugin_get_state, plugin_init,
-    plugin_set_log_level, plugin_shutdown, rb_response_free, register_binary_handler,
+    RB_BATCH_PARALLEL, plugin_call, plugin_call_as, plugin_call_async, plugin_call_id,
+    plugin_call_raw, plugin_call_raw_batch, plugin_call_raw_into, plugin_cancel_async,
+    plugin_free_buffer, plugin_get_admission_stats, plugin_get_dropped_log_count,
+    plugin_get_metrics, plugin_get_rejected_count, plugin_get_slow_calls, plugin_get_state,
+    plugin_init, plugin_input_abort, plugin_input_finish, plugin_input_open, plugin_input_write,
+    plugin_resolve_type_tag, plugin_ring_close, plugin_ring_notify, plugin_ring_open,
+    plugin_ring_wait, plugin_set_log_batch_callback, plugin_set_log_level, plugin_shutdown,
+    plugin_stream_close, plugin_stream_next, plugin_stream_open, rb_response_free,
+};
+pub use flight_recorder::{
+    RB_CALL_KIND_BINARY, RB_CALL_KIND_JSON, RB_SLOW_CALL_ASYNC_HANDLER, RB_SLOW_CALL_ERROR,
+    RB_SLOW_CALL_PANICKED,
+};
+pub use input::INPUT_BUFFER_CHUNKS;
+pub use metrics::{
+    HandlerKind, HandlerSnapshot, LatencySnapshot, METRICS_HISTOGRAM_BUCKETS, MetricsSnapshot,
+    bucket_lower_bound_ns,
+};
+pub use pool::{
+    PoolConfig, PoolStats, buffer_pool_config, buffer_pool_stats, configure_buffer_pool,
+};
+pub use registry::{
+    BinaryIntoHandler, BinaryMessageHandler, register_binary_handler, register_binary_into_handler,
+    register_binary_request,
+};
+pub use ring::{
+    RB_RING_DEFAULT_CAPACITY, RB_RING_MAX_CAPACITY, RB_RING_MIN_CAPACITY, RB_RING_WRAP, RbRing,
+    RbRingChannel, RbRingFrame, RingBuffer, RingChannel,
 };
+pub use stream::STREAM_BUFFER_CHUNKS;
 
 // Re-export types needed for plugin implementation
 pub use rustbridge_core::{LogLevel, Plugin, PluginConfig, PluginContext, PluginError};
 pub use rustbridge_logging::LogCallback;
-pub use rustbridge_runtime::{AsyncBridge, AsyncRuntime, RuntimeConfig};
+pub use rustbridge_runtime::{AdmissionStats, AsyncBridge, AsyncRuntime, RuntimeConfig};
 pub use rustbridge_transport::{RequestEnvelope, ResponseEnvelope};
 
 /// Prelude module for convenient imports
 pub mod prelude {
     pub use crate::{
-        FfiBuffer, PluginHandle, PluginHandleManager, RbBytes, RbBytesOwned, RbResponse, RbString,
-        RbStringOwned,
+        FfiBuffer, PluginHandle, PluginHandleManager, RbAdmissionStats, RbBatchRequest, RbBytes,
+        RbBytesOwned, RbResponse, RbRingChannel, RbRingFrame, RbString, RbStringOwned,
     };
     pub use rustbridge_core::prelude::*;
     pub use rustbridge_logging::prelude::*;
@@ -0,0 +1,471 @@
+//! Per-handler call counts and latency histograms
+//!
+//! With `metrics.enabled` set in the plugin config, every `plugin_call`,
+//! `plugin_call_id`, `plugin_call_raw`, `plugin_call_raw_batch` and
+//! [`PluginHandle::call`](crate::PluginHandle::call) is counted
+//! against its type tag or message ID, and the time it spends in each
+//! [`Phase`] is added to a histogram. `plugin_get_metrics` returns the merged
+//! counters as JSON.
+//!
+//! Counters are split into shards, and each thread writes to its own shard
+//! with relaxed atomic adds, so recording takes no locks and threads do not
+//! contend on a cache line. Reads add the shards together.
+//!
+//! Histogram buckets are log-linear: two buckets per power of two, which
+//! keeps every bucket within 50% of its lower bound.
+
+use crate::flight_recorder::{FlightRecorder, RB_SLOW_CALL_ERROR, RB_SLOW_CALL_PANICKED};
+use rustbridge_transport::DispatchTable;
+use serde::Serialize;
+use std::cell::Cell;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::time::{Duration, Instant};
+
+/// Number of buckets in each latency histogram
+///
+/// Bucket `b` starts at [`bucket_lower_bound_ns`]`(b)`. The last bucket also
+/// counts everything from about 3.2 s up.
+pub const METRICS_HISTOGRAM_BUCKETS: usize = 64;
+
+/// Most shards kept per plugin, whatever the core count
+const MAX_SHARDS: usize = 16;
+
+/// Number of shards to split per-thread state into
+pub(crate) fn shard_count() -> usize {
+    std::thread::available_parallelism()
+        .map_or(1, |n| n.get())
+        .min(MAX_SHARDS)
+}
+
+/// Part of a call a duration is attributed to
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum Phase {
+    /// Waiting for an admission slot
+    Queue,
+    /// Validating the call and finding its handler
+    Dispatch,
+    /// Running the plugin's handler
+    Handler,
+    /// Encoding the response for the host
+    Serialize,
+}
+
+/// Number of [`Phase`] variants
+pub(crate) const PHASES: usize = 4;
+
+/// What a call is counted against
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum MetricKey {
+    /// JSON call by type ID (0 = a tag the plugin does not list)
+    Json(u32),
+    /// Binary call by message ID
+    Binary(u32),
+}
+
+/// Histogram bucket for a duration
+fn bucket(nanos: u64) -> usize {
+    if nanos < 2 {
+        return nanos as usize;
+    }
+    let msb = (u64::BITS - 1 - nanos.leading_zeros()) as usize;
+    let half = ((nanos >> (msb - 1)) & 1) as usize;
+    (2 * msb + half).min(METRICS_HISTOGRAM_BUCKETS - 1)
+}
+
+/// Smallest duration, in nanoseconds, counted in bucket `b`
+pub fn bucket_lower_bound_ns(b: usize) -> u64 {
+    if b < 2 {
+        return b as u64;
+    }
+    let msb = b / 2;
+    (1u64 << msb) + (b as u64 % 2) * (1u64 << (msb - 1))
+}
+
+/// Index of the calling thread, unique within the process
+///
+/// Counters use it modulo their shard count.
+pub(crate) fn thread_shard() -> usize {
+    static NEXT: AtomicUsize = AtomicUsize::new(0);
+    thread_local! {
+        static SHARD: Cell<Option<usize>> = const { Cell::new(None) };
+    }
+    SHARD.with(|shard| match shard.get() {
+        Some(index) => index,
+        None => {
+            let index = NEXT.fetch_add(1, Ordering::Relaxed);
+            shard.set(Some(index));
+            index
+        }
+    })
+}
+
+struct Histogram {
+    sum_ns: AtomicU64,
+    buckets: [AtomicU64; METRICS_HISTOGRAM_BUCKETS],
+}
+
+/// One shard's counters for one handler
+struct Counters {
+    calls: AtomicU64,
+    errors: AtomicU64,
+    phases: [Histogram; PHASES],
+}
+
+impl Counters {
+    fn new() -> Self {
+        Self {
+            calls: AtomicU64::new(0),
+            errors: AtomicU64::new(0),
+            phases: std::array::from_fn(|_| Histogram {
+                sum_ns: AtomicU64::new(0),
+                buckets: std::array::from_fn(|_| AtomicU64::new(0)),
+            }),
+        }
+    }
+}
+
+/// Counters for every handler of one plugin
+///
+/// Slots `0..=json_tags.len()` are JSON type IDs (slot 0 collects tags the
+/// plugin does not list). The binary slots follow, with the first one
+/// collecting message IDs that have no handler.
+pub(crate) struct HandlerMetrics {
+    json_tags: Box<[&'static str]>,
+    message_ids: Box<[u32]>,
+    /// Binary slot offset (from the first binary slot) by message ID
+    binary_slots: DispatchTable<u32>,
+    shards: Box<[Box<[Counters]>]>,
+}
+
+impl HandlerMetrics {
+    /// Create counters for the given JSON type tags (in type ID order) and binary message IDs
+    pub(crate) fn new(json_tags: &[&'static str], message_ids: &[u32]) -> Self {
+        let slots = json_tags.len() + message_ids.len() + 2;
+        Self {
+            json_tags: json_tags.into(),
+            message_ids: message_ids.into(),
+            binary_slots: DispatchTable::from_entries(
+                message_ids
+                    .iter()
+                    .zip(1..)
+                    .map(|(&id, offset)| (id, offset)),
+            ),
+            shards: (0..shard_count())
+                .map(|_| (0..slots).map(|_| Counters::new()).collect())
+                .collect(),
+        }
+    }
+
+    fn slot(&self, key: MetricKey) -> usize {
+        match key {
+            MetricKey::Json(type_id) if (type_id as usize) <= self.json_tags.len() => {
+                type_id as usize
+            }
+            MetricKey::Json(_) => 0,
+            MetricKey::Binary(message_id) => {
+                self.json_tags.len() + 1 + self.binary_slots.get(message_id).unwrap_or(0) as usize
+            }
+        }
+    }
+
+    fn record(&self, key: MetricKey, phases: &[Option<u64>; PHASES], ok: bool) {
+        let shard = &self.shards[thread_shard() % self.shards.len()];
+        let counters = &shard[self.slot(key)];
+        counters.calls.fetch_add(1, Ordering::Relaxed);
+        if !ok {
+            counters.errors.fetch_add(1, Ordering::Relaxed);
+        }
+        for (histogram, nanos) in counters.phases.iter().zip(phases) {
+            if let Some(nanos) = *nanos {
+                histogram.sum_ns.fetch_add(nanos, Ordering::Relaxed);
+                histogram.buckets[bucket(nanos)].fetch_add(1, Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// Merge the shards into a snapshot of every handler that has been called
+    pub(crate) fn snapshot(&self) -> MetricsSnapshot {
+        let keys = (0..=self.json_tags.len())
+            .map(|type_id| {
+                let tag = type_id.checked_sub(1).map(|i| self.json_tags[i]);
+                (HandlerKind::Json, tag, None)
+            })
+            .chain(std::iter::once((HandlerKind::Binary, None, None)))
+            .chain(
+                self.message_ids
+                    .iter()
+                    .map(|&id| (HandlerKind::Binary, None, Some(id))),
+            );
+
+        let handlers = keys
+            .enumerate()
+            .filter_map(|(slot, (kind, type_tag, message_id))| {
+                let (calls, errors, [queue, dispatch, handler, serialize]) = self.merge(slot);
+                (calls > 0).then_some(HandlerSnapshot {
+                    kind,
+                    type_tag,
+                    message_id,
+                    calls,
+                    errors,
+                    queue,
+                    dispatch,
+                    handler,
+                    serialize,
+                })
+            })
+            .collect();
+
+        MetricsSnapshot {
+            enabled: true,
+            handlers,
+        }
+    }
+
+    /// Sum one slot's calls, errors and phase histograms across shards
+    fn merge(&self, slot: usize) -> (u64, u64, [LatencySnapshot; PHASES]) {
+        let mut calls = 0;
+        let mut errors = 0;
+        let mut sums = [0u64; PHASES];
+        let mut buckets = [[0u64; METRICS_HISTOGRAM_BUCKETS]; PHASES];
+        for shard in self.shards.iter() {
+            let counters = &shard[slot];
+            calls += counters.calls.load(Ordering::Relaxed);
+            errors += counters.errors.load(Ordering::Relaxed);
+            for (phase, histogram) in counters.phases.iter().enumerate() {
+                sums[phase] += histogram.sum_ns.load(Ordering::Relaxed);
+                for (total, count) in buckets[phase].iter_mut().zip(&histogram.buckets) {
+                    *total += count.load(Ordering::Relaxed);
+                }
+            }
+        }
+        let phases =
+            std::array::from_fn(|phase| LatencySnapshot::new(sums[phase], &buckets[phase]));
+        (calls, errors, phases)
+    }
+}
+
+/// Times the phases of one call and hands them to the metrics and the
+/// flight recorder when it finishes
+///
+/// Does nothing, and never reads the clock, when both are off. A timer that
+/// is dropped while its thread panics records the call as panicked.
+pub(crate) struct CallTimer<'a> {
+    active: Option<ActiveTimer<'a>>,
+}
+
+struct ActiveTimer<'a> {
+    metrics: Option<&'a HandlerMetrics>,
+    recorder: Option<&'a FlightRecorder>,
+    key: Option<MetricKey>,
+    start: Instant,
+    mark: Instant,
+    phases: [Option<u64>; PHASES],
+    flags: u32,
+}
+
+impl<'a> CallTimer<'a> {
+    /// Start timing a call, if metrics or the flight recorder are enabled
+    #[inline]
+    pub(crate) fn start(
+        metrics: Option<&'a HandlerMetrics>,
+        recorder: Option<&'a FlightRecorder>,
+    ) -> Self {
+        if metrics.is_none() && recorder.is_none() {
+            return Self::off();
+        }
+        let now = Instant::now();
+        Self {
+            active: Some(ActiveTimer {
+                metrics,
+                recorder,
+                key: None,
+                start: now,
+                mark: now,
+                phases: [None; PHASES],
+                flags: 0,
+            }),
+        }
+    }
+
+    /// A timer that records nothing
+    pub(crate) fn off() -> Self {
+        Self { active: None }
+    }
+
+    /// Set what the call is counted against
+    ///
+    /// `key` is only evaluated when the timer is active. Calls that end
+    /// before a key is set are not recorded.
+    #[inline]
+    pub(crate) fn key(&mut self, key: impl FnOnce() -> MetricKey) {
+        if let Some(active) = &mut self.active {
+            active.key = Some(key());
+        }
+    }
+
+    /// Attribute the time since the previous lap (or the start) to `phase`
+    #[inline]
+    pub(crate) fn lap(&mut self, phase: Phase) {
+        if let Some(active) = &mut self.active {
+            let now = Instant::now();
+            active.phases[phase as usize] = Some(duration_ns(now - active.mark));
+            active.mark = now;
+        }
+    }
+
+    /// Mark the call with `RB_SLOW_CALL_*` flags for the flight recorder
+    #[inline]
+    pub(crate) fn flag(&mut self, flags: u32) {
+        if let Some(active) = &mut self.active {
+            active.flags |= flags;
+        }
+    }
+
+    /// Record the finished call
+    #[inline]
+    pub(crate) fn finish(mut self, ok: bool) {
+        if let Some(active) = self.active.take() {
+            active.record(ok);
+        }
+    }
+}
+
+impl Drop for CallTimer<'_> {
+    fn drop(&mut self) {
+        if let Some(mut active) = self.active.take()
+            && std::thread::panicking()
+        {
+            active.flags |= RB_SLOW_CALL_PANICKED;
+            active.record(false);
+        }
+    }
+}
+
+impl ActiveTimer<'_> {
+    fn record(self, ok: bool) {
+        let Some(key) = self.key else {
+            return;
+        };
+        if let Some(metrics) = self.metrics {
+            metrics.record(key, &self.phases, ok);
+        }
+        if let Some(recorder) = self.recorder {
+            let flags = if ok {
+                self.flags
+            } else {
+                self.flags | RB_SLOW_CALL_ERROR
+            };
+            recorder.record(key, self.start, &self.phases, flags);
+        }
+    }
+}
+
+/// Convert a duration to whole nanoseconds, saturating
+pub(crate) fn duration_ns(duration: Duration) -> u64 {
+    u64::try_from(duration.as_nanos()).unwrap_or(u64::MAX)
+}
+
+/// Kind of call a handler serves
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize)]
+#[serde(rename_all = "snake_case")]
+pub enum HandlerKind {
+    /// `plugin_call` / `plugin_call_id`
+    Json,
+    /// `plugin_call_raw` / `plugin_call_raw_batch`
+    Binary,
+}
+
+/// Merged metrics returned by `plugin_get_metrics`
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize)]
+pub struct MetricsSnapshot {
+    /// Whether the plugin was started with `metrics.enabled`
+    pub enabled: bool,
+    /// Handlers that have been called at least once
+    pub handlers: Vec<HandlerSnapshot>,
+}
+
+/// Counters for one type tag or message ID
+///
+/// A JSON entry without a `type_tag` collects tags the plugin does not list
+/// in `supported_types`; a binary entry without a `message_id` collects IDs
+/// with no registered handler.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize)]
+pub struct HandlerSnapshot {
+    /// Whether this is a JSON or a binary handler
+    pub kind: HandlerKind,
+    /// Type tag of a JSON handler
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub type_tag: Option<&'static str>,
+    /// Message ID of a binary handler
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub message_id: Option<u32>,
+    /// Calls made, including failed ones
+    pub calls: u64,
+    /// Calls that returned an error
+    pub errors: u64,
+    /// Time spent waiting for an admission slot (JSON calls only)
+    pub queue: LatencySnapshot,
+    /// Time spent validating the call and finding the handler
+    pub dispatch: LatencySnapshot,
+    /// Time spent in the plugin's handler
+    pub handler: LatencySnapshot,
+    /// Time spent encoding the response
+    pub serialize: LatencySnapshot,
+}
+
+/// Latency distribution of one phase
+///
+/// Percentiles are reported as the upper bound of the bucket they fall in.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize)]
+pub struct LatencySnapshot {
+    /// Number of recorded durations
+    pub count: u64,
+    /// Sum of all recorded durations
+    pub sum_ns: u64,
+    /// Median
+    pub p50_ns: u64,
+    /// 90th percentile
+    pub p90_ns: u64,
+    /// 99th percentile
+    pub p99_ns: u64,
+    /// Non-empty buckets as `[lower_bound_ns, count]`
+    pub buckets: Vec<(u64, u64)>,
+}
+
+impl LatencySnapshot {
+    fn new(sum_ns: u64, buckets: &[u64; METRICS_HISTOGRAM_BUCKETS]) -> Self {
+        let count = buckets.iter().sum();
+        if count == 0 {
+            return Self::default();
+        }
+        let percentile = |p: u64| {
+            // Rank of the percentile, rounded up so p99 of one sample is that sample
+            let rank = (count * p).div_ceil(100).max(1);
+            let mut seen = 0;
+            for (b, &n) in buckets.iter().enumerate() {
+                seen += n;
+                if seen >= rank {
+                    return bucket_lower_bound_ns(b + 1).saturating_sub(1);
+                }
+            }
+            0
+        };
+        Self {
+            count,
+            sum_ns,
+            p50_ns: percentile(50),
+            p90_ns: percentile(90),
+            p99_ns: percentile(99),
+            buckets: buckets
+                .iter()
+                .enumerate()
+                .filter(|(_, n)| **n > 0)
+                .map(|(b, &n)| (bucket_lower_bound_ns(b), n))
+                .collect(),
+        }
+    }
+}
+
+#[cfg(test)]
+#[path = "metrics/metrics_tests.rs"]
+mod metrics_tests;
@@ -0,0 +1,200 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::sync::Arc;
+
+fn record(metrics: &HandlerMetrics, key: MetricKey, ok: bool) {
+    let mut timer = CallTimer::start(Some(metrics), None);
+    timer.key(|| key);
+    timer.lap(Phase::Dispatch);
+    timer.lap(Phase::Handler);
+    timer.finish(ok);
+}
+
+#[test]
+fn bucket___small_values___get_their_own_bucket() {
+    assert_eq!(bucket(0), 0);
+    assert_eq!(bucket(1), 1);
+    assert_eq!(bucket(2), 2);
+    assert_eq!(bucket(3), 3);
+}
+
+#[test]
+fn bucket___splits_each_power_of_two_in_half() {
+    assert_eq!(bucket(4), 4);
+    assert_eq!(bucket(5), 4);
+    assert_eq!(bucket(6), 5);
+    assert_eq!(bucket(7), 5);
+    assert_eq!(bucket(1024), 20);
+    assert_eq!(bucket(1535), 20);
+    assert_eq!(bucket(1536), 21);
+}
+
+#[test]
+fn bucket___huge_values___land_in_last_bucket() {
+    assert_eq!(bucket(u64::MAX), METRICS_HISTOGRAM_BUCKETS - 1);
+}
+
+#[test]
+fn bucket_lower_bound_ns___matches_bucket() {
+    for b in 0..METRICS_HISTOGRAM_BUCKETS {
+        let lower = bucket_lower_bound_ns(b);
+        assert_eq!(bucket(lower), b);
+        if b > 0 {
+            assert_eq!(bucket(lower - 1), b - 1);
+        }
+    }
+}
+
+#[test]
+fn HandlerMetrics___snapshot___omits_handlers_never_called() {
+    let metrics = HandlerMetrics::new(&["echo", "add"], &[7]);
+
+    record(&metrics, MetricKey::Json(2), true);
+
+    let snapshot = metrics.snapshot();
+    assert!(snapshot.enabled);
+    assert_eq!(snapshot.handlers.len(), 1);
+    assert_eq!(snapshot.handlers[0].kind, HandlerKind::Json);
+    assert_eq!(snapshot.handlers[0].type_tag, Some("add"));
+}
+
+#[test]
+fn HandlerMetrics___record___counts_calls_and_errors_per_key() {
+    let metrics = HandlerMetrics::new(&["echo"], &[7, 9]);
+
+    record(&metrics, MetricKey::Binary(9), true);
+    record(&metrics, MetricKey::Binary(9), false);
+    record(&metrics, MetricKey::Binary(7), true);
+
+    let snapshot = metrics.snapshot();
+    let nine = snapshot
+        .handlers
+        .iter()
+        .find(|h| h.message_id == Some(9))
+        .unwrap();
+    assert_eq!(nine.kind, HandlerKind::Binary);
+    assert_eq!(nine.calls, 2);
+    assert_eq!(nine.errors, 1);
+}
+
+#[test]
+fn HandlerMetrics___record___unknown_keys_share_a_catch_all_entry() {
+    let metrics = HandlerMetrics::new(&["echo"], &[7]);
+
+    record(&metrics, MetricKey::Json(0), true);
+    record(&metrics, MetricKey::Json(42), true);
+    record(&metrics, MetricKey::Binary(99), true);
+
+    let snapshot = metrics.snapshot();
+    assert_eq!(snapshot.handlers.len(), 2);
+    assert!(snapshot.handlers.iter().all(|h| h.type_tag.is_none()));
+    assert!(snapshot.handlers.iter().all(|h| h.message_id.is_none()));
+    assert_eq!(snapshot.handlers[0].kind, HandlerKind::Json);
+    assert_eq!(snapshot.handlers[0].calls, 2);
+    assert_eq!(snapshot.handlers[1].kind, HandlerKind::Binary);
+}
+
+#[test]
+fn HandlerMetrics___record___only_lapped_phases_are_counted() {
+    let metrics = HandlerMetrics::new(&["echo"], &[]);
+
+    record(&metrics, MetricKey::Json(1), true);
+
+    let handler = &metrics.snapshot().handlers[0];
+    assert_eq!(handler.queue.count, 0);
+    assert_eq!(handler.dispatch.count, 1);
+    assert_eq!(handler.handler.count, 1);
+    assert_eq!(handler.serialize.count, 0);
+}
+
+#[test]
+fn HandlerMetrics___snapshot___merges_shards_from_many_threads() {
+    let metrics = Arc::new(HandlerMetrics::new(&["echo"], &[]));
+
+    let threads: Vec<_> = (0..8)
+        .map(|_| {
+            let metrics = metrics.clone();
+            std::thread::spawn(move || {
+                for _ in 0..100 {
+                    record(&metrics, MetricKey::Json(1), true);
+                }
+            })
+        })
+        .collect();
+    for thread in threads {
+        thread.join().unwrap();
+    }
+
+    let handler = &metrics.snapshot().handlers[0];
+    assert_eq!(handler.calls, 800);
+    assert_eq!(handler.handler.count, 800);
+}
+
+#[test]
+fn CallTimer___off___records_nothing() {
+    let mut timer = CallTimer::off();
+    timer.key(|| unreachable!("key is not evaluated when the timer is off"));
+    timer.lap(Phase::Handler);
+
+    timer.finish(true);
+}
+
+#[test]
+fn CallTimer___no_key___records_nothing() {
+    let metrics = HandlerMetrics::new(&["echo"], &[]);
+
+    let mut timer = CallTimer::start(Some(&metrics), None);
+    timer.lap(Phase::Handler);
+    timer.finish(true);
+
+    assert!(metrics.snapshot().handlers.is_empty());
+}
+
+#[test]
+fn CallTimer___dropped_while_panicking___counts_an_error() {
+    let metrics = HandlerMetrics::new(&["echo"], &[]);
+
+    let result = std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| {
+        let mut timer = CallTimer::start(Some(&metrics), None);
+        timer.key(|| MetricKey::Json(1));
+        panic!("handler failed");
+    }));
+
+    assert!(result.is_err());
+    let handler = &metrics.snapshot().handlers[0];
+    assert_eq!(handler.calls, 1);
+    assert_eq!(handler.errors, 1);
+}
+
+#[test]
+fn CallTimer___dropped_without_finish___records_nothing() {
+    let metrics = HandlerMetrics::new(&["echo"], &[]);
+
+    let mut timer = CallTimer::start(Some(&metrics), None);
+    timer.key(|| MetricKey::Json(1));
+    drop(timer);
+
+    assert!(metrics.snapshot().handlers.is_empty());
+}
+
+#[test]
+fn LatencySnapshot___new___reports_bucket_upper_bounds_as_percentiles() {
+    let mut buckets = [0u64; METRICS_HISTOGRAM_BUCKETS];
+    buckets[bucket(100)] = 99;
+    buckets[bucket(10_000)] = 1;
+
+    let latency = LatencySnapshot::new(19_900, &buckets);
+
+    assert_eq!(latency.count, 100);
+    assert_eq!(latency.p50_ns, 127);
+    assert_eq!(latency.p99_ns, 127);
+    assert_eq!(latency.buckets, vec![(96, 99), (8192, 1)]);
+}
+
+#[test]
+fn LatencySnapshot___new___empty_histogram_is_all_zero() {
+    let latency = LatencySnapshot::new(0, &[0; METRICS_HISTOGRAM_BUCKETS]);
+
+    assert_eq!(latency, LatencySnapshot::default());
+}
@@ -44,13 +44,18 @@ where
     panic::catch_unwind(f).map_err(|panic_info| {
         let panic_msg = panic_to_string(&panic_info);
 
+        // Log through the plugin's own callback when the handle is valid
+        let handle = match handle_id {
+            0 => None,
+            id => PluginHandleManager::global().lookup(id),
+        };
+        let _log = handle.as_ref().map(|h| h.logger().enter());
+
         // Log the panic
         tracing::error!("FFI panic caught: {}", panic_msg);
 
         // Mark plugin as failed if we have a valid handle
-        if handle_id != 0
-            && let Some(h) = PluginHandleManager::global().get(handle_id)
-        {
+        if let Some(h) = &handle {
             h.mark_failed();
             tracing::warn!("Plugin handle {} marked as failed due to panic", handle_id);
         }
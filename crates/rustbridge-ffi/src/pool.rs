@@ -0,0 +1,228 @@
+//! Per-thread pool of response buffers
+//!
+//! [`FfiBuffer`], [`RbBytesOwned`] and [`RbResponse`] hand Rust-allocated
+//! bytes to the host, which gives them back through the matching free
+//! function. Rather than return that memory to the global allocator, the
+//! free functions park it in a cache on the freeing thread, and the next
+//! response built on that thread reuses it. A steady stream of calls then
+//! allocates nothing once the caches are warm.
+//!
+//! Buffers are cached in power-of-two size classes from [`POOL_MIN_CLASS`]
+//! to [`POOL_MAX_CLASS`] bytes. A buffer is filed under the largest class
+//! its capacity covers, and [`take`] hands out buffers from the smallest
+//! class that fits the request, so a pooled buffer never has to grow while
+//! it is filled. Buffers outside the pooled range, and buffers freed while a
+//! class is at its cap, go back to the allocator.
+//!
+//! Every pooled buffer is an ordinary `Vec<u8>` allocation, so memory from
+//! the pool can still be released with `Vec::from_raw_parts` and memory from
+//! elsewhere can be recycled into it.
+//!
+//! [`FfiBuffer`]: crate::FfiBuffer
+//! [`RbBytesOwned`]: crate::RbBytesOwned
+//! [`RbResponse`]: crate::RbResponse
+
+use std::cell::RefCell;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+
+/// Smallest pooled buffer capacity in bytes
+pub const POOL_MIN_CLASS: usize = 64;
+
+/// Largest pooled buffer capacity in bytes
+pub const POOL_MAX_CLASS: usize = 64 * 1024;
+
+/// Number of size classes between `POOL_MIN_CLASS` and `POOL_MAX_CLASS`
+const CLASS_COUNT: usize =
+    (POOL_MAX_CLASS.trailing_zeros() - POOL_MIN_CLASS.trailing_zeros()) as usize + 1;
+
+/// Initial capacity for formatted messages, enough for typical error text
+const FORMAT_CAPACITY: usize = 128;
+
+/// Default for [`PoolConfig::max_cached_per_class`]
+const DEFAULT_MAX_CACHED_PER_CLASS: usize = 32;
+
+/// Limits on how much memory the pool keeps cached
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct PoolConfig {
+    /// Buffers each thread keeps per size class (0 disables pooling)
+    pub max_cached_per_class: usize,
+    /// Largest buffer capacity worth keeping
+    ///
+    /// Rounded down to a size class and clamped to `POOL_MAX_CLASS`.
+    pub max_buffer_size: usize,
+}
+
+impl Default for PoolConfig {
+    fn default() -> Self {
+        Self {
+            max_cached_per_class: DEFAULT_MAX_CACHED_PER_CLASS,
+            max_buffer_size: POOL_MAX_CLASS,
+        }
+    }
+}
+
+/// Point-in-time pool counters, summed over all threads
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct PoolStats {
+    /// Buffers handed out from a thread cache
+    pub hits: u64,
+    /// Buffers that had to be allocated
+    pub misses: u64,
+    /// Freed buffers kept for reuse
+    pub recycled: u64,
+    /// Freed buffers returned to the allocator
+    pub released: u64,
+}
+
+static MAX_CACHED_PER_CLASS: AtomicUsize = AtomicUsize::new(DEFAULT_MAX_CACHED_PER_CLASS);
+static MAX_BUFFER_SIZE: AtomicUsize = AtomicUsize::new(POOL_MAX_CLASS);
+
+static HITS: AtomicU64 = AtomicU64::new(0);
+static MISSES: AtomicU64 = AtomicU64::new(0);
+static RECYCLED: AtomicU64 = AtomicU64::new(0);
+static RELEASED: AtomicU64 = AtomicU64::new(0);
+
+thread_local! {
+    /// Cached buffers of this thread, indexed by size class
+    static CACHE: RefCell<[Vec<Vec<u8>>; CLASS_COUNT]> =
+        const { RefCell::new([const { Vec::new() }; CLASS_COUNT]) };
+}
+
+/// Set the pool limits for every thread
+///
+/// Caches already holding more than the new cap shrink as they are used;
+/// buffers over the new size limit are released the next time they are
+/// taken and freed.
+pub fn configure_buffer_pool(config: PoolConfig) {
+    MAX_CACHED_PER_CLASS.store(config.max_cached_per_class, Ordering::Relaxed);
+    MAX_BUFFER_SIZE.store(size_limit(config.max_buffer_size), Ordering::Relaxed);
+}
+
+/// Current pool limits
+pub fn buffer_pool_config() -> PoolConfig {
+    PoolConfig {
+        max_cached_per_class: MAX_CACHED_PER_CLASS.load(Ordering::Relaxed),
+        max_buffer_size: MAX_BUFFER_SIZE.load(Ordering::Relaxed),
+    }
+}
+
+/// Snapshot of the pool counters
+pub fn buffer_pool_stats() -> PoolStats {
+    PoolStats {
+        hits: HITS.load(Ordering::Relaxed),
+        misses: MISSES.load(Ordering::Relaxed),
+        recycled: RECYCLED.load(Ordering::Relaxed),
+        released: RELEASED.load(Ordering::Relaxed),
+    }
+}
+
+/// Get an empty buffer with capacity for at least `len` bytes
+///
+/// Requests of 0 bytes and requests over the size limit bypass the pool.
+pub(crate) fn take(len: usize) -> Vec<u8> {
+    if len == 0 || len > MAX_BUFFER_SIZE.load(Ordering::Relaxed) {
+        return Vec::with_capacity(len);
+    }
+    let class = class_fitting(len);
+    let cached = CACHE
+        .try_with(|cache| cache.borrow_mut()[class].pop())
+        .ok()
+        .flatten();
+    match cached {
+        Some(buffer) => {
+            HITS.fetch_add(1, Ordering::Relaxed);
+            buffer
+        }
+        None => {
+            MISSES.fetch_add(1, Ordering::Relaxed);
+            Vec::with_capacity(class_size(class))
+        }
+    }
+}
+
+/// Get a buffer holding a copy of `bytes`
+pub(crate) fn take_copy(bytes: &[u8]) -> Vec<u8> {
+    let mut buffer = take(bytes.len());
+    buffer.extend_from_slice(bytes);
+    buffer
+}
+
+/// Get a buffer holding `args` formatted
+pub(crate) fn write_fmt(args: std::fmt::Arguments<'_>) -> Vec<u8> {
+    use std::io::Write;
+
+    let mut buffer = take(args.as_str().map_or(FORMAT_CAPACITY, str::len));
+    // Writing to a Vec cannot fail
+    let _ = buffer.write_fmt(args);
+    buffer
+}
+
+/// Give a buffer back to this thread's cache, or to the allocator
+pub(crate) fn recycle(mut buffer: Vec<u8>) {
+    let capacity = buffer.capacity();
+    if capacity < POOL_MIN_CLASS || capacity > MAX_BUFFER_SIZE.load(Ordering::Relaxed) {
+        if capacity > 0 {
+            RELEASED.fetch_add(1, Ordering::Relaxed);
+        }
+        return;
+    }
+    let max_cached = MAX_CACHED_PER_CLASS.load(Ordering::Relaxed);
+    buffer.clear();
+    // The cache is gone while the thread exits; the buffer is then dropped
+    let kept = CACHE
+        .try_with(|cache| {
+            let mut cache = cache.borrow_mut();
+            let class = &mut cache[class_covered(capacity)];
+            if class.len() < max_cached {
+                class.push(buffer);
+                true
+            } else {
+                false
+            }
+        })
+        .unwrap_or(false);
+    if kept {
+        RECYCLED.fetch_add(1, Ordering::Relaxed);
+    } else {
+        RELEASED.fetch_add(1, Ordering::Relaxed);
+    }
+}
+
+/// Reassemble a buffer handed out as raw parts and recycle it
+///
+/// # Safety
+///
+/// `data`, `len` and `capacity` must come from a `Vec<u8>` that was leaked
+/// and not freed since.
+pub(crate) unsafe fn recycle_raw(data: *mut u8, len: usize, capacity: usize) {
+    recycle(unsafe { Vec::from_raw_parts(data, len, capacity) });
+}
+
+/// Round a configured size limit down to a class size, or 0 if below every class
+fn size_limit(max_buffer_size: usize) -> usize {
+    match max_buffer_size.min(POOL_MAX_CLASS) {
+        size if size < POOL_MIN_CLASS => 0,
+        size => 1 << size.ilog2(),
+    }
+}
+
+/// Capacity of the buffers in `class`
+fn class_size(class: usize) -> usize {
+    POOL_MIN_CLASS << class
+}
+
+/// Smallest class whose buffers hold `len` bytes (`len <= POOL_MAX_CLASS`)
+fn class_fitting(len: usize) -> usize {
+    let size = len.max(POOL_MIN_CLASS).next_power_of_two();
+    (size.trailing_zeros() - POOL_MIN_CLASS.trailing_zeros()) as usize
+}
+
+/// Largest class a buffer of `capacity` bytes can serve
+/// (`POOL_MIN_CLASS <= capacity <= POOL_MAX_CLASS`)
+fn class_covered(capacity: usize) -> usize {
+    (capacity.ilog2() - POOL_MIN_CLASS.ilog2()) as usize
+}
+
+#[cfg(test)]
+#[path = "pool/pool_tests.rs"]
+mod pool_tests;
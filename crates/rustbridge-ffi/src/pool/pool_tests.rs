@@ -0,0 +1,155 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+// Each test runs on its own thread, so its cache starts empty and is not
+// shared. The counters are process-wide and only checked for growth.
+
+#[test]
+fn take___empty_cache___allocates_class_capacity() {
+    let buffer = take(100);
+
+    assert!(buffer.is_empty());
+    assert_eq!(buffer.capacity(), 128);
+}
+
+#[test]
+fn take___below_smallest_class___rounds_up_to_smallest_class() {
+    let buffer = take(1);
+
+    assert_eq!(buffer.capacity(), POOL_MIN_CLASS);
+}
+
+#[test]
+fn take___zero_length___bypasses_pool() {
+    let buffer = take(0);
+
+    assert_eq!(buffer.capacity(), 0);
+}
+
+#[test]
+fn take___over_largest_class___allocates_exact_capacity() {
+    let buffer = take(POOL_MAX_CLASS + 1);
+
+    assert!(buffer.capacity() > POOL_MAX_CLASS);
+    assert!(buffer.capacity() < POOL_MAX_CLASS * 2);
+}
+
+#[test]
+fn take___after_recycle___reuses_buffer() {
+    let buffer = take(200);
+    let ptr = buffer.as_ptr();
+    recycle(buffer);
+
+    let reused = take(200);
+
+    assert_eq!(reused.as_ptr(), ptr);
+}
+
+#[test]
+fn take___after_recycle___returns_cleared_buffer() {
+    let mut buffer = take(10);
+    buffer.extend_from_slice(b"stale data");
+    recycle(buffer);
+
+    let reused = take(10);
+
+    assert!(reused.is_empty());
+}
+
+#[test]
+fn take___smaller_request___does_not_reuse_larger_class() {
+    let buffer = take(4096);
+    let ptr = buffer.as_ptr();
+    recycle(buffer);
+
+    let small = take(64);
+
+    assert_ne!(small.as_ptr(), ptr);
+}
+
+#[test]
+fn take_copy___copies_bytes() {
+    let buffer = take_copy(b"hello");
+
+    assert_eq!(buffer, b"hello");
+    assert_eq!(buffer.capacity(), POOL_MIN_CLASS);
+}
+
+#[test]
+fn recycle___foreign_capacity___files_under_covered_class() {
+    let buffer: Vec<u8> = Vec::with_capacity(300);
+    let ptr = buffer.as_ptr();
+    recycle(buffer);
+
+    let reused = take(256);
+
+    assert_eq!(reused.as_ptr(), ptr);
+    assert!(reused.capacity() >= 256);
+}
+
+#[test]
+fn recycle___class_at_cap___releases_buffer() {
+    let max_cached = buffer_pool_config().max_cached_per_class;
+    let buffers: Vec<Vec<u8>> = (0..=max_cached).map(|_| take(512)).collect();
+    let released_before = buffer_pool_stats().released;
+
+    for buffer in buffers {
+        recycle(buffer);
+    }
+
+    assert!(buffer_pool_stats().released > released_before);
+    let cached = CACHE.with(|cache| cache.borrow()[class_fitting(512)].len());
+    assert_eq!(cached, max_cached);
+}
+
+#[test]
+fn recycle___then_take___counts_recycle_and_hit() {
+    let before = buffer_pool_stats();
+    let buffer = take(1000);
+
+    recycle(buffer);
+    let _buffer = take(1000);
+
+    let after = buffer_pool_stats();
+    assert!(after.misses > before.misses);
+    assert!(after.recycled > before.recycled);
+    assert!(after.hits > before.hits);
+}
+
+#[test]
+fn class_fitting___boundaries___returns_smallest_fitting_class() {
+    assert_eq!(class_fitting(1), 0);
+    assert_eq!(class_fitting(POOL_MIN_CLASS), 0);
+    assert_eq!(class_fitting(POOL_MIN_CLASS + 1), 1);
+    assert_eq!(class_fitting(POOL_MAX_CLASS), CLASS_COUNT - 1);
+}
+
+#[test]
+fn class_covered___boundaries___returns_largest_covered_class() {
+    assert_eq!(class_covered(POOL_MIN_CLASS), 0);
+    assert_eq!(class_covered(POOL_MIN_CLASS * 2 - 1), 0);
+    assert_eq!(class_covered(POOL_MIN_CLASS * 2), 1);
+    assert_eq!(class_covered(POOL_MAX_CLASS), CLASS_COUNT - 1);
+}
+
+#[test]
+fn size_limit___rounds_down_to_class() {
+    assert_eq!(size_limit(1000), 512);
+    assert_eq!(size_limit(4096), 4096);
+    assert_eq!(size_limit(POOL_MAX_CLASS * 4), POOL_MAX_CLASS);
+}
+
+#[test]
+fn size_limit___below_smallest_class___disables_pooling() {
+    assert_eq!(size_limit(POOL_MIN_CLASS - 1), 0);
+    assert_eq!(size_limit(0), 0);
+}
+
+#[test]
+fn PoolConfig___default___pools_every_class() {
+    let config = PoolConfig::default();
+
+    assert_eq!(config.max_buffer_size, POOL_MAX_CLASS);
+    assert!(config.max_cached_per_class > 0);
+}
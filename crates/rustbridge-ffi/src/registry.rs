@@ -0,0 +1,183 @@
+//! Binary message handler registration
+//!
+//! Handlers registered while a plugin's `on_start` runs belong to that plugin.
+//! Before the plugin becomes `Active` they are frozen into a [`DispatchTable`]
+//! owned by its [`PluginHandle`], so binary calls look up handlers without
+//! locking and two plugins in one process can use the same message IDs.
+//!
+//! Handlers registered at any other time go into a process-wide default
+//! registry, which each plugin copies when it starts. Shutting a plugin down
+//! drops its table but leaves the defaults in place for other plugins.
+
+use crate::binary_layout::{BinaryLayout, BinaryStruct};
+use crate::handle::PluginHandle;
+use once_cell::sync::OnceCell;
+use parking_lot::Mutex;
+use rustbridge_core::PluginError;
+use rustbridge_transport::DispatchTable;
+use std::cell::RefCell;
+use std::collections::HashMap;
+
+/// Handler function type for binary message processing
+///
+/// Plugins that want to support binary transport must register handlers
+/// using this signature. The handler receives the request struct as raw bytes
+/// and must return response bytes (which will be wrapped in RbResponse).
+pub type BinaryMessageHandler =
+    fn(handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, PluginError>;
+
+/// Handler function type for binary messages that write into a caller buffer
+///
+/// The handler writes its response into `out` and returns the number of bytes
+/// written. If `out` is too small it should return
+/// `PluginError::InsufficientCapacity` with the size it needs.
+pub type BinaryIntoHandler =
+    fn(handle: &PluginHandle, request: &[u8], out: &mut [u8]) -> Result<usize, PluginError>;
+
+/// Handlers registered for one binary message ID
+#[derive(Clone, Copy, Default)]
+pub(crate) struct BinaryHandlers {
+    /// Used by plugin_call_raw and plugin_call_raw_batch
+    pub(crate) raw: Option<BinaryMessageHandler>,
+    /// Used by plugin_call_raw_into
+    pub(crate) into: Option<BinaryIntoHandler>,
+    /// Checked before either handler runs
+    pub(crate) layout: Option<&'static BinaryLayout>,
+}
+
+impl BinaryHandlers {
+    /// Overlay the handlers set in `other`
+    fn merge(&mut self, other: BinaryHandlers) {
+        if other.raw.is_some() {
+            self.raw = other.raw;
+        }
+        if other.into.is_some() {
+            self.into = other.into;
+        }
+        if other.layout.is_some() {
+            self.layout = other.layout;
+        }
+    }
+
+    /// Check a request against the registered layout, if any
+    ///
+    /// # Safety
+    ///
+    /// Pointers in the request's `RbString` and `RbBytes` fields must be
+    /// valid, as the binary call functions require of their callers.
+    pub(crate) unsafe fn check(&self, request: &[u8]) -> Result<(), PluginError> {
+        match self.layout {
+            // SAFETY: the layout came from a BinaryStruct impl, and the caller
+            // vouches for the pointers
+            Some(layout) => unsafe { layout.check(request) },
+            None => Ok(()),
+        }
+    }
+}
+
+/// Frozen binary handler table owned by a plugin handle
+pub(crate) type BinaryDispatchTable = DispatchTable<BinaryHandlers>;
+
+/// Handlers collected before they are frozen into a table
+#[derive(Default)]
+pub(crate) struct BinaryRegistry {
+    handlers: HashMap<u32, BinaryHandlers>,
+}
+
+impl BinaryRegistry {
+    fn entry(&mut self, message_id: u32) -> &mut BinaryHandlers {
+        self.handlers.entry(message_id).or_default()
+    }
+
+    /// Freeze into a dispatch table, layered over the process-wide defaults
+    pub(crate) fn freeze(self) -> BinaryDispatchTable {
+        let mut merged = default_registry().lock().handlers.clone();
+        for (message_id, handlers) in self.handlers {
+            merged.entry(message_id).or_default().merge(handlers);
+        }
+        DispatchTable::from_entries(merged)
+    }
+}
+
+/// Process-wide registry for handlers registered outside `on_start`
+static DEFAULT_REGISTRY: OnceCell<Mutex<BinaryRegistry>> = OnceCell::new();
+
+fn default_registry() -> &'static Mutex<BinaryRegistry> {
+    DEFAULT_REGISTRY.get_or_init(Mutex::default)
+}
+
+thread_local! {
+    /// Registry of the plugin whose `on_start` is running on this thread
+    static STARTING: RefCell<Option<BinaryRegistry>> = const { RefCell::new(None) };
+}
+
+/// Run `f`, capturing binary handlers registered on this thread
+///
+/// `PluginHandle::start` runs `on_start` inside this so the plugin's handlers
+/// land in its own registry rather than the process-wide one.
+pub(crate) fn capture_registrations<R>(f: impl FnOnce() -> R) -> (R, BinaryRegistry) {
+    let scope = CaptureScope {
+        previous: STARTING.with(|starting| starting.replace(Some(BinaryRegistry::default()))),
+    };
+    let result = f();
+    let registry = STARTING
+        .with(|starting| starting.borrow_mut().take())
+        .unwrap_or_default();
+    drop(scope);
+    (result, registry)
+}
+
+/// Restores the enclosing capture, including when `on_start` panics
+struct CaptureScope {
+    previous: Option<BinaryRegistry>,
+}
+
+impl Drop for CaptureScope {
+    fn drop(&mut self) {
+        let previous = self.previous.take();
+        STARTING.with(|starting| *starting.borrow_mut() = previous);
+    }
+}
+
+/// Apply a registration to the starting plugin, or the defaults if none
+fn with_registry(f: impl FnOnce(&mut BinaryRegistry)) {
+    STARTING.with(|starting| match starting.borrow_mut().as_mut() {
+        Some(registry) => f(registry),
+        None => f(&mut default_registry().lock()),
+    });
+}
+
+/// Register a binary message handler
+///
+/// Call this from `Plugin::on_start` to register handlers for binary
+/// transport message types. Handlers registered elsewhere apply to every
+/// plugin started afterwards. Registrations made after a plugin is `Active`
+/// are not visible to it.
+pub fn register_binary_handler(message_id: u32, handler: BinaryMessageHandler) {
+    with_registry(|registry| registry.entry(message_id).raw = Some(handler));
+}
+
+/// Register a binary handler that writes directly into a caller buffer
+///
+/// Used by `plugin_call_raw_into`, which otherwise falls back to the handler
+/// registered with `register_binary_handler` and copies its response.
+/// Follows the same scoping rules as [`register_binary_handler`].
+pub fn register_binary_into_handler(message_id: u32, handler: BinaryIntoHandler) {
+    with_registry(|registry| registry.entry(message_id).into = Some(handler));
+}
+
+/// Check requests for a binary message ID against `T`'s layout
+///
+/// Every binary call with this ID is rejected with a `SerializationError`
+/// before its handler runs unless the request is at least `size_of::<T>()`
+/// bytes, aligned for `T`, carries `T`'s version and has valid `RbString`
+/// and `RbBytes` fields. Handlers can then read the request with
+/// [`BinaryStruct::from_request`]. Follows the same scoping rules as
+/// [`register_binary_handler`].
+pub fn register_binary_request<T: BinaryStruct>(message_id: u32) {
+    with_registry(|registry| registry.entry(message_id).layout = Some(&T::LAYOUT));
+}
+
+#[cfg(test)]
+#[path = "registry/registry_tests.rs"]
+mod registry_tests;
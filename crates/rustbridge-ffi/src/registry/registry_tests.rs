@@ -0,0 +1,149 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+fn first_handler(_handle: &PluginHandle, _request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    Ok(vec![1])
+}
+
+fn second_handler(_handle: &PluginHandle, _request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    Ok(vec![2])
+}
+
+fn into_handler(
+    _handle: &PluginHandle,
+    _request: &[u8],
+    _out: &mut [u8],
+) -> Result<usize, PluginError> {
+    Ok(0)
+}
+
+fn raw_of(table: &BinaryDispatchTable, message_id: u32) -> Option<usize> {
+    table
+        .get(message_id)
+        .and_then(|h| h.raw)
+        .map(|h| h as usize)
+}
+
+// capture_registrations tests
+
+#[test]
+fn capture_registrations___handler_registered_inside___lands_in_captured_registry() {
+    let ((), registry) = capture_registrations(|| register_binary_handler(0x9101, first_handler));
+
+    let table = registry.freeze();
+    let defaults = BinaryRegistry::default().freeze();
+
+    assert_eq!(raw_of(&table, 0x9101), Some(first_handler as usize));
+    assert_eq!(raw_of(&defaults, 0x9101), None);
+}
+
+#[test]
+fn capture_registrations___two_captures___keep_handlers_separate() {
+    let ((), first) = capture_registrations(|| register_binary_handler(0x9102, first_handler));
+    let ((), second) = capture_registrations(|| register_binary_handler(0x9102, second_handler));
+
+    assert_eq!(
+        raw_of(&first.freeze(), 0x9102),
+        Some(first_handler as usize)
+    );
+    assert_eq!(
+        raw_of(&second.freeze(), 0x9102),
+        Some(second_handler as usize)
+    );
+}
+
+#[test]
+fn capture_registrations___nested___restores_outer_capture() {
+    let (inner, outer) = capture_registrations(|| {
+        let ((), inner) = capture_registrations(|| register_binary_handler(0x9103, first_handler));
+        register_binary_handler(0x9104, second_handler);
+        inner
+    });
+
+    let inner = inner.freeze();
+    let outer = outer.freeze();
+
+    assert_eq!(raw_of(&inner, 0x9103), Some(first_handler as usize));
+    assert_eq!(raw_of(&inner, 0x9104), None);
+    assert_eq!(raw_of(&outer, 0x9104), Some(second_handler as usize));
+    assert_eq!(raw_of(&outer, 0x9103), None);
+}
+
+#[test]
+fn capture_registrations___panic___ends_capture() {
+    let result = std::panic::catch_unwind(|| capture_registrations(|| panic!("on_start panic")));
+
+    let active = STARTING.with(|starting| starting.borrow().is_some());
+
+    assert!(result.is_err());
+    assert!(!active);
+}
+
+// BinaryRegistry tests
+
+#[test]
+fn BinaryRegistry___freeze___includes_default_handlers() {
+    register_binary_handler(0x9105, first_handler);
+
+    let table = BinaryRegistry::default().freeze();
+
+    assert_eq!(raw_of(&table, 0x9105), Some(first_handler as usize));
+}
+
+#[test]
+fn BinaryRegistry___freeze___plugin_handler_overrides_default() {
+    register_binary_handler(0x9106, first_handler);
+    let ((), registry) = capture_registrations(|| {
+        register_binary_handler(0x9106, second_handler);
+        register_binary_into_handler(0x9106, into_handler);
+    });
+
+    let table = registry.freeze();
+    let handlers = table.get(0x9106).unwrap();
+
+    assert_eq!(
+        handlers.raw.map(|h| h as usize),
+        Some(second_handler as usize)
+    );
+    assert_eq!(
+        handlers.into.map(|h| h as usize),
+        Some(into_handler as usize)
+    );
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct VersionedRequest {
+    version: u8,
+    _reserved: [u8; 3],
+    value: u32,
+}
+
+// SAFETY: the layout matches the struct, which has only integer fields
+unsafe impl BinaryStruct for VersionedRequest {
+    const LAYOUT: BinaryLayout = BinaryLayout {
+        name: "VersionedRequest",
+        size: size_of::<VersionedRequest>(),
+        align: align_of::<VersionedRequest>(),
+        version: Some((std::mem::offset_of!(VersionedRequest, version), 1)),
+        strings: &[],
+        bytes: &[],
+    };
+}
+
+#[test]
+fn BinaryRegistry___freeze___request_layout_layers_over_default_handler() {
+    register_binary_handler(0x9107, first_handler);
+    let ((), registry) =
+        capture_registrations(|| register_binary_request::<VersionedRequest>(0x9107));
+
+    let table = registry.freeze();
+    let handlers = table.get(0x9107).unwrap();
+
+    assert_eq!(
+        handlers.raw.map(|h| h as usize),
+        Some(first_handler as usize)
+    );
+    assert_eq!(handlers.layout, Some(&VersionedRequest::LAYOUT));
+}
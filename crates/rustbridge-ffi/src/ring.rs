@@ -0,0 +1,661 @@
+//! Shared-memory ring transport
+//!
+//! A ring channel is a pair of single-producer, single-consumer byte rings
+//! that the host and the plugin both access directly. The host writes request
+//! frames into the request ring and a consumer task on the plugin's runtime
+//! answers each one with a frame in the response ring. Steady-state traffic
+//! never crosses the FFI boundary: the host only calls `plugin_ring_notify`
+//! when the consumer has parked, and `plugin_ring_wait` when it wants to
+//! block for responses instead of polling.
+//!
+//! # Ring Layout
+//!
+//! Each ring is an [`RbRing`] header followed by `capacity` data bytes. The
+//! `head` and `tail` cursors count bytes ever consumed and published, and the
+//! data offset of a cursor is `cursor & (capacity - 1)`. Frames are an
+//! [`RbRingFrame`] header followed by the payload, padded to 8 bytes. A frame
+//! never straddles the end of the ring: if it does not fit, the producer writes
+//! [`RB_RING_WRAP`] as the frame length and continues at offset 0.
+//!
+//! # Wakeups
+//!
+//! A producer publishes by storing `tail` (release), incrementing `signal`, and
+//! waking the consumer if `waiters` is non-zero. A consumer that finds its ring
+//! empty spins briefly, then increments `waiters` and sleeps on `signal` (a
+//! futex on Linux, short sleeps elsewhere).
+
+use crate::handle::{PluginHandle, TaskHandle};
+use crate::panic_guard::catch_panic;
+use parking_lot::{Condvar, Mutex};
+use rustbridge_core::PluginError;
+use std::alloc::{Layout, alloc_zeroed, dealloc};
+use std::borrow::Cow;
+use std::panic::AssertUnwindSafe;
+use std::ptr::NonNull;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering, fence};
+use std::time::Duration;
+
+/// Frame length marking the unused end of the ring before it wraps to offset 0
+pub const RB_RING_WRAP: u32 = u32::MAX;
+
+/// Ring data capacity used when `plugin_ring_open` is given 0
+pub const RB_RING_DEFAULT_CAPACITY: usize = 1 << 20;
+
+/// Smallest ring data capacity; smaller requests are rounded up
+pub const RB_RING_MIN_CAPACITY: usize = 1 << 12;
+
+/// Largest ring data capacity
+pub const RB_RING_MAX_CAPACITY: usize = 1 << 30;
+
+/// Frame alignment within the ring
+const FRAME_ALIGN: usize = 8;
+
+/// Empty polls before the consumer parks
+const SPIN_LIMIT: u32 = 2_000;
+
+/// Longest the consumer sleeps before re-checking for shutdown
+const PARK_TIMEOUT: Duration = Duration::from_millis(100);
+
+/// Shared ring header, followed in memory by `capacity` data bytes
+///
+/// Each cursor sits on its own cache line so the producer and consumer do
+/// not share a line on the hot path. The layout is 256 bytes on every
+/// platform.
+#[repr(C, align(64))]
+pub struct RbRing {
+    /// Bytes consumed so far (written by the consumer)
+    pub head: AtomicU64,
+    _pad0: [u8; 56],
+    /// Bytes published so far (written by the producer)
+    pub tail: AtomicU64,
+    _pad1: [u8; 56],
+    /// Incremented by the producer after each publish; the futex word
+    pub signal: AtomicU32,
+    /// Number of consumers sleeping on `signal`
+    pub waiters: AtomicU32,
+    _pad2: [u8; 56],
+    /// Data capacity in bytes (a power of two)
+    pub capacity: u64,
+    /// Non-zero once the channel is closing
+    pub closed: AtomicU32,
+    _reserved: u32,
+    _pad3: [u8; 48],
+}
+
+const _: () = assert!(std::mem::size_of::<RbRing>() == 256);
+
+/// Header written in front of every frame payload
+///
+/// Request frames carry `status` 0. Response frames echo the request's
+/// `message_id` and `correlation_id`, and carry 0 with the response bytes on
+/// success, or an error code with a UTF-8 message as the payload.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct RbRingFrame {
+    /// Payload length in bytes
+    pub len: u32,
+    /// Binary message identifier
+    pub message_id: u32,
+    /// 0 for requests and successful responses, otherwise an error code
+    pub status: u32,
+    /// Reserved, must be 0
+    pub reserved: u32,
+    /// Caller-chosen identifier echoed in the response
+    pub correlation_id: u64,
+}
+
+impl RbRingFrame {
+    /// Create a frame header for a request (or a successful response)
+    pub fn new(message_id: u32, correlation_id: u64) -> Self {
+        Self {
+            message_id,
+            correlation_id,
+            ..Self::default()
+        }
+    }
+}
+
+const FRAME_HEADER: usize = std::mem::size_of::<RbRingFrame>();
+
+/// Bytes a frame with `payload_len` bytes of payload occupies in the ring
+const fn frame_size(payload_len: usize) -> usize {
+    (FRAME_HEADER + payload_len + FRAME_ALIGN - 1) & !(FRAME_ALIGN - 1)
+}
+
+/// Ring channel descriptor handed to the host by `plugin_ring_open`
+#[repr(C)]
+pub struct RbRingChannel {
+    /// Host produces, plugin consumes
+    pub request: *mut RbRing,
+    /// Plugin produces, host consumes
+    pub response: *mut RbRing,
+}
+
+/// An owned ring: header and data in one 64-byte aligned allocation
+pub struct RingBuffer {
+    ptr: NonNull<RbRing>,
+}
+
+// SAFETY: all shared state is accessed through atomics or through the
+// single-producer/single-consumer protocol documented on try_push and try_pop
+unsafe impl Send for RingBuffer {}
+unsafe impl Sync for RingBuffer {}
+
+impl RingBuffer {
+    /// Allocate an empty ring
+    ///
+    /// `capacity` is rounded up to a power of two and clamped to at least
+    /// [`RB_RING_MIN_CAPACITY`]. Returns `None` above [`RB_RING_MAX_CAPACITY`].
+    pub fn new(capacity: usize) -> Option<Self> {
+        if capacity > RB_RING_MAX_CAPACITY {
+            return None;
+        }
+        let capacity = capacity.max(RB_RING_MIN_CAPACITY).next_power_of_two();
+        let layout = Self::layout(capacity);
+
+        // SAFETY: the layout has a non-zero size
+        let ptr = NonNull::new(unsafe { alloc_zeroed(layout) } as *mut RbRing)?;
+        // SAFETY: ptr is valid for the header, and an all-zero header is valid
+        unsafe { (*ptr.as_ptr()).capacity = capacity as u64 };
+        Some(Self { ptr })
+    }
+
+    fn layout(capacity: usize) -> Layout {
+        // Capacity is bounded by RB_RING_MAX_CAPACITY, so this cannot overflow
+        Layout::from_size_align(std::mem::size_of::<RbRing>() + capacity, 64)
+            .unwrap_or_else(|_| unreachable!())
+    }
+
+    /// Raw pointer to the shared header
+    pub fn as_ptr(&self) -> *mut RbRing {
+        self.ptr.as_ptr()
+    }
+
+    fn header(&self) -> &RbRing {
+        // SAFETY: ptr is valid for the lifetime of self
+        unsafe { self.ptr.as_ref() }
+    }
+
+    fn data(&self) -> *mut u8 {
+        // SAFETY: the data bytes directly follow the header in the allocation
+        unsafe { self.ptr.as_ptr().add(1) as *mut u8 }
+    }
+
+    /// Data capacity in bytes
+    pub fn capacity(&self) -> usize {
+        self.header().capacity as usize
+    }
+
+    /// Largest payload a single frame can carry
+    ///
+    /// A frame is at most half the ring, so it always fits once the ring
+    /// drains, wherever the cursors are.
+    pub fn max_payload(&self) -> usize {
+        self.capacity() / 2 - FRAME_HEADER
+    }
+
+    /// Bytes published but not yet consumed
+    pub fn len(&self) -> usize {
+        let header = self.header();
+        let tail = header.tail.load(Ordering::Acquire);
+        let head = header.head.load(Ordering::Acquire);
+        tail.wrapping_sub(head) as usize
+    }
+
+    /// Check if no frames are waiting
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Check if the channel is closing
+    pub fn is_closed(&self) -> bool {
+        self.header().closed.load(Ordering::Acquire) != 0
+    }
+
+    /// Mark the ring closed and wake any sleeping consumer
+    pub fn close(&self) {
+        let header = self.header();
+        header.closed.store(1, Ordering::Release);
+        header.signal.fetch_add(1, Ordering::SeqCst);
+        futex_wake(&header.signal);
+    }
+
+    /// Write one frame and publish it
+    ///
+    /// The frame's `len` is taken from `payload`. Returns `false` without
+    /// writing anything if the ring has no room or the payload is larger than
+    /// [`max_payload`](Self::max_payload).
+    ///
+    /// # Safety
+    /// Only one thread may push to a ring at a time. The host counts as a
+    /// producer for the request ring.
+    pub unsafe fn try_push(&self, frame: &RbRingFrame, payload: &[u8]) -> bool {
+        if payload.len() > self.max_payload() {
+            return false;
+        }
+        let header = self.header();
+        let capacity = self.capacity();
+        let total = frame_size(payload.len());
+
+        let mut tail = header.tail.load(Ordering::Relaxed);
+        let head = header.head.load(Ordering::Acquire);
+        let free = capacity - tail.wrapping_sub(head) as usize;
+        let mut pos = tail as usize & (capacity - 1);
+        let contiguous = capacity - pos;
+
+        if contiguous < total {
+            if free < contiguous + total {
+                return false;
+            }
+            // SAFETY: pos is 8-byte aligned and at least 8 bytes remain before
+            // the end of the data area, which the consumer has released
+            unsafe { (self.data().add(pos) as *mut u32).write(RB_RING_WRAP) };
+            tail += contiguous as u64;
+            pos = 0;
+        } else if free < total {
+            return false;
+        }
+
+        let header_out = RbRingFrame {
+            len: payload.len() as u32,
+            ..*frame
+        };
+        // SAFETY: [pos, pos + total) lies inside the data area and is free,
+        // and pos is 8-byte aligned
+        unsafe {
+            let at = self.data().add(pos);
+            (at as *mut RbRingFrame).write(header_out);
+            std::ptr::copy_nonoverlapping(payload.as_ptr(), at.add(FRAME_HEADER), payload.len());
+        }
+
+        header.tail.store(tail + total as u64, Ordering::Release);
+        self.notify();
+        true
+    }
+
+    /// Read the oldest frame, pass it to `f`, then release its space
+    ///
+    /// The payload slice points into the ring and is only valid inside `f`.
+    /// Returns `None` if the ring is empty. A frame whose length runs past
+    /// the published data means the producer broke the protocol; the ring is
+    /// then closed and `None` returned.
+    ///
+    /// # Safety
+    /// Only one thread may pop from a ring at a time. The host counts as the
+    /// consumer for the response ring.
+    pub unsafe fn try_pop<R>(&self, f: impl FnOnce(&RbRingFrame, &[u8]) -> R) -> Option<R> {
+        let header = self.header();
+        let capacity = self.capacity();
+        let mut head = header.head.load(Ordering::Relaxed);
+        let tail = header.tail.load(Ordering::Acquire);
+
+        loop {
+            let available = tail.wrapping_sub(head) as usize;
+            if available == 0 {
+                return None;
+            }
+            let pos = head as usize & (capacity - 1);
+
+            // SAFETY: pos is 8-byte aligned and inside published data
+            let len = unsafe { (self.data().add(pos) as *const u32).read() };
+            if len == RB_RING_WRAP {
+                head += (capacity - pos) as u64;
+                header.head.store(head, Ordering::Release);
+                continue;
+            }
+
+            let total = frame_size(len as usize);
+            if total > available || total > capacity - pos {
+                tracing::error!("Ring frame of {} bytes overruns published data", len);
+                self.close();
+                return None;
+            }
+
+            // SAFETY: the whole frame lies inside published data
+            let (frame, payload) = unsafe {
+                let at = self.data().add(pos);
+                let frame = (at as *const RbRingFrame).read();
+                let payload = std::slice::from_raw_parts(at.add(FRAME_HEADER), len as usize);
+                (frame, payload)
+            };
+            let result = f(&frame, payload);
+
+            header.head.store(head + total as u64, Ordering::Release);
+            return Some(result);
+        }
+    }
+
+    /// Sleep until a frame is published, the ring closes, or `timeout` passes
+    ///
+    /// Returns `true` if frames are waiting. Wakeups may be spurious.
+    pub fn wait(&self, timeout: Duration) -> bool {
+        let header = self.header();
+        header.waiters.fetch_add(1, Ordering::SeqCst);
+        let seq = header.signal.load(Ordering::SeqCst);
+        fence(Ordering::SeqCst);
+        if self.is_empty() && !self.is_closed() {
+            futex_wait(&header.signal, seq, timeout);
+        }
+        header.waiters.fetch_sub(1, Ordering::SeqCst);
+        !self.is_empty()
+    }
+
+    /// Wake the consumer after a publish if it is sleeping
+    pub fn notify(&self) {
+        let header = self.header();
+        header.signal.fetch_add(1, Ordering::SeqCst);
+        if header.waiters.load(Ordering::SeqCst) != 0 {
+            futex_wake(&header.signal);
+        }
+    }
+}
+
+impl Drop for RingBuffer {
+    fn drop(&mut self) {
+        let layout = Self::layout(self.capacity());
+        // SAFETY: ptr was allocated in new with this layout
+        unsafe { dealloc(self.ptr.as_ptr() as *mut u8, layout) };
+    }
+}
+
+#[cfg(target_os = "linux")]
+fn futex_wait(word: &AtomicU32, expected: u32, timeout: Duration) {
+    let ts = libc::timespec {
+        tv_sec: timeout.as_secs() as libc::time_t,
+        tv_nsec: timeout.subsec_nanos() as libc::c_long,
+    };
+    // SAFETY: word is a valid aligned u32 for the duration of the call; the
+    // kernel only reads it and returns on timeout, wake, or value mismatch
+    unsafe {
+        libc::syscall(
+            libc::SYS_futex,
+            word.as_ptr(),
+            libc::FUTEX_WAIT | libc::FUTEX_PRIVATE_FLAG,
+            expected,
+            &ts as *const libc::timespec,
+        )
+    };
+}
+
+#[cfg(target_os = "linux")]
+fn futex_wake(word: &AtomicU32) {
+    // SAFETY: word is a valid aligned u32; FUTEX_WAKE does not access memory
+    unsafe {
+        libc::syscall(
+            libc::SYS_futex,
+            word.as_ptr(),
+            libc::FUTEX_WAKE | libc::FUTEX_PRIVATE_FLAG,
+            i32::MAX,
+        )
+    };
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wait(word: &AtomicU32, expected: u32, timeout: Duration) {
+    // No portable futex: poll with short sleeps until the word changes
+    let deadline = std::time::Instant::now() + timeout;
+    while word.load(Ordering::Acquire) == expected && std::time::Instant::now() < deadline {
+        std::thread::sleep(Duration::from_micros(50));
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wake(_word: &AtomicU32) {}
+
+/// A ring channel owned by the plugin
+///
+/// `#[repr(C)]` with the descriptor first, so the pointer handed to the host
+/// is also a pointer to the channel.
+#[repr(C)]
+pub struct RingChannel {
+    ffi: RbRingChannel,
+    request: RingBuffer,
+    response: RingBuffer,
+    /// True while the consumer task is running
+    running: Mutex<bool>,
+    stopped: Condvar,
+}
+
+// SAFETY: the descriptor's pointers refer to the rings owned by the channel
+unsafe impl Send for RingChannel {}
+unsafe impl Sync for RingChannel {}
+
+impl RingChannel {
+    /// Allocate a channel with `capacity` data bytes per ring
+    pub fn new(capacity: usize) -> Option<Self> {
+        let request = RingBuffer::new(capacity)?;
+        let response = RingBuffer::new(capacity)?;
+        Some(Self {
+            ffi: RbRingChannel {
+                request: request.as_ptr(),
+                response: response.as_ptr(),
+            },
+            request,
+            response,
+            running: Mutex::new(false),
+            stopped: Condvar::new(),
+        })
+    }
+
+    /// Open a channel and start its consumer on the plugin's runtime
+    pub fn open(handle: Arc<PluginHandle>, capacity: usize) -> Result<Arc<Self>, PluginError> {
+        if !handle.state().can_handle_requests() {
+            return Err(PluginError::InvalidState {
+                expected: "Active".to_string(),
+                actual: handle.state().to_string(),
+            });
+        }
+        let capacity = if capacity == 0 {
+            RB_RING_DEFAULT_CAPACITY
+        } else {
+            capacity
+        };
+        let channel = Arc::new(Self::new(capacity).ok_or_else(|| {
+            PluginError::ConfigError(format!(
+                "ring capacity {} exceeds {}",
+                capacity, RB_RING_MAX_CAPACITY
+            ))
+        })?);
+
+        handle.track_ring(&channel);
+        let consumer = channel.clone();
+        let runtime = handle.runtime().handle();
+        runtime.spawn_blocking(move || consumer.run_consumer(handle));
+        Ok(channel)
+    }
+
+    /// The descriptor shared with the host
+    pub fn descriptor(&self) -> &RbRingChannel {
+        &self.ffi
+    }
+
+    /// Ring the host writes requests into
+    pub fn request(&self) -> &RingBuffer {
+        &self.request
+    }
+
+    /// Ring the host reads responses from
+    pub fn response(&self) -> &RingBuffer {
+        &self.response
+    }
+
+    /// Close both rings and wait for the consumer to exit
+    ///
+    /// Requests still in the ring are not answered. Idempotent.
+    pub fn stop(&self) {
+        self.request.close();
+        self.response.close();
+        let mut running = self.running.lock();
+        while *running {
+            self.stopped.wait(&mut running);
+        }
+    }
+
+    fn run_consumer(&self, handle: Arc<PluginHandle>) {
+        // A consumer that starts after stop() sees the closed flag and exits
+        let _running = RunningGuard::new(self);
+        // The handle is released before the guard, so stop() never returns
+        // while this thread still keeps the plugin's runtime alive
+        self.serve_requests(TaskHandle::new(handle));
+    }
+
+    fn serve_requests(&self, handle: TaskHandle) {
+        let _log = handle.logger().enter();
+        let handle_id = handle.id().unwrap_or(0);
+        let mut scratch = vec![0; self.response.max_payload()];
+        let mut idle = 0u32;
+
+        while !self.request.is_closed() {
+            // SAFETY: this task is the only consumer of the request ring and
+            // the only producer of the response ring
+            let served = unsafe {
+                self.request.try_pop(|frame, payload| {
+                    let (status, bytes) = serve(&handle, handle_id, frame, payload, &mut scratch);
+                    let reply = RbRingFrame {
+                        status,
+                        ..RbRingFrame::new(frame.message_id, frame.correlation_id)
+                    };
+                    self.push_response(&reply, &bytes);
+                })
+            };
+
+            if served.is_some() {
+                idle = 0;
+            } else if idle < SPIN_LIMIT {
+                idle += 1;
+                std::hint::spin_loop();
+            } else {
+                self.request.wait(PARK_TIMEOUT);
+            }
+        }
+    }
+
+    /// Push a response, waiting for the host to make room
+    fn push_response(&self, reply: &RbRingFrame, payload: &[u8]) {
+        let max = self.response.max_payload();
+        let oversized;
+        let (reply, payload) = if payload.len() <= max {
+            (*reply, payload)
+        } else if reply.status == 0 {
+            let error = PluginError::InsufficientCapacity {
+                required: payload.len(),
+            };
+            oversized = format!(
+                "Response of {} bytes exceeds ring frame limit {}",
+                payload.len(),
+                max
+            );
+            (
+                RbRingFrame {
+                    status: error.error_code(),
+                    ..*reply
+                },
+                oversized.as_bytes(),
+            )
+        } else {
+            // Error message: truncate rather than replace
+            (*reply, &payload[..max])
+        };
+
+        // SAFETY: only the consumer task produces into the response ring
+        while !unsafe { self.response.try_push(&reply, payload) } {
+            if self.response.is_closed() {
+                return;
+            }
+            std::thread::yield_now();
+        }
+    }
+}
+
+/// Marks the consumer as running until dropped, even if it unwinds
+struct RunningGuard<'a>(&'a RingChannel);
+
+impl<'a> RunningGuard<'a> {
+    fn new(channel: &'a RingChannel) -> Self {
+        *channel.running.lock() = true;
+        Self(channel)
+    }
+}
+
+impl Drop for RunningGuard<'_> {
+    fn drop(&mut self) {
+        *self.0.running.lock() = false;
+        self.0.stopped.notify_all();
+    }
+}
+
+/// Where a handler left its response
+enum Handled {
+    /// The first `n` bytes of the scratch buffer
+    Scratch(usize),
+    /// A buffer returned by the handler
+    Owned(Vec<u8>),
+}
+
+/// Run the binary handler for one request frame
+///
+/// A `register_binary_into_handler` handler writes into the consumer's
+/// scratch buffer, so steady-state traffic through it does not allocate.
+/// Otherwise the `register_binary_handler` handler runs. Returns the frame
+/// status and the response (or error message) bytes.
+fn serve<'s>(
+    handle: &PluginHandle,
+    handle_id: u64,
+    frame: &RbRingFrame,
+    payload: &[u8],
+    scratch: &'s mut [u8],
+) -> (u32, Cow<'s, [u8]>) {
+    if !handle.state().can_handle_requests() {
+        return (1, Cow::Borrowed(b"Plugin not in Active state"));
+    }
+    let handlers = handle.binary_handlers(frame.message_id);
+
+    let result = catch_panic(
+        handle_id,
+        AssertUnwindSafe(|| {
+            // SAFETY: the producer guarantees the payload's pointers are
+            // valid, as plugin_call_raw requires of its caller
+            unsafe { handlers.check(payload) }?;
+            if let Some(into) = handlers.into {
+                match into(handle, payload, scratch) {
+                    Ok(n) => return Ok(Handled::Scratch(n)),
+                    Err(PluginError::InsufficientCapacity { .. }) if handlers.raw.is_some() => {}
+                    Err(e) => return Err(e),
+                }
+            }
+            match handlers.raw {
+                Some(raw) => raw(handle, payload).map(Handled::Owned),
+                None => Err(PluginError::UnknownMessageType(format!(
+                    "Unknown message ID: {}",
+                    frame.message_id
+                ))),
+            }
+        }),
+    );
+
+    match result {
+        Ok(Ok(Handled::Scratch(n))) => (0, Cow::Borrowed(&scratch[..n.min(scratch.len())])),
+        Ok(Ok(Handled::Owned(bytes))) => (0, Cow::Owned(bytes)),
+        Ok(Err(e)) => (e.error_code(), Cow::Owned(e.to_string().into_bytes())),
+        Err(mut error_buffer) => {
+            let message = if error_buffer.data.is_null() {
+                b"Internal error (panic)".to_vec()
+            } else {
+                // SAFETY: the panic error buffer holds a valid message
+                unsafe { std::slice::from_raw_parts(error_buffer.data, error_buffer.len) }.to_vec()
+            };
+            // SAFETY: error_buffer is a valid FfiBuffer from catch_panic
+            unsafe { error_buffer.free() };
+            (11, Cow::Owned(message))
+        }
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+#[cfg(test)]
+#[path = "ring/ring_tests.rs"]
+mod ring_tests;
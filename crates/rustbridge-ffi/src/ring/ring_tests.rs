@@ -0,0 +1,199 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::mem::offset_of;
+use std::thread;
+use std::time::Instant;
+
+fn push(ring: &RingBuffer, message_id: u32, correlation_id: u64, payload: &[u8]) -> bool {
+    // SAFETY: each test pushes from one thread at a time
+    unsafe { ring.try_push(&RbRingFrame::new(message_id, correlation_id), payload) }
+}
+
+fn pop(ring: &RingBuffer) -> Option<(RbRingFrame, Vec<u8>)> {
+    // SAFETY: each test pops from one thread at a time
+    unsafe { ring.try_pop(|frame, payload| (*frame, payload.to_vec())) }
+}
+
+// Layout tests
+
+#[test]
+fn RbRing___layout___matches_c_header() {
+    assert_eq!(std::mem::size_of::<RbRing>(), 256);
+    assert_eq!(std::mem::align_of::<RbRing>(), 64);
+    assert_eq!(offset_of!(RbRing, head), 0);
+    assert_eq!(offset_of!(RbRing, tail), 64);
+    assert_eq!(offset_of!(RbRing, signal), 128);
+    assert_eq!(offset_of!(RbRing, waiters), 132);
+    assert_eq!(offset_of!(RbRing, capacity), 192);
+    assert_eq!(offset_of!(RbRing, closed), 200);
+}
+
+#[test]
+fn RbRingFrame___layout___is_24_bytes() {
+    assert_eq!(std::mem::size_of::<RbRingFrame>(), 24);
+    assert_eq!(offset_of!(RbRingFrame, status), 8);
+    assert_eq!(offset_of!(RbRingFrame, correlation_id), 16);
+}
+
+// Construction tests
+
+#[test]
+fn RingBuffer___new___rounds_capacity_to_power_of_two() {
+    let small = RingBuffer::new(1).unwrap();
+    let odd = RingBuffer::new(5000).unwrap();
+
+    assert_eq!(small.capacity(), RB_RING_MIN_CAPACITY);
+    assert_eq!(odd.capacity(), 8192);
+    assert!(small.is_empty());
+    assert!(!small.is_closed());
+}
+
+#[test]
+fn RingBuffer___new___rejects_capacity_above_max() {
+    assert!(RingBuffer::new(RB_RING_MAX_CAPACITY + 1).is_none());
+}
+
+// Push and pop tests
+
+#[test]
+fn RingBuffer___push_pop___preserves_frame_and_payload() {
+    let ring = RingBuffer::new(0).unwrap();
+
+    assert!(push(&ring, 7, 99, b"hello"));
+    let (frame, payload) = pop(&ring).unwrap();
+
+    assert_eq!(frame.len, 5);
+    assert_eq!(frame.message_id, 7);
+    assert_eq!(frame.correlation_id, 99);
+    assert_eq!(frame.status, 0);
+    assert_eq!(payload, b"hello");
+    assert!(pop(&ring).is_none());
+}
+
+#[test]
+fn RingBuffer___full___rejects_push_until_popped() {
+    let ring = RingBuffer::new(0).unwrap();
+    let payload = vec![1u8; 1000];
+
+    let mut pushed = 0;
+    while push(&ring, 1, pushed, &payload) {
+        pushed += 1;
+    }
+    assert_eq!(pushed as usize, ring.capacity() / frame_size(payload.len()));
+
+    pop(&ring).unwrap();
+
+    assert!(push(&ring, 1, pushed, &payload));
+}
+
+#[test]
+fn RingBuffer___oversized_payload___is_rejected() {
+    let ring = RingBuffer::new(0).unwrap();
+
+    assert!(!push(&ring, 1, 0, &vec![0; ring.max_payload() + 1]));
+    assert!(push(&ring, 1, 0, &vec![0; ring.max_payload()]));
+}
+
+#[test]
+fn RingBuffer___many_laps___wraps_without_splitting_frames() {
+    let ring = RingBuffer::new(0).unwrap();
+
+    for i in 0..2_000u64 {
+        let payload = vec![i as u8; (i as usize * 37) % 700];
+        assert!(push(&ring, 3, i, &payload));
+
+        let (frame, popped) = pop(&ring).unwrap();
+
+        assert_eq!(frame.correlation_id, i);
+        assert_eq!(popped, payload);
+    }
+    assert!(ring.is_empty());
+}
+
+#[test]
+fn RingBuffer___corrupt_frame_length___closes_ring() {
+    let ring = RingBuffer::new(0).unwrap();
+    assert!(push(&ring, 1, 0, b"x"));
+    // SAFETY: offset 0 holds the frame header that was just written
+    unsafe { (ring.data() as *mut u32).write(1 << 20) };
+
+    assert!(pop(&ring).is_none());
+    assert!(ring.is_closed());
+}
+
+// Concurrency tests
+
+#[test]
+fn RingBuffer___producer_and_consumer_threads___deliver_in_order() {
+    let ring = Arc::new(RingBuffer::new(0).unwrap());
+    let producer_ring = ring.clone();
+
+    let producer = thread::spawn(move || {
+        for i in 0..50_000u64 {
+            while !push(&producer_ring, 1, i, &i.to_le_bytes()) {
+                std::hint::spin_loop();
+            }
+        }
+    });
+
+    let mut next = 0u64;
+    while next < 50_000 {
+        match pop(&ring) {
+            Some((frame, payload)) => {
+                assert_eq!(frame.correlation_id, next);
+                assert_eq!(payload, next.to_le_bytes());
+                next += 1;
+            }
+            None => {
+                ring.wait(Duration::from_millis(10));
+            }
+        }
+    }
+    producer.join().unwrap();
+}
+
+#[test]
+fn RingBuffer___wait___wakes_on_push_from_other_thread() {
+    let ring = Arc::new(RingBuffer::new(0).unwrap());
+    let producer_ring = ring.clone();
+
+    let producer = thread::spawn(move || {
+        thread::sleep(Duration::from_millis(20));
+        push(&producer_ring, 1, 0, b"ready");
+    });
+
+    let start = Instant::now();
+    while !ring.wait(Duration::from_secs(5)) {}
+
+    assert!(start.elapsed() < Duration::from_secs(5));
+    assert_eq!(pop(&ring).unwrap().1, b"ready");
+    producer.join().unwrap();
+}
+
+#[test]
+fn RingBuffer___wait___times_out_when_empty() {
+    let ring = RingBuffer::new(0).unwrap();
+
+    let ready = ring.wait(Duration::from_millis(10));
+
+    assert!(!ready);
+}
+
+#[test]
+fn RingBuffer___close___wakes_waiter() {
+    let ring = Arc::new(RingBuffer::new(0).unwrap());
+    let waiter_ring = ring.clone();
+
+    let waiter = thread::spawn(move || {
+        let start = Instant::now();
+        while !waiter_ring.is_closed() {
+            waiter_ring.wait(Duration::from_secs(5));
+        }
+        start.elapsed()
+    });
+    thread::sleep(Duration::from_millis(20));
+    ring.close();
+
+    assert!(waiter.join().unwrap() < Duration::from_secs(5));
+}
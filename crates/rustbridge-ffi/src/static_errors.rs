@@ -0,0 +1,77 @@
+//! Pre-serialized error envelopes for errors that carry no per-call data
+//!
+//! `plugin_call` answers a failed request with a JSON error envelope. For
+//! errors whose envelope is the same on every call, such as rejections under
+//! overload or calls to a plugin that is not `Active`, the envelope is
+//! serialized once and handed out as a static [`FfiBuffer`] that is never
+//! freed. Shedding load then costs no formatting, serialization or
+//! allocation per rejected call.
+
+use crate::buffer::FfiBuffer;
+use once_cell::sync::OnceCell;
+use rustbridge_core::{LifecycleState, PluginError};
+use rustbridge_transport::ResponseEnvelope;
+
+/// Number of `LifecycleState` variants
+const STATE_COUNT: usize = 6;
+
+/// Error code of `PluginError::InvalidState`
+const INVALID_STATE_CODE: u32 = 1;
+
+static TOO_MANY_REQUESTS: OnceCell<Box<[u8]>> = OnceCell::new();
+static CANCELLED: OnceCell<Box<[u8]>> = OnceCell::new();
+static TIMEOUT: OnceCell<Box<[u8]>> = OnceCell::new();
+
+/// `InvalidState` envelopes for calls made outside `Active`, by state
+static INACTIVE: [OnceCell<Box<[u8]>>; STATE_COUNT] = [const { OnceCell::new() }; STATE_COUNT];
+
+/// Static envelope for `error`, if its envelope never varies
+pub(crate) fn envelope(error: &PluginError) -> Option<FfiBuffer> {
+    let cell = match error {
+        PluginError::TooManyRequests => &TOO_MANY_REQUESTS,
+        PluginError::Cancelled => &CANCELLED,
+        PluginError::Timeout => &TIMEOUT,
+        _ => return None,
+    };
+    Some(static_buffer(cell, error))
+}
+
+/// Static envelope rejecting a call made while the plugin is in `state`
+///
+/// Matches the `InvalidState` error `PluginHandle::call` returns.
+pub(crate) fn inactive_envelope(state: LifecycleState) -> FfiBuffer {
+    let bytes = INACTIVE[state_index(state)].get_or_init(|| {
+        encode(&PluginError::InvalidState {
+            expected: LifecycleState::Active.to_string(),
+            actual: state.to_string(),
+        })
+    });
+    FfiBuffer::error_static(INVALID_STATE_CODE, bytes)
+}
+
+fn state_index(state: LifecycleState) -> usize {
+    match state {
+        LifecycleState::Installed => 0,
+        LifecycleState::Starting => 1,
+        LifecycleState::Active => 2,
+        LifecycleState::Stopping => 3,
+        LifecycleState::Stopped => 4,
+        LifecycleState::Failed => 5,
+    }
+}
+
+fn static_buffer(cell: &'static OnceCell<Box<[u8]>>, error: &PluginError) -> FfiBuffer {
+    let bytes = cell.get_or_init(|| encode(error));
+    FfiBuffer::error_static(error.error_code(), bytes)
+}
+
+fn encode(error: &PluginError) -> Box<[u8]> {
+    ResponseEnvelope::from_error(error)
+        .to_bytes()
+        .unwrap_or_default()
+        .into_boxed_slice()
+}
+
+#[cfg(test)]
+#[path = "static_errors/static_errors_tests.rs"]
+mod static_errors_tests;
@@ -0,0 +1,69 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+fn bytes(buffer: &FfiBuffer) -> &[u8] {
+    unsafe { buffer.as_slice() }
+}
+
+#[test]
+fn envelope___fixed_errors___match_serialized_envelope() {
+    for error in [
+        PluginError::TooManyRequests,
+        PluginError::Cancelled,
+        PluginError::Timeout,
+    ] {
+        let expected = ResponseEnvelope::from_error(&error).to_bytes().unwrap();
+
+        let buffer = envelope(&error).unwrap();
+
+        assert_eq!(bytes(&buffer), expected.as_slice());
+        assert_eq!(buffer.error_code, error.error_code());
+    }
+}
+
+#[test]
+fn envelope___fixed_error___is_static() {
+    let mut buffer = envelope(&PluginError::TooManyRequests).unwrap();
+
+    assert_eq!(buffer.capacity, 0);
+    unsafe { buffer.free() };
+}
+
+#[test]
+fn envelope___repeated_calls___share_one_buffer() {
+    let first = envelope(&PluginError::Cancelled).unwrap();
+    let second = envelope(&PluginError::Cancelled).unwrap();
+
+    assert_eq!(first.data, second.data);
+}
+
+#[test]
+fn envelope___error_with_data___returns_none() {
+    let error = PluginError::HandlerError("boom".to_string());
+
+    assert!(envelope(&error).is_none());
+}
+
+#[test]
+fn inactive_envelope___each_state___matches_call_error() {
+    for state in [
+        LifecycleState::Installed,
+        LifecycleState::Starting,
+        LifecycleState::Stopping,
+        LifecycleState::Stopped,
+        LifecycleState::Failed,
+    ] {
+        let error = PluginError::InvalidState {
+            expected: "Active".to_string(),
+            actual: state.to_string(),
+        };
+        let expected = ResponseEnvelope::from_error(&error).to_bytes().unwrap();
+
+        let buffer = inactive_envelope(state);
+
+        assert_eq!(bytes(&buffer), expected.as_slice());
+        assert_eq!(buffer.error_code, error.error_code());
+        assert_eq!(buffer.capacity, 0);
+    }
+}
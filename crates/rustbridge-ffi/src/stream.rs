@@ -0,0 +1,165 @@
+//! Streamed responses pulled by the host chunk by chunk
+//!
+//! `plugin_stream_open` runs [`Plugin::handle_request_stream`] on the calling
+//! thread, then spawns a driver task that polls the returned stream and feeds
+//! a bounded channel. `plugin_stream_next` blocks the host thread on that
+//! channel, so at most [`STREAM_BUFFER_CHUNKS`] chunks are produced ahead of
+//! the host and a slow consumer throttles the handler.
+//!
+//! [`Plugin::handle_request_stream`]: rustbridge_core::Plugin::handle_request_stream
+
+use dashmap::DashMap;
+use parking_lot::Mutex;
+use rustbridge_core::{BoxResponseStream, PluginError, PluginResult};
+use rustbridge_logging::LogCallbackManager;
+use rustbridge_runtime::{AsyncBridge, OwnedAdmissionPermit};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU64, Ordering};
+use tokio::sync::mpsc;
+use tokio::task::AbortHandle;
+
+/// Chunks a stream may produce ahead of the host
+pub const STREAM_BUFFER_CHUNKS: usize = 2;
+
+/// Item sent from a stream's driver task to the host
+enum StreamItem {
+    Chunk(Vec<u8>),
+    End,
+    Error(PluginError),
+}
+
+/// An open stream awaiting `plugin_stream_next` calls
+struct ActiveStream {
+    receiver: Mutex<mpsc::Receiver<StreamItem>>,
+    driver: AbortHandle,
+}
+
+/// Streams opened on one plugin handle, keyed by stream ID
+pub(crate) struct StreamTable {
+    streams: DashMap<u64, Arc<ActiveStream>>,
+    next_id: AtomicU64,
+}
+
+impl StreamTable {
+    pub(crate) fn new() -> Self {
+        Self {
+            streams: DashMap::new(),
+            next_id: AtomicU64::new(1),
+        }
+    }
+
+    /// Start driving `stream` on the runtime and return its ID (never 0)
+    ///
+    /// `permit` is held until the stream finishes or is closed.
+    pub(crate) fn open(
+        &self,
+        bridge: &AsyncBridge,
+        logger: Arc<LogCallbackManager>,
+        stream: BoxResponseStream,
+        permit: Option<OwnedAdmissionPermit>,
+    ) -> u64 {
+        let (sender, receiver) = mpsc::channel(STREAM_BUFFER_CHUNKS);
+
+        let driver = bridge.spawn(rustbridge_logging::scoped(
+            logger,
+            drive(stream, sender.clone(), permit),
+        ));
+        let abort = driver.abort_handle();
+        // The watcher keeps the channel open so a panic is reported instead
+        // of looking like a cancellation
+        bridge.spawn(async move {
+            if let Err(e) = driver.await
+                && e.is_panic()
+            {
+                let panic = PluginError::Internal("Stream handler panicked".to_string());
+                let _ = sender.send(StreamItem::Error(panic)).await;
+            }
+        });
+
+        let id = self.next_id.fetch_add(1, Ordering::Relaxed);
+        self.streams.insert(
+            id,
+            Arc::new(ActiveStream {
+                receiver: Mutex::new(receiver),
+                driver: abort,
+            }),
+        );
+        id
+    }
+
+    /// Block until the stream's next chunk is ready
+    ///
+    /// Returns `Ok(None)` once the stream is complete. The stream is removed
+    /// after it ends, fails, or is cancelled, so later calls fail with
+    /// `InvalidState`. Must not be called from a runtime thread.
+    pub(crate) fn next(&self, id: u64) -> PluginResult<Option<Vec<u8>>> {
+        let Some(stream) = self.streams.get(&id).map(|entry| Arc::clone(&entry)) else {
+            return Err(PluginError::InvalidState {
+                expected: "open stream".to_string(),
+                actual: format!("unknown stream ID {}", id),
+            });
+        };
+
+        let item = stream.receiver.lock().blocking_recv();
+        let result = match item {
+            Some(StreamItem::Chunk(chunk)) => return Ok(Some(chunk)),
+            Some(StreamItem::End) => Ok(None),
+            Some(StreamItem::Error(e)) => Err(e),
+            None => Err(PluginError::Cancelled),
+        };
+        self.streams.remove(&id);
+        result
+    }
+
+    /// Stop a stream before it is complete
+    ///
+    /// Returns `true` if the stream was open.
+    pub(crate) fn close(&self, id: u64) -> bool {
+        match self.streams.remove(&id) {
+            Some((_, stream)) => {
+                stream.driver.abort();
+                true
+            }
+            None => false,
+        }
+    }
+
+    /// Stop every open stream; pending `next` calls fail with `Cancelled`
+    pub(crate) fn close_all(&self) {
+        let ids: Vec<u64> = self.streams.iter().map(|e| *e.key()).collect();
+        for id in ids {
+            self.close(id);
+        }
+    }
+
+    /// Number of open streams
+    pub(crate) fn len(&self) -> usize {
+        self.streams.len()
+    }
+}
+
+/// Poll `stream` into `sender` until it ends or the host goes away
+async fn drive(
+    mut stream: BoxResponseStream,
+    sender: mpsc::Sender<StreamItem>,
+    permit: Option<OwnedAdmissionPermit>,
+) {
+    let _permit = permit;
+    loop {
+        let item = match stream.next_chunk().await {
+            Some(Ok(chunk)) if chunk.is_empty() => continue,
+            Some(Ok(chunk)) => StreamItem::Chunk(chunk),
+            Some(Err(e)) => StreamItem::Error(e),
+            None => StreamItem::End,
+        };
+        let last = !matches!(item, StreamItem::Chunk(_));
+        // A send error means the host closed the stream
+        if sender.send(item).await.is_err() || last {
+            return;
+        }
+    }
+}
+
+#[cfg(test)]
+#[path = "stream/stream_tests.rs"]
+mod stream_tests;
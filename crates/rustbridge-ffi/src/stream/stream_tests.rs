@@ -0,0 +1,136 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use rustbridge_core::{IterStream, OnceStream};
+use rustbridge_runtime::{AsyncRuntime, RuntimeConfig};
+use std::thread;
+use std::time::Duration;
+
+fn bridge() -> AsyncBridge {
+    let runtime = AsyncRuntime::new(RuntimeConfig::new().with_worker_threads(1)).unwrap();
+    AsyncBridge::new(Arc::new(runtime))
+}
+
+fn logger() -> Arc<LogCallbackManager> {
+    Arc::new(LogCallbackManager::new())
+}
+
+fn endless() -> BoxResponseStream {
+    Box::new(IterStream::new(
+        (0..).map(|i: u64| Ok(i.to_le_bytes().to_vec())),
+    ))
+}
+
+/// Stream whose next chunk never arrives
+struct Pending;
+
+#[async_trait::async_trait]
+impl rustbridge_core::ResponseStream for Pending {
+    async fn next_chunk(&mut self) -> Option<PluginResult<Vec<u8>>> {
+        std::future::pending().await
+    }
+}
+
+// Open and next tests
+
+#[test]
+fn StreamTable___open___ids_start_at_one() {
+    let bridge = bridge();
+    let table = StreamTable::new();
+
+    let first = table.open(
+        &bridge,
+        logger(),
+        Box::new(OnceStream::new(b"a".to_vec())),
+        None,
+    );
+    let second = table.open(
+        &bridge,
+        logger(),
+        Box::new(OnceStream::new(b"b".to_vec())),
+        None,
+    );
+
+    assert_eq!(first, 1);
+    assert_eq!(second, 2);
+    assert_eq!(table.len(), 2);
+}
+
+#[test]
+fn StreamTable___next___skips_empty_chunks_and_ends() {
+    let bridge = bridge();
+    let table = StreamTable::new();
+    let chunks = vec![Ok(b"a".to_vec()), Ok(Vec::new()), Ok(b"b".to_vec())];
+    let id = table.open(
+        &bridge,
+        logger(),
+        Box::new(IterStream::new(chunks.into_iter())),
+        None,
+    );
+
+    assert_eq!(table.next(id).unwrap(), Some(b"a".to_vec()));
+    assert_eq!(table.next(id).unwrap(), Some(b"b".to_vec()));
+    assert_eq!(table.next(id).unwrap(), None);
+    assert_eq!(table.len(), 0);
+}
+
+#[test]
+fn StreamTable___next___unknown_id_is_invalid_state() {
+    let table = StreamTable::new();
+
+    let result = table.next(42);
+
+    assert!(matches!(result, Err(PluginError::InvalidState { .. })));
+}
+
+#[test]
+fn StreamTable___next___error_ends_stream() {
+    let bridge = bridge();
+    let table = StreamTable::new();
+    let chunks = vec![Err(PluginError::HandlerError("bad".to_string()))];
+    let id = table.open(
+        &bridge,
+        logger(),
+        Box::new(IterStream::new(chunks.into_iter())),
+        None,
+    );
+
+    let result = table.next(id);
+
+    assert!(matches!(result, Err(PluginError::HandlerError(_))));
+    assert_eq!(table.len(), 0);
+}
+
+// Close tests
+
+#[test]
+fn StreamTable___close___forgets_stream() {
+    let bridge = bridge();
+    let table = StreamTable::new();
+    let id = table.open(&bridge, logger(), endless(), None);
+
+    assert!(table.close(id));
+    assert!(!table.close(id));
+    assert!(matches!(
+        table.next(id),
+        Err(PluginError::InvalidState { .. })
+    ));
+}
+
+#[test]
+fn StreamTable___close_all___releases_blocked_reader_with_cancelled() {
+    let bridge = bridge();
+    let table = Arc::new(StreamTable::new());
+    let id = table.open(&bridge, logger(), Box::new(Pending), None);
+    let reader_table = Arc::clone(&table);
+
+    let reader = thread::spawn(move || reader_table.next(id));
+    thread::sleep(Duration::from_millis(20));
+    table.close_all();
+
+    assert!(matches!(
+        reader.join().unwrap(),
+        Err(PluginError::Cancelled)
+    ));
+    assert_eq!(table.len(), 0);
+}
@@ -0,0 +1,61 @@
+//! Numeric IDs for a plugin's JSON type tags
+//!
+//! `plugin_call` passes the type tag as a C string, so every call pays for a
+//! `strlen`, UTF-8 validation and, on the host side, encoding the tag. Hosts
+//! can instead resolve each tag once with `plugin_resolve_type_tag` and call
+//! `plugin_call_id` with the returned ID, which turns the tag lookup into an
+//! array index.
+//!
+//! The IDs come from [`Plugin::supported_types`] and are fixed when the
+//! plugin starts, so lookups take no locks.
+//!
+//! [`Plugin::supported_types`]: rustbridge_core::Plugin::supported_types
+
+use std::collections::HashMap;
+
+/// Frozen table of type tags and their IDs
+///
+/// IDs start at 1 in the order the tags are listed; 0 means "unknown".
+#[derive(Debug, Default)]
+pub(crate) struct TypeTagIds {
+    tags: Box<[&'static str]>,
+    ids: HashMap<&'static str, u32>,
+}
+
+impl TypeTagIds {
+    /// Assign IDs to `tags`, skipping repeats
+    pub(crate) fn new(tags: impl IntoIterator<Item = &'static str>) -> Self {
+        let mut ordered = Vec::new();
+        let mut ids = HashMap::new();
+        for tag in tags {
+            ids.entry(tag).or_insert_with(|| {
+                ordered.push(tag);
+                ordered.len() as u32
+            });
+        }
+        Self {
+            tags: ordered.into_boxed_slice(),
+            ids,
+        }
+    }
+
+    /// Get the ID for a type tag, or 0 if it has none
+    pub(crate) fn resolve(&self, tag: &str) -> u32 {
+        self.ids.get(tag).copied().unwrap_or(0)
+    }
+
+    /// Get every type tag, in ID order starting from ID 1
+    pub(crate) fn tags(&self) -> &[&'static str] {
+        &self.tags
+    }
+
+    /// Get the type tag for an ID
+    #[inline]
+    pub(crate) fn tag(&self, id: u32) -> Option<&'static str> {
+        self.tags.get((id as usize).checked_sub(1)?).copied()
+    }
+}
+
+#[cfg(test)]
+#[path = "type_ids/type_ids_tests.rs"]
+mod type_ids_tests;
@@ -0,0 +1,45 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+#[test]
+fn TypeTagIds___new___numbers_tags_from_one() {
+    let ids = TypeTagIds::new(["echo", "greet"]);
+
+    assert_eq!(ids.resolve("echo"), 1);
+    assert_eq!(ids.resolve("greet"), 2);
+    assert_eq!(ids.tag(1), Some("echo"));
+    assert_eq!(ids.tag(2), Some("greet"));
+}
+
+#[test]
+fn TypeTagIds___repeated_tag___keeps_first_id() {
+    let ids = TypeTagIds::new(["echo", "greet", "echo"]);
+
+    assert_eq!(ids.resolve("echo"), 1);
+    assert_eq!(ids.tag(3), None);
+}
+
+#[test]
+fn TypeTagIds___unknown_tag___resolves_to_zero() {
+    let ids = TypeTagIds::new(["echo"]);
+
+    assert_eq!(ids.resolve("missing"), 0);
+}
+
+#[test]
+fn TypeTagIds___out_of_range_id___has_no_tag() {
+    let ids = TypeTagIds::new(["echo"]);
+
+    assert_eq!(ids.tag(0), None);
+    assert_eq!(ids.tag(2), None);
+    assert_eq!(ids.tag(u32::MAX), None);
+}
+
+#[test]
+fn TypeTagIds___default___is_empty() {
+    let ids = TypeTagIds::default();
+
+    assert_eq!(ids.resolve("echo"), 0);
+    assert_eq!(ids.tag(1), None);
+}
@@ -0,0 +1,340 @@
+//! Allocation budgets for the FFI hot paths
+//!
+//! A counting global allocator records allocations, bytes and frees made
+//! on the current thread, and each test asserts the exact counts for one
+//! call once the thread-local caches (buffer pool, hazard slots) are warm.
+//! A new allocation on one of these paths fails a test here rather than
+//! showing up later as a latency regression.
+//!
+//! Run with `--nocapture` to print the measured counts:
+//!
+//! ```text
+//! cargo test -p rustbridge-ffi --test alloc_budget_tests -- --nocapture
+//! ```
+
+#![allow(non_snake_case)]
+
+use async_trait::async_trait;
+use rustbridge_core::{Plugin, PluginContext, PluginError, PluginResult};
+use rustbridge_ffi::{
+    BinaryMessageHandler, PluginHandle, plugin_call, plugin_call_raw, plugin_call_raw_into,
+    plugin_free_buffer, plugin_init, plugin_shutdown, rb_response_free, register_binary_handler,
+};
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::cell::Cell;
+use std::ffi::{c_char, c_void};
+use std::ptr;
+
+/// Calls made before measuring, so per-thread caches are populated
+const WARMUP_CALLS: usize = 64;
+
+const MSG_ECHO: u32 = 0x7501;
+
+/// Heap activity on one thread
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+struct Allocs {
+    /// Allocations, including reallocations
+    count: u64,
+    /// Bytes requested by those allocations
+    bytes: u64,
+    /// Deallocations
+    frees: u64,
+}
+
+thread_local! {
+    static COUNTS: Cell<Allocs> = const {
+        Cell::new(Allocs { count: 0, bytes: 0, frees: 0 })
+    };
+}
+
+/// Counts heap activity per thread, so tests running in parallel and the
+/// plugin's runtime threads do not disturb each other's numbers
+struct CountingAllocator;
+
+fn count(update: impl FnOnce(&mut Allocs)) {
+    // The thread-local is gone while the thread exits; those calls are not counted
+    let _ = COUNTS.try_with(|counts| {
+        let mut value = counts.get();
+        update(&mut value);
+        counts.set(value);
+    });
+}
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        count(|c| {
+            c.count += 1;
+            c.bytes += layout.size() as u64;
+        });
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        count(|c| c.frees += 1);
+        unsafe { System.dealloc(ptr, layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        count(|c| {
+            c.count += 1;
+            c.bytes += new_size as u64;
+        });
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAllocator = CountingAllocator;
+
+/// Run `f` and return what it allocated and freed on this thread
+fn measure<R>(label: &str, f: impl FnOnce() -> R) -> (R, Allocs) {
+    let before = COUNTS.with(Cell::get);
+    let result = f();
+    let after = COUNTS.with(Cell::get);
+    let allocs = Allocs {
+        count: after.count - before.count,
+        bytes: after.bytes - before.bytes,
+        frees: after.frees - before.frees,
+    };
+    println!(
+        "{label:<40} {:>3} allocs {:>6} bytes {:>3} frees",
+        allocs.count, allocs.bytes, allocs.frees
+    );
+    (result, allocs)
+}
+
+/// Plugin whose handlers all answer synchronously
+struct BudgetPlugin;
+
+#[async_trait]
+impl Plugin for BudgetPlugin {
+    async fn on_start(&self, _context: &PluginContext) -> PluginResult<()> {
+        register_binary_handler(MSG_ECHO, echo_raw as BinaryMessageHandler);
+        Ok(())
+    }
+
+    async fn on_stop(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn handle_request(
+        &self,
+        _context: &PluginContext,
+        type_tag: &str,
+        _request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        Err(PluginError::UnknownMessageType(type_tag.to_string()))
+    }
+
+    fn handle_request_sync(
+        &self,
+        _ctx: &PluginContext,
+        type_tag: &str,
+        _payload: &[u8],
+    ) -> Option<PluginResult<Vec<u8>>> {
+        match type_tag {
+            "ping" => Some(Ok(br#"{"pong":true}"#.to_vec())),
+            "log" => {
+                tracing::info!("budget log event");
+                Some(Ok(b"{}".to_vec()))
+            }
+            _ => None,
+        }
+    }
+}
+
+fn echo_raw(_handle: &PluginHandle, request: &[u8]) -> PluginResult<Vec<u8>> {
+    Ok(request.to_vec())
+}
+
+extern "C" fn ignore_log(_level: u8, _target: *const c_char, _message: *const u8, _len: usize) {}
+
+fn init(config: &str, log_callback: Option<rustbridge_ffi::LogCallback>) -> *mut c_void {
+    let plugin: Box<dyn Plugin> = Box::new(BudgetPlugin);
+    let plugin_ptr = Box::into_raw(Box::new(plugin)) as *mut c_void;
+    // SAFETY: plugin_ptr is a boxed plugin and config is valid for its length
+    let handle = unsafe { plugin_init(plugin_ptr, config.as_ptr(), config.len(), log_callback) };
+    assert!(!handle.is_null());
+    handle
+}
+
+fn call(handle: *mut c_void, type_tag: &std::ffi::CStr) {
+    // SAFETY: handle is live and the request is valid for its length
+    unsafe {
+        let mut buffer = plugin_call(handle, type_tag.as_ptr(), b"{}".as_ptr(), 2);
+        assert_eq!(buffer.error_code, 0);
+        plugin_free_buffer(&mut buffer);
+    }
+}
+
+fn call_raw(handle: *mut c_void, message_id: u32, request: &[u8]) {
+    // SAFETY: handle is live and the request is valid for its length
+    unsafe {
+        let mut response = plugin_call_raw(
+            handle,
+            message_id,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        );
+        rb_response_free(&mut response);
+    }
+}
+
+#[test]
+fn plugin_call_raw___success___allocates_only_the_handler_response() {
+    let handle = init("{}", None);
+    let request = [7u8; 16];
+    for _ in 0..WARMUP_CALLS {
+        call_raw(handle, MSG_ECHO, &request);
+    }
+
+    let (mut response, call) = measure("plugin_call_raw", || unsafe {
+        plugin_call_raw(
+            handle,
+            MSG_ECHO,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        )
+    });
+    let (_, free) = measure("rb_response_free (16 B, unpooled)", || unsafe {
+        rb_response_free(&mut response)
+    });
+
+    assert_eq!(
+        call,
+        Allocs {
+            count: 1,
+            bytes: 16,
+            frees: 0
+        }
+    );
+    assert_eq!(
+        free,
+        Allocs {
+            count: 0,
+            bytes: 0,
+            frees: 1
+        }
+    );
+    unsafe { plugin_shutdown(handle) };
+}
+
+#[test]
+fn plugin_call_raw___unknown_message___allocates_nothing_when_warm() {
+    let handle = init("{}", None);
+    for _ in 0..WARMUP_CALLS {
+        call_raw(handle, 0x7502, &[]);
+    }
+
+    let (_, allocs) = measure("plugin_call_raw (unknown ID) + free", || {
+        call_raw(handle, 0x7502, &[])
+    });
+
+    assert_eq!(allocs, Allocs::default());
+    unsafe { plugin_shutdown(handle) };
+}
+
+#[test]
+fn plugin_call_raw_into___unknown_message___allocates_nothing_when_warm() {
+    let handle = init("{}", None);
+    let mut out = [0u8; 64];
+    let mut out_len = 0usize;
+    let mut call_into = || unsafe {
+        plugin_call_raw_into(
+            handle,
+            0x7503,
+            ptr::null(),
+            0,
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            &mut out_len,
+        )
+    };
+    for _ in 0..WARMUP_CALLS {
+        call_into();
+    }
+
+    let (code, allocs) = measure("plugin_call_raw_into (unknown ID)", call_into);
+
+    assert_eq!(code, 6);
+    assert_eq!(&out[..out_len], b"Unknown message ID: 29955");
+    assert_eq!(allocs, Allocs::default());
+    unsafe { plugin_shutdown(handle) };
+}
+
+#[test]
+fn plugin_call_raw_into___invalid_handle___allocates_nothing() {
+    let mut out = [0u8; 64];
+    let mut out_len = 0usize;
+
+    let (code, allocs) = measure("plugin_call_raw_into (invalid handle)", || unsafe {
+        plugin_call_raw_into(
+            999_999 as *mut c_void,
+            MSG_ECHO,
+            ptr::null(),
+            0,
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            &mut out_len,
+        )
+    });
+
+    assert_eq!(code, 1);
+    assert_eq!(&out[..out_len], b"Invalid handle");
+    assert_eq!(allocs, Allocs::default());
+}
+
+#[test]
+fn plugin_call___sync_handler___allocates_only_the_handler_response() {
+    let handle = init("{}", None);
+    for _ in 0..WARMUP_CALLS {
+        call(handle, c"ping");
+    }
+
+    let (mut buffer, call) = measure("plugin_call", || unsafe {
+        plugin_call(handle, c"ping".as_ptr(), b"{}".as_ptr(), 2)
+    });
+    let (_, free) = measure("plugin_free_buffer (pooled)", || unsafe {
+        plugin_free_buffer(&mut buffer)
+    });
+
+    // The handler's payload is copied into a pooled envelope and dropped
+    assert_eq!(
+        call,
+        Allocs {
+            count: 1,
+            bytes: 13,
+            frees: 1
+        }
+    );
+    assert_eq!(free, Allocs::default());
+    unsafe { plugin_shutdown(handle) };
+}
+
+#[test]
+fn plugin_call___invalid_handle___allocates_nothing() {
+    let (mut buffer, allocs) = measure("plugin_call (invalid handle)", || unsafe {
+        plugin_call(999_999 as *mut c_void, c"ping".as_ptr(), ptr::null(), 0)
+    });
+
+    assert_eq!(buffer.error_code, 1);
+    assert_eq!(allocs, Allocs::default());
+    unsafe { plugin_free_buffer(&mut buffer) };
+}
+
+#[test]
+fn log_event___sync_callback___allocates_message_and_target() {
+    let handle = init(r#"{"log_level": "info"}"#, Some(ignore_log));
+    for _ in 0..WARMUP_CALLS {
+        call(handle, c"ping");
+        call(handle, c"log");
+    }
+    let (_, without_log) = measure("plugin_call", || call(handle, c"ping"));
+
+    let (_, with_log) = measure("plugin_call + one log event", || call(handle, c"log"));
+
+    // The formatted message and the NUL-terminated target for the callback
+    assert_eq!(with_log.count - without_log.count, 2);
+    assert_eq!(with_log.frees - without_log.frees, 2);
+    unsafe { plugin_shutdown(handle) };
+}
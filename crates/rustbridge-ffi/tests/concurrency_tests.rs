@@ -321,3 +321,96 @@ fn test_rapid_register_remove_no_leak() {
         "Manager should be clean after all removals"
     );
 }
+
+#[test]
+fn test_concurrent_lookup_during_remove_and_reregister() {
+    let manager = Arc::new(PluginHandleManager::new());
+    let num_readers = 8;
+    let rounds = 10;
+    let barrier = Arc::new(Barrier::new(num_readers + 1));
+    let current = Arc::new(std::sync::atomic::AtomicU64::new(0));
+    let done = Arc::new(std::sync::atomic::AtomicBool::new(false));
+
+    let readers: Vec<_> = (0..num_readers)
+        .map(|_| {
+            let manager = manager.clone();
+            let barrier = barrier.clone();
+            let current = current.clone();
+            let done = done.clone();
+            thread::spawn(move || {
+                barrier.wait();
+                let mut hits = 0u64;
+                while !done.load(std::sync::atomic::Ordering::Acquire) {
+                    let id = current.load(std::sync::atomic::Ordering::Acquire);
+                    if let Some(handle) = manager.lookup(id) {
+                        // A resolved ID must always map to its own handle
+                        assert_eq!(handle.id(), Some(id));
+                        hits += 1;
+                    }
+                }
+                hits
+            })
+        })
+        .collect();
+
+    barrier.wait();
+    let mut stale = vec![];
+    for _ in 0..rounds {
+        let handle = PluginHandle::new(Box::new(TestPlugin::new()), PluginConfig::default())
+            .expect("Should create handle");
+        let id = manager.register(handle);
+        current.store(id, std::sync::atomic::Ordering::Release);
+        thread::sleep(std::time::Duration::from_millis(5));
+        assert!(
+            manager.remove(id).is_some(),
+            "Handle {} should be removed",
+            id
+        );
+        stale.push(id);
+    }
+    done.store(true, std::sync::atomic::Ordering::Release);
+
+    for reader in readers {
+        reader.join().expect("Reader should complete");
+    }
+    for id in stale {
+        assert!(
+            manager.lookup(id).is_none(),
+            "Stale ID {} should not resolve",
+            id
+        );
+    }
+    assert!(manager.is_empty(), "Manager should be empty");
+}
+
+#[test]
+fn test_concurrent_lookups_share_handle_without_refcount() {
+    let manager = Arc::new(PluginHandleManager::new());
+    let handle = PluginHandle::new(Box::new(TestPlugin::new()), PluginConfig::default())
+        .expect("Should create handle");
+    let id = manager.register(handle);
+    let num_threads = 16;
+    let barrier = Arc::new(Barrier::new(num_threads));
+
+    let threads: Vec<_> = (0..num_threads)
+        .map(|_| {
+            let manager = manager.clone();
+            let barrier = barrier.clone();
+            thread::spawn(move || {
+                barrier.wait();
+                for _ in 0..10_000 {
+                    let handle = manager.lookup(id).expect("Handle should resolve");
+                    assert_eq!(handle.id(), Some(id));
+                }
+            })
+        })
+        .collect();
+
+    for t in threads {
+        t.join().expect("Thread should complete");
+    }
+
+    // Lookups never took a strong reference
+    let removed = manager.remove(id).expect("Handle should be removed");
+    assert_eq!(Arc::strong_count(&removed), 1);
+}
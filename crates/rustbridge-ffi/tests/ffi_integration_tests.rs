@@ -8,15 +8,33 @@
 #![allow(non_snake_case)]
 
 use async_trait::async_trait;
-use rustbridge_core::{Plugin, PluginContext, PluginError, PluginResult};
+use rustbridge_core::{
+    BoxResponseStream, ContentType, IterStream, OnceStream, Plugin, PluginContext, PluginError,
+    PluginResult, RequestReader,
+};
 use rustbridge_ffi::{
-    plugin_call, plugin_get_rejected_count, plugin_get_state, plugin_init, plugin_shutdown,
+    BinaryLayout, BinaryMessageHandler, BinaryStruct, PluginHandle, RB_BATCH_PARALLEL,
+    RB_CALL_KIND_JSON, RB_RING_MAX_CAPACITY, RB_SLOW_CALL_ASYNC_HANDLER, RB_SLOW_CALL_ERROR,
+    RbAdmissionStats, RbBatchRequest, RbResponse, RbRingChannel, RbRingFrame, RbSlowCall,
+    RingChannel, plugin_call, plugin_call_as, plugin_call_async, plugin_call_id, plugin_call_raw,
+    plugin_call_raw_batch, plugin_call_raw_into, plugin_cancel_async, plugin_get_admission_stats,
+    plugin_get_metrics, plugin_get_rejected_count, plugin_get_slow_calls, plugin_get_state,
+    plugin_init, plugin_input_abort, plugin_input_finish, plugin_input_open, plugin_input_write,
+    plugin_resolve_type_tag, plugin_ring_close, plugin_ring_notify, plugin_ring_open,
+    plugin_ring_wait, plugin_shutdown, plugin_stream_close, plugin_stream_next, plugin_stream_open,
+    rb_response_free, register_binary_handler, register_binary_into_handler,
+    register_binary_request,
 };
 use serde::{Deserialize, Serialize};
 use std::ffi::c_void;
 use std::sync::atomic::{AtomicU64, Ordering};
-use std::sync::{Arc, Barrier};
+use std::sync::{Arc, Barrier, mpsc};
 use std::thread;
+use std::time::Duration;
+use tokio::io::AsyncReadExt;
+
+/// Chunks produced so far by the "endless" stream
+static ENDLESS_PRODUCED: AtomicU64 = AtomicU64::new(0);
 
 /// Test plugin that echoes requests and tracks call count
 struct EchoPlugin {
@@ -80,6 +98,105 @@ impl Plugin for EchoPlugin {
             _ => Err(PluginError::UnknownMessageType(type_tag.to_string())),
         }
     }
+
+    async fn handle_request_as(
+        &self,
+        context: &PluginContext,
+        type_tag: &str,
+        content_type: ContentType,
+        request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        if content_type != ContentType::MsgPack || type_tag != "echo" {
+            return match content_type {
+                ContentType::Json => self.handle_request(context, type_tag, request).await,
+                other => Err(PluginError::UnsupportedContentType(
+                    other.mime().to_string(),
+                )),
+            };
+        }
+        let call_num = self.call_count.fetch_add(1, Ordering::Relaxed) + 1;
+        let req: EchoRequest = rustbridge_transport::decode_as(content_type, request)?;
+        let response = EchoResponse {
+            message: req.message,
+            call_number: call_num,
+        };
+        Ok(rustbridge_transport::encode_as(content_type, &response)?)
+    }
+
+    async fn handle_request_stream(
+        &self,
+        context: &PluginContext,
+        type_tag: &str,
+        request: &[u8],
+    ) -> PluginResult<BoxResponseStream> {
+        let stream: BoxResponseStream = match type_tag {
+            "chunks" => {
+                let count: usize = std::str::from_utf8(request)
+                    .ok()
+                    .and_then(|s| s.parse().ok())
+                    .ok_or_else(|| PluginError::SerializationError("expected a count".into()))?;
+                let chunks = (0..count).map(|i| Ok(format!("chunk-{};", i).into_bytes()));
+                Box::new(IterStream::new(chunks))
+            }
+            "endless" => Box::new(IterStream::new((0..).map(|i: u64| {
+                ENDLESS_PRODUCED.fetch_add(1, Ordering::SeqCst);
+                Ok(i.to_le_bytes().to_vec())
+            }))),
+            "failing" => Box::new(IterStream::new(
+                vec![
+                    Ok(b"first".to_vec()),
+                    Err(PluginError::HandlerError("stream broke".to_string())),
+                ]
+                .into_iter(),
+            )),
+            "panicking" => Box::new(IterStream::new(std::iter::from_fn(
+                || -> Option<PluginResult<Vec<u8>>> { panic!("stream panic") },
+            ))),
+            _ => {
+                let response = self.handle_request(context, type_tag, request).await?;
+                Box::new(OnceStream::new(response))
+            }
+        };
+        Ok(stream)
+    }
+
+    async fn handle_request_reader(
+        &self,
+        context: &PluginContext,
+        type_tag: &str,
+        request: &mut RequestReader,
+    ) -> PluginResult<Vec<u8>> {
+        match type_tag {
+            "count" => {
+                let mut buf = vec![0u8; 4096];
+                let mut total = 0usize;
+                loop {
+                    let n = request
+                        .read(&mut buf)
+                        .await
+                        .map_err(|e| PluginError::Internal(e.to_string()))?;
+                    if n == 0 {
+                        break;
+                    }
+                    total += n;
+                }
+                Ok(format!(r#"{{"bytes":{}}}"#, total).into_bytes())
+            }
+            "stall" => std::future::pending().await,
+            _ => {
+                let mut payload = Vec::new();
+                request
+                    .read_to_end(&mut payload)
+                    .await
+                    .map_err(|e| PluginError::Internal(e.to_string()))?;
+                self.handle_request(context, type_tag, &payload).await
+            }
+        }
+    }
+
+    fn supported_types(&self) -> Vec<&'static str> {
+        vec!["echo", "slow"]
+    }
 }
 
 /// Helper to create a plugin pointer (simulates plugin_create)
@@ -186,6 +303,35 @@ fn plugin_call___echo_request___returns_response() {
     }
 }
 
+#[test]
+fn plugin_call___reencode_response_encoding___returns_same_envelope() {
+    unsafe {
+        let request = r#"{"message": "hello"}"#;
+        let mut envelopes = Vec::new();
+
+        for config in [
+            r#"{"response_encoding": "splice"}"#,
+            r#"{"response_encoding": "reencode"}"#,
+        ] {
+            let plugin_ptr = create_test_plugin();
+            let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+            assert!(!handle.is_null());
+
+            let mut result = plugin_call(handle, c"echo".as_ptr(), request.as_ptr(), request.len());
+            assert!(!result.is_error());
+            let envelope: serde_json::Value = serde_json::from_slice(result.as_slice()).unwrap();
+            envelopes.push(envelope);
+
+            result.free();
+            plugin_shutdown(handle);
+        }
+
+        assert_eq!(envelopes[0], envelopes[1]);
+        assert_eq!(envelopes[0]["status"], "success");
+        assert_eq!(envelopes[0]["payload"]["message"], "hello");
+    }
+}
+
 #[test]
 fn plugin_call___multiple_calls___increments_counter() {
     unsafe {
@@ -238,6 +384,82 @@ fn plugin_call___unknown_type_tag___returns_error() {
     }
 }
 
+#[test]
+fn plugin_resolve_type_tag___supported_types___get_distinct_nonzero_ids() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+
+        let echo = plugin_resolve_type_tag(handle, c"echo".as_ptr());
+        let slow = plugin_resolve_type_tag(handle, c"slow".as_ptr());
+
+        assert_ne!(echo, 0);
+        assert_ne!(slow, 0);
+        assert_ne!(echo, slow);
+        assert_eq!(plugin_resolve_type_tag(handle, c"echo".as_ptr()), echo);
+        assert_eq!(plugin_resolve_type_tag(handle, c"unknown".as_ptr()), 0);
+        assert_eq!(plugin_resolve_type_tag(handle, std::ptr::null()), 0);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_id___resolved_id___matches_plugin_call() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let request = r#"{"message": "by id"}"#;
+
+        let echo = plugin_resolve_type_tag(handle, c"echo".as_ptr());
+        let mut result = plugin_call_id(handle, echo, request.as_ptr(), request.len());
+
+        assert!(!result.is_error());
+        let envelope: serde_json::Value = serde_json::from_slice(result.as_slice()).unwrap();
+        let response: EchoResponse = serde_json::from_value(envelope["payload"].clone()).unwrap();
+        assert_eq!(response.message, "by id");
+
+        result.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_id___unknown_id___returns_code_6() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+
+        let mut result = plugin_call_id(handle, 999, std::ptr::null(), 0);
+
+        assert_eq!(result.error_code, 6);
+
+        result.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_id___after_shutdown___returns_error() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let echo = plugin_resolve_type_tag(handle, c"echo".as_ptr());
+        plugin_shutdown(handle);
+        let request = r#"{"message": "late"}"#;
+
+        let mut result = plugin_call_id(handle, echo, request.as_ptr(), request.len());
+
+        assert!(result.is_error());
+
+        result.free();
+    }
+}
+
 #[test]
 fn plugin_get_rejected_count___no_rejections___returns_zero() {
     unsafe {
@@ -252,6 +474,301 @@ fn plugin_get_rejected_count___no_rejections___returns_zero() {
     }
 }
 
+#[test]
+fn plugin_call_as___msgpack_echo___returns_unwrapped_msgpack() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let request = rustbridge_transport::encode_as(
+            ContentType::MsgPack,
+            &EchoRequest {
+                message: "packed".to_string(),
+            },
+        )
+        .unwrap();
+
+        let mut result = plugin_call_as(
+            handle,
+            c"echo".as_ptr(),
+            c"application/msgpack".as_ptr(),
+            request.as_ptr(),
+            request.len(),
+        );
+
+        assert_eq!(result.error_code, 0);
+        let response: EchoResponse =
+            rustbridge_transport::decode_as(ContentType::MsgPack, result.as_slice()).unwrap();
+        assert_eq!(response.message, "packed");
+        assert_eq!(response.call_number, 1);
+
+        result.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_as___null_content_type___returns_unwrapped_json() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let request = br#"{"message":"plain"}"#;
+
+        let mut result = plugin_call_as(
+            handle,
+            c"echo".as_ptr(),
+            std::ptr::null(),
+            request.as_ptr(),
+            request.len(),
+        );
+
+        assert_eq!(result.error_code, 0);
+        let response: EchoResponse = serde_json::from_slice(result.as_slice()).unwrap();
+        assert_eq!(response.message, "plain");
+
+        result.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_as___unsupported_content_type___returns_code_15() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+
+        let mut unknown = plugin_call_as(
+            handle,
+            c"echo".as_ptr(),
+            c"application/cbor".as_ptr(),
+            std::ptr::null(),
+            0,
+        );
+        let mut unimplemented = plugin_call_as(
+            handle,
+            c"echo".as_ptr(),
+            c"application/x-rustbridge-flat".as_ptr(),
+            std::ptr::null(),
+            0,
+        );
+
+        assert_eq!(unknown.error_code, 15);
+        assert!(String::from_utf8_lossy(unknown.as_slice()).contains("application/cbor"));
+        assert_eq!(unimplemented.error_code, 15);
+
+        unknown.free();
+        unimplemented.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_admission_stats___active_plugin___reports_limit_and_admissions() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let config = br#"{"max_concurrent_ops": 8, "admission": {"mode": "fifo"}}"#;
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        assert!(!handle.is_null());
+        let request = br#"{"message":"hi"}"#;
+        let type_tag = c"echo";
+        let mut buffer = plugin_call(handle, type_tag.as_ptr(), request.as_ptr(), request.len());
+        buffer.free();
+
+        let mut stats = RbAdmissionStats::default();
+        let ok = plugin_get_admission_stats(handle, &mut stats);
+
+        assert!(ok);
+        assert_eq!(stats.limit, 8);
+        assert_eq!(stats.admitted, 1);
+        assert_eq!(stats.in_flight, 0);
+        assert_eq!(stats.rejected, 0);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_admission_stats___invalid_args___returns_false() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let mut stats = RbAdmissionStats::default();
+
+        assert!(!plugin_get_admission_stats(handle, std::ptr::null_mut()));
+        assert!(!plugin_get_admission_stats(
+            999_999 as *mut c_void,
+            &mut stats
+        ));
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_metrics___disabled___reports_enabled_false() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let request = r#"{"message": "hi"}"#;
+        let mut result = plugin_call(handle, c"echo".as_ptr(), request.as_ptr(), request.len());
+        result.free();
+
+        let mut metrics = plugin_get_metrics(handle);
+
+        assert!(!metrics.is_error());
+        let snapshot: serde_json::Value = serde_json::from_slice(metrics.as_slice()).unwrap();
+        assert_eq!(snapshot["enabled"], false);
+        assert_eq!(snapshot["handlers"], serde_json::json!([]));
+
+        metrics.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_metrics___enabled___counts_calls_per_type_tag() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let config = r#"{"metrics": {"enabled": true}}"#;
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        assert!(!handle.is_null());
+        let request = r#"{"message": "hi"}"#;
+        let echo = plugin_resolve_type_tag(handle, c"echo".as_ptr());
+        for _ in 0..3 {
+            let mut result = plugin_call(handle, c"echo".as_ptr(), request.as_ptr(), request.len());
+            result.free();
+        }
+        let mut result = plugin_call_id(handle, echo, request.as_ptr(), request.len());
+        result.free();
+
+        let mut metrics = plugin_get_metrics(handle);
+
+        let snapshot: serde_json::Value = serde_json::from_slice(metrics.as_slice()).unwrap();
+        assert_eq!(snapshot["enabled"], true);
+        let handlers = snapshot["handlers"].as_array().unwrap();
+        assert_eq!(handlers.len(), 1);
+        assert_eq!(handlers[0]["kind"], "json");
+        assert_eq!(handlers[0]["type_tag"], "echo");
+        assert_eq!(handlers[0]["calls"], 4);
+        assert_eq!(handlers[0]["errors"], 0);
+        for phase in ["queue", "dispatch", "handler", "serialize"] {
+            assert_eq!(handlers[0][phase]["count"], 4, "{phase}");
+        }
+
+        metrics.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_metrics___binary_calls___counted_by_message_id() {
+    fn ok(_handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, PluginError> {
+        Ok(request.to_vec())
+    }
+    const MESSAGE_ID: u32 = 0x7401;
+    register_binary_handler(MESSAGE_ID, ok as BinaryMessageHandler);
+
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let config = r#"{"metrics": {"enabled": true}}"#;
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        assert!(!handle.is_null());
+        let request = [1u8, 2, 3];
+        let mut response = plugin_call_raw(
+            handle,
+            MESSAGE_ID,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        );
+        rb_response_free(&mut response);
+        let mut unknown = plugin_call_raw(handle, 0x7402, std::ptr::null(), 0);
+        rb_response_free(&mut unknown);
+
+        let mut metrics = plugin_get_metrics(handle);
+
+        let snapshot: serde_json::Value = serde_json::from_slice(metrics.as_slice()).unwrap();
+        let handlers = snapshot["handlers"].as_array().unwrap();
+        let catch_all = handlers
+            .iter()
+            .find(|h| h["kind"] == "binary" && h.get("message_id").is_none())
+            .unwrap();
+        assert_eq!(catch_all["errors"], 1);
+        let known = handlers
+            .iter()
+            .find(|h| h["message_id"] == MESSAGE_ID)
+            .unwrap();
+        assert_eq!(known["calls"], 1);
+        assert_eq!(known["queue"]["count"], 0);
+        assert_eq!(known["handler"]["count"], 1);
+
+        metrics.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_slow_calls___disabled___returns_zero() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let mut result = plugin_call(handle, c"slow".as_ptr(), b"{}".as_ptr(), 2);
+        result.free();
+
+        let mut calls = [RbSlowCall::default(); 4];
+        let count = plugin_get_slow_calls(handle, calls.as_mut_ptr(), calls.len());
+
+        assert_eq!(count, 0);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_slow_calls___enabled___keeps_only_calls_over_threshold() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let config = r#"{"flight_recorder": {"enabled": true, "slow_call_threshold_us": 50000}}"#;
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        assert!(!handle.is_null());
+        let request = r#"{"message": "hi"}"#;
+        for _ in 0..3 {
+            let mut result = plugin_call(handle, c"echo".as_ptr(), request.as_ptr(), request.len());
+            result.free();
+        }
+        let mut result = plugin_call(handle, c"slow".as_ptr(), b"{}".as_ptr(), 2);
+        result.free();
+
+        let mut calls = [RbSlowCall::default(); 4];
+        let count = plugin_get_slow_calls(handle, calls.as_mut_ptr(), calls.len());
+
+        assert_eq!(count, 1);
+        let call = calls[0];
+        assert_eq!(call.kind, RB_CALL_KIND_JSON);
+        assert_eq!(call.id, plugin_resolve_type_tag(handle, c"slow".as_ptr()));
+        assert!(call.handler_ns >= 100_000_000);
+        assert!(call.total_ns >= call.handler_ns);
+        assert_eq!(call.flags & RB_SLOW_CALL_ERROR, 0);
+        assert_ne!(call.flags & RB_SLOW_CALL_ASYNC_HANDLER, 0);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_get_slow_calls___null_out___returns_zero() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let config = r#"{"flight_recorder": {"enabled": true, "slow_call_threshold_us": 0}}"#;
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        assert!(!handle.is_null());
+        let mut result = plugin_call(handle, c"slow".as_ptr(), b"{}".as_ptr(), 2);
+        result.free();
+
+        assert_eq!(plugin_get_slow_calls(handle, std::ptr::null_mut(), 4), 0);
+
+        plugin_shutdown(handle);
+    }
+}
+
 #[test]
 fn plugin_shutdown___active_plugin___returns_true() {
     unsafe {
@@ -648,3 +1165,1112 @@ fn handle___get_state_after_shutdown___returns_invalid() {
         );
     }
 }
+
+// =============================================================================
+// Async API Tests
+// =============================================================================
+
+type AsyncCompletion = (u64, u32, Vec<u8>);
+
+extern "C" fn async_completion(
+    context: *mut c_void,
+    request_id: u64,
+    data: *const u8,
+    len: usize,
+    error_code: u32,
+) {
+    let tx = unsafe { &*(context as *const mpsc::Sender<AsyncCompletion>) };
+    let bytes = unsafe { std::slice::from_raw_parts(data, len) }.to_vec();
+    let _ = tx.send((request_id, error_code, bytes));
+}
+
+/// Leaked so a callback still returning from `send` never sees it freed
+fn async_channel() -> (*mut c_void, mpsc::Receiver<AsyncCompletion>) {
+    let (tx, rx) = mpsc::channel();
+    let tx: &'static mpsc::Sender<AsyncCompletion> = Box::leak(Box::new(tx));
+    (
+        tx as *const mpsc::Sender<AsyncCompletion> as *mut c_void,
+        rx,
+    )
+}
+
+#[test]
+fn plugin_call_async___echo_request___invokes_callback() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let (context, rx) = async_channel();
+
+        let request = r#"{"message": "async"}"#;
+        let request_id = plugin_call_async(
+            handle,
+            c"echo".as_ptr(),
+            request.as_ptr(),
+            request.len(),
+            async_completion,
+            context,
+        );
+        assert_ne!(request_id, 0, "Async submission should succeed");
+
+        let (id, error_code, data) = rx
+            .recv_timeout(Duration::from_secs(5))
+            .expect("Callback should be invoked");
+        assert_eq!(id, request_id);
+        assert_eq!(error_code, 0);
+
+        let envelope: serde_json::Value = serde_json::from_slice(&data).unwrap();
+        let response: EchoResponse = serde_json::from_value(envelope["payload"].clone()).unwrap();
+        assert_eq!(response.message, "async");
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_async___many_requests___all_complete() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let (context, rx) = async_channel();
+
+        let request = r#"{"message": "batch"}"#;
+        let mut ids = std::collections::HashSet::new();
+        for _ in 0..50 {
+            let request_id = plugin_call_async(
+                handle,
+                c"echo".as_ptr(),
+                request.as_ptr(),
+                request.len(),
+                async_completion,
+                context,
+            );
+            assert_ne!(request_id, 0);
+            ids.insert(request_id);
+        }
+
+        // Every submitted request completes exactly once
+        for _ in 0..50 {
+            let (id, error_code, _) = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+            assert_eq!(error_code, 0);
+            assert!(ids.remove(&id), "Unexpected or duplicate request ID {}", id);
+        }
+        assert!(ids.is_empty());
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_cancel_async___completed_request___returns_false() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let (context, rx) = async_channel();
+
+        let request = r#"{"message": "done"}"#;
+        let request_id = plugin_call_async(
+            handle,
+            c"echo".as_ptr(),
+            request.as_ptr(),
+            request.len(),
+            async_completion,
+            context,
+        );
+        rx.recv_timeout(Duration::from_secs(5)).unwrap();
+
+        assert!(!plugin_cancel_async(handle, request_id));
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_async___after_shutdown___returns_zero() {
+    unsafe {
+        let plugin_ptr = create_test_plugin();
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        assert!(!handle.is_null());
+        let (context, _rx) = async_channel();
+        plugin_shutdown(handle);
+
+        let request_id = plugin_call_async(
+            handle,
+            c"echo".as_ptr(),
+            std::ptr::null(),
+            0,
+            async_completion,
+            context,
+        );
+
+        assert_eq!(request_id, 0);
+    }
+}
+
+// =============================================================================
+// Batch Binary Transport Tests
+// =============================================================================
+
+const MSG_DOUBLE: u32 = 0x7101;
+const MSG_UNREGISTERED: u32 = 0x7102;
+const MSG_PANIC: u32 = 0x7103;
+
+fn double_handler(_handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    let bytes: [u8; 8] = request
+        .try_into()
+        .map_err(|_| PluginError::SerializationError("expected u64".to_string()))?;
+    Ok((u64::from_le_bytes(bytes) * 2).to_le_bytes().to_vec())
+}
+
+fn panicking_handler(_handle: &PluginHandle, _request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    panic!("batch handler panic")
+}
+
+/// Run a batch of doubling requests and return each response's (error_code, data)
+unsafe fn run_double_batch(
+    handle: *mut c_void,
+    values: &[u64],
+    message_ids: &[u32],
+    flags: u32,
+) -> (u32, Vec<(u32, Vec<u8>)>) {
+    let payloads: Vec<[u8; 8]> = values.iter().map(|v| v.to_le_bytes()).collect();
+    let requests: Vec<RbBatchRequest> = payloads
+        .iter()
+        .zip(message_ids)
+        .map(|(payload, id)| RbBatchRequest::new(*id, payload))
+        .collect();
+    let mut responses: Vec<RbResponse> = Vec::with_capacity(requests.len());
+
+    let code = unsafe {
+        plugin_call_raw_batch(
+            handle,
+            requests.as_ptr(),
+            requests.len(),
+            responses.as_mut_ptr(),
+            flags,
+        )
+    };
+    if code != 0 {
+        return (code, Vec::new());
+    }
+    // SAFETY: a successful batch fills every response slot
+    unsafe { responses.set_len(requests.len()) };
+
+    let results = responses
+        .iter_mut()
+        .map(|response| {
+            let data = unsafe {
+                std::slice::from_raw_parts(response.data as *const u8, response.len as usize)
+            }
+            .to_vec();
+            let error_code = response.error_code;
+            unsafe { rb_response_free(response) };
+            (error_code, data)
+        })
+        .collect();
+    (code, results)
+}
+
+#[test]
+fn plugin_call_raw_batch___sequential___returns_responses_in_order() {
+    register_binary_handler(MSG_DOUBLE, double_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        let values: Vec<u64> = (1..=16).collect();
+        let ids = vec![MSG_DOUBLE; values.len()];
+
+        let (code, results) = run_double_batch(handle, &values, &ids, 0);
+
+        assert_eq!(code, 0);
+        assert_eq!(results.len(), values.len());
+        for (value, (error_code, data)) in values.iter().zip(&results) {
+            assert_eq!(*error_code, 0);
+            assert_eq!(data.as_slice(), (value * 2).to_le_bytes());
+        }
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___parallel___returns_responses_in_order() {
+    register_binary_handler(MSG_DOUBLE, double_handler);
+    let plugin_ptr = create_test_plugin();
+    let config = br#"{"worker_threads": 4}"#;
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, config.as_ptr(), config.len(), None);
+        let values: Vec<u64> = (1..=103).collect();
+        let ids = vec![MSG_DOUBLE; values.len()];
+
+        let (code, results) = run_double_batch(handle, &values, &ids, RB_BATCH_PARALLEL);
+
+        assert_eq!(code, 0);
+        assert_eq!(results.len(), values.len());
+        for (value, (error_code, data)) in values.iter().zip(&results) {
+            assert_eq!(*error_code, 0);
+            assert_eq!(data.as_slice(), (value * 2).to_le_bytes());
+        }
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___mixed_outcomes___reports_errors_per_message() {
+    register_binary_handler(MSG_DOUBLE, double_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        let values = [5u64, 6, 7];
+        let ids = [MSG_DOUBLE, MSG_UNREGISTERED, MSG_DOUBLE];
+
+        let (code, results) = run_double_batch(handle, &values, &ids, 0);
+
+        // The bad message fails on its own; its neighbours still succeed
+        assert_eq!(code, 0);
+        assert_eq!(results[0].0, 0);
+        assert_eq!(results[0].1.as_slice(), 10u64.to_le_bytes());
+        assert_eq!(results[1].0, 6);
+        assert_eq!(results[2].0, 0);
+        assert_eq!(results[2].1.as_slice(), 14u64.to_le_bytes());
+        assert_eq!(plugin_get_state(handle), 2);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___handler_panics___rejects_rest_of_batch() {
+    register_binary_handler(MSG_DOUBLE, double_handler);
+    register_binary_handler(MSG_PANIC, panicking_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        let values = [5u64, 6, 7];
+        let ids = [MSG_DOUBLE, MSG_PANIC, MSG_DOUBLE];
+
+        let (code, results) = run_double_batch(handle, &values, &ids, 0);
+
+        // The panic fails the plugin, so the message after it never runs
+        assert_eq!(code, 0);
+        assert_eq!(results[0].0, 0);
+        assert_eq!(results[0].1.as_slice(), 10u64.to_le_bytes());
+        assert_eq!(results[1].0, 11);
+        assert_eq!(results[2].0, 1);
+        assert_eq!(plugin_get_state(handle), 5);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_batch___after_shutdown___returns_invalid_handle() {
+    register_binary_handler(MSG_DOUBLE, double_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+        plugin_shutdown(handle);
+
+        let (code, results) = run_double_batch(handle, &[1], &[MSG_DOUBLE], 0);
+
+        assert_eq!(code, 1);
+        assert!(results.is_empty());
+    }
+}
+
+// =============================================================================
+// Caller-Buffer Binary Transport Tests
+// =============================================================================
+
+const MSG_INTO_COPY: u32 = 0x7201;
+const MSG_INTO_DIRECT: u32 = 0x7202;
+
+/// Fills the output with the request's first byte repeated 32 times
+fn fill_into_handler(
+    _handle: &PluginHandle,
+    request: &[u8],
+    out: &mut [u8],
+) -> Result<usize, PluginError> {
+    let dest = out
+        .get_mut(..32)
+        .ok_or(PluginError::InsufficientCapacity { required: 32 })?;
+    dest.fill(request.first().copied().unwrap_or(0));
+    Ok(32)
+}
+
+/// Call plugin_call_raw_into and return (error_code, out_len, bytes written)
+unsafe fn call_into(
+    handle: *mut c_void,
+    message_id: u32,
+    request: &[u8],
+    capacity: usize,
+) -> (u32, usize, Vec<u8>) {
+    let mut out = vec![0u8; capacity];
+    let mut out_len = usize::MAX;
+    let code = unsafe {
+        plugin_call_raw_into(
+            handle,
+            message_id,
+            request.as_ptr() as *const c_void,
+            request.len(),
+            out.as_mut_ptr() as *mut c_void,
+            out.len(),
+            &mut out_len,
+        )
+    };
+    let written = if code == 14 { 0 } else { out_len };
+    out.truncate(written);
+    (code, out_len, out)
+}
+
+#[test]
+fn plugin_call_raw_into___allocating_handler___copies_response() {
+    register_binary_handler(MSG_INTO_COPY, double_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+
+        let (code, len, out) = call_into(handle, MSG_INTO_COPY, &21u64.to_le_bytes(), 16);
+
+        assert_eq!(code, 0);
+        assert_eq!(len, 8);
+        assert_eq!(out.as_slice(), 42u64.to_le_bytes());
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_into___allocating_handler_small_buffer___reports_required_size() {
+    register_binary_handler(MSG_INTO_COPY, double_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+
+        let (code, len, _) = call_into(handle, MSG_INTO_COPY, &21u64.to_le_bytes(), 4);
+
+        // Host can retry with `len` bytes or fall back to plugin_call_raw
+        assert_eq!(code, 14);
+        assert_eq!(len, 8);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_into___into_handler___writes_directly() {
+    register_binary_into_handler(MSG_INTO_DIRECT, fill_into_handler);
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+
+        let (code, len, out) = call_into(handle, MSG_INTO_DIRECT, &[7], 64);
+        let (small_code, required, _) = call_into(handle, MSG_INTO_DIRECT, &[7], 16);
+
+        assert_eq!(code, 0);
+        assert_eq!(len, 32);
+        assert!(out.iter().all(|b| *b == 7));
+        assert_eq!(small_code, 14);
+        assert_eq!(required, 32);
+
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_into___unknown_message_id___writes_error_message() {
+    let plugin_ptr = create_test_plugin();
+
+    unsafe {
+        let handle = plugin_init(plugin_ptr, std::ptr::null(), 0, None);
+
+        let (code, _, out) = call_into(handle, 0x72FF, &[], 64);
+
+        assert_eq!(code, 6);
+        assert!(String::from_utf8_lossy(&out).contains("Unknown message ID"));
+
+        plugin_shutdown(handle);
+    }
+}
+
+// =============================================================================
+// Binary Request Layout Tests
+// =============================================================================
+
+const MSG_LAYOUT: u32 = 0x7203;
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct LayoutRequest {
+    version: u8,
+    _reserved: [u8; 3],
+    value: u32,
+}
+
+// SAFETY: the layout matches the struct, which has only integer fields
+unsafe impl BinaryStruct for LayoutRequest {
+    const LAYOUT: BinaryLayout = BinaryLayout {
+        name: "LayoutRequest",
+        size: size_of::<LayoutRequest>(),
+        align: align_of::<LayoutRequest>(),
+        version: Some((std::mem::offset_of!(LayoutRequest, version), 1)),
+        strings: &[],
+        bytes: &[],
+    };
+}
+
+fn layout_handler(_handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    // SAFETY: MSG_LAYOUT is registered for LayoutRequest
+    let request = unsafe { LayoutRequest::from_request(request) };
+    Ok(request.value.to_le_bytes().to_vec())
+}
+
+fn layout_request_bytes(request: &LayoutRequest) -> &[u8] {
+    // SAFETY: LayoutRequest has no padding
+    unsafe {
+        std::slice::from_raw_parts(
+            request as *const LayoutRequest as *const u8,
+            size_of::<LayoutRequest>(),
+        )
+    }
+}
+
+fn register_layout_handler() {
+    register_binary_handler(MSG_LAYOUT, layout_handler);
+    register_binary_request::<LayoutRequest>(MSG_LAYOUT);
+}
+
+/// Call plugin_call_raw with MSG_LAYOUT and return (error_code, data)
+unsafe fn call_layout(handle: *mut c_void, request: &[u8]) -> (u32, Vec<u8>) {
+    let mut response = unsafe {
+        plugin_call_raw(
+            handle,
+            MSG_LAYOUT,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        )
+    };
+    let data =
+        unsafe { std::slice::from_raw_parts(response.data as *const u8, response.len as usize) }
+            .to_vec();
+    let error_code = response.error_code;
+    unsafe { rb_response_free(&mut response) };
+    (error_code, data)
+}
+
+#[test]
+fn plugin_call_raw___registered_layout___passes_valid_request_to_handler() {
+    register_layout_handler();
+    let request = LayoutRequest {
+        version: 1,
+        _reserved: [0; 3],
+        value: 42,
+    };
+
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+
+        let (code, data) = call_layout(handle, layout_request_bytes(&request));
+
+        assert_eq!(code, 0);
+        assert_eq!(data, 42u32.to_le_bytes());
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw___registered_layout___rejects_wrong_version_and_size() {
+    register_layout_handler();
+    let request = LayoutRequest {
+        version: 2,
+        _reserved: [0; 3],
+        value: 42,
+    };
+
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let bytes = layout_request_bytes(&request);
+
+        let (version_code, version_message) = call_layout(handle, bytes);
+        let (short_code, _) = call_layout(handle, &bytes[..4]);
+
+        assert_eq!(version_code, 5);
+        assert!(
+            String::from_utf8_lossy(&version_message)
+                .contains("Invalid LayoutRequest: unsupported version 2")
+        );
+        assert_eq!(short_code, 5);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_call_raw_into___registered_layout___rejects_short_request() {
+    register_layout_handler();
+
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+
+        let (code, _, out) = call_into(handle, MSG_LAYOUT, &[1], 64);
+
+        assert_eq!(code, 5);
+        assert!(String::from_utf8_lossy(&out).contains("1 bytes, expected 8"));
+
+        plugin_shutdown(handle);
+    }
+}
+
+// =============================================================================
+// Per-Plugin Binary Dispatch Tests
+// =============================================================================
+
+const MSG_PER_PLUGIN: u32 = 7;
+const MSG_LATE: u32 = 0x7301;
+
+/// Test plugin that registers a binary handler from on_start
+struct BinaryPlugin {
+    handler: BinaryMessageHandler,
+}
+
+#[async_trait]
+impl Plugin for BinaryPlugin {
+    async fn on_start(&self, _context: &PluginContext) -> PluginResult<()> {
+        register_binary_handler(MSG_PER_PLUGIN, self.handler);
+        Ok(())
+    }
+
+    async fn on_stop(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn handle_request(
+        &self,
+        _context: &PluginContext,
+        type_tag: &str,
+        _request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        Err(PluginError::UnknownMessageType(type_tag.to_string()))
+    }
+}
+
+fn create_binary_plugin(handler: BinaryMessageHandler) -> *mut c_void {
+    let plugin: Box<dyn Plugin> = Box::new(BinaryPlugin { handler });
+    let boxed: Box<Box<dyn Plugin>> = Box::new(plugin);
+    Box::into_raw(boxed) as *mut c_void
+}
+
+fn triple_handler(_handle: &PluginHandle, request: &[u8]) -> Result<Vec<u8>, PluginError> {
+    let bytes: [u8; 8] = request
+        .try_into()
+        .map_err(|_| PluginError::SerializationError("expected u64".to_string()))?;
+    Ok((u64::from_le_bytes(bytes) * 3).to_le_bytes().to_vec())
+}
+
+/// Call plugin_call_raw and return (error_code, data)
+unsafe fn call_raw_u64(handle: *mut c_void, message_id: u32, value: u64) -> (u32, Vec<u8>) {
+    let request = value.to_le_bytes();
+    let mut response = unsafe {
+        plugin_call_raw(
+            handle,
+            message_id,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        )
+    };
+    let data =
+        unsafe { std::slice::from_raw_parts(response.data as *const u8, response.len as usize) }
+            .to_vec();
+    let error_code = response.error_code;
+    unsafe { rb_response_free(&mut response) };
+    (error_code, data)
+}
+
+#[test]
+fn plugin_call_raw___two_plugins_same_message_id___dispatch_to_own_handler() {
+    unsafe {
+        let doubler = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+        let tripler = plugin_init(
+            create_binary_plugin(triple_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+
+        let (double_code, doubled) = call_raw_u64(doubler, MSG_PER_PLUGIN, 5);
+        let (triple_code, tripled) = call_raw_u64(tripler, MSG_PER_PLUGIN, 5);
+
+        assert_eq!(double_code, 0);
+        assert_eq!(doubled.as_slice(), 10u64.to_le_bytes());
+        assert_eq!(triple_code, 0);
+        assert_eq!(tripled.as_slice(), 15u64.to_le_bytes());
+
+        plugin_shutdown(doubler);
+        plugin_shutdown(tripler);
+    }
+}
+
+#[test]
+fn plugin_call_raw___handler_registered_after_start___not_visible() {
+    unsafe {
+        let handle = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+        register_binary_handler(MSG_LATE, double_handler);
+
+        let (code, _) = call_raw_u64(handle, MSG_LATE, 5);
+
+        // The table was frozen when the plugin became Active
+        assert_eq!(code, 6);
+
+        plugin_shutdown(handle);
+    }
+}
+
+// =============================================================================
+// Shared-Memory Ring Tests
+// =============================================================================
+
+/// Publish a request frame as a host would, waking the consumer if it parked
+unsafe fn ring_send(channel: *mut RbRingChannel, message_id: u32, id: u64, payload: &[u8]) {
+    // SAFETY: the channel pointer is also a pointer to the RingChannel
+    let ring = unsafe { &*(channel as *const RingChannel) }.request();
+    // SAFETY: each test is the only host producer for its channel
+    while !unsafe { ring.try_push(&RbRingFrame::new(message_id, id), payload) } {
+        thread::yield_now();
+    }
+    unsafe { plugin_ring_notify(channel) };
+}
+
+/// Receive the next response frame, waiting up to five seconds
+unsafe fn ring_recv(channel: *mut RbRingChannel) -> Option<(RbRingFrame, Vec<u8>)> {
+    // SAFETY: the channel pointer is also a pointer to the RingChannel
+    let ring = unsafe { &*(channel as *const RingChannel) }.response();
+    let deadline = std::time::Instant::now() + Duration::from_secs(5);
+    while std::time::Instant::now() < deadline {
+        // SAFETY: each test is the only host consumer for its channel
+        if let Some(frame) = unsafe { ring.try_pop(|frame, payload| (*frame, payload.to_vec())) } {
+            return Some(frame);
+        }
+        unsafe { plugin_ring_wait(channel, 100) };
+    }
+    None
+}
+
+#[test]
+fn plugin_ring_open___binary_plugin___answers_frames_in_order() {
+    unsafe {
+        let handle = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+        let channel = plugin_ring_open(handle, 0);
+        assert!(!channel.is_null());
+
+        for i in 0..1_000u64 {
+            ring_send(channel, MSG_PER_PLUGIN, i, &i.to_le_bytes());
+        }
+        let responses: Vec<_> = (0..1_000).map(|_| ring_recv(channel).unwrap()).collect();
+
+        for (i, (frame, payload)) in responses.iter().enumerate() {
+            assert_eq!(frame.correlation_id, i as u64);
+            assert_eq!(frame.message_id, MSG_PER_PLUGIN);
+            assert_eq!(frame.status, 0);
+            assert_eq!(payload.as_slice(), (i as u64 * 2).to_le_bytes());
+        }
+
+        plugin_ring_close(channel);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_ring_open___unknown_message___returns_error_frame() {
+    unsafe {
+        let handle = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+        let channel = plugin_ring_open(handle, 0);
+
+        ring_send(channel, MSG_LATE, 42, &[0; 8]);
+        let (frame, payload) = ring_recv(channel).unwrap();
+
+        assert_eq!(frame.status, 6);
+        assert_eq!(frame.correlation_id, 42);
+        assert!(String::from_utf8_lossy(&payload).contains("Unknown message ID"));
+
+        plugin_ring_close(channel);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_ring_open___invalid_arguments___returns_null() {
+    unsafe {
+        let handle = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+
+        assert!(plugin_ring_open(std::ptr::null_mut(), 0).is_null());
+        assert!(plugin_ring_open(handle, RB_RING_MAX_CAPACITY + 1).is_null());
+
+        plugin_shutdown(handle);
+        assert!(plugin_ring_open(handle, 0).is_null());
+    }
+}
+
+#[test]
+fn plugin_shutdown___open_ring___stops_consumer_and_closes_rings() {
+    unsafe {
+        let handle = plugin_init(
+            create_binary_plugin(double_handler),
+            std::ptr::null(),
+            0,
+            None,
+        );
+        let channel = plugin_ring_open(handle, 0);
+        ring_send(channel, MSG_PER_PLUGIN, 1, &1u64.to_le_bytes());
+        assert!(ring_recv(channel).is_some());
+
+        assert!(plugin_shutdown(handle));
+
+        let ring = &*(channel as *const RingChannel);
+        assert!(ring.request().is_closed());
+        assert!(ring.response().is_closed());
+        // Returns immediately once closed
+        plugin_ring_wait(channel, 5_000);
+        plugin_ring_close(channel);
+    }
+}
+
+// =============================================================================
+// Streaming Response Tests
+// =============================================================================
+
+/// Open a stream, asserting success
+unsafe fn stream_open(handle: *mut c_void, type_tag: &std::ffi::CStr, request: &[u8]) -> u64 {
+    let mut stream_id = 0;
+    let mut result = unsafe {
+        plugin_stream_open(
+            handle,
+            type_tag.as_ptr(),
+            request.as_ptr(),
+            request.len(),
+            &mut stream_id,
+        )
+    };
+    assert_eq!(result.error_code, 0, "stream open failed");
+    unsafe { result.free() };
+    stream_id
+}
+
+/// Pull one frame: `(error_code, data)`
+unsafe fn stream_next(handle: *mut c_void, stream_id: u64) -> (u32, Vec<u8>) {
+    let mut result = unsafe { plugin_stream_next(handle, stream_id) };
+    let frame = (result.error_code, unsafe { result.as_slice() }.to_vec());
+    unsafe { result.free() };
+    frame
+}
+
+#[test]
+fn plugin_stream_next___chunked_stream___returns_chunks_then_end() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let stream_id = stream_open(handle, c"chunks", b"5");
+
+        let mut body = Vec::new();
+        loop {
+            let (code, data) = stream_next(handle, stream_id);
+            assert_eq!(code, 0);
+            if data.is_empty() {
+                break;
+            }
+            body.extend_from_slice(&data);
+        }
+
+        assert_eq!(body, b"chunk-0;chunk-1;chunk-2;chunk-3;chunk-4;");
+        assert_eq!(
+            stream_next(handle, stream_id).0,
+            1,
+            "ended stream is forgotten"
+        );
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_stream_open___default_stream___returns_whole_payload() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let stream_id = stream_open(handle, c"echo", br#"{"message":"streamed"}"#);
+
+        let (code, data) = stream_next(handle, stream_id);
+        let response: EchoResponse = serde_json::from_slice(&data).unwrap();
+
+        assert_eq!(code, 0);
+        assert_eq!(response.message, "streamed");
+        assert_eq!(stream_next(handle, stream_id), (0, Vec::new()));
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_stream_open___unknown_type_tag___returns_error_envelope() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let mut stream_id = 0;
+
+        let mut result = plugin_stream_open(
+            handle,
+            c"unknown".as_ptr(),
+            std::ptr::null(),
+            0,
+            &mut stream_id,
+        );
+        let envelope: serde_json::Value = serde_json::from_slice(result.as_slice()).unwrap();
+
+        assert_eq!(result.error_code, 6);
+        assert_eq!(envelope["status"], "error");
+        assert_eq!(stream_id, 0);
+        result.free();
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_stream_next___handler_error___returns_error_after_chunks() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let stream_id = stream_open(handle, c"failing", b"");
+
+        let first = stream_next(handle, stream_id);
+        let (code, data) = stream_next(handle, stream_id);
+        let envelope: serde_json::Value = serde_json::from_slice(&data).unwrap();
+
+        assert_eq!(first, (0, b"first".to_vec()));
+        assert_eq!(code, 7);
+        assert_eq!(envelope["error_code"], 7);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_stream_next___handler_panics___returns_internal_error() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let stream_id = stream_open(handle, c"panicking", b"");
+
+        let (code, _) = stream_next(handle, stream_id);
+
+        assert_eq!(code, 11);
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_stream_next___slow_consumer___producer_stays_bounded() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let stream_id = stream_open(handle, c"endless", b"");
+
+        assert_eq!(
+            stream_next(handle, stream_id),
+            (0, 0u64.to_le_bytes().to_vec())
+        );
+        thread::sleep(Duration::from_millis(100));
+        let produced = ENDLESS_PRODUCED.load(Ordering::SeqCst);
+
+        // One pulled, the channel's buffer, and one waiting to be sent
+        assert!(
+            produced <= 2 + rustbridge_ffi::STREAM_BUFFER_CHUNKS as u64,
+            "produced {} chunks ahead of the host",
+            produced
+        );
+        assert!(plugin_stream_close(handle, stream_id));
+        assert!(!plugin_stream_close(handle, stream_id));
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_shutdown___blocked_stream_reader___is_released() {
+    let handle = unsafe { plugin_init(create_test_plugin(), std::ptr::null(), 0, None) };
+    let stream_id = unsafe { stream_open(handle, c"chunks", b"1000000") };
+    let handle_addr = handle as usize;
+
+    let reader = thread::spawn(move || {
+        loop {
+            // SAFETY: the handle stays registered until plugin_shutdown returns
+            let (code, data) = unsafe { stream_next(handle_addr as *mut c_void, stream_id) };
+            if code != 0 || data.is_empty() {
+                return code;
+            }
+        }
+    });
+    thread::sleep(Duration::from_millis(20));
+    unsafe { plugin_shutdown(handle) };
+
+    let code = reader.join().unwrap();
+    assert!(
+        code == 9 || code == 1,
+        "expected Cancelled or invalid handle, got {}",
+        code
+    );
+}
+
+// =============================================================================
+// Streamed Request Tests
+// =============================================================================
+
+/// Open a streamed request, asserting success
+unsafe fn input_open(handle: *mut c_void, type_tag: &std::ffi::CStr) -> u64 {
+    let mut input_id = 0;
+    let mut result = unsafe { plugin_input_open(handle, type_tag.as_ptr(), &mut input_id) };
+    assert_eq!(result.error_code, 0, "input open failed");
+    unsafe { result.free() };
+    input_id
+}
+
+/// Finish a streamed request: `(error_code, envelope)`
+unsafe fn input_finish(handle: *mut c_void, input_id: u64) -> (u32, serde_json::Value) {
+    let mut result = unsafe { plugin_input_finish(handle, input_id) };
+    let envelope =
+        serde_json::from_slice(unsafe { result.as_slice() }).unwrap_or(serde_json::Value::Null);
+    let code = result.error_code;
+    unsafe { result.free() };
+    (code, envelope)
+}
+
+#[test]
+fn plugin_input_finish___chunks_written___handler_reads_whole_payload() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let input_id = input_open(handle, c"count");
+        let chunk = vec![7u8; 1024 * 1024];
+
+        for _ in 0..3 {
+            assert_eq!(
+                plugin_input_write(handle, input_id, chunk.as_ptr(), chunk.len()),
+                0
+            );
+        }
+        let (code, envelope) = input_finish(handle, input_id);
+
+        assert_eq!(code, 0);
+        assert_eq!(envelope["payload"]["bytes"], 3 * 1024 * 1024);
+        assert_eq!(
+            plugin_input_write(handle, input_id, chunk.as_ptr(), 1),
+            1,
+            "finished input is forgotten"
+        );
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_input_finish___default_reader___dispatches_to_handle_request() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let input_id = input_open(handle, c"echo");
+
+        let first = br#"{"message":"#;
+        let second = br#""in pieces"}"#;
+        plugin_input_write(handle, input_id, first.as_ptr(), first.len());
+        plugin_input_write(handle, input_id, second.as_ptr(), second.len());
+        let (code, envelope) = input_finish(handle, input_id);
+
+        assert_eq!(code, 0);
+        assert_eq!(envelope["payload"]["message"], "in pieces");
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_input_finish___handler_error___returns_error_envelope() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+        let input_id = input_open(handle, c"unknown");
+
+        let (code, envelope) = input_finish(handle, input_id);
+
+        assert_eq!(code, 6);
+        assert_eq!(envelope["status"], "error");
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_input_write___invalid_input___returns_error_code() {
+    unsafe {
+        let handle = plugin_init(create_test_plugin(), std::ptr::null(), 0, None);
+
+        assert_eq!(plugin_input_write(handle, 42, b"x".as_ptr(), 1), 1);
+        assert_eq!(
+            plugin_input_write(std::ptr::null_mut(), 1, b"x".as_ptr(), 1),
+            1
+        );
+        let input_id = input_open(handle, c"count");
+        assert_eq!(plugin_input_write(handle, input_id, std::ptr::null(), 1), 4);
+        assert!(plugin_input_abort(handle, input_id));
+        assert!(!plugin_input_abort(handle, input_id));
+        plugin_shutdown(handle);
+    }
+}
+
+#[test]
+fn plugin_shutdown___blocked_input_writer___is_released() {
+    let handle = unsafe { plugin_init(create_test_plugin(), std::ptr::null(), 0, None) };
+    let input_id = unsafe { input_open(handle, c"stall") };
+    let handle_addr = handle as usize;
+
+    let writer = thread::spawn(move || {
+        let chunk = [0u8; 64];
+        let mut accepted = 0;
+        for _ in 0..rustbridge_ffi::INPUT_BUFFER_CHUNKS * 4 {
+            // SAFETY: the handle stays registered until plugin_shutdown returns
+            let code = unsafe {
+                plugin_input_write(handle_addr as *mut c_void, input_id, chunk.as_ptr(), 64)
+            };
+            if code != 0 {
+                break;
+            }
+            accepted += 1;
+        }
+        accepted
+    });
+    thread::sleep(Duration::from_millis(50));
+    unsafe { plugin_shutdown(handle) };
+
+    let accepted = writer.join().unwrap();
+    assert!(
+        accepted >= rustbridge_ffi::INPUT_BUFFER_CHUNKS,
+        "writer accepted only {} chunks",
+        accepted
+    );
+}
@@ -7,10 +7,48 @@ use async_trait::async_trait;
 use rustbridge_core::{Plugin, PluginConfig, PluginContext, PluginResult};
 use rustbridge_ffi::{FfiBuffer, PluginHandle, PluginHandleManager};
 use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 /// Minimal test plugin
 struct TestPlugin;
 
+/// Test plugin that counts how many instances have been dropped
+struct DropTrackingPlugin {
+    drops: Arc<AtomicUsize>,
+}
+
+impl Drop for DropTrackingPlugin {
+    fn drop(&mut self) {
+        self.drops.fetch_add(1, Ordering::SeqCst);
+    }
+}
+
+#[async_trait]
+impl Plugin for DropTrackingPlugin {
+    async fn on_start(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn on_stop(&self, _context: &PluginContext) -> PluginResult<()> {
+        Ok(())
+    }
+
+    async fn handle_request(
+        &self,
+        _context: &PluginContext,
+        _type_tag: &str,
+        _request: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        Ok(vec![])
+    }
+}
+
+fn tracked_plugin(drops: &Arc<AtomicUsize>) -> Box<DropTrackingPlugin> {
+    Box::new(DropTrackingPlugin {
+        drops: drops.clone(),
+    })
+}
+
 #[async_trait]
 impl Plugin for TestPlugin {
     async fn on_start(&self, _context: &PluginContext) -> PluginResult<()> {
@@ -138,6 +176,94 @@ fn test_handle_drop_after_removal() {
     assert!(manager.get(id).is_none());
 }
 
+#[test]
+fn test_handle_dropped_when_removed_without_lookups() {
+    let manager = PluginHandleManager::new();
+    let drops = Arc::new(AtomicUsize::new(0));
+
+    let id = manager.register(
+        PluginHandle::new(tracked_plugin(&drops), PluginConfig::default())
+            .expect("Should create handle"),
+    );
+    let removed = manager.remove(id);
+
+    // The table keeps no reference once no lookup holds the handle
+    assert_eq!(removed.as_ref().map(Arc::strong_count), Some(1));
+    drop(removed);
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+    assert!(manager.is_empty());
+}
+
+#[test]
+fn test_handle_removed_during_lookup_dropped_after_guard() {
+    let manager = PluginHandleManager::new();
+    let drops = Arc::new(AtomicUsize::new(0));
+    let id = manager.register(
+        PluginHandle::new(tracked_plugin(&drops), PluginConfig::default())
+            .expect("Should create handle"),
+    );
+
+    let guard = manager.lookup(id).expect("Handle should be found");
+    drop(manager.remove(id));
+
+    // The in-flight lookup keeps the handle alive
+    assert_eq!(drops.load(Ordering::SeqCst), 0);
+    assert!(guard.id().is_some());
+    assert!(manager.lookup(id).is_none());
+
+    drop(guard);
+    assert_eq!(drops.load(Ordering::SeqCst), 1);
+}
+
+#[test]
+fn test_slot_reuse_does_not_resurrect_stale_ids() {
+    let manager = PluginHandleManager::new();
+    let mut stale = vec![];
+
+    for _ in 0..20 {
+        let handle = PluginHandle::new(Box::new(TestPlugin), PluginConfig::default())
+            .expect("Should create");
+        let id = manager.register(handle);
+        assert!(manager.remove(id).is_some());
+        stale.push(id);
+    }
+
+    let live = manager.register(
+        PluginHandle::new(Box::new(TestPlugin), PluginConfig::default()).expect("Should create"),
+    );
+
+    // Every removed ID stays invalid even though the slot is reused
+    for id in &stale {
+        assert!(manager.lookup(*id).is_none(), "Stale ID {} resolved", id);
+        assert!(manager.remove(*id).is_none());
+    }
+    assert_eq!(
+        manager.lookup(live).and_then(|h| h.id()),
+        Some(live),
+        "Live handle should resolve to itself"
+    );
+    assert_eq!(manager.len(), 1);
+    manager.remove(live);
+}
+
+#[test]
+fn test_manager_drop_releases_registered_handles() {
+    let drops = Arc::new(AtomicUsize::new(0));
+    let manager = PluginHandleManager::new();
+    manager.register(
+        PluginHandle::new(tracked_plugin(&drops), PluginConfig::default())
+            .expect("Should create handle"),
+    );
+    manager.register(
+        PluginHandle::new(tracked_plugin(&drops), PluginConfig::default())
+            .expect("Should create handle"),
+    );
+
+    drop(manager);
+
+    assert_eq!(drops.load(Ordering::SeqCst), 2);
+}
+
 #[test]
 fn test_empty_buffer_creation_and_free() {
     let mut buffer = FfiBuffer::empty();
@@ -128,3 +128,21 @@ impl RbResponse {
         self.capacity = 0;
     }
 }
+
+/// Descriptor for one message in a batch call
+///
+/// This structure must match the layout of `rustbridge_ffi::RbBatchRequest` exactly.
+#[repr(C)]
+pub struct RbBatchRequest {
+    /// Numeric message identifier
+    pub message_id: u32,
+    /// Reserved for alignment (must be zero)
+    pub _reserved: u32,
+    /// Pointer to the request bytes
+    pub request: *const u8,
+    /// Length of the request in bytes
+    pub request_size: usize,
+}
+
+/// Batch flag: dispatch the messages in parallel on the plugin's runtime
+pub const RB_BATCH_PARALLEL: u32 = 1;
@@ -27,59 +27,30 @@
 mod error;
 mod ffi_types;
 mod loader;
+mod registry;
 
 use error::JniError;
+use ffi_types::{FfiBuffer, RB_BATCH_PARALLEL, RbBatchRequest, RbResponse};
 use jni::JNIEnv;
-use jni::objects::{JByteArray, JClass, JString};
+use jni::objects::{JByteArray, JByteBuffer, JClass, JIntArray, JObject, JObjectArray, JString};
 use jni::sys::{JNI_FALSE, JNI_TRUE, jboolean, jint, jlong};
 use loader::LoadedPlugin;
-use std::collections::HashMap;
-use std::sync::{Arc, Mutex};
+use std::cell::RefCell;
+use std::ffi::CString;
 
-// Global registry of loaded plugins
-// Maps handle ID to Arc<LoadedPlugin> (which keeps the library loaded)
-// Using Arc allows us to clone references without holding the mutex during calls
-static LOADED_PLUGINS: Mutex<Option<HashMap<u64, Arc<LoadedPlugin>>>> = Mutex::new(None);
+/// Largest request buffer a thread keeps between calls
+const MAX_RETAINED_REQUEST: usize = 1 << 20;
 
-fn get_plugins() -> std::sync::MutexGuard<'static, Option<HashMap<u64, Arc<LoadedPlugin>>>> {
-    LOADED_PLUGINS.lock().unwrap()
-}
-
-fn init_plugins() {
-    let mut guard = get_plugins();
-    if guard.is_none() {
-        *guard = Some(HashMap::new());
-    }
-}
-
-fn register_plugin(handle: u64, plugin: LoadedPlugin) {
-    init_plugins();
-    let mut guard = get_plugins();
-    if let Some(ref mut map) = *guard {
-        map.insert(handle, Arc::new(plugin));
-    }
-}
-
-fn remove_plugin(handle: u64) -> Option<Arc<LoadedPlugin>> {
-    let mut guard = get_plugins();
-    guard.as_mut().and_then(|map| map.remove(&handle))
-}
-
-/// Get a plugin reference (Arc-cloned to avoid holding the mutex during the call)
-fn get_plugin(handle: u64) -> Option<Arc<LoadedPlugin>> {
-    let guard = get_plugins();
-    guard
-        .as_ref()
-        .and_then(|map| map.get(&handle).map(Arc::clone))
+thread_local! {
+    /// Reused buffer that byte-array requests are copied into
+    static REQUEST_BUFFER: RefCell<Vec<u8>> = const { RefCell::new(Vec::new()) };
 }
 
 fn with_plugin<F, T>(handle: u64, f: F) -> Option<T>
 where
     F: FnOnce(&LoadedPlugin) -> T,
 {
-    // Clone the Arc BEFORE releasing the mutex to allow concurrent calls
-    let plugin = get_plugin(handle)?;
-    // Mutex is released here, allowing other threads to proceed
+    let plugin = registry::get(handle)?;
     Some(f(&plugin))
 }
 
@@ -141,12 +112,13 @@ fn load_plugin_impl(
 
     // Load the plugin
     let loaded = loader::load_plugin(&path, config_bytes.as_deref())?;
-    let handle = loaded.handle();
 
-    // Register for cleanup
-    register_plugin(handle, loaded);
-
-    Ok(handle)
+    // Java holds the registry handle, not the plugin's FFI handle, so plugins
+    // from different libraries never share one
+    registry::insert(loaded).map_err(|loaded| {
+        loaded.shutdown();
+        JniError::InitFailed("Too many plugins loaded".to_string())
+    })
 }
 
 // ============================================================================
@@ -198,11 +170,7 @@ fn call_impl<'local>(
     type_tag: JString<'local>,
     request: JString<'local>,
 ) -> Result<JString<'local>, JniError> {
-    // Get type tag as C string
-    let type_tag_str: String = env
-        .get_string(&type_tag)
-        .map_err(|e| JniError::StringConversion(e.to_string()))?
-        .into();
+    let type_tag_cstr = type_tag_cstring(env, &type_tag)?;
 
     // Get request as bytes
     let request_str: String = env
@@ -211,10 +179,6 @@ fn call_impl<'local>(
         .into();
     let request_bytes = request_str.as_bytes();
 
-    // Create C string for type tag
-    let type_tag_cstr = std::ffi::CString::new(type_tag_str)
-        .map_err(|e| JniError::StringConversion(e.to_string()))?;
-
     // Get the plugin from registry and make the call
     let buffer = with_plugin(handle as u64, |plugin| {
         plugin.call(
@@ -223,51 +187,178 @@ fn call_impl<'local>(
             request_bytes.len(),
         )
     })
-    .ok_or_else(|| JniError::PluginCall {
-        code: 1,
-        message: "Invalid plugin handle".to_string(),
-    })?;
+    .ok_or_else(invalid_handle)?;
 
-    // Check for errors
-    if buffer.is_error() {
-        let error_code = buffer.error_code;
-        // SAFETY: buffer contains valid data from plugin_call
-        let error_msg = unsafe {
-            let slice = buffer.as_slice();
-            std::str::from_utf8(slice).unwrap_or("Unknown error")
-        };
-        let err = JniError::PluginCall {
-            code: error_code,
-            message: error_msg.to_string(),
-        };
+    let response_str = take_call_response(buffer)?;
 
-        // Free the buffer through the plugin
-        // SAFETY: buffer is a valid FfiBuffer from plugin_call
-        unsafe {
-            let mut buf = buffer;
-            buf.free();
-        }
+    // Create Java string from response
+    env.new_string(&response_str)
+        .map_err(|e| JniError::StringConversion(e.to_string()))
+}
 
-        return Err(err);
+/// Call the plugin with a JSON request read in place from a direct ByteBuffer.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `type_tag`: Message type tag
+/// - `request`: Direct buffer holding the UTF-8 JSON request
+/// - `offset`, `length`: Range of the request within the buffer
+///
+/// # Returns
+/// JSON response string, or throws PluginException on failure
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallDirect<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    type_tag: JString<'local>,
+    request: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) -> JString<'local> {
+    match call_direct_impl(&mut env, handle, type_tag, request, offset, length) {
+        Ok(response) => response,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            JString::default()
+        }
     }
+}
 
-    // Parse the response envelope to extract the data
-    // SAFETY: buffer contains valid data from plugin_call
-    let response_bytes = unsafe { buffer.as_slice() };
-    let response_str = extract_response_data(response_bytes)?;
+fn call_direct_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    type_tag: JString<'local>,
+    request: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) -> Result<JString<'local>, JniError> {
+    let type_tag_cstr = type_tag_cstring(env, &type_tag)?;
+    // SAFETY: the Java caller keeps the buffer reachable for the call
+    let request_bytes = unsafe { direct_buffer_slice(env, &request, offset, length) }?;
 
-    // Free the buffer
-    // SAFETY: buffer is a valid FfiBuffer from plugin_call
-    unsafe {
-        let mut buf = buffer;
-        buf.free();
+    let buffer = with_plugin(handle as u64, |plugin| {
+        plugin.call(
+            type_tag_cstr.as_ptr(),
+            request_bytes.as_ptr(),
+            request_bytes.len(),
+        )
+    })
+    .ok_or_else(invalid_handle)?;
+
+    let response_str = take_call_response(buffer)?;
+    env.new_string(&response_str)
+        .map_err(|e| JniError::StringConversion(e.to_string()))
+}
+
+/// Resolve a type tag to the plugin's numeric type ID.
+///
+/// # Returns
+/// The type ID, or 0 if the plugin does not list the tag or cannot be called
+/// by type ID (callers then fall back to `nativeCall`)
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeResolveTypeTag<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    type_tag: JString<'local>,
+) -> jint {
+    let Ok(type_tag_cstr) = type_tag_cstring(&mut env, &type_tag) else {
+        return 0;
+    };
+    with_plugin(handle as u64, |plugin| {
+        plugin.resolve_type_tag(type_tag_cstr.as_ptr())
+    })
+    .flatten()
+    .unwrap_or(0) as jint
+}
+
+/// Make a synchronous call to the plugin by type ID.
+///
+/// Skips the per-call type tag conversion and lookup of `nativeCall`.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `type_id`: Type ID from nativeResolveTypeTag
+/// - `request`: UTF-8 JSON request bytes
+///
+/// # Returns
+/// JSON response string, or throws PluginException on failure
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallId<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    type_id: jint,
+    request: JByteArray<'local>,
+) -> JString<'local> {
+    match call_id_impl(&mut env, handle, type_id, request) {
+        Ok(response) => response,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            JString::default()
+        }
     }
+}
 
-    // Create Java string from response
+fn call_id_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    type_id: jint,
+    request: JByteArray<'local>,
+) -> Result<JString<'local>, JniError> {
+    let buffer = with_request_bytes(env, &request, |request| {
+        with_plugin(handle as u64, |plugin| {
+            plugin.call_id(type_id as u32, request.as_ptr(), request.len())
+        })
+    })?
+    .ok_or_else(invalid_handle)?
+    .ok_or_else(|| JniError::PluginCall {
+        code: 6,
+        message: "Calls by type ID not supported by this plugin".to_string(),
+    })?;
+    let response_str = take_call_response(buffer)?;
     env.new_string(&response_str)
         .map_err(|e| JniError::StringConversion(e.to_string()))
 }
 
+/// Take a JSON call's result buffer, returning the response payload.
+///
+/// The buffer is freed in every case.
+fn take_call_response(buffer: FfiBuffer) -> Result<String, JniError> {
+    let mut buffer = buffer;
+    // SAFETY: buffer contains valid data from the plugin
+    let bytes = unsafe { buffer.as_slice() };
+    let result = if buffer.is_error() {
+        Err(error_from_bytes(buffer.error_code, bytes))
+    } else {
+        extract_response_data(bytes)
+    };
+
+    // Free the buffer through the plugin
+    // SAFETY: buffer is a valid FfiBuffer from the plugin
+    unsafe { buffer.free() };
+    result
+}
+
+/// Build the error carried by an error buffer.
+///
+/// Most entry points put a plain message in the buffer; streamed request
+/// entry points put an error envelope there instead.
+fn error_from_bytes(code: u32, bytes: &[u8]) -> JniError {
+    if bytes.first() == Some(&b'{')
+        && let Err(e @ JniError::PluginCall { .. }) = extract_response_data(bytes)
+    {
+        return e;
+    }
+    JniError::PluginCall {
+        code,
+        message: std::str::from_utf8(bytes)
+            .unwrap_or("Unknown error")
+            .to_string(),
+    }
+}
+
 /// Extract the payload from a response envelope JSON.
 ///
 /// ResponseEnvelope format:
@@ -352,16 +443,57 @@ fn call_raw_impl<'local>(
     message_id: jint,
     request: JByteArray<'local>,
 ) -> Result<JByteArray<'local>, JniError> {
-    // Get request bytes
-    let request_len = env
-        .get_array_length(&request)
-        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+    // Make the raw call
+    let response = with_request_bytes(env, &request, |request| {
+        with_plugin(handle as u64, |plugin| {
+            plugin.call_raw(message_id as u32, request.as_ptr(), request.len())
+        })
+    })?
+    .ok_or_else(invalid_handle)?
+    .ok_or_else(binary_transport_unsupported)?;
+    take_raw_response(env, response)
+}
 
-    let mut request_bytes = vec![0u8; request_len as usize];
-    env.get_byte_array_region(&request, 0, bytemuck_cast_slice_mut(&mut request_bytes))
-        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+/// Make a raw binary call with the request read in place from a direct ByteBuffer.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `message_id`: Binary message ID
+/// - `request`: Direct buffer holding the request struct
+/// - `offset`, `length`: Range of the request within the buffer
+///
+/// # Returns
+/// Response bytes, or throws PluginException on failure
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallRawDirect<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    message_id: jint,
+    request: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) -> JByteArray<'local> {
+    match call_raw_direct_impl(&mut env, handle, message_id, request, offset, length) {
+        Ok(response) => response,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            JByteArray::default()
+        }
+    }
+}
+
+fn call_raw_direct_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    message_id: jint,
+    request: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) -> Result<JByteArray<'local>, JniError> {
+    // SAFETY: the Java caller keeps the buffer reachable for the call
+    let request_bytes = unsafe { direct_buffer_slice(env, &request, offset, length) }?;
 
-    // Make the raw call
     let response = with_plugin(handle as u64, |plugin| {
         plugin.call_raw(
             message_id as u32,
@@ -369,55 +501,344 @@ fn call_raw_impl<'local>(
             request_bytes.len(),
         )
     })
+    .ok_or_else(invalid_handle)?
+    .ok_or_else(binary_transport_unsupported)?;
+    take_raw_response(env, response)
+}
+
+/// Make a raw binary call that writes the response into a direct ByteBuffer.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `message_id`: Binary message ID
+/// - `request`: Request bytes
+/// - `out`: Direct buffer to receive the response
+/// - `out_offset`, `out_length`: Range of `out` the response may fill
+///
+/// # Returns
+/// Number of response bytes written, or throws PluginException on failure
+/// (error code 14 if the range is too small)
+#[unsafe(no_mangle)]
+#[allow(clippy::too_many_arguments)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallRawInto<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    message_id: jint,
+    request: JByteArray<'local>,
+    out: JByteBuffer<'local>,
+    out_offset: jint,
+    out_length: jint,
+) -> jint {
+    match call_raw_into_impl(
+        &mut env, handle, message_id, request, out, out_offset, out_length,
+    ) {
+        Ok(len) => len,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            0
+        }
+    }
+}
+
+fn call_raw_into_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    message_id: jint,
+    request: JByteArray<'local>,
+    out: JByteBuffer<'local>,
+    out_offset: jint,
+    out_length: jint,
+) -> Result<jint, JniError> {
+    // SAFETY: the Java caller keeps the buffer reachable for the call
+    let out = unsafe { direct_buffer_slice_mut(env, &out, out_offset, out_length) }?;
+
+    let mut out_len = 0;
+    let code = with_request_bytes(env, &request, |request| {
+        with_plugin(handle as u64, |plugin| {
+            plugin.call_raw_into(message_id as u32, request, &mut *out, &mut out_len)
+        })
+    })?;
+    into_result(code, out, out_len)
+}
+
+/// Make a raw binary call from one direct ByteBuffer into another.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `message_id`: Binary message ID
+/// - `request`: Direct buffer holding the request struct
+/// - `offset`, `length`: Range of the request within the buffer
+/// - `out`: Direct buffer to receive the response
+/// - `out_offset`, `out_length`: Range of `out` the response may fill
+///
+/// # Returns
+/// Number of response bytes written, or throws PluginException on failure
+/// (error code 14 if the range is too small)
+#[unsafe(no_mangle)]
+#[allow(clippy::too_many_arguments)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallRawDirectInto<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    message_id: jint,
+    request: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+    out: JByteBuffer<'local>,
+    out_offset: jint,
+    out_length: jint,
+) -> jint {
+    match call_raw_direct_into_impl(
+        &env, handle, message_id, request, offset, length, out, out_offset, out_length,
+    ) {
+        Ok(len) => len,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            0
+        }
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+fn call_raw_direct_into_impl(
+    env: &JNIEnv,
+    handle: jlong,
+    message_id: jint,
+    request: JByteBuffer,
+    offset: jint,
+    length: jint,
+    out: JByteBuffer,
+    out_offset: jint,
+    out_length: jint,
+) -> Result<jint, JniError> {
+    // SAFETY: the Java caller keeps both buffers reachable for the call
+    let request_bytes = unsafe { direct_buffer_slice(env, &request, offset, length) }?;
+    // SAFETY: as above
+    let out = unsafe { direct_buffer_slice_mut(env, &out, out_offset, out_length) }?;
+
+    let mut out_len = 0;
+    let code = with_plugin(handle as u64, |plugin| {
+        plugin.call_raw_into(message_id as u32, request_bytes, &mut *out, &mut out_len)
+    });
+    into_result(code, out, out_len)
+}
+
+/// Turn a `call_raw_into` status into the response length or its error.
+fn into_result(code: Option<Option<u32>>, out: &[u8], out_len: usize) -> Result<jint, JniError> {
+    match code.ok_or_else(invalid_handle)? {
+        None => Err(JniError::PluginCall {
+            code: 6,
+            message: "Caller-buffer binary transport not supported by this plugin".to_string(),
+        }),
+        Some(0) => Ok(out_len as jint),
+        Some(14) => Err(JniError::PluginCall {
+            code: 14,
+            message: format!("Output buffer too small: {} bytes required", out_len),
+        }),
+        Some(code) => Err(JniError::PluginCall {
+            code,
+            message: std::str::from_utf8(&out[..out_len.min(out.len())])
+                .ok()
+                .filter(|message| !message.is_empty())
+                .unwrap_or("Unknown error")
+                .to_string(),
+        }),
+    }
+}
+
+/// Copy a raw call's response into a Java byte array.
+///
+/// The response is freed in every case.
+fn take_raw_response<'local>(
+    env: &mut JNIEnv<'local>,
+    response: RbResponse,
+) -> Result<JByteArray<'local>, JniError> {
+    let mut response = response;
+    // SAFETY: response contains valid data from plugin_call_raw
+    let response_bytes = unsafe { response.as_slice() };
+
+    let result = if response.is_error() {
+        Err(JniError::PluginCall {
+            code: response.error_code,
+            message: std::str::from_utf8(response_bytes)
+                .unwrap_or("Unknown error")
+                .to_string(),
+        })
+    } else {
+        env.new_byte_array(response_bytes.len() as i32)
+            .and_then(|array| {
+                env.set_byte_array_region(&array, 0, bytemuck_cast_slice(response_bytes))?;
+                Ok(array)
+            })
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))
+    };
+
+    // Free the response
+    // SAFETY: response is a valid RbResponse from plugin_call_raw
+    unsafe { response.free() };
+    result
+}
+
+/// Check if the batched binary entry point is supported.
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeHasBatchTransport<'local>(
+    _env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+) -> jboolean {
+    let result = with_plugin(handle as u64, |plugin| plugin.has_batch_transport()).unwrap_or(false);
+    if result { JNI_TRUE } else { JNI_FALSE }
+}
+
+/// Make a batch of raw binary calls to the plugin in one FFI crossing.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `message_ids`: Binary message ID for each request
+/// - `requests`: Request bytes for each message
+/// - `parallel`: Dispatch the messages in parallel on the plugin's runtime
+///
+/// # Returns
+/// Response bytes for each request, or throws PluginException for the first
+/// failed message
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeCallRawBatch<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    message_ids: JIntArray<'local>,
+    requests: JObjectArray<'local>,
+    parallel: jboolean,
+) -> JObjectArray<'local> {
+    match call_raw_batch_impl(
+        &mut env,
+        handle,
+        message_ids,
+        requests,
+        parallel != JNI_FALSE,
+    ) {
+        Ok(responses) => responses,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            JObjectArray::default()
+        }
+    }
+}
+
+fn call_raw_batch_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    message_ids: JIntArray<'local>,
+    requests: JObjectArray<'local>,
+    parallel: bool,
+) -> Result<JObjectArray<'local>, JniError> {
+    let count = env
+        .get_array_length(&requests)
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+    let id_count = env
+        .get_array_length(&message_ids)
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+    if id_count != count {
+        return Err(JniError::ArrayAccess(
+            "messageIds and requests must have the same length".to_string(),
+        ));
+    }
+
+    let mut ids = vec![0 as jint; count as usize];
+    env.get_int_array_region(&message_ids, 0, &mut ids)
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+
+    // Copy each request out of the JVM heap; the copies back the descriptors
+    let mut request_bytes = Vec::with_capacity(count as usize);
+    for i in 0..count {
+        let element = JByteArray::from(
+            env.get_object_array_element(&requests, i)
+                .map_err(|e| JniError::ArrayAccess(e.to_string()))?,
+        );
+        let len = env
+            .get_array_length(&element)
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        let mut bytes = vec![0u8; len as usize];
+        env.get_byte_array_region(&element, 0, bytemuck_cast_slice_mut(&mut bytes))
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        env.delete_local_ref(element)
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        request_bytes.push(bytes);
+    }
+
+    let descriptors: Vec<RbBatchRequest> = ids
+        .iter()
+        .zip(&request_bytes)
+        .map(|(id, bytes)| RbBatchRequest {
+            message_id: *id as u32,
+            _reserved: 0,
+            request: bytes.as_ptr(),
+            request_size: bytes.len(),
+        })
+        .collect();
+    let flags = if parallel { RB_BATCH_PARALLEL } else { 0 };
+
+    let mut responses = with_plugin(handle as u64, |plugin| {
+        plugin.call_raw_batch(&descriptors, flags)
+    })
     .ok_or_else(|| JniError::PluginCall {
         code: 1,
         message: "Invalid plugin handle".to_string(),
     })?
     .ok_or_else(|| JniError::PluginCall {
         code: 6,
-        message: "Binary transport not supported by this plugin".to_string(),
+        message: "Batch binary transport not supported by this plugin".to_string(),
+    })?
+    .map_err(|code| JniError::PluginCall {
+        code,
+        message: "Batch call rejected by plugin".to_string(),
     })?;
 
-    // Check for errors
-    if response.is_error() {
-        let error_code = response.error_code;
-        // SAFETY: response contains valid data from plugin_call_raw
+    let result = copy_batch_responses(env, &responses);
+
+    // Free every response, whether or not it was copied
+    for response in &mut responses {
+        // SAFETY: each response is a valid RbResponse from plugin_call_raw_batch
+        unsafe { response.free() };
+    }
+
+    result
+}
+
+/// Copy batch responses into a Java byte[][], failing on the first error response.
+fn copy_batch_responses<'local>(
+    env: &mut JNIEnv<'local>,
+    responses: &[ffi_types::RbResponse],
+) -> Result<JObjectArray<'local>, JniError> {
+    if let Some(failed) = responses.iter().find(|r| r.is_error()) {
+        // SAFETY: response contains valid data from plugin_call_raw_batch
         let error_msg = unsafe {
-            let slice = response.as_slice();
+            let slice = failed.as_slice();
             std::str::from_utf8(slice).unwrap_or("Unknown error")
         };
-        let err = JniError::PluginCall {
-            code: error_code,
+        return Err(JniError::PluginCall {
+            code: failed.error_code,
             message: error_msg.to_string(),
-        };
-
-        // Free the response
-        // SAFETY: response is a valid RbResponse from plugin_call_raw
-        unsafe {
-            let mut resp = response;
-            resp.free();
-        }
-
-        return Err(err);
+        });
     }
 
-    // Get response bytes
-    // SAFETY: response contains valid data from plugin_call_raw
-    let response_bytes = unsafe { response.as_slice() };
-
-    // Create Java byte array
     let result = env
-        .new_byte_array(response_bytes.len() as i32)
+        .new_object_array(responses.len() as i32, "[B", JObject::null())
         .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
 
-    env.set_byte_array_region(&result, 0, bytemuck_cast_slice(response_bytes))
-        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
-
-    // Free the response
-    // SAFETY: response is a valid RbResponse from plugin_call_raw
-    unsafe {
-        let mut resp = response;
-        resp.free();
+    for (i, response) in responses.iter().enumerate() {
+        // SAFETY: response contains valid data from plugin_call_raw_batch
+        let response_bytes = unsafe { response.as_slice() };
+        let element = env
+            .new_byte_array(response_bytes.len() as i32)
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        env.set_byte_array_region(&element, 0, bytemuck_cast_slice(response_bytes))
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        env.set_object_array_element(&result, i as i32, &element)
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+        env.delete_local_ref(element)
+            .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
     }
 
     Ok(result)
@@ -429,6 +850,163 @@ fn bytemuck_cast_slice(bytes: &[u8]) -> &[i8] {
     unsafe { std::slice::from_raw_parts(bytes.as_ptr() as *const i8, bytes.len()) }
 }
 
+/// Check if streamed requests are supported.
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeHasStreamedRequests<'local>(
+    _env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+) -> jboolean {
+    let result =
+        with_plugin(handle as u64, |plugin| plugin.has_streamed_requests()).unwrap_or(false);
+    if result { JNI_TRUE } else { JNI_FALSE }
+}
+
+/// Open a streamed request.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `type_tag`: Message type tag
+///
+/// # Returns
+/// Input ID for the request, or throws PluginException on failure
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeInputOpen<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    type_tag: JString<'local>,
+) -> jlong {
+    match input_open_impl(&mut env, handle, type_tag) {
+        Ok(input_id) => input_id as jlong,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            0
+        }
+    }
+}
+
+fn input_open_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    type_tag: JString<'local>,
+) -> Result<u64, JniError> {
+    let type_tag_cstr = type_tag_cstring(env, &type_tag)?;
+
+    let (mut buffer, input_id) = with_plugin(handle as u64, |plugin| {
+        plugin.input_open(type_tag_cstr.as_ptr())
+    })
+    .ok_or_else(invalid_handle)?
+    .ok_or_else(streamed_requests_unsupported)?;
+
+    // SAFETY: buffer contains valid data from plugin_input_open
+    let result = if buffer.is_error() {
+        Err(error_from_bytes(buffer.error_code, unsafe {
+            buffer.as_slice()
+        }))
+    } else {
+        Ok(input_id)
+    };
+    // SAFETY: buffer is a valid FfiBuffer from plugin_input_open
+    unsafe { buffer.free() };
+    result
+}
+
+/// Append a chunk, read in place from a direct ByteBuffer, to a streamed request.
+///
+/// Blocks while the plugin's handler is behind.
+///
+/// # Parameters
+/// - `handle`: Plugin handle
+/// - `input_id`: Input ID from nativeInputOpen
+/// - `data`: Direct buffer holding the chunk
+/// - `offset`, `length`: Range of the chunk within the buffer
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeInputWrite<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    input_id: jlong,
+    data: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) {
+    if let Err(e) = input_write_impl(&mut env, handle, input_id, data, offset, length) {
+        throw_plugin_exception(&mut env, e.code(), &e.to_string());
+    }
+}
+
+fn input_write_impl<'local>(
+    env: &mut JNIEnv<'local>,
+    handle: jlong,
+    input_id: jlong,
+    data: JByteBuffer<'local>,
+    offset: jint,
+    length: jint,
+) -> Result<(), JniError> {
+    // SAFETY: the Java caller keeps the buffer reachable for the call
+    let chunk = unsafe { direct_buffer_slice(env, &data, offset, length) }?;
+
+    let code = with_plugin(handle as u64, |plugin| {
+        plugin.input_write(input_id as u64, chunk.as_ptr(), chunk.len())
+    })
+    .ok_or_else(invalid_handle)?
+    .ok_or_else(streamed_requests_unsupported)?;
+
+    match code {
+        0 => Ok(()),
+        code => Err(JniError::PluginCall {
+            code,
+            message: "Request write rejected by plugin".to_string(),
+        }),
+    }
+}
+
+/// End a streamed request and wait for the response.
+///
+/// # Returns
+/// JSON response string, or throws PluginException on failure
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeInputFinish<'local>(
+    mut env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    input_id: jlong,
+) -> JString<'local> {
+    let result = with_plugin(handle as u64, |plugin| plugin.input_finish(input_id as u64))
+        .ok_or_else(invalid_handle)
+        .and_then(|buffer| buffer.ok_or_else(streamed_requests_unsupported))
+        .and_then(take_call_response)
+        .and_then(|response| {
+            env.new_string(&response)
+                .map_err(|e| JniError::StringConversion(e.to_string()))
+        });
+    match result {
+        Ok(response) => response,
+        Err(e) => {
+            throw_plugin_exception(&mut env, e.code(), &e.to_string());
+            JString::default()
+        }
+    }
+}
+
+/// Discard a streamed request.
+///
+/// # Returns
+/// true if the request was open
+#[unsafe(no_mangle)]
+pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeInputAbort<'local>(
+    _env: JNIEnv<'local>,
+    _class: JClass<'local>,
+    handle: jlong,
+    input_id: jlong,
+) -> jboolean {
+    let result = with_plugin(handle as u64, |plugin| plugin.input_abort(input_id as u64))
+        .flatten()
+        .unwrap_or(false);
+    if result { JNI_TRUE } else { JNI_FALSE }
+}
+
 /// Set the log level for a plugin.
 #[unsafe(no_mangle)]
 pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeSetLogLevel<'local>(
@@ -460,12 +1038,9 @@ pub extern "system" fn Java_com_rustbridge_jni_JniPlugin_nativeShutdown<'local>(
     _class: JClass<'local>,
     handle: jlong,
 ) -> jboolean {
-    // Remove from our registry and shutdown
-    let result = if let Some(plugin) = remove_plugin(handle as u64) {
-        plugin.shutdown()
-    } else {
-        false
-    };
+    // Remove from our registry and shutdown; the library is unloaded once
+    // calls still in flight have returned
+    let result = registry::remove(handle as u64, LoadedPlugin::shutdown).unwrap_or(false);
 
     if result { JNI_TRUE } else { JNI_FALSE }
 }
@@ -520,6 +1095,140 @@ fn throw_plugin_exception(env: &mut JNIEnv, code: u32, message: &str) {
     let _ = env.throw(throwable);
 }
 
+/// Copy a Java byte array into this thread's request buffer and pass it to `f`.
+///
+/// Plugin calls can block (admission waits, async handlers, arbitrary handler
+/// code), so requests are copied out of the JVM heap rather than pinned in a
+/// critical region, which would stall the garbage collector for every thread.
+/// The buffer is reused across calls, so steady-state calls do not allocate.
+fn with_request_bytes<T>(
+    env: &JNIEnv,
+    request: &JByteArray,
+    f: impl FnOnce(&[u8]) -> T,
+) -> Result<T, JniError> {
+    let len = env
+        .get_array_length(request)
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))? as usize;
+    // Taken rather than borrowed, so a call made from inside `f` gets its own
+    let mut buffer = REQUEST_BUFFER.with(RefCell::take);
+    buffer.clear();
+    buffer.resize(len, 0);
+    env.get_byte_array_region(request, 0, bytemuck_cast_slice_mut(&mut buffer))
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+
+    let result = f(&buffer);
+
+    if buffer.capacity() <= MAX_RETAINED_REQUEST {
+        REQUEST_BUFFER.with(|retained| {
+            let mut retained = retained.borrow_mut();
+            if retained.capacity() < buffer.capacity() {
+                *retained = buffer;
+            }
+        });
+    }
+    Ok(result)
+}
+
+/// Convert a Java type tag to a C string.
+fn type_tag_cstring(env: &mut JNIEnv, type_tag: &JString) -> Result<CString, JniError> {
+    let type_tag_str: String = env
+        .get_string(type_tag)
+        .map_err(|e| JniError::StringConversion(e.to_string()))?
+        .into();
+    CString::new(type_tag_str).map_err(|e| JniError::StringConversion(e.to_string()))
+}
+
+/// Borrow `length` bytes at `offset` of a direct ByteBuffer without copying.
+///
+/// # Safety
+///
+/// The buffer must stay reachable, and its memory unchanged, while the slice is used.
+unsafe fn direct_buffer_slice<'a>(
+    env: &JNIEnv,
+    buffer: &JByteBuffer,
+    offset: jint,
+    length: jint,
+) -> Result<&'a [u8], JniError> {
+    let (address, length) = direct_buffer_range(env, buffer, offset, length)?;
+    if length == 0 {
+        return Ok(&[]);
+    }
+    // SAFETY: the range lies within the buffer, which the caller keeps alive
+    Ok(unsafe { std::slice::from_raw_parts(address, length) })
+}
+
+/// Mutably borrow `length` bytes at `offset` of a direct ByteBuffer.
+///
+/// # Safety
+///
+/// The buffer must stay reachable, and nothing else may access its memory,
+/// while the slice is used.
+unsafe fn direct_buffer_slice_mut<'a>(
+    env: &JNIEnv,
+    buffer: &JByteBuffer,
+    offset: jint,
+    length: jint,
+) -> Result<&'a mut [u8], JniError> {
+    let (address, length) = direct_buffer_range(env, buffer, offset, length)?;
+    if length == 0 {
+        return Ok(&mut []);
+    }
+    // SAFETY: the range lies within the buffer, which the caller keeps alive
+    // and does not otherwise access
+    Ok(unsafe { std::slice::from_raw_parts_mut(address, length) })
+}
+
+/// Check `length` bytes at `offset` against a direct ByteBuffer's capacity,
+/// returning the address of the range.
+fn direct_buffer_range(
+    env: &JNIEnv,
+    buffer: &JByteBuffer,
+    offset: jint,
+    length: jint,
+) -> Result<(*mut u8, usize), JniError> {
+    let address = env
+        .get_direct_buffer_address(buffer)
+        .map_err(|e| JniError::ArrayAccess(format!("Not a direct buffer: {}", e)))?;
+    let capacity = env
+        .get_direct_buffer_capacity(buffer)
+        .map_err(|e| JniError::ArrayAccess(e.to_string()))?;
+
+    let (Ok(offset), Ok(length)) = (usize::try_from(offset), usize::try_from(length)) else {
+        return Err(JniError::ArrayAccess(
+            "Negative buffer offset or length".to_string(),
+        ));
+    };
+    if offset.checked_add(length).is_none_or(|end| end > capacity) {
+        return Err(JniError::ArrayAccess(format!(
+            "Range {}+{} exceeds buffer capacity {}",
+            offset, length, capacity
+        )));
+    }
+    // The offset is within the buffer, so the address stays in bounds
+    Ok((address.wrapping_add(offset), length))
+}
+
+fn invalid_handle() -> JniError {
+    JniError::PluginCall {
+        code: 1,
+        message: "Invalid plugin handle".to_string(),
+    }
+}
+
+fn binary_transport_unsupported() -> JniError {
+    JniError::PluginCall {
+        code: 6,
+        message: "Binary transport not supported by this plugin".to_string(),
+    }
+}
+
+fn streamed_requests_unsupported() -> JniError {
+    JniError::PluginCall {
+        code: 6,
+        message: "Streamed requests not supported by this plugin".to_string(),
+    }
+}
+
 /// Cast a &mut [u8] to &mut [i8] for JNI byte array operations.
 fn bytemuck_cast_slice_mut(bytes: &mut [u8]) -> &mut [i8] {
     // SAFETY: u8 and i8 have the same size and alignment
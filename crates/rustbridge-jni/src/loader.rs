@@ -1,7 +1,7 @@
 //! Dynamic library loading for plugins.
 
 use crate::error::JniError;
-use crate::ffi_types::{FfiBuffer, LogCallback, RbResponse};
+use crate::ffi_types::{FfiBuffer, LogCallback, RbBatchRequest, RbResponse};
 use libloading::{Library, Symbol};
 use std::ffi::{c_char, c_void};
 
@@ -21,19 +21,32 @@ pub struct LoadedPlugin {
 /// Function pointers to plugin FFI functions.
 struct PluginFfi {
     call: PluginCallFn,
+    type_ids: Option<TypeIdFfi>,
     call_raw: Option<PluginCallRawFn>,
+    call_raw_into: Option<PluginCallRawIntoFn>,
+    call_raw_batch: Option<PluginCallRawBatchFn>,
+    input: Option<InputFfi>,
     get_state: PluginGetStateFn,
     set_log_level: PluginSetLogLevelFn,
     get_rejected_count: PluginGetRejectedCountFn,
     shutdown: PluginShutdownFn,
 }
 
-impl LoadedPlugin {
-    /// Get the FFI handle for this plugin.
-    pub fn handle(&self) -> u64 {
-        self.handle
-    }
+/// Function pointers for calls by type ID, present only as a pair.
+struct TypeIdFfi {
+    resolve: PluginResolveTypeTagFn,
+    call: PluginCallIdFn,
+}
+
+/// Function pointers for streamed requests, present only as a set.
+struct InputFfi {
+    open: PluginInputOpenFn,
+    write: PluginInputWriteFn,
+    finish: PluginInputFinishFn,
+    abort: PluginInputAbortFn,
+}
 
+impl LoadedPlugin {
     /// Call the plugin.
     pub fn call(
         &self,
@@ -45,6 +58,30 @@ impl LoadedPlugin {
         unsafe { (self.ffi.call)(self.handle as *mut c_void, type_tag, request, request_len) }
     }
 
+    /// Resolve a type tag to the plugin's numeric type ID.
+    ///
+    /// Returns None if calls by type ID are not supported; otherwise the ID,
+    /// or 0 if the plugin does not list the tag.
+    pub fn resolve_type_tag(&self, type_tag: *const c_char) -> Option<u32> {
+        let type_ids = self.ffi.type_ids.as_ref()?;
+        // SAFETY: handle is valid, type_tag is a valid C string
+        Some(unsafe { (type_ids.resolve)(self.handle as *mut c_void, type_tag) })
+    }
+
+    /// Call the plugin by a type ID from `resolve_type_tag`.
+    ///
+    /// Returns None if calls by type ID are not supported.
+    pub fn call_id(
+        &self,
+        type_id: u32,
+        request: *const u8,
+        request_len: usize,
+    ) -> Option<FfiBuffer> {
+        let type_ids = self.ffi.type_ids.as_ref()?;
+        // SAFETY: handle is valid, request is valid for request_len bytes
+        Some(unsafe { (type_ids.call)(self.handle as *mut c_void, type_id, request, request_len) })
+    }
+
     /// Get the plugin state.
     pub fn get_state(&self) -> u8 {
         // SAFETY: handle is valid
@@ -94,6 +131,114 @@ impl LoadedPlugin {
             )
         })
     }
+
+    /// Make a raw binary call that writes the response into `out`.
+    ///
+    /// Returns None if the entry point is not supported; otherwise the
+    /// plugin's status code, with `out_len` set as `plugin_call_raw_into`
+    /// documents.
+    pub fn call_raw_into(
+        &self,
+        message_id: u32,
+        request: &[u8],
+        out: &mut [u8],
+        out_len: &mut usize,
+    ) -> Option<u32> {
+        let call_raw_into_fn = self.ffi.call_raw_into?;
+        // SAFETY: handle is valid, request and out are valid for their lengths
+        Some(unsafe {
+            call_raw_into_fn(
+                self.handle as *mut c_void,
+                message_id,
+                request.as_ptr() as *const c_void,
+                request.len(),
+                out.as_mut_ptr() as *mut c_void,
+                out.len(),
+                out_len,
+            )
+        })
+    }
+
+    /// Check if the batched binary entry point is supported.
+    pub fn has_batch_transport(&self) -> bool {
+        self.ffi.call_raw_batch.is_some()
+    }
+
+    /// Make a batch of raw binary calls to the plugin.
+    ///
+    /// Returns None if batch transport is not supported. On success there is
+    /// one response per request, each of which must be freed by the caller;
+    /// otherwise the error code returned by the plugin.
+    pub fn call_raw_batch(
+        &self,
+        requests: &[RbBatchRequest],
+        flags: u32,
+    ) -> Option<Result<Vec<RbResponse>, u32>> {
+        let call_raw_batch_fn = self.ffi.call_raw_batch?;
+        let mut responses: Vec<RbResponse> = Vec::with_capacity(requests.len());
+        // SAFETY: handle is valid, requests is valid for its length, and
+        // responses has capacity for one RbResponse per request
+        let code = unsafe {
+            call_raw_batch_fn(
+                self.handle as *mut c_void,
+                requests.as_ptr(),
+                requests.len(),
+                responses.as_mut_ptr(),
+                flags,
+            )
+        };
+        if code != 0 {
+            return Some(Err(code));
+        }
+        // SAFETY: a successful batch call initializes every response slot
+        unsafe { responses.set_len(requests.len()) };
+        Some(Ok(responses))
+    }
+
+    /// Check if streamed requests are supported.
+    pub fn has_streamed_requests(&self) -> bool {
+        self.ffi.input.is_some()
+    }
+
+    /// Open a streamed request.
+    ///
+    /// Returns None if streamed requests are not supported. Otherwise the
+    /// buffer returned by the plugin (empty on success, to be freed by the
+    /// caller) and the input ID it assigned.
+    pub fn input_open(&self, type_tag: *const c_char) -> Option<(FfiBuffer, u64)> {
+        let input = self.ffi.input.as_ref()?;
+        let mut input_id = 0u64;
+        // SAFETY: handle is valid, type_tag is a valid C string, input_id is writable
+        let buffer = unsafe { (input.open)(self.handle as *mut c_void, type_tag, &mut input_id) };
+        Some((buffer, input_id))
+    }
+
+    /// Append a chunk to a streamed request, blocking while the handler is behind.
+    ///
+    /// Returns None if streamed requests are not supported.
+    pub fn input_write(&self, input_id: u64, data: *const u8, len: usize) -> Option<u32> {
+        let input = self.ffi.input.as_ref()?;
+        // SAFETY: handle is valid, data is valid for len bytes
+        Some(unsafe { (input.write)(self.handle as *mut c_void, input_id, data, len) })
+    }
+
+    /// End a streamed request and wait for its response envelope.
+    ///
+    /// Returns None if streamed requests are not supported.
+    pub fn input_finish(&self, input_id: u64) -> Option<FfiBuffer> {
+        let input = self.ffi.input.as_ref()?;
+        // SAFETY: handle is valid
+        Some(unsafe { (input.finish)(self.handle as *mut c_void, input_id) })
+    }
+
+    /// Discard a streamed request.
+    ///
+    /// Returns None if streamed requests are not supported.
+    pub fn input_abort(&self, input_id: u64) -> Option<bool> {
+        let input = self.ffi.input.as_ref()?;
+        // SAFETY: handle is valid
+        Some(unsafe { (input.abort)(self.handle as *mut c_void, input_id) })
+    }
 }
 
 // Type signatures for FFI functions
@@ -110,12 +255,45 @@ type PluginCallFn = unsafe extern "C" fn(
     request: *const u8,
     request_len: usize,
 ) -> FfiBuffer;
+type PluginResolveTypeTagFn =
+    unsafe extern "C" fn(handle: *mut c_void, type_tag: *const c_char) -> u32;
+type PluginCallIdFn = unsafe extern "C" fn(
+    handle: *mut c_void,
+    type_id: u32,
+    request: *const u8,
+    request_len: usize,
+) -> FfiBuffer;
 type PluginCallRawFn = unsafe extern "C" fn(
     handle: *mut c_void,
     message_id: u32,
     request: *const c_void,
     request_len: usize,
 ) -> RbResponse;
+type PluginCallRawIntoFn = unsafe extern "C" fn(
+    handle: *mut c_void,
+    message_id: u32,
+    request: *const c_void,
+    request_size: usize,
+    out: *mut c_void,
+    out_capacity: usize,
+    out_len: *mut usize,
+) -> u32;
+type PluginCallRawBatchFn = unsafe extern "C" fn(
+    handle: *mut c_void,
+    requests: *const RbBatchRequest,
+    count: usize,
+    responses: *mut RbResponse,
+    flags: u32,
+) -> u32;
+type PluginInputOpenFn = unsafe extern "C" fn(
+    handle: *mut c_void,
+    type_tag: *const c_char,
+    input_id: *mut u64,
+) -> FfiBuffer;
+type PluginInputWriteFn =
+    unsafe extern "C" fn(handle: *mut c_void, input_id: u64, data: *const u8, len: usize) -> u32;
+type PluginInputFinishFn = unsafe extern "C" fn(handle: *mut c_void, input_id: u64) -> FfiBuffer;
+type PluginInputAbortFn = unsafe extern "C" fn(handle: *mut c_void, input_id: u64) -> bool;
 type PluginGetStateFn = unsafe extern "C" fn(handle: *mut c_void) -> u8;
 type PluginSetLogLevelFn = unsafe extern "C" fn(handle: *mut c_void, level: u8);
 type PluginGetRejectedCountFn = unsafe extern "C" fn(handle: *mut c_void) -> u64;
@@ -150,9 +328,29 @@ pub fn load_plugin(
     let call_fn: Symbol<PluginCallFn> = unsafe { library.get(b"plugin_call\0") }
         .map_err(|e| JniError::SymbolNotFound(format!("plugin_call: {}", e)))?;
 
+    // Try to load call-by-ID symbols (optional)
+    let resolve_type_tag_fn: Option<Symbol<PluginResolveTypeTagFn>> =
+        unsafe { library.get(b"plugin_resolve_type_tag\0") }.ok();
+    let call_id_fn: Option<Symbol<PluginCallIdFn>> =
+        unsafe { library.get(b"plugin_call_id\0") }.ok();
+
     // Try to load binary transport symbols (optional)
     let call_raw_fn: Option<Symbol<PluginCallRawFn>> =
         unsafe { library.get(b"plugin_call_raw\0") }.ok();
+    let call_raw_into_fn: Option<Symbol<PluginCallRawIntoFn>> =
+        unsafe { library.get(b"plugin_call_raw_into\0") }.ok();
+    let call_raw_batch_fn: Option<Symbol<PluginCallRawBatchFn>> =
+        unsafe { library.get(b"plugin_call_raw_batch\0") }.ok();
+
+    // Try to load streamed request symbols (optional)
+    let input_open_fn: Option<Symbol<PluginInputOpenFn>> =
+        unsafe { library.get(b"plugin_input_open\0") }.ok();
+    let input_write_fn: Option<Symbol<PluginInputWriteFn>> =
+        unsafe { library.get(b"plugin_input_write\0") }.ok();
+    let input_finish_fn: Option<Symbol<PluginInputFinishFn>> =
+        unsafe { library.get(b"plugin_input_finish\0") }.ok();
+    let input_abort_fn: Option<Symbol<PluginInputAbortFn>> =
+        unsafe { library.get(b"plugin_input_abort\0") }.ok();
 
     let get_state_fn: Symbol<PluginGetStateFn> = unsafe { library.get(b"plugin_get_state\0") }
         .map_err(|e| JniError::SymbolNotFound(format!("plugin_get_state: {}", e)))?;
@@ -172,7 +370,30 @@ pub fn load_plugin(
     // SAFETY: These function pointers are valid as long as the library is loaded
     let ffi = PluginFfi {
         call: *call_fn,
+        type_ids: match (resolve_type_tag_fn, call_id_fn) {
+            (Some(resolve), Some(call)) => Some(TypeIdFfi {
+                resolve: *resolve,
+                call: *call,
+            }),
+            _ => None,
+        },
         call_raw: call_raw_fn.map(|f| *f),
+        call_raw_into: call_raw_into_fn.map(|f| *f),
+        call_raw_batch: call_raw_batch_fn.map(|f| *f),
+        input: match (
+            input_open_fn,
+            input_write_fn,
+            input_finish_fn,
+            input_abort_fn,
+        ) {
+            (Some(open), Some(write), Some(finish), Some(abort)) => Some(InputFfi {
+                open: *open,
+                write: *write,
+                finish: *finish,
+                abort: *abort,
+            }),
+            _ => None,
+        },
         get_state: *get_state_fn,
         set_log_level: *set_log_level_fn,
         get_rejected_count: *get_rejected_count_fn,
@@ -0,0 +1,201 @@
+//! Lock-free registry of loaded plugins.
+//!
+//! Every native method looks its plugin up by the handle Java passes in, so
+//! the lookup sits on the hot path of each call. The registry is a fixed
+//! table of slots; a handle packs a slot index (low 32 bits, offset by one so
+//! a handle is never 0) and the slot's generation (high 32 bits), so handles
+//! of removed plugins are rejected even after their slot is reused.
+//!
+//! A lookup counts itself into the slot's reader count, then checks the
+//! slot's entry and generation; it takes no lock and touches no reference
+//! count. Removal unlinks the entry and retires it; whoever brings the
+//! reader count to zero (the removal itself, or the last guard dropped)
+//! drops it, unloads the library and frees the slot. Removal never waits for
+//! readers, so a plugin can be shut down from inside one of its own calls.
+//! Loading and removing plugins is rare and serializes on a mutex.
+//!
+//! rustbridge-ffi has a hazard-pointer table for the same job, but this
+//! crate cannot link it (see the crate docs), and a per-slot reader count is
+//! enough for the handful of plugins a JVM loads.
+
+use crate::loader::LoadedPlugin;
+use std::ops::Deref;
+use std::ptr;
+use std::sync::atomic::{AtomicPtr, AtomicU32, AtomicUsize, Ordering};
+use std::sync::{Mutex, MutexGuard, OnceLock, PoisonError};
+
+/// Maximum number of plugins loaded at once
+const CAPACITY: usize = 1024;
+
+/// One plugin slot
+struct Slot {
+    /// Position in the table
+    index: u32,
+    /// Bumped on every removal
+    generation: AtomicU32,
+    /// Entry from `Box::into_raw`, or null when the slot is free
+    entry: AtomicPtr<LoadedPlugin>,
+    /// Removed entry waiting for its readers to leave, or null
+    retired: AtomicPtr<LoadedPlugin>,
+    /// Lookups currently inside the slot
+    readers: AtomicUsize,
+}
+
+impl Slot {
+    /// Leave the slot, dropping its retired entry if this was the last reader.
+    fn release(&self) {
+        if self.readers.fetch_sub(1, Ordering::SeqCst) == 1 {
+            self.reclaim();
+        }
+    }
+
+    /// Drop the retired entry and free the slot, if no reader is inside.
+    fn reclaim(&self) {
+        if self.readers.load(Ordering::SeqCst) != 0 {
+            return;
+        }
+        // Only one of the threads that saw the count reach zero gets it
+        let entry = self.retired.swap(ptr::null_mut(), Ordering::SeqCst);
+        if entry.is_null() {
+            return;
+        }
+        // SAFETY: the entry came from Box::into_raw, was unlinked before it
+        // was retired, and no reader is left that found it
+        drop(unsafe { Box::from_raw(entry) });
+
+        // The slot is only reused once its retired entry is gone
+        registry().free_list().push(self.index);
+    }
+}
+
+/// Fixed table of plugin slots
+struct Registry {
+    slots: Box<[Slot]>,
+    /// Free slot indices, reused most recently freed first
+    free: Mutex<Vec<u32>>,
+}
+
+fn registry() -> &'static Registry {
+    static REGISTRY: OnceLock<Registry> = OnceLock::new();
+    REGISTRY.get_or_init(|| Registry {
+        slots: (0..CAPACITY as u32)
+            .map(|index| Slot {
+                index,
+                generation: AtomicU32::new(0),
+                entry: AtomicPtr::new(ptr::null_mut()),
+                retired: AtomicPtr::new(ptr::null_mut()),
+                readers: AtomicUsize::new(0),
+            })
+            .collect(),
+        free: Mutex::new((0..CAPACITY as u32).rev().collect()),
+    })
+}
+
+impl Registry {
+    fn free_list(&self) -> MutexGuard<'_, Vec<u32>> {
+        // The list is consistent after every push and pop, so a panic while
+        // it was held leaves nothing to repair
+        self.free.lock().unwrap_or_else(PoisonError::into_inner)
+    }
+}
+
+fn encode_handle(index: u32, generation: u32) -> u64 {
+    (u64::from(generation) << 32) | u64::from(index + 1)
+}
+
+fn decode_handle(handle: u64) -> Option<(usize, u32)> {
+    let index = (handle as u32).checked_sub(1)?;
+    Some((index as usize, (handle >> 32) as u32))
+}
+
+/// Register a loaded plugin, returning its handle.
+///
+/// Gives the plugin back if every slot is taken.
+pub fn insert(plugin: LoadedPlugin) -> Result<u64, LoadedPlugin> {
+    let registry = registry();
+    let mut free = registry.free_list();
+    let Some(index) = free.pop() else {
+        return Err(plugin);
+    };
+    let slot = &registry.slots[index as usize];
+    slot.entry
+        .store(Box::into_raw(Box::new(plugin)), Ordering::SeqCst);
+    Ok(encode_handle(index, slot.generation.load(Ordering::SeqCst)))
+}
+
+/// Look up a plugin without taking a lock.
+///
+/// The plugin stays loaded until the guard is dropped, even if it is removed
+/// meanwhile.
+pub fn get(handle: u64) -> Option<PluginGuard> {
+    let (index, generation) = decode_handle(handle)?;
+    let slot = registry().slots.get(index)?;
+
+    // Count in before reading the entry, so a removal that unlinks it after
+    // this point waits for us
+    slot.readers.fetch_add(1, Ordering::SeqCst);
+    let entry = slot.entry.load(Ordering::SeqCst);
+    if entry.is_null() || slot.generation.load(Ordering::SeqCst) != generation {
+        slot.release();
+        return None;
+    }
+    Some(PluginGuard { slot, entry })
+}
+
+/// Remove a plugin, running `f` on it before it is dropped.
+///
+/// `f` may run while calls that looked the plugin up earlier are still in
+/// flight, including one on this thread; the plugin is dropped by the last
+/// of them to return, or here if there are none.
+pub fn remove<R>(handle: u64, f: impl FnOnce(&LoadedPlugin) -> R) -> Option<R> {
+    let (index, generation) = decode_handle(handle)?;
+    let registry = registry();
+    let slot = registry.slots.get(index)?;
+
+    let entry = {
+        // Serialize with insert, so a slot reused after the generation
+        // check cannot lose its new plugin
+        let _free = registry.free_list();
+        if slot.generation.load(Ordering::SeqCst) != generation {
+            return None;
+        }
+        let entry = slot.entry.swap(ptr::null_mut(), Ordering::SeqCst);
+        if entry.is_null() {
+            return None;
+        }
+        slot.generation.fetch_add(1, Ordering::SeqCst);
+        entry
+    };
+
+    // Count in while `f` runs, so a guard dropped meanwhile cannot free the
+    // entry under it
+    slot.readers.fetch_add(1, Ordering::SeqCst);
+    // SAFETY: the entry came from Box::into_raw and is only freed once
+    // retired and unread
+    let result = f(unsafe { &*entry });
+    slot.retired.store(entry, Ordering::SeqCst);
+    slot.release();
+    Some(result)
+}
+
+/// A plugin found in the registry, kept loaded while the guard lives.
+pub struct PluginGuard {
+    slot: &'static Slot,
+    entry: *const LoadedPlugin,
+}
+
+impl Deref for PluginGuard {
+    type Target = LoadedPlugin;
+
+    fn deref(&self) -> &LoadedPlugin {
+        // SAFETY: the slot's reader count keeps a retired entry from being
+        // dropped
+        unsafe { &*self.entry }
+    }
+}
+
+impl Drop for PluginGuard {
+    fn drop(&mut self) {
+        self.slot.release();
+    }
+}
@@ -1,9 +1,14 @@
 //! FFI log callback management
 
+use crate::queue::{LogQueue, QueuedLog};
 use once_cell::sync::OnceCell;
 use parking_lot::RwLock;
-use rustbridge_core::LogLevel;
-use std::sync::atomic::{AtomicU8, AtomicUsize, Ordering};
+use rustbridge_core::{LogDelivery, LogLevel, LoggingConfig, PluginConfig};
+use std::cell::RefCell;
+use std::sync::atomic::{AtomicBool, AtomicU8, AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Weak};
+use std::thread::Thread;
+use std::time::Duration;
 
 /// FFI callback function type for logging
 ///
@@ -23,121 +28,251 @@ pub type LogCallback = extern "C" fn(
     message_len: usize,
 );
 
-/// Global log callback manager
-static CALLBACK_MANAGER: OnceCell<LogCallbackManager> = OnceCell::new();
+/// One event in a batch passed to [`LogBatchCallback`]
+///
+/// Neither string is null-terminated; both pointers are valid only for the
+/// duration of the callback.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct RbLogRecord {
+    /// Log level (0=Trace, 1=Debug, 2=Info, 3=Warn, 4=Error)
+    pub level: u8,
+    /// Log target (module path), UTF-8 bytes
+    pub target: *const u8,
+    /// Length of the target in bytes
+    pub target_len: usize,
+    /// Log message, UTF-8 bytes
+    pub message: *const u8,
+    /// Length of the message in bytes
+    pub message_len: usize,
+}
+
+/// FFI callback function type for batched log delivery
+///
+/// # Parameters
+/// - `records`: Pointer to `count` consecutive [`RbLogRecord`]s, oldest first
+/// - `count`: Number of records
+///
+/// # Safety
+/// The records and the strings they point to are valid only during the callback.
+pub type LogBatchCallback = extern "C" fn(records: *const RbLogRecord, count: usize);
+
+/// Fallback manager for events logged outside any plugin's scope
+static CALLBACK_MANAGER: OnceCell<Arc<LogCallbackManager>> = OnceCell::new();
+
+/// Number of live managers at each level, indexed by `LogLevel as u8`
+static LEVEL_COUNTS: [AtomicUsize; 6] = [const { AtomicUsize::new(0) }; 6];
+
+/// Most verbose level enabled by any live manager
+static MAX_LEVEL: AtomicU8 = AtomicU8::new(LogLevel::Off as u8);
+
+thread_local! {
+    /// Managers whose callbacks this thread is running, innermost last
+    static DELIVERING: RefCell<Vec<usize>> = const { RefCell::new(Vec::new()) };
+}
 
 /// Manager for FFI log callbacks
 ///
-/// Each plugin can register its own log callback. The callback is cleared
-/// when the plugin that registered it shuts down to prevent use-after-free
-/// (the callback function pointer is tied to the plugin's FFI arena lifetime).
+/// Each plugin handle owns one, with its own callback, level and delivery
+/// mode, and enters it (see [`LogCallbackManager::enter`]) while plugin code
+/// runs. Events logged outside any plugin's scope go to [`Self::global`].
 ///
-/// Log level is shared globally and persists across plugin reload cycles.
+/// The callbacks are cleared by [`Self::close`] when the plugin shuts down,
+/// to prevent use-after-free (the callback function pointer is tied to the
+/// plugin's FFI arena lifetime). Other plugins are unaffected.
+///
+/// Callbacks are copied out and called without holding a lock, so the host
+/// may call back into the plugin (to change the level or callbacks, or to
+/// shut it down) from inside its callback.
 pub struct LogCallbackManager {
     callback: RwLock<Option<LogCallback>>,
     level: AtomicU8,
-    /// Number of active plugins using this callback manager
-    ref_count: AtomicUsize,
-    /// Whether the current callback was registered by a plugin (vs None)
-    has_callback: std::sync::atomic::AtomicBool,
+    batch_callback: RwLock<Option<LogBatchCallback>>,
+    /// Bumped whenever either callback changes
+    generation: AtomicU64,
+    /// Deliveries that copied a callback and may still be calling it
+    in_flight: AtomicUsize,
+    /// Whether events go through the queue instead of straight to the callback
+    async_delivery: AtomicBool,
+    /// Queue and drainer, created the first time asynchronous delivery is enabled
+    drainer: OnceCell<Drainer>,
+    /// Events discarded because the queue was full
+    dropped: AtomicU64,
+}
+
+/// Queue and wake-up state for the drainer thread
+struct Drainer {
+    queue: LogQueue,
+    batch_size: usize,
+    thread: Thread,
+    /// Set once a producer has woken the drainer early, until it next runs
+    wake_pending: AtomicBool,
 }
 
 impl LogCallbackManager {
     /// Create a new callback manager
     pub fn new() -> Self {
+        LEVEL_COUNTS[LogLevel::Info as usize].fetch_add(1, Ordering::SeqCst);
+        refresh_max_level();
         Self {
             callback: RwLock::new(None),
             level: AtomicU8::new(LogLevel::Info as u8),
-            ref_count: AtomicUsize::new(0),
-            has_callback: std::sync::atomic::AtomicBool::new(false),
+            batch_callback: RwLock::new(None),
+            generation: AtomicU64::new(0),
+            in_flight: AtomicUsize::new(0),
+            async_delivery: AtomicBool::new(false),
+            drainer: OnceCell::new(),
+            dropped: AtomicU64::new(0),
+        }
+    }
+
+    /// Create a plugin's manager from its configuration
+    ///
+    /// Applies `log_level` (unknown values mean Info) and `logging`, and
+    /// installs the host's per-event callback. If asynchronous delivery
+    /// cannot start, the warning goes to that callback.
+    pub fn from_config(config: &PluginConfig, callback: Option<LogCallback>) -> Arc<Self> {
+        let level = match config.log_level.to_lowercase().as_str() {
+            "trace" => LogLevel::Trace,
+            "debug" => LogLevel::Debug,
+            "info" => LogLevel::Info,
+            "warn" => LogLevel::Warn,
+            "error" => LogLevel::Error,
+            "off" => LogLevel::Off,
+            _ => LogLevel::Info,
+        };
+        let manager = Arc::new(Self::new());
+        manager.set_callback(callback);
+        manager.set_level(level);
+        if let Err(e) = manager.configure_delivery(&config.logging) {
+            manager.log(
+                LogLevel::Warn,
+                module_path!(),
+                &format!("Failed to start log drainer, logging synchronously: {e}"),
+            );
         }
+        manager
     }
 
-    /// Get the global callback manager instance
-    pub fn global() -> &'static LogCallbackManager {
-        CALLBACK_MANAGER.get_or_init(LogCallbackManager::new)
+    /// Get the fallback manager for events outside any plugin's scope
+    pub fn global() -> &'static Arc<LogCallbackManager> {
+        CALLBACK_MANAGER.get_or_init(|| Arc::new(LogCallbackManager::new()))
     }
 
     /// Set the log callback
     pub fn set_callback(&self, callback: Option<LogCallback>) {
         let mut guard = self.callback.write();
         *guard = callback;
+        self.generation.fetch_add(1, Ordering::Release);
     }
 
-    /// Register a plugin with the callback manager
+    /// Set the batched log callback
     ///
-    /// This increments the reference count and optionally sets the callback.
-    /// If a callback is provided, it replaces any existing callback.
-    ///
-    /// **Important**: The callback function pointer is tied to the plugin's
-    /// FFI arena lifetime. When the plugin shuts down, the callback becomes
-    /// invalid and must be cleared before the arena is closed.
+    /// When set, asynchronous delivery hands the host whole batches instead
+    /// of calling the per-event callback once per event. Like the per-event
+    /// callback, it is cleared by [`Self::close`].
+    pub fn set_batch_callback(&self, callback: Option<LogBatchCallback>) {
+        let mut guard = self.batch_callback.write();
+        *guard = callback;
+        self.generation.fetch_add(1, Ordering::Release);
+    }
+
+    /// Get the current batched log callback
+    pub fn get_batch_callback(&self) -> Option<LogBatchCallback> {
+        *self.batch_callback.read()
+    }
+
+    /// Choose how events reach the host
     ///
-    /// This should be called during plugin initialization.
-    pub fn register_plugin(&self, callback: Option<LogCallback>) {
-        // Increment reference count
-        self.ref_count.fetch_add(1, Ordering::SeqCst);
-
-        // Set callback if provided
-        if let Some(cb) = callback {
-            let mut guard = self.callback.write();
-            *guard = Some(cb);
-            self.has_callback
-                .store(true, std::sync::atomic::Ordering::SeqCst);
+    /// The first switch to [`LogDelivery::Async`] creates the queue with
+    /// `config.queue_capacity` slots and starts the drainer thread; the queue
+    /// size and batch settings are fixed from then on. If the thread cannot
+    /// be spawned, delivery stays synchronous and the spawn error is
+    /// returned. Switching back to [`LogDelivery::Sync`] delivers anything
+    /// still queued first.
+    pub fn configure_delivery(self: &Arc<Self>, config: &LoggingConfig) -> std::io::Result<()> {
+        match config.delivery {
+            LogDelivery::Async => {
+                self.drainer
+                    .get_or_try_init(|| Drainer::start(Arc::downgrade(self), config))?;
+                self.async_delivery.store(true, Ordering::Release);
+            }
+            LogDelivery::Sync => {
+                self.async_delivery.store(false, Ordering::Release);
+                self.flush();
+            }
         }
+        Ok(())
     }
 
-    /// Unregister a plugin from the callback manager
-    ///
-    /// **Critical**: This ALWAYS clears the callback to prevent use-after-free.
-    /// The callback function pointer is tied to the plugin's FFI arena, which
-    /// will be closed immediately after this function returns. If we didn't
-    /// clear the callback, any subsequent logging would call an invalid pointer.
-    ///
-    /// This means that with multiple plugins, the last one to unregister will
-    /// disable logging for any remaining plugins until they re-register a callback.
-    /// This is a safety trade-off: we prioritize crash prevention over convenience.
+    /// Current delivery mode
+    pub fn delivery(&self) -> LogDelivery {
+        if self.async_delivery.load(Ordering::Acquire) {
+            LogDelivery::Async
+        } else {
+            LogDelivery::Sync
+        }
+    }
+
+    /// Number of events dropped because the asynchronous queue was full
+    pub fn dropped_count(&self) -> u64 {
+        self.dropped.load(Ordering::Relaxed)
+    }
+
+    /// Deliver every queued event on the calling thread
+    pub fn flush(&self) {
+        if let Some(drainer) = self.drainer.get() {
+            self.drain(&drainer.queue, drainer.batch_size);
+        }
+    }
+
+    /// Flush queued events, then clear both callbacks
     ///
-    /// Note: The reload handle is NOT cleared because logging initialization
-    /// only happens once per process. The reload handle must persist across
-    /// plugin reload cycles.
+    /// **Critical**: the callback function pointers are tied to the plugin's
+    /// FFI arena, which is closed right after shutdown. After clearing them
+    /// this waits for deliveries on other threads that copied a callback
+    /// earlier, so no callback runs once this returns except one this thread
+    /// is itself inside (when the host shuts down from its callback).
     ///
     /// This should be called during plugin shutdown.
-    pub fn unregister_plugin(&self) {
-        // ALWAYS clear the callback first, before decrementing ref count.
-        // This prevents use-after-free when the plugin's arena is closed.
-        {
-            let mut guard = self.callback.write();
-            *guard = None;
-            self.has_callback
-                .store(false, std::sync::atomic::Ordering::SeqCst);
-        } // Write lock must be released BEFORE logging to avoid deadlock
+    pub fn close(&self) {
+        // Hand queued events to the callback while it is still valid
+        self.flush();
 
-        let prev_count = self.ref_count.fetch_sub(1, Ordering::SeqCst);
+        self.set_batch_callback(None);
+        self.set_callback(None);
 
-        if prev_count == 1 {
-            tracing::debug!("Last plugin unregistered, cleared log callback");
-        } else {
-            tracing::debug!(
-                "Plugin unregistered, cleared log callback (safety). {} plugins remaining",
-                prev_count - 1
-            );
+        let own = DELIVERING
+            .try_with(|delivering| {
+                delivering
+                    .borrow()
+                    .iter()
+                    .filter(|&&manager| manager == self.address())
+                    .count()
+            })
+            .unwrap_or(0);
+        while self.in_flight.load(Ordering::Acquire) > own {
+            std::thread::yield_now();
         }
     }
 
-    /// Get the current reference count (number of active plugins)
-    pub fn plugin_count(&self) -> usize {
-        self.ref_count.load(Ordering::SeqCst)
-    }
-
     /// Get the current log callback
     pub fn get_callback(&self) -> Option<LogCallback> {
         *self.callback.read()
     }
 
     /// Set the log level
+    ///
+    /// Only this manager's events are affected. If no other manager was as
+    /// verbose, the subscriber's interest cache is rebuilt so callsites at
+    /// the new level are no longer skipped (or are skipped again).
     pub fn set_level(&self, level: LogLevel) {
-        self.level.store(level as u8, Ordering::SeqCst);
+        let previous = self.level.swap(level as u8, Ordering::SeqCst);
+        if previous != level as u8 {
+            LEVEL_COUNTS[level as usize].fetch_add(1, Ordering::SeqCst);
+            LEVEL_COUNTS[previous as usize].fetch_sub(1, Ordering::SeqCst);
+            refresh_max_level();
+        }
     }
 
     /// Get the current log level
@@ -162,9 +297,22 @@ impl LogCallbackManager {
         }
 
         // Get callback
-        let callback = match self.get_callback() {
+        let delivery = self.begin_delivery();
+        let callback = match delivery.callback {
             Some(cb) => cb,
-            None => return,
+            None => {
+                if let Some(batch) = delivery.batch_callback {
+                    let record = RbLogRecord {
+                        level: level as u8,
+                        target: target.as_ptr(),
+                        target_len: target.len(),
+                        message: message.as_ptr(),
+                        message_len: message.len(),
+                    };
+                    batch(&record, 1);
+                }
+                return;
+            }
         };
 
         // Prepare target as C string
@@ -181,6 +329,176 @@ impl LogCallbackManager {
             message.len(),
         );
     }
+
+    /// Hand a formatted event to the host according to the delivery mode
+    ///
+    /// In asynchronous mode this only pushes onto the queue, dropping the
+    /// event if the queue is full; otherwise it behaves like [`Self::log`].
+    /// The caller is expected to have checked [`Self::is_enabled`].
+    pub fn submit(&self, level: LogLevel, target: &'static str, message: String) {
+        if self.async_delivery.load(Ordering::Acquire)
+            && let Some(drainer) = self.drainer.get()
+        {
+            let event = QueuedLog {
+                level,
+                target,
+                message,
+            };
+            if drainer.queue.push(event).is_err() {
+                self.dropped.fetch_add(1, Ordering::Relaxed);
+                return;
+            }
+            drainer.wake_if_batch_ready();
+            return;
+        }
+        self.log(level, target, &message);
+    }
+
+    /// Pop and deliver events in batches until the queue is empty
+    fn drain(&self, queue: &LogQueue, batch_size: usize) {
+        let mut batch = Vec::with_capacity(batch_size);
+        let mut records = Vec::with_capacity(batch_size);
+        loop {
+            while batch.len() < batch_size {
+                match queue.pop() {
+                    Some(event) => batch.push(event),
+                    None => break,
+                }
+            }
+            if batch.is_empty() {
+                return;
+            }
+            self.deliver(&batch, &mut records);
+            batch.clear();
+        }
+    }
+
+    /// Pass one batch to the host
+    fn deliver(&self, batch: &[QueuedLog], records: &mut Vec<RbLogRecord>) {
+        let mut delivery = self.begin_delivery();
+        if let Some(callback) = delivery.batch_callback {
+            records.clear();
+            records.extend(batch.iter().map(|event| RbLogRecord {
+                level: event.level as u8,
+                target: event.target.as_ptr(),
+                target_len: event.target.len(),
+                message: event.message.as_ptr(),
+                message_len: event.message.len(),
+            }));
+            callback(records.as_ptr(), records.len());
+            return;
+        }
+
+        for event in batch {
+            // The host may have replaced or cleared the callback from inside it
+            if delivery.is_stale() {
+                delivery = self.begin_delivery();
+            }
+            let Some(callback) = delivery.callback else {
+                return;
+            };
+            // Level may have been raised since the event was queued
+            if !self.is_enabled(event.level) {
+                continue;
+            }
+            let Ok(target) = std::ffi::CString::new(event.target) else {
+                continue;
+            };
+            callback(
+                event.level as u8,
+                target.as_ptr(),
+                event.message.as_ptr(),
+                event.message.len(),
+            );
+        }
+    }
+}
+
+impl LogCallbackManager {
+    /// Copy the callbacks out for one delivery
+    fn begin_delivery(&self) -> Delivery<'_> {
+        let callback = self.callback.read();
+        let batch_callback = self.batch_callback.read();
+        // Counted while the slots are locked, so close() either clears them
+        // first or sees this delivery in flight
+        self.in_flight.fetch_add(1, Ordering::Acquire);
+        let _ = DELIVERING.try_with(|delivering| delivering.borrow_mut().push(self.address()));
+        Delivery {
+            manager: self,
+            callback: *callback,
+            batch_callback: *batch_callback,
+            generation: self.generation.load(Ordering::Acquire),
+        }
+    }
+
+    /// Identity used to recognise this manager's deliveries on a thread
+    fn address(&self) -> usize {
+        self as *const Self as usize
+    }
+}
+
+/// Callbacks copied out of a manager for one delivery
+///
+/// Counted as in flight until dropped, so [`LogCallbackManager::close`] can
+/// wait for it without the callbacks being called under a lock.
+struct Delivery<'a> {
+    manager: &'a LogCallbackManager,
+    callback: Option<LogCallback>,
+    batch_callback: Option<LogBatchCallback>,
+    generation: u64,
+}
+
+impl Delivery<'_> {
+    /// Whether either callback has changed since this delivery began
+    fn is_stale(&self) -> bool {
+        self.manager.generation.load(Ordering::Acquire) != self.generation
+    }
+}
+
+impl Drop for Delivery<'_> {
+    fn drop(&mut self) {
+        let _ = DELIVERING.try_with(|delivering| delivering.borrow_mut().pop());
+        self.manager.in_flight.fetch_sub(1, Ordering::Release);
+    }
+}
+
+impl Drainer {
+    /// Create the queue and spawn the thread that empties it
+    ///
+    /// The thread exits once the manager has been dropped.
+    fn start(manager: Weak<LogCallbackManager>, config: &LoggingConfig) -> std::io::Result<Self> {
+        let interval = Duration::from_millis(config.flush_interval_ms.max(1));
+        let batch_size = config.batch_size.max(1);
+        let thread = std::thread::Builder::new()
+            .name("rustbridge-log".to_string())
+            .spawn(move || {
+                loop {
+                    std::thread::park_timeout(interval);
+                    let Some(manager) = manager.upgrade() else {
+                        return;
+                    };
+                    if let Some(drainer) = manager.drainer.get() {
+                        drainer.wake_pending.store(false, Ordering::Relaxed);
+                        manager.drain(&drainer.queue, drainer.batch_size);
+                    }
+                }
+            })?
+            .thread()
+            .clone();
+        Ok(Self {
+            queue: LogQueue::new(config.queue_capacity),
+            batch_size,
+            thread,
+            wake_pending: AtomicBool::new(false),
+        })
+    }
+
+    /// Wake the drainer before its interval once a full batch is waiting
+    fn wake_if_batch_ready(&self) {
+        if self.queue.len() >= self.batch_size && !self.wake_pending.swap(true, Ordering::Relaxed) {
+            self.thread.unpark();
+        }
+    }
 }
 
 impl Default for LogCallbackManager {
@@ -189,6 +507,34 @@ impl Default for LogCallbackManager {
     }
 }
 
+impl Drop for LogCallbackManager {
+    fn drop(&mut self) {
+        LEVEL_COUNTS[*self.level.get_mut() as usize].fetch_sub(1, Ordering::SeqCst);
+        refresh_max_level();
+        if let Some(drainer) = self.drainer.get() {
+            drainer.thread.unpark();
+        }
+    }
+}
+
+/// Most verbose level enabled by any live manager
+pub(crate) fn max_level() -> LogLevel {
+    LogLevel::from_u8(MAX_LEVEL.load(Ordering::Relaxed))
+}
+
+/// Recompute [`max_level`] and rebuild callsite interest if it changed
+fn refresh_max_level() {
+    // Serialized so a stale computation cannot overwrite a newer one
+    static REFRESH: std::sync::Mutex<()> = std::sync::Mutex::new(());
+    let _guard = REFRESH.lock().unwrap_or_else(|e| e.into_inner());
+    let max = (0..LogLevel::Off as u8)
+        .find(|&level| LEVEL_COUNTS[level as usize].load(Ordering::SeqCst) > 0)
+        .unwrap_or(LogLevel::Off as u8);
+    if MAX_LEVEL.swap(max, Ordering::SeqCst) != max {
+        tracing::callsite::rebuild_interest_cache();
+    }
+}
+
 // Ensure LogCallbackManager is thread-safe
 unsafe impl Send for LogCallbackManager {}
 unsafe impl Sync for LogCallbackManager {}
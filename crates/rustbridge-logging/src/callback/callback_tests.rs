@@ -1,8 +1,8 @@
 #![allow(non_snake_case)]
 
 use super::*;
-use std::sync::Mutex;
 use std::sync::atomic::AtomicUsize;
+use std::sync::{Arc, Mutex};
 
 static CALL_COUNT: AtomicUsize = AtomicUsize::new(0);
 static CALLBACK_TEST_LOCK: Mutex<()> = Mutex::new(());
@@ -125,3 +125,198 @@ fn LogCallbackManager___default___same_as_new() {
     assert_eq!(manager.level(), LogLevel::Info);
     assert!(manager.get_callback().is_none());
 }
+
+static BATCH_RECORDS: AtomicUsize = AtomicUsize::new(0);
+static BATCH_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+extern "C" fn test_batch_callback(_records: *const RbLogRecord, count: usize) {
+    BATCH_CALLS.fetch_add(1, Ordering::SeqCst);
+    BATCH_RECORDS.fetch_add(count, Ordering::SeqCst);
+}
+
+/// Async manager whose drainer never wakes on its own during a test
+fn async_manager(queue_capacity: usize) -> Arc<LogCallbackManager> {
+    let manager = Arc::new(LogCallbackManager::new());
+    manager
+        .configure_delivery(&LoggingConfig {
+            delivery: LogDelivery::Async,
+            queue_capacity,
+            batch_size: 1024,
+            flush_interval_ms: 60_000,
+        })
+        .unwrap();
+    manager
+}
+
+#[test]
+fn LogCallbackManager___configure_delivery___switches_mode() {
+    let manager = async_manager(16);
+
+    assert_eq!(manager.delivery(), LogDelivery::Async);
+
+    manager
+        .configure_delivery(&LoggingConfig::default())
+        .unwrap();
+
+    assert_eq!(manager.delivery(), LogDelivery::Sync);
+}
+
+#[test]
+fn LogCallbackManager___submit_async___delivers_one_batch_on_flush() {
+    let _guard = CALLBACK_TEST_LOCK.lock().unwrap();
+    BATCH_CALLS.store(0, Ordering::SeqCst);
+    BATCH_RECORDS.store(0, Ordering::SeqCst);
+    let manager = async_manager(16);
+    manager.set_batch_callback(Some(test_batch_callback));
+
+    for i in 0..5 {
+        manager.submit(LogLevel::Info, "test", format!("message {i}"));
+    }
+    assert_eq!(BATCH_RECORDS.load(Ordering::SeqCst), 0);
+
+    manager.flush();
+
+    assert_eq!(BATCH_CALLS.load(Ordering::SeqCst), 1);
+    assert_eq!(BATCH_RECORDS.load(Ordering::SeqCst), 5);
+}
+
+#[test]
+fn LogCallbackManager___submit_async___counts_events_dropped_when_full() {
+    let _guard = CALLBACK_TEST_LOCK.lock().unwrap();
+    BATCH_RECORDS.store(0, Ordering::SeqCst);
+    let manager = async_manager(2);
+    manager.set_batch_callback(Some(test_batch_callback));
+
+    for i in 0..5 {
+        manager.submit(LogLevel::Info, "test", format!("message {i}"));
+    }
+    manager.flush();
+
+    assert_eq!(manager.dropped_count(), 3);
+    assert_eq!(BATCH_RECORDS.load(Ordering::SeqCst), 2);
+}
+
+#[test]
+fn LogCallbackManager___submit_async___falls_back_to_per_event_callback() {
+    let _guard = CALLBACK_TEST_LOCK.lock().unwrap();
+    CALL_COUNT.store(0, Ordering::SeqCst);
+    let manager = async_manager(16);
+    manager.set_callback(Some(test_callback));
+
+    manager.submit(LogLevel::Warn, "test", "first".to_string());
+    manager.submit(LogLevel::Warn, "test", "second".to_string());
+    manager.flush();
+
+    assert_eq!(CALL_COUNT.load(Ordering::SeqCst), 2);
+}
+
+#[test]
+fn LogCallbackManager___close___flushes_queue_before_clearing() {
+    let _guard = CALLBACK_TEST_LOCK.lock().unwrap();
+    BATCH_RECORDS.store(0, Ordering::SeqCst);
+    let manager = async_manager(16);
+    manager.set_batch_callback(Some(test_batch_callback));
+    manager.submit(LogLevel::Info, "test", "last words".to_string());
+
+    manager.close();
+
+    assert_eq!(BATCH_RECORDS.load(Ordering::SeqCst), 1);
+    assert!(manager.get_batch_callback().is_none());
+}
+
+/// Manager closed from inside its own callback by [`closing_callback`]
+static CLOSING: OnceCell<Arc<LogCallbackManager>> = OnceCell::new();
+static CLOSING_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+extern "C" fn closing_callback(
+    _level: u8,
+    _target: *const std::ffi::c_char,
+    _message: *const u8,
+    _message_len: usize,
+) {
+    CLOSING_CALLS.fetch_add(1, Ordering::SeqCst);
+    if let Some(manager) = CLOSING.get() {
+        manager.close();
+    }
+}
+
+#[test]
+fn LogCallbackManager___close_from_callback___returns_and_stops_delivery() {
+    let manager = CLOSING.get_or_init(|| async_manager(16));
+    manager.set_callback(Some(closing_callback));
+    for i in 0..3 {
+        manager.submit(LogLevel::Info, "test", format!("message {i}"));
+    }
+
+    manager.flush();
+
+    assert_eq!(CLOSING_CALLS.load(Ordering::SeqCst), 1);
+    assert!(manager.get_callback().is_none());
+}
+
+static SLOW_ENTERED: AtomicBool = AtomicBool::new(false);
+static SLOW_FINISHED: AtomicBool = AtomicBool::new(false);
+
+extern "C" fn slow_batch_callback(_records: *const RbLogRecord, _count: usize) {
+    SLOW_ENTERED.store(true, Ordering::SeqCst);
+    std::thread::sleep(Duration::from_millis(50));
+    SLOW_FINISHED.store(true, Ordering::SeqCst);
+}
+
+#[test]
+fn LogCallbackManager___close___waits_for_delivery_on_another_thread() {
+    let manager = async_manager(16);
+    manager.set_batch_callback(Some(slow_batch_callback));
+    manager.submit(LogLevel::Info, "test", "slow".to_string());
+    let flusher = {
+        let manager = manager.clone();
+        std::thread::spawn(move || manager.flush())
+    };
+    while !SLOW_ENTERED.load(Ordering::SeqCst) {
+        std::thread::yield_now();
+    }
+
+    manager.close();
+
+    assert!(SLOW_FINISHED.load(Ordering::SeqCst));
+    flusher.join().unwrap();
+}
+
+#[test]
+fn LogCallbackManager___log_sync___uses_batch_callback_when_alone() {
+    let _guard = CALLBACK_TEST_LOCK.lock().unwrap();
+    BATCH_RECORDS.store(0, Ordering::SeqCst);
+    let manager = LogCallbackManager::new();
+    manager.set_batch_callback(Some(test_batch_callback));
+
+    manager.log(LogLevel::Info, "test", "message");
+
+    assert_eq!(BATCH_RECORDS.load(Ordering::SeqCst), 1);
+}
+
+#[test]
+fn LogCallbackManager___close___leaves_other_managers_untouched() {
+    let first = LogCallbackManager::new();
+    let second = LogCallbackManager::new();
+    first.set_callback(Some(test_callback));
+    second.set_callback(Some(test_callback));
+
+    first.close();
+
+    assert!(first.get_callback().is_none());
+    assert!(second.get_callback().is_some());
+}
+
+#[test]
+fn LogCallbackManager___from_config___applies_level_and_callback() {
+    let config = PluginConfig {
+        log_level: "Debug".to_string(),
+        ..Default::default()
+    };
+
+    let manager = LogCallbackManager::from_config(&config, Some(test_callback));
+
+    assert_eq!(manager.level(), LogLevel::Debug);
+    assert!(manager.get_callback().is_some());
+    assert_eq!(manager.delivery(), LogDelivery::Sync);
+}
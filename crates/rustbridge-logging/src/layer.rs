@@ -1,27 +1,35 @@
 //! Tracing layer that forwards to FFI callbacks
 
-use crate::callback::LogCallbackManager;
+use crate::callback::{self, LogCallbackManager};
+use crate::scope;
 use rustbridge_core::LogLevel;
 use tracing::field::{Field, Visit};
-use tracing::{Event, Level, Subscriber};
+use tracing::level_filters::LevelFilter;
+use tracing::subscriber::Interest;
+use tracing::{Event, Level, Metadata, Subscriber};
 use tracing_subscriber::Layer;
 use tracing_subscriber::layer::Context;
 use tracing_subscriber::registry::LookupSpan;
 
 /// Tracing layer that forwards log events to FFI callbacks
+///
+/// Events go to the manager entered on the emitting thread (see
+/// [`LogCallbackManager::enter`]), or to the layer's own manager outside any
+/// plugin's scope, and are filtered by that manager's level. Levels no live
+/// manager enables are rejected before an event is even built.
 pub struct FfiLoggingLayer {
     manager: &'static LogCallbackManager,
 }
 
 impl FfiLoggingLayer {
-    /// Create a new FFI logging layer using the global callback manager
+    /// Create a new FFI logging layer falling back to the global callback manager
     pub fn new() -> Self {
         Self {
             manager: LogCallbackManager::global(),
         }
     }
 
-    /// Create a layer with a specific callback manager
+    /// Create a layer falling back to a specific callback manager
     pub fn with_manager(manager: &'static LogCallbackManager) -> Self {
         Self { manager }
     }
@@ -36,6 +44,18 @@ impl FfiLoggingLayer {
             Level::ERROR => LogLevel::Error,
         }
     }
+
+    /// Convert our LogLevel to a tracing LevelFilter
+    fn convert_filter(level: LogLevel) -> LevelFilter {
+        match level {
+            LogLevel::Trace => LevelFilter::TRACE,
+            LogLevel::Debug => LevelFilter::DEBUG,
+            LogLevel::Info => LevelFilter::INFO,
+            LogLevel::Warn => LevelFilter::WARN,
+            LogLevel::Error => LevelFilter::ERROR,
+            LogLevel::Off => LevelFilter::OFF,
+        }
+    }
 }
 
 impl Default for FfiLoggingLayer {
@@ -52,25 +72,36 @@ where
         let metadata = event.metadata();
         let level = Self::convert_level(metadata.level());
 
-        // Check if this level is enabled before doing any work
-        if !self.manager.is_enabled(level) {
-            return;
-        }
+        scope::with_current(self.manager, |manager| {
+            // Check if this level is enabled before doing any work
+            if !manager.is_enabled(level) {
+                return;
+            }
 
-        // Extract the message and fields from the event
-        let mut visitor = MessageVisitor::default();
-        event.record(&mut visitor);
+            // Extract the message and fields from the event
+            let mut visitor = MessageVisitor::default();
+            event.record(&mut visitor);
 
-        let message = visitor.into_message();
-        let target = metadata.target();
+            let message = visitor.into_message();
+            let target = metadata.target();
 
-        // Forward to the callback
-        self.manager.log(level, target, &message);
+            // Forward to the callback, directly or through the queue
+            manager.submit(level, target, message);
+        });
     }
 
-    fn enabled(&self, metadata: &tracing::Metadata<'_>, _ctx: Context<'_, S>) -> bool {
+    fn enabled(&self, metadata: &Metadata<'_>, _ctx: Context<'_, S>) -> bool {
         let level = Self::convert_level(metadata.level());
-        self.manager.is_enabled(level)
+        scope::with_current(self.manager, |manager| manager.is_enabled(level))
+    }
+
+    fn register_callsite(&self, _metadata: &'static Metadata<'static>) -> Interest {
+        // Whether a callsite is enabled depends on the plugin emitting it
+        Interest::sometimes()
+    }
+
+    fn max_level_hint(&self) -> Option<LevelFilter> {
+        Some(Self::convert_filter(callback::max_level()))
     }
 }
 
@@ -151,36 +182,18 @@ impl MessageVisitor {
 /// This sets up tracing with the FFI logging layer. Call this once during
 /// plugin initialization. Subsequent calls after the first initialization
 /// are no-ops since the subscriber is global.
+///
+/// There is no process-wide level filter: each plugin's manager filters its
+/// own events, and the layer's max level hint follows the most verbose one.
 pub fn init_logging() {
     use once_cell::sync::OnceCell;
-    use tracing_subscriber::filter::LevelFilter;
     use tracing_subscriber::prelude::*;
-    use tracing_subscriber::reload;
 
     // Use OnceCell to ensure we only initialize once
     static INITIALIZED: OnceCell<()> = OnceCell::new();
 
     INITIALIZED.get_or_init(|| {
-        let layer = FfiLoggingLayer::new();
-
-        // Create a reloadable level filter
-        let initial_level = LogCallbackManager::global().level();
-        let initial_filter = match initial_level {
-            LogLevel::Trace => LevelFilter::TRACE,
-            LogLevel::Debug => LevelFilter::DEBUG,
-            LogLevel::Info => LevelFilter::INFO,
-            LogLevel::Warn => LevelFilter::WARN,
-            LogLevel::Error => LevelFilter::ERROR,
-            LogLevel::Off => LevelFilter::OFF,
-        };
-
-        let (filter, reload_handle) = reload::Layer::new(initial_filter);
-
-        // Store the reload handle for later use
-        crate::reload::ReloadHandle::global().set_handle(reload_handle);
-
-        // Create subscriber with reloadable filter first, then FFI layer
-        let subscriber = tracing_subscriber::registry().with(filter).with(layer);
+        let subscriber = tracing_subscriber::registry().with(FfiLoggingLayer::new());
 
         // Set as global default - ignore error if already set
         let _ = tracing::subscriber::set_global_default(subscriber);
@@ -3,16 +3,18 @@
 //! This crate provides:
 //! - [`FfiLoggingLayer`] tracing layer that forwards logs to FFI callbacks
 //! - [`LogCallback`] type for the FFI log callback function
-//! - Dynamic log level filtering
+//! - [`LogBatchCallback`] for batched delivery from a background thread
+//! - Per-plugin callbacks and log levels via [`LogCallbackManager::enter`] and [`scoped`]
 
 mod callback;
 mod layer;
-mod reload;
+mod queue;
+mod scope;
 
-pub use callback::{LogCallback, LogCallbackManager};
+pub use callback::{LogBatchCallback, LogCallback, LogCallbackManager, RbLogRecord};
 pub use layer::{FfiLoggingLayer, init_logging};
-pub use reload::ReloadHandle;
-pub use rustbridge_core::LogLevel;
+pub use rustbridge_core::{LogDelivery, LogLevel, LoggingConfig};
+pub use scope::{LogScope, Scoped, scoped};
 
 /// Prelude module for convenient imports
 pub mod prelude {
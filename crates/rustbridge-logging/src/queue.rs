@@ -0,0 +1,137 @@
+//! Bounded lock-free queue for asynchronous log delivery
+
+use rustbridge_core::LogLevel;
+use std::cell::UnsafeCell;
+use std::mem::MaybeUninit;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+/// A formatted log event waiting to be delivered
+pub(crate) struct QueuedLog {
+    pub(crate) level: LogLevel,
+    pub(crate) target: &'static str,
+    pub(crate) message: String,
+}
+
+/// One queue slot; `seq` says whether it is free for the producer at
+/// position `seq` or holds the value for the consumer at `seq - 1`
+struct Slot {
+    seq: AtomicUsize,
+    value: UnsafeCell<MaybeUninit<QueuedLog>>,
+}
+
+/// Keeps the producer and consumer cursors on separate cache lines
+#[repr(align(64))]
+struct Cursor(AtomicUsize);
+
+/// Bounded multi-producer multi-consumer queue of log events
+///
+/// Each slot carries a sequence number, so producers and consumers only
+/// contend on a compare-and-swap of their own cursor and never take a lock.
+/// A push onto a full queue fails immediately instead of waiting.
+pub(crate) struct LogQueue {
+    slots: Box<[Slot]>,
+    mask: usize,
+    tail: Cursor,
+    head: Cursor,
+}
+
+// SAFETY: a slot's value is only touched by the thread that won the cursor
+// CAS for it, and the Release/Acquire pair on `seq` publishes it.
+unsafe impl Send for LogQueue {}
+unsafe impl Sync for LogQueue {}
+
+impl LogQueue {
+    /// Create a queue holding at least `capacity` events (rounded up to a power of two)
+    pub(crate) fn new(capacity: usize) -> Self {
+        let capacity = capacity.max(2).next_power_of_two();
+        let slots = (0..capacity)
+            .map(|i| Slot {
+                seq: AtomicUsize::new(i),
+                value: UnsafeCell::new(MaybeUninit::uninit()),
+            })
+            .collect();
+        Self {
+            slots,
+            mask: capacity - 1,
+            tail: Cursor(AtomicUsize::new(0)),
+            head: Cursor(AtomicUsize::new(0)),
+        }
+    }
+
+    /// Approximate number of queued events
+    pub(crate) fn len(&self) -> usize {
+        let tail = self.tail.0.load(Ordering::Relaxed);
+        let head = self.head.0.load(Ordering::Relaxed);
+        tail.saturating_sub(head)
+    }
+
+    /// Append an event, or hand it back if the queue is full
+    pub(crate) fn push(&self, log: QueuedLog) -> Result<(), QueuedLog> {
+        let mut pos = self.tail.0.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let seq = slot.seq.load(Ordering::Acquire);
+            let diff = seq as isize - pos as isize;
+            if diff == 0 {
+                match self.tail.0.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        // SAFETY: winning the CAS gives this thread sole access to the slot
+                        unsafe { (*slot.value.get()).write(log) };
+                        slot.seq.store(pos + 1, Ordering::Release);
+                        return Ok(());
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if diff < 0 {
+                return Err(log);
+            } else {
+                pos = self.tail.0.load(Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// Remove the oldest event
+    pub(crate) fn pop(&self) -> Option<QueuedLog> {
+        let mut pos = self.head.0.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let seq = slot.seq.load(Ordering::Acquire);
+            let diff = seq as isize - (pos + 1) as isize;
+            if diff == 0 {
+                match self.head.0.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        // SAFETY: the producer published this slot before storing `pos + 1`
+                        let log = unsafe { (*slot.value.get()).assume_init_read() };
+                        slot.seq.store(pos + self.mask + 1, Ordering::Release);
+                        return Some(log);
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if diff < 0 {
+                return None;
+            } else {
+                pos = self.head.0.load(Ordering::Relaxed);
+            }
+        }
+    }
+}
+
+impl Drop for LogQueue {
+    fn drop(&mut self) {
+        while self.pop().is_some() {}
+    }
+}
+
+#[cfg(test)]
+#[path = "queue/queue_tests.rs"]
+mod queue_tests;
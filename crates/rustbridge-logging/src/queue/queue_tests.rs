@@ -0,0 +1,83 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::sync::Arc;
+
+fn log(message: &str) -> QueuedLog {
+    QueuedLog {
+        level: LogLevel::Info,
+        target: "test",
+        message: message.to_string(),
+    }
+}
+
+#[test]
+fn LogQueue___new___rounds_capacity_up_to_power_of_two() {
+    let queue = LogQueue::new(5);
+
+    for i in 0..8 {
+        queue.push(log(&i.to_string())).ok().unwrap();
+    }
+
+    assert!(queue.push(log("8")).is_err());
+}
+
+#[test]
+fn LogQueue___push_pop___preserves_order() {
+    let queue = LogQueue::new(4);
+
+    queue.push(log("a")).ok().unwrap();
+    queue.push(log("b")).ok().unwrap();
+
+    assert_eq!(queue.len(), 2);
+    assert_eq!(queue.pop().unwrap().message, "a");
+    assert_eq!(queue.pop().unwrap().message, "b");
+    assert!(queue.pop().is_none());
+}
+
+#[test]
+fn LogQueue___push___full_queue_returns_event() {
+    let queue = LogQueue::new(2);
+    queue.push(log("a")).ok().unwrap();
+    queue.push(log("b")).ok().unwrap();
+
+    let rejected = queue.push(log("c")).err().unwrap();
+
+    assert_eq!(rejected.message, "c");
+    assert_eq!(queue.len(), 2);
+}
+
+#[test]
+fn LogQueue___push___reuses_slots_after_pop() {
+    let queue = LogQueue::new(2);
+
+    for i in 0..10 {
+        queue.push(log(&i.to_string())).ok().unwrap();
+        assert_eq!(queue.pop().unwrap().message, i.to_string());
+    }
+}
+
+#[test]
+fn LogQueue___concurrent_producers___every_event_popped_once() {
+    let queue = Arc::new(LogQueue::new(4096));
+
+    let producers: Vec<_> = (0..4)
+        .map(|t| {
+            let queue = queue.clone();
+            std::thread::spawn(move || {
+                for i in 0..500 {
+                    queue.push(log(&format!("{t}-{i}"))).ok().unwrap();
+                }
+            })
+        })
+        .collect();
+    for producer in producers {
+        producer.join().unwrap();
+    }
+
+    let mut seen = std::collections::HashSet::new();
+    while let Some(event) = queue.pop() {
+        assert!(seen.insert(event.message));
+    }
+    assert_eq!(seen.len(), 2000);
+}
@@ -0,0 +1,100 @@
+//! Routing log events to the manager of the plugin that emitted them
+
+use crate::callback::LogCallbackManager;
+use std::cell::Cell;
+use std::future::Future;
+use std::marker::PhantomData;
+use std::ops::Deref;
+use std::pin::Pin;
+use std::ptr;
+use std::task::{Context, Poll};
+
+thread_local! {
+    /// Manager of the plugin whose code is running on this thread, or null
+    static CURRENT: Cell<*const LogCallbackManager> = const { Cell::new(ptr::null()) };
+}
+
+/// Guard returned by [`LogCallbackManager::enter`]
+///
+/// Restores the previously entered manager when dropped. It cannot be sent
+/// to another thread.
+#[must_use = "the scope ends when the guard is dropped"]
+pub struct LogScope<'a> {
+    previous: *const LogCallbackManager,
+    _manager: PhantomData<&'a LogCallbackManager>,
+}
+
+impl LogCallbackManager {
+    /// Route events logged on this thread to this manager until the guard drops
+    ///
+    /// Scopes nest; the innermost one wins.
+    pub fn enter(&self) -> LogScope<'_> {
+        let previous = CURRENT.with(|current| current.replace(self));
+        LogScope {
+            previous,
+            _manager: PhantomData,
+        }
+    }
+}
+
+impl Drop for LogScope<'_> {
+    fn drop(&mut self) {
+        CURRENT.with(|current| current.set(self.previous));
+    }
+}
+
+/// Run `f` with the manager entered on this thread, or `fallback` if none is
+pub(crate) fn with_current<R>(
+    fallback: &LogCallbackManager,
+    f: impl FnOnce(&LogCallbackManager) -> R,
+) -> R {
+    let current = CURRENT.with(Cell::get);
+    if current.is_null() {
+        f(fallback)
+    } else {
+        // SAFETY: the pointer was set by a live `LogScope`, which borrows the
+        // manager for as long as it stays entered on this thread
+        f(unsafe { &*current })
+    }
+}
+
+/// Future that enters a manager's scope each time it is polled
+///
+/// Created by [`scoped`].
+pub struct Scoped<S, F> {
+    manager: S,
+    future: F,
+}
+
+/// Wrap `future` so events it logs go to `manager`, on whichever thread polls it
+///
+/// Use an `Arc<LogCallbackManager>` for tasks that are spawned, and a
+/// reference for futures that are awaited or blocked on in place.
+pub fn scoped<S, F>(manager: S, future: F) -> Scoped<S, F>
+where
+    S: Deref<Target = LogCallbackManager>,
+    F: Future,
+{
+    Scoped { manager, future }
+}
+
+impl<S, F> Future for Scoped<S, F>
+where
+    S: Deref<Target = LogCallbackManager>,
+    F: Future,
+{
+    type Output = F::Output;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<F::Output> {
+        // SAFETY: `future` is structurally pinned and never moved out of
+        // `self`; `manager` is only borrowed
+        let this = unsafe { self.get_unchecked_mut() };
+        let _scope = this.manager.enter();
+        let future = unsafe { Pin::new_unchecked(&mut this.future) };
+        future.poll(cx)
+    }
+}
+
+#[cfg(test)]
+#[path = "scope/scope_tests.rs"]
+mod scope_tests;
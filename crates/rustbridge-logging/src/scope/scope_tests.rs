@@ -0,0 +1,75 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use rustbridge_core::LogLevel;
+use std::sync::Arc;
+
+fn current_level(fallback: &LogCallbackManager) -> LogLevel {
+    with_current(fallback, |manager| manager.level())
+}
+
+#[test]
+fn with_current___no_scope___uses_fallback() {
+    let fallback = LogCallbackManager::new();
+    fallback.set_level(LogLevel::Error);
+
+    assert_eq!(current_level(&fallback), LogLevel::Error);
+}
+
+#[test]
+fn LogCallbackManager___enter___routes_to_entered_manager_until_dropped() {
+    let fallback = LogCallbackManager::new();
+    let plugin = LogCallbackManager::new();
+    plugin.set_level(LogLevel::Trace);
+
+    {
+        let _scope = plugin.enter();
+        assert_eq!(current_level(&fallback), LogLevel::Trace);
+    }
+
+    assert_eq!(current_level(&fallback), LogLevel::Info);
+}
+
+#[test]
+fn LogCallbackManager___enter___nested_scopes_restore_outer() {
+    let fallback = LogCallbackManager::new();
+    let outer = LogCallbackManager::new();
+    outer.set_level(LogLevel::Warn);
+    let inner = LogCallbackManager::new();
+    inner.set_level(LogLevel::Debug);
+
+    let _outer = outer.enter();
+    {
+        let _inner = inner.enter();
+        assert_eq!(current_level(&fallback), LogLevel::Debug);
+    }
+
+    assert_eq!(current_level(&fallback), LogLevel::Warn);
+}
+
+#[tokio::test]
+async fn scoped___poll___enters_manager_on_polling_thread() {
+    let fallback = Arc::new(LogCallbackManager::new());
+    let plugin = Arc::new(LogCallbackManager::new());
+    plugin.set_level(LogLevel::Trace);
+
+    let probe = fallback.clone();
+    let level = tokio::spawn(scoped(plugin, async move {
+        tokio::task::yield_now().await;
+        current_level(&probe)
+    }))
+    .await
+    .unwrap();
+
+    assert_eq!(level, LogLevel::Trace);
+    assert_eq!(current_level(&fallback), LogLevel::Info);
+}
+
+#[test]
+fn LogCallbackManager___set_level___raises_process_max_level() {
+    let manager = LogCallbackManager::new();
+
+    manager.set_level(LogLevel::Trace);
+
+    assert_eq!(crate::callback::max_level(), LogLevel::Trace);
+}
@@ -0,0 +1,471 @@
+//! Handler dispatch generated by `#[rustbridge_plugin]` on a `Plugin` impl
+//!
+//! Methods marked `#[rustbridge_handler("tag")]` are moved into an inherent
+//! impl and the trait impl gets `handle_request`, `handle_request_sync`,
+//! `handle_request_as` and `supported_types` that route to them. Type tags
+//! are matched through a perfect hash built here at compile time, and
+//! payloads are decoded straight into each handler's argument type.
+//!
+//! Methods marked `#[rustbridge_handler(binary = N)]` are registered with
+//! `register_binary_handler` at the top of `on_start`.
+
+use proc_macro2::{Span, TokenStream};
+use quote::{format_ident, quote};
+use std::collections::HashSet;
+use syn::parse::{Parse, ParseStream};
+use syn::{
+    Attribute, FnArg, Ident, ImplItem, ImplItemFn, ItemImpl, LitInt, LitStr, ReturnType, Token,
+    Type, parse_quote,
+};
+
+/// Seeds tried per table size before the table is doubled
+const SEED_ATTEMPTS: u64 = 4096;
+
+/// Largest table searched for a collision-free seed
+const MAX_TABLE_SIZE: usize = 1 << 16;
+
+/// Trait methods generated here, which the impl must not define itself
+const GENERATED_METHODS: [&str; 2] = ["handle_request", "handle_request_sync"];
+
+/// Arguments of `#[rustbridge_handler(...)]`
+pub(crate) enum HandlerAttr {
+    /// `#[rustbridge_handler("type.tag")]`
+    Tag(LitStr),
+    /// `#[rustbridge_handler(binary = 1)]`
+    Binary(LitInt),
+}
+
+impl Parse for HandlerAttr {
+    fn parse(input: ParseStream) -> syn::Result<Self> {
+        if input.peek(LitStr) {
+            return Ok(Self::Tag(input.parse()?));
+        }
+        let key: Ident = input.parse()?;
+        if key != "binary" {
+            return Err(syn::Error::new(
+                key.span(),
+                "expected a type tag string or `binary = <message id>`",
+            ));
+        }
+        input.parse::<Token![=]>()?;
+        Ok(Self::Binary(input.parse()?))
+    }
+}
+
+/// A `#[rustbridge_handler("tag")]` method
+struct TagHandler {
+    tag: LitStr,
+    method: Ident,
+    is_async: bool,
+    takes_ctx: bool,
+    request: Option<Type>,
+}
+
+impl TagHandler {
+    fn from_fn(tag: LitStr, method: &ImplItemFn) -> syn::Result<Self> {
+        let sig = &method.sig;
+        let mut inputs = sig.inputs.iter();
+        match inputs.next() {
+            Some(FnArg::Receiver(receiver))
+                if receiver.reference.is_some() && receiver.mutability.is_none() => {}
+            _ => {
+                return Err(syn::Error::new_spanned(
+                    sig,
+                    "type tag handlers must take `&self`",
+                ));
+            }
+        }
+
+        let mut takes_ctx = false;
+        let mut request = None;
+        for input in inputs {
+            let FnArg::Typed(arg) = input else {
+                continue;
+            };
+            if !takes_ctx && request.is_none() && is_context(&arg.ty) {
+                takes_ctx = true;
+            } else if request.is_none() {
+                request = Some((*arg.ty).clone());
+            } else {
+                return Err(syn::Error::new_spanned(
+                    arg,
+                    "type tag handlers take at most `&PluginContext` and one request argument",
+                ));
+            }
+        }
+
+        if matches!(sig.output, ReturnType::Default) {
+            return Err(syn::Error::new_spanned(
+                sig,
+                "type tag handlers must return `PluginResult<T>`",
+            ));
+        }
+
+        Ok(Self {
+            tag,
+            method: sig.ident.clone(),
+            is_async: sig.asyncness.is_some(),
+            takes_ctx,
+            request,
+        })
+    }
+}
+
+/// Check whether `ty` is `&PluginContext`
+fn is_context(ty: &Type) -> bool {
+    let Type::Reference(reference) = ty else {
+        return false;
+    };
+    let Type::Path(path) = &*reference.elem else {
+        return false;
+    };
+    path.path
+        .segments
+        .last()
+        .is_some_and(|segment| segment.ident == "PluginContext")
+}
+
+/// Remove and parse the `#[rustbridge_handler]` attribute, if any
+fn take_handler_attr(attrs: &mut Vec<Attribute>) -> syn::Result<Option<HandlerAttr>> {
+    let Some(position) = attrs.iter().position(|attr| {
+        attr.path()
+            .segments
+            .last()
+            .is_some_and(|segment| segment.ident == "rustbridge_handler")
+    }) else {
+        return Ok(None);
+    };
+    attrs.remove(position).parse_args().map(Some)
+}
+
+/// Hash a type tag; must match `rustbridge_transport::tag_hash`
+pub(crate) fn tag_hash(seed: u64, tag: &[u8]) -> u64 {
+    let mut hash = 0xcbf2_9ce4_8422_2325 ^ seed;
+    for &byte in tag {
+        hash ^= byte as u64;
+        hash = hash.wrapping_mul(0x0000_0100_0000_01b3);
+    }
+    hash ^ (hash >> 32)
+}
+
+/// Find a seed under which every tag gets its own slot
+///
+/// Returns the seed and, per slot, the index of the tag stored there. The
+/// table starts at the next power of two above the tag count and doubles
+/// until a seed is found. Tags must be distinct.
+pub(crate) fn build_tag_table(tags: &[String]) -> Option<(u64, Vec<Option<usize>>)> {
+    let mut size = tags.len().next_power_of_two();
+    while size <= MAX_TABLE_SIZE {
+        let mask = size - 1;
+        for seed in 0..SEED_ATTEMPTS {
+            let mut slots = vec![None; size];
+            let collision_free = tags.iter().enumerate().all(|(index, tag)| {
+                let slot = &mut slots[tag_hash(seed, tag.as_bytes()) as usize & mask];
+                slot.replace(index).is_none()
+            });
+            if collision_free {
+                return Some((seed, slots));
+            }
+        }
+        size *= 2;
+    }
+    None
+}
+
+/// Expand `#[rustbridge_plugin]` on an `impl Plugin for ...` block
+pub(crate) fn expand_plugin_impl(mut item: ItemImpl) -> syn::Result<TokenStream> {
+    if item.trait_.is_none() {
+        return Err(syn::Error::new_spanned(
+            &item.self_ty,
+            "#[rustbridge_plugin] on an impl block requires `impl Plugin for ...`",
+        ));
+    }
+
+    let mut tag_handlers = Vec::new();
+    let mut registrations = Vec::new();
+    let mut handler_fns = Vec::new();
+    let mut items = Vec::new();
+    for impl_item in std::mem::take(&mut item.items) {
+        let ImplItem::Fn(mut method) = impl_item else {
+            items.push(impl_item);
+            continue;
+        };
+        match take_handler_attr(&mut method.attrs)? {
+            Some(HandlerAttr::Tag(tag)) => {
+                tag_handlers.push(TagHandler::from_fn(tag, &method)?);
+                handler_fns.push(method);
+            }
+            Some(HandlerAttr::Binary(message_id)) => {
+                if method.sig.receiver().is_some() {
+                    return Err(syn::Error::new_spanned(
+                        &method.sig,
+                        "binary handlers take `(&PluginHandle, &[u8])`, not `self`",
+                    ));
+                }
+                let method_name = &method.sig.ident;
+                registrations.push(quote! {
+                    ::rustbridge::register_binary_handler(#message_id, Self::#method_name);
+                });
+                handler_fns.push(method);
+            }
+            None => items.push(ImplItem::Fn(method)),
+        }
+    }
+
+    let mut seen = HashSet::new();
+    for handler in &tag_handlers {
+        if !seen.insert(handler.tag.value()) {
+            return Err(syn::Error::new_spanned(
+                &handler.tag,
+                "duplicate type tag handler",
+            ));
+        }
+    }
+    if tag_handlers.len() > u16::MAX as usize {
+        return Err(syn::Error::new(
+            Span::call_site(),
+            "too many type tag handlers",
+        ));
+    }
+
+    let defined: HashSet<String> = items
+        .iter()
+        .filter_map(|item| match item {
+            ImplItem::Fn(method) => Some(method.sig.ident.to_string()),
+            _ => None,
+        })
+        .collect();
+    for name in GENERATED_METHODS {
+        if defined.contains(name) {
+            return Err(syn::Error::new_spanned(
+                &item.self_ty,
+                format!("`{name}` is generated by #[rustbridge_plugin] and must not be defined"),
+            ));
+        }
+    }
+
+    // Binary handlers are registered before the plugin's own startup runs
+    let on_start = items.iter_mut().find_map(|item| match item {
+        ImplItem::Fn(method) if method.sig.ident == "on_start" => Some(method),
+        _ => None,
+    });
+    match on_start {
+        Some(method) => {
+            let block = &method.block;
+            method.block = parse_quote!({
+                #(#registrations)*
+                #block
+            });
+        }
+        None => items.push(parse_quote! {
+            async fn on_start(
+                &self,
+                _ctx: &::rustbridge::PluginContext,
+            ) -> ::rustbridge::PluginResult<()> {
+                #(#registrations)*
+                Ok(())
+            }
+        }),
+    }
+    if !defined.contains("on_stop") {
+        items.push(parse_quote! {
+            async fn on_stop(
+                &self,
+                _ctx: &::rustbridge::PluginContext,
+            ) -> ::rustbridge::PluginResult<()> {
+                Ok(())
+            }
+        });
+    }
+
+    let tags: Vec<String> = tag_handlers.iter().map(|h| h.tag.value()).collect();
+    let Some((seed, slots)) = build_tag_table(&tags) else {
+        return Err(syn::Error::new(
+            Span::call_site(),
+            "could not build a collision-free type tag table",
+        ));
+    };
+    let slots = slots.iter().map(|slot| match slot {
+        Some(index) => {
+            let tag = &tags[*index];
+            let index = *index as u16;
+            quote!(::std::option::Option::Some((#tag, #index)))
+        }
+        None => quote!(::std::option::Option::None),
+    });
+
+    let mut wrappers = Vec::new();
+    let mut async_arms = Vec::new();
+    let mut sync_arms = Vec::new();
+    for (index, handler) in tag_handlers.iter().enumerate() {
+        let index = index as u16;
+        let wrapper = format_ident!("__rustbridge_handle_{}", index);
+        let method = &handler.method;
+        let (decode, request_arg) = match &handler.request {
+            Some(ty) => (
+                quote! {
+                    let request = ::rustbridge::codec::decode_as::<#ty>(content_type, payload)?;
+                },
+                quote!(request),
+            ),
+            None => (quote!(), quote!()),
+        };
+        let ctx_arg = if handler.takes_ctx {
+            quote!(ctx,)
+        } else {
+            quote!()
+        };
+        let (asyncness, await_call) = if handler.is_async {
+            (quote!(async), quote!(.await))
+        } else {
+            (quote!(), quote!())
+        };
+
+        wrappers.push(quote! {
+            #[doc(hidden)]
+            #[allow(unused_variables)]
+            #asyncness fn #wrapper(
+                &self,
+                ctx: &::rustbridge::PluginContext,
+                content_type: ::rustbridge::ContentType,
+                payload: &[u8],
+            ) -> ::rustbridge::PluginResult<::std::vec::Vec<u8>> {
+                #decode
+                let response = self.#method(#ctx_arg #request_arg) #await_call?;
+                Ok(::rustbridge::codec::encode_as(content_type, &response)?)
+            }
+        });
+        async_arms.push(quote! {
+            ::std::option::Option::Some(#index) => {
+                self.#wrapper(ctx, content_type, payload) #await_call
+            }
+        });
+        if !handler.is_async {
+            sync_arms.push(quote! {
+                #index => ::std::option::Option::Some(self.#wrapper(ctx, content_type, payload)),
+            });
+        }
+    }
+
+    items.push(parse_quote! {
+        async fn handle_request(
+            &self,
+            ctx: &::rustbridge::PluginContext,
+            type_tag: &str,
+            payload: &[u8],
+        ) -> ::rustbridge::PluginResult<::std::vec::Vec<u8>> {
+            self.__rustbridge_dispatch(ctx, type_tag, ::rustbridge::ContentType::Json, payload)
+                .await
+        }
+    });
+    if !defined.contains("handle_request_as") {
+        items.push(parse_quote! {
+            async fn handle_request_as(
+                &self,
+                ctx: &::rustbridge::PluginContext,
+                type_tag: &str,
+                content_type: ::rustbridge::ContentType,
+                payload: &[u8],
+            ) -> ::rustbridge::PluginResult<::std::vec::Vec<u8>> {
+                self.__rustbridge_dispatch(ctx, type_tag, content_type, payload)
+                    .await
+            }
+        });
+    }
+    if !defined.contains("supported_types") {
+        items.push(parse_quote! {
+            fn supported_types(&self) -> ::std::vec::Vec<&'static str> {
+                ::std::vec![#(#tags),*]
+            }
+        });
+    }
+
+    let sync_dispatch = if sync_arms.is_empty() {
+        quote!()
+    } else {
+        items.push(parse_quote! {
+            fn handle_request_sync(
+                &self,
+                ctx: &::rustbridge::PluginContext,
+                type_tag: &str,
+                payload: &[u8],
+            ) -> ::std::option::Option<::rustbridge::PluginResult<::std::vec::Vec<u8>>> {
+                self.__rustbridge_dispatch_sync(
+                    ctx,
+                    type_tag,
+                    ::rustbridge::ContentType::Json,
+                    payload,
+                )
+            }
+        });
+        quote! {
+            /// Route a request to a handler that never awaits, if it has one
+            #[doc(hidden)]
+            fn __rustbridge_dispatch_sync(
+                &self,
+                ctx: &::rustbridge::PluginContext,
+                type_tag: &str,
+                content_type: ::rustbridge::ContentType,
+                payload: &[u8],
+            ) -> ::std::option::Option<::rustbridge::PluginResult<::std::vec::Vec<u8>>> {
+                match Self::__RUSTBRIDGE_TAGS.get(type_tag)? {
+                    #(#sync_arms)*
+                    _ => ::std::option::Option::None,
+                }
+            }
+        }
+    };
+
+    let has_async_trait = item.attrs.iter().any(|attr| {
+        attr.path()
+            .segments
+            .last()
+            .is_some_and(|segment| segment.ident == "async_trait")
+    });
+    if !has_async_trait {
+        item.attrs.push(parse_quote!(#[::rustbridge::async_trait]));
+    }
+    item.items = items;
+
+    let (impl_generics, _, where_clause) = item.generics.split_for_impl();
+    let self_ty = &item.self_ty;
+
+    Ok(quote! {
+        impl #impl_generics #self_ty #where_clause {
+            #(#handler_fns)*
+
+            /// Perfect hash table from type tag to handler index
+            #[doc(hidden)]
+            const __RUSTBRIDGE_TAGS: ::rustbridge::TagTable =
+                ::rustbridge::TagTable::new(#seed, &[#(#slots),*]);
+
+            /// Route a request to its handler
+            #[doc(hidden)]
+            #[allow(unused_variables)]
+            async fn __rustbridge_dispatch(
+                &self,
+                ctx: &::rustbridge::PluginContext,
+                type_tag: &str,
+                content_type: ::rustbridge::ContentType,
+                payload: &[u8],
+            ) -> ::rustbridge::PluginResult<::std::vec::Vec<u8>> {
+                match Self::__RUSTBRIDGE_TAGS.get(type_tag) {
+                    #(#async_arms)*
+                    _ => Err(::rustbridge::PluginError::UnknownMessageType(
+                        type_tag.to_string(),
+                    )),
+                }
+            }
+
+            #sync_dispatch
+
+            #(#wrappers)*
+        }
+
+        #item
+    })
+}
+
+#[cfg(test)]
+#[path = "dispatch/dispatch_tests.rs"]
+mod dispatch_tests;
@@ -0,0 +1,201 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+fn expand(item: ItemImpl) -> String {
+    expand_plugin_impl(item).unwrap().to_string()
+}
+
+fn expand_error(item: ItemImpl) -> String {
+    expand_plugin_impl(item).unwrap_err().to_string()
+}
+
+// tag_hash tests
+
+#[test]
+fn tag_hash___matches_transport_tag_hash() {
+    for tag in ["", "echo", "user.create", "bench.large"] {
+        for seed in [0, 1, 4095, u64::MAX] {
+            assert_eq!(
+                tag_hash(seed, tag.as_bytes()),
+                rustbridge_transport::tag_hash(seed, tag.as_bytes())
+            );
+        }
+    }
+}
+
+// build_tag_table tests
+
+#[test]
+fn build_tag_table___tags___each_get_own_slot() {
+    let tags: Vec<String> = (0..40).map(|i| format!("tag.{i}")).collect();
+
+    let (seed, slots) = build_tag_table(&tags).unwrap();
+
+    assert!(slots.len().is_power_of_two());
+    for (index, tag) in tags.iter().enumerate() {
+        let slot = tag_hash(seed, tag.as_bytes()) as usize & (slots.len() - 1);
+        assert_eq!(slots[slot], Some(index));
+    }
+}
+
+#[test]
+fn build_tag_table___no_tags___single_empty_slot() {
+    let (_, slots) = build_tag_table(&[]).unwrap();
+
+    assert_eq!(slots, [None]);
+}
+
+// HandlerAttr tests
+
+#[test]
+fn HandlerAttr___string___parses_tag() {
+    let attr: HandlerAttr = syn::parse_quote!("user.create");
+
+    assert!(matches!(attr, HandlerAttr::Tag(tag) if tag.value() == "user.create"));
+}
+
+#[test]
+fn HandlerAttr___binary___parses_message_id() {
+    let attr: HandlerAttr = syn::parse_quote!(binary = 7);
+
+    assert!(matches!(attr, HandlerAttr::Binary(id) if id.base10_digits() == "7"));
+}
+
+#[test]
+fn HandlerAttr___unknown_key___fails() {
+    let result = syn::parse_str::<HandlerAttr>("message = 7");
+
+    assert!(result.is_err());
+}
+
+// expand_plugin_impl tests
+
+#[test]
+fn expand_plugin_impl___handlers___generates_dispatch() {
+    let output = expand(parse_quote! {
+        impl Plugin for MyPlugin {
+            #[rustbridge_handler("echo")]
+            fn echo(&self, req: EchoRequest) -> PluginResult<EchoResponse> {
+                Ok(req.into())
+            }
+        }
+    });
+
+    assert!(output.contains("fn handle_request"));
+    assert!(output.contains("fn handle_request_sync"));
+    assert!(output.contains("fn handle_request_as"));
+    assert!(output.contains("fn supported_types"));
+    assert!(output.contains("__RUSTBRIDGE_TAGS"));
+    assert!(output.contains("decode_as :: < EchoRequest >"));
+    assert!(!output.contains("rustbridge_handler"));
+}
+
+#[test]
+fn expand_plugin_impl___only_async_handlers___no_sync_dispatch() {
+    let output = expand(parse_quote! {
+        impl Plugin for MyPlugin {
+            #[rustbridge_handler("sleep")]
+            async fn sleep(&self, ctx: &PluginContext, req: SleepRequest) -> PluginResult<()> {
+                Ok(())
+            }
+        }
+    });
+
+    assert!(!output.contains("handle_request_sync"));
+    assert!(output.contains("self . sleep (ctx , request) . await"));
+}
+
+#[test]
+fn expand_plugin_impl___binary_handler___registered_in_on_start() {
+    let output = expand(parse_quote! {
+        impl Plugin for MyPlugin {
+            async fn on_start(&self, _ctx: &PluginContext) -> PluginResult<()> {
+                Ok(())
+            }
+
+            #[rustbridge_handler(binary = 3)]
+            fn lookup(_handle: &PluginHandle, request: &[u8]) -> PluginResult<Vec<u8>> {
+                Ok(request.to_vec())
+            }
+        }
+    });
+
+    assert!(output.contains("register_binary_handler (3 , Self :: lookup)"));
+    assert_eq!(output.matches("fn on_start").count(), 1);
+}
+
+#[test]
+fn expand_plugin_impl___missing_async_trait___adds_it() {
+    let output = expand(parse_quote! {
+        impl Plugin for MyPlugin {}
+    });
+
+    assert!(output.contains(":: rustbridge :: async_trait"));
+    assert!(output.contains("fn on_start"));
+    assert!(output.contains("fn on_stop"));
+}
+
+#[test]
+fn expand_plugin_impl___hand_written_supported_types___kept() {
+    let output = expand(parse_quote! {
+        impl Plugin for MyPlugin {
+            fn supported_types(&self) -> Vec<&'static str> {
+                vec!["custom"]
+            }
+        }
+    });
+
+    assert_eq!(output.matches("fn supported_types").count(), 1);
+    assert!(output.contains("\"custom\""));
+}
+
+#[test]
+fn expand_plugin_impl___duplicate_tag___fails() {
+    let error = expand_error(parse_quote! {
+        impl Plugin for MyPlugin {
+            #[rustbridge_handler("echo")]
+            fn a(&self) -> PluginResult<()> { Ok(()) }
+            #[rustbridge_handler("echo")]
+            fn b(&self) -> PluginResult<()> { Ok(()) }
+        }
+    });
+
+    assert!(error.contains("duplicate"));
+}
+
+#[test]
+fn expand_plugin_impl___hand_written_handle_request___fails() {
+    let error = expand_error(parse_quote! {
+        impl Plugin for MyPlugin {
+            async fn handle_request(&self, ctx: &PluginContext, t: &str, p: &[u8]) -> PluginResult<Vec<u8>> {
+                todo!()
+            }
+        }
+    });
+
+    assert!(error.contains("handle_request"));
+}
+
+#[test]
+fn expand_plugin_impl___inherent_impl___fails() {
+    let error = expand_error(parse_quote! {
+        impl MyPlugin {}
+    });
+
+    assert!(error.contains("impl Plugin for"));
+}
+
+#[test]
+fn expand_plugin_impl___handler_without_self___fails() {
+    let error = expand_error(parse_quote! {
+        impl Plugin for MyPlugin {
+            #[rustbridge_handler("echo")]
+            fn echo(req: EchoRequest) -> PluginResult<EchoResponse> {
+                todo!()
+            }
+        }
+    });
+
+    assert!(error.contains("&self"));
+}
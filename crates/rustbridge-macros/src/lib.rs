@@ -1,7 +1,7 @@
 //! rustbridge-macros - Procedural macros for rustbridge plugins
 //!
 //! This crate provides:
-//! - `#[rustbridge_plugin]` - Mark a struct as a plugin implementation
+//! - `#[rustbridge_plugin]` - Mark a plugin struct, or generate dispatch for its `Plugin` impl
 //! - `#[rustbridge_handler]` - Mark a method as a message handler
 //! - `#[derive(Message)]` - Derive message traits for request/response types
 //! - `rustbridge_entry!` - Generate the FFI entry point
@@ -11,30 +11,77 @@ use proc_macro::TokenStream;
 use quote::quote;
 use syn::{DeriveInput, ItemFn, parse_macro_input};
 
-/// Attribute for marking a struct as a rustbridge plugin
+mod dispatch;
+
+/// Attribute for marking a rustbridge plugin
+///
+/// On the plugin struct, this generates a `new()` constructor that calls
+/// `Default::default()`.
+///
+/// On the plugin's `impl Plugin for ...` block, this generates the request
+/// dispatcher. Methods marked `#[rustbridge_handler("tag")]` are moved into
+/// an inherent impl, and `handle_request`, `handle_request_sync`,
+/// `handle_request_as` and `supported_types` are generated to route to them:
+///
+/// - Type tags are matched through a perfect hash computed at compile time,
+///   so a lookup hashes the tag once and compares one candidate.
+/// - Payloads are decoded directly into the handler's argument type, in
+///   whichever content type the host negotiated, and the handler's response
+///   is encoded the same way.
+/// - Handlers that are not `async` also answer synchronous calls inline.
+///
+/// Handlers take `&self`, an optional `&PluginContext`, and at most one
+/// request argument, and return `PluginResult<T>`.
 ///
-/// This generates the necessary boilerplate for implementing the Plugin trait
-/// and dispatching messages to handler methods.
+/// Methods marked `#[rustbridge_handler(binary = ID)]` must have the
+/// `BinaryMessageHandler` signature and are registered with
+/// `register_binary_handler` at the start of `on_start`. `on_start` and
+/// `on_stop` may be omitted and then do nothing else. `handle_request_as`
+/// and `supported_types` may still be written by hand to replace the
+/// generated ones.
+///
+/// Place this attribute above `#[async_trait]`; it is added if missing.
 ///
 /// # Example
 ///
 /// ```ignore
-/// use rustbridge_macros::rustbridge_plugin;
+/// use rustbridge::prelude::*;
+///
+/// #[derive(Default)]
+/// struct MyPlugin;
 ///
 /// #[rustbridge_plugin]
-/// struct MyPlugin {
-///     // plugin state
-/// }
+/// #[async_trait]
+/// impl Plugin for MyPlugin {
+///     async fn on_start(&self, _ctx: &PluginContext) -> PluginResult<()> {
+///         Ok(())
+///     }
 ///
-/// impl MyPlugin {
 ///     #[rustbridge_handler("user.create")]
-///     fn create_user(&self, req: CreateUserRequest) -> Result<CreateUserResponse, PluginError> {
+///     fn create_user(&self, req: CreateUserRequest) -> PluginResult<CreateUserResponse> {
+///         // handler implementation
+///     }
+///
+///     #[rustbridge_handler("user.sync")]
+///     async fn sync_user(&self, ctx: &PluginContext, req: SyncRequest) -> PluginResult<SyncResponse> {
+///         // handler implementation
+///     }
+///
+///     #[rustbridge_handler(binary = 1)]
+///     fn lookup(_handle: &PluginHandle, request: &[u8]) -> PluginResult<Vec<u8>> {
 ///         // handler implementation
 ///     }
 /// }
 /// ```
 #[proc_macro_attribute]
 pub fn rustbridge_plugin(_attr: TokenStream, item: TokenStream) -> TokenStream {
+    if let Ok(item_impl) = syn::parse::<syn::ItemImpl>(item.clone()) {
+        return match dispatch::expand_plugin_impl(item_impl) {
+            Ok(expanded) => TokenStream::from(expanded),
+            Err(e) => TokenStream::from(e.to_compile_error()),
+        };
+    }
+
     let input = parse_macro_input!(item as DeriveInput);
     let name = &input.ident;
 
@@ -54,7 +101,10 @@ pub fn rustbridge_plugin(_attr: TokenStream, item: TokenStream) -> TokenStream {
 
 /// Attribute for marking a method as a message handler
 ///
-/// The handler will be invoked when a message with the matching type tag is received.
+/// Inside an `impl Plugin` block marked `#[rustbridge_plugin]`, the handler
+/// is invoked when a message with the matching type tag is received, or
+/// registered for a binary message ID with `binary = ID`. See
+/// [`macro@rustbridge_plugin`].
 ///
 /// # Example
 ///
@@ -66,19 +116,23 @@ pub fn rustbridge_plugin(_attr: TokenStream, item: TokenStream) -> TokenStream {
 /// ```
 #[proc_macro_attribute]
 pub fn rustbridge_handler(attr: TokenStream, item: TokenStream) -> TokenStream {
-    let type_tag = parse_macro_input!(attr as syn::LitStr);
+    let handler = parse_macro_input!(attr as dispatch::HandlerAttr);
     let input = parse_macro_input!(item as ItemFn);
 
-    let fn_name = &input.sig.ident;
+    let fn_attrs = &input.attrs;
     let fn_vis = &input.vis;
+    let fn_sig = &input.sig;
     let fn_block = &input.block;
-    let fn_inputs = &input.sig.inputs;
-    let fn_output = &input.sig.output;
 
     // Generate the handler with metadata
+    let metadata = match handler {
+        dispatch::HandlerAttr::Tag(type_tag) => quote!(const _TYPE_TAG: &str = #type_tag;),
+        dispatch::HandlerAttr::Binary(message_id) => quote!(const _MESSAGE_ID: u32 = #message_id;),
+    };
     let expanded = quote! {
-        #fn_vis fn #fn_name(#fn_inputs) #fn_output {
-            const _TYPE_TAG: &str = #type_tag;
+        #(#fn_attrs)*
+        #fn_vis #fn_sig {
+            #metadata
             #fn_block
         }
     };
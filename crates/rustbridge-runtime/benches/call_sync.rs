@@ -0,0 +1,52 @@
+//! Sync Call Dispatch Benchmarks
+//!
+//! Measures the overhead `AsyncBridge::call_sync` adds around a handler:
+//!
+//! 1. **block_on**: the previous behaviour, entering the Tokio scheduler for
+//!    every call
+//! 2. **call_sync (ready)**: a handler future that never awaits, completed by
+//!    the inline first poll
+//! 3. **call_sync (pending)**: a handler that yields once, so it still falls
+//!    through to `block_on`
+//!
+//! The handler body is trivial so the numbers isolate the bridge cost.
+
+use criterion::{Criterion, black_box, criterion_group, criterion_main};
+use rustbridge_core::PluginResult;
+use rustbridge_runtime::{AsyncBridge, AsyncRuntime, RuntimeConfig};
+use std::sync::Arc;
+
+async fn ready_handler(payload: &[u8]) -> PluginResult<usize> {
+    Ok(payload.len())
+}
+
+async fn yielding_handler(payload: &[u8]) -> PluginResult<usize> {
+    tokio::task::yield_now().await;
+    Ok(payload.len())
+}
+
+fn bench_call_sync(c: &mut Criterion) {
+    let runtime = Arc::new(AsyncRuntime::new(RuntimeConfig::default()).unwrap());
+    let bridge = AsyncBridge::new(Arc::clone(&runtime));
+    let payload = [0u8; 64];
+
+    let mut group = c.benchmark_group("call_sync");
+
+    group.bench_function("block_on", |b| {
+        b.iter(|| runtime.block_on(ready_handler(black_box(&payload))))
+    });
+
+    group.bench_function("ready", |b| {
+        b.iter(|| bridge.call_sync(ready_handler(black_box(&payload))))
+    });
+
+    group.bench_function("pending", |b| {
+        b.iter(|| bridge.call_sync(yielding_handler(black_box(&payload))))
+    });
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_call_sync);
+
+criterion_main!(benches);
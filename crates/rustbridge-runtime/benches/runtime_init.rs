@@ -0,0 +1,101 @@
+//! Runtime Construction and Scheduling Benchmarks
+//!
+//! Measures what each `RuntimeConfig` option costs a plugin:
+//!
+//! 1. **Init**: building a dedicated multi-thread runtime, a current-thread
+//!    runtime, or attaching to the shared process-wide runtime, which is what
+//!    `plugin_init` pays per plugin
+//! 2. **Spawn round trip**: `block_on(spawn(..))` from a host thread, the
+//!    path taken by every async handler
+//!
+//! Before the timed runs, the spawn round trip is repeated on each flavor and
+//! the voluntary/involuntary context switches per call are printed (Linux
+//! only, via `getrusage`).
+
+use criterion::{Criterion, black_box, criterion_group, criterion_main};
+use rustbridge_runtime::{AsyncRuntime, RuntimeConfig, RuntimeFlavor};
+
+const SWITCH_SAMPLE_CALLS: u64 = 10_000;
+
+fn configs() -> [(&'static str, RuntimeConfig); 3] {
+    [
+        ("dedicated_multi_thread", RuntimeConfig::default()),
+        (
+            "dedicated_current_thread",
+            RuntimeConfig::new().with_flavor(RuntimeFlavor::CurrentThread),
+        ),
+        (
+            "shared_multi_thread",
+            RuntimeConfig::new().with_shared(true),
+        ),
+    ]
+}
+
+/// Process-wide (voluntary, involuntary) context switch counts
+#[cfg(target_os = "linux")]
+fn context_switches() -> (i64, i64) {
+    // SAFETY: rusage is plain data and getrusage only writes into it
+    let usage = unsafe {
+        let mut usage: libc::rusage = std::mem::zeroed();
+        libc::getrusage(libc::RUSAGE_SELF, &mut usage);
+        usage
+    };
+    (usage.ru_nvcsw, usage.ru_nivcsw)
+}
+
+#[cfg(target_os = "linux")]
+fn report_context_switches() {
+    for (name, config) in configs() {
+        let runtime = AsyncRuntime::new(config).unwrap();
+        let (voluntary, involuntary) = context_switches();
+        for i in 0..SWITCH_SAMPLE_CALLS {
+            runtime.block_on(runtime.spawn(async move { i })).unwrap();
+        }
+        let (voluntary_after, involuntary_after) = context_switches();
+        println!(
+            "context_switches/{name}: {:.3} voluntary, {:.3} involuntary per call",
+            (voluntary_after - voluntary) as f64 / SWITCH_SAMPLE_CALLS as f64,
+            (involuntary_after - involuntary) as f64 / SWITCH_SAMPLE_CALLS as f64,
+        );
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn report_context_switches() {}
+
+fn bench_init(c: &mut Criterion) {
+    let mut group = c.benchmark_group("runtime_init");
+
+    for (name, config) in configs() {
+        // Build the shared runtime up front so only attaching is measured
+        let _warm = AsyncRuntime::new(config.clone()).unwrap();
+        group.bench_function(name, |b| {
+            b.iter(|| AsyncRuntime::new(black_box(config.clone())).unwrap())
+        });
+    }
+
+    group.finish();
+}
+
+fn bench_spawn_round_trip(c: &mut Criterion) {
+    report_context_switches();
+
+    let mut group = c.benchmark_group("spawn_round_trip");
+
+    for (name, config) in configs() {
+        let runtime = AsyncRuntime::new(config).unwrap();
+        group.bench_function(name, |b| {
+            b.iter(|| {
+                runtime
+                    .block_on(runtime.spawn(async { black_box(1u64) }))
+                    .unwrap()
+            })
+        });
+    }
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_init, bench_spawn_round_trip);
+
+criterion_main!(benches);
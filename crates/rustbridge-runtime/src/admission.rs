@@ -0,0 +1,455 @@
+//! Admission control for concurrent requests
+//!
+//! [`AdmissionController`] caps the number of requests in flight. A request
+//! that arrives at the cap is rejected or queued according to its
+//! [`AdmissionMode`]. A queued request waits up to a deadline and is handed
+//! the slot of a finishing request directly, so it cannot be overtaken by a
+//! new arrival.
+//!
+//! The uncontended path is a single compare-and-swap; the queue lock and
+//! clock are only touched once the limit is reached.
+
+use parking_lot::Mutex;
+use rustbridge_core::{AdmissionConfig, AdmissionMode, PluginError, PluginResult};
+use std::collections::VecDeque;
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::task::{Context, Poll, Waker};
+use std::thread::Thread;
+use std::time::{Duration, Instant};
+
+/// Number of buckets in the queue wait-time histogram
+///
+/// Bucket 0 counts waits under 1 µs and bucket `i` counts waits in
+/// `[2^(i-1), 2^i)` µs. The last bucket also counts every longer wait.
+pub const WAIT_HISTOGRAM_BUCKETS: usize = 24;
+
+/// Point-in-time admission counters
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct AdmissionStats {
+    /// Maximum number of requests in flight
+    pub limit: usize,
+    /// Requests currently holding a slot
+    pub in_flight: usize,
+    /// Requests currently queued for a slot
+    pub queue_depth: usize,
+    /// Requests admitted, directly or after queueing
+    pub admitted: u64,
+    /// Requests that had to queue
+    pub queued: u64,
+    /// Requests rejected with `TooManyRequests`, including timeouts
+    pub rejected: u64,
+    /// Queued requests rejected because their deadline passed
+    pub timed_out: u64,
+    /// Queue wait times of admitted requests, in log2 microsecond buckets
+    pub wait_histogram_us: [u64; WAIT_HISTOGRAM_BUCKETS],
+}
+
+/// Limits concurrent requests and queues the overflow
+pub struct AdmissionController {
+    limit: usize,
+    config: AdmissionConfig,
+    in_flight: AtomicUsize,
+    /// Queued requests, readable without the queue lock
+    waiting: AtomicUsize,
+    queue: Mutex<WaitQueue>,
+    admitted: AtomicU64,
+    queued: AtomicU64,
+    rejected: AtomicU64,
+    timed_out: AtomicU64,
+    wait_histogram: [AtomicU64; WAIT_HISTOGRAM_BUCKETS],
+}
+
+struct WaitQueue {
+    waiters: VecDeque<Arc<Waiter>>,
+    /// Last time the queue was seen empty, for overload detection
+    last_empty: Instant,
+}
+
+impl WaitQueue {
+    /// The queue has not drained for longer than `interval`
+    fn overloaded(&self, now: Instant, interval: Duration) -> bool {
+        !self.waiters.is_empty() && now.saturating_duration_since(self.last_empty) > interval
+    }
+
+    fn remove(&mut self, waiter: &Arc<Waiter>) {
+        if let Some(pos) = self.waiters.iter().position(|w| Arc::ptr_eq(w, waiter)) {
+            self.waiters.remove(pos);
+        }
+    }
+}
+
+/// A queued request, granted a slot by whichever request releases one
+struct Waiter {
+    granted: AtomicBool,
+    wake: WakeTarget,
+}
+
+enum WakeTarget {
+    /// A host thread parked in `admit`
+    Thread(Thread),
+    /// A task awaiting `admit_owned`
+    Task(Mutex<Option<Waker>>),
+}
+
+impl Waiter {
+    fn new(wake: WakeTarget) -> Self {
+        Self {
+            granted: AtomicBool::new(false),
+            wake,
+        }
+    }
+
+    fn is_granted(&self) -> bool {
+        self.granted.load(Ordering::Acquire)
+    }
+
+    /// Hand the waiter a slot and wake it (called with the queue lock held)
+    fn grant(&self) {
+        self.granted.store(true, Ordering::Release);
+        match &self.wake {
+            WakeTarget::Thread(thread) => thread.unpark(),
+            WakeTarget::Task(waker) => {
+                if let Some(waker) = waker.lock().take() {
+                    waker.wake();
+                }
+            }
+        }
+    }
+}
+
+impl AdmissionController {
+    /// Create a controller admitting at most `limit` concurrent requests
+    pub fn new(limit: usize, config: AdmissionConfig) -> Self {
+        Self {
+            limit,
+            config,
+            in_flight: AtomicUsize::new(0),
+            waiting: AtomicUsize::new(0),
+            queue: Mutex::new(WaitQueue {
+                waiters: VecDeque::new(),
+                last_empty: Instant::now(),
+            }),
+            admitted: AtomicU64::new(0),
+            queued: AtomicU64::new(0),
+            rejected: AtomicU64::new(0),
+            timed_out: AtomicU64::new(0),
+            wait_histogram: std::array::from_fn(|_| AtomicU64::new(0)),
+        }
+    }
+
+    /// Get the concurrency limit
+    pub fn limit(&self) -> usize {
+        self.limit
+    }
+
+    /// Get the admission configuration
+    pub fn config(&self) -> &AdmissionConfig {
+        &self.config
+    }
+
+    /// Admit a request, parking the calling thread while it is queued
+    ///
+    /// Returns `TooManyRequests` if the request is rejected or its queue
+    /// deadline passes.
+    pub fn admit(&self) -> PluginResult<AdmissionPermit<'_>> {
+        if !self.try_admit_fast()
+            && let Some(queued) = self.enqueue(WakeTarget::Thread(std::thread::current()))?
+        {
+            loop {
+                if queued.waiter.is_granted() {
+                    break;
+                }
+                let now = Instant::now();
+                if now >= queued.deadline {
+                    break;
+                }
+                std::thread::park_timeout(queued.deadline - now);
+            }
+            queued.settle()?;
+        }
+        Ok(AdmissionPermit { controller: self })
+    }
+
+    /// Admit a request without blocking
+    ///
+    /// Returns `Ok(None)` if the limit is reached and the mode queues, in
+    /// which case the caller should wait in [`admit_owned`](Self::admit_owned).
+    pub fn try_admit_owned(self: &Arc<Self>) -> PluginResult<Option<OwnedAdmissionPermit>> {
+        if self.try_admit_fast() {
+            return Ok(Some(OwnedAdmissionPermit {
+                controller: Arc::clone(self),
+            }));
+        }
+        if self.config.mode == AdmissionMode::Reject {
+            return Err(self.reject());
+        }
+        Ok(None)
+    }
+
+    /// Admit a request, waiting asynchronously while it is queued
+    ///
+    /// Dropping the future gives up the request's place in the queue.
+    pub async fn admit_owned(self: Arc<Self>) -> PluginResult<OwnedAdmissionPermit> {
+        if !self.try_admit_fast()
+            && let Some(queued) = self.enqueue(WakeTarget::Task(Mutex::new(None)))?
+        {
+            let deadline = tokio::time::Instant::from_std(queued.deadline);
+            // A timeout is resolved by settle, which may still find the slot granted
+            let _ = tokio::time::timeout_at(
+                deadline,
+                Granted {
+                    waiter: &queued.waiter,
+                },
+            )
+            .await;
+            queued.settle()?;
+        }
+        Ok(OwnedAdmissionPermit { controller: self })
+    }
+
+    /// Take a snapshot of the admission counters
+    pub fn stats(&self) -> AdmissionStats {
+        AdmissionStats {
+            limit: self.limit,
+            in_flight: self.in_flight.load(Ordering::Relaxed),
+            queue_depth: self.waiting.load(Ordering::Relaxed),
+            admitted: self.admitted.load(Ordering::Relaxed),
+            queued: self.queued.load(Ordering::Relaxed),
+            rejected: self.rejected.load(Ordering::Relaxed),
+            timed_out: self.timed_out.load(Ordering::Relaxed),
+            wait_histogram_us: std::array::from_fn(|i| {
+                self.wait_histogram[i].load(Ordering::Relaxed)
+            }),
+        }
+    }
+
+    /// Get the number of rejected requests
+    pub fn rejected_count(&self) -> u64 {
+        self.rejected.load(Ordering::Relaxed)
+    }
+
+    /// Take a free slot, unless requests are already queued for one
+    fn try_admit_fast(&self) -> bool {
+        if self.waiting.load(Ordering::SeqCst) == 0 && self.try_acquire_slot() {
+            self.admitted.fetch_add(1, Ordering::Relaxed);
+            return true;
+        }
+        false
+    }
+
+    fn try_acquire_slot(&self) -> bool {
+        let mut current = self.in_flight.load(Ordering::SeqCst);
+        while current < self.limit {
+            match self.in_flight.compare_exchange_weak(
+                current,
+                current + 1,
+                Ordering::SeqCst,
+                Ordering::SeqCst,
+            ) {
+                Ok(_) => return true,
+                Err(actual) => current = actual,
+            }
+        }
+        false
+    }
+
+    /// Queue the caller, or admit or reject it straight away
+    ///
+    /// Returns `Ok(None)` if a slot was freed before the caller queued.
+    fn enqueue(&self, wake: WakeTarget) -> PluginResult<Option<Queued<'_>>> {
+        if self.config.mode == AdmissionMode::Reject {
+            return Err(self.reject());
+        }
+
+        let mut queue = self.queue.lock();
+        // Announce the waiter before retrying, so a concurrent release either
+        // frees a slot this retry sees or sees the waiter and grants it
+        self.waiting.fetch_add(1, Ordering::SeqCst);
+        if self.try_acquire_slot() {
+            self.waiting.fetch_sub(1, Ordering::SeqCst);
+            self.admitted.fetch_add(1, Ordering::Relaxed);
+            return Ok(None);
+        }
+        if queue.waiters.len() >= self.config.max_queue_depth {
+            self.waiting.fetch_sub(1, Ordering::SeqCst);
+            return Err(self.reject());
+        }
+
+        let now = Instant::now();
+        if queue.waiters.is_empty() {
+            queue.last_empty = now;
+        }
+        let overloaded = self.config.mode == AdmissionMode::AdaptiveLifo
+            && queue.overloaded(now, Duration::from_millis(self.config.codel_interval_ms));
+        let timeout_ms = if overloaded {
+            self.config.codel_target_ms
+        } else {
+            self.config.max_wait_ms
+        };
+
+        let waiter = Arc::new(Waiter::new(wake));
+        queue.waiters.push_back(Arc::clone(&waiter));
+        self.queued.fetch_add(1, Ordering::Relaxed);
+
+        Ok(Some(Queued {
+            controller: self,
+            waiter,
+            enqueued: now,
+            deadline: now + Duration::from_millis(timeout_ms),
+            settled: false,
+        }))
+    }
+
+    /// Return a slot, handing it to queued requests first
+    fn release(&self) {
+        self.in_flight.fetch_sub(1, Ordering::SeqCst);
+        if self.waiting.load(Ordering::SeqCst) != 0 {
+            self.grant_waiters();
+        }
+    }
+
+    fn grant_waiters(&self) {
+        let mut queue = self.queue.lock();
+        let now = Instant::now();
+        let interval = Duration::from_millis(self.config.codel_interval_ms);
+        while !queue.waiters.is_empty() && self.try_acquire_slot() {
+            let lifo =
+                self.config.mode == AdmissionMode::AdaptiveLifo && queue.overloaded(now, interval);
+            let next = if lifo {
+                queue.waiters.pop_back()
+            } else {
+                queue.waiters.pop_front()
+            };
+            if let Some(waiter) = next {
+                self.waiting.fetch_sub(1, Ordering::SeqCst);
+                waiter.grant();
+            }
+        }
+        if queue.waiters.is_empty() {
+            queue.last_empty = now;
+        }
+    }
+
+    fn reject(&self) -> PluginError {
+        self.rejected.fetch_add(1, Ordering::Relaxed);
+        PluginError::TooManyRequests
+    }
+
+    fn record_wait(&self, wait: Duration) {
+        let micros = u64::try_from(wait.as_micros()).unwrap_or(u64::MAX);
+        let bucket = (u64::BITS - micros.leading_zeros()) as usize;
+        self.wait_histogram[bucket.min(WAIT_HISTOGRAM_BUCKETS - 1)].fetch_add(1, Ordering::Relaxed);
+    }
+}
+
+/// A request's place in the queue
+///
+/// Dropping it without settling (a cancelled wait) leaves the queue, or
+/// returns the slot if one was granted in the meantime.
+struct Queued<'a> {
+    controller: &'a AdmissionController,
+    waiter: Arc<Waiter>,
+    enqueued: Instant,
+    deadline: Instant,
+    settled: bool,
+}
+
+impl Queued<'_> {
+    /// Resolve the wait: admitted if granted, otherwise leave the queue and reject
+    fn settle(mut self) -> PluginResult<()> {
+        self.settled = true;
+        let controller = self.controller;
+
+        // Grants happen under the queue lock, so a miss here is only final
+        // once the lock is held
+        if !self.waiter.is_granted() {
+            let mut queue = controller.queue.lock();
+            if !self.waiter.is_granted() {
+                queue.remove(&self.waiter);
+                controller.waiting.fetch_sub(1, Ordering::SeqCst);
+                if queue.waiters.is_empty() {
+                    queue.last_empty = Instant::now();
+                }
+                drop(queue);
+                controller.timed_out.fetch_add(1, Ordering::Relaxed);
+                return Err(controller.reject());
+            }
+        }
+
+        controller.record_wait(self.enqueued.elapsed());
+        controller.admitted.fetch_add(1, Ordering::Relaxed);
+        Ok(())
+    }
+}
+
+impl Drop for Queued<'_> {
+    fn drop(&mut self) {
+        if self.settled {
+            return;
+        }
+        let controller = self.controller;
+        let mut queue = controller.queue.lock();
+        if self.waiter.is_granted() {
+            drop(queue);
+            controller.release();
+        } else {
+            queue.remove(&self.waiter);
+            controller.waiting.fetch_sub(1, Ordering::SeqCst);
+        }
+    }
+}
+
+/// Resolves once a queued task's waiter is granted a slot
+struct Granted<'a> {
+    waiter: &'a Waiter,
+}
+
+impl Future for Granted<'_> {
+    type Output = ();
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+        if self.waiter.is_granted() {
+            return Poll::Ready(());
+        }
+        if let WakeTarget::Task(waker) = &self.waiter.wake {
+            *waker.lock() = Some(cx.waker().clone());
+        }
+        // Re-check after publishing the waker so a concurrent grant is not missed
+        if self.waiter.is_granted() {
+            Poll::Ready(())
+        } else {
+            Poll::Pending
+        }
+    }
+}
+
+/// A slot held by an admitted request, released on drop
+#[must_use = "the slot is released as soon as the permit is dropped"]
+pub struct AdmissionPermit<'a> {
+    controller: &'a AdmissionController,
+}
+
+impl Drop for AdmissionPermit<'_> {
+    fn drop(&mut self) {
+        self.controller.release();
+    }
+}
+
+/// An owned slot that can move into a spawned task, released on drop
+#[must_use = "the slot is released as soon as the permit is dropped"]
+pub struct OwnedAdmissionPermit {
+    controller: Arc<AdmissionController>,
+}
+
+impl Drop for OwnedAdmissionPermit {
+    fn drop(&mut self) {
+        self.controller.release();
+    }
+}
+
+#[cfg(test)]
+#[path = "admission/admission_tests.rs"]
+mod admission_tests;
@@ -0,0 +1,284 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use std::sync::mpsc;
+use std::time::Duration;
+
+fn controller(limit: usize, mode: AdmissionMode) -> Arc<AdmissionController> {
+    Arc::new(AdmissionController::new(
+        limit,
+        AdmissionConfig {
+            mode,
+            max_wait_ms: 5000,
+            codel_target_ms: 5000,
+            ..Default::default()
+        },
+    ))
+}
+
+/// Spin until `f` holds, failing the test after a few seconds
+fn wait_until(f: impl Fn() -> bool) {
+    let deadline = Instant::now() + Duration::from_secs(5);
+    while !f() {
+        assert!(Instant::now() < deadline, "condition not reached");
+        std::thread::sleep(Duration::from_millis(1));
+    }
+}
+
+/// Admit on a new thread and report `tag` once admitted (or 0 if rejected)
+fn admit_on_thread(
+    controller: &Arc<AdmissionController>,
+    tag: u32,
+    tx: &mpsc::Sender<u32>,
+) -> std::thread::JoinHandle<()> {
+    let controller = Arc::clone(controller);
+    let tx = tx.clone();
+    std::thread::spawn(move || match controller.admit() {
+        Ok(_permit) => tx.send(tag).unwrap(),
+        Err(_) => tx.send(0).unwrap(),
+    })
+}
+
+// Reject mode tests
+
+#[test]
+fn AdmissionController___admit___within_limit_succeeds() {
+    let controller = controller(2, AdmissionMode::Reject);
+
+    let _a = controller.admit().unwrap();
+    let _b = controller.admit().unwrap();
+
+    let stats = controller.stats();
+    assert_eq!(stats.in_flight, 2);
+    assert_eq!(stats.admitted, 2);
+}
+
+#[test]
+fn AdmissionController___admit___reject_mode_at_limit_returns_too_many_requests() {
+    let controller = controller(1, AdmissionMode::Reject);
+    let _held = controller.admit().unwrap();
+
+    let result = controller.admit();
+
+    assert!(matches!(result, Err(PluginError::TooManyRequests)));
+    assert_eq!(controller.rejected_count(), 1);
+    assert_eq!(controller.stats().queued, 0);
+}
+
+#[test]
+fn AdmissionController___permit_drop___frees_slot() {
+    let controller = controller(1, AdmissionMode::Reject);
+
+    drop(controller.admit().unwrap());
+    let _permit = controller.admit().unwrap();
+
+    assert_eq!(controller.stats().in_flight, 1);
+}
+
+// Queueing tests
+
+#[test]
+fn AdmissionController___admit___fifo_waiter_gets_released_slot() {
+    let controller = controller(1, AdmissionMode::Fifo);
+    let held = controller.admit().unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    let waiter = admit_on_thread(&controller, 1, &tx);
+    wait_until(|| controller.stats().queue_depth == 1);
+    drop(held);
+
+    assert_eq!(rx.recv_timeout(Duration::from_secs(5)).unwrap(), 1);
+    waiter.join().unwrap();
+    let stats = controller.stats();
+    assert_eq!(stats.queued, 1);
+    assert_eq!(stats.admitted, 2);
+    assert_eq!(stats.wait_histogram_us.iter().sum::<u64>(), 1);
+    assert_eq!(stats.in_flight, 0);
+}
+
+#[test]
+fn AdmissionController___admit___fifo_serves_oldest_first() {
+    let controller = controller(1, AdmissionMode::Fifo);
+    let held = controller.admit().unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    let first = admit_on_thread(&controller, 1, &tx);
+    wait_until(|| controller.stats().queue_depth == 1);
+    let second = admit_on_thread(&controller, 2, &tx);
+    wait_until(|| controller.stats().queue_depth == 2);
+    drop(held);
+
+    let order: Vec<u32> = (0..2)
+        .map(|_| rx.recv_timeout(Duration::from_secs(5)).unwrap())
+        .collect();
+    first.join().unwrap();
+    second.join().unwrap();
+    assert_eq!(order, vec![1, 2]);
+}
+
+#[test]
+fn AdmissionController___admit___adaptive_lifo_overloaded_serves_newest_first() {
+    let controller = Arc::new(AdmissionController::new(
+        1,
+        AdmissionConfig {
+            mode: AdmissionMode::AdaptiveLifo,
+            max_wait_ms: 5000,
+            codel_target_ms: 5000,
+            codel_interval_ms: 0,
+            ..Default::default()
+        },
+    ));
+    let held = controller.admit().unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    let first = admit_on_thread(&controller, 1, &tx);
+    wait_until(|| controller.stats().queue_depth == 1);
+    let second = admit_on_thread(&controller, 2, &tx);
+    wait_until(|| controller.stats().queue_depth == 2);
+    drop(held);
+
+    let order: Vec<u32> = (0..2)
+        .map(|_| rx.recv_timeout(Duration::from_secs(5)).unwrap())
+        .collect();
+    first.join().unwrap();
+    second.join().unwrap();
+    assert_eq!(order, vec![2, 1]);
+}
+
+#[test]
+fn AdmissionController___admit___adaptive_lifo_overloaded_uses_codel_target() {
+    let controller = Arc::new(AdmissionController::new(
+        1,
+        AdmissionConfig {
+            mode: AdmissionMode::AdaptiveLifo,
+            max_wait_ms: 5000,
+            codel_target_ms: 1,
+            codel_interval_ms: 0,
+            ..Default::default()
+        },
+    ));
+    let held = controller.admit().unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    let first = admit_on_thread(&controller, 1, &tx);
+    wait_until(|| controller.stats().queue_depth == 1);
+    std::thread::sleep(Duration::from_millis(2));
+    let second = admit_on_thread(&controller, 2, &tx);
+
+    assert_eq!(rx.recv_timeout(Duration::from_secs(5)).unwrap(), 0);
+    second.join().unwrap();
+    assert_eq!(controller.stats().timed_out, 1);
+    assert_eq!(controller.stats().queue_depth, 1);
+    drop(held);
+    assert_eq!(rx.recv_timeout(Duration::from_secs(5)).unwrap(), 1);
+    first.join().unwrap();
+}
+
+#[test]
+fn AdmissionController___admit___deadline_passes_returns_too_many_requests() {
+    let controller = Arc::new(AdmissionController::new(
+        1,
+        AdmissionConfig {
+            mode: AdmissionMode::Fifo,
+            max_wait_ms: 5,
+            ..Default::default()
+        },
+    ));
+    let _held = controller.admit().unwrap();
+
+    let result = controller.admit();
+
+    assert!(matches!(result, Err(PluginError::TooManyRequests)));
+    let stats = controller.stats();
+    assert_eq!(stats.timed_out, 1);
+    assert_eq!(stats.rejected, 1);
+    assert_eq!(stats.queue_depth, 0);
+}
+
+#[test]
+fn AdmissionController___admit___queue_full_rejects_immediately() {
+    let controller = Arc::new(AdmissionController::new(
+        1,
+        AdmissionConfig {
+            mode: AdmissionMode::Fifo,
+            max_wait_ms: 5000,
+            max_queue_depth: 0,
+            ..Default::default()
+        },
+    ));
+    let _held = controller.admit().unwrap();
+
+    let result = controller.admit();
+
+    assert!(matches!(result, Err(PluginError::TooManyRequests)));
+    assert_eq!(controller.stats().timed_out, 0);
+    assert_eq!(controller.stats().queued, 0);
+}
+
+// Async admission tests
+
+#[test]
+fn AdmissionController___try_admit_owned___reports_queue_or_reject() {
+    let fifo = controller(1, AdmissionMode::Fifo);
+    let reject = controller(1, AdmissionMode::Reject);
+    let _fifo_held = fifo.try_admit_owned().unwrap();
+    let _reject_held = reject.try_admit_owned().unwrap();
+
+    assert!(matches!(fifo.try_admit_owned(), Ok(None)));
+    assert!(matches!(
+        reject.try_admit_owned(),
+        Err(PluginError::TooManyRequests)
+    ));
+}
+
+#[tokio::test]
+async fn AdmissionController___admit_owned___waits_for_released_slot() {
+    let controller = controller(1, AdmissionMode::Fifo);
+    let held = Arc::clone(&controller).admit_owned().await.unwrap();
+
+    let waiter = tokio::spawn(Arc::clone(&controller).admit_owned());
+    while controller.stats().queue_depth == 0 {
+        tokio::task::yield_now().await;
+    }
+    drop(held);
+    let permit = waiter.await.unwrap();
+
+    assert!(permit.is_ok());
+    assert_eq!(controller.stats().in_flight, 1);
+}
+
+#[tokio::test]
+async fn AdmissionController___admit_owned___dropped_future_leaves_queue() {
+    let controller = controller(1, AdmissionMode::Fifo);
+    let held = Arc::clone(&controller).admit_owned().await.unwrap();
+
+    let result = tokio::time::timeout(
+        Duration::from_millis(5),
+        Arc::clone(&controller).admit_owned(),
+    )
+    .await;
+    drop(held);
+
+    assert!(result.is_err());
+    let stats = controller.stats();
+    assert_eq!(stats.queue_depth, 0);
+    assert_eq!(stats.in_flight, 0);
+}
+
+// Histogram tests
+
+#[test]
+fn AdmissionController___record_wait___uses_log2_microsecond_buckets() {
+    let controller = controller(1, AdmissionMode::Fifo);
+
+    controller.record_wait(Duration::ZERO);
+    controller.record_wait(Duration::from_micros(1));
+    controller.record_wait(Duration::from_micros(3));
+    controller.record_wait(Duration::from_secs(3600));
+
+    let histogram = controller.stats().wait_histogram_us;
+    assert_eq!(histogram[0], 1);
+    assert_eq!(histogram[1], 1);
+    assert_eq!(histogram[2], 1);
+    assert_eq!(histogram[WAIT_HISTOGRAM_BUCKETS - 1], 1);
+}
@@ -0,0 +1,113 @@
+//! CPU affinity for runtime threads
+
+use rustbridge_core::{PluginError, PluginResult};
+
+/// Resolve the CPUs a runtime's threads should be restricted to
+///
+/// Returns an empty list when neither an explicit CPU list nor a NUMA node is
+/// configured, meaning the threads are left unpinned.
+pub(crate) fn resolve_cpus(
+    cpu_affinity: &[usize],
+    numa_node: Option<usize>,
+) -> PluginResult<Vec<usize>> {
+    let mut cpus = match numa_node {
+        Some(node) => {
+            let node_cpus = numa_node_cpus(node)?;
+            if cpu_affinity.is_empty() {
+                node_cpus
+            } else {
+                node_cpus
+                    .into_iter()
+                    .filter(|cpu| cpu_affinity.contains(cpu))
+                    .collect()
+            }
+        }
+        None => cpu_affinity.to_vec(),
+    };
+    cpus.sort_unstable();
+    cpus.dedup();
+
+    if cpus.is_empty() && (!cpu_affinity.is_empty() || numa_node.is_some()) {
+        return Err(PluginError::ConfigError(
+            "runtime CPU affinity selects no CPUs".to_string(),
+        ));
+    }
+    Ok(cpus)
+}
+
+/// Parse a kernel CPU list such as `0-3,8,10-11`
+pub(crate) fn parse_cpu_list(list: &str) -> Option<Vec<usize>> {
+    let mut cpus = Vec::new();
+    for part in list.trim().split(',').filter(|p| !p.is_empty()) {
+        match part.split_once('-') {
+            Some((start, end)) => {
+                let start: usize = start.trim().parse().ok()?;
+                let end: usize = end.trim().parse().ok()?;
+                if end < start {
+                    return None;
+                }
+                cpus.extend(start..=end);
+            }
+            None => cpus.push(part.trim().parse().ok()?),
+        }
+    }
+    Some(cpus)
+}
+
+/// CPUs belonging to a NUMA node, as reported by sysfs
+#[cfg(target_os = "linux")]
+fn numa_node_cpus(node: usize) -> PluginResult<Vec<usize>> {
+    let path = format!("/sys/devices/system/node/node{node}/cpulist");
+    let list = std::fs::read_to_string(&path)
+        .map_err(|e| PluginError::ConfigError(format!("NUMA node {node} unavailable: {e}")))?;
+    parse_cpu_list(&list)
+        .ok_or_else(|| PluginError::ConfigError(format!("malformed CPU list in {path}")))
+}
+
+#[cfg(not(target_os = "linux"))]
+fn numa_node_cpus(node: usize) -> PluginResult<Vec<usize>> {
+    Err(PluginError::ConfigError(format!(
+        "NUMA node {node} pinning is only supported on Linux"
+    )))
+}
+
+/// Restrict the calling thread to the given CPUs
+#[cfg(target_os = "linux")]
+pub(crate) fn pin_current_thread(cpus: &[usize]) -> std::io::Result<()> {
+    // SAFETY: cpu_set_t is a plain bitmask, so an all-zero value is valid and
+    // CPU_SET only writes within it for indices below CPU_SETSIZE.
+    let set = unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        for &cpu in cpus.iter().filter(|&&cpu| cpu < libc::CPU_SETSIZE as usize) {
+            libc::CPU_SET(cpu, &mut set);
+        }
+        set
+    };
+    // SAFETY: pid 0 targets the calling thread and `set` outlives the call.
+    let result =
+        unsafe { libc::sched_setaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &set) };
+    if result == 0 {
+        Ok(())
+    } else {
+        Err(std::io::Error::last_os_error())
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+pub(crate) fn pin_current_thread(_cpus: &[usize]) -> std::io::Result<()> {
+    Err(std::io::Error::new(
+        std::io::ErrorKind::Unsupported,
+        "thread affinity is only supported on Linux",
+    ))
+}
+
+/// Pin the calling thread, logging instead of failing if the OS refuses
+pub(crate) fn pin_or_warn(cpus: &[usize]) {
+    if let Err(e) = pin_current_thread(cpus) {
+        tracing::warn!(error = %e, ?cpus, "Failed to set runtime thread affinity");
+    }
+}
+
+#[cfg(test)]
+#[path = "affinity/affinity_tests.rs"]
+mod affinity_tests;
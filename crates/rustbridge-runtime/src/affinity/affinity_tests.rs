@@ -0,0 +1,42 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+// parse_cpu_list tests
+
+#[test]
+fn parse_cpu_list___ranges_and_singles___expands_all() {
+    let cpus = parse_cpu_list("0-3,8,10-11\n");
+
+    assert_eq!(cpus, Some(vec![0, 1, 2, 3, 8, 10, 11]));
+}
+
+#[test]
+fn parse_cpu_list___empty___returns_no_cpus() {
+    assert_eq!(parse_cpu_list("\n"), Some(vec![]));
+}
+
+#[test]
+fn parse_cpu_list___malformed___returns_none() {
+    assert_eq!(parse_cpu_list("0-x"), None);
+    assert_eq!(parse_cpu_list("4-2"), None);
+}
+
+// resolve_cpus tests
+
+#[test]
+fn resolve_cpus___nothing_configured___returns_empty() {
+    assert_eq!(resolve_cpus(&[], None).unwrap(), Vec::<usize>::new());
+}
+
+#[test]
+fn resolve_cpus___explicit_list___sorted_and_deduplicated() {
+    assert_eq!(resolve_cpus(&[3, 1, 3], None).unwrap(), vec![1, 3]);
+}
+
+#[test]
+fn resolve_cpus___unknown_numa_node___returns_config_error() {
+    let result = resolve_cpus(&[], Some(usize::MAX));
+
+    assert!(matches!(result, Err(PluginError::ConfigError(_))));
+}
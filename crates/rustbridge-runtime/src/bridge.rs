@@ -5,6 +5,7 @@ use rustbridge_core::{PluginError, PluginResult};
 use std::future::Future;
 use std::sync::Arc;
 use std::sync::atomic::{AtomicU64, Ordering};
+use std::task::{Context, Poll, Waker};
 
 /// Bridge for executing async operations from sync FFI context
 pub struct AsyncBridge {
@@ -29,6 +30,10 @@ impl AsyncBridge {
     /// Execute an async operation synchronously (blocking)
     ///
     /// This is the primary method for handling sync FFI calls.
+    ///
+    /// The future is polled once on the calling thread first. Handlers that
+    /// never await complete in that poll without touching the scheduler; only
+    /// futures that return `Pending` fall through to `block_on`.
     pub fn call_sync<F, T>(&self, future: F) -> PluginResult<T>
     where
         F: Future<Output = PluginResult<T>>,
@@ -38,6 +43,16 @@ impl AsyncBridge {
                 "Runtime is shutting down".to_string(),
             ));
         }
+        let mut future = std::pin::pin!(future);
+        {
+            // Entered so a first poll that touches timers or I/O finds the runtime
+            let _context = self.runtime.enter();
+            let mut cx = Context::from_waker(Waker::noop());
+            if let Poll::Ready(result) = future.as_mut().poll(&mut cx) {
+                return result;
+            }
+        }
+        // Pending futures re-register their waker when block_on polls again
         self.runtime.block_on(future)
     }
 
@@ -67,6 +82,60 @@ impl AsyncBridge {
         self.runtime.spawn(future)
     }
 
+    /// Run blocking closures on the runtime's blocking pool and wait for all of them
+    ///
+    /// Results are returned in the order the closures were given. A closure
+    /// that panics is reported as an internal error.
+    ///
+    /// Fails without running anything when called from inside a runtime
+    /// context (see [`AsyncBridge::can_block`]), so no closure is left running
+    /// after this returns.
+    pub fn call_blocking_all<F, T>(&self, tasks: Vec<F>) -> PluginResult<Vec<T>>
+    where
+        F: FnOnce() -> T + Send + 'static,
+        T: Send + 'static,
+    {
+        if self.runtime.is_shutting_down() {
+            return Err(PluginError::RuntimeError(
+                "Runtime is shutting down".to_string(),
+            ));
+        }
+        if !self.can_block() {
+            return Err(PluginError::RuntimeError(
+                "Cannot block inside a runtime context".to_string(),
+            ));
+        }
+        let runtime = &self.runtime;
+        self.runtime.block_on(async move {
+            // Spawned inside block_on so nothing is started if it cannot run
+            let handles: Vec<_> = tasks
+                .into_iter()
+                .map(|task| runtime.spawn_blocking(task))
+                .collect();
+            let mut results = Vec::with_capacity(handles.len());
+            let mut failure = None;
+            // Await every task, even after a failure, so none outlives this call
+            for handle in handles {
+                match handle.await {
+                    Ok(value) => results.push(value),
+                    Err(e) => failure = Some(PluginError::Internal(e.to_string())),
+                }
+            }
+            match failure {
+                Some(e) => Err(e),
+                None => Ok(results),
+            }
+        })
+    }
+
+    /// Check whether the calling thread may block on the runtime
+    ///
+    /// False on runtime worker threads and inside `block_on`, for example in
+    /// an async completion callback that calls back into the plugin.
+    pub fn can_block(&self) -> bool {
+        tokio::runtime::Handle::try_current().is_err()
+    }
+
     /// Get a shutdown signal
     pub fn shutdown_signal(&self) -> ShutdownSignal {
         self.runtime.shutdown_signal()
@@ -79,7 +148,6 @@ impl AsyncBridge {
 }
 
 /// Type alias for async completion callback used in FFI
-#[allow(dead_code)] // Reserved for future async API
 pub type CompletionCallback = extern "C" fn(
     context: *mut std::ffi::c_void,
     request_id: u64,
@@ -89,7 +157,6 @@ pub type CompletionCallback = extern "C" fn(
 );
 
 /// Pending async request tracker
-#[allow(dead_code)] // Reserved for future async API
 pub struct PendingRequest {
     pub request_id: u64,
     pub callback: CompletionCallback,
@@ -101,7 +168,6 @@ pub struct PendingRequest {
 unsafe impl Send for PendingRequest {}
 unsafe impl Sync for PendingRequest {}
 
-#[allow(dead_code)] // Reserved for future async API
 impl PendingRequest {
     /// Create a new pending request
     pub fn new(
@@ -117,12 +183,26 @@ impl PendingRequest {
         }
     }
 
+    /// Complete the request with response data and an error code (0 = success)
+    ///
+    /// # Safety
+    /// The callback and context must be valid for the duration of this call.
+    pub unsafe fn complete(&self, data: &[u8], error_code: u32) {
+        (self.callback)(
+            self.context,
+            self.request_id,
+            data.as_ptr(),
+            data.len(),
+            error_code,
+        );
+    }
+
     /// Complete the request with success
     ///
     /// # Safety
     /// The callback and context must be valid for the duration of this call.
     pub unsafe fn complete_success(&self, data: &[u8]) {
-        (self.callback)(self.context, self.request_id, data.as_ptr(), data.len(), 0);
+        unsafe { self.complete(data, 0) };
     }
 
     /// Complete the request with error
@@ -130,14 +210,7 @@ impl PendingRequest {
     /// # Safety
     /// The callback and context must be valid for the duration of this call.
     pub unsafe fn complete_error(&self, error_code: u32, message: &str) {
-        let msg_bytes = message.as_bytes();
-        (self.callback)(
-            self.context,
-            self.request_id,
-            msg_bytes.as_ptr(),
-            msg_bytes.len(),
-            error_code,
-        );
+        unsafe { self.complete(message.as_bytes(), error_code) };
     }
 }
 
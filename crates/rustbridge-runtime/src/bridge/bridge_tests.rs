@@ -42,6 +42,59 @@ fn AsyncBridge___call_sync___propagates_errors() {
     assert!(result.is_err());
 }
 
+#[test]
+fn AsyncBridge___call_sync___ready_future_polled_once() {
+    let bridge = create_test_bridge();
+    let polls = std::cell::Cell::new(0);
+
+    let result = bridge.call_sync(std::future::poll_fn(|_| {
+        polls.set(polls.get() + 1);
+        Poll::Ready(Ok::<_, PluginError>(7))
+    }));
+
+    assert_eq!(result.unwrap(), 7);
+    assert_eq!(polls.get(), 1);
+}
+
+#[test]
+fn AsyncBridge___call_sync___pending_future_completes_on_runtime() {
+    let bridge = create_test_bridge();
+
+    let result = bridge.call_sync(async {
+        tokio::task::yield_now().await;
+        tokio::time::sleep(std::time::Duration::from_millis(5)).await;
+        Ok::<_, PluginError>(42)
+    });
+
+    assert_eq!(result.unwrap(), 42);
+}
+
+#[test]
+fn AsyncBridge___call_sync___first_poll_can_spawn() {
+    let bridge = create_test_bridge();
+
+    let result = bridge.call_sync(async {
+        tokio::spawn(async { 5 })
+            .await
+            .map_err(|e| PluginError::RuntimeError(e.to_string()))
+    });
+
+    assert_eq!(result.unwrap(), 5);
+}
+
+#[test]
+fn AsyncBridge___call_sync___rejected_while_shutting_down() {
+    let runtime = Arc::new(AsyncRuntime::new(RuntimeConfig::default()).unwrap());
+    let bridge = AsyncBridge::new(Arc::clone(&runtime));
+    runtime
+        .shutdown(std::time::Duration::from_millis(10))
+        .unwrap();
+
+    let result = bridge.call_sync(async { Ok::<_, PluginError>(1) });
+
+    assert!(matches!(result, Err(PluginError::RuntimeError(_))));
+}
+
 #[test]
 fn AsyncBridge___call_sync_timeout___succeeds_within_timeout() {
     let bridge = create_test_bridge();
@@ -102,6 +155,48 @@ fn AsyncBridge___is_shutting_down___initially_false() {
     assert!(!bridge.is_shutting_down());
 }
 
+#[test]
+fn AsyncBridge___call_blocking_all___returns_results_in_order() {
+    let bridge = create_test_bridge();
+    let tasks: Vec<_> = (0..8).map(|i| move || i * 10).collect();
+
+    let results = bridge.call_blocking_all(tasks).unwrap();
+
+    assert_eq!(results, vec![0, 10, 20, 30, 40, 50, 60, 70]);
+}
+
+#[test]
+fn AsyncBridge___call_blocking_all___reports_panicking_task() {
+    let bridge = create_test_bridge();
+    let tasks: Vec<Box<dyn FnOnce() -> i32 + Send>> =
+        vec![Box::new(|| 1), Box::new(|| panic!("boom"))];
+
+    let result = bridge.call_blocking_all(tasks);
+
+    assert!(matches!(result, Err(PluginError::Internal(_))));
+}
+
+#[test]
+fn AsyncBridge___call_blocking_all___inside_runtime_context___fails_without_running() {
+    let bridge = create_test_bridge();
+    let ran = Arc::new(std::sync::atomic::AtomicBool::new(false));
+    let flag = ran.clone();
+    let tasks = vec![move || flag.store(true, Ordering::SeqCst)];
+    let _context = bridge.runtime.enter();
+
+    let result = bridge.call_blocking_all(tasks);
+
+    assert!(matches!(result, Err(PluginError::RuntimeError(_))));
+    assert!(!ran.load(Ordering::SeqCst));
+}
+
+#[test]
+fn AsyncBridge___can_block___outside_runtime___true() {
+    let bridge = create_test_bridge();
+
+    assert!(bridge.can_block());
+}
+
 // PendingRequest tests
 
 #[test]
@@ -120,3 +215,28 @@ fn PendingRequest___new___creates_request() {
     assert_eq!(request.request_id, 42);
     assert!(request.cancel_handle.is_none());
 }
+
+#[test]
+fn PendingRequest___complete___passes_data_and_error_code() {
+    extern "C" fn record_callback(
+        context: *mut std::ffi::c_void,
+        request_id: u64,
+        data: *const u8,
+        len: usize,
+        error_code: u32,
+    ) {
+        let out = unsafe { &mut *(context as *mut (u64, Vec<u8>, u32)) };
+        let bytes = unsafe { std::slice::from_raw_parts(data, len) };
+        *out = (request_id, bytes.to_vec(), error_code);
+    }
+    let mut out: (u64, Vec<u8>, u32) = (0, Vec::new(), 0);
+    let request = PendingRequest::new(
+        7,
+        record_callback,
+        &mut out as *mut (u64, Vec<u8>, u32) as *mut std::ffi::c_void,
+    );
+
+    unsafe { request.complete(b"payload", 5) };
+
+    assert_eq!(out, (7, b"payload".to_vec(), 5));
+}
@@ -1,16 +1,25 @@
 //! rustbridge-runtime - Tokio async runtime integration
 //!
 //! This crate provides:
-//! - [`AsyncRuntime`] for managing the Tokio runtime
+//! - [`AsyncRuntime`] for managing the Tokio runtime, dedicated or shared
+//!   between plugins, with optional CPU pinning
 //! - [`AsyncBridge`] for bridging sync FFI calls to async handlers
+//! - [`AdmissionController`] for limiting and queueing concurrent requests
 //! - Graceful shutdown support with broadcast signals
 
+mod admission;
+mod affinity;
 mod bridge;
 mod runtime;
 mod shutdown;
 
-pub use bridge::AsyncBridge;
+pub use admission::{
+    AdmissionController, AdmissionPermit, AdmissionStats, OwnedAdmissionPermit,
+    WAIT_HISTOGRAM_BUCKETS,
+};
+pub use bridge::{AsyncBridge, CompletionCallback, PendingRequest};
 pub use runtime::{AsyncRuntime, RuntimeConfig};
+pub use rustbridge_core::RuntimeFlavor;
 pub use shutdown::{ShutdownHandle, ShutdownSignal};
 
 /// Prelude module for convenient imports
@@ -1,10 +1,12 @@
 //! Tokio runtime management
 
+use crate::affinity;
 use crate::shutdown::{ShutdownHandle, ShutdownSignal};
 use parking_lot::Mutex;
-use rustbridge_core::{PluginError, PluginResult};
-use std::sync::Arc;
+use rustbridge_core::{PluginError, PluginResult, RuntimeFlavor};
+use std::sync::{Arc, Weak};
 use tokio::runtime::{Builder, Runtime};
+use tokio::sync::Notify;
 
 /// Configuration for the async runtime
 #[derive(Debug, Clone)]
@@ -19,6 +21,14 @@ pub struct RuntimeConfig {
     pub enable_time: bool,
     /// Maximum blocking threads
     pub max_blocking_threads: usize,
+    /// Scheduler flavor
+    pub flavor: RuntimeFlavor,
+    /// Reuse the process-wide runtime of this flavor instead of building one
+    pub shared: bool,
+    /// CPUs the runtime's threads may run on (empty = no restriction)
+    pub cpu_affinity: Vec<usize>,
+    /// Restrict the runtime's threads to the CPUs of this NUMA node
+    pub numa_node: Option<usize>,
 }
 
 impl Default for RuntimeConfig {
@@ -29,6 +39,10 @@ impl Default for RuntimeConfig {
             enable_io: true,
             enable_time: true,
             max_blocking_threads: 512,
+            flavor: RuntimeFlavor::default(),
+            shared: false,
+            cpu_affinity: Vec::new(),
+            numa_node: None,
         }
     }
 }
@@ -50,23 +64,73 @@ impl RuntimeConfig {
         self.thread_name = name.into();
         self
     }
+
+    /// Set the scheduler flavor
+    pub fn with_flavor(mut self, flavor: RuntimeFlavor) -> Self {
+        self.flavor = flavor;
+        self
+    }
+
+    /// Use the process-wide runtime of the configured flavor
+    pub fn with_shared(mut self, shared: bool) -> Self {
+        self.shared = shared;
+        self
+    }
+
+    /// Restrict runtime threads to the given CPUs
+    pub fn with_cpu_affinity(mut self, cpus: impl Into<Vec<usize>>) -> Self {
+        self.cpu_affinity = cpus.into();
+        self
+    }
+
+    /// Restrict runtime threads to the CPUs of a NUMA node
+    pub fn with_numa_node(mut self, node: usize) -> Self {
+        self.numa_node = Some(node);
+        self
+    }
+
+    /// Whether a runtime built from `self` has the threads `other` asks for
+    fn builds_same_threads(&self, other: &Self) -> bool {
+        self.worker_threads == other.worker_threads
+            && self.thread_name == other.thread_name
+            && self.enable_io == other.enable_io
+            && self.enable_time == other.enable_time
+            && self.max_blocking_threads == other.max_blocking_threads
+            && self.cpu_affinity == other.cpu_affinity
+            && self.numa_node == other.numa_node
+    }
 }
 
-/// Manages the Tokio async runtime for a plugin
-pub struct AsyncRuntime {
-    runtime: Arc<Runtime>,
-    shutdown_handle: ShutdownHandle,
+/// Process-wide runtimes handed out to plugins with `shared` set
+///
+/// Only weak references are kept, so a shared runtime is shut down with the
+/// last plugin using it rather than outliving the library it runs code from.
+static SHARED_MULTI_THREAD: Mutex<Weak<RuntimeCore>> = Mutex::new(Weak::new());
+static SHARED_CURRENT_THREAD: Mutex<Weak<RuntimeCore>> = Mutex::new(Weak::new());
+
+/// A built Tokio runtime, owned by one plugin or shared by several
+struct RuntimeCore {
+    runtime: Runtime,
+    /// Releases the current-thread driver (None for multi-thread runtimes)
+    driver_stop: Option<Arc<Notify>>,
+    /// Config the runtime was built from
     config: RuntimeConfig,
 }
 
-impl AsyncRuntime {
-    /// Create a new async runtime with the given configuration
-    pub fn new(config: RuntimeConfig) -> PluginResult<Self> {
-        let mut builder = Builder::new_multi_thread();
-
-        if let Some(threads) = config.worker_threads {
-            builder.worker_threads(threads);
-        }
+impl RuntimeCore {
+    fn build(config: &RuntimeConfig) -> PluginResult<Arc<Self>> {
+        let cpus = affinity::resolve_cpus(&config.cpu_affinity, config.numa_node)?;
+
+        let mut builder = match config.flavor {
+            RuntimeFlavor::MultiThread => {
+                let mut builder = Builder::new_multi_thread();
+                if let Some(threads) = config.worker_threads {
+                    builder.worker_threads(threads);
+                }
+                builder
+            }
+            RuntimeFlavor::CurrentThread => Builder::new_current_thread(),
+        };
 
         builder
             .thread_name(&config.thread_name)
@@ -80,12 +144,101 @@ impl AsyncRuntime {
             builder.enable_time();
         }
 
+        if !cpus.is_empty() {
+            let cpus = cpus.clone();
+            builder.on_thread_start(move || affinity::pin_or_warn(&cpus));
+        }
+
         let runtime = builder
             .build()
             .map_err(|e| PluginError::RuntimeError(format!("Failed to create runtime: {}", e)))?;
 
+        if config.flavor == RuntimeFlavor::MultiThread {
+            return Ok(Arc::new(Self {
+                runtime,
+                driver_stop: None,
+                config: config.clone(),
+            }));
+        }
+
+        // A current-thread runtime only makes progress while some thread is
+        // inside block_on, so one dedicated thread drives spawned tasks, timers,
+        // and I/O until the owner releases it.
+        let stop = Arc::new(Notify::new());
+        let core = Arc::new(Self {
+            runtime,
+            driver_stop: Some(Arc::clone(&stop)),
+            config: config.clone(),
+        });
+        let driver = Arc::clone(&core);
+        std::thread::Builder::new()
+            .name(config.thread_name.clone())
+            .spawn(move || {
+                if !cpus.is_empty() {
+                    affinity::pin_or_warn(&cpus);
+                }
+                driver.runtime.block_on(stop.notified());
+            })
+            .map_err(|e| {
+                PluginError::RuntimeError(format!("Failed to start runtime thread: {}", e))
+            })?;
+
+        Ok(core)
+    }
+
+    /// Get the process-wide runtime for the config's flavor, building it if
+    /// no plugin is using one
+    fn shared(config: &RuntimeConfig) -> PluginResult<Arc<Self>> {
+        let mut slot = Self::shared_slot(config.flavor).lock();
+        if let Some(core) = slot.upgrade() {
+            if !core.config.builds_same_threads(config) {
+                tracing::warn!(
+                    shared_thread_name = %core.config.thread_name,
+                    thread_name = %config.thread_name,
+                    "Reusing the shared runtime; this plugin's thread, affinity and driver settings are ignored"
+                );
+            }
+            return Ok(core);
+        }
+        let core = Self::build(config)?;
+        *slot = Arc::downgrade(&core);
+        Ok(core)
+    }
+
+    fn shared_slot(flavor: RuntimeFlavor) -> &'static Mutex<Weak<Self>> {
+        match flavor {
+            RuntimeFlavor::MultiThread => &SHARED_MULTI_THREAD,
+            RuntimeFlavor::CurrentThread => &SHARED_CURRENT_THREAD,
+        }
+    }
+}
+
+/// Manages the Tokio async runtime for a plugin
+///
+/// Each plugin gets its own shutdown signal even when the underlying Tokio
+/// runtime is shared with other plugins.
+pub struct AsyncRuntime {
+    core: Arc<RuntimeCore>,
+    shutdown_handle: ShutdownHandle,
+    config: RuntimeConfig,
+}
+
+impl AsyncRuntime {
+    /// Create a new async runtime with the given configuration
+    ///
+    /// With `shared` set, the process-wide runtime of the requested flavor is
+    /// reused. It is built from the config of the plugin that starts it, and
+    /// a plugin asking for different threads gets a warning and the existing
+    /// runtime. It shuts down once the last plugin using it is dropped.
+    pub fn new(config: RuntimeConfig) -> PluginResult<Self> {
+        let core = if config.shared {
+            RuntimeCore::shared(&config)?
+        } else {
+            RuntimeCore::build(&config)?
+        };
+
         Ok(Self {
-            runtime: Arc::new(runtime),
+            core,
             shutdown_handle: ShutdownHandle::new(),
             config,
         })
@@ -103,7 +256,15 @@ impl AsyncRuntime {
 
     /// Get a handle to the underlying Tokio runtime
     pub fn handle(&self) -> tokio::runtime::Handle {
-        self.runtime.handle().clone()
+        self.core.runtime.handle().clone()
+    }
+
+    /// Enter the runtime context on the current thread
+    ///
+    /// While the guard is alive, Tokio resources (timers, I/O, `spawn`) can be
+    /// used from futures polled outside `block_on`.
+    pub fn enter(&self) -> tokio::runtime::EnterGuard<'_> {
+        self.core.runtime.enter()
     }
 
     /// Get a shutdown signal that can be used to detect shutdown
@@ -118,7 +279,7 @@ impl AsyncRuntime {
     where
         F: std::future::Future,
     {
-        self.runtime.block_on(future)
+        self.core.runtime.block_on(future)
     }
 
     /// Spawn a task on the runtime
@@ -127,7 +288,7 @@ impl AsyncRuntime {
         F: std::future::Future + Send + 'static,
         F::Output: Send + 'static,
     {
-        self.runtime.spawn(future)
+        self.core.runtime.spawn(future)
     }
 
     /// Spawn a blocking task
@@ -136,7 +297,7 @@ impl AsyncRuntime {
         F: FnOnce() -> R + Send + 'static,
         R: Send + 'static,
     {
-        self.runtime.spawn_blocking(func)
+        self.core.runtime.spawn_blocking(func)
     }
 
     /// Initiate graceful shutdown
@@ -152,7 +313,7 @@ impl AsyncRuntime {
 
         // Give tasks a brief moment to notice the shutdown signal
         // This is enough for cooperative tasks to start cleanup
-        self.runtime.block_on(async {
+        self.core.runtime.block_on(async {
             tokio::time::sleep(std::time::Duration::from_millis(10)).await;
         });
 
@@ -170,6 +331,24 @@ impl Drop for AsyncRuntime {
     fn drop(&mut self) {
         // Ensure shutdown is triggered when runtime is dropped
         self.shutdown_handle.trigger();
+
+        // The current-thread driver holds its own reference, so it is
+        // released once no plugin uses the runtime; multi-thread runtimes
+        // shut down when the last reference goes
+        let Some(stop) = &self.core.driver_stop else {
+            return;
+        };
+        if !self.config.shared {
+            stop.notify_one();
+            return;
+        }
+        // Held so no plugin picks the runtime up while it is released
+        let mut slot = RuntimeCore::shared_slot(self.config.flavor).lock();
+        // Only this plugin and the driver thread left
+        if Arc::strong_count(&self.core) == 2 {
+            *slot = Weak::new();
+            stop.notify_one();
+        }
     }
 }
 
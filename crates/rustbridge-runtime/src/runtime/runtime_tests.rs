@@ -1,6 +1,24 @@
 #![allow(non_snake_case)]
 
 use super::*;
+use std::sync::mpsc;
+use std::time::{Duration, Instant};
+
+/// CPUs the calling thread may run on
+#[cfg(target_os = "linux")]
+fn current_affinity() -> Vec<usize> {
+    // SAFETY: an all-zero cpu_set_t is valid and pid 0 targets the calling thread
+    unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        assert_eq!(
+            libc::sched_getaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &mut set),
+            0
+        );
+        (0..libc::CPU_SETSIZE as usize)
+            .filter(|&cpu| libc::CPU_ISSET(cpu, &set))
+            .collect()
+    }
+}
 
 // RuntimeConfig tests
 
@@ -13,6 +31,9 @@ fn RuntimeConfig___default___has_expected_values() {
     assert!(config.enable_io);
     assert!(config.enable_time);
     assert_eq!(config.max_blocking_threads, 512);
+    assert_eq!(config.flavor, RuntimeFlavor::MultiThread);
+    assert!(!config.shared);
+    assert!(config.cpu_affinity.is_empty());
 }
 
 #[test]
@@ -104,6 +125,134 @@ fn AsyncRuntime___is_shutting_down___initially_false() {
     assert!(!runtime.is_shutting_down());
 }
 
+#[test]
+fn AsyncRuntime___current_thread___runs_spawned_tasks_without_block_on() {
+    let runtime =
+        AsyncRuntime::new(RuntimeConfig::new().with_flavor(RuntimeFlavor::CurrentThread)).unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    runtime.spawn(async move {
+        tokio::time::sleep(Duration::from_millis(1)).await;
+        tx.send(std::thread::current().name().map(str::to_string))
+            .unwrap();
+    });
+
+    let thread_name = rx.recv_timeout(Duration::from_secs(5)).unwrap();
+    assert_eq!(thread_name.as_deref(), Some("rustbridge-worker"));
+}
+
+#[test]
+fn AsyncRuntime___current_thread___block_on_awaits_spawned_task() {
+    let runtime =
+        AsyncRuntime::new(RuntimeConfig::new().with_flavor(RuntimeFlavor::CurrentThread)).unwrap();
+
+    let handle = runtime.spawn(async { 7 });
+    let result = runtime.block_on(handle).unwrap();
+
+    assert_eq!(result, 7);
+}
+
+#[test]
+fn AsyncRuntime___current_thread_drop___releases_driver_thread() {
+    let runtime =
+        AsyncRuntime::new(RuntimeConfig::new().with_flavor(RuntimeFlavor::CurrentThread)).unwrap();
+    let core = Arc::clone(&runtime.core);
+
+    drop(runtime);
+
+    let deadline = Instant::now() + Duration::from_secs(5);
+    while Arc::strong_count(&core) > 1 {
+        assert!(Instant::now() < deadline, "driver thread still running");
+        std::thread::sleep(Duration::from_millis(1));
+    }
+}
+
+#[test]
+fn AsyncRuntime___shared___reuses_process_runtime() {
+    let a = AsyncRuntime::new(RuntimeConfig::new().with_shared(true)).unwrap();
+    let b = AsyncRuntime::new(RuntimeConfig::new().with_shared(true)).unwrap();
+    let dedicated = AsyncRuntime::with_defaults().unwrap();
+
+    assert!(Arc::ptr_eq(&a.core, &b.core));
+    assert!(!Arc::ptr_eq(&a.core, &dedicated.core));
+}
+
+#[test]
+fn AsyncRuntime___shared_shutdown___leaves_other_plugins_running() {
+    let a = AsyncRuntime::new(RuntimeConfig::new().with_shared(true)).unwrap();
+    let b = AsyncRuntime::new(RuntimeConfig::new().with_shared(true)).unwrap();
+
+    a.shutdown(Duration::from_millis(10)).unwrap();
+    drop(a);
+    let result = b.block_on(b.spawn(async { 5 })).unwrap();
+
+    assert!(!b.is_shutting_down());
+    assert_eq!(result, 5);
+}
+
+#[test]
+fn AsyncRuntime___last_shared_user_dropped___releases_runtime() {
+    let config = RuntimeConfig::new()
+        .with_flavor(RuntimeFlavor::CurrentThread)
+        .with_shared(true);
+    let a = AsyncRuntime::new(config.clone()).unwrap();
+    let b = AsyncRuntime::new(config).unwrap();
+    let core = Arc::downgrade(&a.core);
+
+    drop(a);
+    let result = b.block_on(b.spawn(async { 5 })).unwrap();
+    drop(b);
+
+    assert_eq!(result, 5);
+    let deadline = Instant::now() + Duration::from_secs(5);
+    while core.upgrade().is_some() {
+        assert!(Instant::now() < deadline, "shared runtime still alive");
+        std::thread::sleep(Duration::from_millis(1));
+    }
+}
+
+#[test]
+fn AsyncRuntime___unknown_numa_node___returns_config_error() {
+    let result = AsyncRuntime::new(RuntimeConfig::new().with_numa_node(usize::MAX));
+
+    assert!(matches!(result, Err(PluginError::ConfigError(_))));
+}
+
+#[cfg(target_os = "linux")]
+#[test]
+fn AsyncRuntime___cpu_affinity___pins_runtime_threads() {
+    let cpu = current_affinity()[0];
+    let runtime = AsyncRuntime::new(
+        RuntimeConfig::new()
+            .with_worker_threads(2)
+            .with_cpu_affinity([cpu]),
+    )
+    .unwrap();
+
+    let worker = runtime.block_on(runtime.spawn(async { current_affinity() }));
+    let blocking = runtime.block_on(runtime.spawn_blocking(current_affinity));
+
+    assert_eq!(worker.unwrap(), vec![cpu]);
+    assert_eq!(blocking.unwrap(), vec![cpu]);
+}
+
+#[cfg(target_os = "linux")]
+#[test]
+fn AsyncRuntime___current_thread_cpu_affinity___pins_driver_thread() {
+    let cpu = current_affinity()[0];
+    let runtime = AsyncRuntime::new(
+        RuntimeConfig::new()
+            .with_flavor(RuntimeFlavor::CurrentThread)
+            .with_cpu_affinity([cpu]),
+    )
+    .unwrap();
+    let (tx, rx) = mpsc::channel();
+
+    runtime.spawn(async move { tx.send(current_affinity()).unwrap() });
+
+    assert_eq!(rx.recv_timeout(Duration::from_secs(5)).unwrap(), vec![cpu]);
+}
+
 // RuntimeHolder tests
 
 #[test]
@@ -7,13 +7,26 @@
 //! # What We're Measuring
 //!
 //! 1. **JSON path**: serialize request → deserialize → process → serialize response → deserialize
-//! 2. **Binary path**: copy struct → process → copy struct
+//! 2. **MessagePack / flat paths**: the same cycle through the codecs that
+//!    `plugin_call_as` negotiates
+//! 3. **Flat view path**: the plugin reads request fields in place with
+//!    `FlatView` instead of decoding
+//! 4. **Binary path**: copy struct → process → copy struct
 //!
 //! The binary path avoids all serialization overhead but requires fixed-size buffers.
 
 use criterion::{Criterion, black_box, criterion_group, criterion_main};
+use rustbridge_core::ContentType;
+use rustbridge_transport::{FlatView, decode_as, encode_as};
 use serde::{Deserialize, Serialize};
 
+/// Codecs compared against the C struct path
+const CODECS: [(&str, ContentType); 3] = [
+    ("json", ContentType::Json),
+    ("msgpack", ContentType::MsgPack),
+    ("flat", ContentType::Flat),
+];
+
 // ============================================================================
 // JSON Message Types
 // ============================================================================
@@ -155,6 +168,39 @@ fn bench_json_roundtrip(c: &mut Criterion) {
         })
     });
 
+    // Negotiated codecs: the same cycle as json_full_cycle
+    for (name, content_type) in CODECS.into_iter().skip(1) {
+        group.bench_function(format!("{name}_full_cycle"), |b| {
+            b.iter(|| {
+                let req_bytes = encode_as(content_type, black_box(&json_request)).unwrap();
+                let req: SmallRequestJson = decode_as(content_type, black_box(&req_bytes)).unwrap();
+                let resp = process_request_json(&req);
+                let resp_bytes = encode_as(content_type, black_box(&resp)).unwrap();
+                let _: SmallResponseJson = decode_as(content_type, black_box(&resp_bytes)).unwrap();
+            })
+        });
+    }
+
+    // Flat: the plugin reads the request in place instead of decoding it
+    group.bench_function("flat_view_cycle", |b| {
+        b.iter(|| {
+            let req_bytes = encode_as(ContentType::Flat, black_box(&json_request)).unwrap();
+
+            let view = FlatView::new(black_box(&req_bytes)).unwrap();
+            let key = view.get(0).and_then(|v| v.as_str()).unwrap();
+            let flags = view.get(1).and_then(|v| v.as_u64()).unwrap();
+            let resp = SmallResponseJson {
+                value: format!("value_for_{}", key),
+                ttl_seconds: 3600,
+                cache_hit: flags & 1 != 0,
+            };
+
+            let resp_bytes = encode_as(ContentType::Flat, black_box(&resp)).unwrap();
+            let _: SmallResponseJson =
+                decode_as(ContentType::Flat, black_box(&resp_bytes)).unwrap();
+        })
+    });
+
     // Binary: Full roundtrip (copy struct → process → copy struct)
     group.bench_function("binary_full_cycle", |b| {
         b.iter(|| {
@@ -221,6 +267,15 @@ fn bench_serialization_only(c: &mut Criterion) {
         b.iter(|| serde_json::to_vec(black_box(&json_response)).unwrap())
     });
 
+    for (name, content_type) in CODECS.into_iter().skip(1) {
+        group.bench_function(format!("{name}_serialize_request"), |b| {
+            b.iter(|| encode_as(content_type, black_box(&json_request)).unwrap())
+        });
+        group.bench_function(format!("{name}_serialize_response"), |b| {
+            b.iter(|| encode_as(content_type, black_box(&json_response)).unwrap())
+        });
+    }
+
     // Binary "serialize" request (memcpy)
     group.bench_function("binary_serialize_request", |b| {
         b.iter(|| {
@@ -274,6 +329,28 @@ fn bench_deserialization_only(c: &mut Criterion) {
         b.iter(|| serde_json::from_slice::<SmallResponseJson>(black_box(&json_resp_bytes)).unwrap())
     });
 
+    for (name, content_type) in CODECS.into_iter().skip(1) {
+        let req_bytes = encode_as(content_type, &json_request).unwrap();
+        let resp_bytes = encode_as(content_type, &json_response).unwrap();
+        group.bench_function(format!("{name}_deserialize_request"), |b| {
+            b.iter(|| decode_as::<SmallRequestJson>(content_type, black_box(&req_bytes)).unwrap())
+        });
+        group.bench_function(format!("{name}_deserialize_response"), |b| {
+            b.iter(|| decode_as::<SmallResponseJson>(content_type, black_box(&resp_bytes)).unwrap())
+        });
+    }
+
+    // Flat "deserialize" request: open a view and read both fields in place
+    let flat_req_bytes = encode_as(ContentType::Flat, &json_request).unwrap();
+    group.bench_function("flat_view_request", |b| {
+        b.iter(|| {
+            let view = FlatView::new(black_box(&flat_req_bytes)).unwrap();
+            let key = view.get(0).and_then(|v| v.as_str());
+            let flags = view.get(1).and_then(|v| v.as_u64());
+            black_box((key, flags))
+        })
+    });
+
     // Binary "deserialize" request (pointer cast)
     group.bench_function("binary_deserialize_request", |b| {
         b.iter(|| {
@@ -310,6 +387,14 @@ fn bench_payload_sizes(c: &mut Criterion) {
 
     println!("\n=== Payload Size Comparison ===");
     println!("JSON request:    {} bytes", json_req_bytes.len());
+    for (name, content_type) in CODECS.into_iter().skip(1) {
+        println!(
+            "{:<16} {} bytes request, {} bytes response",
+            format!("{name}:"),
+            encode_as(content_type, &json_request).unwrap().len(),
+            encode_as(content_type, &json_response).unwrap().len()
+        );
+    }
     println!(
         "Binary request:  {} bytes",
         std::mem::size_of::<SmallRequestRaw>()
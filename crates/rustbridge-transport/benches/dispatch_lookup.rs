@@ -0,0 +1,107 @@
+//! Binary Handler Lookup Benchmarks
+//!
+//! Compares the handler lookup done on every `plugin_call_raw`:
+//!
+//! 1. **DashMap**: the previous process-global `DashMap<u32, fn>` registry,
+//!    which hashes the ID and takes a shard read lock per lookup
+//! 2. **Dense table**: a frozen [`DispatchTable`] with small IDs, which is a
+//!    bounds check plus an indexed load
+//! 3. **Sorted table**: a frozen [`DispatchTable`] with IDs above
+//!    [`DENSE_ID_LIMIT`], which falls back to binary search
+//!
+//! Each iteration looks up a cycle of registered IDs so the branch predictor
+//! cannot settle on a single entry.
+
+use criterion::{BenchmarkId, Criterion, black_box, criterion_group, criterion_main};
+use dashmap::DashMap;
+use rustbridge_transport::{DENSE_ID_LIMIT, DispatchTable};
+
+type Handler = fn(&[u8]) -> usize;
+
+fn handler_len(request: &[u8]) -> usize {
+    request.len()
+}
+
+/// Registered message IDs for a plugin with `count` handlers
+fn dense_ids(count: u32) -> Vec<u32> {
+    (1..=count).collect()
+}
+
+/// The same number of IDs, spread above the dense limit
+fn sparse_ids(count: u32) -> Vec<u32> {
+    (1..=count).map(|i| DENSE_ID_LIMIT + i * 97).collect()
+}
+
+fn bench_lookup(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dispatch_lookup");
+
+    for count in [4u32, 32, 256] {
+        let ids = dense_ids(count);
+
+        let map: DashMap<u32, Handler> = DashMap::new();
+        for id in &ids {
+            map.insert(*id, handler_len as Handler);
+        }
+        group.bench_with_input(BenchmarkId::new("dashmap", count), &ids, |b, ids| {
+            b.iter(|| {
+                for id in ids {
+                    black_box(map.get(black_box(id)).map(|r| *r));
+                }
+            })
+        });
+
+        let dense = DispatchTable::from_entries(ids.iter().map(|id| (*id, handler_len as Handler)));
+        group.bench_with_input(BenchmarkId::new("dense_table", count), &ids, |b, ids| {
+            b.iter(|| {
+                for id in ids {
+                    black_box(dense.get(black_box(*id)));
+                }
+            })
+        });
+
+        let sparse = sparse_ids(count);
+        let sorted =
+            DispatchTable::from_entries(sparse.iter().map(|id| (*id, handler_len as Handler)));
+        group.bench_with_input(
+            BenchmarkId::new("sorted_table", count),
+            &sparse,
+            |b, ids| {
+                b.iter(|| {
+                    for id in ids {
+                        black_box(sorted.get(black_box(*id)));
+                    }
+                })
+            },
+        );
+    }
+
+    group.finish();
+}
+
+fn bench_lookup_and_call(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dispatch_lookup_and_call");
+    let request = [0u8; 72];
+
+    let map: DashMap<u32, Handler> = DashMap::new();
+    map.insert(1, handler_len as Handler);
+    group.bench_function("dashmap", |b| {
+        b.iter(|| {
+            let handler = map.get(black_box(&1)).map(|r| *r);
+            handler.map(|h| h(black_box(&request)))
+        })
+    });
+
+    let table = DispatchTable::from_entries([(1, handler_len as Handler)]);
+    group.bench_function("dense_table", |b| {
+        b.iter(|| {
+            let handler = table.get(black_box(1));
+            handler.map(|h| h(black_box(&request)))
+        })
+    });
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_lookup, bench_lookup_and_call);
+
+criterion_main!(benches);
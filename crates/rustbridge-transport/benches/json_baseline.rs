@@ -9,8 +9,14 @@
 //! - **Small**: ~100 bytes (config lookup, feature flags)
 //! - **Medium**: ~1KB (user records, API entities)
 //! - **Large**: ~100KB (batch queries, data exports)
+//!
+//! The `codec_comparison` group repeats the response encode/decode for the
+//! MessagePack and flat codecs, and times reading one record out of a flat
+//! payload in place (`flat_view`), which is what a zero-copy consumer pays.
 
 use criterion::{BenchmarkId, Criterion, Throughput, black_box, criterion_group, criterion_main};
+use rustbridge_core::{ContentType, ResponseEncoding};
+use rustbridge_transport::{FlatView, ResponseEnvelope, decode_as, encode_as};
 use serde::{Deserialize, Serialize};
 
 // ============================================================================
@@ -494,12 +500,137 @@ fn bench_full_cycle(c: &mut Criterion) {
     group.finish();
 }
 
+/// Benchmark wrapping handler JSON in the response envelope (`plugin_call` response path)
+///
+/// Compares the previous parse + re-encode path against splicing the raw
+/// payload bytes into the envelope.
+fn bench_response_envelope(c: &mut Criterion) {
+    let mut group = c.benchmark_group("response_envelope");
+
+    let payloads = [
+        (
+            "small",
+            serde_json::to_vec(&create_small_response()).unwrap(),
+        ),
+        (
+            "medium",
+            serde_json::to_vec(&create_medium_response()).unwrap(),
+        ),
+        (
+            "large",
+            serde_json::to_vec(&create_large_response(1000)).unwrap(),
+        ),
+    ];
+
+    for (name, payload) in &payloads {
+        group.throughput(Throughput::Bytes(payload.len() as u64));
+
+        group.bench_with_input(BenchmarkId::new("reencode", name), payload, |b, payload| {
+            b.iter(|| {
+                ResponseEnvelope::encode_success_with(
+                    black_box(payload),
+                    ResponseEncoding::Reencode,
+                )
+                .unwrap()
+            })
+        });
+
+        group.bench_with_input(BenchmarkId::new("splice", name), payload, |b, payload| {
+            b.iter(|| {
+                ResponseEnvelope::encode_success_with(black_box(payload), ResponseEncoding::Splice)
+                    .unwrap()
+            })
+        });
+    }
+
+    group.finish();
+}
+
+/// Benchmark the negotiated codecs against JSON on the same responses
+fn bench_codec_comparison(c: &mut Criterion) {
+    let mut group = c.benchmark_group("codec_comparison");
+
+    let codecs = [
+        ("json", ContentType::Json),
+        ("msgpack", ContentType::MsgPack),
+        ("flat", ContentType::Flat),
+    ];
+    let small = create_small_response();
+    let medium = create_medium_response();
+    let large = create_large_response(1000);
+
+    for (codec, content_type) in codecs {
+        println!(
+            "{codec} response sizes: small={} medium={} large={} bytes",
+            encode_as(content_type, &small).unwrap().len(),
+            encode_as(content_type, &medium).unwrap().len(),
+            encode_as(content_type, &large).unwrap().len()
+        );
+
+        let small_bytes = encode_as(content_type, &small).unwrap();
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_serialize"), "small"),
+            |b| b.iter(|| encode_as(content_type, black_box(&small)).unwrap()),
+        );
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_deserialize"), "small"),
+            |b| {
+                b.iter(|| {
+                    decode_as::<SmallResponse>(content_type, black_box(&small_bytes)).unwrap()
+                })
+            },
+        );
+
+        let medium_bytes = encode_as(content_type, &medium).unwrap();
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_serialize"), "medium"),
+            |b| b.iter(|| encode_as(content_type, black_box(&medium)).unwrap()),
+        );
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_deserialize"), "medium"),
+            |b| {
+                b.iter(|| {
+                    decode_as::<MediumResponse>(content_type, black_box(&medium_bytes)).unwrap()
+                })
+            },
+        );
+
+        let large_bytes = encode_as(content_type, &large).unwrap();
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_serialize"), "large"),
+            |b| b.iter(|| encode_as(content_type, black_box(&large)).unwrap()),
+        );
+        group.bench_function(
+            BenchmarkId::new(format!("{codec}_deserialize"), "large"),
+            |b| {
+                b.iter(|| {
+                    decode_as::<LargeResponse>(content_type, black_box(&large_bytes)).unwrap()
+                })
+            },
+        );
+    }
+
+    // Fetch the name of record 500 without decoding the other 999
+    let large_flat = encode_as(ContentType::Flat, &large).unwrap();
+    group.bench_function(BenchmarkId::new("flat_view", "large_one_record"), |b| {
+        b.iter(|| {
+            let view = FlatView::new(black_box(&large_flat)).unwrap();
+            let record = view.get(1).and_then(|results| results.get(500)).unwrap();
+            black_box(record.get(1).and_then(|name| name.as_str()).unwrap())
+        })
+    });
+
+    group.finish();
+}
+
 criterion_group!(
     benches,
     bench_small_payload,
     bench_medium_payload,
     bench_large_payload,
     bench_full_cycle,
+    bench_response_envelope,
+    bench_codec_comparison,
 );
 
 criterion_main!(benches);
@@ -1,7 +1,7 @@
-//! Codec trait and JSON implementation
+//! Codec trait, JSON implementation, and content-type dispatch
 
-use rustbridge_core::PluginError;
-use serde::{Serialize, de::DeserializeOwned};
+use rustbridge_core::{ContentType, PluginError};
+use serde::{Deserialize, Serialize, de::DeserializeOwned};
 use thiserror::Error;
 
 /// Errors that can occur during encoding/decoding
@@ -27,6 +27,18 @@ impl From<serde_json::Error> for CodecError {
     }
 }
 
+impl serde::ser::Error for CodecError {
+    fn custom<T: std::fmt::Display>(msg: T) -> Self {
+        CodecError::Serialization(msg.to_string())
+    }
+}
+
+impl serde::de::Error for CodecError {
+    fn custom<T: std::fmt::Display>(msg: T) -> Self {
+        CodecError::Deserialization(msg.to_string())
+    }
+}
+
 impl From<CodecError> for PluginError {
     fn from(err: CodecError) -> Self {
         PluginError::SerializationError(err.to_string())
@@ -96,6 +108,32 @@ impl Codec for JsonCodec {
     }
 }
 
+/// Encode a value with the codec selected by `content_type`
+pub fn encode_as<T: Serialize + ?Sized>(
+    content_type: ContentType,
+    value: &T,
+) -> Result<Vec<u8>, CodecError> {
+    match content_type {
+        ContentType::Json => serde_json::to_vec(value).map_err(Into::into),
+        ContentType::MsgPack => crate::msgpack::to_vec(value),
+        ContentType::Flat => crate::flat::to_vec(value),
+    }
+}
+
+/// Decode a value with the codec selected by `content_type`
+///
+/// Strings and byte arrays in `T` may borrow from `data`.
+pub fn decode_as<'de, T: Deserialize<'de>>(
+    content_type: ContentType,
+    data: &'de [u8],
+) -> Result<T, CodecError> {
+    match content_type {
+        ContentType::Json => serde_json::from_slice(data).map_err(Into::into),
+        ContentType::MsgPack => crate::msgpack::from_slice(data),
+        ContentType::Flat => crate::flat::from_slice(data),
+    }
+}
+
 #[cfg(test)]
 #[path = "codec/codec_tests.rs"]
 mod codec_tests;
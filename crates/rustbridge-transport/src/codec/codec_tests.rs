@@ -122,3 +122,32 @@ fn CodecError___into_plugin_error___converts_correctly() {
         rustbridge_core::PluginError::SerializationError(_)
     ));
 }
+
+// Content-type dispatch tests
+
+#[test]
+fn encode_as___each_content_type___roundtrips_through_decode_as() {
+    let original = TestMessage {
+        id: 7,
+        name: "dispatch".to_string(),
+    };
+
+    for content_type in [ContentType::Json, ContentType::MsgPack, ContentType::Flat] {
+        let encoded = encode_as(content_type, &original).unwrap();
+        let decoded: TestMessage = decode_as(content_type, &encoded).unwrap();
+
+        assert_eq!(decoded, original, "{content_type:?}");
+    }
+}
+
+#[test]
+fn encode_as___json___matches_json_codec() {
+    let msg = TestMessage {
+        id: 1,
+        name: "same".to_string(),
+    };
+
+    let dispatched = encode_as(ContentType::Json, &msg).unwrap();
+
+    assert_eq!(dispatched, JsonCodec::new().encode(&msg).unwrap());
+}
@@ -0,0 +1,179 @@
+//! Immutable dispatch tables keyed by numeric message ID or type tag
+
+/// Highest message ID stored in a dense table
+///
+/// Tables whose IDs all fall below this are a flat array indexed by ID;
+/// anything larger uses a sorted array searched by binary search.
+pub const DENSE_ID_LIMIT: u32 = 4096;
+
+/// Immutable lookup table from message ID to handler
+///
+/// Built once from a set of registrations and never modified afterwards, so
+/// lookups take no locks and do no hashing. With small IDs a lookup is a
+/// bounds check plus an indexed load.
+#[derive(Debug, Clone)]
+pub struct DispatchTable<T> {
+    entries: Entries<T>,
+    len: usize,
+}
+
+#[derive(Debug, Clone)]
+enum Entries<T> {
+    /// Indexed directly by message ID
+    Dense(Box<[Option<T>]>),
+    /// Sorted by message ID
+    Sorted(Box<[(u32, T)]>),
+}
+
+impl<T: Copy> DispatchTable<T> {
+    /// Create a table with no entries
+    pub fn empty() -> Self {
+        Self {
+            entries: Entries::Dense(Box::default()),
+            len: 0,
+        }
+    }
+
+    /// Build a table from `(message_id, handler)` pairs
+    ///
+    /// If an ID appears more than once, the last handler wins.
+    pub fn from_entries(entries: impl IntoIterator<Item = (u32, T)>) -> Self {
+        let mut sorted: Vec<(u32, T)> = entries.into_iter().collect();
+        // Stable sort keeps registration order within an ID
+        sorted.sort_by_key(|(id, _)| *id);
+        let mut deduped: Vec<(u32, T)> = Vec::with_capacity(sorted.len());
+        for (id, value) in sorted {
+            match deduped.last_mut() {
+                Some(last) if last.0 == id => last.1 = value,
+                _ => deduped.push((id, value)),
+            }
+        }
+
+        let len = deduped.len();
+        let max_id = deduped.last().map(|(id, _)| *id);
+        let entries = match max_id {
+            Some(max_id) if max_id >= DENSE_ID_LIMIT => Entries::Sorted(deduped.into_boxed_slice()),
+            Some(max_id) => {
+                let mut dense = vec![None; max_id as usize + 1];
+                for (id, value) in deduped {
+                    dense[id as usize] = Some(value);
+                }
+                Entries::Dense(dense.into_boxed_slice())
+            }
+            None => Entries::Dense(Box::default()),
+        };
+
+        Self { entries, len }
+    }
+
+    /// Look up the handler for a message ID
+    #[inline]
+    pub fn get(&self, message_id: u32) -> Option<T> {
+        match &self.entries {
+            Entries::Dense(dense) => dense.get(message_id as usize).copied().flatten(),
+            Entries::Sorted(sorted) => sorted
+                .binary_search_by_key(&message_id, |(id, _)| *id)
+                .ok()
+                .map(|i| sorted[i].1),
+        }
+    }
+
+    /// Number of registered message IDs
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Check if the table has no entries
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Check if lookups index a dense array directly
+    pub fn is_dense(&self) -> bool {
+        matches!(self.entries, Entries::Dense(_))
+    }
+
+    /// Registered message IDs in ascending order
+    pub fn message_ids(&self) -> Vec<u32> {
+        match &self.entries {
+            Entries::Dense(dense) => (0..)
+                .zip(dense.iter())
+                .filter(|(_, entry)| entry.is_some())
+                .map(|(id, _)| id)
+                .collect(),
+            Entries::Sorted(sorted) => sorted.iter().map(|(id, _)| *id).collect(),
+        }
+    }
+}
+
+impl<T: Copy> Default for DispatchTable<T> {
+    fn default() -> Self {
+        Self::empty()
+    }
+}
+
+/// Hash a type tag for a [`TagTable`] built with `seed`
+///
+/// FNV-1a with the seed folded into the offset basis. `#[rustbridge_plugin]`
+/// evaluates the same function at compile time while searching for a seed
+/// that gives every tag of a plugin its own slot, so the two must not drift.
+#[inline]
+pub const fn tag_hash(seed: u64, tag: &[u8]) -> u64 {
+    let mut hash = 0xcbf2_9ce4_8422_2325 ^ seed;
+    let mut i = 0;
+    while i < tag.len() {
+        hash ^= tag[i] as u64;
+        hash = hash.wrapping_mul(0x0000_0100_0000_01b3);
+        i += 1;
+    }
+    hash ^ (hash >> 32)
+}
+
+/// Perfect hash table from type tag to handler index
+///
+/// Generated by `#[rustbridge_plugin]` for each plugin's JSON handlers. The
+/// seed is chosen at compile time so that no two tags share a slot, so a
+/// lookup hashes the tag once and compares it against a single candidate
+/// instead of walking a chain of string comparisons.
+#[derive(Debug, Clone, Copy)]
+pub struct TagTable {
+    seed: u64,
+    /// One entry per slot; the length is a power of two
+    slots: &'static [Option<(&'static str, u16)>],
+}
+
+impl TagTable {
+    /// Create a table from a seed and its collision-free slots
+    ///
+    /// `slots.len()` must be a power of two and each tag must sit in the slot
+    /// `tag_hash(seed, tag)` selects. Generated code is the only intended
+    /// caller.
+    #[doc(hidden)]
+    pub const fn new(seed: u64, slots: &'static [Option<(&'static str, u16)>]) -> Self {
+        Self { seed, slots }
+    }
+
+    /// Look up the handler index for a type tag
+    #[inline]
+    pub fn get(&self, tag: &str) -> Option<u16> {
+        if self.slots.is_empty() {
+            return None;
+        }
+        let slot = tag_hash(self.seed, tag.as_bytes()) as usize & (self.slots.len() - 1);
+        match self.slots[slot] {
+            Some((candidate, index)) if candidate == tag => Some(index),
+            _ => None,
+        }
+    }
+
+    /// Type tags in the table, in slot order
+    pub fn tags(&self) -> impl Iterator<Item = &'static str> {
+        self.slots
+            .iter()
+            .filter_map(|slot| slot.map(|(tag, _)| tag))
+    }
+}
+
+#[cfg(test)]
+#[path = "dispatch/dispatch_tests.rs"]
+mod dispatch_tests;
@@ -0,0 +1,129 @@
+#![allow(non_snake_case)]
+
+use super::*;
+
+// DispatchTable tests
+
+#[test]
+fn DispatchTable___empty___finds_nothing() {
+    let table: DispatchTable<u8> = DispatchTable::empty();
+
+    assert!(table.is_empty());
+    assert_eq!(table.get(0), None);
+    assert_eq!(table.get(u32::MAX), None);
+}
+
+#[test]
+fn DispatchTable___small_ids___uses_dense_lookup() {
+    let table = DispatchTable::from_entries([(1, 'a'), (3, 'c'), (7, 'g')]);
+
+    assert!(table.is_dense());
+    assert_eq!(table.len(), 3);
+    assert_eq!(table.get(1), Some('a'));
+    assert_eq!(table.get(3), Some('c'));
+    assert_eq!(table.get(7), Some('g'));
+    assert_eq!(table.get(2), None);
+    assert_eq!(table.get(8), None);
+}
+
+#[test]
+fn DispatchTable___large_id___uses_sorted_lookup() {
+    let table = DispatchTable::from_entries([(0x7201, 'a'), (5, 'b'), (DENSE_ID_LIMIT, 'c')]);
+
+    assert!(!table.is_dense());
+    assert_eq!(table.len(), 3);
+    assert_eq!(table.get(0x7201), Some('a'));
+    assert_eq!(table.get(5), Some('b'));
+    assert_eq!(table.get(DENSE_ID_LIMIT), Some('c'));
+    assert_eq!(table.get(6), None);
+}
+
+#[test]
+fn DispatchTable___duplicate_id___last_entry_wins() {
+    let table = DispatchTable::from_entries([(2, 'x'), (9, 'z'), (2, 'y')]);
+
+    assert_eq!(table.len(), 2);
+    assert_eq!(table.get(2), Some('y'));
+}
+
+#[test]
+fn DispatchTable___id_below_limit___stays_dense() {
+    let table = DispatchTable::from_entries([(DENSE_ID_LIMIT - 1, 1u8)]);
+
+    assert!(table.is_dense());
+    assert_eq!(table.get(DENSE_ID_LIMIT - 1), Some(1));
+}
+
+#[test]
+fn DispatchTable___message_ids___lists_ids_in_order() {
+    let dense = DispatchTable::from_entries([(7, 'g'), (1, 'a'), (3, 'c')]);
+    let sorted = DispatchTable::from_entries([(0x7201, 'a'), (5, 'b')]);
+
+    assert_eq!(dense.message_ids(), vec![1, 3, 7]);
+    assert_eq!(sorted.message_ids(), vec![5, 0x7201]);
+}
+
+// TagTable tests
+
+/// Build a table the way `#[rustbridge_plugin]` does, searching for a seed
+fn tag_table(tags: &[&'static str]) -> TagTable {
+    let size = tags.len().next_power_of_two();
+    let seed = (0..)
+        .find(|&seed| {
+            let mut used = vec![false; size];
+            tags.iter().all(|tag| {
+                let slot = tag_hash(seed, tag.as_bytes()) as usize & (size - 1);
+                !std::mem::replace(&mut used[slot], true)
+            })
+        })
+        .unwrap();
+    let mut slots = vec![None; size];
+    for (index, tag) in tags.iter().enumerate() {
+        slots[tag_hash(seed, tag.as_bytes()) as usize & (size - 1)] = Some((*tag, index as u16));
+    }
+    TagTable::new(seed, Box::leak(slots.into_boxed_slice()))
+}
+
+#[test]
+fn TagTable___known_tags___map_to_their_index() {
+    let table = tag_table(&["echo", "greet", "user.create", "math.add", "test.sleep"]);
+
+    assert_eq!(table.get("echo"), Some(0));
+    assert_eq!(table.get("greet"), Some(1));
+    assert_eq!(table.get("user.create"), Some(2));
+    assert_eq!(table.get("math.add"), Some(3));
+    assert_eq!(table.get("test.sleep"), Some(4));
+}
+
+#[test]
+fn TagTable___unknown_tag___finds_nothing() {
+    let table = tag_table(&["echo", "greet"]);
+
+    assert_eq!(table.get("ech"), None);
+    assert_eq!(table.get("greeting"), None);
+    assert_eq!(table.get(""), None);
+}
+
+#[test]
+fn TagTable___no_slots___finds_nothing() {
+    let table = TagTable::new(0, &[]);
+
+    assert_eq!(table.get("echo"), None);
+    assert_eq!(table.tags().count(), 0);
+}
+
+#[test]
+fn TagTable___tags___lists_every_tag() {
+    let table = tag_table(&["a", "b", "c"]);
+
+    let mut tags: Vec<_> = table.tags().collect();
+    tags.sort_unstable();
+
+    assert_eq!(tags, ["a", "b", "c"]);
+}
+
+#[test]
+fn tag_hash___seed___changes_hash() {
+    assert_ne!(tag_hash(0, b"echo"), tag_hash(1, b"echo"));
+    assert_eq!(tag_hash(7, b"echo"), tag_hash(7, b"echo"));
+}
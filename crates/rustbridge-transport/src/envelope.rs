@@ -1,7 +1,15 @@
 //! Request and response envelope types for FFI transport
 
+use crate::codec::{CodecError, decode_as, encode_as};
+use rustbridge_core::{ContentType, ResponseEncoding};
 use serde::{Deserialize, Serialize, de::DeserializeOwned};
 
+/// Bytes written before the payload of a spliced success envelope
+const SUCCESS_PREFIX: &[u8] = br#"{"status":"success","payload":"#;
+
+/// Bytes written after the payload of a spliced success envelope
+const SUCCESS_SUFFIX: &[u8] = b"}";
+
 /// Request envelope wrapping a message for FFI transport
 ///
 /// The type_tag identifies the handler, and payload contains the
@@ -75,6 +83,16 @@ impl RequestEnvelope {
     pub fn from_bytes(data: &[u8]) -> Result<Self, serde_json::Error> {
         serde_json::from_slice(data)
     }
+
+    /// Serialize with the codec for `content_type`
+    pub fn to_bytes_as(&self, content_type: ContentType) -> Result<Vec<u8>, CodecError> {
+        encode_as(content_type, self)
+    }
+
+    /// Deserialize with the codec for `content_type`
+    pub fn from_bytes_as(content_type: ContentType, data: &[u8]) -> Result<Self, CodecError> {
+        decode_as(content_type, data)
+    }
 }
 
 /// Response status indicating success or failure
@@ -133,6 +151,52 @@ impl ResponseEnvelope {
         Ok(Self::success(payload))
     }
 
+    /// Encode a success envelope around raw JSON payload bytes
+    ///
+    /// Writes the envelope prefix and suffix directly around `data` in a single
+    /// pre-sized buffer, avoiding the `Value` round-trip of
+    /// `success_raw(data)?.to_bytes()`. The payload is still validated, so
+    /// invalid JSON is rejected the same way.
+    pub fn encode_success_raw(data: &[u8]) -> Result<Vec<u8>, serde_json::Error> {
+        let mut bytes = Vec::with_capacity(Self::spliced_success_len(data.len()));
+        Self::encode_success_raw_into(data, &mut bytes)?;
+        Ok(bytes)
+    }
+
+    /// Append a spliced success envelope around `data` to `out`
+    ///
+    /// Lets the caller supply a reused buffer; reserving
+    /// [`spliced_success_len`](Self::spliced_success_len) bytes up front
+    /// avoids any reallocation. On error `out` is left unchanged.
+    pub fn encode_success_raw_into(
+        data: &[u8],
+        out: &mut Vec<u8>,
+    ) -> Result<(), serde_json::Error> {
+        serde_json::from_slice::<serde::de::IgnoredAny>(data)?;
+
+        out.reserve(Self::spliced_success_len(data.len()));
+        out.extend_from_slice(SUCCESS_PREFIX);
+        out.extend_from_slice(data);
+        out.extend_from_slice(SUCCESS_SUFFIX);
+        Ok(())
+    }
+
+    /// Length of the spliced success envelope around a payload of `payload_len` bytes
+    pub const fn spliced_success_len(payload_len: usize) -> usize {
+        SUCCESS_PREFIX.len() + payload_len + SUCCESS_SUFFIX.len()
+    }
+
+    /// Encode a success envelope around raw JSON payload bytes using the given strategy
+    pub fn encode_success_with(
+        data: &[u8],
+        encoding: ResponseEncoding,
+    ) -> Result<Vec<u8>, serde_json::Error> {
+        match encoding {
+            ResponseEncoding::Splice => Self::encode_success_raw(data),
+            ResponseEncoding::Reencode => Self::success_raw(data)?.to_bytes(),
+        }
+    }
+
     /// Create an error response
     pub fn error(code: u32, message: impl Into<String>) -> Self {
         Self {
@@ -179,6 +243,16 @@ impl ResponseEnvelope {
     pub fn from_bytes(data: &[u8]) -> Result<Self, serde_json::Error> {
         serde_json::from_slice(data)
     }
+
+    /// Serialize with the codec for `content_type`
+    pub fn to_bytes_as(&self, content_type: ContentType) -> Result<Vec<u8>, CodecError> {
+        encode_as(content_type, self)
+    }
+
+    /// Deserialize with the codec for `content_type`
+    pub fn from_bytes_as(content_type: ContentType, data: &[u8]) -> Result<Self, CodecError> {
+        decode_as(content_type, data)
+    }
 }
 
 impl Default for ResponseEnvelope {
@@ -107,6 +107,94 @@ fn ResponseEnvelope___success_raw___parses_json_bytes() {
     assert_eq!(payload.id, 123);
 }
 
+#[test]
+fn ResponseEnvelope___encode_success_raw___splices_payload_bytes() {
+    let json_bytes = br#"{"id": 123}"#;
+
+    let bytes = ResponseEnvelope::encode_success_raw(json_bytes).unwrap();
+
+    assert_eq!(
+        bytes,
+        br#"{"status":"success","payload":{"id": 123}}"#.to_vec()
+    );
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw_into___fills_presized_buffer_in_place() {
+    let json_bytes = br#"{"id": 123}"#;
+    let mut bytes = Vec::with_capacity(ResponseEnvelope::spliced_success_len(json_bytes.len()));
+    let ptr = bytes.as_ptr();
+
+    ResponseEnvelope::encode_success_raw_into(json_bytes, &mut bytes).unwrap();
+
+    assert_eq!(
+        bytes,
+        ResponseEnvelope::encode_success_raw(json_bytes).unwrap()
+    );
+    assert_eq!(bytes.as_ptr(), ptr);
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw_into___invalid_json_leaves_buffer_unchanged() {
+    let mut bytes = b"kept".to_vec();
+
+    let result = ResponseEnvelope::encode_success_raw_into(br#"{"id": "#, &mut bytes);
+
+    assert!(result.is_err());
+    assert_eq!(bytes, b"kept");
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw___decodes_like_reencoded_envelope() {
+    let json_bytes = br#"{"id": 123, "tags": ["a", "b"], "nested": {"ok": true}}"#;
+
+    let spliced = ResponseEnvelope::encode_success_raw(json_bytes).unwrap();
+    let reencoded = ResponseEnvelope::success_raw(json_bytes)
+        .unwrap()
+        .to_bytes()
+        .unwrap();
+
+    let spliced: serde_json::Value = serde_json::from_slice(&spliced).unwrap();
+    let reencoded: serde_json::Value = serde_json::from_slice(&reencoded).unwrap();
+    assert_eq!(spliced, reencoded);
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw___scalar_payload() {
+    let bytes = ResponseEnvelope::encode_success_raw(b"42").unwrap();
+
+    let decoded = ResponseEnvelope::from_bytes(&bytes).unwrap();
+    assert!(decoded.is_success());
+    assert_eq!(decoded.payload, Some(serde_json::json!(42)));
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw___rejects_invalid_json() {
+    let result = ResponseEnvelope::encode_success_raw(br#"{"id": "#);
+
+    assert!(result.is_err());
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_raw___rejects_trailing_data() {
+    let result = ResponseEnvelope::encode_success_raw(br#"{"id": 1}, "extra": 2"#);
+
+    assert!(result.is_err());
+}
+
+#[test]
+fn ResponseEnvelope___encode_success_with___reencode_normalizes_payload() {
+    let json_bytes = br#"{ "id" : 123 }"#;
+
+    let bytes =
+        ResponseEnvelope::encode_success_with(json_bytes, ResponseEncoding::Reencode).unwrap();
+
+    assert_eq!(
+        bytes,
+        br#"{"status":"success","payload":{"id":123}}"#.to_vec()
+    );
+}
+
 #[test]
 fn ResponseEnvelope___error___creates_error_response() {
     let resp = ResponseEnvelope::error(404, "Not found");
@@ -180,3 +268,30 @@ fn ResponseStatus___error___serializes_to_snake_case() {
 
     assert_eq!(json, r#""error""#);
 }
+
+#[test]
+fn ResponseEnvelope___to_bytes_as___binary_roundtrip_preserves_fields() {
+    let response = ResponseEnvelope::success(serde_json::json!({"id": 5})).with_request_id(9);
+
+    for content_type in [ContentType::MsgPack, ContentType::Flat] {
+        let bytes = response.to_bytes_as(content_type).unwrap();
+        let decoded = ResponseEnvelope::from_bytes_as(content_type, &bytes).unwrap();
+
+        assert!(decoded.is_success());
+        assert_eq!(decoded.request_id, Some(9));
+        assert_eq!(decoded.payload, Some(serde_json::json!({"id": 5})));
+    }
+}
+
+#[test]
+fn RequestEnvelope___to_bytes_as___msgpack_roundtrip_preserves_fields() {
+    let request = RequestEnvelope::new("user.create", serde_json::json!({"name": "John"}))
+        .with_correlation_id("abc");
+
+    let bytes = request.to_bytes_as(ContentType::MsgPack).unwrap();
+    let decoded = RequestEnvelope::from_bytes_as(ContentType::MsgPack, &bytes).unwrap();
+
+    assert_eq!(decoded.type_tag, "user.create");
+    assert_eq!(decoded.correlation_id.as_deref(), Some("abc"));
+    assert_eq!(decoded.payload, request.payload);
+}
@@ -0,0 +1,1052 @@
+//! Flat binary codec with in-place reads
+//!
+//! A FlatBuffers-style layout that a receiver can read without decoding: every
+//! sequence and map carries an offset table, so [`FlatView`] reaches field
+//! `i` of a struct, or element `i` of a list, in constant time, and strings
+//! and byte arrays are borrowed straight out of the buffer. The full serde
+//! decode path through [`FlatCodec`] is still available for handlers that
+//! want owned types.
+//!
+//! # Layout
+//!
+//! All integers are little-endian. Each value starts with a one-byte tag:
+//!
+//! | Tag | Kind    | Body                                                        |
+//! |-----|---------|-------------------------------------------------------------|
+//! | 0   | nil     | -                                                           |
+//! | 1/2 | bool    | - (1 = false, 2 = true)                                     |
+//! | 3   | u64     | 8 bytes                                                     |
+//! | 4   | i64     | 8 bytes                                                     |
+//! | 5   | f64     | 8 bytes                                                     |
+//! | 6   | string  | u32 length, UTF-8 bytes                                     |
+//! | 7   | bytes   | u32 length, bytes                                           |
+//! | 8   | seq     | u32 count, u32 body length, elements, count x u32 offsets   |
+//! | 9   | map     | u32 count, u32 body length, key/value pairs, count x u32 offsets |
+//! | 10  | enum    | u32 variant index, u32 name length, name, content value     |
+//!
+//! Offsets are relative to the start of the body. The table trails the body
+//! so the writer never has to move bytes once they are written; only the
+//! fixed-size count and length fields are patched when a sequence closes.
+//!
+//! Structs are positional sequences in declaration order. Fields skipped by
+//! `skip_serializing_if` are written as nil so that later fields keep their
+//! index. Unit enum variants carry nil content.
+
+use crate::codec::{Codec, CodecError};
+use rustbridge_core::ContentType;
+use serde::de::{
+    self, DeserializeSeed, Deserializer as _, EnumAccess, MapAccess, SeqAccess, VariantAccess,
+    Visitor, value::BorrowedStrDeserializer,
+};
+use serde::ser::{self, Serialize};
+use serde::{Deserialize, de::DeserializeOwned};
+
+const TAG_NIL: u8 = 0;
+const TAG_FALSE: u8 = 1;
+const TAG_TRUE: u8 = 2;
+const TAG_U64: u8 = 3;
+const TAG_I64: u8 = 4;
+const TAG_F64: u8 = 5;
+const TAG_STR: u8 = 6;
+const TAG_BYTES: u8 = 7;
+const TAG_SEQ: u8 = 8;
+const TAG_MAP: u8 = 9;
+const TAG_ENUM: u8 = 10;
+
+/// Tag plus the u32 count and u32 body length of a sequence or map
+const CONTAINER_HEADER_LEN: usize = 9;
+
+/// Nesting depth at which decoding gives up, matching serde_json's limit
+const MAX_DEPTH: usize = 128;
+
+/// Flat binary codec implementation
+#[derive(Debug, Clone, Copy, Default)]
+pub struct FlatCodec;
+
+impl FlatCodec {
+    /// Create a new flat codec
+    pub fn new() -> Self {
+        Self
+    }
+
+    /// Decode a value that borrows strings and bytes from `data`
+    pub fn decode_borrowed<'de, T: Deserialize<'de>>(
+        &self,
+        data: &'de [u8],
+    ) -> Result<T, CodecError> {
+        from_slice(data)
+    }
+
+    /// Open `data` for in-place reads without decoding it
+    pub fn view<'a>(&self, data: &'a [u8]) -> Result<FlatView<'a>, CodecError> {
+        FlatView::new(data)
+    }
+}
+
+impl Codec for FlatCodec {
+    fn encode<T: Serialize>(&self, value: &T) -> Result<Vec<u8>, CodecError> {
+        to_vec(value)
+    }
+
+    fn decode<T: DeserializeOwned>(&self, data: &[u8]) -> Result<T, CodecError> {
+        from_slice(data)
+    }
+
+    fn content_type(&self) -> &'static str {
+        ContentType::Flat.mime()
+    }
+}
+
+/// Serialize a value to the flat format
+pub fn to_vec<T: Serialize + ?Sized>(value: &T) -> Result<Vec<u8>, CodecError> {
+    let mut out = Vec::with_capacity(128);
+    value.serialize(&mut Serializer { out: &mut out })?;
+    Ok(out)
+}
+
+/// Deserialize exactly one flat value from `data`
+pub fn from_slice<'de, T: Deserialize<'de>>(data: &'de [u8]) -> Result<T, CodecError> {
+    let mut deserializer = Deserializer {
+        input: data,
+        pos: 0,
+        depth: 0,
+    };
+    let value = T::deserialize(&mut deserializer)?;
+    if deserializer.pos != data.len() {
+        return Err(CodecError::InvalidFormat(format!(
+            "{} trailing bytes after flat value",
+            data.len() - deserializer.pos
+        )));
+    }
+    Ok(value)
+}
+
+fn read_u32(buf: &[u8], at: usize) -> Option<u32> {
+    let bytes = buf.get(at..at.checked_add(4)?)?;
+    Some(u32::from_le_bytes([bytes[0], bytes[1], bytes[2], bytes[3]]))
+}
+
+fn read_u64(buf: &[u8], at: usize) -> Option<u64> {
+    let bytes = buf.get(at..at.checked_add(8)?)?;
+    let mut array = [0; 8];
+    array.copy_from_slice(bytes);
+    Some(u64::from_le_bytes(array))
+}
+
+/// Number of bytes occupied by the value starting at `at`
+fn extent(buf: &[u8], at: usize) -> Option<usize> {
+    let mut at = at;
+    let mut prefix = 0usize;
+    // Enums nest their content, so walk the chain iteratively
+    loop {
+        let len = match *buf.get(at)? {
+            TAG_NIL | TAG_FALSE | TAG_TRUE => 1,
+            TAG_U64 | TAG_I64 | TAG_F64 => 9,
+            TAG_STR | TAG_BYTES => 5 + read_u32(buf, at + 1)? as usize,
+            TAG_SEQ | TAG_MAP => {
+                let count = read_u32(buf, at + 1)? as usize;
+                let body = read_u32(buf, at + 5)? as usize;
+                CONTAINER_HEADER_LEN + body + count.checked_mul(4)?
+            }
+            TAG_ENUM => {
+                let name = read_u32(buf, at + 5)? as usize;
+                let header = 9 + name;
+                prefix = prefix.checked_add(header)?;
+                at = at.checked_add(header)?;
+                continue;
+            }
+            _ => return None,
+        };
+        let total = prefix.checked_add(len)?;
+        return (at.checked_add(len)? <= buf.len()).then_some(total);
+    }
+}
+
+// ============================================================================
+// FlatView
+// ============================================================================
+
+/// Kind of a value in a flat buffer
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum FlatKind {
+    Nil,
+    Bool,
+    U64,
+    I64,
+    F64,
+    Str,
+    Bytes,
+    Seq,
+    Map,
+    Enum,
+}
+
+/// Borrowed, lazily checked view of one value in a flat buffer
+///
+/// Accessors return `None` when the value has a different kind or the buffer
+/// is malformed; nothing is copied or decoded up front.
+#[derive(Debug, Clone, Copy)]
+pub struct FlatView<'a> {
+    buf: &'a [u8],
+}
+
+impl<'a> FlatView<'a> {
+    /// Open a buffer holding exactly one flat value
+    pub fn new(data: &'a [u8]) -> Result<Self, CodecError> {
+        match extent(data, 0) {
+            Some(len) if len == data.len() => Ok(Self { buf: data }),
+            Some(len) => Err(CodecError::InvalidFormat(format!(
+                "{} trailing bytes after flat value",
+                data.len() - len
+            ))),
+            None => Err(CodecError::InvalidFormat(
+                "truncated or unknown flat value".to_string(),
+            )),
+        }
+    }
+
+    fn at(&self, offset: usize) -> Option<Self> {
+        let buf = self.buf.get(offset..)?;
+        let len = extent(buf, 0)?;
+        Some(Self { buf: &buf[..len] })
+    }
+
+    /// The raw bytes of this value, including its tag
+    pub fn as_raw(&self) -> &'a [u8] {
+        self.buf
+    }
+
+    /// Kind of this value
+    pub fn kind(&self) -> FlatKind {
+        match self.buf[0] {
+            TAG_NIL => FlatKind::Nil,
+            TAG_FALSE | TAG_TRUE => FlatKind::Bool,
+            TAG_U64 => FlatKind::U64,
+            TAG_I64 => FlatKind::I64,
+            TAG_F64 => FlatKind::F64,
+            TAG_STR => FlatKind::Str,
+            TAG_BYTES => FlatKind::Bytes,
+            TAG_SEQ => FlatKind::Seq,
+            TAG_MAP => FlatKind::Map,
+            _ => FlatKind::Enum,
+        }
+    }
+
+    /// Whether this value is nil (`None`, `()`, or a skipped field)
+    pub fn is_nil(&self) -> bool {
+        self.buf[0] == TAG_NIL
+    }
+
+    pub fn as_bool(&self) -> Option<bool> {
+        match self.buf[0] {
+            TAG_FALSE => Some(false),
+            TAG_TRUE => Some(true),
+            _ => None,
+        }
+    }
+
+    /// Unsigned integer value, converting non-negative signed integers
+    pub fn as_u64(&self) -> Option<u64> {
+        let raw = read_u64(self.buf, 1)?;
+        match self.buf[0] {
+            TAG_U64 => Some(raw),
+            TAG_I64 => u64::try_from(raw as i64).ok(),
+            _ => None,
+        }
+    }
+
+    /// Signed integer value, converting unsigned integers that fit
+    pub fn as_i64(&self) -> Option<i64> {
+        let raw = read_u64(self.buf, 1)?;
+        match self.buf[0] {
+            TAG_I64 => Some(raw as i64),
+            TAG_U64 => i64::try_from(raw).ok(),
+            _ => None,
+        }
+    }
+
+    pub fn as_f64(&self) -> Option<f64> {
+        (self.buf[0] == TAG_F64).then(|| read_u64(self.buf, 1).map(f64::from_bits))?
+    }
+
+    /// String borrowed from the buffer
+    pub fn as_str(&self) -> Option<&'a str> {
+        (self.buf[0] == TAG_STR).then(|| std::str::from_utf8(&self.buf[5..]).ok())?
+    }
+
+    /// Byte array borrowed from the buffer
+    pub fn as_bytes(&self) -> Option<&'a [u8]> {
+        (self.buf[0] == TAG_BYTES).then_some(&self.buf[5..])
+    }
+
+    /// Element or entry count of a sequence or map, 0 for other kinds
+    pub fn len(&self) -> usize {
+        match self.buf[0] {
+            TAG_SEQ | TAG_MAP => read_u32(self.buf, 1).unwrap_or(0) as usize,
+            _ => 0,
+        }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Offset of element `index` from the start of this value
+    fn element_offset(&self, index: usize) -> Option<usize> {
+        if index >= self.len() {
+            return None;
+        }
+        let body = read_u32(self.buf, 5)? as usize;
+        let table = CONTAINER_HEADER_LEN + body;
+        let offset = read_u32(self.buf, table + index * 4)? as usize;
+        (offset < body).then_some(CONTAINER_HEADER_LEN + offset)
+    }
+
+    /// Element `index` of a sequence, or field `index` of a struct
+    pub fn get(&self, index: usize) -> Option<FlatView<'a>> {
+        if self.buf[0] != TAG_SEQ {
+            return None;
+        }
+        self.at(self.element_offset(index)?)
+    }
+
+    /// Key and value of map entry `index`
+    pub fn entry(&self, index: usize) -> Option<(FlatView<'a>, FlatView<'a>)> {
+        if self.buf[0] != TAG_MAP {
+            return None;
+        }
+        let offset = self.element_offset(index)?;
+        let key = self.at(offset)?;
+        let value = self.at(offset + key.buf.len())?;
+        Some((key, value))
+    }
+
+    /// Value stored under a string key in a map
+    pub fn get_key(&self, key: &str) -> Option<FlatView<'a>> {
+        (0..self.len())
+            .filter_map(|i| self.entry(i))
+            .find(|(k, _)| k.as_str() == Some(key))
+            .map(|(_, v)| v)
+    }
+
+    /// Variant index, variant name, and content of an enum value
+    pub fn variant(&self) -> Option<(u32, &'a str, FlatView<'a>)> {
+        if self.buf[0] != TAG_ENUM {
+            return None;
+        }
+        let index = read_u32(self.buf, 1)?;
+        let name_len = read_u32(self.buf, 5)? as usize;
+        let name = std::str::from_utf8(self.buf.get(9..9 + name_len)?).ok()?;
+        Some((index, name, self.at(9 + name_len)?))
+    }
+
+    /// Decode this value (and everything below it) into `T`
+    pub fn deserialize<T: Deserialize<'a>>(&self) -> Result<T, CodecError> {
+        from_slice(self.buf)
+    }
+}
+
+// ============================================================================
+// Serializer
+// ============================================================================
+
+struct Serializer<'a> {
+    out: &'a mut Vec<u8>,
+}
+
+impl Serializer<'_> {
+    fn write_u32(&mut self, v: usize) -> Result<(), CodecError> {
+        let v = u32::try_from(v).map_err(|_| {
+            CodecError::Serialization(format!("length {v} exceeds flat format limit"))
+        })?;
+        self.out.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+
+    fn write_scalar(&mut self, tag: u8, bits: u64) {
+        self.out.push(tag);
+        self.out.extend_from_slice(&bits.to_le_bytes());
+    }
+
+    fn write_blob(&mut self, tag: u8, bytes: &[u8]) -> Result<(), CodecError> {
+        self.out.push(tag);
+        self.write_u32(bytes.len())?;
+        self.out.extend_from_slice(bytes);
+        Ok(())
+    }
+
+    fn write_enum_header(&mut self, index: u32, variant: &str) -> Result<(), CodecError> {
+        self.out.push(TAG_ENUM);
+        self.out.extend_from_slice(&index.to_le_bytes());
+        self.write_u32(variant.len())?;
+        self.out.extend_from_slice(variant.as_bytes());
+        Ok(())
+    }
+
+    /// Start a sequence or map whose header is patched by [`Compound::finish`]
+    fn begin<'b>(&'b mut self, tag: u8, len: Option<usize>) -> Compound<'b> {
+        let start = self.out.len();
+        self.out.push(tag);
+        self.out.extend_from_slice(&[0; 8]);
+        Compound {
+            ser: Serializer {
+                out: &mut *self.out,
+            },
+            start,
+            offsets: Vec::with_capacity(len.unwrap_or(0)),
+        }
+    }
+}
+
+/// In-progress sequence or map collecting its offset table
+struct Compound<'a> {
+    ser: Serializer<'a>,
+    start: usize,
+    offsets: Vec<u32>,
+}
+
+impl Compound<'_> {
+    fn body_start(&self) -> usize {
+        self.start + CONTAINER_HEADER_LEN
+    }
+
+    fn mark(&mut self) -> Result<(), CodecError> {
+        let offset = self.ser.out.len() - self.body_start();
+        let offset = u32::try_from(offset)
+            .map_err(|_| CodecError::Serialization("flat container exceeds 4 GiB".to_string()))?;
+        self.offsets.push(offset);
+        Ok(())
+    }
+
+    fn element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.mark()?;
+        value.serialize(&mut self.ser)
+    }
+
+    fn finish(self) -> Result<(), CodecError> {
+        let Compound {
+            ser,
+            start,
+            offsets,
+        } = self;
+        let body_len = ser.out.len() - start - CONTAINER_HEADER_LEN;
+        for offset in &offsets {
+            ser.out.extend_from_slice(&offset.to_le_bytes());
+        }
+        let count = u32::try_from(offsets.len()).unwrap_or(u32::MAX);
+        let body_len = u32::try_from(body_len)
+            .map_err(|_| CodecError::Serialization("flat container exceeds 4 GiB".to_string()))?;
+        ser.out[start + 1..start + 5].copy_from_slice(&count.to_le_bytes());
+        ser.out[start + 5..start + 9].copy_from_slice(&body_len.to_le_bytes());
+        Ok(())
+    }
+}
+
+impl<'a, 'b> ser::Serializer for &'a mut Serializer<'b> {
+    type Ok = ();
+    type Error = CodecError;
+    type SerializeSeq = Compound<'a>;
+    type SerializeTuple = Compound<'a>;
+    type SerializeTupleStruct = Compound<'a>;
+    type SerializeTupleVariant = Compound<'a>;
+    type SerializeMap = Compound<'a>;
+    type SerializeStruct = Compound<'a>;
+    type SerializeStructVariant = Compound<'a>;
+
+    fn serialize_bool(self, v: bool) -> Result<(), CodecError> {
+        self.out.push(if v { TAG_TRUE } else { TAG_FALSE });
+        Ok(())
+    }
+
+    fn serialize_i8(self, v: i8) -> Result<(), CodecError> {
+        self.serialize_i64(v.into())
+    }
+
+    fn serialize_i16(self, v: i16) -> Result<(), CodecError> {
+        self.serialize_i64(v.into())
+    }
+
+    fn serialize_i32(self, v: i32) -> Result<(), CodecError> {
+        self.serialize_i64(v.into())
+    }
+
+    fn serialize_i64(self, v: i64) -> Result<(), CodecError> {
+        self.write_scalar(TAG_I64, v as u64);
+        Ok(())
+    }
+
+    fn serialize_u8(self, v: u8) -> Result<(), CodecError> {
+        self.serialize_u64(v.into())
+    }
+
+    fn serialize_u16(self, v: u16) -> Result<(), CodecError> {
+        self.serialize_u64(v.into())
+    }
+
+    fn serialize_u32(self, v: u32) -> Result<(), CodecError> {
+        self.serialize_u64(v.into())
+    }
+
+    fn serialize_u64(self, v: u64) -> Result<(), CodecError> {
+        self.write_scalar(TAG_U64, v);
+        Ok(())
+    }
+
+    fn serialize_f32(self, v: f32) -> Result<(), CodecError> {
+        self.serialize_f64(v.into())
+    }
+
+    fn serialize_f64(self, v: f64) -> Result<(), CodecError> {
+        self.write_scalar(TAG_F64, v.to_bits());
+        Ok(())
+    }
+
+    fn serialize_char(self, v: char) -> Result<(), CodecError> {
+        self.write_blob(TAG_STR, v.encode_utf8(&mut [0; 4]).as_bytes())
+    }
+
+    fn serialize_str(self, v: &str) -> Result<(), CodecError> {
+        self.write_blob(TAG_STR, v.as_bytes())
+    }
+
+    fn serialize_bytes(self, v: &[u8]) -> Result<(), CodecError> {
+        self.write_blob(TAG_BYTES, v)
+    }
+
+    fn serialize_none(self) -> Result<(), CodecError> {
+        self.out.push(TAG_NIL);
+        Ok(())
+    }
+
+    fn serialize_some<T: Serialize + ?Sized>(self, value: &T) -> Result<(), CodecError> {
+        value.serialize(self)
+    }
+
+    fn serialize_unit(self) -> Result<(), CodecError> {
+        self.out.push(TAG_NIL);
+        Ok(())
+    }
+
+    fn serialize_unit_struct(self, _name: &'static str) -> Result<(), CodecError> {
+        self.serialize_unit()
+    }
+
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        index: u32,
+        variant: &'static str,
+    ) -> Result<(), CodecError> {
+        self.write_enum_header(index, variant)?;
+        self.out.push(TAG_NIL);
+        Ok(())
+    }
+
+    fn serialize_newtype_struct<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        value.serialize(self)
+    }
+
+    fn serialize_newtype_variant<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        index: u32,
+        variant: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.write_enum_header(index, variant)?;
+        value.serialize(self)
+    }
+
+    fn serialize_seq(self, len: Option<usize>) -> Result<Compound<'a>, CodecError> {
+        Ok(self.begin(TAG_SEQ, len))
+    }
+
+    fn serialize_tuple(self, len: usize) -> Result<Compound<'a>, CodecError> {
+        Ok(self.begin(TAG_SEQ, Some(len)))
+    }
+
+    fn serialize_tuple_struct(
+        self,
+        _name: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        Ok(self.begin(TAG_SEQ, Some(len)))
+    }
+
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        self.write_enum_header(index, variant)?;
+        Ok(self.begin(TAG_SEQ, Some(len)))
+    }
+
+    fn serialize_map(self, len: Option<usize>) -> Result<Compound<'a>, CodecError> {
+        Ok(self.begin(TAG_MAP, len))
+    }
+
+    fn serialize_struct(self, _name: &'static str, len: usize) -> Result<Compound<'a>, CodecError> {
+        Ok(self.begin(TAG_SEQ, Some(len)))
+    }
+
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        self.write_enum_header(index, variant)?;
+        Ok(self.begin(TAG_SEQ, Some(len)))
+    }
+}
+
+impl ser::SerializeSeq for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTuple for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTupleStruct for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTupleVariant for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeMap for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_key<T: Serialize + ?Sized>(&mut self, key: &T) -> Result<(), CodecError> {
+        self.element(key)
+    }
+
+    fn serialize_value<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        value.serialize(&mut self.ser)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeStruct for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn skip_field(&mut self, _key: &'static str) -> Result<(), CodecError> {
+        self.element(&())
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeStructVariant for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn skip_field(&mut self, _key: &'static str) -> Result<(), CodecError> {
+        self.element(&())
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+// ============================================================================
+// Deserializer
+// ============================================================================
+
+struct Deserializer<'de> {
+    input: &'de [u8],
+    pos: usize,
+    depth: usize,
+}
+
+impl<'de> Deserializer<'de> {
+    fn eof() -> CodecError {
+        CodecError::Deserialization("unexpected end of flat input".to_string())
+    }
+
+    fn peek(&self) -> Result<u8, CodecError> {
+        self.input.get(self.pos).copied().ok_or_else(Self::eof)
+    }
+
+    fn take(&mut self, n: usize) -> Result<&'de [u8], CodecError> {
+        let end = self.pos.checked_add(n).ok_or_else(Self::eof)?;
+        let bytes = self.input.get(self.pos..end).ok_or_else(Self::eof)?;
+        self.pos = end;
+        Ok(bytes)
+    }
+
+    fn read_u32(&mut self) -> Result<usize, CodecError> {
+        let value = read_u32(self.input, self.pos).ok_or_else(Self::eof)?;
+        self.pos += 4;
+        Ok(value as usize)
+    }
+
+    fn read_u64(&mut self) -> Result<u64, CodecError> {
+        let value = read_u64(self.input, self.pos).ok_or_else(Self::eof)?;
+        self.pos += 8;
+        Ok(value)
+    }
+
+    fn read_str(&mut self) -> Result<&'de str, CodecError> {
+        let len = self.read_u32()?;
+        std::str::from_utf8(self.take(len)?)
+            .map_err(|e| CodecError::Deserialization(format!("invalid UTF-8 string: {e}")))
+    }
+
+    fn enter(&mut self) -> Result<(), CodecError> {
+        self.depth += 1;
+        if self.depth > MAX_DEPTH {
+            return Err(CodecError::Deserialization(
+                "flat nesting exceeds recursion limit".to_string(),
+            ));
+        }
+        Ok(())
+    }
+
+    /// Walk a container's elements in order, then skip its offset table
+    fn visit_container<V: Visitor<'de>>(
+        &mut self,
+        is_map: bool,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        let count = self.read_u32()?;
+        let body_len = self.read_u32()?;
+        let body_end = self.pos.checked_add(body_len).ok_or_else(Self::eof)?;
+        self.enter()?;
+        let mut access = Counted {
+            de: &mut *self,
+            remaining: count,
+        };
+        let value = if is_map {
+            visitor.visit_map(&mut access)?
+        } else {
+            visitor.visit_seq(&mut access)?
+        };
+        let remaining = access.remaining;
+        self.depth -= 1;
+        if remaining != 0 {
+            return Err(de::Error::invalid_length(count, &"fewer elements"));
+        }
+        if self.pos != body_end {
+            return Err(CodecError::InvalidFormat(
+                "flat container body length mismatch".to_string(),
+            ));
+        }
+        self.take(count.checked_mul(4).ok_or_else(Self::eof)?)?;
+        Ok(value)
+    }
+}
+
+impl<'de> de::Deserializer<'de> for &mut Deserializer<'de> {
+    type Error = CodecError;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        let tag = self.take(1)?[0];
+        match tag {
+            TAG_NIL => visitor.visit_unit(),
+            TAG_FALSE => visitor.visit_bool(false),
+            TAG_TRUE => visitor.visit_bool(true),
+            TAG_U64 => visitor.visit_u64(self.read_u64()?),
+            TAG_I64 => visitor.visit_i64(self.read_u64()? as i64),
+            TAG_F64 => visitor.visit_f64(f64::from_bits(self.read_u64()?)),
+            TAG_STR => visitor.visit_borrowed_str(self.read_str()?),
+            TAG_BYTES => {
+                let len = self.read_u32()?;
+                visitor.visit_borrowed_bytes(self.take(len)?)
+            }
+            TAG_SEQ => self.visit_container(false, visitor),
+            TAG_MAP => self.visit_container(true, visitor),
+            TAG_ENUM => {
+                // Self-describing targets (like serde_json::Value) see the
+                // same externally tagged shape JSON would produce
+                self.read_u32()?;
+                let name = self.read_str()?;
+                if self.peek()? == TAG_NIL {
+                    self.pos += 1;
+                    visitor.visit_borrowed_str(name)
+                } else {
+                    self.enter()?;
+                    let value = visitor.visit_map(SingleEntry {
+                        de: &mut *self,
+                        key: Some(name),
+                    })?;
+                    self.depth -= 1;
+                    Ok(value)
+                }
+            }
+            other => Err(CodecError::InvalidFormat(format!(
+                "unknown flat tag {other}"
+            ))),
+        }
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        if self.peek()? == TAG_NIL {
+            self.pos += 1;
+            visitor.visit_none()
+        } else {
+            visitor.visit_some(self)
+        }
+    }
+
+    fn deserialize_newtype_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        visitor.visit_newtype_struct(self)
+    }
+
+    // A nil where a collection is expected is a field dropped by
+    // `skip_serializing_if` (typically `Vec::is_empty`), so read it as empty
+
+    fn deserialize_seq<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        if self.peek()? == TAG_NIL {
+            self.pos += 1;
+            return visitor.visit_seq(de::value::SeqDeserializer::new(std::iter::empty::<()>()));
+        }
+        self.deserialize_any(visitor)
+    }
+
+    fn deserialize_map<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        if self.peek()? == TAG_NIL {
+            self.pos += 1;
+            return visitor.visit_map(de::value::MapDeserializer::new(
+                std::iter::empty::<((), ())>(),
+            ));
+        }
+        self.deserialize_any(visitor)
+    }
+
+    fn deserialize_enum<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _variants: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        if self.take(1)?[0] != TAG_ENUM {
+            return Err(CodecError::Deserialization(
+                "expected flat enum value".to_string(),
+            ));
+        }
+        self.read_u32()?;
+        let name = self.read_str()?;
+        self.enter()?;
+        let value = visitor.visit_enum(Enum {
+            de: &mut *self,
+            name,
+        })?;
+        self.depth -= 1;
+        Ok(value)
+    }
+
+    serde::forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf unit unit_struct tuple tuple_struct struct
+        identifier ignored_any
+    }
+}
+
+/// Sequence and map access over a known number of elements
+struct Counted<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    remaining: usize,
+}
+
+impl<'de> SeqAccess<'de> for Counted<'_, 'de> {
+    type Error = CodecError;
+
+    fn next_element_seed<T: DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>, CodecError> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+impl<'de> MapAccess<'de> for Counted<'_, 'de> {
+    type Error = CodecError;
+
+    fn next_key_seed<K: DeserializeSeed<'de>>(
+        &mut self,
+        seed: K,
+    ) -> Result<Option<K::Value>, CodecError> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+
+    fn next_value_seed<V: DeserializeSeed<'de>>(
+        &mut self,
+        seed: V,
+    ) -> Result<V::Value, CodecError> {
+        seed.deserialize(&mut *self.de)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+/// `{variant: content}` map presented to self-describing visitors
+struct SingleEntry<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    key: Option<&'de str>,
+}
+
+impl<'de> MapAccess<'de> for SingleEntry<'_, 'de> {
+    type Error = CodecError;
+
+    fn next_key_seed<K: DeserializeSeed<'de>>(
+        &mut self,
+        seed: K,
+    ) -> Result<Option<K::Value>, CodecError> {
+        match self.key.take() {
+            Some(key) => seed
+                .deserialize(BorrowedStrDeserializer::new(key))
+                .map(Some),
+            None => Ok(None),
+        }
+    }
+
+    fn next_value_seed<V: DeserializeSeed<'de>>(
+        &mut self,
+        seed: V,
+    ) -> Result<V::Value, CodecError> {
+        seed.deserialize(&mut *self.de)
+    }
+}
+
+/// Enum access once the variant name has been read
+struct Enum<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    name: &'de str,
+}
+
+impl<'de> EnumAccess<'de> for Enum<'_, 'de> {
+    type Error = CodecError;
+    type Variant = Self;
+
+    fn variant_seed<V: DeserializeSeed<'de>>(
+        self,
+        seed: V,
+    ) -> Result<(V::Value, Self), CodecError> {
+        let variant = seed.deserialize(BorrowedStrDeserializer::<CodecError>::new(self.name))?;
+        Ok((variant, self))
+    }
+}
+
+impl<'de> VariantAccess<'de> for Enum<'_, 'de> {
+    type Error = CodecError;
+
+    fn unit_variant(self) -> Result<(), CodecError> {
+        <()>::deserialize(&mut *self.de)
+    }
+
+    fn newtype_variant_seed<T: DeserializeSeed<'de>>(
+        self,
+        seed: T,
+    ) -> Result<T::Value, CodecError> {
+        seed.deserialize(&mut *self.de)
+    }
+
+    fn tuple_variant<V: Visitor<'de>>(
+        self,
+        _len: usize,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.de.deserialize_any(visitor)
+    }
+
+    fn struct_variant<V: Visitor<'de>>(
+        self,
+        _fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.de.deserialize_any(visitor)
+    }
+}
+
+#[cfg(test)]
+#[path = "flat/flat_tests.rs"]
+mod flat_tests;
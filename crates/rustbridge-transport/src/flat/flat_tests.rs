@@ -0,0 +1,232 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use serde::{Deserialize, Serialize};
+use std::collections::BTreeMap;
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct TestMessage {
+    id: u64,
+    name: String,
+    tags: Vec<String>,
+    score: f64,
+    parent: Option<u32>,
+}
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+enum Shape {
+    Empty,
+    Circle(f32),
+    Rect { w: u16, h: u16 },
+    Pair(i8, i8),
+}
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct Sparse {
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    first: Option<String>,
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    items: Vec<u32>,
+    last: i32,
+}
+
+fn sample() -> TestMessage {
+    TestMessage {
+        id: 42,
+        name: "test".to_string(),
+        tags: vec!["a".to_string(), "b".to_string()],
+        score: 0.5,
+        parent: Some(7),
+    }
+}
+
+// Roundtrip tests
+
+#[test]
+fn FlatCodec___encode_decode___roundtrip_preserves_data() {
+    let codec = FlatCodec::new();
+    let original = sample();
+
+    let encoded = codec.encode(&original).unwrap();
+    let decoded: TestMessage = codec.decode(&encoded).unwrap();
+
+    assert_eq!(original, decoded);
+}
+
+#[test]
+fn FlatCodec___enums___roundtrip_every_variant_shape() {
+    let shapes = vec![
+        Shape::Empty,
+        Shape::Circle(1.5),
+        Shape::Rect { w: 3, h: 4 },
+        Shape::Pair(-1, 1),
+    ];
+
+    let encoded = to_vec(&shapes).unwrap();
+    let decoded: Vec<Shape> = from_slice(&encoded).unwrap();
+
+    assert_eq!(decoded, shapes);
+}
+
+#[test]
+fn FlatCodec___skipped_fields___keep_positions_and_decode_as_default() {
+    let original = Sparse {
+        first: None,
+        items: Vec::new(),
+        last: -9,
+    };
+
+    let encoded = to_vec(&original).unwrap();
+    let view = FlatView::new(&encoded).unwrap();
+    let decoded: Sparse = from_slice(&encoded).unwrap();
+
+    assert_eq!(view.len(), 3);
+    assert!(view.get(0).unwrap().is_nil());
+    assert_eq!(view.get(2).unwrap().as_i64(), Some(-9));
+    assert_eq!(decoded, original);
+}
+
+#[test]
+fn FlatCodec___json_values___roundtrip_with_externally_tagged_enums() {
+    let mut map = BTreeMap::new();
+    map.insert(
+        "one".to_string(),
+        serde_json::json!({"nested": [1, -2, 3.5, null]}),
+    );
+
+    let encoded = to_vec(&map).unwrap();
+    let decoded: BTreeMap<String, serde_json::Value> = from_slice(&encoded).unwrap();
+    let shape: serde_json::Value = from_slice(&to_vec(&Shape::Circle(2.0)).unwrap()).unwrap();
+    let unit: serde_json::Value = from_slice(&to_vec(&Shape::Empty).unwrap()).unwrap();
+
+    assert_eq!(decoded, map);
+    assert_eq!(shape, serde_json::json!({"Circle": 2.0}));
+    assert_eq!(unit, serde_json::json!("Empty"));
+}
+
+#[test]
+fn FlatCodec___content_type___returns_flat() {
+    assert_eq!(
+        FlatCodec::new().content_type(),
+        "application/x-rustbridge-flat"
+    );
+}
+
+// FlatView tests
+
+#[test]
+fn FlatView___get___reads_struct_fields_in_place() {
+    let encoded = to_vec(&sample()).unwrap();
+
+    let view = FlatCodec::new().view(&encoded).unwrap();
+    let name = view.get(1).unwrap().as_str().unwrap();
+
+    assert_eq!(view.kind(), FlatKind::Seq);
+    assert_eq!(view.get(0).unwrap().as_u64(), Some(42));
+    assert_eq!(name, "test");
+    assert!(encoded.as_ptr_range().contains(&name.as_ptr()));
+    assert_eq!(view.get(3).unwrap().as_f64(), Some(0.5));
+    assert_eq!(view.get(4).unwrap().as_u64(), Some(7));
+    assert!(view.get(5).is_none());
+}
+
+#[test]
+fn FlatView___get___reads_nested_sequence_elements() {
+    let encoded = to_vec(&sample()).unwrap();
+    let view = FlatView::new(&encoded).unwrap();
+
+    let tags = view.get(2).unwrap();
+
+    assert_eq!(tags.len(), 2);
+    assert_eq!(tags.get(1).unwrap().as_str(), Some("b"));
+}
+
+#[test]
+fn FlatView___get_key___finds_map_entries() {
+    let mut map = BTreeMap::new();
+    map.insert("alpha", 1u32);
+    map.insert("beta", 2u32);
+    let encoded = to_vec(&map).unwrap();
+
+    let view = FlatView::new(&encoded).unwrap();
+
+    assert_eq!(view.kind(), FlatKind::Map);
+    assert_eq!(view.get_key("beta").unwrap().as_u64(), Some(2));
+    assert!(view.get_key("gamma").is_none());
+    assert_eq!(view.entry(0).unwrap().0.as_str(), Some("alpha"));
+}
+
+#[test]
+fn FlatView___variant___exposes_name_and_content() {
+    let encoded = to_vec(&Shape::Rect { w: 3, h: 4 }).unwrap();
+
+    let (index, name, content) = FlatView::new(&encoded).unwrap().variant().unwrap();
+
+    assert_eq!(index, 2);
+    assert_eq!(name, "Rect");
+    assert_eq!(content.get(1).unwrap().as_u64(), Some(4));
+}
+
+#[test]
+fn FlatView___deserialize___decodes_subtree() {
+    let encoded = to_vec(&sample()).unwrap();
+    let view = FlatView::new(&encoded).unwrap();
+
+    let tags: Vec<&str> = view.get(2).unwrap().deserialize().unwrap();
+
+    assert_eq!(tags, vec!["a", "b"]);
+}
+
+#[test]
+fn FlatView___wrong_kind___returns_none() {
+    let encoded = to_vec(&5u8).unwrap();
+    let view = FlatView::new(&encoded).unwrap();
+
+    assert!(view.as_str().is_none());
+    assert!(view.get(0).is_none());
+    assert_eq!(view.as_i64(), Some(5));
+    assert!(view.is_empty());
+}
+
+#[test]
+fn FlatView___new___rejects_truncated_and_trailing_input() {
+    let encoded = to_vec(&sample()).unwrap();
+    let mut trailing = encoded.clone();
+    trailing.push(0);
+
+    assert!(FlatView::new(&encoded[..encoded.len() - 1]).is_err());
+    assert!(FlatView::new(&trailing).is_err());
+    assert!(FlatView::new(&[]).is_err());
+}
+
+// Error tests
+
+#[test]
+fn from_slice___truncated_input___returns_error() {
+    let encoded = to_vec(&sample()).unwrap();
+
+    let result: Result<TestMessage, _> = from_slice(&encoded[..encoded.len() - 1]);
+
+    assert!(result.is_err());
+}
+
+#[test]
+fn from_slice___unknown_tag___returns_invalid_format() {
+    let result: Result<serde_json::Value, _> = from_slice(&[0xee]);
+
+    assert!(matches!(result, Err(CodecError::InvalidFormat(_))));
+}
+
+#[test]
+fn from_slice___deep_nesting___hits_recursion_limit() {
+    // Each level is a one-element sequence wrapping the next
+    let mut value = serde_json::Value::Null;
+    for _ in 0..=MAX_DEPTH {
+        value = serde_json::Value::Array(vec![value]);
+    }
+    let encoded = to_vec(&value).unwrap();
+
+    let result: Result<serde_json::Value, _> = from_slice(&encoded);
+
+    assert!(result.is_err());
+}
@@ -1,19 +1,31 @@
-//! rustbridge-transport - JSON codec and serialization layer
+//! rustbridge-transport - codecs and serialization layer
 //!
 //! This crate provides:
 //! - [`Codec`] trait for encoding/decoding messages
 //! - [`JsonCodec`] implementation for JSON transport
+//! - [`MsgPackCodec`] and [`FlatCodec`] binary implementations, selected per
+//!   call with [`encode_as`] / [`decode_as`]
+//! - [`FlatView`] for reading flat payloads in place without decoding
 //! - [`RequestEnvelope`] and [`ResponseEnvelope`] for message framing
+//! - [`DispatchTable`] for looking up handlers by numeric message ID
+//! - [`TagTable`] for looking up handlers by type tag with a perfect hash
 
 mod codec;
+mod dispatch;
 mod envelope;
+pub mod flat;
+pub mod msgpack;
 
-pub use codec::{Codec, CodecError, JsonCodec};
+pub use codec::{Codec, CodecError, JsonCodec, decode_as, encode_as};
+pub use dispatch::{DENSE_ID_LIMIT, DispatchTable, TagTable, tag_hash};
 pub use envelope::{RequestEnvelope, ResponseEnvelope, ResponseStatus};
+pub use flat::{FlatCodec, FlatKind, FlatView};
+pub use msgpack::MsgPackCodec;
 
 /// Prelude module for convenient imports
 pub mod prelude {
     pub use crate::{
-        Codec, CodecError, JsonCodec, RequestEnvelope, ResponseEnvelope, ResponseStatus,
+        Codec, CodecError, FlatCodec, JsonCodec, MsgPackCodec, RequestEnvelope, ResponseEnvelope,
+        ResponseStatus,
     };
 }
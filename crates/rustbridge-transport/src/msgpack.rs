@@ -0,0 +1,818 @@
+//! MessagePack codec
+//!
+//! A self-contained serde implementation of the MessagePack wire format.
+//! Structs are written as maps keyed by field name so that payloads stay
+//! compatible with msgpack libraries on the host side (Jackson's msgpack
+//! module, MessagePack-CSharp, `msgpack` for Python), and enums use the same
+//! externally tagged shape as JSON: a unit variant is its name, any other
+//! variant is a single-entry map from name to content.
+//!
+//! Decoding borrows strings and byte arrays from the input where the target
+//! type allows it, so `&str` and `&[u8]` fields do not copy.
+
+use crate::codec::{Codec, CodecError};
+use rustbridge_core::ContentType;
+use serde::de::{
+    self, DeserializeSeed, Deserializer as _, EnumAccess, IntoDeserializer, MapAccess, SeqAccess,
+    VariantAccess, Visitor,
+};
+use serde::ser::{self, Serialize};
+use serde::{Deserialize, de::DeserializeOwned};
+
+/// Nesting depth at which decoding gives up, matching serde_json's limit
+const MAX_DEPTH: usize = 128;
+
+/// Header placeholder used for sequences and maps of unknown length
+const UNKNOWN_LEN_PLACEHOLDER: [u8; 4] = [0; 4];
+
+/// MessagePack codec implementation
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MsgPackCodec;
+
+impl MsgPackCodec {
+    /// Create a new MessagePack codec
+    pub fn new() -> Self {
+        Self
+    }
+
+    /// Decode a value that borrows strings and bytes from `data`
+    pub fn decode_borrowed<'de, T: Deserialize<'de>>(
+        &self,
+        data: &'de [u8],
+    ) -> Result<T, CodecError> {
+        from_slice(data)
+    }
+}
+
+impl Codec for MsgPackCodec {
+    fn encode<T: Serialize>(&self, value: &T) -> Result<Vec<u8>, CodecError> {
+        to_vec(value)
+    }
+
+    fn decode<T: DeserializeOwned>(&self, data: &[u8]) -> Result<T, CodecError> {
+        from_slice(data)
+    }
+
+    fn content_type(&self) -> &'static str {
+        ContentType::MsgPack.mime()
+    }
+}
+
+/// Serialize a value to MessagePack bytes
+pub fn to_vec<T: Serialize + ?Sized>(value: &T) -> Result<Vec<u8>, CodecError> {
+    let mut out = Vec::with_capacity(128);
+    value.serialize(&mut Serializer { out: &mut out })?;
+    Ok(out)
+}
+
+/// Deserialize exactly one MessagePack value from `data`
+pub fn from_slice<'de, T: Deserialize<'de>>(data: &'de [u8]) -> Result<T, CodecError> {
+    let mut deserializer = Deserializer {
+        input: data,
+        pos: 0,
+        depth: 0,
+    };
+    let value = T::deserialize(&mut deserializer)?;
+    if deserializer.pos != data.len() {
+        return Err(CodecError::InvalidFormat(format!(
+            "{} trailing bytes after msgpack value",
+            data.len() - deserializer.pos
+        )));
+    }
+    Ok(value)
+}
+
+// ============================================================================
+// Serializer
+// ============================================================================
+
+struct Serializer<'a> {
+    out: &'a mut Vec<u8>,
+}
+
+impl Serializer<'_> {
+    fn write_uint(&mut self, v: u64) {
+        if v < 0x80 {
+            self.out.push(v as u8);
+        } else if v <= u8::MAX as u64 {
+            self.out.extend_from_slice(&[0xcc, v as u8]);
+        } else if v <= u16::MAX as u64 {
+            self.out.push(0xcd);
+            self.out.extend_from_slice(&(v as u16).to_be_bytes());
+        } else if v <= u32::MAX as u64 {
+            self.out.push(0xce);
+            self.out.extend_from_slice(&(v as u32).to_be_bytes());
+        } else {
+            self.out.push(0xcf);
+            self.out.extend_from_slice(&v.to_be_bytes());
+        }
+    }
+
+    fn write_int(&mut self, v: i64) {
+        if v >= 0 {
+            self.write_uint(v as u64);
+        } else if v >= -32 {
+            self.out.push(v as i8 as u8);
+        } else if v >= i8::MIN as i64 {
+            self.out.extend_from_slice(&[0xd0, v as i8 as u8]);
+        } else if v >= i16::MIN as i64 {
+            self.out.push(0xd1);
+            self.out.extend_from_slice(&(v as i16).to_be_bytes());
+        } else if v >= i32::MIN as i64 {
+            self.out.push(0xd2);
+            self.out.extend_from_slice(&(v as i32).to_be_bytes());
+        } else {
+            self.out.push(0xd3);
+            self.out.extend_from_slice(&v.to_be_bytes());
+        }
+    }
+
+    /// Write a length-prefixed header using the fix/8/16/32 marker family
+    fn write_len(
+        &mut self,
+        len: usize,
+        fix: Option<(u8, usize)>,
+        markers: [u8; 3],
+    ) -> Result<(), CodecError> {
+        match fix {
+            Some((base, limit)) if len < limit => self.out.push(base | len as u8),
+            _ if markers[0] != 0 && len <= u8::MAX as usize => {
+                self.out.extend_from_slice(&[markers[0], len as u8]);
+            }
+            _ if len <= u16::MAX as usize => {
+                self.out.push(markers[1]);
+                self.out.extend_from_slice(&(len as u16).to_be_bytes());
+            }
+            _ => {
+                let len = u32::try_from(len).map_err(|_| {
+                    CodecError::Serialization(format!("length {len} exceeds msgpack limit"))
+                })?;
+                self.out.push(markers[2]);
+                self.out.extend_from_slice(&len.to_be_bytes());
+            }
+        }
+        Ok(())
+    }
+
+    fn write_str(&mut self, v: &str) -> Result<(), CodecError> {
+        self.write_len(v.len(), Some((0xa0, 32)), [0xd9, 0xda, 0xdb])?;
+        self.out.extend_from_slice(v.as_bytes());
+        Ok(())
+    }
+
+    fn write_array_len(&mut self, len: usize) -> Result<(), CodecError> {
+        self.write_len(len, Some((0x90, 16)), [0, 0xdc, 0xdd])
+    }
+
+    fn write_map_len(&mut self, len: usize) -> Result<(), CodecError> {
+        self.write_len(len, Some((0x80, 16)), [0, 0xde, 0xdf])
+    }
+
+    /// Start a sequence or map, reserving a 32-bit count when `len` is unknown
+    fn begin<'b>(
+        &'b mut self,
+        len: Option<usize>,
+        marker32: u8,
+        write_len: fn(&mut Self, usize) -> Result<(), CodecError>,
+    ) -> Result<Compound<'b>, CodecError> {
+        let patch_at = match len {
+            Some(len) => {
+                write_len(self, len)?;
+                None
+            }
+            None => {
+                self.out.push(marker32);
+                self.out.extend_from_slice(&UNKNOWN_LEN_PLACEHOLDER);
+                Some(self.out.len() - UNKNOWN_LEN_PLACEHOLDER.len())
+            }
+        };
+        Ok(Compound {
+            ser: Serializer {
+                out: &mut *self.out,
+            },
+            patch_at,
+            count: 0,
+        })
+    }
+}
+
+/// In-progress array or map; patches its count on `end` when it was unknown
+struct Compound<'a> {
+    ser: Serializer<'a>,
+    patch_at: Option<usize>,
+    count: u32,
+}
+
+impl Compound<'_> {
+    fn element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.count += 1;
+        value.serialize(&mut self.ser)
+    }
+
+    fn finish(self) -> Result<(), CodecError> {
+        if let Some(at) = self.patch_at {
+            self.ser.out[at..at + 4].copy_from_slice(&self.count.to_be_bytes());
+        }
+        Ok(())
+    }
+}
+
+impl<'a, 'b> ser::Serializer for &'a mut Serializer<'b> {
+    type Ok = ();
+    type Error = CodecError;
+    type SerializeSeq = Compound<'a>;
+    type SerializeTuple = Compound<'a>;
+    type SerializeTupleStruct = Compound<'a>;
+    type SerializeTupleVariant = Compound<'a>;
+    type SerializeMap = Compound<'a>;
+    type SerializeStruct = Compound<'a>;
+    type SerializeStructVariant = Compound<'a>;
+
+    fn serialize_bool(self, v: bool) -> Result<(), CodecError> {
+        self.out.push(if v { 0xc3 } else { 0xc2 });
+        Ok(())
+    }
+
+    fn serialize_i8(self, v: i8) -> Result<(), CodecError> {
+        self.write_int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i16(self, v: i16) -> Result<(), CodecError> {
+        self.write_int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i32(self, v: i32) -> Result<(), CodecError> {
+        self.write_int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i64(self, v: i64) -> Result<(), CodecError> {
+        self.write_int(v);
+        Ok(())
+    }
+
+    fn serialize_u8(self, v: u8) -> Result<(), CodecError> {
+        self.write_uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u16(self, v: u16) -> Result<(), CodecError> {
+        self.write_uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u32(self, v: u32) -> Result<(), CodecError> {
+        self.write_uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u64(self, v: u64) -> Result<(), CodecError> {
+        self.write_uint(v);
+        Ok(())
+    }
+
+    fn serialize_f32(self, v: f32) -> Result<(), CodecError> {
+        self.out.push(0xca);
+        self.out.extend_from_slice(&v.to_be_bytes());
+        Ok(())
+    }
+
+    fn serialize_f64(self, v: f64) -> Result<(), CodecError> {
+        self.out.push(0xcb);
+        self.out.extend_from_slice(&v.to_be_bytes());
+        Ok(())
+    }
+
+    fn serialize_char(self, v: char) -> Result<(), CodecError> {
+        self.write_str(v.encode_utf8(&mut [0; 4]))
+    }
+
+    fn serialize_str(self, v: &str) -> Result<(), CodecError> {
+        self.write_str(v)
+    }
+
+    fn serialize_bytes(self, v: &[u8]) -> Result<(), CodecError> {
+        self.write_len(v.len(), None, [0xc4, 0xc5, 0xc6])?;
+        self.out.extend_from_slice(v);
+        Ok(())
+    }
+
+    fn serialize_none(self) -> Result<(), CodecError> {
+        self.out.push(0xc0);
+        Ok(())
+    }
+
+    fn serialize_some<T: Serialize + ?Sized>(self, value: &T) -> Result<(), CodecError> {
+        value.serialize(self)
+    }
+
+    fn serialize_unit(self) -> Result<(), CodecError> {
+        self.out.push(0xc0);
+        Ok(())
+    }
+
+    fn serialize_unit_struct(self, _name: &'static str) -> Result<(), CodecError> {
+        self.serialize_unit()
+    }
+
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+    ) -> Result<(), CodecError> {
+        self.write_str(variant)
+    }
+
+    fn serialize_newtype_struct<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        value.serialize(self)
+    }
+
+    fn serialize_newtype_variant<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.write_map_len(1)?;
+        self.write_str(variant)?;
+        value.serialize(self)
+    }
+
+    fn serialize_seq(self, len: Option<usize>) -> Result<Compound<'a>, CodecError> {
+        self.begin(len, 0xdd, Serializer::write_array_len)
+    }
+
+    fn serialize_tuple(self, len: usize) -> Result<Compound<'a>, CodecError> {
+        self.begin(Some(len), 0xdd, Serializer::write_array_len)
+    }
+
+    fn serialize_tuple_struct(
+        self,
+        _name: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        self.begin(Some(len), 0xdd, Serializer::write_array_len)
+    }
+
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        self.write_map_len(1)?;
+        self.write_str(variant)?;
+        self.begin(Some(len), 0xdd, Serializer::write_array_len)
+    }
+
+    fn serialize_map(self, len: Option<usize>) -> Result<Compound<'a>, CodecError> {
+        self.begin(len, 0xdf, Serializer::write_map_len)
+    }
+
+    fn serialize_struct(self, _name: &'static str, len: usize) -> Result<Compound<'a>, CodecError> {
+        self.begin(Some(len), 0xdf, Serializer::write_map_len)
+    }
+
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, CodecError> {
+        self.write_map_len(1)?;
+        self.write_str(variant)?;
+        self.begin(Some(len), 0xdf, Serializer::write_map_len)
+    }
+}
+
+impl ser::SerializeSeq for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTuple for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTupleStruct for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeTupleVariant for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeMap for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_key<T: Serialize + ?Sized>(&mut self, key: &T) -> Result<(), CodecError> {
+        self.element(key)
+    }
+
+    fn serialize_value<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), CodecError> {
+        value.serialize(&mut self.ser)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeStruct for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        key: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.element(key)?;
+        value.serialize(&mut self.ser)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+impl ser::SerializeStructVariant for Compound<'_> {
+    type Ok = ();
+    type Error = CodecError;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        key: &'static str,
+        value: &T,
+    ) -> Result<(), CodecError> {
+        self.element(key)?;
+        value.serialize(&mut self.ser)
+    }
+
+    fn end(self) -> Result<(), CodecError> {
+        self.finish()
+    }
+}
+
+// ============================================================================
+// Deserializer
+// ============================================================================
+
+struct Deserializer<'de> {
+    input: &'de [u8],
+    pos: usize,
+    depth: usize,
+}
+
+impl<'de> Deserializer<'de> {
+    fn eof() -> CodecError {
+        CodecError::Deserialization("unexpected end of msgpack input".to_string())
+    }
+
+    fn peek(&self) -> Result<u8, CodecError> {
+        self.input.get(self.pos).copied().ok_or_else(Self::eof)
+    }
+
+    fn take(&mut self, n: usize) -> Result<&'de [u8], CodecError> {
+        let end = self.pos.checked_add(n).ok_or_else(Self::eof)?;
+        let bytes = self.input.get(self.pos..end).ok_or_else(Self::eof)?;
+        self.pos = end;
+        Ok(bytes)
+    }
+
+    fn take_array<const N: usize>(&mut self) -> Result<[u8; N], CodecError> {
+        let mut bytes = [0; N];
+        bytes.copy_from_slice(self.take(N)?);
+        Ok(bytes)
+    }
+
+    fn read_u8(&mut self) -> Result<u8, CodecError> {
+        Ok(self.take_array::<1>()?[0])
+    }
+
+    fn read_len(&mut self, width: usize) -> Result<usize, CodecError> {
+        Ok(match width {
+            1 => self.read_u8()? as usize,
+            2 => u16::from_be_bytes(self.take_array()?) as usize,
+            _ => u32::from_be_bytes(self.take_array()?) as usize,
+        })
+    }
+
+    fn read_str(&mut self, len: usize) -> Result<&'de str, CodecError> {
+        std::str::from_utf8(self.take(len)?)
+            .map_err(|e| CodecError::Deserialization(format!("invalid UTF-8 string: {e}")))
+    }
+
+    /// Length of a string at the cursor, or `None` if the next value is not one
+    fn str_len(&mut self, marker: u8) -> Result<Option<usize>, CodecError> {
+        Ok(match marker {
+            0xa0..=0xbf => Some((marker & 0x1f) as usize),
+            0xd9 => Some(self.read_len(1)?),
+            0xda => Some(self.read_len(2)?),
+            0xdb => Some(self.read_len(4)?),
+            _ => None,
+        })
+    }
+
+    /// Entry count of a map at the cursor, or `None` if the next value is not one
+    fn map_len(&mut self, marker: u8) -> Result<Option<usize>, CodecError> {
+        Ok(match marker {
+            0x80..=0x8f => Some((marker & 0x0f) as usize),
+            0xde => Some(self.read_len(2)?),
+            0xdf => Some(self.read_len(4)?),
+            _ => None,
+        })
+    }
+
+    fn enter(&mut self) -> Result<(), CodecError> {
+        self.depth += 1;
+        if self.depth > MAX_DEPTH {
+            return Err(CodecError::Deserialization(
+                "msgpack nesting exceeds recursion limit".to_string(),
+            ));
+        }
+        Ok(())
+    }
+
+    fn visit_seq<V: Visitor<'de>>(
+        &mut self,
+        len: usize,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.enter()?;
+        let mut access = Counted {
+            de: self,
+            remaining: len,
+        };
+        let value = visitor.visit_seq(&mut access)?;
+        let remaining = access.remaining;
+        self.depth -= 1;
+        if remaining != 0 {
+            return Err(de::Error::invalid_length(len, &"fewer elements in array"));
+        }
+        Ok(value)
+    }
+
+    fn visit_map<V: Visitor<'de>>(
+        &mut self,
+        len: usize,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.enter()?;
+        let mut access = Counted {
+            de: self,
+            remaining: len,
+        };
+        let value = visitor.visit_map(&mut access)?;
+        let remaining = access.remaining;
+        self.depth -= 1;
+        if remaining != 0 {
+            return Err(de::Error::invalid_length(len, &"fewer entries in map"));
+        }
+        Ok(value)
+    }
+}
+
+impl<'de> de::Deserializer<'de> for &mut Deserializer<'de> {
+    type Error = CodecError;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        let marker = self.read_u8()?;
+        if let Some(len) = self.str_len(marker)? {
+            return visitor.visit_borrowed_str(self.read_str(len)?);
+        }
+        if let Some(len) = self.map_len(marker)? {
+            return self.visit_map(len, visitor);
+        }
+        match marker {
+            0x00..=0x7f => visitor.visit_u64(marker.into()),
+            0xe0..=0xff => visitor.visit_i64((marker as i8).into()),
+            0x90..=0x9f => self.visit_seq((marker & 0x0f) as usize, visitor),
+            0xdc => {
+                let len = self.read_len(2)?;
+                self.visit_seq(len, visitor)
+            }
+            0xdd => {
+                let len = self.read_len(4)?;
+                self.visit_seq(len, visitor)
+            }
+            0xc0 => visitor.visit_unit(),
+            0xc2 => visitor.visit_bool(false),
+            0xc3 => visitor.visit_bool(true),
+            0xc4..=0xc6 => {
+                let len = self.read_len(1 << (marker - 0xc4))?;
+                visitor.visit_borrowed_bytes(self.take(len)?)
+            }
+            0xca => visitor.visit_f32(f32::from_be_bytes(self.take_array()?)),
+            0xcb => visitor.visit_f64(f64::from_be_bytes(self.take_array()?)),
+            0xcc => visitor.visit_u64(self.read_u8()?.into()),
+            0xcd => visitor.visit_u64(u16::from_be_bytes(self.take_array()?).into()),
+            0xce => visitor.visit_u64(u32::from_be_bytes(self.take_array()?).into()),
+            0xcf => visitor.visit_u64(u64::from_be_bytes(self.take_array()?)),
+            0xd0 => visitor.visit_i64((self.read_u8()? as i8).into()),
+            0xd1 => visitor.visit_i64(i16::from_be_bytes(self.take_array()?).into()),
+            0xd2 => visitor.visit_i64(i32::from_be_bytes(self.take_array()?).into()),
+            0xd3 => visitor.visit_i64(i64::from_be_bytes(self.take_array()?)),
+            other => Err(CodecError::InvalidFormat(format!(
+                "unsupported msgpack marker 0x{other:02x}"
+            ))),
+        }
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, CodecError> {
+        if self.peek()? == 0xc0 {
+            self.pos += 1;
+            visitor.visit_none()
+        } else {
+            visitor.visit_some(self)
+        }
+    }
+
+    fn deserialize_newtype_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        visitor.visit_newtype_struct(self)
+    }
+
+    fn deserialize_enum<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _variants: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        let marker = self.read_u8()?;
+        if let Some(len) = self.str_len(marker)? {
+            let variant = self.read_str(len)?;
+            return visitor.visit_enum(variant.into_deserializer());
+        }
+        match self.map_len(marker)? {
+            Some(1) => {
+                self.enter()?;
+                let value = visitor.visit_enum(Enum { de: &mut *self })?;
+                self.depth -= 1;
+                Ok(value)
+            }
+            _ => Err(CodecError::Deserialization(
+                "expected enum variant name or single-entry map".to_string(),
+            )),
+        }
+    }
+
+    serde::forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf unit unit_struct seq tuple tuple_struct map struct
+        identifier ignored_any
+    }
+}
+
+/// Sequence and map access over a known number of elements
+struct Counted<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    remaining: usize,
+}
+
+impl<'de> SeqAccess<'de> for Counted<'_, 'de> {
+    type Error = CodecError;
+
+    fn next_element_seed<T: DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>, CodecError> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+impl<'de> MapAccess<'de> for Counted<'_, 'de> {
+    type Error = CodecError;
+
+    fn next_key_seed<K: DeserializeSeed<'de>>(
+        &mut self,
+        seed: K,
+    ) -> Result<Option<K::Value>, CodecError> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+
+    fn next_value_seed<V: DeserializeSeed<'de>>(
+        &mut self,
+        seed: V,
+    ) -> Result<V::Value, CodecError> {
+        seed.deserialize(&mut *self.de)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+/// Access to a `{variant: content}` map for non-unit enum variants
+struct Enum<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+}
+
+impl<'de> EnumAccess<'de> for Enum<'_, 'de> {
+    type Error = CodecError;
+    type Variant = Self;
+
+    fn variant_seed<V: DeserializeSeed<'de>>(
+        self,
+        seed: V,
+    ) -> Result<(V::Value, Self), CodecError> {
+        let variant = seed.deserialize(&mut *self.de)?;
+        Ok((variant, self))
+    }
+}
+
+impl<'de> VariantAccess<'de> for Enum<'_, 'de> {
+    type Error = CodecError;
+
+    fn unit_variant(self) -> Result<(), CodecError> {
+        <()>::deserialize(&mut *self.de)
+    }
+
+    fn newtype_variant_seed<T: DeserializeSeed<'de>>(
+        self,
+        seed: T,
+    ) -> Result<T::Value, CodecError> {
+        seed.deserialize(&mut *self.de)
+    }
+
+    fn tuple_variant<V: Visitor<'de>>(
+        self,
+        _len: usize,
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.de.deserialize_any(visitor)
+    }
+
+    fn struct_variant<V: Visitor<'de>>(
+        self,
+        _fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, CodecError> {
+        self.de.deserialize_any(visitor)
+    }
+}
+
+#[cfg(test)]
+#[path = "msgpack/msgpack_tests.rs"]
+mod msgpack_tests;
@@ -0,0 +1,204 @@
+#![allow(non_snake_case)]
+
+use super::*;
+use serde::{Deserialize, Serialize};
+use std::collections::BTreeMap;
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct TestMessage {
+    id: u64,
+    name: String,
+    tags: Vec<String>,
+    score: f64,
+    parent: Option<u32>,
+}
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+enum Shape {
+    Empty,
+    Circle(f32),
+    Rect { w: u16, h: u16 },
+    Pair(i8, i8),
+}
+
+#[derive(Debug, PartialEq, Deserialize)]
+struct Borrowed<'a> {
+    name: &'a str,
+    data: &'a [u8],
+}
+
+fn sample() -> TestMessage {
+    TestMessage {
+        id: 42,
+        name: "test".to_string(),
+        tags: vec!["a".to_string(), "b".to_string()],
+        score: 0.5,
+        parent: None,
+    }
+}
+
+// Wire format tests
+
+#[test]
+fn to_vec___small_scalars___use_fix_encodings() {
+    assert_eq!(to_vec(&7u8).unwrap(), [0x07]);
+    assert_eq!(to_vec(&-3i32).unwrap(), [0xfd]);
+    assert_eq!(to_vec(&true).unwrap(), [0xc3]);
+    assert_eq!(to_vec(&()).unwrap(), [0xc0]);
+    assert_eq!(to_vec("hi").unwrap(), [0xa2, b'h', b'i']);
+}
+
+#[test]
+fn to_vec___integers___pick_smallest_width() {
+    assert_eq!(to_vec(&200u64).unwrap(), [0xcc, 200]);
+    assert_eq!(to_vec(&300u64).unwrap(), [0xcd, 0x01, 0x2c]);
+    assert_eq!(to_vec(&-100i64).unwrap(), [0xd0, 0x9c]);
+    assert_eq!(to_vec(&u64::MAX).unwrap()[0], 0xcf);
+    assert_eq!(to_vec(&i64::MIN).unwrap()[0], 0xd3);
+}
+
+#[test]
+fn to_vec___struct___encodes_as_map_with_field_names() {
+    #[derive(Serialize)]
+    struct Point {
+        x: u8,
+    }
+
+    let encoded = to_vec(&Point { x: 1 }).unwrap();
+
+    assert_eq!(encoded, [0x81, 0xa1, b'x', 0x01]);
+}
+
+#[test]
+fn to_vec___long_string___uses_str8_header() {
+    let value = "x".repeat(40);
+
+    let encoded = to_vec(&value).unwrap();
+
+    assert_eq!(&encoded[..2], &[0xd9, 40]);
+    assert_eq!(encoded.len(), 42);
+}
+
+#[test]
+fn to_vec___unknown_length_seq___patches_array32_count() {
+    struct Evens;
+
+    impl Serialize for Evens {
+        fn serialize<S: serde::Serializer>(&self, s: S) -> Result<S::Ok, S::Error> {
+            s.collect_seq((0u8..10).filter(|n| n % 2 == 0))
+        }
+    }
+
+    let encoded = to_vec(&Evens).unwrap();
+
+    assert_eq!(&encoded[..5], &[0xdd, 0, 0, 0, 5]);
+    let decoded: Vec<u8> = from_slice(&encoded).unwrap();
+    assert_eq!(decoded, vec![0, 2, 4, 6, 8]);
+}
+
+// Roundtrip tests
+
+#[test]
+fn MsgPackCodec___encode_decode___roundtrip_preserves_data() {
+    let codec = MsgPackCodec::new();
+    let original = sample();
+
+    let encoded = codec.encode(&original).unwrap();
+    let decoded: TestMessage = codec.decode(&encoded).unwrap();
+
+    assert_eq!(original, decoded);
+}
+
+#[test]
+fn MsgPackCodec___encode___smaller_than_json() {
+    let original = sample();
+
+    let msgpack = MsgPackCodec::new().encode(&original).unwrap();
+    let json = serde_json::to_vec(&original).unwrap();
+
+    assert!(msgpack.len() < json.len());
+}
+
+#[test]
+fn MsgPackCodec___enums___roundtrip_every_variant_shape() {
+    let shapes = vec![
+        Shape::Empty,
+        Shape::Circle(1.5),
+        Shape::Rect { w: 3, h: 4 },
+        Shape::Pair(-1, 1),
+    ];
+
+    let encoded = to_vec(&shapes).unwrap();
+    let decoded: Vec<Shape> = from_slice(&encoded).unwrap();
+
+    assert_eq!(decoded, shapes);
+}
+
+#[test]
+fn MsgPackCodec___maps_and_json_values___roundtrip() {
+    let mut map = BTreeMap::new();
+    map.insert(
+        "one".to_string(),
+        serde_json::json!({"nested": [1, -2, 3.5, null]}),
+    );
+
+    let encoded = to_vec(&map).unwrap();
+    let decoded: BTreeMap<String, serde_json::Value> = from_slice(&encoded).unwrap();
+
+    assert_eq!(decoded, map);
+}
+
+#[test]
+fn MsgPackCodec___decode_borrowed___borrows_strings_and_bytes() {
+    let mut encoded = vec![0x82];
+    encoded.extend(to_vec("name").unwrap());
+    encoded.extend(to_vec("zero-copy").unwrap());
+    encoded.extend(to_vec("data").unwrap());
+    encoded.extend([0xc4, 3, 1, 2, 3]);
+
+    let decoded: Borrowed<'_> = MsgPackCodec::new().decode_borrowed(&encoded).unwrap();
+
+    assert_eq!(decoded.name, "zero-copy");
+    assert_eq!(decoded.data, &[1, 2, 3]);
+    assert!(encoded.as_ptr_range().contains(&decoded.name.as_ptr()));
+}
+
+#[test]
+fn MsgPackCodec___content_type___returns_msgpack() {
+    assert_eq!(MsgPackCodec::new().content_type(), "application/msgpack");
+}
+
+// Error tests
+
+#[test]
+fn from_slice___truncated_input___returns_error() {
+    let encoded = to_vec(&sample()).unwrap();
+
+    let result: Result<TestMessage, _> = from_slice(&encoded[..encoded.len() - 1]);
+
+    assert!(matches!(result, Err(CodecError::Deserialization(_))));
+}
+
+#[test]
+fn from_slice___trailing_bytes___returns_invalid_format() {
+    let result: Result<u8, _> = from_slice(&[0x01, 0x02]);
+
+    assert!(matches!(result, Err(CodecError::InvalidFormat(_))));
+}
+
+#[test]
+fn from_slice___deep_nesting___hits_recursion_limit() {
+    let mut encoded = vec![0x91; MAX_DEPTH + 1];
+    encoded.push(0xc0);
+
+    let result: Result<serde_json::Value, _> = from_slice(&encoded);
+
+    assert!(result.is_err());
+}
+
+#[test]
+fn from_slice___ext_marker___returns_invalid_format() {
+    let result: Result<serde_json::Value, _> = from_slice(&[0xd4, 0x01, 0x00]);
+
+    assert!(matches!(result, Err(CodecError::InvalidFormat(_))));
+}
@@ -7,6 +7,7 @@
 //! - Mandatory async (Tokio) runtime
 //! - Logging callbacks to host language
 //! - JSON-based data transport with optional binary transport
+//! - MessagePack and flat binary codecs negotiated per call (see [`codec`])
 //!
 //! ## Quick Start
 //!
@@ -78,13 +79,15 @@
 //!
 //! This is a facade crate that re-exports from:
 //! - [`rustbridge_core`] - Core traits, types, and lifecycle
-//! - [`rustbridge_macros`] - Procedural macros (`Message`, `rustbridge_entry!`)
+//! - [`rustbridge_macros`] - Procedural macros (`Message`, `rustbridge_plugin`, `rustbridge_entry!`)
 //! - [`rustbridge_ffi`] - FFI exports and buffer management
+//! - [`rustbridge_transport`] - JSON and binary payload codecs
 
 // Re-export core types
 pub use rustbridge_core::{
-    LifecycleState, LogLevel, Plugin, PluginConfig, PluginContext, PluginError, PluginFactory,
-    PluginMetadata, PluginResult, RequestContext, ResponseBuilder,
+    BoxResponseStream, ContentType, IterStream, LifecycleState, LogLevel, OnceStream, Plugin,
+    PluginConfig, PluginContext, PluginError, PluginFactory, PluginMetadata, PluginResult,
+    RequestContext, RequestReader, ResponseBuilder, ResponseStream,
 };
 
 // Re-export macros
@@ -92,8 +95,14 @@ pub use rustbridge_macros::{
     Message, impl_plugin, rustbridge_entry, rustbridge_handler, rustbridge_plugin,
 };
 
+// Re-export the type tag table used by `#[rustbridge_plugin]` dispatchers
+pub use rustbridge_transport::TagTable;
+
 // Re-export FFI types
-pub use rustbridge_ffi::{FfiBuffer, PluginHandle, PluginHandleManager, register_binary_handler};
+pub use rustbridge_ffi::{
+    BinaryLayout, BinaryStruct, FfiBuffer, PluginHandle, PluginHandleManager,
+    register_binary_handler, register_binary_into_handler, register_binary_request,
+};
 
 // Re-export common dependencies that plugin authors need
 pub use async_trait::async_trait;
@@ -108,9 +117,25 @@ pub use tracing;
 /// to expose the required FFI functions for the shared library.
 pub mod ffi_exports {
     pub use rustbridge_ffi::{
-        plugin_call, plugin_call_async, plugin_call_raw, plugin_cancel_async, plugin_free_buffer,
-        plugin_get_rejected_count, plugin_get_state, plugin_init, plugin_set_log_level,
-        plugin_shutdown, rb_response_free,
+        plugin_call, plugin_call_as, plugin_call_async, plugin_call_id, plugin_call_raw,
+        plugin_call_raw_batch, plugin_call_raw_into, plugin_cancel_async, plugin_free_buffer,
+        plugin_get_admission_stats, plugin_get_dropped_log_count, plugin_get_metrics,
+        plugin_get_rejected_count, plugin_get_slow_calls, plugin_get_state, plugin_init,
+        plugin_input_abort, plugin_input_finish, plugin_input_open, plugin_input_write,
+        plugin_resolve_type_tag, plugin_ring_close, plugin_ring_notify, plugin_ring_open,
+        plugin_ring_wait, plugin_set_log_batch_callback, plugin_set_log_level, plugin_shutdown,
+        plugin_stream_close, plugin_stream_next, plugin_stream_open, rb_response_free,
+    };
+}
+
+/// Payload codecs for implementing [`Plugin::handle_request_as`].
+///
+/// [`encode_as`](codec::encode_as) and [`decode_as`](codec::decode_as) pick the
+/// codec from the [`ContentType`] the host negotiated.
+pub mod codec {
+    pub use rustbridge_transport::{
+        Codec, CodecError, FlatCodec, FlatKind, FlatView, JsonCodec, MsgPackCodec, decode_as,
+        encode_as,
     };
 }
 
@@ -0,0 +1,202 @@
+//! Compiled checks for the dispatcher `#[rustbridge_plugin]` generates
+//!
+//! The plugin below goes through the real macro expansion, so the generated
+//! tag table, payload decoding, sync and async routing and the binary
+//! handler registration injected into `on_start` are all built against the
+//! facade crate and exercised through a `PluginHandle`.
+
+#![allow(non_snake_case)]
+
+use rustbridge::codec::{decode_as, encode_as};
+use rustbridge::ffi_exports::{plugin_call_raw, plugin_shutdown, rb_response_free};
+use rustbridge::prelude::*;
+use rustbridge::{ContentType, PluginHandle, PluginHandleManager};
+use std::ffi::c_void;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+const MSG_DOUBLE: u32 = 0x5101;
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct AddRequest {
+    a: i64,
+    b: i64,
+}
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct AddResponse {
+    sum: i64,
+}
+
+#[derive(Debug, PartialEq, Serialize, Deserialize)]
+struct StatusResponse {
+    state: String,
+}
+
+/// Number of times `MacroPlugin::on_start` has run, across all tests
+static STARTS: AtomicUsize = AtomicUsize::new(0);
+
+struct MacroPlugin;
+
+#[rustbridge_plugin]
+impl Plugin for MacroPlugin {
+    async fn on_start(&self, _ctx: &PluginContext) -> PluginResult<()> {
+        STARTS.fetch_add(1, Ordering::SeqCst);
+        Ok(())
+    }
+
+    #[rustbridge_handler("math.add")]
+    fn add(&self, request: AddRequest) -> PluginResult<AddResponse> {
+        Ok(AddResponse {
+            sum: request.a + request.b,
+        })
+    }
+
+    #[rustbridge_handler("plugin.status")]
+    async fn status(&self, ctx: &PluginContext) -> PluginResult<StatusResponse> {
+        tokio::task::yield_now().await;
+        Ok(StatusResponse {
+            state: ctx.state().to_string(),
+        })
+    }
+
+    #[rustbridge_handler(binary = 0x5101)]
+    fn double(_handle: &PluginHandle, request: &[u8]) -> PluginResult<Vec<u8>> {
+        Ok(request.iter().map(|b| b.wrapping_mul(2)).collect())
+    }
+}
+
+fn started_plugin() -> (u64, Arc<PluginHandle>) {
+    let handle = PluginHandle::new(Box::new(MacroPlugin), PluginConfig::default()).unwrap();
+    handle.start().unwrap();
+    let id = PluginHandleManager::global().register(handle);
+    assert_ne!(id, 0);
+    let handle = PluginHandleManager::global().get(id).unwrap();
+    (id, handle)
+}
+
+fn shutdown(id: u64) {
+    // SAFETY: id was registered by started_plugin and is shut down once
+    assert!(unsafe { plugin_shutdown(id as *mut c_void) });
+}
+
+// Type tag dispatch
+
+#[test]
+fn rustbridge_plugin___sync_handler___decodes_json_request() {
+    let (id, handle) = started_plugin();
+
+    let response = handle.call("math.add", br#"{"a": 2, "b": 40}"#).unwrap();
+
+    let response: AddResponse = serde_json::from_slice(&response).unwrap();
+    assert_eq!(response, AddResponse { sum: 42 });
+    shutdown(id);
+}
+
+#[test]
+fn rustbridge_plugin___async_handler___receives_context() {
+    let (id, handle) = started_plugin();
+
+    let response = handle.call("plugin.status", b"{}").unwrap();
+
+    let response: StatusResponse = serde_json::from_slice(&response).unwrap();
+    assert_eq!(response.state, LifecycleState::Active.to_string());
+    shutdown(id);
+}
+
+#[test]
+fn rustbridge_plugin___msgpack_request___answered_in_msgpack() {
+    let (id, handle) = started_plugin();
+    let request = encode_as(ContentType::MsgPack, &AddRequest { a: 1, b: 2 }).unwrap();
+
+    let response = handle
+        .call_as("math.add", ContentType::MsgPack, &request)
+        .unwrap();
+
+    let response: AddResponse = decode_as(ContentType::MsgPack, &response).unwrap();
+    assert_eq!(response, AddResponse { sum: 3 });
+    shutdown(id);
+}
+
+#[test]
+fn rustbridge_plugin___unknown_tag___returns_unknown_message_type() {
+    let (id, handle) = started_plugin();
+
+    let result = handle.call("math.sub", b"{}");
+
+    assert!(matches!(result, Err(PluginError::UnknownMessageType(tag)) if tag == "math.sub"));
+    shutdown(id);
+}
+
+#[test]
+fn rustbridge_plugin___invalid_payload___returns_serialization_error() {
+    let (id, handle) = started_plugin();
+
+    let result = handle.call("math.add", br#"{"a": "two"}"#);
+
+    assert!(matches!(result, Err(PluginError::SerializationError(_))));
+    shutdown(id);
+}
+
+// Generated trait methods
+
+#[test]
+fn rustbridge_plugin___handle_request_sync___answers_only_non_async_handlers() {
+    let plugin = MacroPlugin;
+    let ctx = PluginContext::new(PluginConfig::default());
+
+    let sync = plugin.handle_request_sync(&ctx, "math.add", br#"{"a": 1, "b": 1}"#);
+    let not_sync = plugin.handle_request_sync(&ctx, "plugin.status", b"{}");
+    let unknown = plugin.handle_request_sync(&ctx, "math.sub", b"{}");
+
+    assert!(matches!(sync, Some(Ok(_))));
+    assert!(not_sync.is_none());
+    assert!(unknown.is_none());
+}
+
+#[test]
+fn rustbridge_plugin___supported_types___lists_type_tag_handlers() {
+    let plugin = MacroPlugin;
+
+    let mut types = plugin.supported_types();
+    types.sort_unstable();
+
+    assert_eq!(types, vec!["math.add", "plugin.status"]);
+}
+
+// on_start injection and binary handlers
+
+#[test]
+fn rustbridge_plugin___on_start___runs_the_plugin_body() {
+    let before = STARTS.load(Ordering::SeqCst);
+
+    let (id, _handle) = started_plugin();
+
+    assert!(STARTS.load(Ordering::SeqCst) > before);
+    shutdown(id);
+}
+
+#[test]
+fn rustbridge_plugin___binary_handler___registered_at_start() {
+    let (id, _handle) = started_plugin();
+    let request = [1u8, 2, 3, 4];
+
+    // SAFETY: id is a live handle and request is valid for its length
+    let mut response = unsafe {
+        plugin_call_raw(
+            id as *mut c_void,
+            MSG_DOUBLE,
+            request.as_ptr() as *const c_void,
+            request.len(),
+        )
+    };
+
+    assert_eq!(response.error_code, 0);
+    // SAFETY: a successful response holds len bytes at data
+    let data =
+        unsafe { std::slice::from_raw_parts(response.data as *const u8, response.len as usize) };
+    assert_eq!(data, &[2, 4, 6, 8]);
+    // SAFETY: response came from plugin_call_raw and is freed once
+    unsafe { rb_response_free(&mut response) };
+    shutdown(id);
+}
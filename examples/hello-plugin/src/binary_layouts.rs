@@ -0,0 +1,37 @@
+// Auto-generated by rustbridge generate-header
+// Source: binary_messages.rs
+// DO NOT EDIT - regenerate with: rustbridge generate-header --layouts
+//
+// Include from the source file: include!("<this file>");
+
+// SAFETY: generated from the definition of SmallRequestRaw, whose fields are
+// valid for any bit pattern
+unsafe impl rustbridge::BinaryStruct for SmallRequestRaw {
+    const LAYOUT: rustbridge::BinaryLayout = rustbridge::BinaryLayout {
+        name: "SmallRequestRaw",
+        size: ::core::mem::size_of::<SmallRequestRaw>(),
+        align: ::core::mem::align_of::<SmallRequestRaw>(),
+        version: Some((
+            ::core::mem::offset_of!(SmallRequestRaw, version),
+            SmallRequestRaw::VERSION,
+        )),
+        strings: &[],
+        bytes: &[],
+    };
+}
+
+// SAFETY: generated from the definition of SmallResponseRaw, whose fields are
+// valid for any bit pattern
+unsafe impl rustbridge::BinaryStruct for SmallResponseRaw {
+    const LAYOUT: rustbridge::BinaryLayout = rustbridge::BinaryLayout {
+        name: "SmallResponseRaw",
+        size: ::core::mem::size_of::<SmallResponseRaw>(),
+        align: ::core::mem::align_of::<SmallResponseRaw>(),
+        version: Some((
+            ::core::mem::offset_of!(SmallResponseRaw, version),
+            SmallResponseRaw::VERSION,
+        )),
+        strings: &[],
+        bytes: &[],
+    };
+}
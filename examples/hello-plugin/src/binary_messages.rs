@@ -10,8 +10,20 @@
 //! | bench.small | 1 |
 //! | bench.medium | 2 |
 //! | bench.large | 3 |
+//!
+//! Request layouts are checked at dispatch using the `BinaryStruct` impls in
+//! `binary_layouts.rs`, generated with:
+//!
+//! ```bash
+//! rustbridge generate-header --source src/binary_messages.rs \
+//!     --output messages.h --layouts src/binary_layouts.rs
+//! ```
+
+use rustbridge::{
+    BinaryStruct, PluginHandle, PluginResult, register_binary_handler, register_binary_request,
+};
 
-use rustbridge::{PluginError, PluginHandle, PluginResult, register_binary_handler};
+include!("binary_layouts.rs");
 
 /// Message ID for small benchmark
 pub const MSG_BENCH_SMALL: u32 = 1;
@@ -128,29 +140,20 @@ impl SmallResponseRaw {
 /// for benchmark messages.
 pub fn register_benchmark_handlers() {
     register_binary_handler(MSG_BENCH_SMALL, handle_bench_small_raw);
+    register_binary_request::<SmallRequestRaw>(MSG_BENCH_SMALL);
     // TODO: Add medium and large handlers when needed
 }
 
 /// Handle small benchmark request (binary transport)
 fn handle_bench_small_raw(_handle: &PluginHandle, request: &[u8]) -> PluginResult<Vec<u8>> {
-    // Validate request size
-    if request.len() < std::mem::size_of::<SmallRequestRaw>() {
-        return Err(PluginError::HandlerError("Request too small".to_string()));
-    }
-
-    // SAFETY: We validated the size, and SmallRequestRaw is repr(C)
-    let req = unsafe { &*(request.as_ptr() as *const SmallRequestRaw) };
-
-    // Validate version for forward compatibility
-    if req.version != SmallRequestRaw::VERSION {
-        return Err(PluginError::HandlerError(format!(
-            "Unsupported request version: {} (expected {})",
-            req.version,
-            SmallRequestRaw::VERSION
-        )));
-    }
+    // SAFETY: MSG_BENCH_SMALL is registered for SmallRequestRaw, so dispatch
+    // has already checked the size, alignment and version
+    let req = unsafe { SmallRequestRaw::from_request(request) };
+    Ok(respond_small(req))
+}
 
-    // Process request (same logic as JSON handler)
+/// Process a small request (same logic as JSON handler)
+fn respond_small(req: &SmallRequestRaw) -> Vec<u8> {
     let key = req.key_str();
     let value = format!("value_for_{}", key);
     let cache_hit = req.flags & 1 != 0;
@@ -165,7 +168,7 @@ fn handle_bench_small_raw(_handle: &PluginHandle, request: &[u8]) -> PluginResul
         )
     };
 
-    Ok(response_bytes.to_vec())
+    response_bytes.to_vec()
 }
 
 // ============================================================================
@@ -221,22 +224,20 @@ mod tests {
         assert_eq!(size, 80);
     }
 
-    #[test]
-    fn handler___handle_bench_small_raw___processes_request() {
-        let req = SmallRequestRaw::new("my_key", 0x01);
-        let req_bytes = unsafe {
+    fn request_bytes(req: &SmallRequestRaw) -> &[u8] {
+        unsafe {
             std::slice::from_raw_parts(
-                &req as *const SmallRequestRaw as *const u8,
+                req as *const SmallRequestRaw as *const u8,
                 std::mem::size_of::<SmallRequestRaw>(),
             )
-        };
+        }
+    }
 
-        // Create a dummy plugin handle for testing
-        // Note: This test uses a simplified approach without a real handle
-        // In practice, the handler would use the handle for state access
+    #[test]
+    fn handler___respond_small___processes_request() {
+        let req = SmallRequestRaw::new("my_key", 0x01);
 
-        // For this test, we just verify the request/response serialization
-        let response_bytes = handle_bench_small_raw_test(req_bytes).unwrap();
+        let response_bytes = respond_small(&req);
 
         assert_eq!(
             response_bytes.len(),
@@ -249,54 +250,32 @@ mod tests {
         assert_eq!(resp.cache_hit, 1); // flags & 1 != 0
     }
 
-    // Test helper that doesn't require PluginHandle
-    fn handle_bench_small_raw_test(request: &[u8]) -> PluginResult<Vec<u8>> {
-        if request.len() < std::mem::size_of::<SmallRequestRaw>() {
-            return Err(PluginError::HandlerError("Request too small".to_string()));
-        }
+    #[test]
+    fn layout___SmallRequestRaw___accepts_current_version() {
+        let req = SmallRequestRaw::new("my_key", 0x01);
 
-        let req = unsafe { &*(request.as_ptr() as *const SmallRequestRaw) };
+        let result = unsafe { SmallRequestRaw::LAYOUT.check(request_bytes(&req)) };
 
-        // Validate version
-        if req.version != SmallRequestRaw::VERSION {
-            return Err(PluginError::HandlerError(format!(
-                "Unsupported request version: {} (expected {})",
-                req.version,
-                SmallRequestRaw::VERSION
-            )));
-        }
+        assert!(result.is_ok());
+    }
 
-        let key = req.key_str();
-        let value = format!("value_for_{}", key);
-        let cache_hit = req.flags & 1 != 0;
+    #[test]
+    fn layout___SmallRequestRaw___rejects_invalid_version() {
+        let mut req = SmallRequestRaw::new("my_key", 0x01);
+        req.version = 99; // Invalid version
 
-        let response = SmallResponseRaw::new(&value, 3600, cache_hit);
-        let response_bytes = unsafe {
-            std::slice::from_raw_parts(
-                &response as *const SmallResponseRaw as *const u8,
-                std::mem::size_of::<SmallResponseRaw>(),
-            )
-        };
+        let result = unsafe { SmallRequestRaw::LAYOUT.check(request_bytes(&req)) };
 
-        Ok(response_bytes.to_vec())
+        let err = result.unwrap_err();
+        assert!(err.to_string().contains("unsupported version 99"));
     }
 
     #[test]
-    fn handler___handle_bench_small_raw___rejects_invalid_version() {
-        let mut req = SmallRequestRaw::new("my_key", 0x01);
-        req.version = 99; // Invalid version
+    fn layout___SmallRequestRaw___rejects_short_request() {
+        let req = SmallRequestRaw::new("my_key", 0x01);
 
-        let req_bytes = unsafe {
-            std::slice::from_raw_parts(
-                &req as *const SmallRequestRaw as *const u8,
-                std::mem::size_of::<SmallRequestRaw>(),
-            )
-        };
+        let result = unsafe { SmallRequestRaw::LAYOUT.check(&request_bytes(&req)[..8]) };
 
-        let result = handle_bench_small_raw_test(req_bytes);
         assert!(result.is_err());
-
-        let err = result.unwrap_err();
-        assert!(err.to_string().contains("Unsupported request version"));
     }
 }
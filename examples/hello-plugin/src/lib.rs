@@ -4,7 +4,7 @@
 //! including message handling, lifecycle management, and FFI integration.
 
 use rustbridge::prelude::*;
-use rustbridge::{PluginMetadata, serde_json, tokio, tracing};
+use rustbridge::{ContentType, PluginMetadata, codec, serde_json, tokio, tracing};
 
 pub mod binary_messages;
 
@@ -200,6 +200,35 @@ impl HelloPlugin {
         Self::default()
     }
 
+    /// Dispatch the requests whose handlers never await
+    ///
+    /// Returns `None` for `test.sleep` and unknown tags, which go through
+    /// the async `handle_request`.
+    fn dispatch_sync(&self, type_tag: &str, payload: &[u8]) -> Option<PluginResult<Vec<u8>>> {
+        self.dispatch_as(type_tag, ContentType::Json, payload)
+    }
+
+    /// Dispatch a request encoded as `content_type` to a synchronous handler
+    fn dispatch_as(
+        &self,
+        type_tag: &str,
+        content_type: ContentType,
+        payload: &[u8],
+    ) -> Option<PluginResult<Vec<u8>>> {
+        let ct = content_type;
+        match type_tag {
+            "echo" => Some(call_as(ct, payload, |req| self.handle_echo(req))),
+            "greet" => Some(call_as(ct, payload, |req| self.handle_greet(req))),
+            "user.create" => Some(call_as(ct, payload, |req| self.handle_create_user(req))),
+            "math.add" => Some(call_as(ct, payload, |req| self.handle_add(req))),
+            // Benchmark handlers
+            "bench.small" => Some(call_as(ct, payload, |req| self.handle_bench_small(req))),
+            "bench.medium" => Some(call_as(ct, payload, |req| self.handle_bench_medium(req))),
+            "bench.large" => Some(call_as(ct, payload, |req| self.handle_bench_large(req))),
+            _ => None,
+        }
+    }
+
     /// Handle echo request
     fn handle_echo(&self, req: EchoRequest) -> PluginResult<EchoResponse> {
         tracing::debug!("Handling echo request: {:?}", req);
@@ -376,58 +405,48 @@ impl Plugin for HelloPlugin {
         Ok(())
     }
 
+    fn handle_request_sync(
+        &self,
+        _ctx: &PluginContext,
+        type_tag: &str,
+        payload: &[u8],
+    ) -> Option<PluginResult<Vec<u8>>> {
+        self.dispatch_sync(type_tag, payload)
+    }
+
     async fn handle_request(
         &self,
         _ctx: &PluginContext,
         type_tag: &str,
         payload: &[u8],
     ) -> PluginResult<Vec<u8>> {
+        if let Some(result) = self.dispatch_sync(type_tag, payload) {
+            return result;
+        }
         match type_tag {
-            "echo" => {
-                let req: EchoRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_echo(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
-            "greet" => {
-                let req: GreetRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_greet(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
-            "user.create" => {
-                let req: CreateUserRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_create_user(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
-            "math.add" => {
-                let req: AddRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_add(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
             "test.sleep" => {
                 let req: SleepRequest = serde_json::from_slice(payload)?;
                 let resp = self.handle_sleep(req).await?;
                 Ok(serde_json::to_vec(&resp)?)
             }
-            // Benchmark handlers
-            "bench.small" => {
-                let req: SmallRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_bench_small(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
-            "bench.medium" => {
-                let req: MediumRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_bench_medium(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
-            "bench.large" => {
-                let req: LargeRequest = serde_json::from_slice(payload)?;
-                let resp = self.handle_bench_large(req)?;
-                Ok(serde_json::to_vec(&resp)?)
-            }
             _ => Err(PluginError::UnknownMessageType(type_tag.to_string())),
         }
     }
 
+    async fn handle_request_as(
+        &self,
+        ctx: &PluginContext,
+        type_tag: &str,
+        content_type: ContentType,
+        payload: &[u8],
+    ) -> PluginResult<Vec<u8>> {
+        if content_type == ContentType::Json {
+            return self.handle_request(ctx, type_tag, payload).await;
+        }
+        self.dispatch_as(type_tag, content_type, payload)
+            .unwrap_or_else(|| Err(PluginError::UnknownMessageType(type_tag.to_string())))
+    }
+
     async fn on_stop(&self, _ctx: &PluginContext) -> PluginResult<()> {
         tracing::info!("HelloPlugin stopping...");
         tracing::info!("HelloPlugin stopped");
@@ -462,6 +481,21 @@ pub use rustbridge::ffi_exports::*;
 // Utilities
 // ============================================================================
 
+/// Decode a request, run the handler, and encode its response in the same format
+fn call_as<Req, Resp>(
+    content_type: ContentType,
+    payload: &[u8],
+    handler: impl FnOnce(Req) -> PluginResult<Resp>,
+) -> PluginResult<Vec<u8>>
+where
+    Req: serde::de::DeserializeOwned,
+    Resp: Serialize,
+{
+    let req: Req = codec::decode_as(content_type, payload)?;
+    let resp = handler(req)?;
+    Ok(codec::encode_as(content_type, &resp)?)
+}
+
 /// Simple timestamp function (avoiding chrono dependency for the example)
 fn chrono_lite_now() -> String {
     use std::time::{SystemTime, UNIX_EPOCH};
@@ -138,6 +138,57 @@ fn HelloPlugin___supported_types___includes_all_handlers() {
     assert!(types.contains(&"bench.large"));
 }
 
+// HelloPlugin::handle_request_as tests
+
+#[tokio::test]
+async fn HelloPlugin___handle_request_as___msgpack_echo_roundtrips() {
+    let plugin = HelloPlugin::new();
+    let ctx = create_test_context();
+    let request = codec::encode_as(
+        ContentType::MsgPack,
+        &EchoRequest {
+            message: "packed".to_string(),
+        },
+    )
+    .unwrap();
+
+    let response = plugin
+        .handle_request_as(&ctx, "echo", ContentType::MsgPack, &request)
+        .await
+        .unwrap();
+
+    let echo_response: EchoResponse = codec::decode_as(ContentType::MsgPack, &response).unwrap();
+    assert_eq!(echo_response.message, "packed");
+    assert_eq!(echo_response.length, 6);
+}
+
+#[tokio::test]
+async fn HelloPlugin___handle_request_as___flat_response_readable_in_place() {
+    let plugin = HelloPlugin::new();
+    let ctx = create_test_context();
+    let request = codec::encode_as(ContentType::Flat, &AddRequest { a: 2, b: 40 }).unwrap();
+
+    let response = plugin
+        .handle_request_as(&ctx, "math.add", ContentType::Flat, &request)
+        .await
+        .unwrap();
+
+    let view = codec::FlatView::new(&response).unwrap();
+    assert_eq!(view.get(0).and_then(|v| v.as_i64()), Some(42));
+}
+
+#[tokio::test]
+async fn HelloPlugin___handle_request_as___binary_async_only_tag_returns_error() {
+    let plugin = HelloPlugin::new();
+    let ctx = create_test_context();
+
+    let result = plugin
+        .handle_request_as(&ctx, "test.sleep", ContentType::MsgPack, &[0x80])
+        .await;
+
+    assert!(matches!(result, Err(PluginError::UnknownMessageType(_))));
+}
+
 // ============================================================================
 // Benchmark Handler Tests
 // ============================================================================
@@ -142,11 +142,14 @@ typedef struct {
  * Usage:
  * - error_code == 0: Success, data points to response struct
  * - error_code != 0: Error, data may point to null-terminated error message
+ *
+ * Fixed errors point to static messages with capacity 0. rb_response_free()
+ * is still safe to call on them and does nothing.
  */
 typedef struct {
     uint32_t error_code;    /* Error code (0 = success) */
     uint32_t len;           /* Size of response data in bytes */
-    uint32_t capacity;      /* Allocation capacity */
+    uint32_t capacity;      /* Allocation capacity (0 = static data, never freed) */
     void* data;             /* Pointer to response data (or error message) */
 } RbResponse;
 
@@ -165,6 +168,168 @@ typedef struct {
  */
 #define RB_RESPONSE_ERROR_MSG(r) ((const char*)(r).data)
 
+/* ============================================================================
+ * Batch Binary Transport
+ * ============================================================================ */
+
+/**
+ * Descriptor for one message in a plugin_call_raw_batch() call
+ *
+ * The request bytes are borrowed for the duration of the call.
+ */
+typedef struct {
+    uint32_t message_id;    /* Numeric message identifier */
+    uint32_t _reserved;     /* Reserved for alignment (must be zero) */
+    const void* request;    /* Pointer to request struct */
+    size_t request_size;    /* Size of request struct in bytes */
+} RbBatchRequest;
+
+/**
+ * Batch flag: dispatch the messages in parallel on the plugin's runtime
+ */
+#define RB_BATCH_PARALLEL 1u
+
+/* ============================================================================
+ * Admission Stats
+ * ============================================================================ */
+
+/**
+ * Number of buckets in RbAdmissionStats.wait_histogram_us
+ */
+#define RB_WAIT_HISTOGRAM_BUCKETS 24
+
+/**
+ * Admission control counters filled in by plugin_get_admission_stats()
+ *
+ * wait_histogram_us[i] counts queued requests that waited [2^(i-1), 2^i)
+ * microseconds; bucket 0 counts waits under 1 us and the last bucket also
+ * counts every longer wait.
+ */
+typedef struct {
+    uint64_t limit;         /* Maximum requests in flight (0 = unlimited) */
+    uint64_t in_flight;     /* Requests currently holding a slot */
+    uint64_t queue_depth;   /* Requests currently queued for a slot */
+    uint64_t admitted;      /* Requests admitted, directly or after queueing */
+    uint64_t queued;        /* Requests that had to queue */
+    uint64_t rejected;      /* Requests rejected, including timeouts */
+    uint64_t timed_out;     /* Queued requests whose deadline passed */
+    uint64_t wait_histogram_us[RB_WAIT_HISTOGRAM_BUCKETS];
+} RbAdmissionStats;
+
+/* ============================================================================
+ * Slow Calls
+ * ============================================================================ */
+
+/**
+ * RbSlowCall.kind values
+ */
+#define RB_CALL_KIND_JSON 0u    /* id is the type ID (0 for unlisted tags) */
+#define RB_CALL_KIND_BINARY 1u  /* id is the message ID */
+
+/**
+ * RbSlowCall.flags bits
+ */
+#define RB_SLOW_CALL_ERROR (1u << 0)          /* The call returned an error */
+#define RB_SLOW_CALL_PANICKED (1u << 1)       /* The call panicked (ERROR is also set) */
+#define RB_SLOW_CALL_ASYNC_HANDLER (1u << 2)  /* The caller blocked on an async handler */
+
+/**
+ * A slow call captured by the flight recorder, filled in by
+ * plugin_get_slow_calls()
+ *
+ * Durations are in nanoseconds; a phase the call never reached is 0.
+ */
+typedef struct {
+    uint64_t started_ns;    /* Start time, since the plugin started */
+    uint64_t total_ns;      /* Duration of the whole call */
+    uint64_t queue_ns;      /* Waiting for admission */
+    uint64_t dispatch_ns;   /* Validating the request and finding the handler */
+    uint64_t handler_ns;    /* In the handler */
+    uint64_t serialize_ns;  /* Encoding the response */
+    uint32_t kind;          /* RB_CALL_KIND_* */
+    uint32_t id;            /* Type ID or message ID, per kind */
+    uint32_t flags;         /* RB_SLOW_CALL_* bits */
+    uint32_t thread;        /* Calling thread, unique within the process */
+} RbSlowCall;
+
+/* ============================================================================
+ * Shared-Memory Ring Transport
+ * ============================================================================ */
+
+/**
+ * Ring data capacity used when plugin_ring_open() is given 0
+ */
+#define RB_RING_DEFAULT_CAPACITY (1u << 20)
+
+/**
+ * Smallest and largest ring data capacities
+ */
+#define RB_RING_MIN_CAPACITY (1u << 12)
+#define RB_RING_MAX_CAPACITY (1u << 30)
+
+/**
+ * Frame length marking the unused end of a ring before it wraps to offset 0
+ */
+#define RB_RING_WRAP 0xFFFFFFFFu
+
+/**
+ * Single-producer, single-consumer byte ring shared by host and plugin
+ *
+ * The header is followed directly by capacity data bytes. head and tail
+ * count bytes ever consumed and published; the data offset of a cursor is
+ * cursor & (capacity - 1). Frames (RbRingFrame plus payload, padded to 8
+ * bytes) never straddle the end of the data: a producer that cannot fit a
+ * frame before the end writes RB_RING_WRAP as the frame length there and
+ * continues at offset 0. A frame is at most capacity / 2 bytes.
+ *
+ * Producer: write the frame, store tail with release ordering, atomically
+ * increment signal, then read waiters; if it is non-zero, wake the consumer
+ * (plugin_ring_notify() for the request ring).
+ *
+ * Consumer: load tail with acquire ordering, read frames from head, then
+ * store head with release ordering. To block on the response ring, call
+ * plugin_ring_wait().
+ *
+ * The atomic fields must only be accessed atomically.
+ */
+typedef struct {
+    uint64_t head;          /* Bytes consumed (written by the consumer) */
+    uint8_t _pad0[56];
+    uint64_t tail;          /* Bytes published (written by the producer) */
+    uint8_t _pad1[56];
+    uint32_t signal;        /* Incremented after each publish (futex word) */
+    uint32_t waiters;       /* Consumers sleeping on signal */
+    uint8_t _pad2[56];
+    uint64_t capacity;      /* Data capacity in bytes (power of two) */
+    uint32_t closed;        /* Non-zero once the channel is closing */
+    uint32_t _reserved;
+    uint8_t _pad3[48];
+    /* uint8_t data[capacity] follows */
+} RbRing;
+
+/**
+ * Header in front of every ring frame payload
+ *
+ * Responses echo the request's message_id and correlation_id. status is 0
+ * for requests and successful responses; otherwise it is an RbErrorCode and
+ * the payload is a UTF-8 error message.
+ */
+typedef struct {
+    uint32_t len;           /* Payload length in bytes */
+    uint32_t message_id;    /* Binary message identifier */
+    uint32_t status;        /* 0 or an RbErrorCode */
+    uint32_t reserved;      /* Must be zero */
+    uint64_t correlation_id; /* Caller-chosen identifier */
+} RbRingFrame;
+
+/**
+ * Ring channel descriptor returned by plugin_ring_open()
+ */
+typedef struct {
+    RbRing* request;        /* Host produces, plugin consumes */
+    RbRing* response;       /* Plugin produces, host consumes */
+} RbRingChannel;
+
 /* ============================================================================
  * Error Codes
  * ============================================================================ */
@@ -186,6 +351,9 @@ typedef enum {
     RB_ERROR_TIMEOUT            = 10,   /* Operation timed out */
     RB_ERROR_INTERNAL           = 11,   /* Internal error (including panics) */
     RB_ERROR_FFI                = 12,   /* FFI-specific error */
+    RB_ERROR_TOO_MANY_REQUESTS  = 13,   /* Concurrency limit exceeded */
+    RB_ERROR_INSUFFICIENT_CAPACITY = 14, /* Caller output buffer too small */
+    RB_ERROR_UNSUPPORTED_CONTENT_TYPE = 15, /* Payload content type not supported */
 } RbErrorCode;
 
 /* ============================================================================
@@ -243,6 +411,57 @@ typedef void* RbPluginHandle;
  */
 typedef void (*RbLogCallback)(uint8_t level, const char* message, size_t len);
 
+/**
+ * One log event in a batch passed to RbLogBatchCallback
+ *
+ * Strings are UTF-8 and not null-terminated. Pointers are valid only for
+ * the duration of the callback.
+ */
+typedef struct RbLogRecord {
+    uint8_t level;              /* Log level (RbLogLevel) */
+    const uint8_t* target;      /* Log target (module path) */
+    size_t target_len;          /* Length of target in bytes */
+    const uint8_t* message;     /* Log message */
+    size_t message_len;         /* Length of message in bytes */
+} RbLogRecord;
+
+/**
+ * Callback receiving a batch of log events, oldest first
+ *
+ * Used when the plugin is configured with "logging": {"delivery": "async"}.
+ * Called from a dedicated plugin thread, never from a request thread.
+ *
+ * @param records   Array of count records
+ * @param count     Number of records
+ */
+typedef void (*RbLogBatchCallback)(const RbLogRecord* records, size_t count);
+
+/* ============================================================================
+ * Async Completion Callback
+ * ============================================================================ */
+
+/**
+ * Callback invoked when an async request completes
+ *
+ * Called exactly once per request, from a plugin runtime thread, unless the
+ * request was cancelled with plugin_cancel_async(). The data is a JSON
+ * response envelope (same format as plugin_call) and is only valid for the
+ * duration of the callback.
+ *
+ * @param context       Opaque pointer passed to plugin_call_async()
+ * @param request_id    Request ID returned by plugin_call_async()
+ * @param data          Response envelope bytes
+ * @param len           Length of data
+ * @param error_code    0 on success, otherwise an RbErrorCode
+ */
+typedef void (*RbCompletionCallback)(
+    void* context,
+    uint64_t request_id,
+    const uint8_t* data,
+    size_t len,
+    uint32_t error_code
+);
+
 /* ============================================================================
  * Function Declarations
  * ============================================================================ */
@@ -274,6 +493,35 @@ RbPluginHandle plugin_init(
  */
 /* Note: Returns FfiBuffer, not RbResponse - for JSON transport */
 
+/**
+ * Resolve a type tag to a numeric ID for plugin_call_id()
+ *
+ * Call once per type tag, typically at startup. IDs are assigned to the
+ * plugin's supported types when it starts and stay valid for the handle's
+ * lifetime.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param type_tag      Null-terminated message type tag
+ * @return              Type ID, or 0 if the plugin does not list the tag
+ *                      (fall back to plugin_call for those)
+ */
+uint32_t plugin_resolve_type_tag(RbPluginHandle handle, const char* type_tag);
+
+/**
+ * Make a synchronous JSON request to the plugin by type ID
+ *
+ * Same as plugin_call() for the tag the ID was resolved from, without
+ * passing the tag string.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param type_id       Type ID from plugin_resolve_type_tag()
+ * @param request       JSON request payload
+ * @param request_len   Length of request payload
+ * @return              FfiBuffer with JSON response; unknown IDs fail with
+ *                      RB_ERROR_UNKNOWN_MESSAGE
+ */
+/* Note: Returns FfiBuffer, not RbResponse - for JSON transport */
+
 /**
  * Make a synchronous binary request to the plugin
  *
@@ -291,7 +539,95 @@ RbResponse plugin_call_raw(
 );
 
 /**
- * Free an RbResponse returned by plugin_call_raw
+ * Make several binary requests to the plugin in one call
+ *
+ * Each message is dispatched to its registered handler and gets its own
+ * response, so one failing message does not affect the others.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param requests      Array of count request descriptors
+ * @param count         Number of messages in the batch
+ * @param responses     Caller-allocated array of count responses; on success
+ *                      every entry must be freed with rb_response_free()
+ * @param flags         Bitwise OR of batch flags (RB_BATCH_PARALLEL)
+ * @return              0 if the batch was dispatched, otherwise an error code
+ *                      (responses is then left untouched)
+ */
+uint32_t plugin_call_raw_batch(
+    RbPluginHandle handle,
+    const RbBatchRequest* requests,
+    size_t count,
+    RbResponse* responses,
+    uint32_t flags
+);
+
+/**
+ * Make a synchronous binary request, writing the response into a caller buffer
+ *
+ * Needs no allocation and no rb_response_free() call. On
+ * RB_ERROR_INSUFFICIENT_CAPACITY nothing is written and *out_len holds the
+ * required size (0 if unknown); retry with a larger buffer or fall back to
+ * plugin_call_raw(). On any other error the UTF-8 error message, truncated
+ * to out_capacity, is written to out.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param message_id    Numeric message identifier
+ * @param request       Pointer to request struct
+ * @param request_size  Size of request struct
+ * @param out           Caller-allocated output buffer
+ * @param out_capacity  Size of out in bytes
+ * @param out_len       Receives the number of bytes written (or required)
+ * @return              RB_ERROR_NONE on success, otherwise an error code
+ */
+uint32_t plugin_call_raw_into(
+    RbPluginHandle handle,
+    uint32_t message_id,
+    const void* request,
+    size_t request_size,
+    void* out,
+    size_t out_capacity,
+    size_t* out_len
+);
+
+/**
+ * Submit an asynchronous JSON request to the plugin
+ *
+ * Returns immediately; the callback receives the response when the handler
+ * completes. Requests still pending at shutdown complete with
+ * RB_ERROR_CANCELLED.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param type_tag      Null-terminated message type tag
+ * @param request       JSON request payload
+ * @param request_len   Length of request payload
+ * @param callback      Completion callback
+ * @param context       Opaque pointer passed through to the callback
+ * @return              Non-zero request ID, or 0 if the request was not
+ *                      submitted (the callback is then never invoked)
+ */
+uint64_t plugin_call_async(
+    RbPluginHandle handle,
+    const char* type_tag,
+    const uint8_t* request,
+    size_t request_len,
+    RbCompletionCallback callback,
+    void* context
+);
+
+/**
+ * Cancel a pending async request
+ *
+ * The completion callback is not invoked for a cancelled request.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param request_id    Request ID from plugin_call_async()
+ * @return              true if the request was pending and is now cancelled,
+ *                      false if it already completed or was not found
+ */
+bool plugin_cancel_async(RbPluginHandle handle, uint64_t request_id);
+
+/**
+ * Free an RbResponse returned by plugin_call_raw or plugin_call_raw_batch
  *
  * @param response      Pointer to response to free
  */
@@ -321,6 +657,204 @@ uint8_t plugin_get_state(RbPluginHandle handle);
  */
 void plugin_set_log_level(RbPluginHandle handle, uint8_t level);
 
+/**
+ * Set a callback that receives log events in batches
+ *
+ * With asynchronous delivery, events are queued on the emitting thread and
+ * handed to this callback from a background thread. Cleared at shutdown.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param callback      Batched log callback, or NULL to remove it
+ * @return              true on success, false for an invalid handle
+ */
+bool plugin_set_log_batch_callback(RbPluginHandle handle, RbLogBatchCallback callback);
+
+/**
+ * Get the number of log events dropped because the async log queue was full
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @return              Dropped events for this plugin, or 0 for an invalid handle
+ */
+uint64_t plugin_get_dropped_log_count(RbPluginHandle handle);
+
+/**
+ * Copy a plugin's admission control counters into stats
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param stats         Receives the counters; untouched on failure
+ * @return              true on success, false for an invalid handle or NULL stats
+ */
+bool plugin_get_admission_stats(RbPluginHandle handle, RbAdmissionStats* stats);
+
+/**
+ * Get per-handler call counts and latency histograms as JSON
+ *
+ * Recorded only when the plugin was initialized with
+ * {"metrics": {"enabled": true}}; otherwise the snapshot reports
+ * "enabled": false and no handlers. Each handler entry has its kind ("json"
+ * or "binary"), type_tag or message_id, calls, errors, and a latency
+ * summary for each phase (queue, dispatch, handler, serialize).
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @return              FfiBuffer with the JSON snapshot; invalid handles fail
+ *                      with error code 1
+ */
+/* Note: Returns FfiBuffer, not RbResponse - for JSON transport */
+
+/**
+ * Copy a plugin's latest slow calls into calls, newest first
+ *
+ * Recorded only when the plugin was initialized with
+ * {"flight_recorder": {"enabled": true}}. A call is kept when it takes at
+ * least slow_call_threshold_us (default 1000) or panics; each thread keeps
+ * the last capacity (default 64) of them.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param calls         Receives up to capacity records
+ * @param capacity      Number of records calls can hold
+ * @return              Records written; 0 for an invalid handle, NULL calls,
+ *                      or a disabled recorder
+ */
+size_t plugin_get_slow_calls(RbPluginHandle handle, RbSlowCall* calls, size_t capacity);
+
+/**
+ * Open a streamed response for a request
+ *
+ * Runs the plugin's stream handler for type_tag. Chunks are then produced on
+ * the plugin's runtime as plugin_stream_next() pulls them, with only a few
+ * buffered ahead of the host.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param type_tag      Null-terminated message type tag
+ * @param request       JSON request payload
+ * @param request_len   Length of request payload
+ * @param stream_id     Receives the stream ID (never 0) on success
+ * @return              FfiBuffer: empty on success, or an error envelope with
+ *                      error_code set (free with plugin_free_buffer either way)
+ */
+/* Note: Returns FfiBuffer - for JSON transport */
+
+/**
+ * Pull the next frame of a streamed response
+ *
+ * Blocks until the plugin has produced the frame. error_code 0 with len > 0
+ * is a chunk of the response payload; error_code 0 with len 0 ends the
+ * stream; a non-zero error_code ends the stream with an error envelope.
+ * Streams still open at plugin_shutdown() end with RB_ERROR_CANCELLED.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param stream_id     Stream ID from plugin_stream_open()
+ * @return              FfiBuffer holding the frame (free with plugin_free_buffer)
+ */
+/* Note: Returns FfiBuffer - for JSON transport */
+
+/**
+ * Stop a streamed response before it is complete
+ *
+ * A plugin_stream_next() call blocked on the stream ends with RB_ERROR_CANCELLED.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param stream_id     Stream ID from plugin_stream_open()
+ * @return              true if the stream was open
+ */
+bool plugin_stream_close(RbPluginHandle handle, uint64_t stream_id);
+
+/**
+ * Open a streamed request, written chunk by chunk
+ *
+ * Starts the plugin's request reader handler for type_tag. The payload is
+ * then supplied with plugin_input_write() and completed with
+ * plugin_input_finish(). An admission slot is held until the handler ends.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param type_tag      Null-terminated message type tag
+ * @param input_id      Receives the input ID (never 0) on success
+ * @return              FfiBuffer: empty on success, or an error envelope with
+ *                      error_code set (free with plugin_free_buffer either way)
+ */
+/* Note: Returns FfiBuffer - for JSON transport */
+
+/**
+ * Append a chunk to a streamed request
+ *
+ * The chunk is copied, so data may be reused once this returns. Blocks while
+ * the handler is behind, so only a few chunks are ever queued.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param input_id      Input ID from plugin_input_open()
+ * @param data          Chunk bytes
+ * @param len           Length of data (0 is a no-op)
+ * @return              0 on success, 1 for an unknown handle or input,
+ *                      4 for NULL data with len > 0
+ */
+uint32_t plugin_input_write(RbPluginHandle handle, uint64_t input_id,
+                            const uint8_t* data, size_t len);
+
+/**
+ * End a streamed request and wait for the response
+ *
+ * The input ID is invalid afterwards.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param input_id      Input ID from plugin_input_open()
+ * @return              FfiBuffer holding the response envelope, as from
+ *                      plugin_call() (free with plugin_free_buffer)
+ */
+/* Note: Returns FfiBuffer - for JSON transport */
+
+/**
+ * Discard a streamed request before it is finished
+ *
+ * A plugin_input_write() call blocked on the input returns.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param input_id      Input ID from plugin_input_open()
+ * @return              true if the input was open
+ */
+bool plugin_input_abort(RbPluginHandle handle, uint64_t input_id);
+
+/**
+ * Open a shared-memory ring channel to the plugin
+ *
+ * A consumer on the plugin's runtime answers each request frame with the
+ * binary handler registered for its message_id, preferring handlers
+ * registered with register_binary_into_handler.
+ *
+ * @param handle        Plugin handle from plugin_init()
+ * @param capacity      Data bytes per ring, rounded up to a power of two
+ *                      (0 = RB_RING_DEFAULT_CAPACITY)
+ * @return              Channel descriptor, or NULL on failure; release it
+ *                      with plugin_ring_close(), also after plugin_shutdown()
+ */
+RbRingChannel* plugin_ring_open(RbPluginHandle handle, size_t capacity);
+
+/**
+ * Wake the ring consumer after publishing requests
+ *
+ * Only needed when channel->request->waiters is non-zero after publishing.
+ *
+ * @param channel       Descriptor from plugin_ring_open()
+ */
+void plugin_ring_notify(const RbRingChannel* channel);
+
+/**
+ * Block until the response ring has frames, the channel closes, or the timeout passes
+ *
+ * @param channel       Descriptor from plugin_ring_open()
+ * @param timeout_ms    Longest time to wait
+ * @return              true if response frames are waiting (may be spurious)
+ */
+bool plugin_ring_wait(const RbRingChannel* channel, uint32_t timeout_ms);
+
+/**
+ * Stop a ring channel's consumer and release the channel
+ *
+ * Requests still in the ring are not answered.
+ *
+ * @param channel       Descriptor from plugin_ring_open(); invalid afterwards
+ */
+void plugin_ring_close(RbRingChannel* channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,583 @@
+/**
+ * rb_bench.c - Native benchmark harness for rustbridge plugins
+ *
+ * Loads a plugin shared library with dlopen() and drives the C ABI declared
+ * in rustbridge_types.h directly, so the numbers contain the FFI boundary
+ * and the plugin and nothing else: no JVM, CLR or interpreter in the way.
+ *
+ * Every case is run at each thread count. Each thread times every call
+ * with CLOCK_MONOTONIC; the samples of all threads are merged into one set
+ * of percentiles, and throughput is total calls over wall time.
+ *
+ * Results are written as JSON Lines in the rustbridge-bench/1 format (see
+ * docs/BENCHMARK_RESULTS.md), one line per case and thread count. A summary
+ * table goes to stderr.
+ *
+ * Build (Linux/macOS):
+ *   cc -O2 -std=c11 -I include rustbridge-c/benchmarks/rb_bench.c \
+ *      -o target/release/rb_bench -ldl -lpthread
+ *
+ * Run against the hello-plugin:
+ *   target/release/rb_bench target/release/libhello_plugin.so > results.jsonl
+ *
+ * Copyright (c) 2024 rustbridge contributors
+ * Licensed under MIT OR Apache-2.0
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rustbridge_types.h"
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RB_BENCH_SCHEMA "rustbridge-bench/1"
+#define RB_BENCH_MAX_LIST 16
+
+/* ============================================================================
+ * Plugin ABI
+ * ============================================================================ */
+
+/**
+ * JSON transport buffer returned by plugin_call() and plugin_call_id()
+ *
+ * rustbridge_types.h does not declare it; this mirrors FfiBuffer in
+ * crates/rustbridge-ffi/src/buffer.rs.
+ */
+typedef struct {
+    uint8_t* data;          /* Response envelope bytes */
+    size_t len;             /* Length of valid data */
+    size_t capacity;        /* Allocation capacity (0 = static data) */
+    uint32_t error_code;    /* Error code (0 = success) */
+} RbFfiBuffer;
+
+/**
+ * Request for hello-plugin's bench.small binary message (message ID 1)
+ *
+ * Mirrors SmallRequestRaw in examples/hello-plugin/src/binary_messages.rs.
+ */
+typedef struct {
+    uint8_t version;
+    uint8_t _reserved[3];
+    uint8_t key[64];
+    uint32_t key_len;
+    uint32_t flags;
+} SmallRequestRaw;
+
+#define MSG_BENCH_SMALL 1u
+
+/**
+ * Entry points resolved from the plugin library
+ */
+typedef struct {
+    void* (*create)(void);
+    RbPluginHandle (*init)(void*, const uint8_t*, size_t, RbLogCallback);
+    bool (*shutdown)(RbPluginHandle);
+    RbFfiBuffer (*call)(RbPluginHandle, const char*, const uint8_t*, size_t);
+    RbFfiBuffer (*call_id)(RbPluginHandle, uint32_t, const uint8_t*, size_t);
+    uint32_t (*resolve_type_tag)(RbPluginHandle, const char*);
+    void (*free_buffer)(RbFfiBuffer*);
+    RbResponse (*call_raw)(RbPluginHandle, uint32_t, const void*, size_t);
+    uint32_t (*call_raw_batch)(RbPluginHandle, const RbBatchRequest*, size_t, RbResponse*,
+                               uint32_t);
+    uint32_t (*call_raw_into)(RbPluginHandle, uint32_t, const void*, size_t, void*, size_t,
+                              size_t*);
+    void (*response_free)(RbResponse*);
+    uint64_t (*call_async)(RbPluginHandle, const char*, const uint8_t*, size_t,
+                           RbCompletionCallback, void*);
+} PluginApi;
+
+static void* load_symbol(void* library, const char* name) {
+    void* symbol = dlsym(library, name);
+    if (symbol == NULL) {
+        fprintf(stderr, "rb_bench: missing symbol %s\n", name);
+        exit(1);
+    }
+    return symbol;
+}
+
+/* Function pointers cannot be assigned from void* in ISO C without a copy */
+#define LOAD(library, field, name) \
+    do { \
+        void* symbol = load_symbol(library, name); \
+        memcpy(&(field), &symbol, sizeof(symbol)); \
+    } while (0)
+
+static void load_api(void* library, PluginApi* api) {
+    LOAD(library, api->create, "plugin_create");
+    LOAD(library, api->init, "plugin_init");
+    LOAD(library, api->shutdown, "plugin_shutdown");
+    LOAD(library, api->call, "plugin_call");
+    LOAD(library, api->call_id, "plugin_call_id");
+    LOAD(library, api->resolve_type_tag, "plugin_resolve_type_tag");
+    LOAD(library, api->free_buffer, "plugin_free_buffer");
+    LOAD(library, api->call_raw, "plugin_call_raw");
+    LOAD(library, api->call_raw_batch, "plugin_call_raw_batch");
+    LOAD(library, api->call_raw_into, "plugin_call_raw_into");
+    LOAD(library, api->response_free, "rb_response_free");
+    LOAD(library, api->call_async, "plugin_call_async");
+}
+
+/* ============================================================================
+ * Cases
+ * ============================================================================ */
+
+typedef struct Case Case;
+
+/**
+ * Per-thread state for one case
+ */
+typedef struct {
+    const Case* bench;
+    uint8_t* request;               /* JSON request or binary request struct */
+    size_t request_len;
+    RbBatchRequest* batch;          /* Batch descriptors (batch cases) */
+    RbResponse* responses;          /* Batch responses (batch cases) */
+    uint8_t* out;                   /* Output buffer (into cases) */
+    pthread_mutex_t lock;           /* Completion signal (async cases) */
+    pthread_cond_t done;
+    bool completed;
+    uint32_t async_error;
+} Worker;
+
+struct Case {
+    const char* api;                /* Entry point being measured */
+    const char* transport;          /* "json" or "binary" */
+    size_t payload;                 /* Echoed message length (JSON cases) */
+    size_t batch;                   /* Messages per call (batch cases), else 1 */
+    int (*run)(Worker* worker);     /* Make one call; non-zero on failure */
+};
+
+static PluginApi api;
+static RbPluginHandle handle;
+static uint32_t echo_type_id;
+
+static int run_call(Worker* w) {
+    RbFfiBuffer buffer = api.call(handle, "echo", w->request, w->request_len);
+    uint32_t error = buffer.error_code;
+    api.free_buffer(&buffer);
+    return error != 0;
+}
+
+static int run_call_id(Worker* w) {
+    RbFfiBuffer buffer = api.call_id(handle, echo_type_id, w->request, w->request_len);
+    uint32_t error = buffer.error_code;
+    api.free_buffer(&buffer);
+    return error != 0;
+}
+
+static int run_call_raw(Worker* w) {
+    RbResponse response = api.call_raw(handle, MSG_BENCH_SMALL, w->request, w->request_len);
+    uint32_t error = response.error_code;
+    api.response_free(&response);
+    return error != 0;
+}
+
+static int run_call_raw_into(Worker* w) {
+    size_t out_len = 0;
+    return api.call_raw_into(handle, MSG_BENCH_SMALL, w->request, w->request_len, w->out, 256,
+                             &out_len) != RB_ERROR_NONE;
+}
+
+static int run_call_raw_batch(Worker* w) {
+    size_t count = w->bench->batch;
+    if (api.call_raw_batch(handle, w->batch, count, w->responses, 0) != RB_ERROR_NONE) {
+        return 1;
+    }
+    int failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        failed |= w->responses[i].error_code != 0;
+        api.response_free(&w->responses[i]);
+    }
+    return failed;
+}
+
+static void on_async_complete(void* context, uint64_t request_id, const uint8_t* data,
+                              size_t len, uint32_t error_code) {
+    (void)request_id;
+    (void)data;
+    (void)len;
+    Worker* w = context;
+    pthread_mutex_lock(&w->lock);
+    w->completed = true;
+    w->async_error = error_code;
+    pthread_cond_signal(&w->done);
+    pthread_mutex_unlock(&w->lock);
+}
+
+static int run_call_async(Worker* w) {
+    w->completed = false;
+    if (api.call_async(handle, "echo", w->request, w->request_len, on_async_complete, w) == 0) {
+        return 1;
+    }
+    pthread_mutex_lock(&w->lock);
+    while (!w->completed) {
+        pthread_cond_wait(&w->done, &w->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return w->async_error != 0;
+}
+
+static const Case CASES[] = {
+    { "plugin_call", "json", 16, 1, run_call },
+    { "plugin_call", "json", 256, 1, run_call },
+    { "plugin_call", "json", 4096, 1, run_call },
+    { "plugin_call", "json", 65536, 1, run_call },
+    { "plugin_call_id", "json", 16, 1, run_call_id },
+    { "plugin_call_id", "json", 4096, 1, run_call_id },
+    { "plugin_call_async", "json", 16, 1, run_call_async },
+    { "plugin_call_raw", "binary", 0, 1, run_call_raw },
+    { "plugin_call_raw_into", "binary", 0, 1, run_call_raw_into },
+    { "plugin_call_raw_batch", "binary", 0, 16, run_call_raw_batch },
+    { "plugin_call_raw_batch", "binary", 0, 256, run_call_raw_batch },
+};
+
+#define CASE_COUNT (sizeof(CASES) / sizeof(CASES[0]))
+
+static void* checked_malloc(size_t size) {
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == NULL) {
+        fprintf(stderr, "rb_bench: out of memory\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+static void worker_init(Worker* w, const Case* bench) {
+    memset(w, 0, sizeof(*w));
+    w->bench = bench;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->done, NULL);
+
+    if (strcmp(bench->transport, "json") == 0) {
+        /* {"message":"xxx...x"} */
+        static const char prefix[] = "{\"message\":\"";
+        static const char suffix[] = "\"}";
+        w->request_len = sizeof(prefix) - 1 + bench->payload + sizeof(suffix) - 1;
+        w->request = checked_malloc(w->request_len);
+        memcpy(w->request, prefix, sizeof(prefix) - 1);
+        memset(w->request + sizeof(prefix) - 1, 'x', bench->payload);
+        memcpy(w->request + sizeof(prefix) - 1 + bench->payload, suffix, sizeof(suffix) - 1);
+        return;
+    }
+
+    SmallRequestRaw* request = checked_malloc(sizeof(SmallRequestRaw));
+    memset(request, 0, sizeof(*request));
+    request->version = 1;
+    memcpy(request->key, "bench_key", 9);
+    request->key_len = 9;
+    request->flags = 1;
+    w->request = (uint8_t*)request;
+    w->request_len = sizeof(*request);
+    w->out = checked_malloc(256);
+    w->batch = checked_malloc(bench->batch * sizeof(RbBatchRequest));
+    w->responses = checked_malloc(bench->batch * sizeof(RbResponse));
+    for (size_t i = 0; i < bench->batch; i++) {
+        w->batch[i] = (RbBatchRequest){
+            .message_id = MSG_BENCH_SMALL,
+            .request = request,
+            .request_size = sizeof(*request),
+        };
+    }
+}
+
+static void worker_destroy(Worker* w) {
+    free(w->request);
+    free(w->out);
+    free(w->batch);
+    free(w->responses);
+    pthread_mutex_destroy(&w->lock);
+    pthread_cond_destroy(&w->done);
+}
+
+/* Bytes sent per call: the JSON request, or every binary request struct */
+static size_t request_bytes(const Case* bench) {
+    if (strcmp(bench->transport, "json") == 0) {
+        return strlen("{\"message\":\"\"}") + bench->payload;
+    }
+    return bench->batch * sizeof(SmallRequestRaw);
+}
+
+/* ============================================================================
+ * Measurement
+ * ============================================================================ */
+
+typedef struct {
+    const Case* bench;
+    size_t warmup;
+    size_t iterations;
+    atomic_size_t* waiting;         /* Threads still warming up */
+    atomic_bool* aborted;           /* Set when the case could not start */
+    uint64_t* samples;              /* iterations latencies, in ns */
+    uint64_t started_ns;
+    uint64_t finished_ns;
+    size_t failures;
+} Thread;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void* thread_main(void* arg) {
+    Thread* t = arg;
+    Worker w;
+    worker_init(&w, t->bench);
+
+    for (size_t i = 0; i < t->warmup; i++) {
+        t->failures += (size_t)t->bench->run(&w);
+    }
+    /* Start the timed loops together (macOS has no pthread barriers) */
+    atomic_fetch_sub(t->waiting, 1);
+    while (atomic_load(t->waiting) > 0) {
+    }
+    if (atomic_load(t->aborted)) {
+        worker_destroy(&w);
+        return NULL;
+    }
+
+    t->started_ns = now_ns();
+    uint64_t previous = t->started_ns;
+    for (size_t i = 0; i < t->iterations; i++) {
+        t->failures += (size_t)t->bench->run(&w);
+        uint64_t now = now_ns();
+        t->samples[i] = now - previous;
+        previous = now;
+    }
+    t->finished_ns = previous;
+
+    worker_destroy(&w);
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted samples */
+static uint64_t percentile(const uint64_t* sorted, size_t count, double p) {
+    size_t rank = (size_t)(p / 100.0 * (double)count + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+    return sorted[(rank > count ? count : rank) - 1];
+}
+
+typedef struct {
+    size_t warmup;
+    size_t iterations;
+    size_t threads[RB_BENCH_MAX_LIST];
+    size_t thread_counts;
+    const char* filter;
+    FILE* out;
+} Options;
+
+static int run_case(const Options* options, const Case* bench, size_t threads) {
+    size_t total = threads * options->iterations;
+    uint64_t* samples = checked_malloc(total * sizeof(uint64_t));
+    Thread* state = checked_malloc(threads * sizeof(Thread));
+    pthread_t* ids = checked_malloc(threads * sizeof(pthread_t));
+    atomic_size_t waiting = threads;
+    atomic_bool aborted = false;
+
+    size_t started_threads = 0;
+    for (; started_threads < threads; started_threads++) {
+        size_t i = started_threads;
+        state[i] = (Thread){
+            .bench = bench,
+            .warmup = options->warmup,
+            .iterations = options->iterations,
+            .waiting = &waiting,
+            .aborted = &aborted,
+            .samples = samples + i * options->iterations,
+        };
+        int error = pthread_create(&ids[i], NULL, thread_main, &state[i]);
+        if (error != 0) {
+            fprintf(stderr, "rb_bench: cannot start thread %zu of %zu for %s/%s: %s\n", i + 1,
+                    threads, bench->api, bench->transport, strerror(error));
+            break;
+        }
+    }
+    if (started_threads < threads) {
+        /* Release the threads already waiting at the barrier */
+        atomic_store(&aborted, true);
+        atomic_fetch_sub(&waiting, threads - started_threads);
+        for (size_t i = 0; i < started_threads; i++) {
+            pthread_join(ids[i], NULL);
+        }
+        free(ids);
+        free(state);
+        free(samples);
+        return 1;
+    }
+
+    uint64_t started = UINT64_MAX;
+    uint64_t finished = 0;
+    size_t failures = 0;
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        started = state[i].started_ns < started ? state[i].started_ns : started;
+        finished = state[i].finished_ns > finished ? state[i].finished_ns : finished;
+        failures += state[i].failures;
+    }
+
+    qsort(samples, total, sizeof(uint64_t), compare_u64);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < total; i++) {
+        sum += samples[i];
+    }
+    double mean = (double)sum / (double)total;
+    double wall = (double)(finished - started) / 1e9;
+    double ops_per_sec = wall > 0 ? (double)total * (double)bench->batch / wall : 0;
+
+    char name[128];
+    snprintf(name, sizeof(name), "c/%s/%s/%zu/%zu/%zu", bench->api, bench->transport,
+             request_bytes(bench), bench->batch, threads);
+    fprintf(options->out,
+            "{\"schema\":\"" RB_BENCH_SCHEMA "\",\"name\":\"%s\",\"harness\":\"c\","
+            "\"language\":\"c\",\"api\":\"%s\",\"transport\":\"%s\",\"payload_bytes\":%zu,"
+            "\"batch\":%zu,\"threads\":%zu,\"samples\":%zu,\"mean_ns\":%.1f,"
+            "\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,"
+            "\"max_ns\":%llu,\"ops_per_sec\":%.1f,\"errors\":%zu}\n",
+            name, bench->api, bench->transport, request_bytes(bench), bench->batch, threads,
+            total, mean, (unsigned long long)percentile(samples, total, 50),
+            (unsigned long long)percentile(samples, total, 90),
+            (unsigned long long)percentile(samples, total, 99),
+            (unsigned long long)percentile(samples, total, 99.9),
+            (unsigned long long)samples[total - 1], ops_per_sec, failures);
+    fflush(options->out);
+
+    fprintf(stderr, "%-22s %-6s %8zu B x%-4zu %3zu thr  p50 %9llu ns  p99 %9llu ns  %12.0f ops/s%s\n",
+            bench->api, bench->transport, request_bytes(bench), bench->batch, threads,
+            (unsigned long long)percentile(samples, total, 50),
+            (unsigned long long)percentile(samples, total, 99), ops_per_sec,
+            failures > 0 ? "  (errors)" : "");
+
+    free(ids);
+    free(state);
+    free(samples);
+    return failures > 0;
+}
+
+/* ============================================================================
+ * Command Line
+ * ============================================================================ */
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: rb_bench <plugin-library> [options]\n"
+            "\n"
+            "  --iterations N    Timed calls per thread (default 20000)\n"
+            "  --warmup N        Untimed calls per thread first (default 2000)\n"
+            "  --threads LIST    Comma-separated thread counts (default 1,2,4,8)\n"
+            "  --filter TEXT     Only run cases whose API contains TEXT\n"
+            "  --out FILE        Write results to FILE instead of stdout\n");
+}
+
+static size_t parse_count(const char* text) {
+    char* end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || value == 0) {
+        fprintf(stderr, "rb_bench: expected a positive number, got '%s'\n", text);
+        exit(2);
+    }
+    return (size_t)value;
+}
+
+static void parse_list(const char* text, size_t* values, size_t* count) {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    *count = 0;
+    for (char* item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ",")) {
+        if (*count == RB_BENCH_MAX_LIST) {
+            fprintf(stderr, "rb_bench: at most %d thread counts\n", RB_BENCH_MAX_LIST);
+            exit(2);
+        }
+        values[(*count)++] = parse_count(item);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || strcmp(argv[1], "--help") == 0) {
+        usage();
+        return argc < 2 ? 2 : 0;
+    }
+
+    Options options = {
+        .warmup = 2000,
+        .iterations = 20000,
+        .threads = { 1, 2, 4, 8 },
+        .thread_counts = 4,
+        .out = stdout,
+    };
+    for (int i = 2; i < argc; i++) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (strcmp(arg, "--iterations") == 0) {
+            options.iterations = parse_count(value);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options.warmup = parse_count(value);
+        } else if (strcmp(arg, "--threads") == 0) {
+            parse_list(value, options.threads, &options.thread_counts);
+        } else if (strcmp(arg, "--filter") == 0) {
+            options.filter = value;
+        } else if (strcmp(arg, "--out") == 0) {
+            options.out = fopen(value, "w");
+            if (options.out == NULL) {
+                perror(value);
+                return 1;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    void* library = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+    if (library == NULL) {
+        fprintf(stderr, "rb_bench: %s\n", dlerror());
+        return 1;
+    }
+    load_api(library, &api);
+
+    static const char config[] = "{\"log_level\":\"error\"}";
+    handle = api.init(api.create(), (const uint8_t*)config, sizeof(config) - 1, NULL);
+    if (handle == NULL) {
+        fprintf(stderr, "rb_bench: plugin_init failed\n");
+        return 1;
+    }
+    echo_type_id = api.resolve_type_tag(handle, "echo");
+
+    int failed = 0;
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        const Case* bench = &CASES[c];
+        if (options.filter != NULL && strstr(bench->api, options.filter) == NULL) {
+            continue;
+        }
+        if (bench->run == run_call_id && echo_type_id == 0) {
+            fprintf(stderr, "rb_bench: plugin does not list \"echo\"; skipping %s\n", bench->api);
+            continue;
+        }
+        for (size_t t = 0; t < options.thread_counts; t++) {
+            failed |= run_case(&options, bench, options.threads[t]);
+        }
+    }
+
+    api.shutdown(handle);
+    if (options.out != stdout) {
+        fclose(options.out);
+    }
+    return failed;
+}
@@ -0,0 +1,23 @@
+namespace RustBridge;
+
+/// <summary>
+/// How a plugin handles requests that arrive while its concurrency limit is reached.
+/// </summary>
+public enum AdmissionMode
+{
+    /// <summary>
+    /// Reject immediately with a TooManyRequests error (default).
+    /// </summary>
+    Reject,
+
+    /// <summary>
+    /// Queue the request and serve waiters oldest-first until the wait deadline.
+    /// </summary>
+    Fifo,
+
+    /// <summary>
+    /// Queue the request; under sustained overload serve the newest waiter first
+    /// and time out waiters using the CoDel target.
+    /// </summary>
+    AdaptiveLifo
+}
@@ -0,0 +1,32 @@
+namespace RustBridge;
+
+/// <summary>
+/// Snapshot of a plugin's admission control counters.
+/// </summary>
+/// <param name="Limit">Maximum concurrent requests (0 = unlimited).</param>
+/// <param name="InFlight">Requests currently holding a slot.</param>
+/// <param name="QueueDepth">Requests currently waiting for a slot.</param>
+/// <param name="Admitted">Total requests admitted.</param>
+/// <param name="Queued">Total requests that had to wait before admission.</param>
+/// <param name="Rejected">Total requests rejected (including timeouts).</param>
+/// <param name="TimedOut">Total queued requests whose wait deadline passed.</param>
+/// <param name="WaitHistogramUs">
+/// Queue wait histogram with log2 microsecond buckets: bucket 0 counts waits
+/// under 1us, bucket <c>i</c> counts waits in <c>[2^(i-1), 2^i)</c>us, and the
+/// last bucket also absorbs anything longer.
+/// </param>
+public sealed record AdmissionStats(
+    long Limit,
+    long InFlight,
+    long QueueDepth,
+    long Admitted,
+    long Queued,
+    long Rejected,
+    long TimedOut,
+    long[] WaitHistogramUs)
+{
+    /// <summary>
+    /// Number of buckets in <see cref="WaitHistogramUs"/>.
+    /// </summary>
+    public const int WaitHistogramBuckets = 24;
+}
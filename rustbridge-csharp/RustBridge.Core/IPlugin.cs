@@ -24,6 +24,23 @@ public interface IPlugin : IDisposable
     /// <exception cref="PluginException">If the call fails.</exception>
     string Call(string typeTag, string request);
 
+    /// <summary>
+    /// Make a synchronous call with the payload encoded in the given content type.
+    /// <para>
+    /// The request and response bytes are passed through without a JSON envelope, so
+    /// binary formats such as <c>application/msgpack</c> never round-trip through JSON.
+    /// </para>
+    /// </summary>
+    /// <param name="typeTag">The message type tag.</param>
+    /// <param name="contentType">The payload MIME type (e.g., "application/msgpack").</param>
+    /// <param name="request">The encoded request payload.</param>
+    /// <returns>The encoded response payload.</returns>
+    /// <exception cref="PluginException">
+    /// If the call fails, the content type is unsupported (code 15), or the plugin
+    /// does not export plugin_call_as.
+    /// </exception>
+    byte[] CallAs(string typeTag, string contentType, byte[] request);
+
     /// <summary>
     /// Make a synchronous call with a typed request and response.
     /// </summary>
@@ -51,6 +68,16 @@ public interface IPlugin : IDisposable
     /// </summary>
     long RejectedRequestCount { get; }
 
+    /// <summary>
+    /// Get a snapshot of the plugin's admission control counters.
+    /// <para>
+    /// Includes the current queue depth, admission and timeout totals, and a
+    /// histogram of how long queued requests waited for a slot.
+    /// </para>
+    /// </summary>
+    /// <exception cref="PluginException">If the plugin does not export admission stats.</exception>
+    AdmissionStats AdmissionStats { get; }
+
     /// <summary>
     /// Check if binary transport is supported by this plugin.
     /// <para>
@@ -76,4 +103,46 @@ public interface IPlugin : IDisposable
     TResponse CallRaw<TRequest, TResponse>(int messageId, TRequest request)
         where TRequest : unmanaged, IBinaryStruct
         where TResponse : unmanaged, IBinaryStruct;
+
+    /// <summary>
+    /// Call the plugin with a binary struct request, writing the response into <paramref name="output"/>.
+    /// <para>
+    /// The response is written straight into caller-owned memory, so the call makes no
+    /// native allocation and needs no second crossing to free a response.
+    /// </para>
+    /// </summary>
+    /// <typeparam name="TRequest">The request struct type.</typeparam>
+    /// <param name="messageId">The binary message ID.</param>
+    /// <param name="request">The request struct.</param>
+    /// <param name="output">The buffer that receives the response bytes.</param>
+    /// <returns>The number of bytes written to <paramref name="output"/>.</returns>
+    /// <exception cref="PluginException">
+    /// If the call fails. Error code 14 means <paramref name="output"/> is too small;
+    /// the message then gives the required size.
+    /// </exception>
+    int CallRawInto<TRequest>(int messageId, TRequest request, Span<byte> output)
+        where TRequest : unmanaged, IBinaryStruct;
+
+    /// <summary>
+    /// Check if the batched binary entry point is supported by this plugin.
+    /// </summary>
+    bool HasBatchTransport { get; }
+
+    /// <summary>
+    /// Call the plugin with several binary struct requests in one native call.
+    /// <para>
+    /// Amortizes the FFI crossing over the whole batch. Every message is dispatched
+    /// even if an earlier one fails; the first failure is then thrown.
+    /// </para>
+    /// </summary>
+    /// <typeparam name="TRequest">The request struct type.</typeparam>
+    /// <typeparam name="TResponse">The response struct type.</typeparam>
+    /// <param name="messageIds">The binary message ID for each request.</param>
+    /// <param name="requests">The request structs.</param>
+    /// <param name="parallel">Dispatch the messages in parallel on the plugin's worker threads.</param>
+    /// <returns>The response structs, in request order.</returns>
+    /// <exception cref="PluginException">If the batch or any message in it fails.</exception>
+    TResponse[] CallRawBatch<TRequest, TResponse>(int[] messageIds, TRequest[] requests, bool parallel = false)
+        where TRequest : unmanaged, IBinaryStruct
+        where TResponse : unmanaged, IBinaryStruct;
 }
@@ -14,6 +14,12 @@ public class PluginConfig
     private string _logLevel = "info";
     private int _maxConcurrentOps = 1000;
     private long _shutdownTimeoutMs = 5000;
+    private AdmissionMode? _admissionMode;
+    private long? _admissionMaxWaitMs;
+    private int? _admissionMaxQueueDepth;
+    private long? _codelTargetMs;
+    private long? _codelIntervalMs;
+    private readonly JsonObject _runtime = new();
 
     /// <summary>
     /// Create a new empty configuration.
@@ -76,6 +82,106 @@ public class PluginConfig
         return this;
     }
 
+    /// <summary>
+    /// Set how requests beyond <see cref="MaxConcurrentOps"/> are handled.
+    /// <para>
+    /// <see cref="AdmissionMode.Reject"/> fails them immediately. The queueing modes
+    /// hold them for up to <paramref name="maxWaitMs"/> before failing with TooManyRequests.
+    /// </para>
+    /// </summary>
+    /// <param name="mode">The admission mode.</param>
+    /// <param name="maxWaitMs">Maximum time a request may wait for a slot.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig Admission(AdmissionMode mode, long maxWaitMs = 10)
+    {
+        _admissionMode = mode;
+        _admissionMaxWaitMs = maxWaitMs;
+        return this;
+    }
+
+    /// <summary>
+    /// Set the maximum number of requests that may wait for a slot.
+    /// </summary>
+    /// <param name="depth">The maximum queue depth.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig AdmissionMaxQueueDepth(int depth)
+    {
+        _admissionMaxQueueDepth = depth;
+        return this;
+    }
+
+    /// <summary>
+    /// Set the CoDel overload detection parameters used by <see cref="AdmissionMode.AdaptiveLifo"/>.
+    /// </summary>
+    /// <param name="targetMs">Acceptable queue wait while overloaded.</param>
+    /// <param name="intervalMs">How long the queue must stay non-empty to count as overloaded.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig AdmissionCodel(long targetMs, long intervalMs)
+    {
+        _codelTargetMs = targetMs;
+        _codelIntervalMs = intervalMs;
+        return this;
+    }
+
+    /// <summary>
+    /// Set the scheduler used by the plugin's Tokio runtime.
+    /// </summary>
+    /// <param name="flavor">The runtime flavor.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig WithRuntimeFlavor(RuntimeFlavor flavor)
+    {
+        _runtime["flavor"] = flavor == RuntimeFlavor.CurrentThread ? "current_thread" : "multi_thread";
+        return this;
+    }
+
+    /// <summary>
+    /// Reuse the process-wide runtime instead of building one for this plugin.
+    /// <para>
+    /// The shared runtime is built by the first plugin that asks for it, so that
+    /// plugin's thread and affinity settings apply to every plugin sharing it.
+    /// </para>
+    /// </summary>
+    /// <param name="shared">True to share the runtime.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig SharedRuntime(bool shared = true)
+    {
+        _runtime["shared"] = shared;
+        return this;
+    }
+
+    /// <summary>
+    /// Set the maximum number of threads in the runtime's blocking pool.
+    /// </summary>
+    /// <param name="threads">The maximum blocking threads.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig MaxBlockingThreads(int threads)
+    {
+        _runtime["max_blocking_threads"] = threads;
+        return this;
+    }
+
+    /// <summary>
+    /// Restrict the runtime's threads to the given CPUs.
+    /// </summary>
+    /// <param name="cpus">CPU indices the threads may run on.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig CpuAffinity(params int[] cpus)
+    {
+        _runtime["cpu_affinity"] = new JsonArray(cpus.Select(cpu => (JsonNode?)cpu).ToArray());
+        return this;
+    }
+
+    /// <summary>
+    /// Restrict the runtime's threads to the CPUs of a NUMA node (Linux only).
+    /// </summary>
+    /// <param name="node">The NUMA node index.</param>
+    /// <returns>This config for chaining.</returns>
+    public PluginConfig NumaNode(int node)
+    {
+        _runtime["numa_node"] = node;
+        return this;
+    }
+
     /// <summary>
     /// Set the shutdown timeout.
     /// </summary>
@@ -168,6 +274,48 @@ public class PluginConfig
             json["worker_threads"] = _workerThreads.Value;
         }
 
+        if (_runtime.Count > 0)
+        {
+            json["runtime"] = _runtime.DeepClone();
+        }
+
+        var admission = AdmissionJson();
+        if (admission.Count > 0)
+        {
+            json["admission"] = admission;
+        }
+
         return JsonSerializer.SerializeToUtf8Bytes(json);
     }
+
+    private JsonObject AdmissionJson()
+    {
+        var admission = new JsonObject();
+        if (_admissionMode.HasValue)
+        {
+            admission["mode"] = _admissionMode.Value switch
+            {
+                AdmissionMode.Fifo => "fifo",
+                AdmissionMode.AdaptiveLifo => "adaptive_lifo",
+                _ => "reject"
+            };
+        }
+        if (_admissionMaxWaitMs.HasValue)
+        {
+            admission["max_wait_ms"] = _admissionMaxWaitMs.Value;
+        }
+        if (_admissionMaxQueueDepth.HasValue)
+        {
+            admission["max_queue_depth"] = _admissionMaxQueueDepth.Value;
+        }
+        if (_codelTargetMs.HasValue)
+        {
+            admission["codel_target_ms"] = _codelTargetMs.Value;
+        }
+        if (_codelIntervalMs.HasValue)
+        {
+            admission["codel_interval_ms"] = _codelIntervalMs.Value;
+        }
+        return admission;
+    }
 }
@@ -0,0 +1,17 @@
+namespace RustBridge;
+
+/// <summary>
+/// Scheduler used by a plugin's Tokio runtime.
+/// </summary>
+public enum RuntimeFlavor
+{
+    /// <summary>
+    /// Work-stealing scheduler with one worker per core (or the configured worker count).
+    /// </summary>
+    MultiThread,
+
+    /// <summary>
+    /// A single scheduler thread, for plugins with little async work.
+    /// </summary>
+    CurrentThread
+}
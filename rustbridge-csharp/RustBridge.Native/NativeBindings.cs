@@ -53,6 +53,70 @@ internal static class NativeBindings
         public IntPtr Data;
     }
 
+    /// <summary>
+    /// RbBatchRequest structure describing one message in a plugin_call_raw_batch call.
+    /// <code>
+    /// struct RbBatchRequest {
+    ///     message_id: u32,         // binary message ID
+    ///     _reserved: u32,          // alignment padding (zero)
+    ///     request: *const c_void,  // request struct pointer
+    ///     request_size: usize      // request struct size
+    /// }
+    /// </code>
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RbBatchRequest
+    {
+        public uint MessageId;
+        private readonly uint _reserved;
+        public IntPtr Request;
+        public nuint RequestSize;
+    }
+
+    /// <summary>
+    /// Batch flag: dispatch the messages in parallel on the plugin's runtime.
+    /// </summary>
+    public const uint BatchParallel = 1;
+
+    /// <summary>
+    /// RbAdmissionStats structure filled by plugin_get_admission_stats.
+    /// <code>
+    /// struct RbAdmissionStats {
+    ///     limit, in_flight, queue_depth: u64,
+    ///     admitted, queued, rejected, timed_out: u64,
+    ///     wait_histogram_us: [u64; 24]
+    /// }
+    /// </code>
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct RbAdmissionStats
+    {
+        public ulong Limit;
+        public ulong InFlight;
+        public ulong QueueDepth;
+        public ulong Admitted;
+        public ulong Queued;
+        public ulong Rejected;
+        public ulong TimedOut;
+        public fixed ulong WaitHistogramUs[24];
+    }
+
+    /// <summary>
+    /// RbRingChannel descriptor returned by plugin_ring_open.
+    /// <code>
+    /// struct RbRingChannel {
+    ///     request: *mut RbRing,   // host produces, plugin consumes
+    ///     response: *mut RbRing   // plugin produces, host consumes
+    /// }
+    /// </code>
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RbRingChannel
+    {
+        public IntPtr Request;
+        public IntPtr Response;
+    }
+
     /// <summary>
     /// Delegate type for the log callback function.
     /// </summary>
@@ -92,6 +156,18 @@ internal static class NativeBindings
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate FfiBuffer PluginCallDelegate(IntPtr handle, IntPtr typeTag, IntPtr request, nuint requestLen);
 
+    /// <summary>
+    /// Call the plugin with a request encoded in a negotiated content type.
+    /// </summary>
+    /// <param name="handle">Plugin handle from plugin_init.</param>
+    /// <param name="typeTag">Null-terminated type tag string.</param>
+    /// <param name="contentType">Null-terminated MIME type, or null for JSON.</param>
+    /// <param name="request">Pointer to request bytes.</param>
+    /// <param name="requestLen">Length of request.</param>
+    /// <returns>FfiBuffer containing the un-enveloped response payload.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate FfiBuffer PluginCallAsDelegate(IntPtr handle, IntPtr typeTag, IntPtr contentType, IntPtr request, nuint requestLen);
+
     /// <summary>
     /// Call the plugin with a binary request (raw transport).
     /// </summary>
@@ -103,6 +179,38 @@ internal static class NativeBindings
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate RbResponse PluginCallRawDelegate(IntPtr handle, int messageId, IntPtr request, nuint requestSize);
 
+    /// <summary>
+    /// Call the plugin with several binary requests in one native call.
+    /// </summary>
+    /// <param name="handle">Plugin handle from plugin_init.</param>
+    /// <param name="requests">Pointer to an array of RbBatchRequest descriptors.</param>
+    /// <param name="count">Number of requests.</param>
+    /// <param name="responses">Pointer to a caller-allocated array of count RbResponse slots.</param>
+    /// <param name="flags">Bitwise OR of batch flags (BatchParallel).</param>
+    /// <returns>0 if the batch was dispatched, otherwise an error code.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate uint PluginCallRawBatchDelegate(IntPtr handle, IntPtr requests, nuint count, IntPtr responses, uint flags);
+
+    /// <summary>
+    /// Call the plugin with a binary request, writing the response into a caller buffer.
+    /// </summary>
+    /// <param name="handle">Plugin handle from plugin_init.</param>
+    /// <param name="messageId">Binary message ID.</param>
+    /// <param name="request">Pointer to request struct.</param>
+    /// <param name="requestSize">Size of request struct.</param>
+    /// <param name="output">Pointer to the output buffer.</param>
+    /// <param name="outputCapacity">Size of the output buffer.</param>
+    /// <param name="outputLen">Receives the bytes written (or required, on insufficient capacity).</param>
+    /// <returns>0 on success, otherwise an error code.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate uint PluginCallRawIntoDelegate(
+        IntPtr handle, int messageId, IntPtr request, nuint requestSize, IntPtr output, nuint outputCapacity, out nuint outputLen);
+
+    /// <summary>
+    /// Error code returned by plugin_call_raw_into when the output buffer is too small.
+    /// </summary>
+    public const uint ErrorInsufficientCapacity = 14;
+
     /// <summary>
     /// Free a buffer returned by plugin_call.
     /// </summary>
@@ -111,7 +219,7 @@ internal static class NativeBindings
     public delegate void PluginFreeBufferDelegate(IntPtr buffer);
 
     /// <summary>
-    /// Free a response returned by plugin_call_raw.
+    /// Free a response returned by plugin_call_raw or plugin_call_raw_batch.
     /// </summary>
     /// <param name="response">Pointer to the RbResponse.</param>
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
@@ -149,4 +257,118 @@ internal static class NativeBindings
     /// <returns>Number of rejected requests.</returns>
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate ulong PluginGetRejectedCountDelegate(IntPtr handle);
+
+    /// <summary>
+    /// Copy the admission control counters into a caller-provided struct.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="stats">Receives the counters.</param>
+    /// <returns>True if the stats were copied, false for an invalid handle.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    public delegate bool PluginGetAdmissionStatsDelegate(IntPtr handle, out RbAdmissionStats stats);
+
+    /// <summary>
+    /// Open a shared-memory ring channel to the plugin.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="capacity">Data bytes per ring (0 = default).</param>
+    /// <returns>Pointer to an RbRingChannel, or null on failure.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate IntPtr PluginRingOpenDelegate(IntPtr handle, nuint capacity);
+
+    /// <summary>
+    /// Wake the ring consumer after publishing requests.
+    /// </summary>
+    /// <param name="channel">Channel from plugin_ring_open.</param>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void PluginRingNotifyDelegate(IntPtr channel);
+
+    /// <summary>
+    /// Block until the response ring has frames, the channel closes, or the timeout passes.
+    /// </summary>
+    /// <param name="channel">Channel from plugin_ring_open.</param>
+    /// <param name="timeoutMs">Longest time to wait.</param>
+    /// <returns>True if response frames are waiting.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    public delegate bool PluginRingWaitDelegate(IntPtr channel, uint timeoutMs);
+
+    /// <summary>
+    /// Stop a ring channel's consumer and release the channel.
+    /// </summary>
+    /// <param name="channel">Channel from plugin_ring_open.</param>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void PluginRingCloseDelegate(IntPtr channel);
+
+    /// <summary>
+    /// Open a streamed response for a request.
+    /// </summary>
+    /// <param name="handle">Plugin handle from plugin_init.</param>
+    /// <param name="typeTag">Null-terminated type tag string.</param>
+    /// <param name="request">Pointer to request bytes.</param>
+    /// <param name="requestLen">Length of request.</param>
+    /// <param name="streamId">Receives the stream ID on success.</param>
+    /// <returns>Empty FfiBuffer on success, otherwise an error envelope.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate FfiBuffer PluginStreamOpenDelegate(IntPtr handle, IntPtr typeTag, IntPtr request, nuint requestLen, out ulong streamId);
+
+    /// <summary>
+    /// Block until the next chunk of a streamed response is ready.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="streamId">Stream ID from plugin_stream_open.</param>
+    /// <returns>FfiBuffer holding a chunk, an empty end frame, or an error envelope.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate FfiBuffer PluginStreamNextDelegate(IntPtr handle, ulong streamId);
+
+    /// <summary>
+    /// Stop a streamed response before it is complete.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="streamId">Stream ID from plugin_stream_open.</param>
+    /// <returns>True if the stream was open.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    public delegate bool PluginStreamCloseDelegate(IntPtr handle, ulong streamId);
+
+    /// <summary>
+    /// Open a streamed request, written chunk by chunk.
+    /// </summary>
+    /// <param name="handle">Plugin handle from plugin_init.</param>
+    /// <param name="typeTag">Null-terminated type tag string.</param>
+    /// <param name="inputId">Receives the input ID on success.</param>
+    /// <returns>Empty FfiBuffer on success, otherwise an error envelope.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate FfiBuffer PluginInputOpenDelegate(IntPtr handle, IntPtr typeTag, out ulong inputId);
+
+    /// <summary>
+    /// Append a chunk to a streamed request, blocking while the handler is behind.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="inputId">Input ID from plugin_input_open.</param>
+    /// <param name="data">Pointer to the chunk bytes (copied before returning).</param>
+    /// <param name="len">Length of the chunk.</param>
+    /// <returns>0 on success, otherwise an error code.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate uint PluginInputWriteDelegate(IntPtr handle, ulong inputId, IntPtr data, nuint len);
+
+    /// <summary>
+    /// End a streamed request and wait for the response.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="inputId">Input ID from plugin_input_open.</param>
+    /// <returns>FfiBuffer holding the response envelope, as from plugin_call.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate FfiBuffer PluginInputFinishDelegate(IntPtr handle, ulong inputId);
+
+    /// <summary>
+    /// Discard a streamed request before it is finished.
+    /// </summary>
+    /// <param name="handle">Plugin handle.</param>
+    /// <param name="inputId">Input ID from plugin_input_open.</param>
+    /// <returns>True if the input was open.</returns>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    public delegate bool PluginInputAbortDelegate(IntPtr handle, ulong inputId);
 }
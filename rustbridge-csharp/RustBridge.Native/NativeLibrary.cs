@@ -13,43 +13,120 @@ internal sealed class NativeLibraryHandle : IDisposable
     public NativeBindings.PluginCreateDelegate PluginCreate { get; }
     public NativeBindings.PluginInitDelegate PluginInit { get; }
     public NativeBindings.PluginCallDelegate PluginCall { get; }
+    public NativeBindings.PluginCallAsDelegate? PluginCallAs { get; }  // nullable - content-type negotiation optional
     public NativeBindings.PluginCallRawDelegate? PluginCallRaw { get; }  // nullable - binary transport optional
+    public NativeBindings.PluginCallRawBatchDelegate? PluginCallRawBatch { get; }  // nullable - batch transport optional
+    public NativeBindings.PluginCallRawIntoDelegate? PluginCallRawInto { get; }  // nullable - caller-buffer transport optional
     public NativeBindings.PluginFreeBufferDelegate PluginFreeBuffer { get; }
     public NativeBindings.RbResponseFreeDelegate? RbResponseFree { get; }  // nullable - binary transport optional
     public NativeBindings.PluginShutdownDelegate PluginShutdown { get; }
     public NativeBindings.PluginSetLogLevelDelegate PluginSetLogLevel { get; }
     public NativeBindings.PluginGetStateDelegate PluginGetState { get; }
     public NativeBindings.PluginGetRejectedCountDelegate PluginGetRejectedCount { get; }
+    public NativeBindings.PluginGetAdmissionStatsDelegate? PluginGetAdmissionStats { get; }  // nullable - older plugins lack it
+    public NativeBindings.PluginRingOpenDelegate? PluginRingOpen { get; }  // nullable - ring transport optional
+    public NativeBindings.PluginRingNotifyDelegate? PluginRingNotify { get; }  // nullable - ring transport optional
+    public NativeBindings.PluginRingWaitDelegate? PluginRingWait { get; }  // nullable - ring transport optional
+    public NativeBindings.PluginRingCloseDelegate? PluginRingClose { get; }  // nullable - ring transport optional
+    public NativeBindings.PluginStreamOpenDelegate? PluginStreamOpen { get; }  // nullable - streaming optional
+    public NativeBindings.PluginStreamNextDelegate? PluginStreamNext { get; }  // nullable - streaming optional
+    public NativeBindings.PluginStreamCloseDelegate? PluginStreamClose { get; }  // nullable - streaming optional
+    public NativeBindings.PluginInputOpenDelegate? PluginInputOpen { get; }  // nullable - streamed requests optional
+    public NativeBindings.PluginInputWriteDelegate? PluginInputWrite { get; }  // nullable - streamed requests optional
+    public NativeBindings.PluginInputFinishDelegate? PluginInputFinish { get; }  // nullable - streamed requests optional
+    public NativeBindings.PluginInputAbortDelegate? PluginInputAbort { get; }  // nullable - streamed requests optional
 
     /// <summary>
     /// Check if binary transport is supported by this library.
     /// </summary>
     public bool HasBinaryTransport => PluginCallRaw != null && RbResponseFree != null;
 
+    /// <summary>
+    /// Check if batched binary transport is supported by this library.
+    /// </summary>
+    public bool HasBatchTransport => PluginCallRawBatch != null && RbResponseFree != null;
+
+    /// <summary>
+    /// Check if caller-buffer binary transport is supported by this library.
+    /// </summary>
+    public bool HasCallRawInto => PluginCallRawInto != null;
+
+    /// <summary>
+    /// Check if content-type negotiated calls are supported by this library.
+    /// </summary>
+    public bool HasCallAs => PluginCallAs != null;
+
+    /// <summary>
+    /// Check if the shared-memory ring transport is supported by this library.
+    /// </summary>
+    public bool HasRingTransport =>
+        PluginRingOpen != null && PluginRingNotify != null && PluginRingWait != null && PluginRingClose != null;
+
+    /// <summary>
+    /// Check if streamed responses are supported by this library.
+    /// </summary>
+    public bool HasStreaming => PluginStreamOpen != null && PluginStreamNext != null && PluginStreamClose != null;
+
+    /// <summary>
+    /// Check if streamed requests are supported by this library.
+    /// </summary>
+    public bool HasStreamedRequests =>
+        PluginInputOpen != null && PluginInputWrite != null && PluginInputFinish != null && PluginInputAbort != null;
+
     private NativeLibraryHandle(
         IntPtr libraryHandle,
         NativeBindings.PluginCreateDelegate pluginCreate,
         NativeBindings.PluginInitDelegate pluginInit,
         NativeBindings.PluginCallDelegate pluginCall,
+        NativeBindings.PluginCallAsDelegate? pluginCallAs,
         NativeBindings.PluginCallRawDelegate? pluginCallRaw,
+        NativeBindings.PluginCallRawBatchDelegate? pluginCallRawBatch,
+        NativeBindings.PluginCallRawIntoDelegate? pluginCallRawInto,
         NativeBindings.PluginFreeBufferDelegate pluginFreeBuffer,
         NativeBindings.RbResponseFreeDelegate? rbResponseFree,
         NativeBindings.PluginShutdownDelegate pluginShutdown,
         NativeBindings.PluginSetLogLevelDelegate pluginSetLogLevel,
         NativeBindings.PluginGetStateDelegate pluginGetState,
-        NativeBindings.PluginGetRejectedCountDelegate pluginGetRejectedCount)
+        NativeBindings.PluginGetRejectedCountDelegate pluginGetRejectedCount,
+        NativeBindings.PluginGetAdmissionStatsDelegate? pluginGetAdmissionStats,
+        NativeBindings.PluginRingOpenDelegate? pluginRingOpen,
+        NativeBindings.PluginRingNotifyDelegate? pluginRingNotify,
+        NativeBindings.PluginRingWaitDelegate? pluginRingWait,
+        NativeBindings.PluginRingCloseDelegate? pluginRingClose,
+        NativeBindings.PluginStreamOpenDelegate? pluginStreamOpen,
+        NativeBindings.PluginStreamNextDelegate? pluginStreamNext,
+        NativeBindings.PluginStreamCloseDelegate? pluginStreamClose,
+        NativeBindings.PluginInputOpenDelegate? pluginInputOpen,
+        NativeBindings.PluginInputWriteDelegate? pluginInputWrite,
+        NativeBindings.PluginInputFinishDelegate? pluginInputFinish,
+        NativeBindings.PluginInputAbortDelegate? pluginInputAbort)
     {
         _libraryHandle = libraryHandle;
         PluginCreate = pluginCreate;
         PluginInit = pluginInit;
         PluginCall = pluginCall;
+        PluginCallAs = pluginCallAs;
         PluginCallRaw = pluginCallRaw;
+        PluginCallRawBatch = pluginCallRawBatch;
+        PluginCallRawInto = pluginCallRawInto;
         PluginFreeBuffer = pluginFreeBuffer;
         RbResponseFree = rbResponseFree;
         PluginShutdown = pluginShutdown;
         PluginSetLogLevel = pluginSetLogLevel;
         PluginGetState = pluginGetState;
         PluginGetRejectedCount = pluginGetRejectedCount;
+        PluginGetAdmissionStats = pluginGetAdmissionStats;
+        PluginRingOpen = pluginRingOpen;
+        PluginRingNotify = pluginRingNotify;
+        PluginRingWait = pluginRingWait;
+        PluginRingClose = pluginRingClose;
+        PluginStreamOpen = pluginStreamOpen;
+        PluginStreamNext = pluginStreamNext;
+        PluginStreamClose = pluginStreamClose;
+        PluginInputOpen = pluginInputOpen;
+        PluginInputWrite = pluginInputWrite;
+        PluginInputFinish = pluginInputFinish;
+        PluginInputAbort = pluginInputAbort;
     }
 
     /// <summary>
@@ -72,13 +149,28 @@ internal sealed class NativeLibraryHandle : IDisposable
                 GetDelegate<NativeBindings.PluginCreateDelegate>(handle, "plugin_create"),
                 GetDelegate<NativeBindings.PluginInitDelegate>(handle, "plugin_init"),
                 GetDelegate<NativeBindings.PluginCallDelegate>(handle, "plugin_call"),
+                TryGetDelegate<NativeBindings.PluginCallAsDelegate>(handle, "plugin_call_as"),  // optional
                 TryGetDelegate<NativeBindings.PluginCallRawDelegate>(handle, "plugin_call_raw"),  // optional
+                TryGetDelegate<NativeBindings.PluginCallRawBatchDelegate>(handle, "plugin_call_raw_batch"),  // optional
+                TryGetDelegate<NativeBindings.PluginCallRawIntoDelegate>(handle, "plugin_call_raw_into"),  // optional
                 GetDelegate<NativeBindings.PluginFreeBufferDelegate>(handle, "plugin_free_buffer"),
                 TryGetDelegate<NativeBindings.RbResponseFreeDelegate>(handle, "rb_response_free"),  // optional
                 GetDelegate<NativeBindings.PluginShutdownDelegate>(handle, "plugin_shutdown"),
                 GetDelegate<NativeBindings.PluginSetLogLevelDelegate>(handle, "plugin_set_log_level"),
                 GetDelegate<NativeBindings.PluginGetStateDelegate>(handle, "plugin_get_state"),
-                GetDelegate<NativeBindings.PluginGetRejectedCountDelegate>(handle, "plugin_get_rejected_count")
+                GetDelegate<NativeBindings.PluginGetRejectedCountDelegate>(handle, "plugin_get_rejected_count"),
+                TryGetDelegate<NativeBindings.PluginGetAdmissionStatsDelegate>(handle, "plugin_get_admission_stats"),  // optional
+                TryGetDelegate<NativeBindings.PluginRingOpenDelegate>(handle, "plugin_ring_open"),  // optional
+                TryGetDelegate<NativeBindings.PluginRingNotifyDelegate>(handle, "plugin_ring_notify"),  // optional
+                TryGetDelegate<NativeBindings.PluginRingWaitDelegate>(handle, "plugin_ring_wait"),  // optional
+                TryGetDelegate<NativeBindings.PluginRingCloseDelegate>(handle, "plugin_ring_close"),  // optional
+                TryGetDelegate<NativeBindings.PluginStreamOpenDelegate>(handle, "plugin_stream_open"),  // optional
+                TryGetDelegate<NativeBindings.PluginStreamNextDelegate>(handle, "plugin_stream_next"),  // optional
+                TryGetDelegate<NativeBindings.PluginStreamCloseDelegate>(handle, "plugin_stream_close"),  // optional
+                TryGetDelegate<NativeBindings.PluginInputOpenDelegate>(handle, "plugin_input_open"),  // optional
+                TryGetDelegate<NativeBindings.PluginInputWriteDelegate>(handle, "plugin_input_write"),  // optional
+                TryGetDelegate<NativeBindings.PluginInputFinishDelegate>(handle, "plugin_input_finish"),  // optional
+                TryGetDelegate<NativeBindings.PluginInputAbortDelegate>(handle, "plugin_input_abort")  // optional
             );
         }
         catch
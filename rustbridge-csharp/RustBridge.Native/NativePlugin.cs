@@ -79,6 +79,38 @@ public sealed class NativePlugin : IPlugin
         }
     }
 
+    /// <inheritdoc/>
+    public byte[] CallAs(string typeTag, string contentType, byte[] request)
+    {
+        ThrowIfDisposed();
+
+        if (_library.PluginCallAs == null)
+        {
+            throw new PluginException("Content-type negotiation not supported by this plugin");
+        }
+
+        var typeTagBytes = Encoding.UTF8.GetBytes(typeTag + '\0');
+        var contentTypeBytes = Encoding.UTF8.GetBytes(contentType + '\0');
+
+        unsafe
+        {
+            fixed (byte* typeTagPtr = typeTagBytes)
+            fixed (byte* contentTypePtr = contentTypeBytes)
+            fixed (byte* requestPtr = request)
+            {
+                var buffer = _library.PluginCallAs(
+                    _handle,
+                    (IntPtr)typeTagPtr,
+                    (IntPtr)contentTypePtr,
+                    (IntPtr)requestPtr,
+                    (nuint)request.Length
+                );
+
+                return ParseRawPayloadBuffer(buffer);
+            }
+        }
+    }
+
     /// <inheritdoc/>
     public TResponse Call<TRequest, TResponse>(string typeTag, TRequest request)
     {
@@ -105,9 +137,188 @@ public sealed class NativePlugin : IPlugin
         }
     }
 
+    /// <inheritdoc/>
+    public unsafe AdmissionStats AdmissionStats
+    {
+        get
+        {
+            ThrowIfDisposed();
+            if (_library.PluginGetAdmissionStats == null)
+            {
+                throw new PluginException("Admission stats not supported by this plugin");
+            }
+            if (!_library.PluginGetAdmissionStats(_handle, out var raw))
+            {
+                throw new PluginException("Invalid plugin handle");
+            }
+
+            var histogram = new long[AdmissionStats.WaitHistogramBuckets];
+            for (var i = 0; i < histogram.Length; i++)
+            {
+                histogram[i] = (long)raw.WaitHistogramUs[i];
+            }
+            return new AdmissionStats(
+                (long)raw.Limit,
+                (long)raw.InFlight,
+                (long)raw.QueueDepth,
+                (long)raw.Admitted,
+                (long)raw.Queued,
+                (long)raw.Rejected,
+                (long)raw.TimedOut,
+                histogram);
+        }
+    }
+
     /// <inheritdoc/>
     public bool HasBinaryTransport => _library.HasBinaryTransport;
 
+    /// <summary>
+    /// Check if the shared-memory ring transport is supported by this plugin.
+    /// </summary>
+    public bool HasRingTransport => _library.HasRingTransport;
+
+    /// <summary>
+    /// Open a shared-memory ring channel to the plugin.
+    /// <para>
+    /// Frames sent through the channel are answered by the plugin's binary handlers
+    /// on its own runtime, without a native call per message. Dispose the channel
+    /// before or after disposing the plugin to release its memory.
+    /// </para>
+    /// </summary>
+    /// <param name="capacity">Data bytes per ring, rounded up to a power of two (0 = 1 MiB).</param>
+    /// <returns>The open channel.</returns>
+    /// <exception cref="PluginException">If the plugin lacks ring transport, is not active, or the capacity is too large.</exception>
+    public RingChannel OpenRing(long capacity = 0)
+    {
+        ThrowIfDisposed();
+        return RingChannel.Open(_library, _handle, capacity);
+    }
+
+    /// <summary>
+    /// Check if streamed responses are supported by this plugin.
+    /// </summary>
+    public bool HasStreaming => _library.HasStreaming;
+
+    /// <summary>
+    /// Make a call whose response is pulled chunk by chunk.
+    /// <para>
+    /// The plugin produces only a few chunks ahead of the enumerator, and concatenated
+    /// they form the payload <see cref="Call(string, string)"/> would have returned.
+    /// Errors the handler reports before its first chunk are thrown here; later errors
+    /// are thrown from <c>MoveNext</c>. Disposing the enumerator early stops the stream.
+    /// An admission slot is held until the stream ends or is disposed.
+    /// </para>
+    /// </summary>
+    /// <param name="typeTag">The message type identifier.</param>
+    /// <param name="request">The request payload as JSON.</param>
+    /// <returns>The response chunks, to be enumerated once.</returns>
+    /// <exception cref="PluginException">If the call fails before streaming starts or streaming is not supported.</exception>
+    public IEnumerable<byte[]> CallStream(string typeTag, string request)
+    {
+        ThrowIfDisposed();
+
+        if (!_library.HasStreaming)
+        {
+            throw new PluginException("Streamed responses not supported by this plugin");
+        }
+
+        var typeTagBytes = Encoding.UTF8.GetBytes(typeTag + '\0');
+        var requestBytes = Encoding.UTF8.GetBytes(request);
+        ulong streamId;
+
+        unsafe
+        {
+            fixed (byte* typeTagPtr = typeTagBytes)
+            fixed (byte* requestPtr = requestBytes)
+            {
+                var buffer = _library.PluginStreamOpen!(
+                    _handle,
+                    (IntPtr)typeTagPtr,
+                    (IntPtr)requestPtr,
+                    (nuint)requestBytes.Length,
+                    out streamId
+                );
+                ParseStreamFrame(buffer);
+            }
+        }
+
+        return ReadStream(streamId);
+    }
+
+    private IEnumerable<byte[]> ReadStream(ulong streamId)
+    {
+        var finished = false;
+        try
+        {
+            while (true)
+            {
+                byte[] chunk;
+                try
+                {
+                    chunk = ParseStreamFrame(_library.PluginStreamNext!(_handle, streamId));
+                }
+                catch
+                {
+                    finished = true;
+                    throw;
+                }
+
+                if (chunk.Length == 0)
+                {
+                    finished = true;
+                    yield break;
+                }
+                yield return chunk;
+            }
+        }
+        finally
+        {
+            if (!finished && !_disposed)
+            {
+                _library.PluginStreamClose!(_handle, streamId);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Check if streamed requests are supported by this plugin.
+    /// </summary>
+    public bool HasStreamedRequests => _library.HasStreamedRequests;
+
+    /// <summary>
+    /// Open a request whose payload is written chunk by chunk.
+    /// <para>
+    /// The handler starts right away and reads the payload as it arrives; an admission
+    /// slot is held until it returns or the writer is disposed.
+    /// </para>
+    /// </summary>
+    /// <param name="typeTag">The message type identifier.</param>
+    /// <returns>The open writer; finish it to get the response, or dispose it to discard the request.</returns>
+    /// <exception cref="PluginException">If the request cannot be opened or streamed requests are not supported.</exception>
+    public RequestWriter OpenRequest(string typeTag)
+    {
+        ThrowIfDisposed();
+
+        if (!_library.HasStreamedRequests)
+        {
+            throw new PluginException("Streamed requests not supported by this plugin");
+        }
+
+        var typeTagBytes = Encoding.UTF8.GetBytes(typeTag + '\0');
+        ulong inputId;
+
+        unsafe
+        {
+            fixed (byte* typeTagPtr = typeTagBytes)
+            {
+                var buffer = _library.PluginInputOpen!(_handle, (IntPtr)typeTagPtr, out inputId);
+                ParseStreamFrame(buffer);
+            }
+        }
+
+        return new RequestWriter(this, _library, _handle, inputId);
+    }
+
     /// <inheritdoc/>
     public TResponse CallRaw<TRequest, TResponse>(int messageId, TRequest request)
         where TRequest : unmanaged, IBinaryStruct
@@ -136,6 +347,127 @@ public sealed class NativePlugin : IPlugin
         }
     }
 
+    /// <inheritdoc/>
+    public int CallRawInto<TRequest>(int messageId, TRequest request, Span<byte> output)
+        where TRequest : unmanaged, IBinaryStruct
+    {
+        ThrowIfDisposed();
+
+        if (!_library.HasCallRawInto)
+        {
+            throw new PluginException("Caller-buffer binary transport not supported by this plugin");
+        }
+
+        uint result;
+        nuint outputLen;
+        unsafe
+        {
+            var requestPtr = (IntPtr)Unsafe.AsPointer(ref request);
+            fixed (byte* outputPtr = output)
+            {
+                result = _library.PluginCallRawInto!(
+                    _handle,
+                    messageId,
+                    requestPtr,
+                    (nuint)request.ByteSize,
+                    (IntPtr)outputPtr,
+                    (nuint)output.Length,
+                    out outputLen
+                );
+            }
+        }
+
+        if (result == 0)
+        {
+            return (int)outputLen;
+        }
+        if (result == NativeBindings.ErrorInsufficientCapacity)
+        {
+            throw new PluginException((int)result, $"Output buffer too small: {outputLen} bytes required");
+        }
+        var errorMessage = outputLen > 0 ? Encoding.UTF8.GetString(output[..(int)outputLen]) : "Unknown error";
+        throw new PluginException((int)result, errorMessage);
+    }
+
+    /// <inheritdoc/>
+    public bool HasBatchTransport => _library.HasBatchTransport;
+
+    /// <inheritdoc/>
+    public TResponse[] CallRawBatch<TRequest, TResponse>(int[] messageIds, TRequest[] requests, bool parallel = false)
+        where TRequest : unmanaged, IBinaryStruct
+        where TResponse : unmanaged, IBinaryStruct
+    {
+        ThrowIfDisposed();
+
+        if (!HasBatchTransport)
+        {
+            throw new PluginException("Batch binary transport not supported by this plugin");
+        }
+        if (messageIds.Length != requests.Length)
+        {
+            throw new ArgumentException("messageIds and requests must have the same length", nameof(messageIds));
+        }
+
+        var count = requests.Length;
+        if (count == 0)
+        {
+            return Array.Empty<TResponse>();
+        }
+
+        var descriptors = new NativeBindings.RbBatchRequest[count];
+        var rawResponses = new NativeBindings.RbResponse[count];
+
+        unsafe
+        {
+            fixed (TRequest* requestsPtr = requests)
+            fixed (NativeBindings.RbBatchRequest* descriptorsPtr = descriptors)
+            fixed (NativeBindings.RbResponse* responsesPtr = rawResponses)
+            {
+                // Descriptors point directly at the pinned request structs
+                for (int i = 0; i < count; i++)
+                {
+                    descriptors[i].MessageId = (uint)messageIds[i];
+                    descriptors[i].Request = (IntPtr)(requestsPtr + i);
+                    descriptors[i].RequestSize = (nuint)requests[i].ByteSize;
+                }
+
+                var result = _library.PluginCallRawBatch!(
+                    _handle,
+                    (IntPtr)descriptorsPtr,
+                    (nuint)count,
+                    (IntPtr)responsesPtr,
+                    parallel ? NativeBindings.BatchParallel : 0
+                );
+
+                if (result != 0)
+                {
+                    throw new PluginException((int)result, "Batch call rejected by plugin");
+                }
+            }
+        }
+
+        // Parse every response so each one is freed, then report the first failure
+        var responses = new TResponse[count];
+        PluginException? firstFailure = null;
+        for (int i = 0; i < count; i++)
+        {
+            try
+            {
+                responses[i] = ParseRawResponse<TResponse>(rawResponses[i]);
+            }
+            catch (PluginException ex)
+            {
+                firstFailure ??= ex;
+            }
+        }
+
+        if (firstFailure != null)
+        {
+            throw firstFailure;
+        }
+        return responses;
+    }
+
     private unsafe TResponse ParseRawResponse<TResponse>(NativeBindings.RbResponse response)
         where TResponse : unmanaged, IBinaryStruct
     {
@@ -253,6 +585,75 @@ public sealed class NativePlugin : IPlugin
         }
     }
 
+    private byte[] ParseRawPayloadBuffer(NativeBindings.FfiBuffer buffer)
+    {
+        try
+        {
+            var bytes = buffer.Data != IntPtr.Zero && buffer.Len > 0
+                ? new byte[(int)buffer.Len]
+                : Array.Empty<byte>();
+            if (bytes.Length > 0)
+            {
+                Marshal.Copy(buffer.Data, bytes, 0, bytes.Length);
+            }
+
+            if (buffer.ErrorCode != 0)
+            {
+                var errorMessage = bytes.Length > 0 ? Encoding.UTF8.GetString(bytes) : "Unknown error";
+                throw new PluginException((int)buffer.ErrorCode, errorMessage);
+            }
+
+            return bytes;
+        }
+        finally
+        {
+            FreeBuffer(buffer);
+        }
+    }
+
+    internal byte[] ParseStreamFrame(NativeBindings.FfiBuffer buffer)
+    {
+        byte[] bytes;
+        try
+        {
+            bytes = buffer.Data != IntPtr.Zero && buffer.Len > 0
+                ? new byte[(int)buffer.Len]
+                : Array.Empty<byte>();
+            if (bytes.Length > 0)
+            {
+                Marshal.Copy(buffer.Data, bytes, 0, bytes.Length);
+            }
+        }
+        finally
+        {
+            FreeBuffer(buffer);
+        }
+
+        if (buffer.ErrorCode == 0)
+        {
+            return bytes;
+        }
+
+        // Error frames hold an error envelope, or plain text if the handle itself was bad
+        var text = Encoding.UTF8.GetString(bytes);
+        if (text.StartsWith('{'))
+        {
+            try
+            {
+                var envelope = ResponseEnvelope.FromJson(text);
+                if (!envelope.IsSuccess)
+                {
+                    throw envelope.ToException();
+                }
+            }
+            catch (JsonException)
+            {
+                // Not an envelope; report the raw text
+            }
+        }
+        throw new PluginException((int)buffer.ErrorCode, text.Length > 0 ? text : "Unknown error");
+    }
+
     private void FreeBuffer(NativeBindings.FfiBuffer buffer)
     {
         try
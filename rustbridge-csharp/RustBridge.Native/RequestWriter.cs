@@ -0,0 +1,142 @@
+using System.Text;
+
+namespace RustBridge.Native;
+
+/// <summary>
+/// A request payload written to a plugin chunk by chunk.
+/// <para>
+/// Bytes are handed to the plugin's handler as they are written, with only a few chunks
+/// buffered ahead of it, so a large request never has to be held in memory at once.
+/// Writes pass the caller's memory to the plugin in place and block while the handler is
+/// behind. Concatenated, the written bytes form the request
+/// <see cref="NativePlugin.Call(string, string)"/> would have taken.
+/// </para>
+/// <para>
+/// Write from one thread at a time. Disposing a writer that was not finished discards
+/// the request.
+/// </para>
+/// </summary>
+public sealed class RequestWriter : Stream
+{
+    private readonly NativePlugin _plugin;
+    private readonly NativeLibraryHandle _library;
+    private readonly IntPtr _handle;
+    private readonly ulong _inputId;
+    private volatile bool _done;
+
+    internal RequestWriter(NativePlugin plugin, NativeLibraryHandle library, IntPtr handle, ulong inputId)
+    {
+        _plugin = plugin;
+        _library = library;
+        _handle = handle;
+        _inputId = inputId;
+    }
+
+    /// <inheritdoc/>
+    public override bool CanRead => false;
+
+    /// <inheritdoc/>
+    public override bool CanSeek => false;
+
+    /// <inheritdoc/>
+    public override bool CanWrite => !_done;
+
+    /// <inheritdoc/>
+    public override long Length => throw new NotSupportedException();
+
+    /// <inheritdoc/>
+    public override long Position
+    {
+        get => throw new NotSupportedException();
+        set => throw new NotSupportedException();
+    }
+
+    /// <inheritdoc/>
+    public override void Write(byte[] buffer, int offset, int count)
+    {
+        ValidateBufferArguments(buffer, offset, count);
+        Write(buffer.AsSpan(offset, count));
+    }
+
+    /// <summary>
+    /// Send bytes to the handler, blocking while it is behind.
+    /// </summary>
+    /// <param name="buffer">The bytes to send; copied by the plugin before this returns.</param>
+    /// <exception cref="InvalidOperationException">If the request was already finished or discarded.</exception>
+    /// <exception cref="PluginException">If the plugin rejected the write.</exception>
+    public override void Write(ReadOnlySpan<byte> buffer)
+    {
+        if (_done)
+        {
+            throw new InvalidOperationException("Request already finished");
+        }
+        if (buffer.IsEmpty)
+        {
+            return;
+        }
+
+        uint result;
+        unsafe
+        {
+            fixed (byte* dataPtr = buffer)
+            {
+                result = _library.PluginInputWrite!(_handle, _inputId, (IntPtr)dataPtr, (nuint)buffer.Length);
+            }
+        }
+        if (result != 0)
+        {
+            throw new PluginException((int)result, "Request write failed");
+        }
+    }
+
+    /// <summary>
+    /// End the request and wait for the handler's response.
+    /// </summary>
+    /// <returns>The JSON response payload.</returns>
+    /// <exception cref="InvalidOperationException">If the request was already finished or discarded.</exception>
+    /// <exception cref="PluginException">If the handler failed.</exception>
+    public string Finish()
+    {
+        if (_done)
+        {
+            throw new InvalidOperationException("Request already finished");
+        }
+        _done = true;
+
+        var bytes = _plugin.ParseStreamFrame(_library.PluginInputFinish!(_handle, _inputId));
+        var envelope = ResponseEnvelope.FromJson(Encoding.UTF8.GetString(bytes));
+        if (!envelope.IsSuccess)
+        {
+            throw envelope.ToException();
+        }
+        return envelope.GetPayloadJson();
+    }
+
+    /// <inheritdoc/>
+    public override void Flush()
+    {
+    }
+
+    /// <inheritdoc/>
+    public override int Read(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+
+    /// <inheritdoc/>
+    public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+
+    /// <inheritdoc/>
+    public override void SetLength(long value) => throw new NotSupportedException();
+
+    /// <summary>
+    /// Discard the request if it was not finished. The handler is stopped and its
+    /// admission slot released.
+    /// </summary>
+    protected override void Dispose(bool disposing)
+    {
+        if (!_done)
+        {
+            _done = true;
+            _library.PluginInputAbort!(_handle, _inputId);
+        }
+        base.Dispose(disposing);
+    }
+}
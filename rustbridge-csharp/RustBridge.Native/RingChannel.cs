@@ -0,0 +1,280 @@
+using System.Text;
+
+namespace RustBridge.Native;
+
+/// <summary>
+/// A response frame read from a <see cref="RingChannel"/>.
+/// </summary>
+/// <param name="MessageId">The request's message ID.</param>
+/// <param name="Status">0 on success, otherwise the error code.</param>
+/// <param name="CorrelationId">The request's correlation ID.</param>
+/// <param name="Payload">Response bytes, or a UTF-8 error message when Status is non-zero.</param>
+public readonly record struct RingFrame(int MessageId, int Status, ulong CorrelationId, byte[] Payload)
+{
+    /// <summary>
+    /// True if the plugin handled the request successfully.
+    /// </summary>
+    public bool IsSuccess => Status == 0;
+
+    /// <summary>
+    /// Get the response bytes.
+    /// </summary>
+    /// <exception cref="PluginException">If the plugin reported an error for this request.</exception>
+    public byte[] PayloadOrThrow()
+    {
+        if (Status != 0)
+        {
+            throw new PluginException(Status, Encoding.UTF8.GetString(Payload));
+        }
+        return Payload;
+    }
+}
+
+/// <summary>
+/// Shared-memory ring channel to a plugin.
+/// <para>
+/// Requests are written straight into a ring the plugin consumes on its own runtime,
+/// and responses come back through a second ring, so a steady stream of messages
+/// crosses into native code only when one side has to be woken. Each frame carries a
+/// binary message ID, a caller-chosen correlation ID, and an opaque payload that is
+/// handed to the plugin's binary handler for that message ID.
+/// </para>
+/// <para>
+/// <b>Thread Safety</b>: Both rings are single-producer, single-consumer. This class
+/// serializes its producers and its consumers with locks, so any thread may call
+/// <see cref="TryWrite"/> or <see cref="TryRead"/>. Responses arrive in request order.
+/// </para>
+/// </summary>
+public sealed unsafe class RingChannel : IDisposable
+{
+    // RbRing header offsets (see rustbridge_types.h)
+    private const int HeadOffset = 0;
+    private const int TailOffset = 64;
+    private const int SignalOffset = 128;
+    private const int WaitersOffset = 132;
+    private const int CapacityOffset = 192;
+    private const int ClosedOffset = 200;
+    private const int HeaderSize = 256;
+
+    // RbRingFrame offsets
+    private const int FrameMessageIdOffset = 4;
+    private const int FrameStatusOffset = 8;
+    private const int FrameCorrelationIdOffset = 16;
+    private const int FrameHeaderSize = 24;
+
+    private const uint RingWrap = 0xFFFFFFFF;
+
+    private readonly NativeLibraryHandle _library;
+    private readonly IntPtr _channel;
+    private readonly byte* _request;
+    private readonly byte* _response;
+    private readonly ulong _capacity;
+    private readonly object _producerLock = new();
+    private readonly object _consumerLock = new();
+    private volatile bool _disposed;
+
+    private RingChannel(NativeLibraryHandle library, IntPtr channel)
+    {
+        _library = library;
+        _channel = channel;
+        var descriptor = (NativeBindings.RbRingChannel*)channel;
+        _request = (byte*)descriptor->Request;
+        _response = (byte*)descriptor->Response;
+        _capacity = *(ulong*)(_request + CapacityOffset);
+    }
+
+    internal static RingChannel Open(NativeLibraryHandle library, IntPtr handle, long capacity)
+    {
+        if (!library.HasRingTransport)
+        {
+            throw new PluginException("Ring transport not supported by this plugin");
+        }
+        if (capacity < 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(capacity));
+        }
+
+        var channel = library.PluginRingOpen!(handle, (nuint)capacity);
+        if (channel == IntPtr.Zero)
+        {
+            throw new PluginException(1, "Failed to open ring channel (plugin not active or capacity too large)");
+        }
+        return new RingChannel(library, channel);
+    }
+
+    /// <summary>
+    /// The largest payload a single frame can carry.
+    /// </summary>
+    public int MaxPayload => (int)Math.Min(_capacity / 2 - FrameHeaderSize, int.MaxValue);
+
+    /// <summary>
+    /// True once the channel is disposed or the plugin has stopped serving it.
+    /// </summary>
+    public bool IsClosed => _disposed || Volatile.Read(ref *(uint*)(_request + ClosedOffset)) != 0;
+
+    /// <summary>
+    /// Publish a request frame.
+    /// </summary>
+    /// <param name="messageId">The binary message ID.</param>
+    /// <param name="correlationId">Identifier echoed in the response.</param>
+    /// <param name="payload">The request bytes.</param>
+    /// <returns>False if the ring is full; read responses and retry.</returns>
+    /// <exception cref="ArgumentException">If the payload exceeds <see cref="MaxPayload"/>.</exception>
+    /// <exception cref="ObjectDisposedException">If the channel has been disposed.</exception>
+    /// <exception cref="InvalidOperationException">If the plugin has stopped serving the channel.</exception>
+    public bool TryWrite(int messageId, ulong correlationId, ReadOnlySpan<byte> payload)
+    {
+        if (payload.Length > MaxPayload)
+        {
+            throw new ArgumentException($"Payload of {payload.Length} bytes exceeds ring frame limit", nameof(payload));
+        }
+
+        lock (_producerLock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            if (Volatile.Read(ref *(uint*)(_request + ClosedOffset)) != 0)
+            {
+                throw new InvalidOperationException("Plugin has stopped serving this ring channel");
+            }
+
+            if (!TryPush(_request, messageId, correlationId, payload))
+            {
+                return false;
+            }
+
+            if (Volatile.Read(ref *(uint*)(_request + WaitersOffset)) != 0)
+            {
+                _library.PluginRingNotify!(_channel);
+            }
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Take the oldest response frame.
+    /// </summary>
+    /// <param name="frame">Receives the frame.</param>
+    /// <returns>False if no response is waiting.</returns>
+    /// <exception cref="ObjectDisposedException">If the channel has been disposed.</exception>
+    public bool TryRead(out RingFrame frame)
+    {
+        lock (_consumerLock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            return TryPop(_response, out frame);
+        }
+    }
+
+    /// <summary>
+    /// Block until a response is waiting, the channel closes, or the timeout passes.
+    /// </summary>
+    /// <param name="timeoutMs">Longest time to wait.</param>
+    /// <returns>True if a response is waiting (may be spurious).</returns>
+    public bool WaitForResponses(uint timeoutMs)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        return _library.PluginRingWait!(_channel, timeoutMs);
+    }
+
+    /// <summary>
+    /// Stop the plugin's consumer and release both rings.
+    /// <para>
+    /// Requests still in the ring are not answered. Must be called even after the
+    /// plugin itself has been disposed.
+    /// </para>
+    /// </summary>
+    public void Dispose()
+    {
+        lock (_producerLock)
+        {
+            lock (_consumerLock)
+            {
+                if (_disposed) return;
+                _disposed = true;
+                _library.PluginRingClose!(_channel);
+            }
+        }
+    }
+
+    private bool TryPush(byte* ring, int messageId, ulong correlationId, ReadOnlySpan<byte> payload)
+    {
+        var data = ring + HeaderSize;
+        var total = FrameSize((ulong)payload.Length);
+        var tail = *(ulong*)(ring + TailOffset);
+        var head = Volatile.Read(ref *(ulong*)(ring + HeadOffset));
+        var free = _capacity - (tail - head);
+        var pos = tail & (_capacity - 1);
+        var contiguous = _capacity - pos;
+
+        if (contiguous < total)
+        {
+            if (free < contiguous + total)
+            {
+                return false;
+            }
+            *(uint*)(data + pos) = RingWrap;
+            tail += contiguous;
+            pos = 0;
+        }
+        else if (free < total)
+        {
+            return false;
+        }
+
+        var at = data + pos;
+        *(uint*)at = (uint)payload.Length;
+        *(int*)(at + FrameMessageIdOffset) = messageId;
+        *(ulong*)(at + FrameStatusOffset) = 0;
+        *(ulong*)(at + FrameCorrelationIdOffset) = correlationId;
+        payload.CopyTo(new Span<byte>(at + FrameHeaderSize, payload.Length));
+
+        Volatile.Write(ref *(ulong*)(ring + TailOffset), tail + total);
+        // Full fence between publishing and reading the consumer's waiter count
+        Interlocked.Increment(ref *(int*)(ring + SignalOffset));
+        return true;
+    }
+
+    private bool TryPop(byte* ring, out RingFrame frame)
+    {
+        var data = ring + HeaderSize;
+        var head = *(ulong*)(ring + HeadOffset);
+        var tail = Volatile.Read(ref *(ulong*)(ring + TailOffset));
+
+        while (true)
+        {
+            var available = tail - head;
+            if (available == 0)
+            {
+                frame = default;
+                return false;
+            }
+
+            var pos = head & (_capacity - 1);
+            var at = data + pos;
+            var len = *(uint*)at;
+            if (len == RingWrap)
+            {
+                head += _capacity - pos;
+                Volatile.Write(ref *(ulong*)(ring + HeadOffset), head);
+                continue;
+            }
+
+            var total = FrameSize(len);
+            if (total > available || total > _capacity - pos)
+            {
+                throw new InvalidOperationException($"Ring frame of {len} bytes overruns published data");
+            }
+
+            frame = new RingFrame(
+                *(int*)(at + FrameMessageIdOffset),
+                *(int*)(at + FrameStatusOffset),
+                *(ulong*)(at + FrameCorrelationIdOffset),
+                new ReadOnlySpan<byte>(at + FrameHeaderSize, (int)len).ToArray());
+
+            Volatile.Write(ref *(ulong*)(ring + HeadOffset), head + total);
+            return true;
+        }
+    }
+
+    private static ulong FrameSize(ulong payloadLen) => (FrameHeaderSize + payloadLen + 7) & ~7UL;
+}
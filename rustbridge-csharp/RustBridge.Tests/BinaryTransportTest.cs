@@ -153,6 +153,135 @@ public class BinaryTransportTest : IDisposable
         }
     }
 
+    [SkippableFact]
+    public void CallRawInto___SmallBenchmark___WritesResponseIntoSpan()
+    {
+        SkipIfPluginNotAvailable();
+
+        var request = SmallRequestRaw.Create("into_key", 0x01);
+        Span<byte> output = stackalloc byte[128];
+
+        var written = _plugin!.CallRawInto(MsgBenchSmall, request, output);
+        var response = MemoryMarshal.Read<SmallResponseRaw>(output[..written]);
+
+        Assert.Equal(80, written);
+        Assert.Equal(SmallResponseRaw.CurrentVersion, response.Version);
+        Assert.True(response.ValueLen > 0);
+        Assert.Equal(1, response.CacheHit);
+    }
+
+    [SkippableFact]
+    public void CallRawInto___BufferTooSmall___ThrowsInsufficientCapacity()
+    {
+        SkipIfPluginNotAvailable();
+
+        var request = SmallRequestRaw.Create("into_key", 0x01);
+        var output = new byte[8];
+
+        var ex = Assert.Throws<PluginException>(() => _plugin!.CallRawInto(MsgBenchSmall, request, output));
+
+        Assert.Equal(14, ex.ErrorCode);
+    }
+
+    [SkippableFact]
+    public void CallRawBatch___SequentialBatch___ReturnsResponsesInOrder()
+    {
+        SkipIfPluginNotAvailable();
+
+        var requests = Enumerable.Range(0, 8).Select(i => SmallRequestRaw.Create($"batch_key_{i}", 0x01)).ToArray();
+        var messageIds = Enumerable.Repeat(MsgBenchSmall, requests.Length).ToArray();
+
+        var responses = _plugin!.CallRawBatch<SmallRequestRaw, SmallResponseRaw>(messageIds, requests);
+
+        Assert.Equal(requests.Length, responses.Length);
+        for (int i = 0; i < responses.Length; i++)
+        {
+            Assert.Contains($"batch_key_{i}", responses[i].GetValue());
+        }
+    }
+
+    [SkippableFact]
+    public void CallRawBatch___ParallelBatch___ReturnsResponsesInOrder()
+    {
+        SkipIfPluginNotAvailable();
+
+        var requests = Enumerable.Range(0, 64).Select(i => SmallRequestRaw.Create($"parallel_key_{i}", 0x01)).ToArray();
+        var messageIds = Enumerable.Repeat(MsgBenchSmall, requests.Length).ToArray();
+
+        var responses = _plugin!.CallRawBatch<SmallRequestRaw, SmallResponseRaw>(messageIds, requests, parallel: true);
+
+        Assert.Equal(requests.Length, responses.Length);
+        for (int i = 0; i < responses.Length; i++)
+        {
+            Assert.Contains($"parallel_key_{i}", responses[i].GetValue());
+        }
+    }
+
+    [SkippableFact]
+    public void CallRawBatch___UnknownMessageId___ThrowsPluginException()
+    {
+        SkipIfPluginNotAvailable();
+
+        var requests = new[] { SmallRequestRaw.Create("ok", 0), SmallRequestRaw.Create("bad", 0) };
+        var messageIds = new[] { MsgBenchSmall, 999 };
+
+        var ex = Assert.Throws<PluginException>(() =>
+            _plugin!.CallRawBatch<SmallRequestRaw, SmallResponseRaw>(messageIds, requests));
+
+        Assert.Equal(6, ex.ErrorCode);
+    }
+
+    [SkippableFact]
+    public void RingChannel___SmallBenchmark___AnswersFramesInOrder()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+        Assert.True(plugin.HasRingTransport, "Plugin should support ring transport");
+
+        using var ring = plugin.OpenRing();
+        const int count = 100;
+        for (int i = 0; i < count; i++)
+        {
+            var request = SmallRequestRaw.Create($"ring_key_{i}", 0x01);
+            Assert.True(ring.TryWrite(MsgBenchSmall, (ulong)i, MemoryMarshal.AsBytes(MemoryMarshal.CreateReadOnlySpan(ref request, 1))));
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            RingFrame frame;
+            while (!ring.TryRead(out frame))
+            {
+                ring.WaitForResponses(100);
+            }
+            var response = MemoryMarshal.Read<SmallResponseRaw>(frame.PayloadOrThrow());
+
+            Assert.Equal((ulong)i, frame.CorrelationId);
+            Assert.Equal(MsgBenchSmall, frame.MessageId);
+            Assert.Contains($"ring_key_{i}", response.GetValue());
+        }
+    }
+
+    [SkippableFact]
+    public void RingChannel___UnknownMessageId___ReturnsErrorFrame()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+
+        using var ring = plugin.OpenRing();
+        Assert.True(ring.TryWrite(999, 42, new byte[] { 1, 2, 3 }));
+
+        RingFrame frame;
+        while (!ring.TryRead(out frame))
+        {
+            ring.WaitForResponses(100);
+        }
+
+        Assert.Equal(42UL, frame.CorrelationId);
+        Assert.Equal(6, frame.Status);
+        var ex = Assert.Throws<PluginException>(() => frame.PayloadOrThrow());
+        Assert.Equal(6, ex.ErrorCode);
+    }
+
     // ==================== Binary Struct Types ====================
 
     /// <summary>
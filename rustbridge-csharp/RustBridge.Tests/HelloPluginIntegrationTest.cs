@@ -1,3 +1,4 @@
+using System.Text;
 using System.Text.Json;
 using System.Text.Json.Serialization;
 using RustBridge.Native;
@@ -223,6 +224,87 @@ public class HelloPluginIntegrationTest : IDisposable
         Assert.Equal(5, ex.ErrorCode); // SerializationError
     }
 
+    // ==================== Content Type Tests ====================
+
+    [SkippableFact]
+    public void CallAs___MsgPackEcho___ReturnsMsgPackResponse()
+    {
+        SkipIfPluginNotAvailable();
+
+        // {"message": "hi"}
+        byte[] request = [0x81, 0xa7, .."message"u8, 0xa2, .."hi"u8];
+        // {"message": "hi", "length": 2}
+        byte[] expected = [0x82, 0xa7, .."message"u8, 0xa2, .."hi"u8, 0xa6, .."length"u8, 0x02];
+
+        var response = _plugin!.CallAs("echo", "application/msgpack", request);
+
+        Assert.Equal(expected, response);
+    }
+
+    [SkippableFact]
+    public void CallAs___UnknownContentType___ThrowsWithErrorCode15()
+    {
+        SkipIfPluginNotAvailable();
+
+        var ex = Assert.Throws<PluginException>(() =>
+            _plugin!.CallAs("echo", "application/cbor", [0xa0]));
+
+        Assert.Equal(15, ex.ErrorCode); // UnsupportedContentType
+    }
+
+    // ==================== Streaming Tests ====================
+
+    [SkippableFact]
+    public void CallStream___Echo___YieldsWholeResponseAsOneChunk()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+
+        var chunks = plugin.CallStream("echo", """{"message": "streamed"}""").ToList();
+
+        Assert.Single(chunks);
+        Assert.Contains("streamed", Encoding.UTF8.GetString(chunks[0]));
+    }
+
+    [SkippableFact]
+    public void CallStream___UnknownTypeTag___ThrowsOnOpen()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+
+        var ex = Assert.Throws<PluginException>(() => plugin.CallStream("nonexistent.type", "{}"));
+
+        Assert.Equal(6, ex.ErrorCode); // UnknownMessageType
+    }
+
+    // ==================== Streamed Request Tests ====================
+
+    [SkippableFact]
+    public void OpenRequest___EchoWrittenInPieces___ReturnsResponse()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+
+        using var writer = plugin.OpenRequest("echo");
+        writer.Write(Encoding.UTF8.GetBytes("""{"message": """));
+        writer.Write(Encoding.UTF8.GetBytes("\"in pieces\"}"));
+        var response = writer.Finish();
+
+        Assert.Contains("in pieces", response);
+    }
+
+    [SkippableFact]
+    public void OpenRequest___UnknownTypeTag___ThrowsOnFinish()
+    {
+        SkipIfPluginNotAvailable();
+        var plugin = (NativePlugin)_plugin!;
+
+        using var writer = plugin.OpenRequest("nonexistent.type");
+        var ex = Assert.Throws<PluginException>(() => writer.Finish());
+
+        Assert.Equal(6, ex.ErrorCode); // UnknownMessageType
+    }
+
     // ==================== Concurrency Tests ====================
 
     [SkippableFact]
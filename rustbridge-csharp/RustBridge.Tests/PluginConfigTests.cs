@@ -87,4 +87,48 @@ public class PluginConfigTests
         Assert.Equal(500, root.GetProperty("max_concurrent_ops").GetInt32());
         Assert.Equal(10000, root.GetProperty("shutdown_timeout_ms").GetInt64());
     }
+
+    [Fact]
+    public void ToJsonBytes___WithoutAdmission___OmitsAdmissionSection()
+    {
+        var json = JsonDocument.Parse(PluginConfig.Defaults().ToJsonBytes());
+
+        Assert.False(json.RootElement.TryGetProperty("admission", out _));
+    }
+
+    [Fact]
+    public void ToJsonBytes___WithAdmission___IncludesQueueSettings()
+    {
+        var config = PluginConfig.Defaults()
+            .Admission(AdmissionMode.AdaptiveLifo, 25)
+            .AdmissionMaxQueueDepth(64)
+            .AdmissionCodel(5, 100);
+
+        var json = JsonDocument.Parse(config.ToJsonBytes());
+        var admission = json.RootElement.GetProperty("admission");
+
+        Assert.Equal("adaptive_lifo", admission.GetProperty("mode").GetString());
+        Assert.Equal(25, admission.GetProperty("max_wait_ms").GetInt64());
+        Assert.Equal(64, admission.GetProperty("max_queue_depth").GetInt32());
+        Assert.Equal(5, admission.GetProperty("codel_target_ms").GetInt64());
+        Assert.Equal(100, admission.GetProperty("codel_interval_ms").GetInt64());
+    }
+
+    [Fact]
+    public void ToJsonBytes___WithRuntimeSettings___IncludesRuntimeSection()
+    {
+        var config = PluginConfig.Defaults()
+            .WithRuntimeFlavor(RuntimeFlavor.CurrentThread)
+            .SharedRuntime()
+            .CpuAffinity(0, 2)
+            .NumaNode(1);
+
+        var json = JsonDocument.Parse(config.ToJsonBytes());
+        var runtime = json.RootElement.GetProperty("runtime");
+
+        Assert.Equal("current_thread", runtime.GetProperty("flavor").GetString());
+        Assert.True(runtime.GetProperty("shared").GetBoolean());
+        Assert.Equal(2, runtime.GetProperty("cpu_affinity").GetArrayLength());
+        Assert.Equal(1, runtime.GetProperty("numa_node").GetInt32());
+    }
 }
@@ -0,0 +1,39 @@
+package com.rustbridge;
+
+import org.jetbrains.annotations.NotNull;
+
+/**
+ * How a plugin admits requests once {@code max_concurrent_ops} are in flight.
+ */
+public enum AdmissionMode {
+    /**
+     * Reject immediately with error code 13 (TooManyRequests).
+     */
+    REJECT("reject"),
+
+    /**
+     * Queue in arrival order for up to the configured maximum wait.
+     */
+    FIFO("fifo"),
+
+    /**
+     * Queue in arrival order until the queue stays non-empty for the CoDel interval,
+     * then serve the newest request first with the shorter CoDel target as its deadline.
+     */
+    ADAPTIVE_LIFO("adaptive_lifo");
+
+    private final String configValue;
+
+    AdmissionMode(String configValue) {
+        this.configValue = configValue;
+    }
+
+    /**
+     * Get the value used for this mode in the plugin's JSON configuration.
+     *
+     * @return the configuration value
+     */
+    public @NotNull String configValue() {
+        return configValue;
+    }
+}
@@ -0,0 +1,33 @@
+package com.rustbridge;
+
+import org.jetbrains.annotations.NotNull;
+
+/**
+ * Snapshot of a plugin's admission control counters.
+ * <p>
+ * {@code waitHistogramUs[i]} counts queued requests that waited {@code [2^(i-1), 2^i)}
+ * microseconds; bucket 0 counts waits under 1 µs and the last bucket also counts every
+ * longer wait. A plugin without a concurrency limit reports all zeros.
+ *
+ * @param limit           maximum requests in flight (0 = unlimited)
+ * @param inFlight        requests currently holding a slot
+ * @param queueDepth      requests currently queued for a slot
+ * @param admitted        requests admitted, directly or after queueing
+ * @param queued          requests that had to queue
+ * @param rejected        requests rejected, including timeouts
+ * @param timedOut        queued requests whose deadline passed
+ * @param waitHistogramUs queue wait times in log2 microsecond buckets
+ */
+public record AdmissionStats(
+        long limit,
+        long inFlight,
+        long queueDepth,
+        long admitted,
+        long queued,
+        long rejected,
+        long timedOut,
+        long @NotNull [] waitHistogramUs
+) {
+    /** Number of buckets in {@link #waitHistogramUs()}. */
+    public static final int WAIT_HISTOGRAM_BUCKETS = 24;
+}
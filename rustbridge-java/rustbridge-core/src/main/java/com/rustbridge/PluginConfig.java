@@ -20,6 +20,8 @@ public class PluginConfig {
     private @Nullable Integer workerThreads;
     private String logLevel = "info";
     private int maxConcurrentOps = 1000;
+    private @Nullable Map<String, Object> admission;
+    private @Nullable Map<String, Object> runtime;
     private long shutdownTimeoutMs = 5000;
 
     /**
@@ -85,6 +87,118 @@ public class PluginConfig {
         return this;
     }
 
+    /**
+     * Set how requests beyond {@link #maxConcurrentOps(int)} are admitted.
+     * <p>
+     * {@link AdmissionMode#REJECT} (the default) fails them immediately. The queueing
+     * modes make them wait up to {@code maxWaitMs} for a slot before they are rejected.
+     *
+     * @param mode      the admission mode
+     * @param maxWaitMs the longest a queued request waits, in milliseconds
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig admission(@NotNull AdmissionMode mode, long maxWaitMs) {
+        admissionSettings().put("mode", mode.configValue());
+        admissionSettings().put("max_wait_ms", maxWaitMs);
+        return this;
+    }
+
+    /**
+     * Set the maximum number of queued requests; arrivals beyond it are rejected.
+     *
+     * @param depth the maximum queue depth
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig admissionMaxQueueDepth(int depth) {
+        admissionSettings().put("max_queue_depth", depth);
+        return this;
+    }
+
+    /**
+     * Set the CoDel parameters used by {@link AdmissionMode#ADAPTIVE_LIFO}.
+     *
+     * @param targetMs   queue deadline while overloaded, in milliseconds
+     * @param intervalMs how long the queue must stay non-empty to count as overloaded
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig admissionCodel(long targetMs, long intervalMs) {
+        admissionSettings().put("codel_target_ms", targetMs);
+        admissionSettings().put("codel_interval_ms", intervalMs);
+        return this;
+    }
+
+    private Map<String, Object> admissionSettings() {
+        if (this.admission == null) {
+            this.admission = new HashMap<>();
+        }
+        return this.admission;
+    }
+
+    /**
+     * Set the scheduler used by the plugin's Tokio runtime.
+     *
+     * @param flavor the runtime flavor
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig runtimeFlavor(@NotNull RuntimeFlavor flavor) {
+        runtimeSettings().put("flavor", flavor.configValue());
+        return this;
+    }
+
+    /**
+     * Reuse the process-wide runtime instead of building one for this plugin.
+     * <p>
+     * The shared runtime is built by the first plugin that asks for it, so that
+     * plugin's thread and affinity settings apply to every plugin sharing it.
+     *
+     * @param shared true to share the runtime
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig sharedRuntime(boolean shared) {
+        runtimeSettings().put("shared", shared);
+        return this;
+    }
+
+    /**
+     * Set the maximum number of threads in the runtime's blocking pool.
+     *
+     * @param threads the maximum blocking threads
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig maxBlockingThreads(int threads) {
+        runtimeSettings().put("max_blocking_threads", threads);
+        return this;
+    }
+
+    /**
+     * Restrict the runtime's threads to the given CPUs.
+     *
+     * @param cpus CPU indices the threads may run on
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig cpuAffinity(int @NotNull ... cpus) {
+        runtimeSettings().put("cpu_affinity", cpus.clone());
+        return this;
+    }
+
+    /**
+     * Restrict the runtime's threads to the CPUs of a NUMA node (Linux only).
+     *
+     * @param node the NUMA node index
+     * @return this config for chaining
+     */
+    public @NotNull PluginConfig numaNode(int node) {
+        runtimeSettings().put("numa_node", node);
+        return this;
+    }
+
+    private Map<String, Object> runtimeSettings() {
+        if (this.runtime == null) {
+            this.runtime = new HashMap<>();
+        }
+        return this.runtime;
+    }
+
     /**
      * Set the shutdown timeout.
      *
@@ -170,9 +284,15 @@ public class PluginConfig {
         if (workerThreads != null) {
             json.put("worker_threads", workerThreads);
         }
+        if (runtime != null) {
+            json.set("runtime", OBJECT_MAPPER.valueToTree(runtime));
+        }
 
         json.put("log_level", logLevel);
         json.put("max_concurrent_ops", maxConcurrentOps);
+        if (admission != null) {
+            json.set("admission", OBJECT_MAPPER.valueToTree(admission));
+        }
         json.put("shutdown_timeout_ms", shutdownTimeoutMs);
 
         try {
@@ -0,0 +1,99 @@
+package com.rustbridge;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.Objects;
+
+/**
+ * A request payload written to the plugin chunk by chunk.
+ * <p>
+ * Bytes are handed to the plugin's handler as they are written, with only a few
+ * chunks buffered ahead of it, so a large request never has to be held in memory
+ * at once. Writes block while the handler is behind. Concatenated, the written bytes
+ * form the request {@link Plugin#call(String, String)} would have taken.
+ * <p>
+ * Write from one thread at a time. Closing a writer that was not finished discards
+ * the request.
+ *
+ * <pre>{@code
+ * try (RequestWriter writer = plugin.openRequest("import")) {
+ *     input.transferTo(writer);
+ *     String response = writer.finish();
+ * }
+ * }</pre>
+ */
+public abstract class RequestWriter extends OutputStream {
+    private volatile boolean done = false;
+
+    @Override
+    public void write(int b) throws IOException {
+        write(new byte[]{(byte) b}, 0, 1);
+    }
+
+    /**
+     * Send bytes to the handler, blocking while it is behind.
+     *
+     * @throws IOException if the request was finished or discarded, or the plugin
+     *                     rejected the write (the cause is a {@link PluginException})
+     */
+    @Override
+    public void write(byte @NotNull [] b, int off, int len) throws IOException {
+        Objects.checkFromIndexSize(off, len, b.length);
+        if (done) {
+            throw new IOException("Request already finished");
+        }
+        if (len == 0) {
+            return;
+        }
+        try {
+            writeChunk(b, off, len);
+        } catch (PluginException e) {
+            throw new IOException(e.getMessage(), e);
+        }
+    }
+
+    /**
+     * End the request and wait for the handler's response.
+     *
+     * @return the JSON response payload
+     * @throws PluginException if the handler failed
+     * @throws IllegalStateException if the request was already finished or discarded
+     */
+    public @NotNull String finish() throws PluginException {
+        if (done) {
+            throw new IllegalStateException("Request already finished");
+        }
+        done = true;
+        return finishRequest();
+    }
+
+    /**
+     * Discard the request if it was not finished. The handler is stopped and its
+     * admission slot released.
+     */
+    @Override
+    public void close() {
+        if (done) {
+            return;
+        }
+        done = true;
+        abortRequest();
+    }
+
+    /**
+     * Hand {@code len} bytes starting at {@code off} to the plugin.
+     */
+    protected abstract void writeChunk(byte @NotNull [] b, int off, int len) throws PluginException;
+
+    /**
+     * Signal the end of the request and return the response payload.
+     */
+    protected abstract @NotNull String finishRequest() throws PluginException;
+
+    /**
+     * Stop the handler and discard the request.
+     */
+    protected abstract void abortRequest();
+}
@@ -0,0 +1,33 @@
+package com.rustbridge;
+
+import org.jetbrains.annotations.NotNull;
+
+/**
+ * Scheduler used by a plugin's Tokio runtime.
+ */
+public enum RuntimeFlavor {
+    /**
+     * Work-stealing scheduler with one worker per core (or the configured worker count).
+     */
+    MULTI_THREAD("multi_thread"),
+
+    /**
+     * A single scheduler thread, for plugins with little async work.
+     */
+    CURRENT_THREAD("current_thread");
+
+    private final String configValue;
+
+    RuntimeFlavor(String configValue) {
+        this.configValue = configValue;
+    }
+
+    /**
+     * Get the value used for this flavor in the plugin's JSON configuration.
+     *
+     * @return the configuration value
+     */
+    public @NotNull String configValue() {
+        return configValue;
+    }
+}
@@ -105,6 +105,52 @@ class PluginConfigTest {
         assertFalse(jsonStr.contains("\"init_params\""));
     }
 
+    @Test
+    void toJsonBytes___omits_admission_when_not_set() {
+        String jsonStr = new String(PluginConfig.defaults().toJsonBytes());
+
+        assertFalse(jsonStr.contains("\"admission\""));
+    }
+
+    @Test
+    void admission___serializes_mode_and_limits() {
+        PluginConfig config = PluginConfig.defaults()
+            .admission(AdmissionMode.ADAPTIVE_LIFO, 50)
+            .admissionMaxQueueDepth(64)
+            .admissionCodel(5, 100);
+
+        String jsonStr = new String(config.toJsonBytes());
+
+        assertTrue(jsonStr.contains("\"mode\":\"adaptive_lifo\""));
+        assertTrue(jsonStr.contains("\"max_wait_ms\":50"));
+        assertTrue(jsonStr.contains("\"max_queue_depth\":64"));
+        assertTrue(jsonStr.contains("\"codel_target_ms\":5"));
+        assertTrue(jsonStr.contains("\"codel_interval_ms\":100"));
+    }
+
+    @Test
+    void toJsonBytes___omits_runtime_when_not_set() {
+        String jsonStr = new String(PluginConfig.defaults().toJsonBytes());
+
+        assertFalse(jsonStr.contains("\"runtime\""));
+    }
+
+    @Test
+    void runtime___serializes_flavor_sharing_and_affinity() {
+        PluginConfig config = PluginConfig.defaults()
+            .runtimeFlavor(RuntimeFlavor.CURRENT_THREAD)
+            .sharedRuntime(true)
+            .cpuAffinity(0, 2)
+            .numaNode(1);
+
+        String jsonStr = new String(config.toJsonBytes());
+
+        assertTrue(jsonStr.contains("\"flavor\":\"current_thread\""));
+        assertTrue(jsonStr.contains("\"shared\":true"));
+        assertTrue(jsonStr.contains("\"cpu_affinity\":[0,2]"));
+        assertTrue(jsonStr.contains("\"numa_node\":1"));
+    }
+
     @Test
     void initParam___works_with_nested_objects() {
         Map<String, Object> databaseConfig = new HashMap<>();
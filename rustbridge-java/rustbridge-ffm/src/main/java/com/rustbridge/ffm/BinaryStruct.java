@@ -63,8 +63,11 @@ public abstract class BinaryStruct {
     public abstract long byteSize();
 
     // Unaligned layouts for safe access to heap-backed segments (from byte arrays)
+    private static final ValueLayout.OfShort JAVA_SHORT_UNALIGNED = ValueLayout.JAVA_SHORT.withByteAlignment(1);
     private static final ValueLayout.OfInt JAVA_INT_UNALIGNED = ValueLayout.JAVA_INT.withByteAlignment(1);
     private static final ValueLayout.OfLong JAVA_LONG_UNALIGNED = ValueLayout.JAVA_LONG.withByteAlignment(1);
+    private static final ValueLayout.OfFloat JAVA_FLOAT_UNALIGNED = ValueLayout.JAVA_FLOAT.withByteAlignment(1);
+    private static final ValueLayout.OfDouble JAVA_DOUBLE_UNALIGNED = ValueLayout.JAVA_DOUBLE.withByteAlignment(1);
 
     /**
      * Read a fixed-size string field with a separate length field.
@@ -137,6 +140,30 @@ public abstract class BinaryStruct {
         segment.set(ValueLayout.JAVA_BYTE, offset, value);
     }
 
+    /**
+     * Get a short (u16/i16) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @return the short value
+     */
+    protected short getShort(long offset) {
+        return segment.get(JAVA_SHORT_UNALIGNED, offset);
+    }
+
+    /**
+     * Set a short (u16/i16) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @param value  the short value
+     */
+    protected void setShort(long offset, short value) {
+        segment.set(JAVA_SHORT_UNALIGNED, offset, value);
+    }
+
     /**
      * Get an int (u32/i32) field.
      * <p>
@@ -184,4 +211,52 @@ public abstract class BinaryStruct {
     protected void setLong(long offset, long value) {
         segment.set(JAVA_LONG_UNALIGNED, offset, value);
     }
+
+    /**
+     * Get a float (f32) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @return the float value
+     */
+    protected float getFloat(long offset) {
+        return segment.get(JAVA_FLOAT_UNALIGNED, offset);
+    }
+
+    /**
+     * Set a float (f32) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @param value  the float value
+     */
+    protected void setFloat(long offset, float value) {
+        segment.set(JAVA_FLOAT_UNALIGNED, offset, value);
+    }
+
+    /**
+     * Get a double (f64) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @return the double value
+     */
+    protected double getDouble(long offset) {
+        return segment.get(JAVA_DOUBLE_UNALIGNED, offset);
+    }
+
+    /**
+     * Set a double (f64) field.
+     * <p>
+     * Uses unaligned access to support heap-backed segments.
+     *
+     * @param offset byte offset
+     * @param value  the double value
+     */
+    protected void setDouble(long offset, double value) {
+        segment.set(JAVA_DOUBLE_UNALIGNED, offset, value);
+    }
 }
@@ -11,6 +11,7 @@ import org.slf4j.LoggerFactory;
 import java.lang.foreign.*;
 import java.lang.invoke.MethodHandle;
 import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * FFM-based plugin implementation using Java 21+ Foreign Function and Memory API.
@@ -44,11 +45,21 @@ public class FfmPlugin implements Plugin {
     private static final Logger log = LoggerFactory.getLogger(FfmPlugin.class);
     private static final ObjectMapper OBJECT_MAPPER = JsonMapper.getInstance();
 
+    /** Error code returned by plugin_call_raw_into when the output buffer is too small. */
+    private static final int ERROR_INSUFFICIENT_CAPACITY = 14;
+
+    /** Per-thread out_len slot for callRawInto, so the call itself allocates nothing. */
+    private static final ThreadLocal<MemorySegment> OUT_LEN =
+            ThreadLocal.withInitial(() -> Arena.ofAuto().allocate(ValueLayout.JAVA_LONG));
+
     private final Arena pluginArena;
     private final MemorySegment handle;
     private final NativeBindings bindings;
     private final LogCallback logCallback;
 
+    /** Type tag to numeric type ID, resolved once per tag; 0 means the tag has no ID. */
+    private final ConcurrentHashMap<String, Integer> typeIds = new ConcurrentHashMap<>();
+
     private volatile boolean closed = false;
 
     /**
@@ -90,27 +101,103 @@ public class FfmPlugin implements Plugin {
             throw new PluginException(1, "Plugin has been closed");
         }
 
+        int typeId = resolveTypeId(typeTag);
+
         // Use confined arena - faster than shared, safe since we only use it in this thread
         try (Arena callArena = Arena.ofConfined()) {
-            // Allocate type tag as null-terminated string
-            MemorySegment typeTagSegment = callArena.allocateUtf8String(typeTag);
-
             // Allocate request data
             byte[] requestBytes = request.getBytes(StandardCharsets.UTF_8);
             MemorySegment requestSegment = callArena.allocate(requestBytes.length);
             requestSegment.copyFrom(MemorySegment.ofArray(requestBytes));
 
             // Call the plugin - use callArena as SegmentAllocator for return struct
-            MemorySegment resultBuffer = (MemorySegment) bindings.pluginCall().invoke(
-                    callArena,  // SegmentAllocator for return value
+            MemorySegment resultBuffer;
+            if (typeId != 0) {
+                resultBuffer = (MemorySegment) bindings.pluginCallId().invoke(
+                        callArena,  // SegmentAllocator for return value
+                        handle,
+                        typeId,
+                        requestSegment,
+                        (long) requestBytes.length
+                );
+            } else {
+                // Allocate type tag as null-terminated string
+                MemorySegment typeTagSegment = callArena.allocateUtf8String(typeTag);
+                resultBuffer = (MemorySegment) bindings.pluginCall().invoke(
+                        callArena,  // SegmentAllocator for return value
+                        handle,
+                        typeTagSegment,
+                        requestSegment,
+                        (long) requestBytes.length
+                );
+            }
+
+            // Parse the result buffer (copies data to Java heap, then frees native buffer)
+            return parseResultBuffer(resultBuffer);
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native call failed", t);
+        }
+    }
+
+    /**
+     * Look up the numeric ID the plugin assigned to a type tag, asking the plugin only
+     * the first time a tag is seen.
+     *
+     * @return the type ID, or 0 to send the tag as a string
+     */
+    private int resolveTypeId(String typeTag) {
+        if (!bindings.hasCallId()) {
+            return 0;
+        }
+        return typeIds.computeIfAbsent(typeTag, tag -> {
+            try (Arena arena = Arena.ofConfined()) {
+                return (int) bindings.pluginResolveTypeTag().invoke(handle, arena.allocateUtf8String(tag));
+            } catch (Throwable t) {
+                return 0;
+            }
+        });
+    }
+
+    /**
+     * Make a call with the payload encoded in the given content type.
+     * <p>
+     * The request and response bytes are passed through without a JSON envelope, so
+     * binary formats such as {@code application/msgpack} never round-trip through JSON.
+     *
+     * @param typeTag     the message type identifier
+     * @param contentType the payload MIME type, e.g. {@code application/msgpack}
+     * @param request     the encoded request payload
+     * @return the encoded response payload
+     * @throws PluginException if the call fails or the content type is unsupported (code 15)
+     * @throws UnsupportedOperationException if the plugin predates plugin_call_as
+     */
+    public byte @NotNull [] callAs(@NotNull String typeTag, @NotNull String contentType, byte @NotNull [] request)
+            throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        if (!bindings.hasCallAs()) {
+            throw new UnsupportedOperationException("Content-type negotiation not supported by this plugin");
+        }
+
+        try (Arena callArena = Arena.ofConfined()) {
+            MemorySegment typeTagSegment = callArena.allocateUtf8String(typeTag);
+            MemorySegment contentTypeSegment = callArena.allocateUtf8String(contentType);
+            MemorySegment requestSegment = callArena.allocate(request.length);
+            requestSegment.copyFrom(MemorySegment.ofArray(request));
+
+            MemorySegment resultBuffer = (MemorySegment) bindings.pluginCallAs().invoke(
+                    callArena,
                     handle,
                     typeTagSegment,
+                    contentTypeSegment,
                     requestSegment,
-                    (long) requestBytes.length
+                    (long) request.length
             );
 
-            // Parse the result buffer (copies data to Java heap, then frees native buffer)
-            return parseResultBuffer(resultBuffer);
+            return parseRawPayloadBuffer(resultBuffer);
         } catch (PluginException e) {
             throw e;
         } catch (Throwable t) {
@@ -175,6 +262,165 @@ public class FfmPlugin implements Plugin {
         }
     }
 
+    /**
+     * Call the plugin with a binary struct request, writing the response into {@code out}.
+     * <p>
+     * The response is written straight into caller-owned memory, so the call makes no
+     * native allocation and needs no second crossing to free a response. Reuse the same
+     * {@code out} segment across calls to keep the hot path allocation-free.
+     *
+     * <pre>{@code
+     * MemorySegment out = arena.allocate(RESPONSE_SIZE);
+     * long len = plugin.callRawInto(MSG_ID, request, out);
+     * }</pre>
+     *
+     * @param messageId the binary message ID
+     * @param request   the request struct
+     * @param out       the native (off-heap) segment to receive the response
+     * @return the number of bytes written to {@code out}
+     * @throws PluginException if the call fails; error code 14 means {@code out} is too
+     *                         small, and the message then gives the required size
+     */
+    public long callRawInto(int messageId, @NotNull BinaryStruct request, @NotNull MemorySegment out)
+            throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        if (!bindings.hasCallRawInto()) {
+            throw new PluginException(1, "Caller-buffer binary transport not supported by this plugin");
+        }
+
+        MemorySegment outLen = OUT_LEN.get();
+        int result;
+        try {
+            result = (int) bindings.pluginCallRawInto().invokeExact(
+                    handle,
+                    messageId,
+                    request.segment(),
+                    request.byteSize(),
+                    out,
+                    out.byteSize(),
+                    outLen
+            );
+        } catch (Throwable t) {
+            throw new PluginException("Native raw call failed", t);
+        }
+
+        long len = outLen.get(ValueLayout.JAVA_LONG, 0);
+        if (result == 0) {
+            return len;
+        }
+        if (result == ERROR_INSUFFICIENT_CAPACITY) {
+            throw new PluginException(result, "Output buffer too small: " + len + " bytes required");
+        }
+        String errorMessage = len > 0
+                ? new String(out.asSlice(0, len).toArray(ValueLayout.JAVA_BYTE), StandardCharsets.UTF_8)
+                : "Unknown error";
+        throw new PluginException(result, errorMessage);
+    }
+
+    /**
+     * Call the plugin with several binary struct requests in one native call.
+     * <p>
+     * Amortizes the FFI crossing over the whole batch. Equivalent to
+     * {@code callRawBatch(messageIds, requests, false)}.
+     *
+     * @param messageIds the binary message ID for each request
+     * @param requests   the request structs
+     * @return response data for each request, in request order
+     * @throws PluginException if the batch or any message in it fails
+     */
+    public byte @NotNull [] @NotNull [] callRawBatch(int @NotNull [] messageIds, @NotNull BinaryStruct @NotNull [] requests)
+            throws PluginException {
+        return callRawBatch(messageIds, requests, false);
+    }
+
+    /**
+     * Call the plugin with several binary struct requests in one native call.
+     * <p>
+     * Every message is dispatched even if an earlier one fails; the first
+     * failure is then thrown after all responses have been freed.
+     *
+     * <pre>{@code
+     * byte[][] responses = plugin.callRawBatch(
+     *         new int[] {MSG_ID, MSG_ID},
+     *         new BinaryStruct[] {first, second},
+     *         true);
+     * }</pre>
+     *
+     * @param messageIds the binary message ID for each request
+     * @param requests   the request structs
+     * @param parallel   dispatch the messages in parallel on the plugin's worker threads
+     * @return response data for each request, in request order
+     * @throws PluginException if the batch or any message in it fails
+     */
+    public byte @NotNull [] @NotNull [] callRawBatch(int @NotNull [] messageIds, @NotNull BinaryStruct @NotNull [] requests,
+                                                     boolean parallel) throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        if (!bindings.hasBatchTransport()) {
+            throw new PluginException(1, "Batch binary transport not supported by this plugin");
+        }
+        if (messageIds.length != requests.length) {
+            throw new IllegalArgumentException("messageIds and requests must have the same length");
+        }
+
+        int count = requests.length;
+        if (count == 0) {
+            return new byte[0][];
+        }
+
+        try (Arena ffiArena = Arena.ofConfined()) {
+            MemorySegment requestArray = ffiArena.allocateArray(NativeBindings.RB_BATCH_REQUEST_LAYOUT, count);
+            long requestStride = NativeBindings.RB_BATCH_REQUEST_LAYOUT.byteSize();
+            for (int i = 0; i < count; i++) {
+                long base = i * requestStride;
+                requestArray.set(ValueLayout.JAVA_INT, base, messageIds[i]);
+                requestArray.set(ValueLayout.JAVA_INT, base + 4, 0);
+                requestArray.set(ValueLayout.ADDRESS, base + 8, requests[i].segment());
+                requestArray.set(ValueLayout.JAVA_LONG, base + 16, requests[i].byteSize());
+            }
+
+            MemorySegment responseArray = ffiArena.allocateArray(NativeBindings.RB_RESPONSE_LAYOUT, count);
+            int flags = parallel ? NativeBindings.RB_BATCH_PARALLEL : 0;
+
+            int result = (int) bindings.pluginCallRawBatch().invokeExact(
+                    handle,
+                    requestArray,
+                    (long) count,
+                    responseArray,
+                    flags
+            );
+            if (result != 0) {
+                throw new PluginException(result, "Batch call rejected by plugin");
+            }
+
+            // Parse every response so each one is freed, then report the first failure
+            byte[][] responses = new byte[count][];
+            PluginException firstFailure = null;
+            long responseStride = NativeBindings.RB_RESPONSE_LAYOUT.byteSize();
+            for (int i = 0; i < count; i++) {
+                MemorySegment response = responseArray.asSlice(i * responseStride, responseStride);
+                try {
+                    responses[i] = parseRawResultBufferToBytes(response);
+                } catch (PluginException e) {
+                    if (firstFailure == null) {
+                        firstFailure = e;
+                    }
+                }
+            }
+            if (firstFailure != null) {
+                throw firstFailure;
+            }
+            return responses;
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native batch call failed", t);
+        }
+    }
+
     /**
      * Parse the RbResponse buffer and return as byte array.
      */
@@ -236,6 +482,119 @@ public class FfmPlugin implements Plugin {
         }
     }
 
+    /**
+     * Get a snapshot of the plugin's admission control counters.
+     *
+     * @return queue depth, admission and rejection counts, and the queue wait histogram
+     * @throws UnsupportedOperationException if the plugin predates admission stats
+     */
+    public @NotNull AdmissionStats getAdmissionStats() {
+        checkNotClosed();
+        if (!bindings.hasAdmissionStats()) {
+            throw new UnsupportedOperationException("Admission stats not supported by this plugin");
+        }
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment out = arena.allocate(NativeBindings.RB_ADMISSION_STATS_LAYOUT);
+            boolean ok = (boolean) bindings.pluginGetAdmissionStats().invokeExact(handle, out);
+            if (!ok) {
+                throw new IllegalStateException("Invalid plugin handle");
+            }
+            long[] counters = out.asSlice(0, 7 * Long.BYTES).toArray(ValueLayout.JAVA_LONG);
+            long[] histogram = out.asSlice(7 * Long.BYTES).toArray(ValueLayout.JAVA_LONG);
+            return new AdmissionStats(
+                    counters[0], counters[1], counters[2], counters[3],
+                    counters[4], counters[5], counters[6], histogram);
+        } catch (IllegalStateException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new RuntimeException("Failed to get admission stats", t);
+        }
+    }
+
+    /**
+     * Open a shared-memory ring channel to the plugin.
+     * <p>
+     * Frames sent through the channel are answered by the plugin's binary handlers
+     * on its own runtime, without a native call per message. Close the channel
+     * before or after closing the plugin to release its memory.
+     *
+     * @param capacity data bytes per ring, rounded up to a power of two (0 = 1 MiB)
+     * @return the open channel
+     * @throws PluginException if the plugin lacks ring transport, is not active,
+     *                         or the capacity is too large
+     */
+    public @NotNull RingChannel openRing(long capacity) throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        return RingChannel.open(bindings, handle, capacity);
+    }
+
+    /**
+     * Check if the shared-memory ring transport is supported by this plugin.
+     *
+     * @return true if {@link #openRing(long)} is available
+     */
+    public boolean hasRingTransport() {
+        return bindings.hasRingTransport();
+    }
+
+    /**
+     * Make a call whose response is pulled chunk by chunk.
+     * <p>
+     * Errors the handler reports before its first chunk are thrown here. An
+     * admission slot is held until the stream ends or is closed.
+     *
+     * @param typeTag the message type identifier
+     * @param request the request payload as JSON
+     * @return the open stream; close it when done
+     * @throws PluginException if the call fails before streaming starts
+     * @throws UnsupportedOperationException if the plugin predates streamed responses
+     */
+    public @NotNull ResponseStream callStream(@NotNull String typeTag, @NotNull String request)
+            throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        return ResponseStream.open(bindings, handle, typeTag, request.getBytes(StandardCharsets.UTF_8));
+    }
+
+    /**
+     * Check if streamed responses are supported by this plugin.
+     *
+     * @return true if {@link #callStream(String, String)} is available
+     */
+    public boolean hasStreaming() {
+        return bindings.hasStreaming();
+    }
+
+    /**
+     * Open a request whose payload is written chunk by chunk.
+     * <p>
+     * The handler starts right away and reads the payload as it arrives; an
+     * admission slot is held until it returns or the writer is closed.
+     *
+     * @param typeTag the message type identifier
+     * @return the open writer; finish it to get the response, or close it to discard the request
+     * @throws PluginException if the request cannot be opened
+     * @throws UnsupportedOperationException if the plugin predates streamed requests
+     */
+    public @NotNull RequestWriter openRequest(@NotNull String typeTag) throws PluginException {
+        if (closed) {
+            throw new PluginException(1, "Plugin has been closed");
+        }
+        return FfmRequestWriter.open(bindings, handle, typeTag);
+    }
+
+    /**
+     * Check if streamed requests are supported by this plugin.
+     *
+     * @return true if {@link #openRequest(String)} is available
+     */
+    public boolean hasStreamedRequests() {
+        return bindings.hasStreamedRequests();
+    }
+
     /**
      * Check if binary transport is supported by this plugin.
      * <p>
@@ -312,6 +671,30 @@ public class FfmPlugin implements Plugin {
         }
     }
 
+    /**
+     * Copy an un-enveloped payload out of a result buffer, then free it.
+     */
+    private byte[] parseRawPayloadBuffer(MemorySegment bufferStruct) throws PluginException {
+        MemorySegment data = bufferStruct.get(ValueLayout.ADDRESS, 0);
+        long len = bufferStruct.get(ValueLayout.JAVA_LONG, 8);
+        int errorCode = bufferStruct.get(ValueLayout.JAVA_INT, 24);
+
+        try {
+            byte[] bytes = (data.equals(MemorySegment.NULL) || len == 0)
+                    ? new byte[0]
+                    : data.reinterpret(len).toArray(ValueLayout.JAVA_BYTE);
+            if (errorCode != 0) {
+                String errorMessage = bytes.length > 0
+                        ? new String(bytes, StandardCharsets.UTF_8)
+                        : "Unknown error";
+                throw new PluginException(errorCode, errorMessage);
+            }
+            return bytes;
+        } finally {
+            freeBuffer(bufferStruct);
+        }
+    }
+
     /**
      * Free a result buffer.
      */
@@ -0,0 +1,118 @@
+package com.rustbridge.ffm;
+
+import com.rustbridge.PluginException;
+import com.rustbridge.RequestWriter;
+import com.rustbridge.ResponseEnvelope;
+import org.jetbrains.annotations.NotNull;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * {@link RequestWriter} over the plugin_input_* entry points.
+ * <p>
+ * Writes are staged through one native segment owned by the writer, so a
+ * write allocates nothing; larger writes are passed on in staging-sized chunks.
+ */
+final class FfmRequestWriter extends RequestWriter {
+    /** Bytes handed to plugin_input_write per chunk. */
+    static final int STAGING_SIZE = 64 * 1024;
+
+    private final NativeBindings bindings;
+    private final MemorySegment handle;
+    private final long inputId;
+    private final Arena arena;
+    private final MemorySegment staging;
+
+    private FfmRequestWriter(NativeBindings bindings, MemorySegment handle, long inputId) {
+        this.bindings = bindings;
+        this.handle = handle;
+        this.inputId = inputId;
+        this.arena = Arena.ofShared();
+        this.staging = arena.allocate(STAGING_SIZE);
+    }
+
+    static @NotNull FfmRequestWriter open(@NotNull NativeBindings bindings, @NotNull MemorySegment handle,
+                                          @NotNull String typeTag) throws PluginException {
+        if (!bindings.hasStreamedRequests()) {
+            throw new UnsupportedOperationException("Streamed requests not supported by this plugin");
+        }
+
+        try (Arena openArena = Arena.ofConfined()) {
+            MemorySegment typeTagSegment = openArena.allocateUtf8String(typeTag);
+            MemorySegment inputIdSegment = openArena.allocate(ValueLayout.JAVA_LONG);
+
+            MemorySegment result = (MemorySegment) bindings.pluginInputOpen().invoke(
+                    openArena,
+                    handle,
+                    typeTagSegment,
+                    inputIdSegment
+            );
+            ResponseStream.readFrame(bindings, result);
+
+            return new FfmRequestWriter(bindings, handle, inputIdSegment.get(ValueLayout.JAVA_LONG, 0));
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native request open failed", t);
+        }
+    }
+
+    @Override
+    protected void writeChunk(byte @NotNull [] b, int off, int len) throws PluginException {
+        try {
+            while (len > 0) {
+                int n = Math.min(len, STAGING_SIZE);
+                MemorySegment.copy(b, off, staging, ValueLayout.JAVA_BYTE, 0, n);
+                int code = (int) bindings.pluginInputWrite().invokeExact(handle, inputId, staging, (long) n);
+                if (code != 0) {
+                    throw new PluginException(code, "Request write failed");
+                }
+                off += n;
+                len -= n;
+            }
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native request write failed", t);
+        }
+    }
+
+    @Override
+    protected @NotNull String finishRequest() throws PluginException {
+        try (Arena finishArena = Arena.ofConfined()) {
+            MemorySegment result = (MemorySegment) bindings.pluginInputFinish().invoke(
+                    finishArena,
+                    handle,
+                    inputId
+            );
+            byte[] bytes = ResponseStream.readFrame(bindings, result);
+
+            ResponseEnvelope envelope = ResponseEnvelope.fromJson(new String(bytes, StandardCharsets.UTF_8));
+            if (!envelope.isSuccess()) {
+                throw envelope.toException();
+            }
+            String payload = envelope.getPayloadJson();
+            return payload != null ? payload : "null";
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native request finish failed", t);
+        } finally {
+            arena.close();
+        }
+    }
+
+    @Override
+    protected void abortRequest() {
+        try {
+            boolean ignored = (boolean) bindings.pluginInputAbort().invokeExact(handle, inputId);
+        } catch (Throwable t) {
+            // The input is also released at plugin shutdown
+        } finally {
+            arena.close();
+        }
+    }
+}
@@ -29,15 +29,76 @@ public class NativeBindings {
             ValueLayout.ADDRESS.withName("data")
     );
 
+    /**
+     * Memory layout for RbBatchRequest struct (one message in a batch call).
+     * <pre>
+     * struct RbBatchRequest {
+     *     message_id: u32,         // binary message ID
+     *     _reserved: u32,          // alignment padding (zero)
+     *     request: *const c_void,  // request struct pointer
+     *     request_size: usize      // request struct size
+     * }
+     * </pre>
+     */
+    public static final StructLayout RB_BATCH_REQUEST_LAYOUT = MemoryLayout.structLayout(
+            ValueLayout.JAVA_INT.withName("message_id"),
+            ValueLayout.JAVA_INT.withName("_reserved"),
+            ValueLayout.ADDRESS.withName("request"),
+            ValueLayout.JAVA_LONG.withName("request_size")
+    );
+
+    /**
+     * Batch flag: dispatch messages in parallel on the plugin's runtime.
+     */
+    public static final int RB_BATCH_PARALLEL = 1;
+
+    /**
+     * Memory layout for RbAdmissionStats struct (admission control counters).
+     * <pre>
+     * struct RbAdmissionStats {
+     *     limit, in_flight, queue_depth: u64,
+     *     admitted, queued, rejected, timed_out: u64,
+     *     wait_histogram_us: [u64; 24]
+     * }
+     * </pre>
+     */
+    public static final StructLayout RB_ADMISSION_STATS_LAYOUT = MemoryLayout.structLayout(
+            ValueLayout.JAVA_LONG.withName("limit"),
+            ValueLayout.JAVA_LONG.withName("in_flight"),
+            ValueLayout.JAVA_LONG.withName("queue_depth"),
+            ValueLayout.JAVA_LONG.withName("admitted"),
+            ValueLayout.JAVA_LONG.withName("queued"),
+            ValueLayout.JAVA_LONG.withName("rejected"),
+            ValueLayout.JAVA_LONG.withName("timed_out"),
+            MemoryLayout.sequenceLayout(24, ValueLayout.JAVA_LONG).withName("wait_histogram_us")
+    );
+
     private final MethodHandle pluginInit;
     private final MethodHandle pluginCall;
+    private final MethodHandle pluginCallAs;       // nullable - content-type negotiation optional
+    private final MethodHandle pluginCallId;       // nullable - numeric type IDs optional
+    private final MethodHandle pluginResolveTypeTag; // nullable - numeric type IDs optional
     private final MethodHandle pluginCallRaw;      // nullable - binary transport optional
+    private final MethodHandle pluginCallRawBatch; // nullable - batch transport optional
+    private final MethodHandle pluginCallRawInto;  // nullable - caller-buffer transport optional
     private final MethodHandle pluginFreeBuffer;
     private final MethodHandle rbResponseFree;     // nullable - binary transport optional
     private final MethodHandle pluginShutdown;
     private final MethodHandle pluginSetLogLevel;
     private final MethodHandle pluginGetState;
     private final MethodHandle pluginGetRejectedCount;
+    private final MethodHandle pluginGetAdmissionStats; // nullable - older plugins lack it
+    private final MethodHandle pluginRingOpen;     // nullable - ring transport optional
+    private final MethodHandle pluginRingNotify;   // nullable - ring transport optional
+    private final MethodHandle pluginRingWait;     // nullable - ring transport optional
+    private final MethodHandle pluginRingClose;    // nullable - ring transport optional
+    private final MethodHandle pluginStreamOpen;   // nullable - streaming optional
+    private final MethodHandle pluginStreamNext;   // nullable - streaming optional
+    private final MethodHandle pluginStreamClose;  // nullable - streaming optional
+    private final MethodHandle pluginInputOpen;    // nullable - streamed requests optional
+    private final MethodHandle pluginInputWrite;   // nullable - streamed requests optional
+    private final MethodHandle pluginInputFinish;  // nullable - streamed requests optional
+    private final MethodHandle pluginInputAbort;   // nullable - streamed requests optional
     private final boolean hasBinaryTransport;
 
     /**
@@ -81,6 +142,53 @@ public class NativeBindings {
                 )
         );
 
+        // plugin_call_as(handle, type_tag, content_type, request, request_len) -> FfiBuffer
+        var callAsSymbol = lookup.find("plugin_call_as");
+        if (callAsSymbol.isPresent()) {
+            this.pluginCallAs = linker.downcallHandle(
+                    callAsSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,      // return: FfiBuffer
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.ADDRESS,  // type_tag
+                            ValueLayout.ADDRESS,  // content_type (nullable)
+                            ValueLayout.ADDRESS,  // request
+                            ValueLayout.JAVA_LONG // request_len
+                    )
+            );
+        } else {
+            this.pluginCallAs = null;
+        }
+
+        // plugin_resolve_type_tag(handle, type_tag) -> u32
+        // plugin_call_id(handle, type_id, request, request_len) -> FfiBuffer
+        // Optional - older plugins only accept C-string type tags
+        var resolveTypeTagSymbol = lookup.find("plugin_resolve_type_tag");
+        var callIdSymbol = lookup.find("plugin_call_id");
+        if (resolveTypeTagSymbol.isPresent() && callIdSymbol.isPresent()) {
+            this.pluginResolveTypeTag = linker.downcallHandle(
+                    resolveTypeTagSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_INT, // return: type ID, 0 if unknown
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.ADDRESS   // type_tag
+                    )
+            );
+            this.pluginCallId = linker.downcallHandle(
+                    callIdSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,      // return: FfiBuffer
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.JAVA_INT, // type_id
+                            ValueLayout.ADDRESS,  // request
+                            ValueLayout.JAVA_LONG // request_len
+                    )
+            );
+        } else {
+            this.pluginResolveTypeTag = null;
+            this.pluginCallId = null;
+        }
+
         // plugin_call_raw(handle, message_id, request, request_size) -> RbResponse
         // Optional - binary transport may not be available
         var callRawSymbol = lookup.find("plugin_call_raw");
@@ -99,6 +207,46 @@ public class NativeBindings {
             this.pluginCallRaw = null;
         }
 
+        // plugin_call_raw_batch(handle, requests, count, responses, flags) -> u32
+        // Optional - older plugins do not export the batch entry point
+        var callRawBatchSymbol = lookup.find("plugin_call_raw_batch");
+        if (callRawBatchSymbol.isPresent()) {
+            this.pluginCallRawBatch = linker.downcallHandle(
+                    callRawBatchSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_INT,  // return: error code
+                            ValueLayout.ADDRESS,   // handle
+                            ValueLayout.ADDRESS,   // requests
+                            ValueLayout.JAVA_LONG, // count
+                            ValueLayout.ADDRESS,   // responses
+                            ValueLayout.JAVA_INT   // flags
+                    )
+            );
+        } else {
+            this.pluginCallRawBatch = null;
+        }
+
+        // plugin_call_raw_into(handle, message_id, request, request_size, out, out_capacity, out_len) -> u32
+        // Optional - older plugins do not export the caller-buffer entry point
+        var callRawIntoSymbol = lookup.find("plugin_call_raw_into");
+        if (callRawIntoSymbol.isPresent()) {
+            this.pluginCallRawInto = linker.downcallHandle(
+                    callRawIntoSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_INT,  // return: error code
+                            ValueLayout.ADDRESS,   // handle
+                            ValueLayout.JAVA_INT,  // message_id
+                            ValueLayout.ADDRESS,   // request
+                            ValueLayout.JAVA_LONG, // request_size
+                            ValueLayout.ADDRESS,   // out
+                            ValueLayout.JAVA_LONG, // out_capacity
+                            ValueLayout.ADDRESS    // out_len
+                    )
+            );
+        } else {
+            this.pluginCallRawInto = null;
+        }
+
         // plugin_free_buffer(buffer)
         this.pluginFreeBuffer = linker.downcallHandle(
                 lookup.find("plugin_free_buffer").orElseThrow(),
@@ -159,6 +307,153 @@ public class NativeBindings {
                         ValueLayout.ADDRESS    // handle
                 )
         );
+
+        // plugin_get_admission_stats(handle, out) -> bool
+        var admissionStatsSymbol = lookup.find("plugin_get_admission_stats");
+        if (admissionStatsSymbol.isPresent()) {
+            this.pluginGetAdmissionStats = linker.downcallHandle(
+                    admissionStatsSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_BOOLEAN, // return: true if copied
+                            ValueLayout.ADDRESS,      // handle
+                            ValueLayout.ADDRESS       // out
+                    )
+            );
+        } else {
+            this.pluginGetAdmissionStats = null;
+        }
+
+        // plugin_ring_open / plugin_ring_notify / plugin_ring_wait / plugin_ring_close
+        // Optional - older plugins do not export the ring transport
+        var ringOpenSymbol = lookup.find("plugin_ring_open");
+        var ringNotifySymbol = lookup.find("plugin_ring_notify");
+        var ringWaitSymbol = lookup.find("plugin_ring_wait");
+        var ringCloseSymbol = lookup.find("plugin_ring_close");
+        if (ringOpenSymbol.isPresent() && ringNotifySymbol.isPresent()
+                && ringWaitSymbol.isPresent() && ringCloseSymbol.isPresent()) {
+            this.pluginRingOpen = linker.downcallHandle(
+                    ringOpenSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.ADDRESS,  // return: RbRingChannel* (nullable)
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.JAVA_LONG // capacity
+                    )
+            );
+            this.pluginRingNotify = linker.downcallHandle(
+                    ringNotifySymbol.get(),
+                    FunctionDescriptor.ofVoid(
+                            ValueLayout.ADDRESS   // channel
+                    )
+            );
+            this.pluginRingWait = linker.downcallHandle(
+                    ringWaitSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_BOOLEAN, // return: frames waiting
+                            ValueLayout.ADDRESS,      // channel
+                            ValueLayout.JAVA_INT      // timeout_ms
+                    )
+            );
+            this.pluginRingClose = linker.downcallHandle(
+                    ringCloseSymbol.get(),
+                    FunctionDescriptor.ofVoid(
+                            ValueLayout.ADDRESS   // channel
+                    )
+            );
+        } else {
+            this.pluginRingOpen = null;
+            this.pluginRingNotify = null;
+            this.pluginRingWait = null;
+            this.pluginRingClose = null;
+        }
+
+        // plugin_stream_open / plugin_stream_next / plugin_stream_close
+        // Optional - older plugins do not export streamed responses
+        var streamOpenSymbol = lookup.find("plugin_stream_open");
+        var streamNextSymbol = lookup.find("plugin_stream_next");
+        var streamCloseSymbol = lookup.find("plugin_stream_close");
+        if (streamOpenSymbol.isPresent() && streamNextSymbol.isPresent() && streamCloseSymbol.isPresent()) {
+            this.pluginStreamOpen = linker.downcallHandle(
+                    streamOpenSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,       // return: FfiBuffer (empty on success)
+                            ValueLayout.ADDRESS,   // handle
+                            ValueLayout.ADDRESS,   // type_tag
+                            ValueLayout.ADDRESS,   // request
+                            ValueLayout.JAVA_LONG, // request_len
+                            ValueLayout.ADDRESS    // stream_id (out)
+                    )
+            );
+            this.pluginStreamNext = linker.downcallHandle(
+                    streamNextSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,      // return: FfiBuffer frame
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.JAVA_LONG // stream_id
+                    )
+            );
+            this.pluginStreamClose = linker.downcallHandle(
+                    streamCloseSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_BOOLEAN, // return: stream was open
+                            ValueLayout.ADDRESS,      // handle
+                            ValueLayout.JAVA_LONG     // stream_id
+                    )
+            );
+        } else {
+            this.pluginStreamOpen = null;
+            this.pluginStreamNext = null;
+            this.pluginStreamClose = null;
+        }
+
+        // plugin_input_open / plugin_input_write / plugin_input_finish / plugin_input_abort
+        // Optional - older plugins do not export streamed requests
+        var inputOpenSymbol = lookup.find("plugin_input_open");
+        var inputWriteSymbol = lookup.find("plugin_input_write");
+        var inputFinishSymbol = lookup.find("plugin_input_finish");
+        var inputAbortSymbol = lookup.find("plugin_input_abort");
+        if (inputOpenSymbol.isPresent() && inputWriteSymbol.isPresent()
+                && inputFinishSymbol.isPresent() && inputAbortSymbol.isPresent()) {
+            this.pluginInputOpen = linker.downcallHandle(
+                    inputOpenSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,     // return: FfiBuffer (empty on success)
+                            ValueLayout.ADDRESS, // handle
+                            ValueLayout.ADDRESS, // type_tag
+                            ValueLayout.ADDRESS  // input_id (out)
+                    )
+            );
+            this.pluginInputWrite = linker.downcallHandle(
+                    inputWriteSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_INT,  // return: error code
+                            ValueLayout.ADDRESS,   // handle
+                            ValueLayout.JAVA_LONG, // input_id
+                            ValueLayout.ADDRESS,   // data
+                            ValueLayout.JAVA_LONG  // len
+                    )
+            );
+            this.pluginInputFinish = linker.downcallHandle(
+                    inputFinishSymbol.get(),
+                    FunctionDescriptor.of(
+                            ffiBufferLayout,      // return: FfiBuffer response envelope
+                            ValueLayout.ADDRESS,  // handle
+                            ValueLayout.JAVA_LONG // input_id
+                    )
+            );
+            this.pluginInputAbort = linker.downcallHandle(
+                    inputAbortSymbol.get(),
+                    FunctionDescriptor.of(
+                            ValueLayout.JAVA_BOOLEAN, // return: input was open
+                            ValueLayout.ADDRESS,      // handle
+                            ValueLayout.JAVA_LONG     // input_id
+                    )
+            );
+        } else {
+            this.pluginInputOpen = null;
+            this.pluginInputWrite = null;
+            this.pluginInputFinish = null;
+            this.pluginInputAbort = null;
+        }
     }
 
     public MethodHandle pluginInit() {
@@ -169,10 +464,30 @@ public class NativeBindings {
         return pluginCall;
     }
 
+    public MethodHandle pluginCallAs() {
+        return pluginCallAs;
+    }
+
+    public MethodHandle pluginCallId() {
+        return pluginCallId;
+    }
+
+    public MethodHandle pluginResolveTypeTag() {
+        return pluginResolveTypeTag;
+    }
+
     public MethodHandle pluginCallRaw() {
         return pluginCallRaw;
     }
 
+    public MethodHandle pluginCallRawBatch() {
+        return pluginCallRawBatch;
+    }
+
+    public MethodHandle pluginCallRawInto() {
+        return pluginCallRawInto;
+    }
+
     public MethodHandle pluginFreeBuffer() {
         return pluginFreeBuffer;
     }
@@ -197,6 +512,54 @@ public class NativeBindings {
         return pluginGetRejectedCount;
     }
 
+    public MethodHandle pluginGetAdmissionStats() {
+        return pluginGetAdmissionStats;
+    }
+
+    public MethodHandle pluginRingOpen() {
+        return pluginRingOpen;
+    }
+
+    public MethodHandle pluginRingNotify() {
+        return pluginRingNotify;
+    }
+
+    public MethodHandle pluginRingWait() {
+        return pluginRingWait;
+    }
+
+    public MethodHandle pluginRingClose() {
+        return pluginRingClose;
+    }
+
+    public MethodHandle pluginStreamOpen() {
+        return pluginStreamOpen;
+    }
+
+    public MethodHandle pluginStreamNext() {
+        return pluginStreamNext;
+    }
+
+    public MethodHandle pluginStreamClose() {
+        return pluginStreamClose;
+    }
+
+    public MethodHandle pluginInputOpen() {
+        return pluginInputOpen;
+    }
+
+    public MethodHandle pluginInputWrite() {
+        return pluginInputWrite;
+    }
+
+    public MethodHandle pluginInputFinish() {
+        return pluginInputFinish;
+    }
+
+    public MethodHandle pluginInputAbort() {
+        return pluginInputAbort;
+    }
+
     /**
      * Check if binary transport is supported by this plugin.
      *
@@ -205,4 +568,76 @@ public class NativeBindings {
     public boolean hasBinaryTransport() {
         return hasBinaryTransport;
     }
+
+    /**
+     * Check if the batched binary entry point is supported by this plugin.
+     *
+     * @return true if plugin_call_raw_batch is available
+     */
+    public boolean hasBatchTransport() {
+        return hasBinaryTransport && pluginCallRawBatch != null;
+    }
+
+    /**
+     * Check if the caller-buffer binary entry point is supported by this plugin.
+     *
+     * @return true if plugin_call_raw_into is available
+     */
+    public boolean hasCallRawInto() {
+        return pluginCallRawInto != null;
+    }
+
+    /**
+     * Check if the content-type negotiating entry point is supported by this plugin.
+     *
+     * @return true if plugin_call_as is available
+     */
+    public boolean hasCallAs() {
+        return pluginCallAs != null;
+    }
+
+    /**
+     * Check if the numeric type ID entry points are supported by this plugin.
+     *
+     * @return true if plugin_resolve_type_tag and plugin_call_id are available
+     */
+    public boolean hasCallId() {
+        return pluginCallId != null;
+    }
+
+    /**
+     * Check if the admission stats entry point is supported by this plugin.
+     *
+     * @return true if plugin_get_admission_stats is available
+     */
+    public boolean hasAdmissionStats() {
+        return pluginGetAdmissionStats != null;
+    }
+
+    /**
+     * Check if the shared-memory ring transport is supported by this plugin.
+     *
+     * @return true if the plugin_ring_* entry points are available
+     */
+    public boolean hasRingTransport() {
+        return pluginRingOpen != null;
+    }
+
+    /**
+     * Check if streamed responses are supported by this plugin.
+     *
+     * @return true if the plugin_stream_* entry points are available
+     */
+    public boolean hasStreaming() {
+        return pluginStreamOpen != null;
+    }
+
+    /**
+     * Check if streamed requests are supported by this plugin.
+     *
+     * @return true if the plugin_input_* entry points are available
+     */
+    public boolean hasStreamedRequests() {
+        return pluginInputOpen != null;
+    }
 }
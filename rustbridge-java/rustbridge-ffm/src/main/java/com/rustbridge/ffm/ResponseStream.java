@@ -0,0 +1,182 @@
+package com.rustbridge.ffm;
+
+import com.rustbridge.PluginException;
+import com.rustbridge.ResponseEnvelope;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.io.ByteArrayOutputStream;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * A plugin response pulled chunk by chunk.
+ * <p>
+ * The plugin produces only a few chunks ahead of the reader, so a large response
+ * never has to be held in memory at once on either side. Concatenated, the chunks
+ * form the payload {@link FfmPlugin#call(String, String)} would have returned.
+ * <p>
+ * Read from one thread at a time. {@link #close()} may be called from any thread;
+ * a read blocked on the stream then fails with code 9 (Cancelled).
+ *
+ * <pre>{@code
+ * try (ResponseStream stream = plugin.callStream("export", request)) {
+ *     byte[] chunk;
+ *     while ((chunk = stream.nextChunk()) != null) {
+ *         out.write(chunk);
+ *     }
+ * }
+ * }</pre>
+ */
+public final class ResponseStream implements AutoCloseable {
+    private final NativeBindings bindings;
+    private final MemorySegment handle;
+    private final long streamId;
+
+    private volatile boolean done = false;
+
+    private ResponseStream(NativeBindings bindings, MemorySegment handle, long streamId) {
+        this.bindings = bindings;
+        this.handle = handle;
+        this.streamId = streamId;
+    }
+
+    static @NotNull ResponseStream open(@NotNull NativeBindings bindings, @NotNull MemorySegment handle,
+                                        @NotNull String typeTag, byte @NotNull [] request) throws PluginException {
+        if (!bindings.hasStreaming()) {
+            throw new UnsupportedOperationException("Streamed responses not supported by this plugin");
+        }
+
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment typeTagSegment = arena.allocateUtf8String(typeTag);
+            MemorySegment requestSegment = arena.allocate(Math.max(request.length, 1));
+            requestSegment.copyFrom(MemorySegment.ofArray(request));
+            MemorySegment streamIdSegment = arena.allocate(ValueLayout.JAVA_LONG);
+
+            MemorySegment result = (MemorySegment) bindings.pluginStreamOpen().invoke(
+                    arena,
+                    handle,
+                    typeTagSegment,
+                    requestSegment,
+                    (long) request.length,
+                    streamIdSegment
+            );
+            readFrame(bindings, result);
+
+            return new ResponseStream(bindings, handle, streamIdSegment.get(ValueLayout.JAVA_LONG, 0));
+        } catch (PluginException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new PluginException("Native stream open failed", t);
+        }
+    }
+
+    /**
+     * Block until the next chunk is ready.
+     *
+     * @return the next chunk, or null once the response is complete
+     * @throws PluginException if the handler failed or the stream was cancelled;
+     *                         the stream is finished afterwards
+     */
+    public byte @Nullable [] nextChunk() throws PluginException {
+        if (done) {
+            return null;
+        }
+
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment result = (MemorySegment) bindings.pluginStreamNext().invoke(arena, handle, streamId);
+            byte[] chunk = readFrame(bindings, result);
+            if (chunk.length == 0) {
+                done = true;
+                return null;
+            }
+            return chunk;
+        } catch (PluginException e) {
+            done = true;
+            throw e;
+        } catch (Throwable t) {
+            done = true;
+            throw new PluginException("Native stream read failed", t);
+        }
+    }
+
+    /**
+     * Read the remaining chunks into one array.
+     *
+     * @return the rest of the response
+     * @throws PluginException if the handler failed or the stream was cancelled
+     */
+    public byte @NotNull [] readAll() throws PluginException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        byte[] chunk;
+        while ((chunk = nextChunk()) != null) {
+            out.writeBytes(chunk);
+        }
+        return out.toByteArray();
+    }
+
+    /**
+     * Stop the stream. The plugin stops producing chunks and releases its admission slot.
+     * <p>
+     * Closing a finished stream does nothing. Must be called before the plugin is closed.
+     */
+    @Override
+    public void close() {
+        if (done) {
+            return;
+        }
+        done = true;
+        try {
+            boolean ignored = (boolean) bindings.pluginStreamClose().invokeExact(handle, streamId);
+        } catch (Throwable t) {
+            // The stream is also released at plugin shutdown
+        }
+    }
+
+    /**
+     * Copy a frame's bytes out and free it, throwing if it carries an error.
+     */
+    static byte[] readFrame(NativeBindings bindings, MemorySegment bufferStruct) throws PluginException {
+        MemorySegment data = bufferStruct.get(ValueLayout.ADDRESS, 0);
+        long len = bufferStruct.get(ValueLayout.JAVA_LONG, 8);
+        int errorCode = bufferStruct.get(ValueLayout.JAVA_INT, 24);
+
+        byte[] bytes;
+        try {
+            bytes = (data.equals(MemorySegment.NULL) || len == 0)
+                    ? new byte[0]
+                    : data.reinterpret(len).toArray(ValueLayout.JAVA_BYTE);
+        } finally {
+            try {
+                bindings.pluginFreeBuffer().invokeExact(bufferStruct);
+            } catch (Throwable t) {
+                // Leak the buffer rather than mask the frame
+            }
+        }
+
+        if (errorCode != 0) {
+            throw toException(errorCode, bytes);
+        }
+        return bytes;
+    }
+
+    /**
+     * Error frames hold an error envelope, or plain text if the handle itself was bad.
+     */
+    private static PluginException toException(int errorCode, byte[] bytes) {
+        String text = new String(bytes, StandardCharsets.UTF_8);
+        if (text.startsWith("{")) {
+            try {
+                ResponseEnvelope envelope = ResponseEnvelope.fromJson(text);
+                if (!envelope.isSuccess()) {
+                    return envelope.toException();
+                }
+            } catch (RuntimeException e) {
+                // Not an envelope; report the raw text
+            }
+        }
+        return new PluginException(errorCode, text.isEmpty() ? "Unknown error" : text);
+    }
+}
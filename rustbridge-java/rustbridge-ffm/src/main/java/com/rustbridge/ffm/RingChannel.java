@@ -0,0 +1,331 @@
+package com.rustbridge.ffm;
+
+import com.rustbridge.PluginException;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.lang.invoke.VarHandle;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.locks.ReentrantLock;
+
+/**
+ * Shared-memory ring channel to a plugin.
+ * <p>
+ * Requests are written straight into a ring the plugin consumes on its own runtime,
+ * and responses come back through a second ring, so a steady stream of messages
+ * crosses into native code only when one side has to be woken. Each frame carries a
+ * binary message ID, a caller-chosen correlation ID, and an opaque payload that is
+ * handed to the plugin's binary handler for that message ID.
+ * <p>
+ * Both rings are single-producer, single-consumer. This class serializes its
+ * producers and its consumers with locks, so any thread may call {@link #offer} or
+ * {@link #poll}. Responses arrive in request order.
+ *
+ * <pre>{@code
+ * try (RingChannel ring = plugin.openRing(0)) {
+ *     ring.offer(MSG_ID, 1, payload);
+ *     RingChannel.Frame response;
+ *     while ((response = ring.poll()) == null) {
+ *         ring.awaitResponses(100);
+ *     }
+ * }
+ * }</pre>
+ */
+public final class RingChannel implements AutoCloseable {
+    // RbRing header offsets (see rustbridge_types.h)
+    private static final long HEAD = 0;
+    private static final long TAIL = 64;
+    private static final long SIGNAL = 128;
+    private static final long WAITERS = 132;
+    private static final long CAPACITY = 192;
+    private static final long CLOSED = 200;
+    private static final long HEADER_SIZE = 256;
+
+    // RbRingFrame offsets
+    private static final long FRAME_LEN = 0;
+    private static final long FRAME_MESSAGE_ID = 4;
+    private static final long FRAME_STATUS = 8;
+    private static final long FRAME_CORRELATION_ID = 16;
+    private static final long FRAME_HEADER_SIZE = 24;
+
+    private static final int RING_WRAP = 0xFFFFFFFF;
+
+    private static final VarHandle LONG = ValueLayout.JAVA_LONG.varHandle();
+    private static final VarHandle INT = ValueLayout.JAVA_INT.varHandle();
+
+    /**
+     * A response frame read from the ring.
+     *
+     * @param messageId     the request's message ID
+     * @param status        0 on success, otherwise the error code
+     * @param correlationId the request's correlation ID
+     * @param payload       the response bytes, or a UTF-8 error message when status is non-zero
+     */
+    public record Frame(int messageId, int status, long correlationId, byte @NotNull [] payload) {
+        /**
+         * @return true if the plugin handled the request successfully
+         */
+        public boolean isSuccess() {
+            return status == 0;
+        }
+
+        /**
+         * @return the response bytes
+         * @throws PluginException if the plugin reported an error for this request
+         */
+        public byte @NotNull [] payloadOrThrow() throws PluginException {
+            if (status != 0) {
+                throw new PluginException(status, new String(payload, StandardCharsets.UTF_8));
+            }
+            return payload;
+        }
+    }
+
+    private final NativeBindings bindings;
+    private final MemorySegment channel;
+    private final Ring request;
+    private final Ring response;
+    private final ReentrantLock producerLock = new ReentrantLock();
+    private final ReentrantLock consumerLock = new ReentrantLock();
+    private volatile boolean closed = false;
+
+    private RingChannel(NativeBindings bindings, MemorySegment channel) {
+        this.bindings = bindings;
+        this.channel = channel.reinterpret(2 * ValueLayout.ADDRESS.byteSize());
+        this.request = new Ring(this.channel.get(ValueLayout.ADDRESS, 0));
+        this.response = new Ring(this.channel.get(ValueLayout.ADDRESS, ValueLayout.ADDRESS.byteSize()));
+    }
+
+    static @NotNull RingChannel open(@NotNull NativeBindings bindings, @NotNull MemorySegment handle, long capacity)
+            throws PluginException {
+        if (!bindings.hasRingTransport()) {
+            throw new PluginException(1, "Ring transport not supported by this plugin");
+        }
+        MemorySegment channel;
+        try {
+            channel = (MemorySegment) bindings.pluginRingOpen().invokeExact(handle, capacity);
+        } catch (Throwable t) {
+            throw new PluginException("Native ring open failed", t);
+        }
+        if (channel.address() == 0) {
+            throw new PluginException(1, "Failed to open ring channel (plugin not active or capacity too large)");
+        }
+        return new RingChannel(bindings, channel);
+    }
+
+    /**
+     * @return the largest payload a single frame can carry
+     */
+    public long maxPayload() {
+        return request.capacity / 2 - FRAME_HEADER_SIZE;
+    }
+
+    /**
+     * Publish a request frame.
+     *
+     * @param messageId     the binary message ID
+     * @param correlationId identifier echoed in the response
+     * @param payload       the request bytes
+     * @return false if the ring is full; poll responses and retry
+     * @throws IllegalArgumentException if the payload exceeds {@link #maxPayload()}
+     * @throws IllegalStateException    if the channel or plugin has been closed
+     */
+    public boolean offer(int messageId, long correlationId, byte @NotNull [] payload) {
+        if (payload.length > maxPayload()) {
+            throw new IllegalArgumentException("Payload of " + payload.length + " bytes exceeds ring frame limit");
+        }
+        producerLock.lock();
+        try {
+            checkOpen(request);
+            if (!request.tryPush(messageId, correlationId, payload)) {
+                return false;
+            }
+            if ((int) INT.getVolatile(request.waiters) != 0) {
+                bindings.pluginRingNotify().invokeExact(channel);
+            }
+            return true;
+        } catch (RuntimeException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new RuntimeException("Native ring notify failed", t);
+        } finally {
+            producerLock.unlock();
+        }
+    }
+
+    /**
+     * Take the oldest response frame.
+     *
+     * @return the frame, or null if no response is waiting
+     * @throws IllegalStateException if the channel has been closed
+     */
+    public @Nullable Frame poll() {
+        consumerLock.lock();
+        try {
+            if (closed) {
+                throw new IllegalStateException("Ring channel has been closed");
+            }
+            return response.tryPop();
+        } finally {
+            consumerLock.unlock();
+        }
+    }
+
+    /**
+     * Block until a response is waiting, the channel closes, or the timeout passes.
+     *
+     * @param timeoutMillis longest time to wait
+     * @return true if a response is waiting (may be spurious)
+     */
+    public boolean awaitResponses(int timeoutMillis) {
+        if (closed) {
+            throw new IllegalStateException("Ring channel has been closed");
+        }
+        try {
+            return (boolean) bindings.pluginRingWait().invokeExact(channel, timeoutMillis);
+        } catch (Throwable t) {
+            throw new RuntimeException("Native ring wait failed", t);
+        }
+    }
+
+    /**
+     * @return true once the plugin has stopped serving this channel
+     */
+    public boolean isClosed() {
+        return closed || request.isClosed();
+    }
+
+    /**
+     * Stop the plugin's consumer and release both rings.
+     * <p>
+     * Requests still in the ring are not answered. Must be called even after the
+     * plugin itself has been closed.
+     */
+    @Override
+    public void close() {
+        producerLock.lock();
+        consumerLock.lock();
+        try {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            bindings.pluginRingClose().invokeExact(channel);
+        } catch (Throwable t) {
+            throw new RuntimeException("Native ring close failed", t);
+        } finally {
+            consumerLock.unlock();
+            producerLock.unlock();
+        }
+    }
+
+    private void checkOpen(Ring ring) {
+        if (closed) {
+            throw new IllegalStateException("Ring channel has been closed");
+        }
+        if (ring.isClosed()) {
+            throw new IllegalStateException("Plugin has stopped serving this ring channel");
+        }
+    }
+
+    /**
+     * One RbRing mapped as a memory segment.
+     */
+    private static final class Ring {
+        final MemorySegment data;
+        final MemorySegment head;
+        final MemorySegment tail;
+        final MemorySegment signal;
+        final MemorySegment waiters;
+        final MemorySegment closed;
+        final long capacity;
+
+        Ring(MemorySegment address) {
+            long capacity = address.reinterpret(HEADER_SIZE).get(ValueLayout.JAVA_LONG, CAPACITY);
+            MemorySegment ring = address.reinterpret(HEADER_SIZE + capacity);
+            this.data = ring.asSlice(HEADER_SIZE, capacity);
+            this.head = ring.asSlice(HEAD, Long.BYTES);
+            this.tail = ring.asSlice(TAIL, Long.BYTES);
+            this.signal = ring.asSlice(SIGNAL, Integer.BYTES);
+            this.waiters = ring.asSlice(WAITERS, Integer.BYTES);
+            this.closed = ring.asSlice(CLOSED, Integer.BYTES);
+            this.capacity = capacity;
+        }
+
+        boolean isClosed() {
+            return (int) INT.getAcquire(closed) != 0;
+        }
+
+        boolean tryPush(int messageId, long correlationId, byte[] payload) {
+            long total = frameSize(payload.length);
+            long tailPos = (long) LONG.get(tail);
+            long headPos = (long) LONG.getAcquire(head);
+            long free = capacity - (tailPos - headPos);
+            long pos = tailPos & (capacity - 1);
+            long contiguous = capacity - pos;
+
+            if (contiguous < total) {
+                if (free < contiguous + total) {
+                    return false;
+                }
+                data.set(ValueLayout.JAVA_INT, pos, RING_WRAP);
+                tailPos += contiguous;
+                pos = 0;
+            } else if (free < total) {
+                return false;
+            }
+
+            data.set(ValueLayout.JAVA_INT, pos + FRAME_LEN, payload.length);
+            data.set(ValueLayout.JAVA_INT, pos + FRAME_MESSAGE_ID, messageId);
+            data.set(ValueLayout.JAVA_INT, pos + FRAME_STATUS, 0);
+            data.set(ValueLayout.JAVA_INT, pos + FRAME_STATUS + 4, 0);
+            data.set(ValueLayout.JAVA_LONG, pos + FRAME_CORRELATION_ID, correlationId);
+            MemorySegment.copy(payload, 0, data, ValueLayout.JAVA_BYTE, pos + FRAME_HEADER_SIZE, payload.length);
+
+            LONG.setRelease(tail, tailPos + total);
+            // Full fence between publishing and reading the consumer's waiter count
+            INT.getAndAdd(signal, 1);
+            return true;
+        }
+
+        @Nullable Frame tryPop() {
+            long headPos = (long) LONG.get(head);
+            long tailPos = (long) LONG.getAcquire(tail);
+
+            while (true) {
+                long available = tailPos - headPos;
+                if (available == 0) {
+                    return null;
+                }
+                long pos = headPos & (capacity - 1);
+                int len = data.get(ValueLayout.JAVA_INT, pos + FRAME_LEN);
+                if (len == RING_WRAP) {
+                    headPos += capacity - pos;
+                    LONG.setRelease(head, headPos);
+                    continue;
+                }
+
+                long total = frameSize(Integer.toUnsignedLong(len));
+                if (total > available || total > capacity - pos) {
+                    throw new IllegalStateException("Ring frame of " + Integer.toUnsignedLong(len)
+                            + " bytes overruns published data");
+                }
+
+                Frame frame = new Frame(
+                        data.get(ValueLayout.JAVA_INT, pos + FRAME_MESSAGE_ID),
+                        data.get(ValueLayout.JAVA_INT, pos + FRAME_STATUS),
+                        data.get(ValueLayout.JAVA_LONG, pos + FRAME_CORRELATION_ID),
+                        data.asSlice(pos + FRAME_HEADER_SIZE, len).toArray(ValueLayout.JAVA_BYTE));
+
+                LONG.setRelease(head, headPos + total);
+                return frame;
+            }
+        }
+
+        private static long frameSize(long payloadLen) {
+            return (FRAME_HEADER_SIZE + payloadLen + 7) & ~7L;
+        }
+    }
+}
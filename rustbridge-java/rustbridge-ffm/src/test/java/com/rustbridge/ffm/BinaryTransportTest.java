@@ -146,6 +146,147 @@ class BinaryTransportTest {
         }
     }
 
+    @Test
+    @Order(6)
+    @DisplayName("callRawBatch___SequentialBatch___ReturnsResponsesInOrder")
+    void callRawBatch___SequentialBatch___ReturnsResponsesInOrder() throws PluginException {
+        try (Arena arena = Arena.ofConfined()) {
+            BinaryStruct[] requests = new BinaryStruct[8];
+            int[] messageIds = new int[requests.length];
+            for (int i = 0; i < requests.length; i++) {
+                requests[i] = new SmallRequestRaw(arena, "batch_key_" + i, 0x01);
+                messageIds[i] = MSG_BENCH_SMALL;
+            }
+
+            byte[][] responses = plugin.callRawBatch(messageIds, requests);
+
+            assertEquals(requests.length, responses.length);
+            for (int i = 0; i < responses.length; i++) {
+                SmallResponseRaw response = new SmallResponseRaw(MemorySegment.ofArray(responses[i]));
+                assertTrue(response.getValue().contains("batch_key_" + i),
+                        "Response " + i + " should contain its key, got: " + response.getValue());
+            }
+        }
+    }
+
+    @Test
+    @Order(7)
+    @DisplayName("callRawBatch___ParallelBatch___ReturnsResponsesInOrder")
+    void callRawBatch___ParallelBatch___ReturnsResponsesInOrder() throws PluginException {
+        try (Arena arena = Arena.ofConfined()) {
+            BinaryStruct[] requests = new BinaryStruct[64];
+            int[] messageIds = new int[requests.length];
+            for (int i = 0; i < requests.length; i++) {
+                requests[i] = new SmallRequestRaw(arena, "parallel_key_" + i, 0x01);
+                messageIds[i] = MSG_BENCH_SMALL;
+            }
+
+            byte[][] responses = plugin.callRawBatch(messageIds, requests, true);
+
+            assertEquals(requests.length, responses.length);
+            for (int i = 0; i < responses.length; i++) {
+                SmallResponseRaw response = new SmallResponseRaw(MemorySegment.ofArray(responses[i]));
+                assertTrue(response.getValue().contains("parallel_key_" + i));
+            }
+        }
+    }
+
+    @Test
+    @Order(8)
+    @DisplayName("callRawBatch___UnknownMessageId___ThrowsPluginException")
+    void callRawBatch___UnknownMessageId___ThrowsPluginException() {
+        try (Arena arena = Arena.ofConfined()) {
+            BinaryStruct[] requests = {
+                    new SmallRequestRaw(arena, "ok", 0x01),
+                    new SmallRequestRaw(arena, "bad", 0x01)
+            };
+            int[] messageIds = {MSG_BENCH_SMALL, 0x7FFF};
+
+            PluginException e = assertThrows(PluginException.class,
+                    () -> plugin.callRawBatch(messageIds, requests));
+
+            assertEquals(6, e.getErrorCode());
+        }
+    }
+
+    @Test
+    @Order(9)
+    @DisplayName("callRawInto___SmallBenchmark___WritesResponseIntoSegment")
+    void callRawInto___SmallBenchmark___WritesResponseIntoSegment() throws PluginException {
+        try (Arena arena = Arena.ofConfined()) {
+            SmallRequestRaw request = new SmallRequestRaw(arena, "into_key", 0x01);
+            MemorySegment out = arena.allocate(128);
+
+            long len = plugin.callRawInto(MSG_BENCH_SMALL, request, out);
+            SmallResponseRaw response = new SmallResponseRaw(out.asSlice(0, len));
+
+            assertEquals(SmallResponseRaw.CURRENT_VERSION, response.getVersion());
+            assertTrue(response.getValue().contains("into_key"));
+        }
+    }
+
+    @Test
+    @Order(10)
+    @DisplayName("callRawInto___BufferTooSmall___ThrowsInsufficientCapacity")
+    void callRawInto___BufferTooSmall___ThrowsInsufficientCapacity() {
+        try (Arena arena = Arena.ofConfined()) {
+            SmallRequestRaw request = new SmallRequestRaw(arena, "into_key", 0x01);
+            MemorySegment out = arena.allocate(8);
+
+            PluginException e = assertThrows(PluginException.class,
+                    () -> plugin.callRawInto(MSG_BENCH_SMALL, request, out));
+
+            assertEquals(14, e.getErrorCode());
+        }
+    }
+
+    @Test
+    @Order(11)
+    @DisplayName("ringChannel___SmallBenchmark___AnswersFramesInOrder")
+    void ringChannel___SmallBenchmark___AnswersFramesInOrder() throws PluginException {
+        assertTrue(plugin.hasRingTransport(), "Plugin should support ring transport");
+
+        try (Arena arena = Arena.ofConfined(); RingChannel ring = plugin.openRing(0)) {
+            int count = 100;
+            for (int i = 0; i < count; i++) {
+                byte[] payload = new SmallRequestRaw(arena, "ring_key_" + i, 0x01).segment()
+                        .toArray(ValueLayout.JAVA_BYTE);
+                assertTrue(ring.offer(MSG_BENCH_SMALL, i, payload));
+            }
+
+            for (int i = 0; i < count; i++) {
+                RingChannel.Frame frame;
+                while ((frame = ring.poll()) == null) {
+                    ring.awaitResponses(100);
+                }
+                SmallResponseRaw response = new SmallResponseRaw(MemorySegment.ofArray(frame.payloadOrThrow()));
+
+                assertEquals(i, frame.correlationId());
+                assertEquals(MSG_BENCH_SMALL, frame.messageId());
+                assertTrue(response.getValue().contains("ring_key_" + i));
+            }
+        }
+    }
+
+    @Test
+    @Order(12)
+    @DisplayName("ringChannel___UnknownMessageId___ReturnsErrorFrame")
+    void ringChannel___UnknownMessageId___ReturnsErrorFrame() throws PluginException {
+        try (RingChannel ring = plugin.openRing(0)) {
+            assertTrue(ring.offer(0x7FFF, 42, new byte[]{1, 2, 3}));
+
+            RingChannel.Frame frame;
+            while ((frame = ring.poll()) == null) {
+                ring.awaitResponses(100);
+            }
+
+            assertEquals(42, frame.correlationId());
+            assertEquals(6, frame.status());
+            PluginException e = assertThrows(PluginException.class, frame::payloadOrThrow);
+            assertEquals(6, e.getErrorCode());
+        }
+    }
+
     // ==================== Binary Struct Types ====================
 
     /**
@@ -4,6 +4,7 @@ import com.rustbridge.*;
 import org.junit.jupiter.api.*;
 import org.junit.jupiter.api.condition.DisabledIfSystemProperty;
 
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Path;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -301,4 +302,78 @@ class HelloPluginIntegrationTest {
             System.out.println("Received " + logCount.get() + " log messages");
         }
     }
+
+    @Test
+    @Order(16)
+    @DisplayName("callAs with MessagePack echoes without a JSON envelope")
+    void callAs___msgpack_echo___returns_msgpack_response() throws PluginException {
+        // {"message": "hi"}
+        byte[] request = {(byte) 0x81, (byte) 0xa7, 'm', 'e', 's', 's', 'a', 'g', 'e', (byte) 0xa2, 'h', 'i'};
+        // {"message": "hi", "length": 2}
+        byte[] expected = {
+                (byte) 0x82, (byte) 0xa7, 'm', 'e', 's', 's', 'a', 'g', 'e', (byte) 0xa2, 'h', 'i',
+                (byte) 0xa6, 'l', 'e', 'n', 'g', 't', 'h', 0x02};
+
+        byte[] response = ((FfmPlugin) plugin).callAs("echo", "application/msgpack", request);
+
+        assertArrayEquals(expected, response);
+    }
+
+    @Test
+    @Order(17)
+    @DisplayName("callAs with an unknown content type fails with code 15")
+    void callAs___unknown_content_type___throws_unsupported_content_type() {
+        PluginException e = assertThrows(PluginException.class,
+                () -> ((FfmPlugin) plugin).callAs("echo", "application/cbor", new byte[]{(byte) 0xa0}));
+
+        assertEquals(15, e.getErrorCode());
+    }
+
+    @Test
+    @Order(18)
+    @DisplayName("callStream yields the whole echo response as one chunk")
+    void callStream___echo___yields_response_then_ends() throws PluginException {
+        try (ResponseStream stream = ((FfmPlugin) plugin).callStream("echo", "{\"message\": \"streamed\"}")) {
+            byte[] chunk = stream.nextChunk();
+
+            assertNotNull(chunk);
+            assertTrue(new String(chunk, StandardCharsets.UTF_8).contains("streamed"));
+            assertNull(stream.nextChunk());
+        }
+    }
+
+    @Test
+    @Order(19)
+    @DisplayName("callStream with an unknown type tag fails on open")
+    void callStream___unknown_type_tag___throws_on_open() {
+        PluginException e = assertThrows(PluginException.class,
+                () -> ((FfmPlugin) plugin).callStream("nonexistent.type", "{}"));
+
+        assertEquals(6, e.getErrorCode());
+    }
+
+    @Test
+    @Order(20)
+    @DisplayName("openRequest delivers a payload written in pieces to the echo handler")
+    void openRequest___echo_written_in_pieces___returns_response() throws Exception {
+        try (RequestWriter writer = ((FfmPlugin) plugin).openRequest("echo")) {
+            writer.write("{\"message\": ".getBytes(StandardCharsets.UTF_8));
+            writer.write("\"in pieces\"}".getBytes(StandardCharsets.UTF_8));
+
+            String response = writer.finish();
+
+            assertTrue(response.contains("in pieces"));
+        }
+    }
+
+    @Test
+    @Order(21)
+    @DisplayName("openRequest with an unknown type tag fails on finish")
+    void openRequest___unknown_type_tag___throws_on_finish() throws PluginException {
+        try (RequestWriter writer = ((FfmPlugin) plugin).openRequest("nonexistent.type")) {
+            PluginException e = assertThrows(PluginException.class, writer::finish);
+
+            assertEquals(6, e.getErrorCode());
+        }
+    }
 }
@@ -6,6 +6,10 @@ import com.fasterxml.jackson.databind.ObjectMapper;
 import org.jetbrains.annotations.NotNull;
 import org.jetbrains.annotations.Nullable;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ConcurrentHashMap;
+
 /**
  * JNI-based plugin implementation for Java 17+ compatibility.
  * <p>
@@ -21,6 +25,10 @@ public class JniPlugin implements Plugin {
 
     private final long handle;
     private final LogCallback logCallback;
+
+    /** Type tag to numeric type ID, resolved once per tag; 0 means the tag has no ID. */
+    private final ConcurrentHashMap<String, Integer> typeIds = new ConcurrentHashMap<>();
+
     private volatile boolean closed = false;
 
     /**
@@ -39,11 +47,46 @@ public class JniPlugin implements Plugin {
     private static native String nativeCall(long handle, String typeTag, String request)
             throws PluginException;
 
+    private static native int nativeResolveTypeTag(long handle, String typeTag);
+
+    private static native String nativeCallId(long handle, int typeId, byte[] request)
+            throws PluginException;
+
+    private static native String nativeCallDirect(long handle, String typeTag, ByteBuffer request,
+                                                  int offset, int length) throws PluginException;
+
     private static native byte[] nativeCallRaw(long handle, int messageId, byte[] request)
             throws PluginException;
 
+    private static native byte[] nativeCallRawDirect(long handle, int messageId, ByteBuffer request,
+                                                     int offset, int length) throws PluginException;
+
+    private static native int nativeCallRawInto(long handle, int messageId, byte[] request,
+                                                ByteBuffer out, int outOffset, int outLength)
+            throws PluginException;
+
+    private static native int nativeCallRawDirectInto(long handle, int messageId, ByteBuffer request,
+                                                      int offset, int length, ByteBuffer out,
+                                                      int outOffset, int outLength) throws PluginException;
+
     private static native boolean nativeHasBinaryTransport(long handle);
 
+    private static native byte[][] nativeCallRawBatch(long handle, int[] messageIds, byte[][] requests,
+                                                      boolean parallel) throws PluginException;
+
+    private static native boolean nativeHasBatchTransport(long handle);
+
+    private static native boolean nativeHasStreamedRequests(long handle);
+
+    static native long nativeInputOpen(long handle, String typeTag) throws PluginException;
+
+    static native void nativeInputWrite(long handle, long inputId, ByteBuffer data,
+                                        int offset, int length) throws PluginException;
+
+    static native String nativeInputFinish(long handle, long inputId) throws PluginException;
+
+    static native boolean nativeInputAbort(long handle, long inputId);
+
     private static native void nativeSetLogLevel(long handle, int level);
 
     private static native long nativeGetRejectedCount(long handle);
@@ -63,9 +106,44 @@ public class JniPlugin implements Plugin {
     @Override
     public @NotNull String call(@NotNull String typeTag, @NotNull String request) throws PluginException {
         checkNotClosed();
+        int typeId = resolveTypeId(typeTag);
+        if (typeId != 0) {
+            return nativeCallId(handle, typeId, request.getBytes(StandardCharsets.UTF_8));
+        }
         return nativeCall(handle, typeTag, request);
     }
 
+    /**
+     * Look up the numeric ID the plugin assigned to a type tag, asking the plugin only
+     * the first time a tag is seen.
+     *
+     * @return the type ID, or 0 to send the tag as a string
+     */
+    private int resolveTypeId(String typeTag) {
+        return typeIds.computeIfAbsent(typeTag, tag -> nativeResolveTypeTag(handle, tag));
+    }
+
+    /**
+     * Make a call with the JSON request read in place from a buffer.
+     * <p>
+     * The request is the UTF-8 text between the buffer's position and limit; the
+     * position is left unchanged. A direct buffer is passed to the plugin without
+     * being copied, which avoids the String round trip of {@link #call(String, String)}
+     * for large requests. Heap buffers are decoded and sent through {@code call}.
+     *
+     * @param typeTag the message type tag
+     * @param request the UTF-8 JSON request payload
+     * @return the JSON response payload
+     * @throws PluginException if the call fails
+     */
+    public @NotNull String callDirect(@NotNull String typeTag, @NotNull ByteBuffer request) throws PluginException {
+        checkNotClosed();
+        if (!request.isDirect()) {
+            return call(typeTag, StandardCharsets.UTF_8.decode(request.duplicate()).toString());
+        }
+        return nativeCallDirect(handle, typeTag, request, request.position(), request.remaining());
+    }
+
     // Native methods (implemented in Rust)
 
     @Override
@@ -99,6 +177,10 @@ public class JniPlugin implements Plugin {
      * <p>
      * This method bypasses JSON serialization for high-performance scenarios.
      * The request and response are fixed-size C structs serialized as byte arrays.
+     * <p>
+     * The request array is read in place rather than copied. Some garbage collectors
+     * are held off while the plugin reads it, so prefer {@link #callRawDirect(int, ByteBuffer)}
+     * for handlers that may run long.
      *
      * @param messageId the binary message ID (registered with register_binary_handler)
      * @param request   the request struct as a byte array
@@ -110,6 +192,163 @@ public class JniPlugin implements Plugin {
         return nativeCallRaw(handle, messageId, request);
     }
 
+    /**
+     * Call the plugin with a binary struct request read in place from a buffer.
+     * <p>
+     * The request is the bytes between the buffer's position and limit; the position
+     * is left unchanged. A direct buffer is passed to the plugin without being copied.
+     * Heap buffers are copied and sent through {@link #callRaw(int, byte[])}.
+     *
+     * @param messageId the binary message ID (registered with register_binary_handler)
+     * @param request   the request struct
+     * @return the response struct as a byte array
+     * @throws PluginException if the call fails or binary transport is not supported
+     */
+    public byte @NotNull [] callRawDirect(int messageId, @NotNull ByteBuffer request) throws PluginException {
+        checkNotClosed();
+        if (!request.isDirect()) {
+            byte[] bytes = new byte[request.remaining()];
+            request.duplicate().get(bytes);
+            return nativeCallRaw(handle, messageId, bytes);
+        }
+        return nativeCallRawDirect(handle, messageId, request, request.position(), request.remaining());
+    }
+
+    /**
+     * Call the plugin with a binary struct request, writing the response into {@code out}.
+     * <p>
+     * The response is written at {@code out}'s position, into at most its remaining
+     * bytes, without allocating a response array; neither buffer's position changes.
+     * Reuse the same {@code out} buffer across calls to keep the hot path allocation-free.
+     * The request array is read in place, as with {@link #callRaw(int, byte[])}.
+     *
+     * <pre>{@code
+     * ByteBuffer out = ByteBuffer.allocateDirect(RESPONSE_SIZE);
+     * int len = plugin.callRawInto(MSG_ID, request, out);
+     * }</pre>
+     *
+     * @param messageId the binary message ID (registered with register_binary_handler)
+     * @param request   the request struct as a byte array
+     * @param out       the direct buffer to receive the response
+     * @return the number of bytes written to {@code out}
+     * @throws PluginException if the call fails; error code 14 means {@code out} is too
+     *                         small, and the message then gives the required size
+     * @throws IllegalArgumentException if {@code out} is not a direct buffer
+     */
+    public int callRawInto(int messageId, byte @NotNull [] request, @NotNull ByteBuffer out)
+            throws PluginException {
+        checkNotClosed();
+        checkDirect(out);
+        return nativeCallRawInto(handle, messageId, request, out, out.position(), out.remaining());
+    }
+
+    /**
+     * Call the plugin with a binary struct request read in place from a buffer, writing
+     * the response into {@code out}.
+     * <p>
+     * The request is the bytes between {@code request}'s position and limit; otherwise
+     * this behaves as {@link #callRawInto(int, byte[], ByteBuffer)}. With a direct
+     * request buffer, nothing is copied or allocated on either side of the call.
+     *
+     * @param messageId the binary message ID (registered with register_binary_handler)
+     * @param request   the request struct
+     * @param out       the direct buffer to receive the response
+     * @return the number of bytes written to {@code out}
+     * @throws PluginException if the call fails; error code 14 means {@code out} is too
+     *                         small, and the message then gives the required size
+     * @throws IllegalArgumentException if {@code out} is not a direct buffer
+     */
+    public int callRawInto(int messageId, @NotNull ByteBuffer request, @NotNull ByteBuffer out)
+            throws PluginException {
+        checkNotClosed();
+        checkDirect(out);
+        if (!request.isDirect()) {
+            byte[] bytes = new byte[request.remaining()];
+            request.duplicate().get(bytes);
+            return nativeCallRawInto(handle, messageId, bytes, out, out.position(), out.remaining());
+        }
+        return nativeCallRawDirectInto(handle, messageId, request, request.position(), request.remaining(),
+                out, out.position(), out.remaining());
+    }
+
+    /**
+     * Check if this plugin supports the batched binary entry point.
+     *
+     * @return true if batch transport is available
+     */
+    public boolean hasBatchTransport() {
+        checkNotClosed();
+        return nativeHasBatchTransport(handle);
+    }
+
+    /**
+     * Call the plugin with several binary struct requests in one native call.
+     * <p>
+     * Equivalent to {@code callRawBatch(messageIds, requests, false)}.
+     *
+     * @param messageIds the binary message ID for each request
+     * @param requests   the request structs as byte arrays
+     * @return the response structs as byte arrays, in request order
+     * @throws PluginException if the batch or any message in it fails
+     */
+    public byte @NotNull [] @NotNull [] callRawBatch(int @NotNull [] messageIds, byte @NotNull [] @NotNull [] requests)
+            throws PluginException {
+        return callRawBatch(messageIds, requests, false);
+    }
+
+    /**
+     * Call the plugin with several binary struct requests in one native call.
+     * <p>
+     * Every message is dispatched even if an earlier one fails; the first
+     * failure is then thrown.
+     *
+     * @param messageIds the binary message ID for each request
+     * @param requests   the request structs as byte arrays
+     * @param parallel   dispatch the messages in parallel on the plugin's worker threads
+     * @return the response structs as byte arrays, in request order
+     * @throws PluginException if the batch or any message in it fails
+     */
+    public byte @NotNull [] @NotNull [] callRawBatch(int @NotNull [] messageIds, byte @NotNull [] @NotNull [] requests,
+                                                     boolean parallel) throws PluginException {
+        checkNotClosed();
+        if (messageIds.length != requests.length) {
+            throw new IllegalArgumentException("messageIds and requests must have the same length");
+        }
+        if (requests.length == 0) {
+            return new byte[0][];
+        }
+        return nativeCallRawBatch(handle, messageIds, requests, parallel);
+    }
+
+    /**
+     * Check if this plugin supports streamed requests.
+     *
+     * @return true if {@link #openRequest(String)} is available
+     */
+    public boolean hasStreamedRequests() {
+        checkNotClosed();
+        return nativeHasStreamedRequests(handle);
+    }
+
+    /**
+     * Open a request whose payload is written chunk by chunk.
+     * <p>
+     * The handler starts right away and reads the payload as it arrives; an
+     * admission slot is held until it returns or the writer is closed.
+     *
+     * @param typeTag the message type tag
+     * @return the open writer; finish it to get the response, or close it to discard the request
+     * @throws PluginException if the request cannot be opened
+     * @throws UnsupportedOperationException if the plugin predates streamed requests
+     */
+    public @NotNull RequestWriter openRequest(@NotNull String typeTag) throws PluginException {
+        checkNotClosed();
+        if (!nativeHasStreamedRequests(handle)) {
+            throw new UnsupportedOperationException("Streamed requests not supported by this plugin");
+        }
+        return new JniRequestWriter(handle, nativeInputOpen(handle, typeTag));
+    }
+
     // Native methods (implemented in Rust)
 
     @Override
@@ -138,4 +377,10 @@ public class JniPlugin implements Plugin {
             throw new IllegalStateException("Plugin has been closed");
         }
     }
+
+    private static void checkDirect(ByteBuffer out) {
+        if (!out.isDirect()) {
+            throw new IllegalArgumentException("Output buffer must be a direct ByteBuffer");
+        }
+    }
 }
@@ -0,0 +1,49 @@
+package com.rustbridge.jni;
+
+import com.rustbridge.PluginException;
+import com.rustbridge.RequestWriter;
+import org.jetbrains.annotations.NotNull;
+
+import java.nio.ByteBuffer;
+
+/**
+ * {@link RequestWriter} over the plugin_input_* entry points.
+ * <p>
+ * Writes are staged through one direct buffer owned by the writer, which the
+ * native side reads in place; larger writes are passed on in staging-sized chunks.
+ */
+final class JniRequestWriter extends RequestWriter {
+    /** Bytes handed to plugin_input_write per chunk. */
+    static final int STAGING_SIZE = 64 * 1024;
+
+    private final long handle;
+    private final long inputId;
+    private final ByteBuffer staging = ByteBuffer.allocateDirect(STAGING_SIZE);
+
+    JniRequestWriter(long handle, long inputId) {
+        this.handle = handle;
+        this.inputId = inputId;
+    }
+
+    @Override
+    protected void writeChunk(byte @NotNull [] b, int off, int len) throws PluginException {
+        while (len > 0) {
+            int n = Math.min(len, STAGING_SIZE);
+            staging.clear();
+            staging.put(b, off, n);
+            JniPlugin.nativeInputWrite(handle, inputId, staging, 0, n);
+            off += n;
+            len -= n;
+        }
+    }
+
+    @Override
+    protected @NotNull String finishRequest() throws PluginException {
+        return JniPlugin.nativeInputFinish(handle, inputId);
+    }
+
+    @Override
+    protected void abortRequest() {
+        JniPlugin.nativeInputAbort(handle, inputId);
+    }
+}
@@ -142,6 +142,121 @@ class BinaryTransportTest {
         assertTrue(response.value.contains("my_key"), "Value should contain the key, got: " + response.value);
     }
 
+    @Test
+    @Order(6)
+    @DisplayName("callRawBatch___SequentialBatch___ReturnsResponsesInOrder")
+    void callRawBatch___SequentialBatch___ReturnsResponsesInOrder() throws PluginException {
+        byte[][] requests = new byte[8][];
+        int[] messageIds = new int[requests.length];
+        for (int i = 0; i < requests.length; i++) {
+            requests[i] = SmallRequestRaw.create("batch_key_" + i, 0x01);
+            messageIds[i] = MSG_BENCH_SMALL;
+        }
+
+        byte[][] responses = plugin.callRawBatch(messageIds, requests);
+
+        assertEquals(requests.length, responses.length);
+        for (int i = 0; i < responses.length; i++) {
+            SmallResponseRaw response = SmallResponseRaw.parse(responses[i]);
+            assertTrue(response.value.contains("batch_key_" + i),
+                    "Response " + i + " should contain its key, got: " + response.value);
+        }
+    }
+
+    @Test
+    @Order(7)
+    @DisplayName("callRawBatch___ParallelBatch___ReturnsResponsesInOrder")
+    void callRawBatch___ParallelBatch___ReturnsResponsesInOrder() throws PluginException {
+        byte[][] requests = new byte[64][];
+        int[] messageIds = new int[requests.length];
+        for (int i = 0; i < requests.length; i++) {
+            requests[i] = SmallRequestRaw.create("parallel_key_" + i, 0x01);
+            messageIds[i] = MSG_BENCH_SMALL;
+        }
+
+        byte[][] responses = plugin.callRawBatch(messageIds, requests, true);
+
+        assertEquals(requests.length, responses.length);
+        for (int i = 0; i < responses.length; i++) {
+            SmallResponseRaw response = SmallResponseRaw.parse(responses[i]);
+            assertTrue(response.value.contains("parallel_key_" + i));
+        }
+    }
+
+    @Test
+    @Order(8)
+    @DisplayName("callRawBatch___UnknownMessageId___ThrowsPluginException")
+    void callRawBatch___UnknownMessageId___ThrowsPluginException() {
+        byte[][] requests = {
+                SmallRequestRaw.create("ok", 0x01),
+                SmallRequestRaw.create("bad", 0x01)
+        };
+        int[] messageIds = {MSG_BENCH_SMALL, 0x7FFF};
+
+        PluginException e = assertThrows(PluginException.class,
+                () -> plugin.callRawBatch(messageIds, requests));
+
+        assertEquals(6, e.getErrorCode());
+    }
+
+    @Test
+    @Order(9)
+    @DisplayName("callRawInto___SmallBenchmark___WritesResponseIntoBuffer")
+    void callRawInto___SmallBenchmark___WritesResponseIntoBuffer() throws PluginException {
+        byte[] request = SmallRequestRaw.create("into_key", 0x01);
+        ByteBuffer out = ByteBuffer.allocateDirect(128);
+        out.position(16);
+
+        int len = plugin.callRawInto(MSG_BENCH_SMALL, request, out);
+        byte[] responseBytes = new byte[len];
+        out.duplicate().get(responseBytes);
+        SmallResponseRaw response = SmallResponseRaw.parse(responseBytes);
+
+        assertEquals(16, out.position(), "Position should be unchanged");
+        assertEquals(SmallResponseRaw.CURRENT_VERSION, response.version);
+        assertTrue(response.value.contains("into_key"));
+    }
+
+    @Test
+    @Order(10)
+    @DisplayName("callRawInto___DirectRequest___WritesResponseIntoBuffer")
+    void callRawInto___DirectRequest___WritesResponseIntoBuffer() throws PluginException {
+        byte[] requestBytes = SmallRequestRaw.create("direct_into", 0x01);
+        ByteBuffer request = ByteBuffer.allocateDirect(requestBytes.length);
+        request.put(requestBytes).flip();
+        ByteBuffer out = ByteBuffer.allocateDirect(128);
+
+        int len = plugin.callRawInto(MSG_BENCH_SMALL, request, out);
+        byte[] responseBytes = new byte[len];
+        out.duplicate().get(responseBytes);
+
+        assertEquals(0, request.position(), "Request position should be unchanged");
+        assertTrue(SmallResponseRaw.parse(responseBytes).value.contains("direct_into"));
+    }
+
+    @Test
+    @Order(11)
+    @DisplayName("callRawInto___BufferTooSmall___ThrowsInsufficientCapacity")
+    void callRawInto___BufferTooSmall___ThrowsInsufficientCapacity() {
+        byte[] request = SmallRequestRaw.create("into_key", 0x01);
+        ByteBuffer out = ByteBuffer.allocateDirect(8);
+
+        PluginException e = assertThrows(PluginException.class,
+                () -> plugin.callRawInto(MSG_BENCH_SMALL, request, out));
+
+        assertEquals(14, e.getErrorCode());
+    }
+
+    @Test
+    @Order(12)
+    @DisplayName("callRawInto___HeapOutputBuffer___ThrowsIllegalArgument")
+    void callRawInto___HeapOutputBuffer___ThrowsIllegalArgument() {
+        byte[] request = SmallRequestRaw.create("into_key", 0x01);
+
+        assertThrows(IllegalArgumentException.class,
+                () -> plugin.callRawInto(MSG_BENCH_SMALL, request, ByteBuffer.allocate(128)));
+    }
+
     // ==================== Binary Struct Types (Java 8 compatible) ====================
 
     /**
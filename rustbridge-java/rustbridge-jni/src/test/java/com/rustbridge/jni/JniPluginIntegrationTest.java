@@ -4,6 +4,8 @@ import com.rustbridge.*;
 import com.rustbridge.jni.JniNativeLibraryCondition.RequiresJniLibrary;
 import org.junit.jupiter.api.*;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Path;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -265,4 +267,45 @@ class JniPluginIntegrationTest {
                 "Expected all calls to succeed, but " + errorCount.get() + " failed");
         assertEquals(0, errorCount.get(), "No errors should occur");
     }
+
+    @Test
+    @Order(15)
+    @DisplayName("callDirect reads the request from a direct buffer")
+    void callDirect___direct_buffer___returns_response() throws PluginException {
+        byte[] request = "{\"message\": \"direct\"}".getBytes(StandardCharsets.UTF_8);
+        ByteBuffer buffer = ByteBuffer.allocateDirect(request.length).put(request).flip();
+
+        String response = ((JniPlugin) plugin).callDirect("echo", buffer);
+
+        assertTrue(response.contains("direct"));
+        assertEquals(0, buffer.position(), "Position should be left unchanged");
+    }
+
+    @Test
+    @Order(16)
+    @DisplayName("openRequest delivers a payload written in pieces to the echo handler")
+    void openRequest___echo_written_in_pieces___returns_response() throws Exception {
+        try (RequestWriter writer = ((JniPlugin) plugin).openRequest("echo")) {
+            writer.write("{\"message\": ".getBytes(StandardCharsets.UTF_8));
+            writer.write("\"in pieces\"}".getBytes(StandardCharsets.UTF_8));
+
+            String response = writer.finish();
+
+            assertTrue(response.contains("in pieces"));
+        }
+    }
+
+    @Test
+    @Order(17)
+    @DisplayName("Closing one plugin leaves another loaded from the same library working")
+    void close___second_plugin_loaded___other_plugin_still_answers() throws PluginException {
+        String request = "{\"message\": \"still here\"}";
+        Plugin second = JniPluginLoader.load(PLUGIN_PATH.toString());
+        second.call("echo", request);
+
+        second.close();
+
+        assertTrue(plugin.call("echo", request).contains("still here"));
+        assertThrows(IllegalStateException.class, () -> second.call("echo", request));
+    }
 }
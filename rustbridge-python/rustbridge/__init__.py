@@ -35,6 +35,7 @@ Example:
         response = plugin.call("echo", '{"message": "hello"}')
 """
 
+from rustbridge.core.admission_stats import AdmissionStats
 from rustbridge.core.log_level import LogLevel
 from rustbridge.core.lifecycle_state import LifecycleState
 from rustbridge.core.plugin_exception import PluginException
@@ -46,6 +47,7 @@ from rustbridge.core.minisign_verifier import MinisignVerifier
 from rustbridge.native.structures import FfiBuffer
 from rustbridge.native.native_plugin import NativePlugin
 from rustbridge.native.plugin_loader import NativePluginLoader
+from rustbridge.native.request_writer import RequestWriter
 
 __version__ = "0.7.0"
 
@@ -56,6 +58,7 @@ __all__ = [
     "PluginException",
     "PluginConfig",
     "ResponseEnvelope",
+    "AdmissionStats",
     # Bundle loading
     "BundleManifest",
     "PlatformInfo",
@@ -66,4 +69,5 @@ __all__ = [
     "FfiBuffer",
     "NativePlugin",
     "NativePluginLoader",
+    "RequestWriter",
 ]
@@ -1,5 +1,6 @@
 """Core types for rustbridge Python bindings."""
 
+from rustbridge.core.admission_stats import AdmissionStats
 from rustbridge.core.log_level import LogLevel
 from rustbridge.core.lifecycle_state import LifecycleState
 from rustbridge.core.plugin_exception import PluginException
@@ -10,6 +11,7 @@ from rustbridge.core.bundle_loader import BundleLoader
 from rustbridge.core.minisign_verifier import MinisignVerifier
 
 __all__ = [
+    "AdmissionStats",
     "LogLevel",
     "LifecycleState",
     "PluginException",
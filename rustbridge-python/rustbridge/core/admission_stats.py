@@ -0,0 +1,36 @@
+"""Admission control counters reported by a plugin."""
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+
+# Number of log2 microsecond buckets in the queue wait histogram
+WAIT_HISTOGRAM_BUCKETS = 24
+
+
+@dataclass(frozen=True)
+class AdmissionStats:
+    """
+    Snapshot of a plugin's admission control counters.
+
+    Attributes:
+        limit: Maximum concurrent requests (0 = unlimited).
+        in_flight: Requests currently holding a slot.
+        queue_depth: Requests currently waiting for a slot.
+        admitted: Total requests admitted.
+        queued: Total requests that had to wait before admission.
+        rejected: Total requests rejected (including timeouts).
+        timed_out: Total queued requests whose wait deadline passed.
+        wait_histogram_us: Queue wait histogram. Bucket 0 counts waits under 1us,
+            bucket i counts waits in [2^(i-1), 2^i) us, and the last bucket also
+            absorbs anything longer.
+    """
+
+    limit: int = 0
+    in_flight: int = 0
+    queue_depth: int = 0
+    admitted: int = 0
+    queued: int = 0
+    rejected: int = 0
+    timed_out: int = 0
+    wait_histogram_us: tuple[int, ...] = field(default=(0,) * WAIT_HISTOGRAM_BUCKETS)
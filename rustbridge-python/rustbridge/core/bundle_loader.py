@@ -9,7 +9,7 @@ import stat
 import tempfile
 import zipfile
 from pathlib import Path
-from typing import TYPE_CHECKING, Callable
+from typing import IO, TYPE_CHECKING, Callable
 
 from rustbridge.core.bundle_manifest import BundleManifest, BridgeInfo, BuildInfo, SchemaInfo
 from rustbridge.core.minisign_verifier import MinisignVerifier
@@ -50,6 +50,7 @@ class BundleLoader:
         self,
         verify_signatures: bool = True,
         public_key_override: str | None = None,
+        cache_dir: str | Path | None = None,
     ) -> None:
         """
         Create a new BundleLoader.
@@ -57,9 +58,13 @@ class BundleLoader:
         Args:
             verify_signatures: Whether to verify minisign signatures (default: True).
             public_key_override: Optional public key to use instead of manifest's key.
+            cache_dir: Optional extraction cache shared across processes. When set,
+                load() reuses a library extracted and verified earlier instead of
+                extracting to a new temp directory. See extract_library_cached().
         """
         self._verify_signatures = verify_signatures
         self._public_key_override = public_key_override
+        self._cache_dir = Path(cache_dir) if cache_dir is not None else None
 
     def load(self, bundle_path: str | Path) -> "NativePlugin":
         """
@@ -106,6 +111,10 @@ class BundleLoader:
         if not bundle_path.exists():
             raise FileNotFoundError(f"Bundle not found: {bundle_path}")
 
+        if self._cache_dir is not None:
+            lib_path = self.extract_library_cached(bundle_path, self._cache_dir)
+            return NativePluginLoader.load_with_config(str(lib_path), config, log_callback)
+
         # Extract library to unique temp directory
         temp_dir = tempfile.mkdtemp(prefix="rustbridge-", dir=tempfile.gettempdir())
         try:
@@ -176,6 +185,71 @@ class BundleLoader:
 
         return self._extract_library_internal(bundle_path, dest_dir, fail_if_exists=True)
 
+    def extract_library_cached(
+        self,
+        bundle_path: str | Path,
+        cache_dir: str | Path,
+        variant: str | None = None,
+    ) -> Path:
+        """
+        Extract and verify library from bundle into a shared cache directory.
+
+        Libraries are cached under ``cache_dir/<sha256>/``, keyed by the checksum
+        the manifest records for the variant. A cached library is reused when its
+        size and modification time still match the stamp written next to it, so a
+        warm start verifies the manifest but reads no library bytes. On a miss the
+        library is extracted and verified as usual while holding a file lock on the
+        entry, so concurrent processes extract it only once. The cache layout and
+        stamp format are shared with the Rust ``BundleLoader``.
+
+        The cache trusts its own contents, so ``cache_dir`` must only be writable
+        by the processes that load from it.
+
+        Args:
+            bundle_path: Path to the .rbp bundle file.
+            cache_dir: Root directory of the cache.
+            variant: Variant to extract (defaults to platform's default variant).
+
+        Returns:
+            Path to the cached library file.
+
+        Raises:
+            PluginException: If extraction or verification fails.
+        """
+        bundle_path = Path(bundle_path)
+        if not bundle_path.exists():
+            raise FileNotFoundError(f"Bundle not found: {bundle_path}")
+
+        with zipfile.ZipFile(bundle_path, "r") as zip_file:
+            manifest = self._load_manifest(zip_file)
+            if self._verify_signatures:
+                self._verify_manifest_signature(zip_file, manifest)
+            library_path, checksum = self._resolve_library(manifest, variant)
+
+        digest = checksum[7:] if checksum.lower().startswith("sha256:") else checksum
+        if len(digest) != 64 or any(c not in "0123456789abcdefABCDEF" for c in digest):
+            raise PluginException(f"Invalid checksum for {library_path}: {checksum}")
+
+        entry_dir = Path(cache_dir) / digest
+        library = entry_dir / Path(library_path).name
+        stamp = entry_dir / _CACHE_STAMP_FILE
+        if _cache_hit(library, stamp, digest):
+            return library
+
+        entry_dir.mkdir(parents=True, exist_ok=True)
+        with open(entry_dir / _CACHE_LOCK_FILE, "a+b") as lock:
+            _lock_exclusive(lock)
+
+            # Another process may have filled the entry while we waited
+            if _cache_hit(library, stamp, digest):
+                return library
+            library = self._extract_library_internal(
+                bundle_path, entry_dir, fail_if_exists=False, variant=variant
+            )
+            _write_stamp(library, stamp, digest)
+
+        return library
+
     def _extract_library_internal(
         self,
         bundle_path: Path,
@@ -204,23 +278,7 @@ class BundleLoader:
             if self._verify_signatures:
                 self._verify_manifest_signature(zip_file, manifest)
 
-            # Detect platform
-            current_platform = self.get_current_platform()
-            platform_info = manifest.get_platform(current_platform)
-            if not platform_info:
-                raise PluginException(f"Platform not supported: {current_platform}")
-
-            # Get effective variant
-            effective_variant = variant or platform_info.get_default_variant()
-
-            # Get library path and checksum for the variant
-            library_path = platform_info.get_library(effective_variant)
-            checksum = platform_info.get_checksum(effective_variant)
-
-            if not library_path:
-                raise PluginException(
-                    f"Variant '{effective_variant}' not found for platform '{current_platform}'"
-                )
+            library_path, checksum = self._resolve_library(manifest, variant)
 
             # Read library data
             lib_data = self._read_zip_entry(zip_file, library_path)
@@ -249,14 +307,7 @@ class BundleLoader:
             dest_dir.mkdir(parents=True, exist_ok=True)
 
             # Write the library
-            output_path.write_bytes(lib_data)
-
-            # Make executable on Unix
-            if os.name != "nt":
-                current_mode = output_path.stat().st_mode
-                output_path.chmod(
-                    current_mode | stat.S_IXUSR | stat.S_IXGRP | stat.S_IXOTH
-                )
+            _write_library(output_path, lib_data)
 
             return output_path
 
@@ -493,14 +544,7 @@ class BundleLoader:
             dest_dir.mkdir(parents=True, exist_ok=True)
 
             # Write the library
-            output_path.write_bytes(lib_data)
-
-            # Make executable on Unix
-            if os.name != "nt":
-                current_mode = output_path.stat().st_mode
-                output_path.chmod(
-                    current_mode | stat.S_IXUSR | stat.S_IXGRP | stat.S_IXOTH
-                )
+            _write_library(output_path, lib_data)
 
             return output_path
 
@@ -649,6 +693,29 @@ class BundleLoader:
         manifest_data = self._read_zip_entry(zip_file, "manifest.json")
         return BundleManifest.from_json(manifest_data.decode("utf-8"))
 
+    def _resolve_library(
+        self, manifest: BundleManifest, variant: str | None
+    ) -> tuple[str, str]:
+        """Get the library path and checksum of a variant for the current platform."""
+        current_platform = self.get_current_platform()
+        platform_info = manifest.get_platform(current_platform)
+        if not platform_info:
+            raise PluginException(f"Platform not supported: {current_platform}")
+
+        # Get effective variant
+        effective_variant = variant or platform_info.get_default_variant()
+
+        # Get library path and checksum for the variant
+        library_path = platform_info.get_library(effective_variant)
+        checksum = platform_info.get_checksum(effective_variant)
+
+        if not library_path:
+            raise PluginException(
+                f"Variant '{effective_variant}' not found for platform '{current_platform}'"
+            )
+
+        return library_path, checksum
+
     def _verify_manifest_signature(
         self, zip_file: zipfile.ZipFile, manifest: BundleManifest
     ) -> None:
@@ -729,3 +796,60 @@ class BundleLoader:
             expected = expected[7:]
 
         return actual_hash.lower() == expected.lower()
+
+
+# File next to a cached library that records what was verified
+_CACHE_STAMP_FILE = ".rbcache"
+
+# File locked while a cache entry is being filled
+_CACHE_LOCK_FILE = ".lock"
+
+
+def _write_library(output_path: Path, data: bytes) -> None:
+    """Write a library under a private name, then rename it into place."""
+    partial = output_path.with_name(f".{output_path.name}.{os.getpid()}.partial")
+    try:
+        partial.write_bytes(data)
+
+        # Make executable on Unix
+        if os.name != "nt":
+            current_mode = partial.stat().st_mode
+            partial.chmod(current_mode | stat.S_IXUSR | stat.S_IXGRP | stat.S_IXOTH)
+
+        os.replace(partial, output_path)
+    except BaseException:
+        partial.unlink(missing_ok=True)
+        raise
+
+
+def _stamp_contents(library: Path, digest: str) -> str:
+    """Render the cache stamp for a library: digest, size and mtime."""
+    info = library.stat()
+    return f"sha256:{digest}\n{info.st_size}\n{info.st_mtime_ns}\n"
+
+
+def _cache_hit(library: Path, stamp: Path, digest: str) -> bool:
+    """Check that a cached library is still the one that was verified."""
+    try:
+        return stamp.read_text() == _stamp_contents(library, digest)
+    except OSError:
+        return False
+
+
+def _write_stamp(library: Path, stamp: Path, digest: str) -> None:
+    """Record a freshly verified library, replacing any stale stamp atomically."""
+    partial = stamp.with_name(f"{stamp.name}.{os.getpid()}.partial")
+    partial.write_text(_stamp_contents(library, digest))
+    os.replace(partial, stamp)
+
+
+def _lock_exclusive(file: IO[bytes]) -> None:
+    """Block until this process holds an exclusive lock on an open file."""
+    if os.name == "nt":
+        import msvcrt
+
+        msvcrt.locking(file.fileno(), msvcrt.LK_LOCK, 1)
+    else:
+        import fcntl
+
+        fcntl.flock(file.fileno(), fcntl.LOCK_EX)
@@ -29,6 +29,8 @@ class PluginConfig:
         self._log_level: str = "info"
         self._max_concurrent_ops: int = 1000
         self._shutdown_timeout_ms: int = 5000
+        self._admission: dict[str, Any] = {}
+        self._runtime: dict[str, Any] = {}
 
     @classmethod
     def defaults(cls) -> PluginConfig:
@@ -77,6 +79,121 @@ class PluginConfig:
         self._max_concurrent_ops = max_ops
         return self
 
+    def admission(self, mode: str, max_wait_ms: int = 10) -> PluginConfig:
+        """
+        Set how requests beyond max_concurrent_ops are handled.
+
+        "reject" fails them immediately. The queueing modes ("fifo" and
+        "adaptive_lifo") hold them for up to max_wait_ms before failing with
+        TooManyRequests.
+
+        Args:
+            mode: The admission mode ("reject", "fifo" or "adaptive_lifo").
+            max_wait_ms: Maximum time a request may wait for a slot.
+
+        Returns:
+            This config for chaining.
+        """
+        self._admission["mode"] = mode.lower()
+        self._admission["max_wait_ms"] = max_wait_ms
+        return self
+
+    def admission_max_queue_depth(self, depth: int) -> PluginConfig:
+        """
+        Set the maximum number of requests that may wait for a slot.
+
+        Args:
+            depth: The maximum queue depth.
+
+        Returns:
+            This config for chaining.
+        """
+        self._admission["max_queue_depth"] = depth
+        return self
+
+    def admission_codel(self, target_ms: int, interval_ms: int) -> PluginConfig:
+        """
+        Set the CoDel overload detection parameters used by "adaptive_lifo".
+
+        Args:
+            target_ms: Acceptable queue wait while overloaded.
+            interval_ms: How long the queue must stay non-empty to count as overloaded.
+
+        Returns:
+            This config for chaining.
+        """
+        self._admission["codel_target_ms"] = target_ms
+        self._admission["codel_interval_ms"] = interval_ms
+        return self
+
+    def runtime_flavor(self, flavor: str) -> PluginConfig:
+        """
+        Set the scheduler used by the plugin's Tokio runtime.
+
+        Args:
+            flavor: "multi_thread" (default) or "current_thread".
+
+        Returns:
+            This config for chaining.
+        """
+        self._runtime["flavor"] = flavor.lower()
+        return self
+
+    def shared_runtime(self, shared: bool = True) -> PluginConfig:
+        """
+        Reuse the process-wide runtime instead of building one for this plugin.
+
+        The shared runtime is built by the first plugin that asks for it, so that
+        plugin's thread and affinity settings apply to every plugin sharing it.
+
+        Args:
+            shared: True to share the runtime.
+
+        Returns:
+            This config for chaining.
+        """
+        self._runtime["shared"] = shared
+        return self
+
+    def max_blocking_threads(self, threads: int) -> PluginConfig:
+        """
+        Set the maximum number of threads in the runtime's blocking pool.
+
+        Args:
+            threads: The maximum blocking threads.
+
+        Returns:
+            This config for chaining.
+        """
+        self._runtime["max_blocking_threads"] = threads
+        return self
+
+    def cpu_affinity(self, *cpus: int) -> PluginConfig:
+        """
+        Restrict the runtime's threads to the given CPUs.
+
+        Args:
+            cpus: CPU indices the threads may run on.
+
+        Returns:
+            This config for chaining.
+        """
+        self._runtime["cpu_affinity"] = list(cpus)
+        return self
+
+    def numa_node(self, node: int) -> PluginConfig:
+        """
+        Restrict the runtime's threads to the CPUs of a NUMA node (Linux only).
+
+        Args:
+            node: The NUMA node index.
+
+        Returns:
+            This config for chaining.
+        """
+        self._runtime["numa_node"] = node
+        return self
+
     def shutdown_timeout_ms(self, timeout_ms: int) -> PluginConfig:
         """
         Set the shutdown timeout.
@@ -158,6 +275,12 @@ class PluginConfig:
         if self._worker_threads is not None:
             config["worker_threads"] = self._worker_threads
 
+        if self._admission:
+            config["admission"] = dict(self._admission)
+
+        if self._runtime:
+            config["runtime"] = dict(self._runtime)
+
         return json.dumps(config).encode("utf-8")
 
     def to_dict(self) -> dict[str, Any]:
@@ -180,4 +303,10 @@ class PluginConfig:
         if self._worker_threads is not None:
             config["worker_threads"] = self._worker_threads
 
+        if self._admission:
+            config["admission"] = dict(self._admission)
+
+        if self._runtime:
+            config["runtime"] = dict(self._runtime)
+
         return config
@@ -4,10 +4,12 @@ from rustbridge.native.structures import FfiBuffer
 from rustbridge.native.library import NativeLibrary
 from rustbridge.native.native_plugin import NativePlugin
 from rustbridge.native.plugin_loader import NativePluginLoader
+from rustbridge.native.request_writer import RequestWriter
 
 __all__ = [
     "FfiBuffer",
     "NativeLibrary",
     "NativePlugin",
     "NativePluginLoader",
+    "RequestWriter",
 ]
@@ -0,0 +1,280 @@
+/**
+ * _fastcall.c - Compiled fast path for NativePlugin binary calls
+ *
+ * The ctypes path converts every argument, allocates a Structure for the
+ * response and copies the response into it. This module calls
+ * plugin_call_raw and plugin_call_raw_into through the function pointers
+ * NativeLibrary resolved, so a call costs one C function call:
+ *
+ * - requests are any buffer-protocol object (bytes, bytearray, memoryview,
+ *   ctypes Structure or array) and are read in place;
+ * - plugin_call_raw responses are returned as read-only memoryviews over
+ *   the RbResponse data, freed with rb_response_free once the last view is
+ *   released;
+ * - as with ctypes, the GIL is released while the plugin runs, so threads
+ *   calling the same plugin run in parallel.
+ *
+ * The module is optional. NativePlugin falls back to ctypes when it is not
+ * built; see setup.py.
+ *
+ * Copyright (c) 2024 rustbridge contributors
+ * Licensed under MIT OR Apache-2.0
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "rustbridge_types.h"
+
+typedef RbResponse (*CallRawFn)(RbPluginHandle, uint32_t, const void*, size_t);
+typedef uint32_t (*CallRawIntoFn)(RbPluginHandle, uint32_t, const void*, size_t, void*, size_t,
+                                  size_t*);
+typedef void (*ResponseFreeFn)(RbResponse*);
+
+/* ============================================================================
+ * Caller
+ * ============================================================================ */
+
+/**
+ * Entry points of one plugin instance
+ *
+ * Immutable once created, so any number of threads may use it at once.
+ */
+typedef struct {
+    PyObject_HEAD
+    RbPluginHandle handle;
+    CallRawFn call_raw;
+    CallRawIntoFn call_raw_into;   /* NULL if the library does not export it */
+    ResponseFreeFn response_free;
+    PyObject* owner;               /* Keeps the library loaded */
+    PyObject* error_type;          /* Raised as error_type(message, error_code) */
+} Caller;
+
+/**
+ * A plugin_call_raw response, exported read-only through the buffer protocol
+ */
+typedef struct {
+    PyObject_HEAD
+    RbResponse response;
+    Caller* caller;                /* Owns response_free */
+} Response;
+
+static PyTypeObject ResponseType;
+
+static void raise_plugin_error(Caller* self, const void* message, size_t len, uint32_t code) {
+    PyObject* text = PyUnicode_DecodeUTF8(message, (Py_ssize_t)len, "replace");
+    if (text == NULL) {
+        return;
+    }
+    if (PyUnicode_GET_LENGTH(text) == 0) {
+        Py_DECREF(text);
+        text = PyUnicode_FromString("Unknown error");
+        if (text == NULL) {
+            return;
+        }
+    }
+    PyObject* error = PyObject_CallFunction(self->error_type, "OI", text, (unsigned int)code);
+    Py_DECREF(text);
+    if (error != NULL) {
+        PyErr_SetObject(self->error_type, error);
+        Py_DECREF(error);
+    }
+}
+
+static PyObject* Caller_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {
+        "handle", "call_raw", "response_free", "call_raw_into", "owner", "error_type", NULL,
+    };
+    unsigned long long handle, call_raw, response_free, call_raw_into;
+    PyObject* owner;
+    PyObject* error_type;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "KKKKOO:Caller", keywords, &handle, &call_raw,
+                                     &response_free, &call_raw_into, &owner, &error_type)) {
+        return NULL;
+    }
+    if (call_raw == 0 || response_free == 0) {
+        PyErr_SetString(PyExc_ValueError, "call_raw and response_free are required");
+        return NULL;
+    }
+
+    Caller* self = (Caller*)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->handle = (RbPluginHandle)(uintptr_t)handle;
+    self->call_raw = (CallRawFn)(uintptr_t)call_raw;
+    self->response_free = (ResponseFreeFn)(uintptr_t)response_free;
+    self->call_raw_into = (CallRawIntoFn)(uintptr_t)call_raw_into;
+    Py_INCREF(owner);
+    self->owner = owner;
+    Py_INCREF(error_type);
+    self->error_type = error_type;
+    return (PyObject*)self;
+}
+
+static void Caller_dealloc(Caller* self) {
+    Py_XDECREF(self->owner);
+    Py_XDECREF(self->error_type);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+PyDoc_STRVAR(Caller_call_raw_doc,
+             "call_raw(message_id, request) -> memoryview\n"
+             "\n"
+             "Call plugin_call_raw with the request read in place, returning a read-only\n"
+             "view over the response. The response is freed once every view of it is\n"
+             "released.");
+
+static PyObject* Caller_call_raw(Caller* self, PyObject* args) {
+    unsigned int message_id;
+    Py_buffer request;
+    if (!PyArg_ParseTuple(args, "Iy*:call_raw", &message_id, &request)) {
+        return NULL;
+    }
+
+    RbResponse response;
+    Py_BEGIN_ALLOW_THREADS
+    response = self->call_raw(self->handle, message_id, request.buf, (size_t)request.len);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&request);
+
+    if (response.error_code != 0) {
+        raise_plugin_error(self, response.data, response.len, response.error_code);
+        self->response_free(&response);
+        return NULL;
+    }
+
+    Response* owner = PyObject_New(Response, &ResponseType);
+    if (owner == NULL) {
+        self->response_free(&response);
+        return NULL;
+    }
+    owner->response = response;
+    Py_INCREF(self);
+    owner->caller = self;
+
+    PyObject* view = PyMemoryView_FromObject((PyObject*)owner);
+    Py_DECREF(owner);
+    return view;
+}
+
+PyDoc_STRVAR(Caller_call_raw_into_doc,
+             "call_raw_into(message_id, request, out) -> int\n"
+             "\n"
+             "Call plugin_call_raw_into with the request read in place and the response\n"
+             "written into the writable buffer out. Returns the number of bytes written.");
+
+static PyObject* Caller_call_raw_into(Caller* self, PyObject* args) {
+    unsigned int message_id;
+    Py_buffer request;
+    Py_buffer out;
+    if (self->call_raw_into == NULL) {
+        PyErr_SetString(PyExc_NotImplementedError, "plugin_call_raw_into is not available");
+        return NULL;
+    }
+    if (!PyArg_ParseTuple(args, "Iy*w*:call_raw_into", &message_id, &request, &out)) {
+        return NULL;
+    }
+
+    size_t out_len = 0;
+    uint32_t code;
+    Py_BEGIN_ALLOW_THREADS
+    code = self->call_raw_into(self->handle, message_id, request.buf, (size_t)request.len,
+                               out.buf, (size_t)out.len, &out_len);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&request);
+
+    PyObject* result = NULL;
+    if (code == 0) {
+        result = PyLong_FromSize_t(out_len);
+    } else if (code == RB_ERROR_INSUFFICIENT_CAPACITY) {
+        char message[64];
+        PyOS_snprintf(message, sizeof(message), "Output buffer too small: %zu bytes required",
+                      out_len);
+        raise_plugin_error(self, message, strlen(message), code);
+    } else {
+        size_t len = out_len < (size_t)out.len ? out_len : (size_t)out.len;
+        raise_plugin_error(self, out.buf, len, code);
+    }
+    PyBuffer_Release(&out);
+    return result;
+}
+
+static PyMethodDef Caller_methods[] = {
+    {"call_raw", (PyCFunction)Caller_call_raw, METH_VARARGS, Caller_call_raw_doc},
+    {"call_raw_into", (PyCFunction)Caller_call_raw_into, METH_VARARGS, Caller_call_raw_into_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyTypeObject CallerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "rustbridge.native._fastcall.Caller",
+    .tp_doc = PyDoc_STR("Caller(handle, call_raw, response_free, call_raw_into, owner, "
+                        "error_type)\n\nBinary entry points of one plugin instance, "
+                        "given as function addresses."),
+    .tp_basicsize = sizeof(Caller),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = Caller_new,
+    .tp_dealloc = (destructor)Caller_dealloc,
+    .tp_methods = Caller_methods,
+};
+
+/* ============================================================================
+ * Response
+ * ============================================================================ */
+
+static int Response_getbuffer(Response* self, Py_buffer* view, int flags) {
+    /* Empty responses may carry a null pointer; views need a valid address */
+    static char empty[1];
+    void* data = self->response.len > 0 ? self->response.data : empty;
+    return PyBuffer_FillInfo(view, (PyObject*)self, data, (Py_ssize_t)self->response.len, 1,
+                             flags);
+}
+
+static void Response_dealloc(Response* self) {
+    self->caller->response_free(&self->response);
+    Py_DECREF(self->caller);
+    PyObject_Free(self);
+}
+
+static PyBufferProcs Response_as_buffer = {
+    .bf_getbuffer = (getbufferproc)Response_getbuffer,
+};
+
+static PyTypeObject ResponseType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "rustbridge.native._fastcall.Response",
+    .tp_doc = PyDoc_STR("Response data owned by the plugin"),
+    .tp_basicsize = sizeof(Response),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)Response_dealloc,
+    .tp_as_buffer = &Response_as_buffer,
+};
+
+/* ============================================================================
+ * Module
+ * ============================================================================ */
+
+static struct PyModuleDef fastcall_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "rustbridge.native._fastcall",
+    .m_doc = PyDoc_STR("Compiled fast path for NativePlugin binary calls."),
+    .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit__fastcall(void) {
+    if (PyType_Ready(&CallerType) < 0 || PyType_Ready(&ResponseType) < 0) {
+        return NULL;
+    }
+    PyObject* module = PyModule_Create(&fastcall_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&CallerType);
+    if (PyModule_AddObject(module, "Caller", (PyObject*)&CallerType) < 0) {
+        Py_DECREF(&CallerType);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
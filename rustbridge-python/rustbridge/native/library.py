@@ -7,7 +7,13 @@ from ctypes import c_bool, c_char_p, c_size_t, c_uint8, c_uint32, c_uint64, c_vo
 from pathlib import Path
 
 from rustbridge.core.plugin_exception import PluginException
-from rustbridge.native.structures import FfiBuffer, RbResponse, LogCallbackFnType
+from rustbridge.native.structures import (
+    FfiBuffer,
+    LogCallbackFnType,
+    RbAdmissionStats,
+    RbBatchRequest,
+    RbResponse,
+)
 
 
 class NativeLibrary:
@@ -79,6 +85,86 @@ class NativeLibrary:
         self._lib.plugin_get_rejected_count.argtypes = [c_void_p]
         self._lib.plugin_get_rejected_count.restype = c_uint64
 
+        # Optional: content-type negotiated calls
+        try:
+            # plugin_call_as(handle, type_tag, content_type, request, request_len) -> FfiBuffer
+            self._lib.plugin_call_as.argtypes = [
+                c_void_p,  # handle
+                c_char_p,  # type_tag (null-terminated)
+                c_char_p,  # content_type (null-terminated, null means JSON)
+                POINTER(c_uint8),  # request
+                c_size_t,  # request_len
+            ]
+            self._lib.plugin_call_as.restype = FfiBuffer
+            self._has_call_as = True
+        except AttributeError:
+            self._has_call_as = False
+
+        # Optional: streamed responses
+        try:
+            # plugin_stream_open(handle, type_tag, request, request_len, stream_id) -> FfiBuffer
+            self._lib.plugin_stream_open.argtypes = [
+                c_void_p,  # handle
+                c_char_p,  # type_tag (null-terminated)
+                POINTER(c_uint8),  # request
+                c_size_t,  # request_len
+                POINTER(c_uint64),  # stream_id (out)
+            ]
+            self._lib.plugin_stream_open.restype = FfiBuffer
+
+            # plugin_stream_next(handle, stream_id) -> FfiBuffer
+            self._lib.plugin_stream_next.argtypes = [c_void_p, c_uint64]
+            self._lib.plugin_stream_next.restype = FfiBuffer
+
+            # plugin_stream_close(handle, stream_id) -> bool
+            self._lib.plugin_stream_close.argtypes = [c_void_p, c_uint64]
+            self._lib.plugin_stream_close.restype = c_bool
+            self._has_streaming = True
+        except AttributeError:
+            self._has_streaming = False
+
+        # Optional: streamed requests
+        try:
+            # plugin_input_open(handle, type_tag, input_id) -> FfiBuffer
+            self._lib.plugin_input_open.argtypes = [
+                c_void_p,  # handle
+                c_char_p,  # type_tag (null-terminated)
+                POINTER(c_uint64),  # input_id (out)
+            ]
+            self._lib.plugin_input_open.restype = FfiBuffer
+
+            # plugin_input_write(handle, input_id, data, len) -> u32
+            self._lib.plugin_input_write.argtypes = [
+                c_void_p,  # handle
+                c_uint64,  # input_id
+                c_char_p,  # data
+                c_size_t,  # len
+            ]
+            self._lib.plugin_input_write.restype = c_uint32
+
+            # plugin_input_finish(handle, input_id) -> FfiBuffer
+            self._lib.plugin_input_finish.argtypes = [c_void_p, c_uint64]
+            self._lib.plugin_input_finish.restype = FfiBuffer
+
+            # plugin_input_abort(handle, input_id) -> bool
+            self._lib.plugin_input_abort.argtypes = [c_void_p, c_uint64]
+            self._lib.plugin_input_abort.restype = c_bool
+            self._has_streamed_requests = True
+        except AttributeError:
+            self._has_streamed_requests = False
+
+        # Optional: admission stats
+        try:
+            # plugin_get_admission_stats(handle, out) -> bool
+            self._lib.plugin_get_admission_stats.argtypes = [
+                c_void_p,  # handle
+                POINTER(RbAdmissionStats),  # out
+            ]
+            self._lib.plugin_get_admission_stats.restype = c_bool
+            self._has_admission_stats = True
+        except AttributeError:
+            self._has_admission_stats = False
+
         # Optional: binary transport functions
         try:
             # plugin_call_raw(handle, message_id, request, request_size) -> RbResponse
@@ -97,6 +183,39 @@ class NativeLibrary:
         except AttributeError:
             self._has_binary_transport = False
 
+        # Optional: caller-buffer binary transport
+        try:
+            # plugin_call_raw_into(handle, message_id, request, request_size,
+            #                      out, out_capacity, out_len) -> u32
+            self._lib.plugin_call_raw_into.argtypes = [
+                c_void_p,  # handle
+                c_uint32,  # message_id
+                c_void_p,  # request
+                c_size_t,  # request_size
+                c_void_p,  # out
+                c_size_t,  # out_capacity
+                POINTER(c_size_t),  # out_len
+            ]
+            self._lib.plugin_call_raw_into.restype = c_uint32
+            self._has_call_raw_into = True
+        except AttributeError:
+            self._has_call_raw_into = False
+
+        # Optional: batched binary transport
+        try:
+            # plugin_call_raw_batch(handle, requests, count, responses, flags) -> u32
+            self._lib.plugin_call_raw_batch.argtypes = [
+                c_void_p,  # handle
+                POINTER(RbBatchRequest),  # requests
+                c_size_t,  # count
+                POINTER(RbResponse),  # responses
+                c_uint32,  # flags
+            ]
+            self._lib.plugin_call_raw_batch.restype = c_uint32
+            self._has_batch_transport = self._has_binary_transport
+        except AttributeError:
+            self._has_batch_transport = False
+
     @property
     def path(self) -> str:
         """Return the library path."""
@@ -107,6 +226,46 @@ class NativeLibrary:
         """Check if this library supports binary transport."""
         return self._has_binary_transport
 
+    @property
+    def has_batch_transport(self) -> bool:
+        """Check if this library supports batched binary transport."""
+        return self._has_batch_transport
+
+    @property
+    def has_call_raw_into(self) -> bool:
+        """Check if this library supports caller-buffer binary transport."""
+        return self._has_call_raw_into
+
+    @property
+    def has_call_as(self) -> bool:
+        """Check if this library supports content-type negotiated calls."""
+        return self._has_call_as
+
+    @property
+    def has_streaming(self) -> bool:
+        """Check if this library supports streamed responses."""
+        return self._has_streaming
+
+    @property
+    def has_streamed_requests(self) -> bool:
+        """Check if this library supports streamed requests."""
+        return self._has_streamed_requests
+
+    def symbol_address(self, name: str) -> int:
+        """
+        Get the address of an exported function, for the compiled fast path.
+
+        Args:
+            name: Symbol name, e.g. ``plugin_call_raw``.
+
+        Returns:
+            The function address, or 0 if the library does not export it.
+        """
+        try:
+            return ctypes.cast(getattr(self._lib, name), c_void_p).value or 0
+        except AttributeError:
+            return 0
+
     def plugin_create(self) -> c_void_p:
         """Create a new plugin instance."""
         return self._lib.plugin_create()
@@ -163,6 +322,123 @@ class NativeLibrary:
             handle, type_tag_bytes, request_ptr, len(request)
         )
 
+    def plugin_call_as(
+        self, handle: c_void_p, type_tag: str, content_type: str, request: bytes
+    ) -> FfiBuffer:
+        """
+        Make a call with the payload encoded in the given content type.
+
+        Args:
+            handle: Plugin handle from plugin_init.
+            type_tag: Message type identifier.
+            content_type: Payload MIME type (e.g., "application/msgpack").
+            request: Encoded request payload bytes.
+
+        Returns:
+            FfiBuffer containing the un-enveloped response payload.
+
+        Raises:
+            PluginException: If the library does not export plugin_call_as.
+        """
+        if not self._has_call_as:
+            raise PluginException("Content-type negotiation not supported by this library")
+
+        request_array = (c_uint8 * len(request)).from_buffer_copy(request)
+        request_ptr = ctypes.cast(request_array, POINTER(c_uint8))
+
+        return self._lib.plugin_call_as(
+            handle,
+            type_tag.encode("utf-8"),
+            content_type.encode("utf-8"),
+            request_ptr,
+            len(request),
+        )
+
+    def plugin_stream_open(
+        self, handle: c_void_p, type_tag: str, request: bytes
+    ) -> tuple[FfiBuffer, int]:
+        """
+        Open a streamed response for a request.
+
+        Args:
+            handle: Plugin handle from plugin_init.
+            type_tag: Message type identifier.
+            request: Request payload bytes.
+
+        Returns:
+            The open result (empty on success, an error envelope otherwise)
+            and the stream ID.
+
+        Raises:
+            PluginException: If the library does not export streamed responses.
+        """
+        if not self._has_streaming:
+            raise PluginException("Streamed responses not supported by this library")
+
+        request_array = (c_uint8 * len(request)).from_buffer_copy(request)
+        request_ptr = ctypes.cast(request_array, POINTER(c_uint8))
+        stream_id = c_uint64(0)
+
+        buffer = self._lib.plugin_stream_open(
+            handle,
+            type_tag.encode("utf-8"),
+            request_ptr,
+            len(request),
+            ctypes.byref(stream_id),
+        )
+        return buffer, stream_id.value
+
+    def plugin_stream_next(self, handle: c_void_p, stream_id: int) -> FfiBuffer:
+        """Block until the next frame of a streamed response is ready."""
+        return self._lib.plugin_stream_next(handle, stream_id)
+
+    def plugin_stream_close(self, handle: c_void_p, stream_id: int) -> bool:
+        """Stop a streamed response before it is complete."""
+        return self._lib.plugin_stream_close(handle, stream_id)
+
+    def plugin_input_open(self, handle: c_void_p, type_tag: str) -> tuple[FfiBuffer, int]:
+        """
+        Open a streamed request, written chunk by chunk.
+
+        Args:
+            handle: Plugin handle from plugin_init.
+            type_tag: Message type identifier.
+
+        Returns:
+            The open result (empty on success, an error envelope otherwise)
+            and the input ID.
+
+        Raises:
+            PluginException: If the library does not export streamed requests.
+        """
+        if not self._has_streamed_requests:
+            raise PluginException("Streamed requests not supported by this library")
+
+        input_id = c_uint64(0)
+        buffer = self._lib.plugin_input_open(
+            handle, type_tag.encode("utf-8"), ctypes.byref(input_id)
+        )
+        return buffer, input_id.value
+
+    def plugin_input_write(self, handle: c_void_p, input_id: int, data: bytes) -> int:
+        """
+        Append a chunk to a streamed request, blocking while the handler is behind.
+
+        The bytes object is passed to the plugin in place and copied there.
+
+        Returns:
+            0 on success, otherwise an error code.
+        """
+        return self._lib.plugin_input_write(handle, input_id, data, len(data))
+
+    def plugin_input_finish(self, handle: c_void_p, input_id: int) -> FfiBuffer:
+        """End a streamed request and wait for the response envelope."""
+        return self._lib.plugin_input_finish(handle, input_id)
+
+    def plugin_input_abort(self, handle: c_void_p, input_id: int) -> bool:
+        """Discard a streamed request before it is finished."""
+        return self._lib.plugin_input_abort(handle, input_id)
+
     def plugin_free_buffer(self, buffer: FfiBuffer) -> None:
         """Free a buffer returned by plugin_call."""
         self._lib.plugin_free_buffer(ctypes.byref(buffer))
@@ -183,6 +459,22 @@ class NativeLibrary:
         """Get the number of rejected requests."""
         return self._lib.plugin_get_rejected_count(handle)
 
+    def plugin_get_admission_stats(self, handle: c_void_p) -> RbAdmissionStats:
+        """
+        Get the admission control counters for a plugin.
+
+        Raises:
+            PluginException: If the library does not export admission stats or
+                the handle is invalid.
+        """
+        if not self._has_admission_stats:
+            raise PluginException("Admission stats not supported by this library")
+
+        stats = RbAdmissionStats()
+        if not self._lib.plugin_get_admission_stats(handle, ctypes.byref(stats)):
+            raise PluginException("Invalid plugin handle")
+        return stats
+
     def plugin_call_raw(
         self, handle: c_void_p, message_id: int, request_ptr: c_void_p, request_size: int
     ) -> RbResponse:
@@ -206,6 +498,75 @@ class NativeLibrary:
 
         return self._lib.plugin_call_raw(handle, message_id, request_ptr, request_size)
 
+    def plugin_call_raw_batch(
+        self,
+        handle: c_void_p,
+        requests: ctypes.Array[RbBatchRequest],
+        responses: ctypes.Array[RbResponse],
+        flags: int,
+    ) -> int:
+        """
+        Make several binary calls to the plugin in one FFI crossing.
+
+        Args:
+            handle: Plugin handle from plugin_init.
+            requests: Array of request descriptors.
+            responses: Array with one slot per request, filled on success.
+            flags: Bitwise OR of batch flags (RB_BATCH_PARALLEL).
+
+        Returns:
+            0 if the batch was dispatched (every response must then be freed),
+            otherwise an error code.
+
+        Raises:
+            PluginException: If batch transport is not supported.
+        """
+        if not self._has_batch_transport:
+            raise PluginException("Batch binary transport not supported by this library")
+
+        return self._lib.plugin_call_raw_batch(handle, requests, len(requests), responses, flags)
+
+    def plugin_call_raw_into(
+        self,
+        handle: c_void_p,
+        message_id: int,
+        request_ptr: c_void_p,
+        request_size: int,
+        out_ptr: c_void_p,
+        out_capacity: int,
+        out_len: c_size_t,
+    ) -> int:
+        """
+        Make a binary call that writes the response into a caller buffer.
+
+        Args:
+            handle: Plugin handle from plugin_init.
+            message_id: Numeric message identifier.
+            request_ptr: Pointer to the request struct.
+            request_size: Size of the request struct in bytes.
+            out_ptr: Pointer to the output buffer.
+            out_capacity: Size of the output buffer in bytes.
+            out_len: Receives the bytes written (or required, on insufficient capacity).
+
+        Returns:
+            0 on success, otherwise an error code.
+
+        Raises:
+            PluginException: If caller-buffer transport is not supported.
+        """
+        if not self._has_call_raw_into:
+            raise PluginException("Caller-buffer binary transport not supported by this library")
+
+        return self._lib.plugin_call_raw_into(
+            handle,
+            message_id,
+            request_ptr,
+            request_size,
+            out_ptr,
+            out_capacity,
+            ctypes.byref(out_len),
+        )
+
     def rb_response_free(self, response: RbResponse) -> None:
         """Free a binary response."""
         if self._has_binary_transport:
@@ -4,24 +4,42 @@ from __future__ import annotations
 
 import ctypes
 import json
-from ctypes import Structure, addressof, c_void_p, memmove, sizeof
-from typing import Any, Callable, TypeVar
+from ctypes import Array, Structure, addressof, c_size_t, c_void_p, memmove, sizeof
+from typing import Any, Callable, Iterator, TypeVar
 
+from rustbridge.core.admission_stats import AdmissionStats
 from rustbridge.core.lifecycle_state import LifecycleState
 from rustbridge.core.log_level import LogLevel
 from rustbridge.core.plugin_exception import PluginException
 from rustbridge.core.response_envelope import ResponseEnvelope
 from rustbridge.native.library import NativeLibrary
-from rustbridge.native.structures import LogCallbackFnType
+from rustbridge.native.request_writer import RequestWriter
+from rustbridge.native.structures import (
+    RB_BATCH_PARALLEL,
+    LogCallbackFnType,
+    RbBatchRequest,
+    RbResponse,
+)
+
+try:
+    from rustbridge.native import _fastcall
+except ImportError:  # The optional extension was not built; use ctypes only
+    _fastcall = None
 
 T = TypeVar("T")
 R = TypeVar("R")
 TRequest = TypeVar("TRequest", bound=Structure)
 TResponse = TypeVar("TResponse", bound=Structure)
 
+# Error code returned by plugin_call_raw_into when the output buffer is too small
+_ERROR_INSUFFICIENT_CAPACITY = 14
+
 # Type alias for log callback
 LogCallbackFn = Callable[[LogLevel, str, str], None]
 
+# Objects supporting the buffer protocol (bytes, bytearray, memoryview, ctypes objects)
+Buffer = Any
+
 
 class NativePlugin:
     """
@@ -61,6 +79,30 @@ class NativePlugin:
         self._log_callback = log_callback
         self._callback_ref = _callback_ref
         self._disposed = False
+        self._fast = self._create_fast_caller()
+
+    def _create_fast_caller(self) -> Any:
+        """Bind the compiled fast path to this plugin, if it was built."""
+        if _fastcall is None or not self._library.has_binary_transport:
+            return None
+        return _fastcall.Caller(
+            getattr(self._handle, "value", self._handle) or 0,
+            self._library.symbol_address("plugin_call_raw"),
+            self._library.symbol_address("rb_response_free"),
+            self._library.symbol_address("plugin_call_raw_into"),
+            self._library,
+            PluginException,
+        )
+
+    @property
+    def has_fast_path(self) -> bool:
+        """
+        Check if binary calls use the compiled extension instead of ctypes.
+
+        Returns:
+            True if the ``rustbridge.native._fastcall`` extension is in use.
+        """
+        return self._fast is not None
 
     @property
     def state(self) -> LifecycleState:
@@ -92,6 +134,30 @@ class NativePlugin:
         self._throw_if_disposed()
         return self._library.plugin_get_rejected_count(self._handle)
 
+    @property
+    def admission_stats(self) -> AdmissionStats:
+        """
+        Get a snapshot of the plugin's admission control counters.
+
+        Returns:
+            Queue depth, admission and rejection totals, and the queue wait histogram.
+
+        Raises:
+            PluginException: If the plugin does not export admission stats.
+        """
+        self._throw_if_disposed()
+        raw = self._library.plugin_get_admission_stats(self._handle)
+        return AdmissionStats(
+            limit=raw.limit,
+            in_flight=raw.in_flight,
+            queue_depth=raw.queue_depth,
+            admitted=raw.admitted,
+            queued=raw.queued,
+            rejected=raw.rejected,
+            timed_out=raw.timed_out,
+            wait_histogram_us=tuple(raw.wait_histogram_us),
+        )
+
     def call(self, type_tag: str, request: str) -> str:
         """
         Make a call to the plugin with JSON request/response.
@@ -116,6 +182,136 @@ class NativePlugin:
         finally:
             self._library.plugin_free_buffer(buffer)
 
+    def call_as(self, type_tag: str, content_type: str, request: bytes) -> bytes:
+        """
+        Make a call with the payload encoded in the given content type.
+
+        The request and response bytes are passed through without a JSON
+        envelope, so binary formats never round-trip through JSON.
+
+        Args:
+            type_tag: Message type identifier.
+            content_type: Payload MIME type (e.g., "application/msgpack").
+            request: Encoded request payload.
+
+        Returns:
+            Encoded response payload.
+
+        Raises:
+            PluginException: If the call fails, the content type is unsupported
+                (code 15), or the plugin does not export plugin_call_as.
+        """
+        self._throw_if_disposed()
+
+        buffer = self._library.plugin_call_as(
+            self._handle, type_tag, content_type, request
+        )
+
+        try:
+            if buffer.is_error():
+                error_message = "Unknown error"
+                if not buffer.is_empty():
+                    error_message = buffer.get_string()
+                raise PluginException(error_message, buffer.error_code)
+            return buffer.get_bytes()
+        finally:
+            self._library.plugin_free_buffer(buffer)
+
+    def call_stream(self, type_tag: str, request: str) -> Iterator[bytes]:
+        """
+        Make a call whose response is pulled chunk by chunk.
+
+        The plugin produces only a few chunks ahead of the reader, and
+        concatenated they form the payload ``call`` would have returned.
+        Errors the handler reports before its first chunk are raised here;
+        later errors are raised while iterating. Closing the iterator early
+        stops the stream.
+
+        Args:
+            type_tag: Message type identifier.
+            request: JSON request payload.
+
+        Returns:
+            Iterator over the response chunks.
+
+        Raises:
+            PluginException: If the call fails before streaming starts or the
+                plugin does not export streamed responses.
+        """
+        self._throw_if_disposed()
+
+        buffer, stream_id = self._library.plugin_stream_open(
+            self._handle, type_tag, request.encode("utf-8")
+        )
+        self._read_stream_frame(buffer)
+        return self._iter_stream(stream_id)
+
+    def _iter_stream(self, stream_id: int) -> Iterator[bytes]:
+        """Yield chunks until the end frame, closing the stream if abandoned."""
+        finished = False
+        try:
+            while True:
+                try:
+                    chunk = self._read_stream_frame(
+                        self._library.plugin_stream_next(self._handle, stream_id)
+                    )
+                except PluginException:
+                    finished = True
+                    raise
+                if not chunk:
+                    finished = True
+                    return
+                yield chunk
+        finally:
+            if not finished and not self._disposed:
+                self._library.plugin_stream_close(self._handle, stream_id)
+
+    def _read_stream_frame(self, buffer: Any) -> bytes:
+        """Copy a stream frame out and free it, raising if it carries an error."""
+        try:
+            data = buffer.get_bytes()
+            error_code = buffer.error_code
+        finally:
+            self._library.plugin_free_buffer(buffer)
+
+        if error_code == 0:
+            return data
+
+        # Error frames hold an error envelope, or plain text if the handle itself was bad
+        text = data.decode("utf-8", errors="replace")
+        if text.startswith("{"):
+            try:
+                envelope = ResponseEnvelope.from_json(text)
+            except PluginException:
+                envelope = None
+            if envelope is not None and not envelope.is_success:
+                raise envelope.to_exception()
+        raise PluginException(text or "Unknown error", error_code)
+
+    def open_request(self, type_tag: str) -> RequestWriter:
+        """
+        Open a request whose payload is written chunk by chunk.
+
+        The handler starts right away and reads the payload as it arrives; an
+        admission slot is held until it returns or the writer is closed.
+
+        Args:
+            type_tag: Message type identifier.
+
+        Returns:
+            The open writer; finish it to get the response, or close it to
+            discard the request.
+
+        Raises:
+            PluginException: If the request cannot be opened or the plugin
+                does not export streamed requests.
+        """
+        self._throw_if_disposed()
+
+        buffer, input_id = self._library.plugin_input_open(self._handle, type_tag)
+        self._read_stream_frame(buffer)
+        return RequestWriter(self, input_id)
+
     def call_typed(
         self, type_tag: str, request: Any, response_type: type[T] | None = None
     ) -> T | Any:
@@ -196,6 +392,15 @@ class NativePlugin:
         if not self._library.has_binary_transport:
             raise PluginException("Binary transport not supported by this library")
 
+        expected_size = sizeof(response_type)
+        if self._fast is not None:
+            with self._fast.call_raw(message_id, request) as view:
+                if view.nbytes != expected_size:
+                    raise PluginException(
+                        f"Response size mismatch: expected {expected_size}, got {view.nbytes}"
+                    )
+                return response_type.from_buffer_copy(view)
+
         # Get pointer to request struct directly (avoids copy)
         request_ptr = c_void_p(addressof(request))
         request_size = sizeof(request)
@@ -212,7 +417,6 @@ class NativePlugin:
                 raise PluginException(error_message, rb_response.error_code)
 
             # Validate response size
-            expected_size = sizeof(response_type)
             if rb_response.len != expected_size:
                 raise PluginException(
                     f"Response size mismatch: expected {expected_size}, got {rb_response.len}"
@@ -227,6 +431,190 @@ class NativePlugin:
             # Free the response
             self._library.rb_response_free(rb_response)
 
+    def call_raw_into(
+        self,
+        message_id: int,
+        request: Structure,
+        out: Structure | Array[Any],
+    ) -> int:
+        """
+        Make a binary call that writes the response directly into ``out``.
+
+        No native allocation is made for the response and no free call is needed,
+        so reusing the same ``out`` buffer keeps the hot path allocation-free.
+
+        Args:
+            message_id: Numeric message identifier.
+            request: The request struct.
+            out: A ctypes Structure or array that receives the response bytes.
+
+        Returns:
+            The number of bytes written to ``out``.
+
+        Raises:
+            PluginException: If the call fails. Error code 14 means ``out`` is too
+                small; the message then gives the required size.
+
+        Example:
+            ```python
+            response = SmallResponse()
+            plugin.call_raw_into(1, SmallRequest(...), response)
+            ```
+        """
+        self._throw_if_disposed()
+
+        if not self._library.has_call_raw_into:
+            raise PluginException("Caller-buffer binary transport not supported by this library")
+
+        if self._fast is not None:
+            return self._fast.call_raw_into(message_id, request, out)
+
+        out_len = c_size_t(0)
+        result = self._library.plugin_call_raw_into(
+            self._handle,
+            message_id,
+            c_void_p(addressof(request)),
+            sizeof(request),
+            c_void_p(addressof(out)),
+            sizeof(out),
+            out_len,
+        )
+
+        if result == 0:
+            return out_len.value
+        if result == _ERROR_INSUFFICIENT_CAPACITY:
+            raise PluginException(
+                f"Output buffer too small: {out_len.value} bytes required", result
+            )
+        message = ctypes.string_at(addressof(out), out_len.value).decode("utf-8", errors="replace")
+        raise PluginException(message or "Unknown error", result)
+
+    def call_raw_buffer(self, message_id: int, request: Buffer) -> memoryview:
+        """
+        Make a binary call with any buffer as the request, returning a view of the response.
+
+        With the compiled extension (see ``has_fast_path``) the request is read in
+        place and the returned read-only memoryview points straight at the plugin's
+        response, which is freed once the view is released. Without it the request and
+        response are copied through ctypes.
+
+        Args:
+            message_id: Numeric message identifier.
+            request: The request bytes: bytes, bytearray, memoryview, a ctypes
+                Structure or array, or any other contiguous buffer.
+
+        Returns:
+            A read-only memoryview of the response bytes.
+
+        Raises:
+            PluginException: If the call fails or binary transport is not supported.
+
+        Example:
+            ```python
+            with plugin.call_raw_buffer(1, bytes(request)) as view:
+                response = SmallResponse.from_buffer_copy(view)
+            ```
+        """
+        self._throw_if_disposed()
+
+        if not self._library.has_binary_transport:
+            raise PluginException("Binary transport not supported by this library")
+
+        if self._fast is not None:
+            return self._fast.call_raw(message_id, request)
+
+        request_bytes = (ctypes.c_char * memoryview(request).nbytes).from_buffer_copy(request)
+        rb_response = self._library.plugin_call_raw(
+            self._handle, message_id, c_void_p(addressof(request_bytes)), sizeof(request_bytes)
+        )
+        try:
+            if rb_response.is_error():
+                error_message = rb_response.get_error_message() or "Unknown error"
+                raise PluginException(error_message, rb_response.error_code)
+            return memoryview(ctypes.string_at(rb_response.data, rb_response.len))
+        finally:
+            self._library.rb_response_free(rb_response)
+
+    def call_raw_batch(
+        self,
+        message_ids: list[int],
+        requests: list[Structure],
+        response_type: type[TResponse],
+        parallel: bool = False,
+    ) -> list[TResponse]:
+        """
+        Make several binary calls to the plugin in one FFI crossing.
+
+        Every message is dispatched even if an earlier one fails; the first
+        failure is then raised after all responses have been freed.
+
+        Args:
+            message_ids: Numeric message identifier for each request.
+            requests: The request structs.
+            response_type: The ctypes Structure type for every response.
+            parallel: Dispatch the messages in parallel on the plugin's worker threads.
+
+        Returns:
+            One response struct per request, in request order.
+
+        Raises:
+            PluginException: If the batch or any message in it fails.
+            ValueError: If message_ids and requests differ in length.
+
+        Example:
+            ```python
+            requests = [SmallRequest(...), SmallRequest(...)]
+            responses = plugin.call_raw_batch([1, 1], requests, SmallResponse, parallel=True)
+            ```
+        """
+        self._throw_if_disposed()
+
+        if not self._library.has_batch_transport:
+            raise PluginException("Batch binary transport not supported by this library")
+        if len(message_ids) != len(requests):
+            raise ValueError("message_ids and requests must have the same length")
+
+        count = len(requests)
+        if count == 0:
+            return []
+
+        # Descriptors point directly at the request structs (avoids copies)
+        descriptors = (RbBatchRequest * count)()
+        for i, (message_id, request) in enumerate(zip(message_ids, requests)):
+            descriptors[i].message_id = message_id
+            descriptors[i].request = addressof(request)
+            descriptors[i].request_size = sizeof(request)
+
+        rb_responses = (RbResponse * count)()
+        flags = RB_BATCH_PARALLEL if parallel else 0
+
+        result = self._library.plugin_call_raw_batch(self._handle, descriptors, rb_responses, flags)
+        if result != 0:
+            raise PluginException("Batch call rejected by plugin", result)
+
+        expected_size = sizeof(response_type)
+        responses: list[TResponse] = []
+        first_failure: PluginException | None = None
+        for rb_response in rb_responses:
+            if first_failure is None:
+                if rb_response.is_error():
+                    error_message = rb_response.get_error_message() or "Unknown error"
+                    first_failure = PluginException(error_message, rb_response.error_code)
+                elif rb_response.len != expected_size:
+                    first_failure = PluginException(
+                        f"Response size mismatch: expected {expected_size}, "
+                        f"got {rb_response.len}"
+                    )
+                else:
+                    response = response_type()
+                    memmove(addressof(response), rb_response.data, expected_size)
+                    responses.append(response)
+            self._library.rb_response_free(rb_response)
+
+        if first_failure is not None:
+            raise first_failure
+        return responses
+
     @property
     def has_binary_transport(self) -> bool:
         """
@@ -0,0 +1,99 @@
+"""Streamed requests written to a plugin chunk by chunk."""
+
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, Any
+
+from rustbridge.core.plugin_exception import PluginException
+from rustbridge.core.response_envelope import ResponseEnvelope
+
+if TYPE_CHECKING:
+    from rustbridge.native.native_plugin import NativePlugin
+
+
+class RequestWriter:
+    """
+    A request payload written to the plugin chunk by chunk.
+
+    Bytes are handed to the plugin's handler as they are written, with only a
+    few chunks buffered ahead of it, so a large request never has to be held
+    in memory at once. Writes block while the handler is behind. Concatenated,
+    the written bytes form the request ``call`` would have taken.
+
+    Leaving the ``with`` block without calling ``finish`` discards the request.
+
+    Example:
+        with plugin.open_request("import") as writer:
+            for chunk in chunks:
+                writer.write(chunk)
+            response = writer.finish()
+    """
+
+    def __init__(self, plugin: NativePlugin, input_id: int) -> None:
+        self._plugin = plugin
+        self._library = plugin._library
+        self._handle = plugin._handle
+        self._input_id = input_id
+        self._done = False
+
+    def write(self, data: bytes | bytearray | memoryview) -> int:
+        """
+        Send bytes to the handler, blocking while it is behind.
+
+        Args:
+            data: The bytes to send.
+
+        Returns:
+            The number of bytes written.
+
+        Raises:
+            PluginException: If the request was finished or discarded, or the
+                plugin rejected the write.
+        """
+        if self._done:
+            raise PluginException("Request already finished")
+        if not isinstance(data, bytes):
+            data = bytes(data)
+        if not data:
+            return 0
+
+        code = self._library.plugin_input_write(self._handle, self._input_id, data)
+        if code != 0:
+            raise PluginException("Request write failed", code)
+        return len(data)
+
+    def finish(self) -> str:
+        """
+        End the request and wait for the handler's response.
+
+        Returns:
+            The JSON response payload.
+
+        Raises:
+            PluginException: If the handler failed or the request was already
+                finished or discarded.
+        """
+        if self._done:
+            raise PluginException("Request already finished")
+        self._done = True
+
+        data = self._plugin._read_stream_frame(
+            self._library.plugin_input_finish(self._handle, self._input_id)
+        )
+        envelope = ResponseEnvelope.from_json(data.decode("utf-8"))
+        if not envelope.is_success:
+            raise envelope.to_exception()
+        return envelope.get_payload_json()
+
+    def close(self) -> None:
+        """Discard the request if it was not finished."""
+        if self._done:
+            return
+        self._done = True
+        self._library.plugin_input_abort(self._handle, self._input_id)
+
+    def __enter__(self) -> RequestWriter:
+        return self
+
+    def __exit__(self, exc_type: Any, exc_val: Any, exc_tb: Any) -> None:
+        self.close()
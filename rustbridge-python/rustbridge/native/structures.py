@@ -1,6 +1,16 @@
 """ctypes structures for FFI interop."""
 
-from ctypes import CFUNCTYPE, POINTER, Structure, c_char_p, c_size_t, c_uint8, c_uint32, c_uint64
+from ctypes import (
+    CFUNCTYPE,
+    POINTER,
+    Structure,
+    c_char_p,
+    c_size_t,
+    c_uint8,
+    c_uint32,
+    c_uint64,
+    c_void_p,
+)
 
 
 class FfiBuffer(Structure):
@@ -108,6 +118,67 @@ class RbResponse(Structure):
         return self.get_bytes().decode("utf-8", errors="replace")
 
 
+class RbBatchRequest(Structure):
+    """
+    Descriptor for one message in a plugin_call_raw_batch call.
+
+    Layout matches Rust RbBatchRequest:
+    ```rust
+    struct RbBatchRequest {
+        message_id: u32,          // binary message ID
+        _reserved: u32,           // alignment padding (zero)
+        request: *const c_void,   // request struct pointer
+        request_size: usize       // request struct size
+    }
+    ```
+
+    Attributes:
+        message_id: Numeric message identifier.
+        request: Pointer to the request struct (borrowed for the call).
+        request_size: Size of the request struct in bytes.
+    """
+
+    _fields_ = [
+        ("message_id", c_uint32),
+        ("_reserved", c_uint32),
+        ("request", c_void_p),
+        ("request_size", c_size_t),
+    ]
+
+
+# Batch flag: dispatch the messages in parallel on the plugin's runtime
+RB_BATCH_PARALLEL = 1
+
+# Number of buckets in RbAdmissionStats.wait_histogram_us
+RB_WAIT_HISTOGRAM_BUCKETS = 24
+
+
+class RbAdmissionStats(Structure):
+    """
+    Admission control counters filled by plugin_get_admission_stats.
+
+    Layout matches Rust RbAdmissionStats:
+    ```rust
+    struct RbAdmissionStats {
+        limit, in_flight, queue_depth: u64,
+        admitted, queued, rejected, timed_out: u64,
+        wait_histogram_us: [u64; 24]
+    }
+    ```
+    """
+
+    _fields_ = [
+        ("limit", c_uint64),
+        ("in_flight", c_uint64),
+        ("queue_depth", c_uint64),
+        ("admitted", c_uint64),
+        ("queued", c_uint64),
+        ("rejected", c_uint64),
+        ("timed_out", c_uint64),
+        ("wait_histogram_us", c_uint64 * RB_WAIT_HISTOGRAM_BUCKETS),
+    ]
+
+
 # Log callback function type
 # void (*)(uint8_t level, const char* target, const char* message, size_t message_len)
 LogCallbackFnType = CFUNCTYPE(None, c_uint8, c_char_p, c_char_p, c_size_t)
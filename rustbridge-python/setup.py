@@ -0,0 +1,21 @@
+"""Build the optional compiled fast path for binary calls.
+
+Project metadata lives in pyproject.toml; this file only declares the
+``rustbridge.native._fastcall`` extension. It is optional: if it cannot be
+built (no C compiler, or ``include/rustbridge_types.h`` is not in the parent
+directory, as in an sdist), installation continues and NativePlugin uses
+ctypes for every call.
+"""
+
+from setuptools import Extension, setup
+
+setup(
+    ext_modules=[
+        Extension(
+            "rustbridge.native._fastcall",
+            sources=["rustbridge/native/_fastcall.c"],
+            include_dirs=["../include"],
+            optional=True,
+        )
+    ]
+)
@@ -187,6 +187,120 @@ class TestBinaryTransport:
         with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
             assert plugin.has_binary_transport is True
 
+    def test_call_raw_into___small_benchmark___writes_response_into_buffer(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test binary transport into a caller-provided response struct."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            request = SmallRequestRaw.create("into_key", 0x01)
+            response = SmallResponseRaw()
+
+            written = plugin.call_raw_into(MSG_BENCH_SMALL, request, response)
+
+            assert written == sizeof(SmallResponseRaw)
+            assert response.version == SmallResponseRaw.CURRENT_VERSION
+            assert "into_key" in response.get_value()
+
+    def test_call_raw_into___buffer_too_small___raises_insufficient_capacity(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test that a too-small output buffer reports the required size."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            request = SmallRequestRaw.create("into_key", 0x01)
+            out = (c_uint8 * 8)()
+
+            with pytest.raises(PluginException, match="80 bytes required"):
+                plugin.call_raw_into(MSG_BENCH_SMALL, request, out)
+
+    def test_call_raw_buffer___bytes_request___returns_response_view(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test binary transport with a plain bytes request and a memoryview response."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            request = bytes(SmallRequestRaw.create("buffer_key", 0x01))
+
+            with plugin.call_raw_buffer(MSG_BENCH_SMALL, request) as view:
+                assert view.readonly
+                assert view.nbytes == sizeof(SmallResponseRaw)
+                response = SmallResponseRaw.from_buffer_copy(view)
+
+            assert "buffer_key" in response.get_value()
+
+    def test_call_raw_buffer___unknown_message_id___raises_exception(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test that the buffer API reports plugin errors like call_raw."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            with pytest.raises(PluginException, match="Unknown message ID"):
+                plugin.call_raw_buffer(999, bytearray(sizeof(SmallRequestRaw)))
+
+    def test_call_raw_buffer___concurrent_calls___all_succeed(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test concurrent buffer calls from several threads."""
+        import concurrent.futures
+
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+
+            def make_call(i: int) -> str:
+                request = bytes(SmallRequestRaw.create(f"key_{i}", 0x01))
+                with plugin.call_raw_buffer(MSG_BENCH_SMALL, request) as view:
+                    return SmallResponseRaw.from_buffer_copy(view).get_value()
+
+            with concurrent.futures.ThreadPoolExecutor(max_workers=8) as executor:
+                values = list(executor.map(make_call, range(200)))
+
+            for i, value in enumerate(values):
+                assert f"key_{i}" in value
+
+    def test_has_fast_path___extension_built___returns_true(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test that the compiled extension is picked up when it was built."""
+        pytest.importorskip("rustbridge.native._fastcall")
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            assert plugin.has_fast_path is True
+
+    def test_call_raw_batch___sequential___returns_responses_in_order(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test a batch of binary calls dispatched on the calling thread."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            requests = [SmallRequestRaw.create(f"batch_key_{i}", 0x01) for i in range(8)]
+
+            responses = plugin.call_raw_batch(
+                [MSG_BENCH_SMALL] * len(requests), requests, SmallResponseRaw
+            )
+
+            assert len(responses) == len(requests)
+            for i, response in enumerate(responses):
+                assert f"batch_key_{i}" in response.get_value()
+
+    def test_call_raw_batch___parallel___returns_responses_in_order(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test a batch of binary calls dispatched on the plugin's worker threads."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            requests = [SmallRequestRaw.create(f"parallel_key_{i}", 0x01) for i in range(64)]
+
+            responses = plugin.call_raw_batch(
+                [MSG_BENCH_SMALL] * len(requests), requests, SmallResponseRaw, parallel=True
+            )
+
+            assert len(responses) == len(requests)
+            for i, response in enumerate(responses):
+                assert f"parallel_key_{i}" in response.get_value()
+
+    def test_call_raw_batch___unknown_message_id___raises_exception(
+        self, hello_plugin_path: Path, skip_if_no_plugin: None
+    ) -> None:
+        """Test that one unknown message ID fails the batch."""
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            requests = [SmallRequestRaw.create("ok", 0), SmallRequestRaw.create("bad", 0)]
+
+            with pytest.raises(PluginException, match="Unknown message ID"):
+                plugin.call_raw_batch([MSG_BENCH_SMALL, 999], requests, SmallResponseRaw)
+
 
 class TestBinaryTransportBenchmark:
     """Benchmark tests comparing JSON vs binary transport."""
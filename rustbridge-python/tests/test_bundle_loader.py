@@ -472,3 +472,82 @@ class TestBundleLoaderEdgeCases:
                 loader.load(bundle_path)
         finally:
             bundle_path.unlink()
+
+
+def _write_library_bundle(path: Path, library: bytes, checksum_of: bytes | None = None) -> None:
+    """Write a bundle for the current platform whose manifest records `checksum_of`."""
+    current = BundleLoader.get_current_platform()
+    library_path = f"lib/{current}/release/libtest.so"
+    checksum = hashlib.sha256(library if checksum_of is None else checksum_of).hexdigest()
+    manifest = {
+        "bundle_version": "1.0",
+        "plugin": {"name": "test-plugin", "version": "1.0.0"},
+        "platforms": {
+            current: {
+                "variants": {
+                    "release": {"library": library_path, "checksum": f"sha256:{checksum}"}
+                }
+            }
+        },
+    }
+    with zipfile.ZipFile(path, "w", zipfile.ZIP_DEFLATED) as zf:
+        zf.writestr("manifest.json", json.dumps(manifest))
+        zf.writestr(library_path, library)
+
+
+class TestBundleLoaderCache:
+    """Tests for the content-addressed extraction cache."""
+
+    def test_extract_library_cached___cold___extracts_into_digest_directory(
+        self, tmp_path: Path
+    ) -> None:
+        bundle_path = tmp_path / "plugin.rbp"
+        _write_library_bundle(bundle_path, b"library bytes")
+        loader = BundleLoader(verify_signatures=False)
+
+        result = loader.extract_library_cached(bundle_path, tmp_path / "cache")
+
+        digest = hashlib.sha256(b"library bytes").hexdigest()
+        assert result == tmp_path / "cache" / digest / "libtest.so"
+        assert result.read_bytes() == b"library bytes"
+        assert (result.parent / ".rbcache").exists()
+
+    def test_extract_library_cached___warm___skips_extraction(self, tmp_path: Path) -> None:
+        original = tmp_path / "original.rbp"
+        tampered = tmp_path / "tampered.rbp"
+        _write_library_bundle(original, b"original library")
+        _write_library_bundle(tampered, b"tampered library", checksum_of=b"original library")
+        loader = BundleLoader(verify_signatures=False)
+        loader.extract_library_cached(original, tmp_path / "cache")
+
+        # A hit never reads the entry, so the bad copy in this bundle goes unnoticed
+        result = loader.extract_library_cached(tampered, tmp_path / "cache")
+
+        assert result.read_bytes() == b"original library"
+
+    def test_extract_library_cached___changed_library___extracts_again(
+        self, tmp_path: Path
+    ) -> None:
+        bundle_path = tmp_path / "plugin.rbp"
+        _write_library_bundle(bundle_path, b"library bytes")
+        loader = BundleLoader(verify_signatures=False)
+        cached = loader.extract_library_cached(bundle_path, tmp_path / "cache")
+
+        cached.write_bytes(b"overwritten")
+        result = loader.extract_library_cached(bundle_path, tmp_path / "cache")
+
+        assert result == cached
+        assert result.read_bytes() == b"library bytes"
+
+    def test_extract_library_cached___checksum_mismatch___leaves_no_library(
+        self, tmp_path: Path
+    ) -> None:
+        bundle_path = tmp_path / "plugin.rbp"
+        _write_library_bundle(bundle_path, b"tampered library", checksum_of=b"original")
+        loader = BundleLoader(verify_signatures=False)
+
+        with pytest.raises(PluginException, match="Checksum verification failed"):
+            loader.extract_library_cached(bundle_path, tmp_path / "cache")
+
+        digest = hashlib.sha256(b"original").hexdigest()
+        assert not (tmp_path / "cache" / digest / "libtest.so").exists()
@@ -116,6 +116,66 @@ class TestHelloPluginIntegration:
             assert isinstance(response, dict)
             assert "message" in response
 
+    def test_call_as___msgpack_echo___returns_msgpack_response(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            # {"message": "hi"}
+            request = b"\x81\xa7message\xa2hi"
+
+            response = plugin.call_as("echo", "application/msgpack", request)
+
+            # {"message": "hi", "length": 2}
+            assert response == b"\x82\xa7message\xa2hi\xa6length\x02"
+
+    def test_call_as___unknown_content_type___raises_code_15(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            with pytest.raises(PluginException) as exc_info:
+                plugin.call_as("echo", "application/cbor", b"\xa0")
+
+            assert exc_info.value.error_code == 15
+
+    def test_call_stream___echo___yields_response_then_ends(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            chunks = list(plugin.call_stream("echo", '{"message": "streamed"}'))
+
+            assert len(chunks) == 1
+            assert b"streamed" in chunks[0]
+
+    def test_call_stream___unknown_type_tag___raises_on_open(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            with pytest.raises(PluginException) as exc_info:
+                plugin.call_stream("nonexistent.type", "{}")
+
+            assert exc_info.value.error_code == 6
+
+    def test_open_request___echo_written_in_pieces___returns_response(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            with plugin.open_request("echo") as writer:
+                writer.write(b'{"message": ')
+                writer.write(b'"in pieces"}')
+                response = writer.finish()
+
+            assert "in pieces" in response
+
+    def test_open_request___unknown_type_tag___raises_on_finish(
+        self, skip_if_no_plugin: None, hello_plugin_path: Path
+    ) -> None:
+        with NativePluginLoader.load(str(hello_plugin_path)) as plugin:
+            with plugin.open_request("nonexistent.type") as writer:
+                with pytest.raises(PluginException) as exc_info:
+                    writer.finish()
+
+            assert exc_info.value.error_code == 6
+
     def test_load_with_log_callback___callback_invoked(
         self, skip_if_no_plugin: None, hello_plugin_path: Path
     ) -> None:
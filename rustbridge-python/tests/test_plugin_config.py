@@ -100,3 +100,52 @@ class TestPluginConfig:
         assert parsed["data"]["custom"] == "value"
         assert parsed["max_concurrent_ops"] == 1000
         assert parsed["shutdown_timeout_ms"] == 5000
+
+    def test_admission___sets_mode_and_wait(self) -> None:
+        config = PluginConfig.defaults().admission("FIFO", max_wait_ms=25)
+
+        admission = config.to_dict()["admission"]
+
+        assert admission == {"mode": "fifo", "max_wait_ms": 25}
+
+    def test_admission___unset___omits_section(self) -> None:
+        parsed = json.loads(PluginConfig.defaults().to_json_bytes())
+
+        assert "admission" not in parsed
+
+    def test_admission_codel___serializes_queue_settings(self) -> None:
+        config = (
+            PluginConfig.defaults()
+            .admission("adaptive_lifo")
+            .admission_max_queue_depth(64)
+            .admission_codel(5, 100)
+        )
+
+        parsed = json.loads(config.to_json_bytes())
+
+        assert parsed["admission"]["mode"] == "adaptive_lifo"
+        assert parsed["admission"]["max_wait_ms"] == 10
+        assert parsed["admission"]["max_queue_depth"] == 64
+        assert parsed["admission"]["codel_target_ms"] == 5
+        assert parsed["admission"]["codel_interval_ms"] == 100
+
+    def test_runtime___unset___omits_section(self) -> None:
+        assert "runtime" not in PluginConfig.defaults().to_dict()
+
+    def test_runtime___serializes_flavor_sharing_and_affinity(self) -> None:
+        config = (
+            PluginConfig.defaults()
+            .runtime_flavor("current_thread")
+            .shared_runtime()
+            .cpu_affinity(0, 2)
+            .numa_node(1)
+        )
+
+        parsed = json.loads(config.to_json_bytes())
+
+        assert parsed["runtime"] == {
+            "flavor": "current_thread",
+            "shared": True,
+            "cpu_affinity": [0, 2],
+            "numa_node": 1,
+        }
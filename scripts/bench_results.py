@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""Convert, compare and tabulate benchmark results in the rustbridge-bench/1 format.
+
+Every harness reports into one format: JSON Lines, one object per measured
+case. The C harness (rustbridge-c/benchmarks/rb_bench.c) writes it directly;
+JMH, BenchmarkDotNet and pytest-benchmark JSON reports are converted with
+``convert``. See docs/BENCHMARK_RESULTS.md for the field list.
+
+Usage:
+    bench_results.py convert {jmh,dotnet,pytest} REPORT [-o OUT]
+    bench_results.py compare BASELINE CURRENT [--metric p50_ns] [--threshold 10]
+    bench_results.py table RESULTS...
+
+``compare`` exits with status 1 when any case present in both files got
+slower than the threshold allows, so it can gate CI.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+import sys
+from pathlib import Path
+from typing import Any, Iterable
+
+SCHEMA = "rustbridge-bench/1"
+
+# Time unit suffixes used by JMH, in nanoseconds
+_JMH_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def _record(
+    harness: str,
+    language: str,
+    api: str,
+    transport: str,
+    threads: int,
+    mean_ns: float,
+    *,
+    samples: int | None = None,
+    p50_ns: float | None = None,
+    p90_ns: float | None = None,
+    p99_ns: float | None = None,
+    max_ns: float | None = None,
+    payload_bytes: int | None = None,
+    batch: int = 1,
+) -> dict[str, Any]:
+    """Build one result record, deriving the name and throughput."""
+    payload = "" if payload_bytes is None else payload_bytes
+    return {
+        "schema": SCHEMA,
+        "name": f"{harness}/{api}/{transport}/{payload}/{batch}/{threads}",
+        "harness": harness,
+        "language": language,
+        "api": api,
+        "transport": transport,
+        "payload_bytes": payload_bytes,
+        "batch": batch,
+        "threads": threads,
+        "samples": samples,
+        "mean_ns": mean_ns,
+        "p50_ns": p50_ns,
+        "p90_ns": p90_ns,
+        "p99_ns": p99_ns,
+        "max_ns": max_ns,
+        "ops_per_sec": threads * batch * 1e9 / mean_ns if mean_ns > 0 else None,
+        "errors": 0,
+    }
+
+
+def _transport(name: str) -> str:
+    """Guess the transport from a benchmark name."""
+    return "binary" if re.search(r"binary|raw", name, re.IGNORECASE) else "json"
+
+
+def convert_jmh(report: Any) -> Iterable[dict[str, Any]]:
+    """Convert a JMH ``-rf json`` report (average time modes only)."""
+    for bench in report:
+        metric = bench["primaryMetric"]
+        unit = metric["scoreUnit"].split("/")[0]
+        if bench.get("mode") not in ("avgt", "sample") or unit not in _JMH_UNITS:
+            continue
+        scale = _JMH_UNITS[unit]
+        percentiles = metric.get("scorePercentiles", {})
+
+        def pct(key: str) -> float | None:
+            return percentiles[key] * scale if key in percentiles else None
+
+        name = bench["benchmark"]
+        language = "java-jni" if "jni" in name.lower() else "java-ffm"
+        yield _record(
+            "jmh",
+            language,
+            name.rsplit(".", 2)[-2] + "." + name.rsplit(".", 1)[-1],
+            _transport(name),
+            bench.get("threads", 1),
+            metric["score"] * scale,
+            p50_ns=pct("50.0"),
+            p90_ns=pct("90.0"),
+            p99_ns=pct("99.0"),
+            max_ns=pct("100.0"),
+        )
+
+
+def convert_dotnet(report: Any) -> Iterable[dict[str, Any]]:
+    """Convert a BenchmarkDotNet full JSON report (times are in ns)."""
+    for bench in report["Benchmarks"]:
+        stats = bench.get("Statistics")
+        if not stats:
+            continue
+        percentiles = stats.get("Percentiles", {})
+        yield _record(
+            "dotnet",
+            "csharp",
+            f"{bench['Type']}.{bench['Method']}",
+            _transport(bench["Method"]),
+            1,
+            stats["Mean"],
+            samples=stats.get("N"),
+            p50_ns=percentiles.get("P50", stats.get("Median")),
+            p90_ns=percentiles.get("P90"),
+            max_ns=stats.get("Max"),
+        )
+
+
+def convert_pytest(report: Any) -> Iterable[dict[str, Any]]:
+    """Convert a pytest-benchmark ``--benchmark-json`` report (times are in s)."""
+    for bench in report["benchmarks"]:
+        stats = bench["stats"]
+        yield _record(
+            "pytest",
+            "python",
+            bench["name"],
+            _transport(bench["name"]),
+            1,
+            stats["mean"] * 1e9,
+            samples=stats.get("rounds"),
+            p50_ns=stats["median"] * 1e9,
+            max_ns=stats["max"] * 1e9,
+        )
+
+
+CONVERTERS = {"jmh": convert_jmh, "dotnet": convert_dotnet, "pytest": convert_pytest}
+
+
+def load(path: Path) -> dict[str, dict[str, Any]]:
+    """Read a results file, keyed by case name."""
+    results = {}
+    for number, line in enumerate(path.read_text().splitlines(), 1):
+        if not line.strip():
+            continue
+        record = json.loads(line)
+        if record.get("schema") != SCHEMA:
+            raise SystemExit(f"{path}:{number}: not a {SCHEMA} record")
+        results[record["name"]] = record
+    return results
+
+
+def cmd_convert(args: argparse.Namespace) -> int:
+    report = json.loads(Path(args.report).read_text())
+    out = open(args.output, "w") if args.output else sys.stdout
+    with out:
+        for record in CONVERTERS[args.format](report):
+            out.write(json.dumps(record) + "\n")
+    return 0
+
+
+def cmd_compare(args: argparse.Namespace) -> int:
+    baseline = load(Path(args.baseline))
+    current = load(Path(args.current))
+    regressions = 0
+    print(f"{'case':<60} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in sorted(baseline.keys() & current.keys()):
+        before = baseline[name].get(args.metric)
+        after = current[name].get(args.metric)
+        if not before or after is None:
+            continue
+        change = (after - before) / before * 100
+        regressed = change > args.threshold
+        regressions += regressed
+        flag = "  REGRESSED" if regressed else ""
+        print(f"{name:<60} {before:>12.0f} {after:>12.0f} {change:>+7.1f}%{flag}")
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f"{name:<60} missing from {args.current}")
+    if regressions:
+        print(f"\n{regressions} case(s) slower than {args.threshold}% on {args.metric}")
+        return 1
+    return 0
+
+
+def _ns(value: float | None) -> str:
+    if value is None:
+        return "-"
+    if value >= 1e6:
+        return f"{value / 1e6:.2f} ms"
+    if value >= 1e3:
+        return f"{value / 1e3:.2f} μs"
+    return f"{value:.0f} ns"
+
+
+def cmd_table(args: argparse.Namespace) -> int:
+    print("| Harness | API | Transport | Payload | Batch | Threads | p50 | p99 | Mean | Ops/s |")
+    print("|---------|-----|-----------|---------|-------|---------|-----|-----|------|-------|")
+    for path in args.results:
+        for r in load(Path(path)).values():
+            payload = "-" if r["payload_bytes"] is None else f"{r['payload_bytes']} B"
+            ops = "-" if r.get("ops_per_sec") is None else f"{r['ops_per_sec']:,.0f}"
+            print(
+                f"| {r['harness']} | `{r['api']}` | {r['transport']} | {payload} "
+                f"| {r['batch']} | {r['threads']} | {_ns(r['p50_ns'])} | {_ns(r['p99_ns'])} "
+                f"| {_ns(r['mean_ns'])} | {ops} |"
+            )
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    convert = commands.add_parser("convert", help="convert a harness report")
+    convert.add_argument("format", choices=sorted(CONVERTERS))
+    convert.add_argument("report")
+    convert.add_argument("-o", "--output")
+    convert.set_defaults(run=cmd_convert)
+
+    compare = commands.add_parser("compare", help="fail on regressions against a baseline")
+    compare.add_argument("baseline")
+    compare.add_argument("current")
+    compare.add_argument("--metric", default="p50_ns")
+    compare.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in %%")
+    compare.set_defaults(run=cmd_compare)
+
+    table = commands.add_parser("table", help="print results as a Markdown table")
+    table.add_argument("results", nargs="+")
+    table.set_defaults(run=cmd_table)
+
+    args = parser.parse_args()
+    return args.run(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())